@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+"""Compare benchmark results against a stored baseline.
+
+Reads the JSON written by the benchmark harness (--format=json), matches benchmarks by
+"<suite>/<name>", and flags a regression only when the median slowed down by more than the
+tolerance AND a one-sided Mann-Whitney U test on the raw samples says the slowdown is
+unlikely to be noise. Every compared benchmark counts as one test, so the p-values are
+Holm-corrected across the whole set before they are checked against alpha.
+
+Samples from one process are not independent: code placement and machine state shift a whole
+run. When several files hold the same benchmark (for example interleaved rounds), each run's
+median therefore becomes one sample, and the test compares runs rather than raw samples.
+Uses only the Python standard library.
+
+Exit status: 0 if nothing regressed, 1 on regressions, 2 on usage or input errors.
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import statistics
+import sys
+
+BASELINE_VERSION = 1
+
+
+def load_results(paths):
+    """Returns {"suite/name": {"median": float, "samples": [float]}} from harness JSON files.
+
+    A benchmark found in several files is summarized by its run medians: they are its samples,
+    and their median is its median.
+    """
+    runs = {}
+    for path in paths:
+        with open(path, encoding="utf-8") as handle:
+            document = json.load(handle)
+        suite = document.get("suite", os.path.splitext(os.path.basename(path))[0])
+        for benchmark in document.get("benchmarks", []):
+            key = f"{suite}/{benchmark['name']}"
+            runs.setdefault(key, []).append(benchmark)
+    results = {}
+    for key, benchmarks in runs.items():
+        if len(benchmarks) == 1:
+            results[key] = {"median": benchmarks[0]["median"], "samples": benchmarks[0]["samples"]}
+        else:
+            medians = [benchmark["median"] for benchmark in benchmarks]
+            results[key] = {"median": statistics.median(medians), "samples": medians}
+    return results
+
+
+def load_baseline(path):
+    with open(path, encoding="utf-8") as handle:
+        document = json.load(handle)
+    if document.get("version") != BASELINE_VERSION:
+        raise ValueError(f"{path}: unsupported baseline version {document.get('version')}")
+    return document["benchmarks"]
+
+
+def write_baseline(path, results):
+    directory = os.path.dirname(path)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+    with open(path, "w", encoding="utf-8") as handle:
+        json.dump({"version": BASELINE_VERSION, "benchmarks": results}, handle, indent=1,
+                  sort_keys=True)
+        handle.write("\n")
+
+
+# --- Mann-Whitney U ---
+
+def _ranks(values):
+    """Average ranks (1-based) with ties sharing the mean rank; also returns tie group sizes."""
+    order = sorted(range(len(values)), key=lambda index: values[index])
+    ranks = [0.0] * len(values)
+    ties = []
+    start = 0
+    while start < len(order):
+        end = start
+        while end + 1 < len(order) and values[order[end + 1]] == values[order[start]]:
+            end += 1
+        for position in range(start, end + 1):
+            ranks[order[position]] = (start + end) / 2.0 + 1.0
+        if end > start:
+            ties.append(end - start + 1)
+        start = end + 1
+    return ranks, ties
+
+
+def _exact_upper_tail(u_value, first_count, second_count):
+    """P(U >= u_value) under the null hypothesis, by counting rank arrangements."""
+    # counts[n][u]: arrangements of first_count items among first_count + n with statistic u
+    max_u = first_count * second_count
+    previous = [[1] + [0] * max_u for _ in range(second_count + 1)]  # zero items from sample 1
+    for size_one in range(1, first_count + 1):
+        current = [[0] * (max_u + 1) for _ in range(second_count + 1)]
+        current[0][0] = 1
+        for size_two in range(1, second_count + 1):
+            for u in range(size_one * size_two + 1):
+                # The largest value belongs to sample 1 (beating size_two values) or sample 2
+                total = current[size_two - 1][u]
+                if u >= size_two:
+                    total += previous[size_two][u - size_two]
+                current[size_two][u] = total
+        previous = current
+    distribution = previous[second_count]
+    threshold = math.ceil(u_value)
+    return sum(distribution[threshold:]) / math.comb(first_count + second_count, first_count)
+
+
+def mann_whitney_greater(first, second):
+    """One-sided p-value that values in `first` tend to be larger than those in `second`."""
+    first_count, second_count = len(first), len(second)
+    if first_count == 0 or second_count == 0:
+        return 1.0
+    ranks, ties = _ranks(list(first) + list(second))
+    u_value = sum(ranks[:first_count]) - first_count * (first_count + 1) / 2.0
+    if not ties and first_count * second_count <= 2500:
+        return _exact_upper_tail(u_value, first_count, second_count)
+    # Normal approximation with tie and continuity corrections
+    total = first_count + second_count
+    mean = first_count * second_count / 2.0
+    tie_term = sum(size ** 3 - size for size in ties) / (total * (total - 1))
+    variance = first_count * second_count / 12.0 * (total + 1 - tie_term)
+    if variance <= 0:
+        return 1.0
+    z_score = (u_value - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z_score / math.sqrt(2.0))
+
+
+def smallest_p_value(first_count, second_count):
+    """Smallest one-sided p-value the exact test can produce: complete separation."""
+    return 1.0 / math.comb(first_count + second_count, first_count)
+
+
+def holm_adjust(p_values, family_size):
+    """Holm step-down adjusted p-values for a family of family_size tests.
+
+    p_values holds the tests that were run; the untested rest of the family counts as p = 1,
+    which only ever ranks after them.
+    """
+    adjusted = {}
+    running_max = 0.0
+    for rank, (key, p_value) in enumerate(sorted(p_values.items(), key=lambda item: item[1])):
+        running_max = max(running_max, min(1.0, (family_size - rank) * p_value))
+        adjusted[key] = running_max
+    return adjusted
+
+
+# --- Comparison ---
+
+def compare(baseline, current, tolerance, alpha):
+    """Returns (rows, regression_count). Each row is (key, old, new, delta, p_value, status).
+
+    p_value is Holm-adjusted over every benchmark present in both runs, separately for
+    slowdowns and speedups, and is only computed when the median moved beyond the tolerance.
+    """
+    matched = sorted(set(baseline) & set(current))
+    deltas = {}
+    slower, faster = {}, {}
+    for key in matched:
+        old, new = baseline[key], current[key]
+        delta = (new["median"] - old["median"]) / old["median"] if old["median"] > 0 else 0.0
+        deltas[key] = delta
+        if delta > tolerance:
+            slower[key] = mann_whitney_greater(new["samples"], old["samples"])
+        elif delta < -tolerance:
+            faster[key] = mann_whitney_greater(old["samples"], new["samples"])
+    adjusted = holm_adjust(slower, len(matched))
+    adjusted.update(holm_adjust(faster, len(matched)))
+
+    rows = []
+    regressions = 0
+    for key in sorted(set(baseline) | set(current)):
+        if key not in current:
+            rows.append((key, baseline[key]["median"], None, None, None, "missing"))
+            continue
+        if key not in baseline:
+            rows.append((key, None, current[key]["median"], None, None, "new"))
+            continue
+        status = "ok"
+        p_value = adjusted.get(key)
+        if key in slower:
+            status = "REGRESSION" if p_value < alpha else "noise"
+        elif key in faster:
+            status = "improved" if p_value < alpha else "noise"
+        if status == "REGRESSION":
+            regressions += 1
+        rows.append((key, baseline[key]["median"], current[key]["median"], deltas[key], p_value,
+                     status))
+    return rows, regressions
+
+
+def check_power(baseline, current, alpha):
+    """Warns when too few samples were taken for any corrected test to reach alpha."""
+    matched = sorted(set(baseline) & set(current))
+    if not matched:
+        return
+    weakest = max(matched, key=lambda key: smallest_p_value(len(current[key]["samples"]),
+                                                            len(baseline[key]["samples"])))
+    floor = smallest_p_value(len(current[weakest]["samples"]), len(baseline[weakest]["samples"]))
+    if floor * len(matched) >= alpha:
+        print(f"Warning: {weakest} has too few samples to pass alpha = {alpha} after correcting "
+              f"for {len(matched)} benchmarks (smallest p-value {floor:.2g}); "
+              f"use more runs or repetitions.", file=sys.stderr)
+
+
+def format_ns(value):
+    if value is None:
+        return "-"
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if value >= scale:
+            return f"{value / scale:.2f} {unit}"
+    return f"{value:.2f} ns"
+
+
+def print_table(rows):
+    name_width = max([len("Benchmark")] + [len(row[0]) for row in rows])
+    print(f"{'Benchmark':<{name_width}} {'Baseline':>12} {'Current':>12} {'Delta':>9} "
+          f"{'p (Holm)':>9}  Status")
+    for key, old, new, delta, p_value, status in rows:
+        delta_text = f"{delta * 100:+.1f}%" if delta is not None else "-"
+        p_text = f"{p_value:.4f}" if p_value is not None else "-"
+        print(f"{key:<{name_width}} {format_ns(old):>12} {format_ns(new):>12} {delta_text:>9} "
+              f"{p_text:>9}  {status}")
+
+
+def write_csv(path, rows):
+    """Writes the comparison rows; empty cells stand for values that do not apply."""
+    directory = os.path.dirname(path)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+    with open(path, "w", encoding="utf-8", newline="") as handle:
+        writer = csv.writer(handle)
+        writer.writerow(["benchmark", "baseline_median_ns", "current_median_ns", "delta",
+                         "p_value_holm", "status"])
+        for row in rows:
+            writer.writerow(["" if value is None else value for value in row])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("results", nargs="+", help="JSON files written with --format=json")
+    parser.add_argument("--baseline", required=True, help="Baseline file to compare against")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="Relative median slowdown ignored as noise (default: 0.10)")
+    parser.add_argument("--alpha", type=float, default=0.05,
+                        help="Family-wise significance level across all benchmarks, "
+                             "Holm-corrected (default: 0.05)")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="Replace the baseline with these results instead of comparing")
+    parser.add_argument("--csv", help="Also write the comparison table to this CSV file")
+    args = parser.parse_args()
+
+    try:
+        current = load_results(args.results)
+    except (OSError, ValueError, KeyError) as error:
+        print(f"Error: cannot read results: {error}", file=sys.stderr)
+        return 2
+    if not current:
+        print("Error: no benchmark results found", file=sys.stderr)
+        return 2
+
+    if args.update_baseline or not os.path.exists(args.baseline):
+        write_baseline(args.baseline, current)
+        reason = "Updated" if args.update_baseline else "No baseline found; wrote"
+        print(f"{reason} {args.baseline} with {len(current)} benchmarks.")
+        return 0
+
+    try:
+        baseline = load_baseline(args.baseline)
+    except (OSError, ValueError, KeyError) as error:
+        print(f"Error: cannot read baseline: {error}", file=sys.stderr)
+        return 2
+
+    check_power(baseline, current, args.alpha)
+    rows, regressions = compare(baseline, current, args.tolerance, args.alpha)
+    print_table(rows)
+    if args.csv:
+        write_csv(args.csv, rows)
+    if regressions:
+        print(f"\n{regressions} benchmark(s) regressed by more than {args.tolerance * 100:.0f}% "
+              f"(Holm-corrected p < {args.alpha}).")
+        return 1
+    print(f"\nNo regressions beyond {args.tolerance * 100:.0f}% (Holm-corrected p < {args.alpha}).")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,290 @@
+#ifndef MVN_DS_BENCHMARK_DOCUMENT_H
+#define MVN_DS_BENCHMARK_DOCUMENT_H
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_workload.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Longest path (in steps) produced by document_random_path
+#define DOCUMENT_MAX_PATH_DEPTH 32
+
+// Percent of non-root nodes that are maps and arrays; the rest are scalars
+#define DOCUMENT_MAP_PERCENT   25
+#define DOCUMENT_ARRAY_PERCENT 15
+// Percent of array elements that are maps (records), the rest follow the normal mix
+#define DOCUMENT_ARRAY_RECORD_PERCENT 50
+
+/**
+ * @brief Shape of generated documents. The defaults give JSON-like records of a few KB.
+ */
+typedef struct document_config_t {
+    size_t fanout;            /**< Keys per map. */
+    size_t depth;             /**< Maximum nesting depth below the root. */
+    size_t array_length;      /**< Elements per array. */
+    size_t min_string_length; /**< Shortest generated string. */
+    size_t max_string_length; /**< Longest generated string. */
+    double string_skew;       /**< 1 gives uniform lengths; larger values favor short strings. */
+} document_config_t;
+
+/**
+ * @brief Deterministic document generator. Maps reuse one key vocabulary, as records
+ * sharing a schema do.
+ */
+typedef struct document_generator_t {
+    document_config_t config;
+    workload_rng_t    rng;
+    char            **keys;          /**< config.fanout key names. */
+    char             *string_buffer; /**< Scratch space for generated strings. */
+} document_generator_t;
+
+/**
+ * @brief A path from a document root: each step is a map key or, when key is NULL, an
+ * array index.
+ */
+typedef struct document_path_t {
+    size_t      length;
+    const char *keys[DOCUMENT_MAX_PATH_DEPTH];
+    size_t      indices[DOCUMENT_MAX_PATH_DEPTH];
+} document_path_t;
+
+// Field names in the style of typical API payloads; suffixed when fanout exceeds the list
+static const char *const document_key_vocabulary[] = {
+    "id",         "name",      "type",     "status",   "created_at", "updated_at", "owner",
+    "email",      "title",     "body",     "tags",     "score",      "version",    "enabled",
+    "parent_id",  "children",  "metadata", "location", "latitude",   "longitude",  "price",
+    "currency",   "quantity",  "items",    "address",  "city",       "country",    "phone",
+    "description", "priority", "labels",   "settings"};
+
+#define DOCUMENT_KEY_VOCABULARY_SIZE \
+    (sizeof(document_key_vocabulary) / sizeof(document_key_vocabulary[0]))
+
+static inline document_config_t document_config_default(void)
+{
+    document_config_t config;
+    config.fanout            = 8;
+    config.depth             = 3;
+    config.array_length      = 4;
+    config.min_string_length = 4;
+    config.max_string_length = 32;
+    config.string_skew       = 2.0;
+    return config;
+}
+
+static inline void document_generator_free(document_generator_t *generator)
+{
+    if (generator->keys != NULL) {
+        for (size_t index = 0; index < generator->config.fanout; index++) {
+            free(generator->keys[index]);
+        }
+        free(generator->keys);
+    }
+    free(generator->string_buffer);
+    generator->keys          = NULL;
+    generator->string_buffer = NULL;
+}
+
+/**
+ * @brief Prepares a generator; returns false on allocation failure or an invalid config.
+ */
+static inline bool document_generator_init(document_generator_t    *generator,
+                                           const document_config_t *config,
+                                           uint64_t                 seed)
+{
+    memset(generator, 0, sizeof(*generator));
+    if (config->fanout == 0 || config->min_string_length > config->max_string_length ||
+        config->depth >= DOCUMENT_MAX_PATH_DEPTH) {
+        return false;
+    }
+    generator->config = *config;
+    workload_rng_seed(&generator->rng, seed);
+
+    generator->keys          = (char **)calloc(config->fanout, sizeof(char *));
+    generator->string_buffer = (char *)malloc(config->max_string_length + 1);
+    if (generator->keys == NULL || generator->string_buffer == NULL) {
+        document_generator_free(generator);
+        return false;
+    }
+    for (size_t index = 0; index < config->fanout; index++) {
+        const char *base  = document_key_vocabulary[index % DOCUMENT_KEY_VOCABULARY_SIZE];
+        size_t      round = index / DOCUMENT_KEY_VOCABULARY_SIZE;
+        char        buffer[64];
+        if (round == 0) {
+            snprintf(buffer, sizeof(buffer), "%s", base);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s_%zu", base, round);
+        }
+        generator->keys[index] = (char *)malloc(strlen(buffer) + 1);
+        if (generator->keys[index] == NULL) {
+            document_generator_free(generator);
+            return false;
+        }
+        strcpy(generator->keys[index], buffer);
+    }
+    return true;
+}
+
+static inline mvn_val_t document_generate_string(document_generator_t *generator)
+{
+    const document_config_t *config = &generator->config;
+    size_t                   spread = config->max_string_length - config->min_string_length + 1;
+    double skewed = pow(workload_rng_double(&generator->rng), config->string_skew);
+    size_t length = config->min_string_length + (size_t)(skewed * (double)spread);
+    if (length > config->max_string_length) {
+        length = config->max_string_length;
+    }
+    for (size_t index = 0; index < length; index++) {
+        generator->string_buffer[index] = (char)('a' + workload_rng_below(&generator->rng, 26));
+    }
+    generator->string_buffer[length] = '\0';
+    return mvn_val_str(generator->string_buffer);
+}
+
+static inline mvn_val_t document_generate_node(document_generator_t *generator, size_t level);
+
+static inline mvn_val_t document_generate_map(document_generator_t *generator, size_t level)
+{
+    mvn_val_t map = mvn_val_hmap();
+    if (map.type != MVN_VAL_HASHMAP) {
+        return map;
+    }
+    for (size_t index = 0; index < generator->config.fanout; index++) {
+        mvn_hmap_set_cstr(
+            map.hmap, generator->keys[index], document_generate_node(generator, level + 1));
+    }
+    return map;
+}
+
+static inline mvn_val_t document_generate_node(document_generator_t *generator, size_t level)
+{
+    size_t roll = workload_rng_below(&generator->rng, 100);
+    if (level < generator->config.depth) {
+        if (roll < DOCUMENT_MAP_PERCENT) {
+            return document_generate_map(generator, level);
+        }
+        if (roll < DOCUMENT_MAP_PERCENT + DOCUMENT_ARRAY_PERCENT) {
+            mvn_val_t array = mvn_val_arr();
+            if (array.type != MVN_VAL_ARRAY) {
+                return array;
+            }
+            for (size_t index = 0; index < generator->config.array_length; index++) {
+                if (workload_rng_below(&generator->rng, 100) < DOCUMENT_ARRAY_RECORD_PERCENT) {
+                    mvn_arr_push(array.arr, document_generate_map(generator, level + 1));
+                } else {
+                    mvn_arr_push(array.arr, document_generate_node(generator, level + 1));
+                }
+            }
+            return array;
+        }
+    }
+    // Scalars split evenly between the remaining kinds, strings counted twice
+    switch (roll % 6) {
+        case 0:
+            return mvn_val_i64((int64_t)(workload_rng_next(&generator->rng) >> 1));
+        case 1:
+            return mvn_val_f64(workload_rng_double(&generator->rng) * 1000.0);
+        case 2:
+            return mvn_val_bool((workload_rng_next(&generator->rng) & 1U) != 0);
+        case 3:
+            return mvn_val_null();
+        default:
+            return document_generate_string(generator);
+    }
+}
+
+/**
+ * @brief Generates the next document. The root is always a map.
+ */
+static inline mvn_val_t document_generate(document_generator_t *generator)
+{
+    return document_generate_map(generator, 0);
+}
+
+/**
+ * @brief Picks a random root-to-node path by descending through random keys and indices,
+ * stopping at a scalar or after a random number of steps. Keys borrow the generator's names.
+ */
+static inline void document_random_path(document_generator_t *generator,
+                                        const mvn_val_t      *document,
+                                        document_path_t      *path)
+{
+    const mvn_val_t *node = document;
+    path->length          = 0;
+    while (path->length < DOCUMENT_MAX_PATH_DEPTH) {
+        if (node->type == MVN_VAL_HASHMAP && node->hmap->count > 0) {
+            const char *key = generator->keys[workload_rng_below(&generator->rng,
+                                                                 generator->config.fanout)];
+            path->keys[path->length]    = key;
+            path->indices[path->length] = 0;
+            node                        = mvn_hmap_cstr(node->hmap, key);
+        } else if (node->type == MVN_VAL_ARRAY && node->arr->count > 0) {
+            size_t index                = workload_rng_below(&generator->rng, node->arr->count);
+            path->keys[path->length]    = NULL;
+            path->indices[path->length] = index;
+            node                        = mvn_arr_get(node->arr, index);
+        } else {
+            return;
+        }
+        path->length++;
+        // Stop early at one in four containers so lookups hit every depth
+        if (node == NULL || workload_rng_below(&generator->rng, 4) == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Follows a path from the root; returns NULL if any step is missing.
+ */
+static inline const mvn_val_t *document_lookup(const mvn_val_t       *document,
+                                               const document_path_t *path)
+{
+    const mvn_val_t *node = document;
+    for (size_t step = 0; step < path->length && node != NULL; step++) {
+        if (path->keys[step] != NULL) {
+            node = node->type == MVN_VAL_HASHMAP ? mvn_hmap_cstr(node->hmap, path->keys[step])
+                                                 : NULL;
+        } else {
+            node = node->type == MVN_VAL_ARRAY ? mvn_arr_get(node->arr, path->indices[step])
+                                               : NULL;
+        }
+    }
+    return node;
+}
+
+/**
+ * @brief Counts the values in a document, the root included.
+ */
+static inline size_t document_node_count(const mvn_val_t *node)
+{
+    size_t count = 1;
+    if (node->type == MVN_VAL_ARRAY) {
+        for (size_t index = 0; index < node->arr->count; index++) {
+            count += document_node_count(&node->arr->data[index]);
+        }
+    } else if (node->type == MVN_VAL_HASHMAP) {
+        for (size_t bucket = 0; bucket < node->hmap->capacity; bucket++) {
+            for (const mvn_hmap_entry_t *entry = node->hmap->buckets[bucket]; entry != NULL;
+                 entry                         = entry->next) {
+                count += document_node_count(&entry->value);
+            }
+        }
+    }
+    return count;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BENCHMARK_DOCUMENT_H */
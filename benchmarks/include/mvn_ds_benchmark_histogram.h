@@ -0,0 +1,197 @@
+#ifndef MVN_DS_BENCHMARK_HISTOGRAM_H
+#define MVN_DS_BENCHMARK_HISTOGRAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// log2 of the sub-buckets per power of two; 8 bits keeps every value within 0.4%
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 8
+#define LATENCY_HISTOGRAM_SUB_BUCKETS     ((uint64_t)1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+// Enough buckets to cover every uint64_t value
+#define LATENCY_HISTOGRAM_BUCKETS \
+    ((size_t)LATENCY_HISTOGRAM_SUB_BUCKETS * (64 - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1))
+
+/**
+ * @brief Log-linear latency histogram in the style of HdrHistogram: values below
+ * 2 * LATENCY_HISTOGRAM_SUB_BUCKETS are exact, larger ones share buckets whose width grows
+ * with the value so relative precision stays constant. Recording is O(1) and the memory
+ * footprint is fixed, so any number of samples can be kept. Allocate on the heap (~115 KB).
+ */
+typedef struct latency_histogram_t {
+    uint64_t counts[LATENCY_HISTOGRAM_BUCKETS];
+    uint64_t total_count;
+    uint64_t min;
+    uint64_t max;
+    double   sum;
+} latency_histogram_t;
+
+static inline void latency_histogram_reset(latency_histogram_t *histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->min = UINT64_MAX;
+}
+
+/**
+ * @internal
+ * @brief Index of the highest set bit; value must be non-zero.
+ */
+static inline unsigned latency_histogram_msb(uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (unsigned)index;
+#elif defined(__GNUC__) || defined(__clang__)
+    return 63U - (unsigned)__builtin_clzll(value);
+#else
+    unsigned index = 0;
+    while (value >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+static inline size_t latency_histogram_index(uint64_t value)
+{
+    if (value < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS) {
+        return (size_t)value;
+    }
+    unsigned shift    = latency_histogram_msb(value) - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    uint64_t mantissa = value >> shift; // In [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    return (size_t)(LATENCY_HISTOGRAM_SUB_BUCKETS * (shift + 1) +
+                    (mantissa - LATENCY_HISTOGRAM_SUB_BUCKETS));
+}
+
+/**
+ * @brief Returns the largest value that maps to the same bucket as index.
+ */
+static inline uint64_t latency_histogram_highest_equivalent(size_t index)
+{
+    if (index < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+    uint64_t shift    = index / LATENCY_HISTOGRAM_SUB_BUCKETS - 1;
+    uint64_t mantissa = index % LATENCY_HISTOGRAM_SUB_BUCKETS + LATENCY_HISTOGRAM_SUB_BUCKETS;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+static inline void latency_histogram_record(latency_histogram_t *histogram, uint64_t value)
+{
+    histogram->counts[latency_histogram_index(value)]++;
+    histogram->total_count++;
+    histogram->sum += (double)value;
+    histogram->min = value < histogram->min ? value : histogram->min;
+    histogram->max = value > histogram->max ? value : histogram->max;
+}
+
+/**
+ * @brief Returns the value at a percentile in [0, 100], reported as the top of its bucket
+ * (and never above the recorded maximum), as HdrHistogram does.
+ */
+static inline uint64_t latency_histogram_percentile(const latency_histogram_t *histogram,
+                                                    double                     percentile)
+{
+    if (histogram->total_count == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)((percentile / 100.0) * (double)histogram->total_count + 0.5);
+    target          = target < 1 ? 1 : target;
+    uint64_t seen   = 0;
+    for (size_t index = 0; index < LATENCY_HISTOGRAM_BUCKETS; index++) {
+        seen += histogram->counts[index];
+        if (seen >= target) {
+            uint64_t value = latency_histogram_highest_equivalent(index);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/**
+ * @brief Returns how many recorded values are at least threshold (to bucket precision).
+ */
+static inline uint64_t latency_histogram_count_at_or_above(const latency_histogram_t *histogram,
+                                                           uint64_t                   threshold)
+{
+    uint64_t count = 0;
+    for (size_t index = latency_histogram_index(threshold); index < LATENCY_HISTOGRAM_BUCKETS;
+         index++) {
+        count += histogram->counts[index];
+    }
+    return count;
+}
+
+static inline double latency_histogram_mean(const latency_histogram_t *histogram)
+{
+    return histogram->total_count > 0 ? histogram->sum / (double)histogram->total_count : 0.0;
+}
+
+/**
+ * @brief Writes the percentile distribution in HdrHistogram's text format (value, percentile,
+ * total count, 1/(1-percentile)) so existing plotting tools can read it. Ticks halve the
+ * remaining distance to 100% each time, giving detail in the tail.
+ */
+static inline void latency_histogram_write_distribution(const latency_histogram_t *histogram,
+                                                        FILE                      *out,
+                                                        double value_scale)
+{
+    fprintf(out,
+            "%12s %14s %10s %14s\n\n",
+            "Value",
+            "Percentile",
+            "TotalCount",
+            "1/(1-Percentile)");
+    if (histogram->total_count == 0) {
+        return;
+    }
+    const int ticks_per_half = 5;
+    double    percentile     = 0.0;
+    for (int half = 0; percentile < 100.0 && half < 64; half++) {
+        double remaining = 100.0 / (double)(1ULL << half);
+        for (int tick = 0; tick < ticks_per_half; tick++) {
+            percentile = 100.0 - remaining + remaining / 2.0 * tick / ticks_per_half;
+            uint64_t value = latency_histogram_percentile(histogram, percentile);
+            uint64_t count = (uint64_t)(percentile / 100.0 * (double)histogram->total_count);
+            if (count >= histogram->total_count) {
+                percentile = 100.0;
+                break;
+            }
+            fprintf(out,
+                    "%12.3f %14.12f %10llu %14.2f\n",
+                    (double)value / value_scale,
+                    percentile / 100.0,
+                    (unsigned long long)count,
+                    1.0 / (1.0 - percentile / 100.0));
+        }
+    }
+    fprintf(out,
+            "%12.3f %14.12f %10llu\n",
+            (double)histogram->max / value_scale,
+            1.0,
+            (unsigned long long)histogram->total_count);
+    fprintf(out,
+            "#[Mean    = %12.3f, Max        = %12.3f]\n"
+            "#[Total count    = %12llu]\n",
+            latency_histogram_mean(histogram) / value_scale,
+            (double)histogram->max / value_scale,
+            (unsigned long long)histogram->total_count);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BENCHMARK_HISTOGRAM_H */
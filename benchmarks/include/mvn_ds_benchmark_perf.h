@@ -0,0 +1,194 @@
+#ifndef MVN_DS_BENCHMARK_PERF_H
+#define MVN_DS_BENCHMARK_PERF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Hardware events counted with --perf. Each is opened on its own, so a PMU that lacks
+ * one event (common for dTLB on virtual machines) still reports the others.
+ */
+typedef enum {
+    BENCHMARK_PERF_INSTRUCTIONS,
+    BENCHMARK_PERF_CYCLES,
+    BENCHMARK_PERF_L1D_MISSES,
+    BENCHMARK_PERF_LLC_MISSES,
+    BENCHMARK_PERF_BRANCH_MISSES,
+    BENCHMARK_PERF_DTLB_MISSES,
+    BENCHMARK_PERF_COUNTERS
+} benchmark_perf_counter_t;
+
+/**
+ * @brief Snapshot of all counters, scaled for multiplexing by time_enabled / time_running.
+ */
+typedef struct benchmark_perf_values_t {
+    double values[BENCHMARK_PERF_COUNTERS];
+} benchmark_perf_values_t;
+
+/**
+ * @brief Open counter file descriptors for the calling thread; fd -1 marks an unavailable one.
+ */
+typedef struct benchmark_perf_t {
+    int  fds[BENCHMARK_PERF_COUNTERS];
+    bool available; /**< At least one counter opened. */
+    int  error;     /**< errno of the first failed open, for the diagnostic. */
+} benchmark_perf_t;
+
+// Column and JSON names, in benchmark_perf_counter_t order
+static const char *const benchmark_perf_names[BENCHMARK_PERF_COUNTERS] = {
+    "instructions", "cycles", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"};
+
+#if defined(__linux__)
+/**
+ * @internal
+ * @brief Opens one user-space-only counter on the calling thread, enabled immediately.
+ * Worker threads (e.g. mvn_pool) are not included.
+ */
+static inline int benchmark_perf_open_event(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/**
+ * @brief Initializes perf with no counters open.
+ */
+static inline void benchmark_perf_open_none(benchmark_perf_t *perf)
+{
+    for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+        perf->fds[index] = -1;
+    }
+    perf->available = false;
+    perf->error     = 0;
+}
+
+/**
+ * @brief Opens the hardware counters. Never fails: counters that cannot be opened (no PMU,
+ * containers, perf_event_paranoid, non-Linux) are left out and reported as unavailable.
+ */
+static inline void benchmark_perf_open(benchmark_perf_t *perf)
+{
+    benchmark_perf_open_none(perf);
+#if defined(__linux__)
+    const uint64_t read_miss = ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const uint32_t types[BENCHMARK_PERF_COUNTERS] = {PERF_TYPE_HARDWARE,
+                                                     PERF_TYPE_HARDWARE,
+                                                     PERF_TYPE_HW_CACHE,
+                                                     PERF_TYPE_HARDWARE,
+                                                     PERF_TYPE_HARDWARE,
+                                                     PERF_TYPE_HW_CACHE};
+    const uint64_t configs[BENCHMARK_PERF_COUNTERS] = {
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_CACHE_L1D | read_miss,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB | read_miss};
+    for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+        perf->fds[index] = benchmark_perf_open_event(types[index], configs[index]);
+        if (perf->fds[index] >= 0) {
+            perf->available = true;
+        } else if (perf->error == 0) {
+            perf->error = errno;
+        }
+    }
+#endif
+}
+
+static inline void benchmark_perf_close(benchmark_perf_t *perf)
+{
+#if defined(__linux__)
+    for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+        if (perf->fds[index] >= 0) {
+            close(perf->fds[index]);
+        }
+        perf->fds[index] = -1;
+    }
+#endif
+    perf->available = false;
+}
+
+/**
+ * @brief Reads all counters; unavailable ones read as 0. Costs one syscall per open counter.
+ */
+static inline void benchmark_perf_read(const benchmark_perf_t *perf,
+                                       benchmark_perf_values_t *values)
+{
+    memset(values, 0, sizeof(*values));
+#if defined(__linux__)
+    for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+        uint64_t data[3]; // value, time_enabled, time_running
+        if (perf->fds[index] < 0 || read(perf->fds[index], data, sizeof(data)) != sizeof(data)) {
+            continue;
+        }
+        // Scale up if the kernel multiplexed this counter with others
+        values->values[index] = data[2] > 0 && data[2] < data[1]
+                                    ? (double)data[0] * ((double)data[1] / (double)data[2])
+                                    : (double)data[0];
+    }
+#else
+    (void)perf;
+#endif
+}
+
+/**
+ * @brief Whether counter index was opened.
+ */
+static inline bool benchmark_perf_has(const benchmark_perf_t *perf, size_t index)
+{
+    return perf->fds[index] >= 0;
+}
+
+/**
+ * @brief Returns a one-line explanation of why counters are missing, for the report.
+ */
+static inline const char *benchmark_perf_diagnostic(const benchmark_perf_t *perf)
+{
+#if defined(__linux__)
+    switch (perf->error) {
+        case 0:
+            return "all counters available";
+        case EACCES:
+        case EPERM:
+            return "permission denied (check /proc/sys/kernel/perf_event_paranoid)";
+        case ENOENT:
+        case EOPNOTSUPP:
+            return "not supported by this CPU or virtual machine";
+        case ENOSYS:
+            return "perf_event_open is not available (seccomp or container)";
+        default:
+            return strerror(perf->error);
+    }
+#else
+    (void)perf;
+    return "perf_event_open requires Linux";
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BENCHMARK_PERF_H */
@@ -1,32 +1,845 @@
 #ifndef MVN_DS_BENCHMARK_UTILS_H
 #define MVN_DS_BENCHMARK_UTILS_H
 
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
 #include <time.h>
+#endif
+
+#include "mvn_ds_benchmark_perf.h"
+
+// Libraries built with MVN_DS_ALLOC_STATS export the flag, enabling allocs/op reporting
+#ifdef MVN_DS_ALLOC_STATS
+#include "mvn_ds/mvn_ds_alloc.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+// Default number of timed samples per benchmark
+#define BENCHMARK_DEFAULT_REPETITIONS 15
+// Default minimum duration of one sample; iteration counts are calibrated to reach it
+#define BENCHMARK_DEFAULT_MIN_TIME_MS 20.0
+// Default number of untimed samples run after calibration
+#define BENCHMARK_DEFAULT_WARMUP_RUNS 1
+// Upper bound for calibrated iteration counts
+#define BENCHMARK_MAX_ITERATIONS ((size_t)1 << 30)
+
+/**
+ * @brief Output format for benchmark results.
+ */
+typedef enum {
+    BENCHMARK_FORMAT_TEXT, /**< Human-readable table only. */
+    BENCHMARK_FORMAT_JSON, /**< JSON document including the raw samples. */
+    BENCHMARK_FORMAT_CSV   /**< One CSV row per benchmark. */
+} benchmark_format_t;
+
+/**
+ * @brief State handed to a benchmark body for one sample.
+ * The body must run its operation state->iterations times.
+ */
+typedef struct benchmark_state_t {
+    size_t   iterations;    /**< Number of operations to run in this sample. */
+    void    *context;       /**< User context passed to benchmark_run. */
+    uint64_t paused_ns;     /**< Time spent paused during the sample. */
+    uint64_t pause_start;   /**< Timestamp of the pending pause, or 0. */
+    uint64_t paused_allocs; /**< Library allocations made while paused. */
+    uint64_t pause_allocs;  /**< Allocation count when the pending pause began. */
+    const benchmark_perf_t *perf; /**< Hardware counters, or NULL when not counting. */
+    benchmark_perf_values_t paused_counters; /**< Counter increments while paused. */
+    benchmark_perf_values_t pause_counters;  /**< Counter values when the pending pause began. */
+} benchmark_state_t;
+
+// Benchmark body: runs the measured operation state->iterations times.
+typedef void (*benchmark_fn)(benchmark_state_t *state);
+
+/**
+ * @brief Statistics for one benchmark. All times are nanoseconds per operation.
+ */
+typedef struct benchmark_result_t {
+    char   *name;        /**< Benchmark name (owned). */
+    size_t  iterations;  /**< Operations per sample after calibration. */
+    size_t  repetitions; /**< Number of timed samples. */
+    double *samples;     /**< Per-sample ns/op, in run order (owned). */
+    double  min;
+    double  median;
+    double  p90;
+    double  p99;
+    double  mean;
+    double  stddev;
+    double  allocs_per_op;  /**< mvn_ds allocations per operation (0 without MVN_DS_ALLOC_STATS). */
+    double  per_element_ns; /**< Median cost per element over a baseline; -1 if not reported. */
+    double  counters_per_op[BENCHMARK_PERF_COUNTERS]; /**< Per operation; -1 if not counted. */
+} benchmark_result_t;
+
+/**
+ * @brief A set of benchmarks sharing command-line configuration and output.
+ */
+typedef struct benchmark_suite_t {
+    const char         *suite_name;   /**< Executable name, used in machine-readable output. */
+    benchmark_format_t  format;       /**< --format=text|json|csv */
+    const char         *out_path;     /**< --out=PATH; NULL writes machine output to stdout. */
+    const char         *filter;       /**< --filter=SUBSTRING; NULL runs everything. */
+    size_t              repetitions;  /**< --repetitions=N */
+    double              min_time_ms;  /**< --min-time-ms=MS */
+    size_t              warmup_runs;  /**< --warmup=N */
+    benchmark_perf_t    perf;         /**< --perf: hardware counters (perf.available). */
+    FILE               *report;       /**< Destination of the human-readable table. */
+    bool                header_done;  /**< Whether the table header has been printed. */
+    benchmark_result_t *results;      /**< Results in run order. */
+    size_t              result_count; /**< Number of results. */
+} benchmark_suite_t;
+
+// --- Timing ---
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds (wall clock, not CPU time).
+ */
+static inline uint64_t benchmark_now_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Returns the number of mvn_ds allocations so far, or 0 without MVN_DS_ALLOC_STATS.
+ */
+static inline uint64_t benchmark_alloc_count(void)
+{
+#ifdef MVN_DS_ALLOC_STATS
+    return mvn_ds_alloc_count();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Stops the sample clock, e.g. around per-sample setup or teardown.
+ * Each pause costs two clock reads, so avoid pausing inside the iteration loop.
+ * Allocations made while paused are not counted either.
+ */
+static inline void benchmark_pause(benchmark_state_t *state)
+{
+    if (state->perf != NULL) {
+        benchmark_perf_read(state->perf, &state->pause_counters);
+    }
+    state->pause_start  = benchmark_now_ns();
+    state->pause_allocs = benchmark_alloc_count();
+}
+
+/**
+ * @brief Restarts the sample clock after benchmark_pause.
+ */
+static inline void benchmark_resume(benchmark_state_t *state)
+{
+    if (state->pause_start != 0) {
+        state->paused_allocs += benchmark_alloc_count() - state->pause_allocs;
+        state->paused_ns += benchmark_now_ns() - state->pause_start;
+        state->pause_start = 0;
+        if (state->perf != NULL) {
+            benchmark_perf_values_t now;
+            benchmark_perf_read(state->perf, &now);
+            for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+                state->paused_counters.values[index] +=
+                    now.values[index] - state->pause_counters.values[index];
+            }
+        }
+    }
+}
+
+// --- Optimization Barriers ---
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#pragma intrinsic(_ReadWriteBarrier)
+// Sink for benchmark_do_not_optimize on compilers without GNU inline assembly
+static volatile const void *benchmark_sink;
+#endif
+
+/**
+ * @brief Makes the compiler assume value's address escapes and its memory is read, so the
+ * computation that produced it cannot be removed (Google Benchmark's DoNotOptimize).
+ * Costs no instructions beyond storing the value to memory.
+ */
+static inline void benchmark_do_not_optimize(const void *value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    benchmark_sink = value;
+    _ReadWriteBarrier();
+#else
+    __asm__ __volatile__("" : : "r"(value) : "memory");
+#endif
+}
+
+/**
+ * @brief Makes the compiler assume all memory may have been read and written, so stores are
+ * not sunk out of the loop and loads are not hoisted into it (Google Benchmark's
+ * ClobberMemory).
+ */
+static inline void benchmark_clobber_memory(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    __asm__ __volatile__("" : : : "memory");
+#endif
+}
+
+// --- Suite ---
+
+/**
+ * @brief Prints command-line usage.
+ */
+static inline void benchmark_print_usage(const char *program)
+{
+    printf("Usage: %s [options]\n"
+           "  --format=text|json|csv  Machine-readable output format (default: text)\n"
+           "  --out=PATH              Write machine-readable output to PATH (default: stdout)\n"
+           "  --filter=SUBSTRING      Only run benchmarks whose name contains SUBSTRING\n"
+           "  --repetitions=N         Timed samples per benchmark (default: %d)\n"
+           "  --min-time-ms=MS        Minimum duration of one sample (default: %.0f)\n"
+           "  --warmup=N              Untimed samples after calibration (default: %d)\n"
+           "  --perf                  Count instructions, cycles and misses (Linux perf_event)\n",
+           program,
+           BENCHMARK_DEFAULT_REPETITIONS,
+           BENCHMARK_DEFAULT_MIN_TIME_MS,
+           BENCHMARK_DEFAULT_WARMUP_RUNS);
+}
+
+/**
+ * @brief Removes "--name=value" from argv and returns value, or NULL if absent.
+ * Call before benchmark_suite_init so benchmark-specific options are not rejected as unknown.
+ * If the option is repeated, the last occurrence wins.
+ */
+static inline const char *benchmark_take_option(int *argc, char **argv, const char *name)
+{
+    const char *value       = NULL;
+    size_t      name_length = strlen(name);
+    int         kept        = 1;
+    for (int index = 1; index < *argc; index++) {
+        const char *arg = argv[index];
+        if (strncmp(arg, "--", 2) == 0 && strncmp(arg + 2, name, name_length) == 0 &&
+            arg[2 + name_length] == '=') {
+            value = arg + 3 + name_length;
+        } else {
+            argv[kept++] = argv[index];
+        }
+    }
+    *argc = kept;
+    return value;
+}
+
+/**
+ * @brief benchmark_take_option for a size; value is left unchanged if the option is absent.
+ */
+static inline void
+benchmark_take_size_option(int *argc, char **argv, const char *name, size_t *value)
+{
+    const char *text = benchmark_take_option(argc, argv, name);
+    if (text != NULL) {
+        *value = (size_t)strtoull(text, NULL, 10);
+    }
+}
+
+/**
+ * @brief benchmark_take_option for a double; value is left unchanged if the option is absent.
+ */
+static inline void
+benchmark_take_double_option(int *argc, char **argv, const char *name, double *value)
+{
+    const char *text = benchmark_take_option(argc, argv, name);
+    if (text != NULL) {
+        *value = strtod(text, NULL);
+    }
+}
+
+/**
+ * @brief Initializes a suite from the command line.
+ * @return true on success, false on an invalid argument or --help (the caller should exit).
+ */
+static inline bool benchmark_suite_init(benchmark_suite_t *suite, int argc, char **argv)
+{
+    memset(suite, 0, sizeof(*suite));
+    suite->suite_name  = (argc > 0 && argv[0] != NULL) ? argv[0] : "benchmark";
+    suite->format      = BENCHMARK_FORMAT_TEXT;
+    suite->repetitions = BENCHMARK_DEFAULT_REPETITIONS;
+    suite->min_time_ms = BENCHMARK_DEFAULT_MIN_TIME_MS;
+    suite->warmup_runs = BENCHMARK_DEFAULT_WARMUP_RUNS;
+    benchmark_perf_open_none(&suite->perf);
+    bool perf = false;
+
+    // Strip the directory from the executable name
+    const char *slash = strrchr(suite->suite_name, '/');
+    const char *back  = strrchr(suite->suite_name, '\\');
+    if (back != NULL && (slash == NULL || back > slash)) {
+        slash = back;
+    }
+    if (slash != NULL) {
+        suite->suite_name = slash + 1;
+    }
+
+    for (int index = 1; index < argc; index++) {
+        const char *arg = argv[index];
+        if (strncmp(arg, "--format=", 9) == 0) {
+            const char *value = arg + 9;
+            if (strcmp(value, "json") == 0) {
+                suite->format = BENCHMARK_FORMAT_JSON;
+            } else if (strcmp(value, "csv") == 0) {
+                suite->format = BENCHMARK_FORMAT_CSV;
+            } else if (strcmp(value, "text") == 0) {
+                suite->format = BENCHMARK_FORMAT_TEXT;
+            } else {
+                fprintf(stderr, "Unknown format '%s'\n", value);
+                return false;
+            }
+        } else if (strncmp(arg, "--out=", 6) == 0) {
+            suite->out_path = arg + 6;
+        } else if (strncmp(arg, "--filter=", 9) == 0) {
+            suite->filter = arg + 9;
+        } else if (strncmp(arg, "--repetitions=", 14) == 0) {
+            suite->repetitions = (size_t)strtoul(arg + 14, NULL, 10);
+        } else if (strncmp(arg, "--min-time-ms=", 14) == 0) {
+            suite->min_time_ms = strtod(arg + 14, NULL);
+        } else if (strncmp(arg, "--warmup=", 9) == 0) {
+            suite->warmup_runs = (size_t)strtoul(arg + 9, NULL, 10);
+        } else if (strcmp(arg, "--perf") == 0) {
+            perf = true;
+        } else {
+            if (strcmp(arg, "--help") != 0) {
+                fprintf(stderr, "Unknown argument '%s'\n", arg);
+            }
+            benchmark_print_usage(suite->suite_name);
+            return false;
+        }
+    }
+    if (suite->repetitions == 0) {
+        suite->repetitions = 1;
+    }
+    if (suite->min_time_ms < 0.0) {
+        suite->min_time_ms = 0.0;
+    }
+    // Keep stdout clean when it carries machine-readable output
+    suite->report = (suite->format != BENCHMARK_FORMAT_TEXT && suite->out_path == NULL) ? stderr
+                                                                                          : stdout;
+    if (perf) {
+        benchmark_perf_open(&suite->perf);
+        if (!suite->perf.available) {
+            fprintf(suite->report,
+                    "Hardware counters unavailable (%s); reporting wall time only\n",
+                    benchmark_perf_diagnostic(&suite->perf));
+        } else if (suite->perf.error != 0) {
+            fprintf(suite->report,
+                    "Some hardware counters unavailable (%s):",
+                    benchmark_perf_diagnostic(&suite->perf));
+            for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+                if (!benchmark_perf_has(&suite->perf, index)) {
+                    fprintf(suite->report, " %s", benchmark_perf_names[index]);
+                }
+            }
+            fprintf(suite->report, "\n");
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Event counts of one sample, excluding paused spans.
+ */
+typedef struct benchmark_sample_counts_t {
+    uint64_t                allocations; /**< mvn_ds allocations. */
+    benchmark_perf_values_t counters;    /**< Hardware counter increments (if perf was given). */
+} benchmark_sample_counts_t;
+
+/**
+ * @internal
+ * @brief Runs one sample and returns its duration in nanoseconds, excluding paused time.
+ * If counts is not NULL, it receives the unpaused allocation count and, if perf is not NULL,
+ * the unpaused hardware counter increments.
+ */
+static inline uint64_t benchmark_run_sample(benchmark_fn               body,
+                                            void                      *context,
+                                            size_t                     iterations,
+                                            const benchmark_perf_t    *perf,
+                                            benchmark_sample_counts_t *counts)
+{
+    benchmark_state_t state;
+    memset(&state, 0, sizeof(state));
+    state.iterations = iterations;
+    state.context    = context;
+    state.perf       = counts != NULL ? perf : NULL;
+
+    benchmark_perf_values_t counters_before;
+    if (state.perf != NULL) {
+        benchmark_perf_read(state.perf, &counters_before);
+    }
+    uint64_t allocs_before = benchmark_alloc_count();
+    uint64_t start         = benchmark_now_ns();
+    body(&state);
+    uint64_t elapsed = benchmark_now_ns() - start;
+    if (counts != NULL) {
+        counts->allocations = benchmark_alloc_count() - allocs_before - state.paused_allocs;
+        memset(&counts->counters, 0, sizeof(counts->counters));
+    }
+    if (state.perf != NULL) {
+        benchmark_perf_values_t counters_after;
+        benchmark_perf_read(state.perf, &counters_after);
+        for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+            counts->counters.values[index] = counters_after.values[index] -
+                                             counters_before.values[index] -
+                                             state.paused_counters.values[index];
+        }
+    }
+    return elapsed > state.paused_ns ? elapsed - state.paused_ns : 0;
+}
+
+/**
+ * @internal
+ * @brief qsort comparator for doubles.
+ */
+static inline int benchmark_compare_doubles(const void *left, const void *right)
+{
+    double lhs = *(const double *)left;
+    double rhs = *(const double *)right;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @internal
+ * @brief Linearly interpolated percentile of sorted values (fraction in [0, 1]).
+ */
+static inline double benchmark_percentile(const double *sorted, size_t count, double fraction)
+{
+    double position = fraction * (double)(count - 1);
+    size_t lower    = (size_t)position;
+    if (lower + 1 >= count) {
+        return sorted[count - 1];
+    }
+    double weight = position - (double)lower;
+    return sorted[lower] * (1.0 - weight) + sorted[lower + 1] * weight;
+}
+
+/**
+ * @internal
+ * @brief Formats nanoseconds with a readable unit.
+ */
+static inline const char *benchmark_format_ns(double nanoseconds, char *buffer, size_t size)
+{
+    if (nanoseconds < 1e3) {
+        snprintf(buffer, size, "%.2f ns", nanoseconds);
+    } else if (nanoseconds < 1e6) {
+        snprintf(buffer, size, "%.2f us", nanoseconds / 1e3);
+    } else if (nanoseconds < 1e9) {
+        snprintf(buffer, size, "%.2f ms", nanoseconds / 1e6);
+    } else {
+        snprintf(buffer, size, "%.2f s", nanoseconds / 1e9);
+    }
+    return buffer;
+}
+
+/**
+ * @internal
+ * @brief Prints the per-operation hardware counter columns; "-" marks uncounted events.
+ */
+static inline void benchmark_print_counters(FILE *out, const benchmark_result_t *result)
+{
+    const double *counters = result->counters_per_op;
+    for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+        if (index == BENCHMARK_PERF_L1D_MISSES) {
+            // IPC sits between the instruction/cycle counts and the miss counts
+            if (counters[BENCHMARK_PERF_INSTRUCTIONS] >= 0.0 &&
+                counters[BENCHMARK_PERF_CYCLES] > 0.0) {
+                fprintf(out,
+                        " %6.2f",
+                        counters[BENCHMARK_PERF_INSTRUCTIONS] / counters[BENCHMARK_PERF_CYCLES]);
+            } else {
+                fprintf(out, " %6s", "-");
+            }
+        }
+        if (counters[index] >= 0.0) {
+            fprintf(out, " %10.2f", counters[index]);
+        } else {
+            fprintf(out, " %10s", "-");
+        }
+    }
+}
+
+/**
+ * @brief Calibrates, warms up and measures one benchmark, then prints its row.
+ * The iteration count starts at 1 and grows until one sample lasts at least min_time_ms;
+ * warmup samples then run untimed, followed by the timed repetitions.
+ * @param suite The suite (results are appended to it).
+ * @param name Benchmark name, unique within the suite.
+ * @param body The measured body.
+ * @param context Passed to body as state->context.
+ * @return The result, or NULL if the benchmark was filtered out or on allocation failure.
+ */
+static inline const benchmark_result_t *
+benchmark_run(benchmark_suite_t *suite, const char *name, benchmark_fn body, void *context)
+{
+    if (suite->filter != NULL && strstr(name, suite->filter) == NULL) {
+        return NULL;
+    }
+
+    // Calibrate
+    double   min_time_ns = suite->min_time_ms * 1e6;
+    size_t   iterations  = 1;
+    uint64_t elapsed     = benchmark_run_sample(body, context, iterations, NULL, NULL);
+    while ((double)elapsed < min_time_ns && iterations < BENCHMARK_MAX_ITERATIONS) {
+        // Aim 20% past the target, growing at least 2x and at most 100x per step
+        double scale = elapsed > 0 ? (min_time_ns * 1.2) / (double)elapsed : 100.0;
+        scale        = scale < 2.0 ? 2.0 : (scale > 100.0 ? 100.0 : scale);
+        iterations   = (size_t)((double)iterations * scale);
+        if (iterations > BENCHMARK_MAX_ITERATIONS) {
+            iterations = BENCHMARK_MAX_ITERATIONS;
+        }
+        elapsed = benchmark_run_sample(body, context, iterations, NULL, NULL);
+    }
+
+    for (size_t warmup = 0; warmup < suite->warmup_runs; warmup++) {
+        benchmark_run_sample(body, context, iterations, NULL, NULL);
+    }
+
+    // Measure
+    double *samples = (double *)malloc(suite->repetitions * sizeof(double));
+    double *sorted  = (double *)malloc(suite->repetitions * sizeof(double));
+    char   *owned   = (char *)malloc(strlen(name) + 1);
+    benchmark_result_t *grown = (benchmark_result_t *)realloc(
+        suite->results, (suite->result_count + 1) * sizeof(benchmark_result_t));
+    if (grown != NULL) {
+        suite->results = grown;
+    }
+    if (samples == NULL || sorted == NULL || owned == NULL || grown == NULL) {
+        fprintf(stderr, "Out of memory while running %s\n", name);
+        free(samples);
+        free(sorted);
+        free(owned);
+        return NULL;
+    }
+    const benchmark_perf_t *perf        = suite->perf.available ? &suite->perf : NULL;
+    uint64_t                allocations = 0;
+    double                  counters[BENCHMARK_PERF_COUNTERS] = {0};
+    for (size_t rep = 0; rep < suite->repetitions; rep++) {
+        benchmark_sample_counts_t counts;
+        uint64_t elapsed_ns = benchmark_run_sample(body, context, iterations, perf, &counts);
+        samples[rep]        = (double)elapsed_ns / (double)iterations;
+        allocations += counts.allocations;
+        for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+            counters[index] += counts.counters.values[index];
+        }
+    }
+
+    // Summarize
+    benchmark_result_t *result = &suite->results[suite->result_count++];
+    memcpy(owned, name, strlen(name) + 1);
+    memcpy(sorted, samples, suite->repetitions * sizeof(double));
+    qsort(sorted, suite->repetitions, sizeof(double), benchmark_compare_doubles);
+
+    double sum = 0.0;
+    for (size_t rep = 0; rep < suite->repetitions; rep++) {
+        sum += samples[rep];
+    }
+    double mean     = sum / (double)suite->repetitions;
+    double variance = 0.0;
+    for (size_t rep = 0; rep < suite->repetitions; rep++) {
+        variance += (samples[rep] - mean) * (samples[rep] - mean);
+    }
+    variance = suite->repetitions > 1 ? variance / (double)(suite->repetitions - 1) : 0.0;
+
+    result->name        = owned;
+    result->iterations  = iterations;
+    result->repetitions = suite->repetitions;
+    result->samples     = samples;
+    result->min         = sorted[0];
+    result->median      = benchmark_percentile(sorted, suite->repetitions, 0.50);
+    result->p90         = benchmark_percentile(sorted, suite->repetitions, 0.90);
+    result->p99         = benchmark_percentile(sorted, suite->repetitions, 0.99);
+    result->mean        = mean;
+    result->stddev      = sqrt(variance);
+    result->allocs_per_op =
+        (double)allocations / ((double)iterations * (double)suite->repetitions);
+    for (size_t index = 0; index < BENCHMARK_PERF_COUNTERS; index++) {
+        result->counters_per_op[index] =
+            benchmark_perf_has(&suite->perf, index)
+                ? counters[index] / ((double)iterations * (double)suite->repetitions)
+                : -1.0;
+    }
+    result->per_element_ns = -1.0;
+    free(sorted);
+
+    if (!suite->header_done) {
+        fprintf(suite->report,
+                "%-52s %12s %10s %10s %10s %10s %10s",
+                "Benchmark",
+                "Iterations",
+                "Min",
+                "Median",
+                "P90",
+                "P99",
+                "StdDev");
+#ifdef MVN_DS_ALLOC_STATS
+        fprintf(suite->report, " %10s", "Allocs/op");
+#endif
+        if (suite->perf.available) {
+            fprintf(suite->report,
+                    " %10s %10s %6s %10s %10s %10s %10s",
+                    "Instr/op",
+                    "Cycles/op",
+                    "IPC",
+                    "L1D-mis/op",
+                    "LLC-mis/op",
+                    "Br-mis/op",
+                    "TLB-mis/op");
+        }
+        fprintf(suite->report, "\n");
+        suite->header_done = true;
+    }
+    char min_text[32];
+    char median_text[32];
+    char p90_text[32];
+    char p99_text[32];
+    char stddev_text[32];
+    fprintf(suite->report,
+            "%-52s %12zu %10s %10s %10s %10s %10s",
+            name,
+            iterations,
+            benchmark_format_ns(result->min, min_text, sizeof(min_text)),
+            benchmark_format_ns(result->median, median_text, sizeof(median_text)),
+            benchmark_format_ns(result->p90, p90_text, sizeof(p90_text)),
+            benchmark_format_ns(result->p99, p99_text, sizeof(p99_text)),
+            benchmark_format_ns(result->stddev, stddev_text, sizeof(stddev_text)));
+#ifdef MVN_DS_ALLOC_STATS
+    fprintf(suite->report, " %10.2f", result->allocs_per_op);
+#endif
+    if (suite->perf.available) {
+        benchmark_print_counters(suite->report, result);
+    }
+    fprintf(suite->report, "\n");
+    fflush(suite->report);
+    return result;
+}
+
+/**
+ * @brief Records what each element adds to a result's median over a baseline (e.g. the same
+ * operation on an empty container) and prints it with both medians.
+ * The cost is clamped at 0, since noise can make a tiny difference negative. It is written to
+ * JSON and CSV output as per_element_ns.
+ * @param result A result just returned by benchmark_run on this suite.
+ */
+static inline void benchmark_report_per_element(benchmark_suite_t        *suite,
+                                                const benchmark_result_t *result,
+                                                double                    baseline_ns,
+                                                size_t                    elements)
+{
+    if (result == NULL || elements == 0) {
+        return;
+    }
+    double cost = (result->median - baseline_ns) / (double)elements;
+    cost        = cost > 0.0 ? cost : 0.0;
+    suite->results[result - suite->results].per_element_ns = cost;
+
+    char median_text[32];
+    char baseline_text[32];
+    fprintf(suite->report,
+            "  -> %.2f ns per element (median %s, baseline %s, %zu elements)\n",
+            cost,
+            benchmark_format_ns(result->median, median_text, sizeof(median_text)),
+            benchmark_format_ns(baseline_ns, baseline_text, sizeof(baseline_text)),
+            elements);
+}
+
+/**
+ * @internal
+ * @brief Writes a JSON string literal, escaping quotes, backslashes and control characters.
+ */
+static inline void benchmark_write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const char *cursor = text; *cursor != '\0'; cursor++) {
+        unsigned char character = (unsigned char)*cursor;
+        if (character == '"' || character == '\\') {
+            fprintf(out, "\\%c", character);
+        } else if (character < 0x20) {
+            fprintf(out, "\\u%04x", character);
+        } else {
+            fputc(character, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @internal
+ * @brief Writes all results as JSON, including the raw per-sample times.
+ */
+static inline void benchmark_write_json(const benchmark_suite_t *suite, FILE *out)
+{
+    fprintf(out, "{\n  \"suite\": ");
+    benchmark_write_json_string(out, suite->suite_name);
+    fprintf(out,
+            ",\n  \"context\": {\"timer\": \"monotonic\", \"unit\": \"ns/op\", "
+            "\"repetitions\": %zu, \"min_time_ms\": %g, \"warmup_runs\": %zu, "
+            "\"alloc_stats\": %s, \"perf_counters\": %s},\n",
+            suite->repetitions,
+            suite->min_time_ms,
+            suite->warmup_runs,
+#ifdef MVN_DS_ALLOC_STATS
+            "true",
+#else
+            "false",
+#endif
+            suite->perf.available ? "true" : "false");
+    fprintf(out, "  \"benchmarks\": [");
+    for (size_t index = 0; index < suite->result_count; index++) {
+        const benchmark_result_t *result = &suite->results[index];
+        fprintf(out, "%s\n    {\"name\": ", index > 0 ? "," : "");
+        benchmark_write_json_string(out, result->name);
+        fprintf(out,
+                ", \"iterations\": %zu, \"repetitions\": %zu, \"min\": %.3f, \"median\": %.3f, "
+                "\"p90\": %.3f, \"p99\": %.3f, \"mean\": %.3f, \"stddev\": %.3f, "
+                "\"allocs_per_op\": %.3f, \"samples\": [",
+                result->iterations,
+                result->repetitions,
+                result->min,
+                result->median,
+                result->p90,
+                result->p99,
+                result->mean,
+                result->stddev,
+                result->allocs_per_op);
+        for (size_t rep = 0; rep < result->repetitions; rep++) {
+            fprintf(out, "%s%.3f", rep > 0 ? ", " : "", result->samples[rep]);
+        }
+        fprintf(out, "]");
+        if (result->per_element_ns >= 0.0) {
+            fprintf(out, ", \"per_element_ns\": %.3f", result->per_element_ns);
+        }
+        if (suite->perf.available) {
+            // Per-operation counts; null for events the PMU could not count
+            fprintf(out, ", \"counters_per_op\": {");
+            for (size_t counter = 0; counter < BENCHMARK_PERF_COUNTERS; counter++) {
+                fprintf(out, "%s\"%s\": ", counter > 0 ? ", " : "", benchmark_perf_names[counter]);
+                if (result->counters_per_op[counter] >= 0.0) {
+                    fprintf(out, "%.3f", result->counters_per_op[counter]);
+                } else {
+                    fprintf(out, "null");
+                }
+            }
+            fprintf(out, "}");
+        }
+        fprintf(out, "}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
 /**
- * @brief Starts a timer and returns the start time.
- * @return The start time as a `clock_t` value.
+ * @internal
+ * @brief Writes one CSV row per result. Quotes in names are doubled.
  */
-static inline clock_t benchmark_start(void)
+static inline void benchmark_write_csv(const benchmark_suite_t *suite, FILE *out)
 {
-    return clock();
+    fprintf(out, "suite,name,iterations,repetitions,min_ns,median_ns,p90_ns,p99_ns,mean_ns,"
+                 "stddev_ns,allocs_per_op,per_element_ns");
+    if (suite->perf.available) {
+        for (size_t counter = 0; counter < BENCHMARK_PERF_COUNTERS; counter++) {
+            fprintf(out, ",%s_per_op", benchmark_perf_names[counter]);
+        }
+    }
+    fprintf(out, "\n");
+    for (size_t index = 0; index < suite->result_count; index++) {
+        const benchmark_result_t *result = &suite->results[index];
+        fprintf(out, "%s,\"", suite->suite_name);
+        for (const char *cursor = result->name; *cursor != '\0'; cursor++) {
+            if (*cursor == '"') {
+                fputc('"', out);
+            }
+            fputc(*cursor, out);
+        }
+        fprintf(out,
+                "\",%zu,%zu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f",
+                result->iterations,
+                result->repetitions,
+                result->min,
+                result->median,
+                result->p90,
+                result->p99,
+                result->mean,
+                result->stddev,
+                result->allocs_per_op);
+        // Left empty when the benchmark reports no per-element cost
+        if (result->per_element_ns >= 0.0) {
+            fprintf(out, ",%.3f", result->per_element_ns);
+        } else {
+            fprintf(out, ",");
+        }
+        if (suite->perf.available) {
+            // Uncounted events are left empty
+            for (size_t counter = 0; counter < BENCHMARK_PERF_COUNTERS; counter++) {
+                if (result->counters_per_op[counter] >= 0.0) {
+                    fprintf(out, ",%.3f", result->counters_per_op[counter]);
+                } else {
+                    fprintf(out, ",");
+                }
+            }
+        }
+        fprintf(out, "\n");
+    }
 }
 
 /**
- * @brief Ends a timer and prints the elapsed time in milliseconds.
- * @param start The start time returned by `benchmark_start`.
- * @param label A label to identify the benchmark.
+ * @brief Writes machine-readable output (if requested) and frees the suite's results.
+ * @return 0 on success, 1 if the output file could not be written (use as the exit code).
  */
-static inline void benchmark_end(clock_t start, const char *label)
+static inline int benchmark_suite_finish(benchmark_suite_t *suite)
 {
-    clock_t end        = clock();
-    double  elapsed_ms = ((double)(end - start) / CLOCKS_PER_SEC) * 1000.0;
-    printf("%s: %.3f ms\n", label, elapsed_ms);
+    int status = 0;
+    if (suite->format != BENCHMARK_FORMAT_TEXT) {
+        FILE *out = suite->out_path != NULL ? fopen(suite->out_path, "w") : stdout;
+        if (out == NULL) {
+            fprintf(stderr, "Failed to open %s for writing\n", suite->out_path);
+            status = 1;
+        } else {
+            if (suite->format == BENCHMARK_FORMAT_JSON) {
+                benchmark_write_json(suite, out);
+            } else {
+                benchmark_write_csv(suite, out);
+            }
+            if (out != stdout && fclose(out) != 0) {
+                status = 1;
+            }
+        }
+    }
+    for (size_t index = 0; index < suite->result_count; index++) {
+        free(suite->results[index].name);
+        free(suite->results[index].samples);
+    }
+    free(suite->results);
+    suite->results      = NULL;
+    suite->result_count = 0;
+    benchmark_perf_close(&suite->perf);
+    return status;
 }
 
 #ifdef __cplusplus
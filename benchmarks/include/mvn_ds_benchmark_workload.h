@@ -0,0 +1,167 @@
+#ifndef MVN_DS_BENCHMARK_WORKLOAD_H
+#define MVN_DS_BENCHMARK_WORKLOAD_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Skew used for Zipfian workloads (the YCSB default)
+#define WORKLOAD_ZIPF_THETA 0.99
+
+/**
+ * @brief Access distribution for generated index sequences.
+ */
+typedef enum {
+    WORKLOAD_UNIFORM, /**< Every index equally likely. */
+    WORKLOAD_ZIPFIAN  /**< A few hot indices take most accesses, scattered over the range. */
+} workload_distribution_t;
+
+/**
+ * @brief Small deterministic PRNG (splitmix64) so every implementation sees the same inputs.
+ */
+typedef struct workload_rng_t {
+    uint64_t state;
+} workload_rng_t;
+
+/**
+ * @brief Zipfian generator over [0, count) (Gray et al., "Quickly Generating Billion-Record
+ * Synthetic Databases", as used by YCSB). Setup is O(count); each draw is O(1).
+ */
+typedef struct workload_zipf_t {
+    size_t count;
+    double theta;
+    double alpha;
+    double zeta_count;
+    double eta;
+} workload_zipf_t;
+
+// --- Random Numbers ---
+
+static inline void workload_rng_seed(workload_rng_t *rng, uint64_t seed)
+{
+    rng->state = seed;
+}
+
+static inline uint64_t workload_rng_next(workload_rng_t *rng)
+{
+    uint64_t value = (rng->state += 0x9E3779B97F4A7C15ULL);
+    value          = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value          = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Returns a value in [0, bound). bound must be non-zero.
+ */
+static inline size_t workload_rng_below(workload_rng_t *rng, size_t bound)
+{
+    return (size_t)(workload_rng_next(rng) % (uint64_t)bound);
+}
+
+/**
+ * @brief Returns a double in [0, 1).
+ */
+static inline double workload_rng_double(workload_rng_t *rng)
+{
+    return (double)(workload_rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// --- Zipfian Distribution ---
+
+static inline void workload_zipf_init(workload_zipf_t *zipf, size_t count, double theta)
+{
+    double zeta_two  = 0.0;
+    zipf->count      = count;
+    zipf->theta      = theta;
+    zipf->zeta_count = 0.0;
+    for (size_t rank = 1; rank <= count; rank++) {
+        zipf->zeta_count += 1.0 / pow((double)rank, theta);
+        if (rank == 2) {
+            zeta_two = zipf->zeta_count;
+        }
+    }
+    zipf->alpha = 1.0 / (1.0 - theta);
+    zipf->eta   = (1.0 - pow(2.0 / (double)count, 1.0 - theta)) /
+                (1.0 - zeta_two / zipf->zeta_count);
+}
+
+/**
+ * @brief Returns a rank in [0, count); rank 0 is the most popular.
+ */
+static inline size_t workload_zipf_next(const workload_zipf_t *zipf, workload_rng_t *rng)
+{
+    double uniform = workload_rng_double(rng);
+    double scaled  = uniform * zipf->zeta_count;
+    if (scaled < 1.0 || zipf->count < 2) {
+        return 0;
+    }
+    if (scaled < 1.0 + pow(0.5, zipf->theta)) {
+        return 1;
+    }
+    size_t rank =
+        (size_t)((double)zipf->count * pow(zipf->eta * uniform - zipf->eta + 1.0, zipf->alpha));
+    return rank < zipf->count ? rank : zipf->count - 1;
+}
+
+// --- Index Sequences ---
+
+/**
+ * @brief Fills indices[0..length) with draws from [0, count) under the given distribution.
+ * Zipfian ranks are scattered with a hash so hot entries are not adjacent in memory.
+ * The same seed always yields the same sequence.
+ */
+static inline void workload_fill_indices(size_t                 *indices,
+                                         size_t                  length,
+                                         size_t                  count,
+                                         workload_distribution_t distribution,
+                                         uint64_t                seed)
+{
+    workload_rng_t rng;
+    workload_rng_seed(&rng, seed);
+    if (distribution == WORKLOAD_UNIFORM) {
+        for (size_t index = 0; index < length; index++) {
+            indices[index] = workload_rng_below(&rng, count);
+        }
+        return;
+    }
+    workload_zipf_t zipf;
+    workload_zipf_init(&zipf, count, WORKLOAD_ZIPF_THETA);
+    for (size_t index = 0; index < length; index++) {
+        workload_rng_t scatter;
+        workload_rng_seed(&scatter, (uint64_t)workload_zipf_next(&zipf, &rng));
+        indices[index] = (size_t)(workload_rng_next(&scatter) % (uint64_t)count);
+    }
+}
+
+/**
+ * @brief Returns a short name for a distribution, for benchmark labels.
+ */
+static inline const char *workload_distribution_name(workload_distribution_t distribution)
+{
+    return distribution == WORKLOAD_UNIFORM ? "uniform" : "zipfian";
+}
+
+/**
+ * @brief Writes the key for an index. Present keys use the "key_" prefix and absent keys
+ * (for miss lookups) the "miss_" prefix, so both have similar lengths and hash costs.
+ */
+static inline void workload_format_key(char *buffer, size_t size, size_t index, int present)
+{
+    if (present) {
+        snprintf(buffer, size, "key_%08zu", index);
+    } else {
+        snprintf(buffer, size, "miss_%07zu", index);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BENCHMARK_WORKLOAD_H */
@@ -1,40 +1,101 @@
 #!/bin/bash
+#
+# Runs the CI benchmark set and compares each benchmark's median against a baseline.
+#
+# Usage: benchmarks/run_benchmarks.sh [--update-baseline] [--tolerance=0.10] [--alpha=0.05]
+#
+# Environment:
+#   BENCHMARK_DIR       Directory with the benchmark executables (default: ./build/benchmarks)
+#   BENCHMARK_BASE_DIR  Executables built from the base commit. When set, base and current
+#                       executables run alternately on this machine and the base samples become
+#                       the baseline, so both sides see the same machine state.
+#   BENCHMARK_BASELINE  Baseline file (default: ./build/benchmark_baseline.json). Baselines are
+#                       machine-specific, so keep one per CI runner type. Locally a missing
+#                       baseline is created from the current run; when CI is set it is an error,
+#                       since the gate would otherwise pass without comparing anything.
+#   BENCHMARK_RESULTS   Directory for this run's JSON results and comparison.csv
+#                       (default: ./build/benchmark_results)
+#   BENCHMARK_ROUNDS    Runs of each executable (default: 12). Each run's median is one sample
+#                       of the comparison, since samples within a run are not independent.
 
-set -e
+set -euo pipefail
 
-# Define time limits for each benchmark (in milliseconds)
-declare -A BENCHMARK_LIMITS=(
-    ["mvn_ds_arr_benchmark"]=22
-    ["mvn_ds_hmap_benchmark"]=45
-    ["mvn_ds_string_benchmark"]=10
-    ["mvn_ds_primitives_benchmark"]=12
+# Benchmarks that make up the gate
+BENCHMARKS=(
+    mvn_ds_arr_benchmark
+    mvn_ds_hmap_benchmark
+    mvn_ds_string_benchmark
+    mvn_ds_primitives_benchmark
 )
 
-# Directory containing the benchmark executables
-BENCHMARK_DIR="./build/benchmarks"
+# Samples per run; only their median is compared. 12 runs per side let the Holm-corrected
+# Mann-Whitney test reach alpha = 0.05 across a few thousand benchmarks
+BENCHMARK_ARGS=(--repetitions=3 --min-time-ms=5)
 
-# Run each benchmark and check its execution time
-for BENCHMARK in "${!BENCHMARK_LIMITS[@]}"; do
-    BENCHMARK_PATH="${BENCHMARK_DIR}/${BENCHMARK}"
-    TIME_LIMIT=${BENCHMARK_LIMITS[$BENCHMARK]}
+BENCHMARK_DIR="${BENCHMARK_DIR:-./build/benchmarks}"
+BENCHMARK_BASE_DIR="${BENCHMARK_BASE_DIR:-}"
+BENCHMARK_ROUNDS="${BENCHMARK_ROUNDS:-12}"
+BENCHMARK_BASELINE="${BENCHMARK_BASELINE:-./build/benchmark_baseline.json}"
+BENCHMARK_RESULTS="${BENCHMARK_RESULTS:-./build/benchmark_results}"
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+
+UPDATE_BASELINE=0
+for ARG in "$@"; do
+    if [[ "$ARG" == "--update-baseline" ]]; then
+        UPDATE_BASELINE=1
+    fi
+done
+if [[ -z "$BENCHMARK_BASE_DIR" && ! -f "$BENCHMARK_BASELINE" && $UPDATE_BASELINE -eq 0 &&
+      -n "${CI:-}" ]]; then
+    echo "::error::No benchmark baseline at $BENCHMARK_BASELINE; the regression gate cannot run."
+    echo "Restore a baseline for this runner type or run with --update-baseline."
+    exit 2
+fi
 
+for BENCHMARK in "${BENCHMARKS[@]}"; do
+    BENCHMARK_PATH="${BENCHMARK_DIR}/${BENCHMARK}"
     if [[ ! -x "$BENCHMARK_PATH" ]]; then
         echo "Error: Benchmark executable $BENCHMARK_PATH not found or not executable."
-        exit 1
+        exit 2
     fi
+done
 
-    echo "Running $BENCHMARK..."
-    START_TIME=$(($(date +%s%N) / 1000000)) # Get current time in milliseconds
-    $BENCHMARK_PATH
-    END_TIME=$(($(date +%s%N) / 1000000)) # Get current time in milliseconds
-
-    ELAPSED_TIME=$((END_TIME - START_TIME))
-    echo "$BENCHMARK completed in $ELAPSED_TIME ms."
+# Runs one round of BENCHMARK from DIRECTORY, writing its JSON into OUTPUT_DIR
+run_round() {
+    local DIRECTORY="$1" OUTPUT_DIR="$2" ROUND="$3"
+    mkdir -p "$OUTPUT_DIR"
+    "${DIRECTORY}/${BENCHMARK}" "${BENCHMARK_ARGS[@]}" --format=json \
+        --out="${OUTPUT_DIR}/${BENCHMARK}.${ROUND}.json"
+}
 
-    if (( ELAPSED_TIME > TIME_LIMIT )); then
-        echo "Error: $BENCHMARK exceeded the time limit of $TIME_LIMIT ms."
-        exit 1
-    fi
+# Results are pooled from every JSON file in the directory, so drop the previous run's
+mkdir -p "$BENCHMARK_RESULTS"
+rm -f "${BENCHMARK_RESULTS}"/*.json
+rm -rf "${BENCHMARK_RESULTS}/base"
+for ((ROUND = 1; ROUND <= BENCHMARK_ROUNDS; ROUND++)); do
+    for BENCHMARK in "${BENCHMARKS[@]}"; do
+        echo "Running $BENCHMARK (round $ROUND of $BENCHMARK_ROUNDS)..."
+        # A benchmark added by this change has no base executable; it is reported as new
+        if [[ -z "$BENCHMARK_BASE_DIR" || ! -x "${BENCHMARK_BASE_DIR}/${BENCHMARK}" ]]; then
+            run_round "$BENCHMARK_DIR" "$BENCHMARK_RESULTS" "$ROUND"
+        elif ((ROUND % 2 == 1)); then # Alternate which side runs first
+            run_round "$BENCHMARK_BASE_DIR" "${BENCHMARK_RESULTS}/base" "$ROUND"
+            run_round "$BENCHMARK_DIR" "$BENCHMARK_RESULTS" "$ROUND"
+        else
+            run_round "$BENCHMARK_DIR" "$BENCHMARK_RESULTS" "$ROUND"
+            run_round "$BENCHMARK_BASE_DIR" "${BENCHMARK_RESULTS}/base" "$ROUND"
+        fi
+    done
 done
+shopt -s nullglob
+RESULT_FILES=("${BENCHMARK_RESULTS}"/*.json)
+BASE_FILES=("${BENCHMARK_RESULTS}"/base/*.json)
+shopt -u nullglob
 
-echo "All benchmarks completed within their time limits."
+echo
+if ((${#BASE_FILES[@]} > 0)); then
+    python3 "${SCRIPT_DIR}/compare_benchmarks.py" --baseline="$BENCHMARK_BASELINE" \
+        --update-baseline "${BASE_FILES[@]}"
+fi
+python3 "${SCRIPT_DIR}/compare_benchmarks.py" --baseline="$BENCHMARK_BASELINE" \
+    --csv="${BENCHMARK_RESULTS}/comparison.csv" "$@" "${RESULT_FILES[@]}"
@@ -3,34 +3,60 @@
 
 #include <stdio.h>
 
-int main()
+#define ACCESS_ELEMENTS 1000000
+
+static void bench_arr_creation(benchmark_state_t *state)
 {
-    const size_t num_elements = 1000000;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_arr_t *array = mvn_arr_new();
+        mvn_arr_free(array);
+    }
+}
 
-    // Benchmark array creation
-    clock_t    start = benchmark_start();
+static void bench_arr_push(benchmark_state_t *state)
+{
+    benchmark_pause(state);
     mvn_arr_t *array = mvn_arr_new();
-    benchmark_end(start, "Array Creation");
+    benchmark_resume(state);
 
-    // Benchmark array push
-    start = benchmark_start();
-    for (size_t i = 0; i < num_elements; ++i) {
+    for (size_t i = 0; i < state->iterations; ++i) {
         mvn_arr_push(array, mvn_val_i32((int)i));
     }
-    benchmark_end(start, "Array Push (1M elements)");
-
-    // Benchmark array access
-    start = benchmark_start();
-    for (size_t i = 0; i < num_elements; ++i) {
-        mvn_val_t *val = mvn_arr_get(array, i);
-        if (val == NULL || val->type != MVN_VAL_I32 || val->i32 != (int)i) {
-            fprintf(stderr, "Array access error at index %zu\n", i);
+
+    benchmark_pause(state);
+    mvn_arr_free(array);
+    benchmark_resume(state);
+}
+
+static void bench_arr_access(benchmark_state_t *state)
+{
+    mvn_arr_t *array = (mvn_arr_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t     index = i % ACCESS_ELEMENTS;
+        mvn_val_t *val   = mvn_arr_get(array, index);
+        if (val == NULL || val->type != MVN_VAL_I32 || val->i32 != (int)index) {
+            fprintf(stderr, "Array access error at index %zu\n", index);
         }
     }
-    benchmark_end(start, "Array Access (1M elements)");
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        return 1;
+    }
+
+    benchmark_run(&suite, "Array Creation", bench_arr_creation, NULL);
+    benchmark_run(&suite, "Array Push", bench_arr_push, NULL);
 
-    // Free the array
+    // Access reads from a prebuilt 1M element array
+    mvn_arr_t *array = mvn_arr_new_capacity(ACCESS_ELEMENTS);
+    for (size_t i = 0; i < ACCESS_ELEMENTS; ++i) {
+        mvn_arr_push(array, mvn_val_i32((int)i));
+    }
+    benchmark_run(&suite, "Array Access (1M elements)", bench_arr_access, array);
     mvn_arr_free(array);
 
-    return 0;
+    return benchmark_suite_finish(&suite);
 }
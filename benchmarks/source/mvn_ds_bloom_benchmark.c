@@ -0,0 +1,173 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_MIN_SIZE     1000
+#define DEFAULT_MAX_SIZE     1000000
+#define DEFAULT_MISS_PERCENT 90
+#define PROBE_COUNT          65536 // Probe keys; a power of two, too many for the caches to hold
+#define BENCHMARK_SEED       0xB100DULL
+
+// Two maps holding the same size keys, one with a filter attached, and a fixed mix of probe
+// keys of which miss_percent percent are absent from both.
+typedef struct bloom_bench_t {
+    size_t      size;                // Keys in each map
+    size_t      next;                // Next probe to look up
+    uint64_t    rng;                 // State for picking probes
+    mvn_hmap_t *plain;               // Map without a filter
+    mvn_hmap_t *filtered;            // Same keys, with a filter attached
+    mvn_str_t  *probes[PROBE_COUNT]; // Keys to look up, hits and misses shuffled together
+} bloom_bench_t;
+
+static uint64_t rng_next(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static mvn_str_t *make_key(const char *prefix, uint64_t number)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "%s%llu", prefix, (unsigned long long)number);
+    return mvn_str_new(text);
+}
+
+// --- Benchmarks ---
+
+static void bench_lookup(benchmark_state_t *state, const mvn_hmap_t *hmap)
+{
+    bloom_bench_t *bench = (bloom_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_val_t *value = mvn_hmap_get(hmap, bench->probes[bench->next]);
+        bench->next      = (bench->next + 1) & (PROBE_COUNT - 1);
+        benchmark_do_not_optimize(value);
+    }
+}
+
+static void bench_lookup_plain(benchmark_state_t *state)
+{
+    bench_lookup(state, ((bloom_bench_t *)state->context)->plain);
+}
+
+static void bench_lookup_filtered(benchmark_state_t *state)
+{
+    bench_lookup(state, ((bloom_bench_t *)state->context)->filtered);
+}
+
+// Cost of keeping the filter up to date: insert a new key, then delete it again.
+static void bench_insert(benchmark_state_t *state, mvn_hmap_t *hmap)
+{
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_hmap_set_cstr(hmap, "inserted", mvn_val_i64((int64_t)i));
+        mvn_hmap_delete_cstr(hmap, "inserted");
+    }
+    benchmark_clobber_memory();
+}
+
+static void bench_insert_plain(benchmark_state_t *state)
+{
+    bench_insert(state, ((bloom_bench_t *)state->context)->plain);
+}
+
+static void bench_insert_filtered(benchmark_state_t *state)
+{
+    bench_insert(state, ((bloom_bench_t *)state->context)->filtered);
+}
+
+static bool bloom_bench_init(bloom_bench_t *bench, size_t size, size_t miss_percent)
+{
+    bench->size     = size;
+    bench->rng      = BENCHMARK_SEED;
+    bench->plain    = mvn_hmap_new_capacity(size * 2);
+    bench->filtered = mvn_hmap_new_capacity(size * 2);
+    if (bench->plain == NULL || bench->filtered == NULL ||
+        !mvn_hmap_attach_filter(bench->filtered, 0.01)) {
+        return false;
+    }
+    for (size_t index = 0; index < size; index++) {
+        mvn_str_t *key = make_key("key", index);
+        if (key == NULL || !mvn_hmap_set_cstr(bench->filtered, key->data, mvn_val_i64(0)) ||
+            !mvn_hmap_set(bench->plain, key, mvn_val_i64(0))) {
+            return false;
+        }
+    }
+    for (size_t index = 0; index < PROBE_COUNT; index++) {
+        uint64_t pick = rng_next(&bench->rng);
+        bool     miss = pick % 100 < miss_percent;
+        bench->probes[index] =
+            miss ? make_key("miss", pick >> 8) : make_key("key", (pick >> 8) % size);
+        if (bench->probes[index] == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void bloom_bench_free(bloom_bench_t *bench)
+{
+    mvn_hmap_free(bench->plain);
+    mvn_hmap_free(bench->filtered);
+    for (size_t index = 0; index < PROBE_COUNT; index++) {
+        mvn_str_free(bench->probes[index]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t min_size     = DEFAULT_MIN_SIZE;
+    size_t max_size     = DEFAULT_MAX_SIZE;
+    size_t miss_percent = DEFAULT_MISS_PERCENT;
+    benchmark_take_size_option(&argc, argv, "min-size", &min_size);
+    benchmark_take_size_option(&argc, argv, "max-size", &max_size);
+    benchmark_take_size_option(&argc, argv, "miss-percent", &miss_percent);
+
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv) || miss_percent > 100) {
+        printf("Bloom options: --min-size=N (default: %d), --max-size=N (default: %d), "
+               "--miss-percent=N (default: %d)\n",
+               DEFAULT_MIN_SIZE,
+               DEFAULT_MAX_SIZE,
+               DEFAULT_MISS_PERCENT);
+        return 1;
+    }
+
+    const struct {
+        const char  *name;
+        benchmark_fn body;
+    } benchmarks[] = {
+        {"lookup/plain", bench_lookup_plain},
+        {"lookup/filtered", bench_lookup_filtered},
+        {"insert/plain", bench_insert_plain},
+        {"insert/filtered", bench_insert_filtered},
+    };
+
+    for (size_t size = min_size > 0 ? min_size : 1; size <= max_size; size *= 10) {
+        bloom_bench_t *bench = (bloom_bench_t *)calloc(1, sizeof(bloom_bench_t));
+        if (bench == NULL || !bloom_bench_init(bench, size, miss_percent)) {
+            fprintf(stderr, "Failed to set up maps of %zu keys\n", size);
+            if (bench != NULL) {
+                bloom_bench_free(bench);
+                free(bench);
+            }
+            return 1;
+        }
+        for (size_t index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]); index++) {
+            char name[96];
+            snprintf(name,
+                     sizeof(name),
+                     "bloom/%s/miss%zu/%zu",
+                     benchmarks[index].name,
+                     miss_percent,
+                     size);
+            benchmark_run(&suite, name, benchmarks[index].body, bench);
+        }
+        bloom_bench_free(bench);
+        free(bench);
+    }
+
+    return benchmark_suite_finish(&suite);
+}
@@ -0,0 +1,326 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// FNV-1a parameters used by mvn_str_hash
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME        16777619U
+
+#define BLOCK_LENGTH      4    // Characters per colliding block
+#define MAX_BLOCKS        20   // Up to 2^20 colliding keys
+#define SEARCH_TABLE_BITS 19   // Birthday search table; half of it is filled at most
+#define DEFAULT_MAX_KEYS  4096 // Largest key set; colliding inserts cost O(n) each
+#define DEFAULT_MIN_KEYS  256
+#define BENCHMARK_SEED    0xF100DULL
+
+static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+typedef struct collision_bench_t {
+    char      **keys;     // Keys to insert/look up
+    size_t      count;    // Number of keys
+    bool        seeded;   // Use mvn_hmap_new_randomized instead of mvn_hmap_new
+    mvn_hmap_t *hmap;     // Pre-built map for lookups
+    mvn_str_t **key_strs; // Keys as mvn_str_t, for lookups without allocation
+} collision_bench_t;
+
+static uint64_t rng_next(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static uint32_t fnv_block(uint32_t state, const char *block)
+{
+    for (size_t index = 0; index < BLOCK_LENGTH; index++) {
+        state ^= (uint32_t)(unsigned char)block[index];
+        state *= FNV_PRIME;
+    }
+    return state;
+}
+
+/**
+ * @brief Finds two different blocks that take the FNV-1a state from start to the same state
+ * (birthday search, ~2^16 attempts for a 32-bit state).
+ * @return true with the blocks in first/second and the common state in end, false if none was
+ * found or on allocation failure.
+ */
+static bool find_block_collision(uint32_t  start,
+                                 uint64_t *rng,
+                                 char      first[BLOCK_LENGTH],
+                                 char      second[BLOCK_LENGTH],
+                                 uint32_t *end)
+{
+    const size_t slots  = (size_t)1 << SEARCH_TABLE_BITS;
+    uint32_t    *states = (uint32_t *)malloc(slots * sizeof(uint32_t));
+    char(*blocks)[BLOCK_LENGTH] = (char(*)[BLOCK_LENGTH])malloc(slots * BLOCK_LENGTH);
+    bool *used                  = (bool *)calloc(slots, sizeof(bool));
+    bool  found                 = false;
+    if (states == NULL || blocks == NULL || used == NULL) {
+        goto done;
+    }
+    for (size_t attempt = 0; attempt < slots / 2 && !found; attempt++) {
+        char     block[BLOCK_LENGTH];
+        uint64_t bits = rng_next(rng);
+        for (size_t index = 0; index < BLOCK_LENGTH; index++) {
+            block[index] = alphabet[(bits >> (8 * index)) % (sizeof(alphabet) - 1)];
+        }
+        uint32_t state = fnv_block(start, block);
+        size_t   slot  = (size_t)((state * 2654435761U) >> (32 - SEARCH_TABLE_BITS));
+        while (used[slot]) {
+            if (states[slot] == state && memcmp(blocks[slot], block, BLOCK_LENGTH) != 0) {
+                memcpy(first, blocks[slot], BLOCK_LENGTH);
+                memcpy(second, block, BLOCK_LENGTH);
+                *end  = state;
+                found = true;
+                break;
+            }
+            slot = (slot + 1) & (slots - 1);
+        }
+        if (!found && !used[slot]) {
+            used[slot]   = true;
+            states[slot] = state;
+            memcpy(blocks[slot], block, BLOCK_LENGTH);
+        }
+    }
+done:
+    free(states);
+    free(blocks);
+    free(used);
+    return found;
+}
+
+/**
+ * @brief Builds 2^block_count keys that all share one FNV-1a hash (Joux multicollision):
+ * each block position has two interchangeable blocks with the same state transition, so any
+ * combination of choices ends in the same final state.
+ */
+static char **make_colliding_keys(size_t block_count, uint64_t seed)
+{
+    char     pairs[MAX_BLOCKS][2][BLOCK_LENGTH];
+    uint32_t states[MAX_BLOCKS + 1] = {FNV_OFFSET_BASIS};
+    uint64_t rng                    = seed;
+    size_t   failures               = 0;
+    for (size_t block = 0; block < block_count;) {
+        if (find_block_collision(
+                states[block], &rng, pairs[block][0], pairs[block][1], &states[block + 1])) {
+            block++;
+        } else if (++failures > 64) {
+            return NULL;
+        } else if (block > 0) {
+            // Some states have no colliding block pair; pick another pair for the previous block
+            block--;
+        }
+    }
+
+    size_t count = (size_t)1 << block_count;
+    char **keys  = (char **)calloc(count, sizeof(char *));
+    if (keys == NULL) {
+        return NULL;
+    }
+    for (size_t key = 0; key < count; key++) {
+        keys[key] = (char *)malloc(block_count * BLOCK_LENGTH + 1);
+        if (keys[key] == NULL) {
+            return keys; // Caller checks every entry
+        }
+        for (size_t block = 0; block < block_count; block++) {
+            const char *choice = pairs[block][(key >> block) & 1U];
+            memcpy(keys[key] + block * BLOCK_LENGTH, choice, BLOCK_LENGTH);
+        }
+        keys[key][block_count * BLOCK_LENGTH] = '\0';
+    }
+    return keys;
+}
+
+// Random keys of the same length, for the non-adversarial baseline.
+static char **make_random_keys(size_t count, size_t length, uint64_t seed)
+{
+    char   **keys = (char **)calloc(count, sizeof(char *));
+    uint64_t rng  = seed;
+    for (size_t key = 0; keys != NULL && key < count; key++) {
+        keys[key] = (char *)malloc(length + 1);
+        if (keys[key] == NULL) {
+            return keys;
+        }
+        for (size_t index = 0; index < length; index++) {
+            keys[key][index] = alphabet[rng_next(&rng) % (sizeof(alphabet) - 1)];
+        }
+        keys[key][length] = '\0';
+    }
+    return keys;
+}
+
+static void free_keys(char **keys, size_t count)
+{
+    for (size_t key = 0; keys != NULL && key < count; key++) {
+        free(keys[key]);
+    }
+    free(keys);
+}
+
+static mvn_hmap_t *new_map(const collision_bench_t *bench)
+{
+    return bench->seeded ? mvn_hmap_new_randomized(MVN_DS_HMAP_INITIAL_CAPACITY)
+                         : mvn_hmap_new();
+}
+
+// --- Benchmarks ---
+
+// One insert per iteration; the map is rebuilt every count inserts.
+static void bench_insert(benchmark_state_t *state)
+{
+    collision_bench_t *bench = (collision_bench_t *)state->context;
+    mvn_hmap_t        *hmap  = new_map(bench);
+    size_t             next  = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        if (next == bench->count) {
+            benchmark_pause(state);
+            mvn_hmap_free(hmap);
+            hmap = new_map(bench);
+            next = 0;
+            benchmark_resume(state);
+        }
+        mvn_hmap_set_cstr(hmap, bench->keys[next++], mvn_val_null());
+    }
+    benchmark_pause(state);
+    mvn_hmap_free(hmap);
+    benchmark_resume(state);
+}
+
+static void bench_lookup(benchmark_state_t *state)
+{
+    collision_bench_t *bench = (collision_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        if (mvn_hmap_get(bench->hmap, bench->key_strs[i % bench->count]) == NULL) {
+            fprintf(stderr, "Lookup failed\n");
+        }
+    }
+}
+
+static size_t longest_chain(const mvn_hmap_t *hmap)
+{
+    size_t longest = 0;
+    for (size_t bucket = 0; bucket < hmap->capacity; bucket++) {
+        size_t length = 0;
+        for (const mvn_hmap_entry_t *entry = hmap->buckets[bucket]; entry; entry = entry->next) {
+            length++;
+        }
+        longest = length > longest ? length : longest;
+    }
+    return longest;
+}
+
+static bool collision_bench_init(collision_bench_t *bench, char **keys, size_t count, bool seeded)
+{
+    memset(bench, 0, sizeof(*bench));
+    bench->keys     = keys;
+    bench->count    = count;
+    bench->seeded   = seeded;
+    bench->hmap     = new_map(bench);
+    bench->key_strs = (mvn_str_t **)calloc(count, sizeof(mvn_str_t *));
+    if (bench->hmap == NULL || bench->key_strs == NULL) {
+        return false;
+    }
+    for (size_t key = 0; key < count; key++) {
+        bench->key_strs[key] = mvn_str_new(keys[key]);
+        if (bench->key_strs[key] == NULL ||
+            !mvn_hmap_set_cstr(bench->hmap, keys[key], mvn_val_null())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void collision_bench_free(collision_bench_t *bench)
+{
+    for (size_t key = 0; bench->key_strs != NULL && key < bench->count; key++) {
+        mvn_str_free(bench->key_strs[key]);
+    }
+    free(bench->key_strs);
+    mvn_hmap_free(bench->hmap);
+}
+
+int main(int argc, char **argv)
+{
+    size_t min_keys = DEFAULT_MIN_KEYS;
+    size_t max_keys = DEFAULT_MAX_KEYS;
+    benchmark_take_size_option(&argc, argv, "min-keys", &min_keys);
+    benchmark_take_size_option(&argc, argv, "max-keys", &max_keys);
+
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        printf("Collision options: --min-keys=N (default: %d), --max-keys=N (default: %d, "
+               "rounded to powers of two, at most 2^%d)\n",
+               DEFAULT_MIN_KEYS,
+               DEFAULT_MAX_KEYS,
+               MAX_BLOCKS);
+        return 1;
+    }
+
+    size_t block_count = 1;
+    while (block_count < MAX_BLOCKS && ((size_t)1 << block_count) < max_keys) {
+        block_count++;
+    }
+    max_keys         = (size_t)1 << block_count;
+    char **colliding = make_colliding_keys(block_count, BENCHMARK_SEED);
+    char **random    = make_random_keys(max_keys, block_count * BLOCK_LENGTH, BENCHMARK_SEED);
+    bool   complete  = colliding != NULL && random != NULL;
+    for (size_t key = 0; complete && key < max_keys; key++) {
+        complete = colliding[key] != NULL && random[key] != NULL;
+    }
+    if (!complete) {
+        fprintf(stderr, "Failed to generate keys\n");
+        free_keys(colliding, colliding != NULL ? max_keys : 0);
+        free_keys(random, random != NULL ? max_keys : 0);
+        return 1;
+    }
+    mvn_str_t *sample = mvn_str_new(colliding[0]);
+    fprintf(suite.report,
+            "%zu keys of %zu characters share the FNV-1a hash 0x%08x\n",
+            max_keys,
+            block_count * BLOCK_LENGTH,
+            (unsigned)mvn_str_hash(sample));
+    mvn_str_free(sample);
+
+    const struct {
+        const char *name;
+        char      **keys;
+        bool        seeded;
+    } variants[] = {
+        {"random/fnv", random, false},
+        {"colliding/fnv", colliding, false},
+        {"colliding/seeded", colliding, true},
+    };
+
+    for (size_t count = min_keys < max_keys ? min_keys : max_keys;; count *= 4) {
+        count = count > max_keys ? max_keys : count;
+        for (size_t variant = 0; variant < sizeof(variants) / sizeof(variants[0]); variant++) {
+            collision_bench_t bench;
+            if (!collision_bench_init(
+                    &bench, variants[variant].keys, count, variants[variant].seeded)) {
+                fprintf(stderr, "Failed to set up %s\n", variants[variant].name);
+                collision_bench_free(&bench);
+                continue;
+            }
+            char name[96];
+            snprintf(name, sizeof(name), "hmap/%s/insert/%zu", variants[variant].name, count);
+            benchmark_run(&suite, name, bench_insert, &bench);
+            snprintf(name, sizeof(name), "hmap/%s/lookup/%zu", variants[variant].name, count);
+            if (benchmark_run(&suite, name, bench_lookup, &bench) != NULL) {
+                fprintf(suite.report, "  -> longest chain %zu\n", longest_chain(bench.hmap));
+            }
+            collision_bench_free(&bench);
+        }
+        if (count == max_keys) {
+            break;
+        }
+    }
+
+    free_keys(colliding, max_keys);
+    free_keys(random, max_keys);
+    return benchmark_suite_finish(&suite);
+}
@@ -0,0 +1,219 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_document.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_DOCUMENTS   32
+#define PATHS_PER_DOCUMENT  64
+#define DOCUMENT_SEED       0xD0C5EEDULL
+#define DOCUMENT_BUILD_SEED 0xB011DULL
+#define DOCUMENT_PATH_SEED  0x9A7A5ULL
+
+typedef struct document_bench_t {
+    document_config_t    config;
+    document_generator_t builder; // Generates fresh documents for the build benchmark
+    mvn_val_t           *documents;
+    mvn_val_t           *copies;
+    document_path_t     *paths;
+    size_t               document_count;
+    size_t               path_count;
+    size_t               next; // Rotates through the document set across samples
+} document_bench_t;
+
+static void bench_document_build(benchmark_state_t *state)
+{
+    document_bench_t *bench = (document_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_val_t document = document_generate(&bench->builder);
+        benchmark_pause(state);
+        mvn_val_free(&document);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_document_path_lookup(benchmark_state_t *state)
+{
+    document_bench_t *bench = (document_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t           index = (bench->next + i) % bench->path_count;
+        const mvn_val_t *found =
+            document_lookup(&bench->documents[index / PATHS_PER_DOCUMENT], &bench->paths[index]);
+        if (found == NULL) {
+            fprintf(stderr, "Document path lookup failed for path %zu\n", index);
+        }
+    }
+    bench->next += state->iterations;
+}
+
+static void bench_document_equal(benchmark_state_t *state)
+{
+    document_bench_t *bench = (document_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = (bench->next + i) % bench->document_count;
+        if (!mvn_val_equal(&bench->documents[index], &bench->copies[index])) {
+            fprintf(stderr, "Document %zu differs from its copy\n", index);
+        }
+    }
+    bench->next += state->iterations;
+}
+
+static void bench_document_deep_copy(benchmark_state_t *state)
+{
+    document_bench_t *bench = (document_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t    index = (bench->next + i) % bench->document_count;
+        mvn_val_t copy  = mvn_val_deep_copy(&bench->documents[index]);
+        benchmark_pause(state);
+        mvn_val_free(&copy);
+        benchmark_resume(state);
+    }
+    bench->next += state->iterations;
+}
+
+static void bench_document_free(benchmark_state_t *state)
+{
+    document_bench_t *bench = (document_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        size_t    index = (bench->next + i) % bench->document_count;
+        mvn_val_t copy  = mvn_val_deep_copy(&bench->documents[index]);
+        benchmark_resume(state);
+        mvn_val_free(&copy);
+    }
+    bench->next += state->iterations;
+}
+
+// Prints throughput for a per-document result; result pointers do not outlive the next run
+static void report_throughput(const benchmark_suite_t  *suite,
+                              const benchmark_result_t *result,
+                              double                    bytes_per_document)
+{
+    if (result == NULL || result->median <= 0.0) {
+        return;
+    }
+    double documents_per_second = 1e9 / result->median;
+    fprintf(suite->report,
+            "  -> %.0f docs/s, %.1f MB/s\n",
+            documents_per_second,
+            documents_per_second * bytes_per_document / (1024.0 * 1024.0));
+}
+
+static void document_bench_free(document_bench_t *bench)
+{
+    for (size_t index = 0; index < bench->document_count; index++) {
+        mvn_val_free(&bench->documents[index]);
+        mvn_val_free(&bench->copies[index]);
+    }
+    free(bench->documents);
+    free(bench->copies);
+    free(bench->paths);
+    document_generator_free(&bench->builder);
+}
+
+static bool document_bench_init(document_bench_t *bench, size_t document_count)
+{
+    document_generator_t generator;
+    if (!document_generator_init(&generator, &bench->config, DOCUMENT_SEED)) {
+        return false;
+    }
+    if (!document_generator_init(&bench->builder, &bench->config, DOCUMENT_BUILD_SEED)) {
+        document_generator_free(&generator);
+        return false;
+    }
+    bench->document_count = document_count;
+    bench->path_count     = document_count * PATHS_PER_DOCUMENT;
+    bench->documents      = (mvn_val_t *)calloc(document_count, sizeof(mvn_val_t));
+    bench->copies         = (mvn_val_t *)calloc(document_count, sizeof(mvn_val_t));
+    bench->paths          = (document_path_t *)calloc(bench->path_count, sizeof(document_path_t));
+    if (bench->documents == NULL || bench->copies == NULL || bench->paths == NULL) {
+        document_generator_free(&generator);
+        bench->document_count = 0;
+        document_bench_free(bench);
+        return false;
+    }
+
+    for (size_t index = 0; index < document_count; index++) {
+        bench->documents[index] = document_generate(&generator);
+        bench->copies[index]    = mvn_val_deep_copy(&bench->documents[index]);
+    }
+    document_generator_free(&generator);
+
+    // Paths borrow the builder's key names, which live as long as the bench; they draw from
+    // their own stream so the build benchmark sees the same documents either way
+    workload_rng_t build_rng = bench->builder.rng;
+    workload_rng_seed(&bench->builder.rng, DOCUMENT_PATH_SEED);
+    for (size_t index = 0; index < bench->path_count; index++) {
+        document_random_path(
+            &bench->builder, &bench->documents[index / PATHS_PER_DOCUMENT], &bench->paths[index]);
+    }
+    bench->builder.rng = build_rng;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    document_bench_t bench;
+    size_t           document_count = DEFAULT_DOCUMENTS;
+    memset(&bench, 0, sizeof(bench));
+    bench.config = document_config_default();
+
+    // Document shape options, removed before the harness parses its own
+    benchmark_take_size_option(&argc, argv, "documents", &document_count);
+    benchmark_take_size_option(&argc, argv, "fanout", &bench.config.fanout);
+    benchmark_take_size_option(&argc, argv, "depth", &bench.config.depth);
+    benchmark_take_size_option(&argc, argv, "array-length", &bench.config.array_length);
+    benchmark_take_size_option(&argc, argv, "min-string", &bench.config.min_string_length);
+    benchmark_take_size_option(&argc, argv, "max-string", &bench.config.max_string_length);
+    benchmark_take_double_option(&argc, argv, "string-skew", &bench.config.string_skew);
+
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        printf("Document options: --documents=N --fanout=N --depth=N --array-length=N\n"
+               "                  --min-string=N --max-string=N --string-skew=X\n");
+        return 1;
+    }
+    if (document_count == 0 || !document_bench_init(&bench, document_count)) {
+        fprintf(stderr, "Invalid document configuration\n");
+        return 1;
+    }
+
+    size_t total_bytes = 0;
+    size_t total_nodes = 0;
+    for (size_t index = 0; index < document_count; index++) {
+        total_bytes += mvn_val_memory_usage(&bench.documents[index]);
+        total_nodes += document_node_count(&bench.documents[index]);
+    }
+    double bytes_per_document = (double)total_bytes / (double)document_count;
+    fprintf(suite.report,
+            "Documents: %zu (fanout %zu, depth %zu, arrays of %zu, strings %zu..%zu)\n"
+            "Mean size: %.0f bytes, %.1f values per document\n",
+            document_count,
+            bench.config.fanout,
+            bench.config.depth,
+            bench.config.array_length,
+            bench.config.min_string_length,
+            bench.config.max_string_length,
+            bytes_per_document,
+            (double)total_nodes / (double)document_count);
+
+    // Whole-document operations also report throughput; lookups are per path
+    report_throughput(&suite,
+                      benchmark_run(&suite, "Document Build", bench_document_build, &bench),
+                      bytes_per_document);
+    benchmark_run(&suite, "Document Path Lookup", bench_document_path_lookup, &bench);
+    report_throughput(&suite,
+                      benchmark_run(&suite, "Document Equal", bench_document_equal, &bench),
+                      bytes_per_document);
+    report_throughput(&suite,
+                      benchmark_run(&suite, "Document Deep Copy", bench_document_deep_copy, &bench),
+                      bytes_per_document);
+    report_throughput(&suite,
+                      benchmark_run(&suite, "Document Free", bench_document_free, &bench),
+                      bytes_per_document);
+
+    document_bench_free(&bench);
+    return benchmark_suite_finish(&suite);
+}
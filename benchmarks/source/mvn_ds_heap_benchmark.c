@@ -0,0 +1,202 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_MIN_SIZE 100
+#define DEFAULT_MAX_SIZE 10000
+#define BENCHMARK_SEED   0x5EED5ULL
+
+// A queue of size pending items, kept either as a heap or as an array re-sorted after every
+// change (the pattern the heap replaces). The sorted array is kept in descending order, so
+// the next item is at the end and pops without shifting.
+typedef struct heap_bench_t {
+    size_t      size;     // Pending items in the queue
+    uint64_t    rng;      // State for priorities and picks
+    mvn_heap_t *heap;     // Queue as a heap
+    mvn_heap_t *indexed;  // Heap from mvn_heap_from_arr, where item i has handle i
+    mvn_arr_t  *sorted;   // Queue as a re-sorted array
+    mvn_arr_t  *priority; // Random priorities, for the build benchmarks
+} heap_bench_t;
+
+static uint64_t rng_next(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static mvn_val_t random_priority(heap_bench_t *bench)
+{
+    return mvn_val_i64((int64_t)(rng_next(&bench->rng) % 1000000));
+}
+
+static int compare_descending(const mvn_val_t *a, const mvn_val_t *b)
+{
+    return mvn_val_compare(b, a);
+}
+
+// Copy of the random priorities, made while the timer is paused.
+static mvn_arr_t *copy_priorities(const heap_bench_t *bench)
+{
+    mvn_arr_t *copy = mvn_arr_new_capacity(bench->size);
+    for (size_t index = 0; copy != NULL && index < bench->size; index++) {
+        mvn_arr_push(copy, bench->priority->data[index]);
+    }
+    return copy;
+}
+
+// --- Benchmarks ---
+
+// One scheduling step: add an item, then take the next one.
+static void bench_heap_push_pop(benchmark_state_t *state)
+{
+    heap_bench_t *bench = (heap_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_val_t next;
+        mvn_heap_push(bench->heap, random_priority(bench), NULL);
+        mvn_heap_pop(bench->heap, &next);
+        benchmark_do_not_optimize(&next);
+    }
+}
+
+static void bench_resort_push_pop(benchmark_state_t *state)
+{
+    heap_bench_t *bench = (heap_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_arr_push(bench->sorted, random_priority(bench));
+        mvn_arr_sort(bench->sorted, compare_descending);
+        mvn_val_t next = mvn_arr_pop(bench->sorted);
+        benchmark_do_not_optimize(&next);
+    }
+}
+
+// Lower the priority of a random pending item (e.g. a deadline moved up).
+static void bench_heap_decrease_key(benchmark_state_t *state)
+{
+    heap_bench_t *bench = (heap_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t           handle  = rng_next(&bench->rng) % bench->size;
+        const mvn_val_t *current = mvn_heap_get(bench->indexed, handle);
+        mvn_heap_update(bench->indexed, handle, mvn_val_i64(current->i64 - 1000));
+    }
+    benchmark_clobber_memory();
+}
+
+static void bench_resort_decrease_key(benchmark_state_t *state)
+{
+    heap_bench_t *bench = (heap_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_val_t *item = mvn_arr_get(bench->sorted, rng_next(&bench->rng) % bench->size);
+        item->i64 -= 1000;
+        mvn_arr_sort(bench->sorted, compare_descending);
+    }
+    benchmark_clobber_memory();
+}
+
+// Build a queue from size unordered items.
+static void bench_heapify(benchmark_state_t *state)
+{
+    heap_bench_t *bench = (heap_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        mvn_arr_t *items = copy_priorities(bench);
+        benchmark_resume(state);
+        mvn_heap_t *heap = mvn_heap_from_arr(items, 0, NULL, NULL);
+        benchmark_do_not_optimize(heap);
+        benchmark_pause(state);
+        mvn_heap_free(heap);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_sort(benchmark_state_t *state)
+{
+    heap_bench_t *bench = (heap_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        mvn_arr_t *items = copy_priorities(bench);
+        benchmark_resume(state);
+        mvn_arr_sort(items, compare_descending);
+        benchmark_do_not_optimize(items);
+        benchmark_pause(state);
+        mvn_arr_free(items);
+        benchmark_resume(state);
+    }
+}
+
+static bool heap_bench_init(heap_bench_t *bench, size_t size)
+{
+    bench->size     = size;
+    bench->rng      = BENCHMARK_SEED;
+    bench->heap     = mvn_heap_new(0, NULL, NULL);
+    bench->sorted   = mvn_arr_new_capacity(size + 1);
+    bench->priority = mvn_arr_new_capacity(size);
+    if (bench->heap == NULL || bench->sorted == NULL || bench->priority == NULL) {
+        return false;
+    }
+    for (size_t index = 0; index < size; index++) {
+        mvn_val_t priority = random_priority(bench);
+        if (!mvn_heap_push(bench->heap, priority, NULL) ||
+            !mvn_arr_push(bench->sorted, priority) || !mvn_arr_push(bench->priority, priority)) {
+            return false;
+        }
+    }
+    bench->indexed = mvn_heap_from_arr(copy_priorities(bench), 0, NULL, NULL);
+    return bench->indexed != NULL && mvn_arr_sort(bench->sorted, compare_descending);
+}
+
+static void heap_bench_free(heap_bench_t *bench)
+{
+    mvn_heap_free(bench->heap);
+    mvn_heap_free(bench->indexed);
+    mvn_arr_free(bench->sorted);
+    mvn_arr_free(bench->priority);
+}
+
+int main(int argc, char **argv)
+{
+    size_t min_size = DEFAULT_MIN_SIZE;
+    size_t max_size = DEFAULT_MAX_SIZE;
+    benchmark_take_size_option(&argc, argv, "min-size", &min_size);
+    benchmark_take_size_option(&argc, argv, "max-size", &max_size);
+
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        printf("Heap options: --min-size=N (default: %d), --max-size=N (default: %d)\n",
+               DEFAULT_MIN_SIZE,
+               DEFAULT_MAX_SIZE);
+        return 1;
+    }
+
+    const struct {
+        const char  *name;
+        benchmark_fn body;
+    } benchmarks[] = {
+        {"push_pop/heap", bench_heap_push_pop},
+        {"push_pop/resort", bench_resort_push_pop},
+        {"decrease_key/heap", bench_heap_decrease_key},
+        {"decrease_key/resort", bench_resort_decrease_key},
+        {"build/heapify", bench_heapify},
+        {"build/sort", bench_sort},
+    };
+
+    for (size_t size = min_size > 0 ? min_size : 1; size <= max_size; size *= 10) {
+        heap_bench_t bench = {0};
+        if (!heap_bench_init(&bench, size)) {
+            fprintf(stderr, "Failed to set up a queue of %zu items\n", size);
+            heap_bench_free(&bench);
+            return 1;
+        }
+        for (size_t index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]); index++) {
+            char name[96];
+            snprintf(name, sizeof(name), "queue/%s/%zu", benchmarks[index].name, size);
+            benchmark_run(&suite, name, benchmarks[index].body, &bench);
+        }
+        heap_bench_free(&bench);
+    }
+
+    return benchmark_suite_finish(&suite);
+}
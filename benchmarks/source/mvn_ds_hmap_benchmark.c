@@ -3,38 +3,66 @@
 
 #include <stdio.h>
 
-int main()
+#define LOOKUP_ELEMENTS 100000
+
+static void bench_hmap_creation(benchmark_state_t *state)
 {
-    const size_t num_elements = 100000;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_hmap_t *hmap = mvn_hmap_new();
+        mvn_hmap_free(hmap);
+    }
+}
 
-    // Benchmark hash map creation
-    clock_t     start = benchmark_start();
-    mvn_hmap_t *hmap  = mvn_hmap_new();
-    benchmark_end(start, "Hash Map Creation");
+static void bench_hmap_insertion(benchmark_state_t *state)
+{
+    benchmark_pause(state);
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    benchmark_resume(state);
 
-    // Benchmark hash map insertion
-    start = benchmark_start();
-    for (size_t i = 0; i < num_elements; ++i) {
+    for (size_t i = 0; i < state->iterations; ++i) {
         char key[32];
         snprintf(key, sizeof(key), "key%zu", i);
         mvn_hmap_set_cstr(hmap, key, mvn_val_i32((int)i));
     }
-    benchmark_end(start, "Hash Map Insertion (100K elements)");
 
-    // Benchmark hash map lookup
-    start = benchmark_start();
-    for (size_t i = 0; i < num_elements; ++i) {
-        char key[32];
-        snprintf(key, sizeof(key), "key%zu", i);
+    benchmark_pause(state);
+    mvn_hmap_free(hmap);
+    benchmark_resume(state);
+}
+
+static void bench_hmap_lookup(benchmark_state_t *state)
+{
+    mvn_hmap_t *hmap = (mvn_hmap_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = i % LOOKUP_ELEMENTS;
+        char   key[32];
+        snprintf(key, sizeof(key), "key%zu", index);
         mvn_val_t *val = mvn_hmap_cstr(hmap, key);
-        if (val == NULL || val->type != MVN_VAL_I32 || val->i32 != (int)i) {
+        if (val == NULL || val->type != MVN_VAL_I32 || val->i32 != (int)index) {
             fprintf(stderr, "Hash map lookup error for key %s\n", key);
         }
     }
-    benchmark_end(start, "Hash Map Lookup (100K elements)");
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        return 1;
+    }
+
+    benchmark_run(&suite, "Hash Map Creation", bench_hmap_creation, NULL);
+    benchmark_run(&suite, "Hash Map Insertion", bench_hmap_insertion, NULL);
 
-    // Free the hash map
+    // Lookups run against a prebuilt 100K element map
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    for (size_t i = 0; i < LOOKUP_ELEMENTS; ++i) {
+        char key[32];
+        snprintf(key, sizeof(key), "key%zu", i);
+        mvn_hmap_set_cstr(hmap, key, mvn_val_i32((int)i));
+    }
+    benchmark_run(&suite, "Hash Map Lookup (100K elements)", bench_hmap_lookup, hmap);
     mvn_hmap_free(hmap);
 
-    return 0;
+    return benchmark_suite_finish(&suite);
 }
@@ -0,0 +1,183 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_MIN_SIZE     1000
+#define DEFAULT_MAX_SIZE     1000000
+#define NESTED_LOOP_MAX_SIZE 10000 // Larger nested-loop joins take minutes per sample
+#define BENCHMARK_SEED       0x10140ULL
+
+// size orders and size users. Each order names a user; about one in eleven names a user that
+// does not exist, so left joins keep some orders alone.
+typedef struct join_bench_t {
+    size_t     size;   // Records on each side
+    mvn_arr_t *orders; // Left records {order, user, amount}
+    mvn_arr_t *users;  // Right records {user, name}, one per user id
+} join_bench_t;
+
+static uint64_t rng_next(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// --- Benchmarks ---
+
+// Baseline: count matching pairs with a nested loop over both arrays.
+static void bench_count_nested_loop(benchmark_state_t *state)
+{
+    join_bench_t *bench = (join_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t matches = 0;
+        for (size_t left = 0; left < bench->orders->count; left++) {
+            const mvn_val_t *key = mvn_hmap_cstr(bench->orders->data[left].hmap, "user");
+            for (size_t right = 0; right < bench->users->count; right++) {
+                const mvn_val_t *other = mvn_hmap_cstr(bench->users->data[right].hmap, "user");
+                matches += mvn_val_equal(key, other) ? 1 : 0;
+            }
+        }
+        benchmark_do_not_optimize(&matches);
+    }
+}
+
+// Same count through a hash index built on the users, as the join does.
+static void bench_count_index(benchmark_state_t *state)
+{
+    join_bench_t *bench = (join_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_index_t *index   = mvn_index_build(bench->users, "user");
+        size_t       matches = 0;
+        for (size_t left = 0; index != NULL && left < bench->orders->count; left++) {
+            size_t count = 0;
+            mvn_index_rows(index, mvn_hmap_cstr(bench->orders->data[left].hmap, "user"), &count);
+            matches += count;
+        }
+        benchmark_do_not_optimize(&matches);
+        benchmark_pause(state);
+        mvn_index_free(index);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_index_build(benchmark_state_t *state)
+{
+    join_bench_t *bench = (join_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_index_t *index = mvn_index_build(bench->orders, "user");
+        benchmark_do_not_optimize(index);
+        benchmark_pause(state);
+        mvn_index_free(index);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_join(benchmark_state_t *state, mvn_join_mode_t mode)
+{
+    join_bench_t *bench = (join_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_arr_t *joined = mvn_hash_join(bench->orders, bench->users, "user", "user", mode);
+        benchmark_do_not_optimize(joined);
+        benchmark_pause(state);
+        mvn_arr_free(joined);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_join_inner(benchmark_state_t *state)
+{
+    bench_join(state, MVN_JOIN_INNER);
+}
+
+static void bench_join_left(benchmark_state_t *state)
+{
+    bench_join(state, MVN_JOIN_LEFT);
+}
+
+static bool join_bench_init(join_bench_t *bench, size_t size)
+{
+    uint64_t rng  = BENCHMARK_SEED;
+    bench->size   = size;
+    bench->orders = mvn_arr_new_capacity(size);
+    bench->users  = mvn_arr_new_capacity(size);
+    if (bench->orders == NULL || bench->users == NULL) {
+        return false;
+    }
+    for (size_t index = 0; index < size; index++) {
+        char name[32];
+        snprintf(name, sizeof(name), "user%zu", index);
+        mvn_hmap_t *user  = mvn_hmap_new_capacity(4);
+        mvn_hmap_t *order = mvn_hmap_new_capacity(4);
+        if (user == NULL || order == NULL || !mvn_hmap_set_cstr(user, "user", mvn_val_u64(index)) ||
+            !mvn_hmap_set_cstr(user, "name", mvn_val_str(name)) ||
+            !mvn_hmap_set_cstr(order, "order", mvn_val_u64(index)) ||
+            !mvn_hmap_set_cstr(order, "user", mvn_val_u64(rng_next(&rng) % (size + size / 10))) ||
+            !mvn_hmap_set_cstr(order, "amount", mvn_val_i64((int64_t)(rng_next(&rng) % 1000)))) {
+            mvn_hmap_free(user);
+            mvn_hmap_free(order);
+            return false;
+        }
+        if (!mvn_arr_push(bench->users, mvn_val_hmap_take(user)) ||
+            !mvn_arr_push(bench->orders, mvn_val_hmap_take(order))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void join_bench_free(join_bench_t *bench)
+{
+    mvn_arr_free(bench->orders);
+    mvn_arr_free(bench->users);
+}
+
+int main(int argc, char **argv)
+{
+    size_t min_size = DEFAULT_MIN_SIZE;
+    size_t max_size = DEFAULT_MAX_SIZE;
+    benchmark_take_size_option(&argc, argv, "min-size", &min_size);
+    benchmark_take_size_option(&argc, argv, "max-size", &max_size);
+
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        printf("Join options: --min-size=N (default: %d), --max-size=N (default: %d)\n",
+               DEFAULT_MIN_SIZE,
+               DEFAULT_MAX_SIZE);
+        return 1;
+    }
+
+    const struct {
+        const char  *name;
+        benchmark_fn body;
+        size_t       max_size;
+    } benchmarks[] = {
+        {"count/nested_loop", bench_count_nested_loop, NESTED_LOOP_MAX_SIZE},
+        {"count/index", bench_count_index, SIZE_MAX},
+        {"index/build", bench_index_build, SIZE_MAX},
+        {"hash_join/inner", bench_join_inner, SIZE_MAX},
+        {"hash_join/left", bench_join_left, SIZE_MAX},
+    };
+
+    for (size_t size = min_size > 0 ? min_size : 1; size <= max_size; size *= 10) {
+        join_bench_t bench = {0};
+        if (!join_bench_init(&bench, size)) {
+            fprintf(stderr, "Failed to set up %zu x %zu records\n", size, size);
+            join_bench_free(&bench);
+            return 1;
+        }
+        for (size_t index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]); index++) {
+            if (size > benchmarks[index].max_size) {
+                continue;
+            }
+            char name[96];
+            snprintf(name, sizeof(name), "join/%s/%zux%zu", benchmarks[index].name, size, size);
+            benchmark_run(&suite, name, benchmarks[index].body, &bench);
+        }
+        join_bench_free(&bench);
+    }
+
+    return benchmark_suite_finish(&suite);
+}
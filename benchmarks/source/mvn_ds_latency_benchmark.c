@@ -0,0 +1,186 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_histogram.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sizes run from the minimum up to --max-size in powers of ten. The default keeps a full run
+// under a few seconds; resize stalls only reach milliseconds at tens of millions of elements.
+#define DEFAULT_MIN_SIZE   10000
+#define DEFAULT_MAX_SIZE   1000000
+#define SPIKE_THRESHOLD_NS 1000000 // Inserts at least this slow are counted as stalls
+#define APPEND_CHUNK       "abcdefgh"
+
+typedef struct latency_config_t {
+    size_t      min_size;
+    size_t      max_size;
+    const char *filter;
+    FILE       *distribution; // Receives full percentile distributions if not NULL
+} latency_config_t;
+
+// Times every push into a fresh array of count elements.
+static void measure_arr_push(latency_histogram_t *histogram, size_t count)
+{
+    mvn_arr_t *array = mvn_arr_new();
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t start = benchmark_now_ns();
+        mvn_arr_push(array, mvn_val_i64((int64_t)i));
+        latency_histogram_record(histogram, benchmark_now_ns() - start);
+    }
+    mvn_arr_free(array);
+}
+
+// Times every 8-byte append to a fresh string.
+static void measure_str_append(latency_histogram_t *histogram, size_t count)
+{
+    mvn_str_t *str = mvn_str_new("");
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t start = benchmark_now_ns();
+        mvn_str_append_cstr(str, APPEND_CHUNK);
+        latency_histogram_record(histogram, benchmark_now_ns() - start);
+    }
+    mvn_str_free(str);
+}
+
+// Times every insert of a new key into a fresh map. Keys are formatted outside the timed span.
+static void measure_hmap_set(latency_histogram_t *histogram, size_t count)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    char        key[32];
+    for (size_t i = 0; i < count; ++i) {
+        snprintf(key, sizeof(key), "key_%zu", i);
+        uint64_t start = benchmark_now_ns();
+        mvn_hmap_set_cstr(hmap, key, mvn_val_i64((int64_t)i));
+        latency_histogram_record(histogram, benchmark_now_ns() - start);
+    }
+    mvn_hmap_free(hmap);
+}
+
+typedef struct latency_operation_t {
+    const char *name;
+    void (*measure)(latency_histogram_t *histogram, size_t count);
+} latency_operation_t;
+
+static const latency_operation_t operations[] = {
+    {"arr_push", measure_arr_push},
+    {"str_append", measure_str_append},
+    {"hmap_set", measure_hmap_set},
+};
+
+// Smallest observed gap between two clock reads; every sample includes roughly this much.
+static uint64_t measure_timer_overhead(void)
+{
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t start   = benchmark_now_ns();
+        uint64_t elapsed = benchmark_now_ns() - start;
+        best             = elapsed < best ? elapsed : best;
+    }
+    return best;
+}
+
+static void print_row(const char *name, size_t count, const latency_histogram_t *histogram)
+{
+    const double percentiles[] = {50.0, 99.0, 99.9, 99.99};
+    char         texts[6][32];
+    for (size_t index = 0; index < 4; index++) {
+        benchmark_format_ns((double)latency_histogram_percentile(histogram, percentiles[index]),
+                            texts[index],
+                            sizeof(texts[index]));
+    }
+    benchmark_format_ns((double)histogram->max, texts[4], sizeof(texts[4]));
+    benchmark_format_ns(latency_histogram_mean(histogram), texts[5], sizeof(texts[5]));
+    printf("%-12s %12zu %10s %10s %10s %10s %10s %10s %8llu\n",
+           name,
+           count,
+           texts[5],
+           texts[0],
+           texts[1],
+           texts[2],
+           texts[3],
+           texts[4],
+           (unsigned long long)latency_histogram_count_at_or_above(histogram, SPIKE_THRESHOLD_NS));
+    fflush(stdout);
+}
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [options]\n"
+           "  --min-size=N         Smallest container size (default: %d)\n"
+           "  --max-size=N         Largest container size, e.g. 100000000 (default: %d)\n"
+           "  --filter=SUBSTRING   Only run operations whose name contains SUBSTRING\n"
+           "  --distribution=PATH  Write full percentile distributions (HdrHistogram format)\n",
+           program,
+           DEFAULT_MIN_SIZE,
+           DEFAULT_MAX_SIZE);
+}
+
+int main(int argc, char **argv)
+{
+    latency_config_t config = {DEFAULT_MIN_SIZE, DEFAULT_MAX_SIZE, NULL, NULL};
+    benchmark_take_size_option(&argc, argv, "min-size", &config.min_size);
+    benchmark_take_size_option(&argc, argv, "max-size", &config.max_size);
+    config.filter                 = benchmark_take_option(&argc, argv, "filter");
+    const char *distribution_path = benchmark_take_option(&argc, argv, "distribution");
+    if (argc > 1 || config.min_size == 0 || config.min_size > config.max_size) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (distribution_path != NULL) {
+        config.distribution = fopen(distribution_path, "w");
+        if (config.distribution == NULL) {
+            fprintf(stderr, "Failed to open %s for writing\n", distribution_path);
+            return 1;
+        }
+    }
+
+    latency_histogram_t *histogram = (latency_histogram_t *)malloc(sizeof(latency_histogram_t));
+    if (histogram == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    printf("Per-operation latency, one clock read pair per insert (timer overhead ~%llu ns)\n",
+           (unsigned long long)measure_timer_overhead());
+    printf("%-12s %12s %10s %10s %10s %10s %10s %10s %8s\n",
+           "Operation",
+           "Size",
+           "Mean",
+           "P50",
+           "P99",
+           "P99.9",
+           "P99.99",
+           "Max",
+           ">=1ms");
+
+    for (size_t op = 0; op < sizeof(operations) / sizeof(operations[0]); op++) {
+        if (config.filter != NULL && strstr(operations[op].name, config.filter) == NULL) {
+            continue;
+        }
+        for (size_t count = config.min_size;; count *= 10) {
+            count = count > config.max_size ? config.max_size : count;
+            latency_histogram_reset(histogram);
+            operations[op].measure(histogram, count);
+            print_row(operations[op].name, count, histogram);
+            if (config.distribution != NULL) {
+                fprintf(config.distribution,
+                        "# %s, %zu inserts, values in us\n",
+                        operations[op].name,
+                        count);
+                latency_histogram_write_distribution(histogram, config.distribution, 1000.0);
+                fprintf(config.distribution, "\n");
+            }
+            if (count == config.max_size) {
+                break;
+            }
+        }
+    }
+
+    free(histogram);
+    if (config.distribution != NULL && fclose(config.distribution) != 0) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "mvn_ds/mvn_ds_pool.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct fib_task_t {
+    mvn_pool_t *pool;
+    int         input;
+    long        result;
+} fib_task_t;
+
+static long fib_serial(int input)
+{
+    return input < 2 ? input : fib_serial(input - 1) + fib_serial(input - 2);
+}
+
+// Fork-join Fibonacci: spawn the left branch, run the right branch inline, then join.
+static void fib_task(void *context)
+{
+    fib_task_t *task = (fib_task_t *)context;
+    if (task->input < 20) {
+        task->result = fib_serial(task->input); // Sequential cutoff
+        return;
+    }
+    fib_task_t        left  = {task->pool, task->input - 1, 0};
+    fib_task_t        right = {task->pool, task->input - 2, 0};
+    mvn_pool_group_t *group = mvn_pool_group_new(task->pool);
+    if (group == NULL || !mvn_pool_group_submit(group, fib_task, &left)) {
+        fib_task(&left);
+    }
+    fib_task(&right);
+    mvn_pool_group_free(group);
+    task->result = left.result + right.result;
+}
+
+static void sum_range(size_t begin, size_t end, void *context)
+{
+    double *values = (double *)context;
+    for (size_t index = begin; index < end; index++) {
+        values[index] = values[index] * 0.5 + 1.0;
+    }
+}
+
+typedef struct pool_bench_t {
+    mvn_pool_t *pool;
+    double     *values;
+} pool_bench_t;
+
+#define FIB_INPUT    32
+#define NUM_ELEMENTS 10000000
+
+static void bench_fib_serial(benchmark_state_t *state)
+{
+    for (size_t i = 0; i < state->iterations; ++i) {
+        volatile long result = fib_serial(FIB_INPUT);
+        (void)result;
+    }
+}
+
+static void bench_fib_fork_join(benchmark_state_t *state)
+{
+    pool_bench_t *bench = (pool_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        fib_task_t root = {bench->pool, FIB_INPUT, 0};
+        fib_task(&root);
+    }
+}
+
+static void bench_range_serial(benchmark_state_t *state)
+{
+    pool_bench_t *bench = (pool_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        sum_range(0, NUM_ELEMENTS, bench->values);
+    }
+}
+
+static void bench_range_parallel(benchmark_state_t *state)
+{
+    pool_bench_t *bench = (pool_bench_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_pool_parallel_for(bench->pool, 0, NUM_ELEMENTS, 0, sum_range, bench->values);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        return 1;
+    }
+
+    pool_bench_t bench;
+    bench.pool   = mvn_pool_new(0);
+    bench.values = (double *)calloc(NUM_ELEMENTS, sizeof(double));
+    if (bench.pool == NULL || bench.values == NULL) {
+        fprintf(stderr, "Failed to create pool or values\n");
+        mvn_pool_free(bench.pool);
+        free(bench.values);
+        return 1;
+    }
+    fprintf(suite.report, "Pool workers: %zu\n", mvn_pool_thread_count(bench.pool));
+
+    // Check fork-join correctness once before timing it
+    fib_task_t check = {bench.pool, FIB_INPUT, 0};
+    fib_task(&check);
+    if (check.result != fib_serial(FIB_INPUT)) {
+        fprintf(stderr, "Fork-join result mismatch: %ld\n", check.result);
+    }
+
+    // Fork-join recursion against the serial baseline
+    benchmark_run(&suite, "Fibonacci (serial, n=32)", bench_fib_serial, &bench);
+    benchmark_run(&suite, "Fibonacci (fork-join, n=32)", bench_fib_fork_join, &bench);
+
+    // parallel_for with adaptive grain against a serial loop
+    benchmark_run(&suite, "Range Update (serial, 10M elements)", bench_range_serial, &bench);
+    benchmark_run(&suite, "Range Update (parallel_for, 10M elements)", bench_range_parallel, &bench);
+
+    free(bench.values);
+    mvn_pool_free(bench.pool);
+    return benchmark_suite_finish(&suite);
+}
@@ -2,39 +2,336 @@
 #include "mvn_ds_benchmark_utils.h"
 
 #include <stdio.h>
+#include <string.h>
 
-int main()
-{
-    const size_t num_iterations = 1000000;
+#define SHORT_STRING_LENGTH 8
+#define LONG_STRING_LENGTH  4096
+#define SMALL_CONTAINER     8
+#define LARGE_CONTAINER     10000
+#define COPY_BATCH_ELEMENTS 65536 // Elements held by one batch of copies, bounds memory use
+#define MAX_COPY_BATCH      256   // Copies made (or freed) between two pauses
+
+// A pair of equal but separately allocated values of one type and size.
+typedef struct value_fixture_t {
+    const char *name;     // Type and size, e.g. "string/long"
+    size_t      elements; // Characters, elements or entries; 0 for scalars
+    mvn_val_t   first;
+    mvn_val_t   second; // Deep copy of first, so comparisons walk the content
+    mvn_val_t  *batch;  // Scratch copies for the deep_copy and free benchmarks
+    size_t      batch_size;
+} value_fixture_t;
 
-    // Benchmark primitive creation
-    clock_t start = benchmark_start();
-    for (size_t i = 0; i < num_iterations; ++i) {
+static void bench_primitive_creation(benchmark_state_t *state)
+{
+    for (size_t i = 0; i < state->iterations; ++i) {
         mvn_val_t val = mvn_val_i32((int)i);
+        benchmark_do_not_optimize(&val);
         mvn_val_free(&val);
     }
-    benchmark_end(start, "Primitive Creation and Freeing (I32, 1M iterations)");
+}
 
-    // Benchmark primitive equality
+static void bench_primitive_equality(benchmark_state_t *state)
+{
     mvn_val_t val1 = mvn_val_i32(42);
     mvn_val_t val2 = mvn_val_i32(42);
-    start          = benchmark_start();
-    for (size_t i = 0; i < num_iterations; ++i) {
-        mvn_val_equal(&val1, &val2);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        bool equal = mvn_val_equal(&val1, &val2);
+        benchmark_do_not_optimize(&equal);
     }
-    benchmark_end(start, "Primitive Equality Check (I32, 1M iterations)");
-    mvn_val_free(&val1);
-    mvn_val_free(&val2);
+}
 
-    // Benchmark primitive access
+static void bench_primitive_access(benchmark_state_t *state)
+{
     mvn_val_t val_access = mvn_val_i32(12345);
-    start                = benchmark_start();
-    for (size_t i = 0; i < num_iterations; ++i) {
-        volatile int value = val_access.i32; // Use volatile to prevent compiler optimization
-        (void)value;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_clobber_memory(); // Reload the field every iteration
+        int32_t value = val_access.i32;
+        benchmark_do_not_optimize(&value);
+    }
+}
+
+// --- Per-Type Benchmarks ---
+
+static void bench_value_equal(benchmark_state_t *state)
+{
+    value_fixture_t *fixture = (value_fixture_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        bool equal = mvn_val_equal(&fixture->first, &fixture->second);
+        benchmark_do_not_optimize(&equal);
+    }
+}
+
+// Differing types return after the type check, which isolates the call and dispatch cost.
+static void bench_value_equal_type_mismatch(benchmark_state_t *state)
+{
+    value_fixture_t *fixture = (value_fixture_t *)state->context;
+    mvn_val_t        other   = fixture->first.type == MVN_VAL_NULL ? mvn_val_bool(false)
+                                                                   : mvn_val_null();
+    for (size_t i = 0; i < state->iterations; ++i) {
+        bool equal = mvn_val_equal(&fixture->first, &other);
+        benchmark_do_not_optimize(&equal);
     }
-    benchmark_end(start, "Primitive Access (I32, 1M iterations)");
-    mvn_val_free(&val_access);
+}
 
-    return 0;
+static void bench_value_compare(benchmark_state_t *state)
+{
+    value_fixture_t *fixture = (value_fixture_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        int order = mvn_val_compare(&fixture->first, &fixture->second);
+        benchmark_do_not_optimize(&order);
+    }
+}
+
+static void free_batch(value_fixture_t *fixture, size_t count)
+{
+    for (size_t copy = 0; copy < count; copy++) {
+        mvn_val_free(&fixture->batch[copy]);
+    }
+}
+
+// Copies are freed in batches with the clock paused.
+static void bench_value_deep_copy(benchmark_state_t *state)
+{
+    value_fixture_t *fixture = (value_fixture_t *)state->context;
+    for (size_t done = 0; done < state->iterations;) {
+        size_t count = state->iterations - done;
+        count        = count < fixture->batch_size ? count : fixture->batch_size;
+        for (size_t copy = 0; copy < count; copy++) {
+            fixture->batch[copy] = mvn_val_deep_copy(&fixture->first);
+        }
+        benchmark_clobber_memory();
+        benchmark_pause(state);
+        free_batch(fixture, count);
+        benchmark_resume(state);
+        done += count;
+    }
+}
+
+// Copies are made in batches with the clock paused.
+static void bench_value_free(benchmark_state_t *state)
+{
+    value_fixture_t *fixture = (value_fixture_t *)state->context;
+    for (size_t done = 0; done < state->iterations;) {
+        size_t count = state->iterations - done;
+        count        = count < fixture->batch_size ? count : fixture->batch_size;
+        benchmark_pause(state);
+        for (size_t copy = 0; copy < count; copy++) {
+            fixture->batch[copy] = mvn_val_deep_copy(&fixture->first);
+        }
+        benchmark_resume(state);
+        benchmark_clobber_memory();
+        free_batch(fixture, count);
+        done += count;
+    }
+}
+
+// --- Fixtures ---
+
+static mvn_val_t make_string(size_t length)
+{
+    mvn_str_t *string = mvn_str_new_capacity(length);
+    for (size_t index = 0; string != NULL && index < length; index++) {
+        char character[2] = {(char)('a' + index % 26), '\0'};
+        mvn_str_append_cstr(string, character);
+    }
+    return mvn_val_str_take(string);
+}
+
+// Mixed element types, so equal and deep_copy dispatch per element.
+static mvn_val_t make_element(size_t index)
+{
+    switch (index % 3) {
+        case 0:
+            return mvn_val_i64((int64_t)index);
+        case 1:
+            return mvn_val_f64((double)index * 0.5);
+        default: {
+            char text[24];
+            snprintf(text, sizeof(text), "value_%zu", index);
+            return mvn_val_str(text);
+        }
+    }
+}
+
+static mvn_val_t make_array(size_t count)
+{
+    mvn_arr_t *array = mvn_arr_new_capacity(count);
+    for (size_t index = 0; array != NULL && index < count; index++) {
+        mvn_arr_push(array, make_element(index));
+    }
+    return mvn_val_arr_take(array);
+}
+
+static mvn_hmap_t *make_hmap(size_t count)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new_capacity(count);
+    for (size_t index = 0; hmap != NULL && index < count; index++) {
+        char key[24];
+        snprintf(key, sizeof(key), "key_%zu", index);
+        mvn_hmap_set_cstr(hmap, key, make_element(index));
+    }
+    return hmap;
+}
+
+static mvn_val_t make_hset(size_t count)
+{
+    mvn_hset_t *hset = mvn_hset_new_capacity(count);
+    for (size_t index = 0; hset != NULL && index < count; index++) {
+        mvn_hset_insert(hset, make_element(index));
+    }
+    return mvn_val_hset_take(hset);
+}
+
+static mvn_val_t make_bitset(size_t size)
+{
+    mvn_bitset_t *bits = mvn_bitset_new(size);
+    for (size_t index = 0; bits != NULL && index < size; index += 3) {
+        mvn_bitset_set(bits, index);
+    }
+    return mvn_val_bitset_take(bits);
+}
+
+static bool
+fixture_init(value_fixture_t *fixture, const char *name, size_t elements, mvn_val_t first)
+{
+    fixture->name       = name;
+    fixture->elements   = elements;
+    fixture->first      = first;
+    fixture->second     = mvn_val_deep_copy(&first);
+    fixture->batch_size = COPY_BATCH_ELEMENTS / (elements + 1);
+    fixture->batch_size = fixture->batch_size < 1 ? 1 : fixture->batch_size;
+    fixture->batch_size = fixture->batch_size > MAX_COPY_BATCH ? MAX_COPY_BATCH
+                                                               : fixture->batch_size;
+    fixture->batch = (mvn_val_t *)calloc(fixture->batch_size, sizeof(mvn_val_t));
+    return fixture->batch != NULL && mvn_val_equal(&fixture->first, &fixture->second);
+}
+
+static void fixture_free(value_fixture_t *fixture)
+{
+    mvn_val_free(&fixture->first);
+    mvn_val_free(&fixture->second);
+    free(fixture->batch);
+    fixture->batch = NULL;
+}
+
+/**
+ * @brief Builds one fixture per mvn_val_type_t, plus empty, small and large sizes of every
+ * container type. Empty containers show the per-call cost that the larger sizes add to.
+ * @return The number of fixtures initialized; fixtures that failed are left out.
+ */
+static size_t make_fixtures(value_fixture_t *fixtures)
+{
+    static int pointee = 0;
+    struct {
+        const char *name;
+        size_t      elements;
+        mvn_val_t   value;
+    } specs[] = {
+        {"null", 0, mvn_val_null()},
+        {"bool", 0, mvn_val_bool(true)},
+        {"i8", 0, mvn_val_i8(-8)},
+        {"i16", 0, mvn_val_i16(-1600)},
+        {"i32", 0, mvn_val_i32(-320000)},
+        {"i64", 0, mvn_val_i64(-6400000000LL)},
+        {"u8", 0, mvn_val_u8(8)},
+        {"u16", 0, mvn_val_u16(1600)},
+        {"u32", 0, mvn_val_u32(320000)},
+        {"u64", 0, mvn_val_u64(6400000000ULL)},
+        {"f32", 0, mvn_val_f32(3.25f)},
+        {"f64", 0, mvn_val_f64(6.125)},
+        {"char", 0, mvn_val_char('x')},
+        {"ptr", 0, mvn_val_ptr(&pointee)},
+        {"string/empty", 0, make_string(0)},
+        {"string/short", SHORT_STRING_LENGTH, make_string(SHORT_STRING_LENGTH)},
+        {"string/long", LONG_STRING_LENGTH, make_string(LONG_STRING_LENGTH)},
+        {"array/empty", 0, make_array(0)},
+        {"array/small", SMALL_CONTAINER, make_array(SMALL_CONTAINER)},
+        {"array/large", LARGE_CONTAINER, make_array(LARGE_CONTAINER)},
+        {"hashmap/empty", 0, mvn_val_hmap_take(make_hmap(0))},
+        {"hashmap/small", SMALL_CONTAINER, mvn_val_hmap_take(make_hmap(SMALL_CONTAINER))},
+        {"hashmap/large", LARGE_CONTAINER, mvn_val_hmap_take(make_hmap(LARGE_CONTAINER))},
+        {"frozen_map/empty", 0, mvn_val_hmap_take(make_hmap(0))},
+        {"frozen_map/small", SMALL_CONTAINER, mvn_val_hmap_take(make_hmap(SMALL_CONTAINER))},
+        {"frozen_map/large", LARGE_CONTAINER, mvn_val_hmap_take(make_hmap(LARGE_CONTAINER))},
+        {"hashset/empty", 0, make_hset(0)},
+        {"hashset/small", SMALL_CONTAINER, make_hset(SMALL_CONTAINER)},
+        {"hashset/large", LARGE_CONTAINER, make_hset(LARGE_CONTAINER)},
+        {"bitset/empty", 0, make_bitset(0)},
+        {"bitset/small", SMALL_CONTAINER, make_bitset(SMALL_CONTAINER)},
+        {"bitset/large", LARGE_CONTAINER, make_bitset(LARGE_CONTAINER)},
+    };
+
+    size_t count = 0;
+    for (size_t spec = 0; spec < sizeof(specs) / sizeof(specs[0]); spec++) {
+        bool frozen = strncmp(specs[spec].name, "frozen_map/", 11) == 0;
+        if (frozen && !mvn_val_freeze(&specs[spec].value)) {
+            fprintf(stderr, "Failed to freeze the %s fixture\n", specs[spec].name);
+            mvn_val_free(&specs[spec].value);
+            continue;
+        }
+        if (!fixture_init(
+                &fixtures[count], specs[spec].name, specs[spec].elements, specs[spec].value)) {
+            fprintf(stderr, "Failed to set up the %s fixture\n", specs[spec].name);
+            fixture_free(&fixtures[count]);
+            continue;
+        }
+        count++;
+    }
+    return count;
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        return 1;
+    }
+
+    benchmark_run(&suite, "Primitive Creation and Freeing (I32)", bench_primitive_creation, NULL);
+    benchmark_run(&suite, "Primitive Equality Check (I32)", bench_primitive_equality, NULL);
+    benchmark_run(&suite, "Primitive Access (I32)", bench_primitive_access, NULL);
+
+    value_fixture_t fixtures[48];
+    size_t          fixture_count = make_fixtures(fixtures);
+    const struct {
+        const char  *name;
+        benchmark_fn body;
+        bool         per_element; // Report the cost per element over the empty container
+    } operations[] = {
+        {"equal", bench_value_equal, true},
+        {"equal_type_mismatch", bench_value_equal_type_mismatch, false},
+        {"compare", bench_value_compare, true},
+        {"deep_copy", bench_value_deep_copy, true},
+        {"free", bench_value_free, true},
+    };
+
+    for (size_t operation = 0; operation < sizeof(operations) / sizeof(operations[0]);
+         operation++) {
+        const char *empty_type = NULL; // Container type of the last empty fixture, e.g. "array/"
+        double      empty_ns   = 0.0;  // Same operation on that empty container
+        for (size_t fixture = 0; fixture < fixture_count; fixture++) {
+            const char *fixture_name = fixtures[fixture].name;
+            char        name[96];
+            snprintf(name, sizeof(name), "val/%s/%s", operations[operation].name, fixture_name);
+            const benchmark_result_t *result =
+                benchmark_run(&suite, name, operations[operation].body, &fixtures[fixture]);
+            if (result == NULL || !operations[operation].per_element) {
+                continue;
+            }
+            const char *size = strchr(fixture_name, '/');
+            if (size != NULL && strcmp(size, "/empty") == 0) {
+                empty_type = fixture_name;
+                empty_ns   = result->median;
+            } else if (size != NULL && empty_type != NULL &&
+                       strncmp(fixture_name, empty_type, (size_t)(size - fixture_name) + 1) == 0) {
+                // Content cost: what each element adds on top of the empty case
+                benchmark_report_per_element(&suite, result, empty_ns, fixtures[fixture].elements);
+            }
+        }
+    }
+
+    for (size_t fixture = 0; fixture < fixture_count; fixture++) {
+        fixture_free(&fixtures[fixture]);
+    }
+    return benchmark_suite_finish(&suite);
 }
@@ -0,0 +1,286 @@
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_document.h"
+#include "mvn_ds_benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SCALING_ATOMIC_INCREMENT(target) _InterlockedIncrement((volatile long *)(target))
+#define SCALING_ATOMIC_LOAD(target)      _InterlockedOr((volatile long *)(target), 0)
+#else
+#define SCALING_ATOMIC_INCREMENT(target) __atomic_add_fetch(target, 1, __ATOMIC_SEQ_CST)
+#define SCALING_ATOMIC_LOAD(target)      __atomic_load_n(target, __ATOMIC_ACQUIRE)
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#define SCALING_YIELD() SwitchToThread()
+#else
+#include <sched.h>
+#define SCALING_YIELD() sched_yield()
+#endif
+
+#define CHURN_ENTRIES      16    // Keys and elements per container in the churn workload
+#define DOCUMENT_LOOKUPS   4     // Path lookups per document in the document workload
+#define SHARED_MAP_KEYS    65536 // Keys in the shared frozen map
+#define SHARED_KEY_LENGTH  16
+#define DOCUMENT_SEED_BASE 0x5CA1EULL
+
+typedef struct scaling_bench_t scaling_bench_t;
+
+// Runs count operations of a workload on behalf of one thread.
+typedef void (*scaling_workload_fn)(scaling_bench_t *bench, size_t thread, size_t count);
+
+typedef struct scaling_task_t {
+    scaling_bench_t *bench;
+    size_t           thread;
+    size_t           count;
+} scaling_task_t;
+
+typedef struct scaling_workload_t {
+    const char         *name;
+    scaling_workload_fn run;
+    bool                uses_carr; // A fresh shared carr is created for each sample
+} scaling_workload_t;
+
+struct scaling_bench_t {
+    mvn_pool_t               *pool;
+    size_t                    threads;
+    const scaling_workload_t *workload;
+    volatile long             arrived; // Start barrier, so all threads really run at once
+    scaling_task_t           *tasks;
+    document_generator_t     *generators; // One per thread; each thread builds its own data
+    mvn_carr_t               *carr;
+    mvn_fmap_t               *fmap;
+    char (*keys)[SHARED_KEY_LENGTH];
+};
+
+// --- Workloads ---
+
+// Independent documents: build, query a few paths, deep copy, compare, free.
+static void workload_document(scaling_bench_t *bench, size_t thread, size_t count)
+{
+    document_generator_t *generator = &bench->generators[thread];
+    document_path_t       path;
+    for (size_t i = 0; i < count; ++i) {
+        mvn_val_t document = document_generate(generator);
+        for (size_t lookup = 0; lookup < DOCUMENT_LOOKUPS; lookup++) {
+            document_random_path(generator, &document, &path);
+            if (document_lookup(&document, &path) == NULL) {
+                fprintf(stderr, "Document lookup failed on thread %zu\n", thread);
+            }
+        }
+        mvn_val_t copy = mvn_val_deep_copy(&document);
+        if (!mvn_val_equal(&document, &copy)) {
+            fprintf(stderr, "Document copy differs on thread %zu\n", thread);
+        }
+        mvn_val_free(&copy);
+        mvn_val_free(&document);
+    }
+}
+
+// Short-lived small containers: stresses the allocator behind MVN_DS_MALLOC.
+static void workload_churn(scaling_bench_t *bench, size_t thread, size_t count)
+{
+    (void)bench;
+    (void)thread;
+    static const char *const keys[CHURN_ENTRIES] = {"k0", "k1", "k2",  "k3",  "k4",  "k5",
+                                                    "k6", "k7", "k8",  "k9",  "k10", "k11",
+                                                    "k12", "k13", "k14", "k15"};
+    for (size_t i = 0; i < count; ++i) {
+        mvn_hmap_t *hmap  = mvn_hmap_new();
+        mvn_arr_t  *array = mvn_arr_new();
+        for (size_t entry = 0; entry < CHURN_ENTRIES; entry++) {
+            mvn_hmap_set_cstr(hmap, keys[entry], mvn_val_str("value"));
+            mvn_arr_push(array, mvn_val_i64((int64_t)entry));
+        }
+        mvn_arr_free(array);
+        mvn_hmap_free(hmap);
+    }
+}
+
+// Every thread appends to one concurrent array.
+static void workload_shared_carr_push(scaling_bench_t *bench, size_t thread, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        mvn_carr_push(bench->carr, mvn_val_i64((int64_t)(thread * count + i)));
+    }
+}
+
+// Every thread reads one frozen map.
+static void workload_shared_fmap_lookup(scaling_bench_t *bench, size_t thread, size_t count)
+{
+    size_t index = thread * 7919; // Threads start at different keys
+    for (size_t i = 0; i < count; ++i) {
+        index = (index + 40503) % SHARED_MAP_KEYS;
+        if (mvn_fmap_get_cstr(bench->fmap, bench->keys[index]) == NULL) {
+            fprintf(stderr, "Shared map lookup failed for %s\n", bench->keys[index]);
+        }
+    }
+}
+
+static const scaling_workload_t workloads[] = {
+    {"document", workload_document, false},
+    {"churn", workload_churn, false},
+    {"shared_carr_push", workload_shared_carr_push, true},
+    {"shared_fmap_lookup", workload_shared_fmap_lookup, false},
+};
+
+#define WORKLOAD_COUNT (sizeof(workloads) / sizeof(workloads[0]))
+
+// --- Harness Glue ---
+
+static void scaling_task(void *context)
+{
+    scaling_task_t  *task  = (scaling_task_t *)context;
+    scaling_bench_t *bench = task->bench;
+    SCALING_ATOMIC_INCREMENT(&bench->arrived);
+    while ((size_t)SCALING_ATOMIC_LOAD(&bench->arrived) < bench->threads) {
+        SCALING_YIELD();
+    }
+    bench->workload->run(bench, task->thread, task->count);
+}
+
+// One operation per iteration, split evenly over the threads; ns/op is the inverse of the
+// aggregate throughput.
+static void bench_scaling(benchmark_state_t *state)
+{
+    scaling_bench_t *bench = (scaling_bench_t *)state->context;
+    if (bench->workload->uses_carr) {
+        benchmark_pause(state);
+        bench->carr = mvn_carr_new();
+        benchmark_resume(state);
+    }
+
+    bench->arrived = 0;
+    for (size_t thread = 0; thread < bench->threads; thread++) {
+        bench->tasks[thread].bench  = bench;
+        bench->tasks[thread].thread = thread;
+        bench->tasks[thread].count  = state->iterations / bench->threads +
+                                     (thread < state->iterations % bench->threads ? 1 : 0);
+        if (!mvn_pool_submit(bench->pool, scaling_task, &bench->tasks[thread])) {
+            fprintf(stderr, "Failed to submit scaling task\n");
+            bench->arrived = (long)bench->threads; // Release the others
+        }
+    }
+    mvn_pool_wait_idle(bench->pool);
+
+    if (bench->workload->uses_carr) {
+        benchmark_pause(state);
+        mvn_carr_free(bench->carr);
+        bench->carr = NULL;
+        benchmark_resume(state);
+    }
+}
+
+static bool scaling_bench_init(scaling_bench_t *bench, size_t max_threads)
+{
+    memset(bench, 0, sizeof(*bench));
+    bench->tasks      = (scaling_task_t *)calloc(max_threads, sizeof(scaling_task_t));
+    bench->generators = (document_generator_t *)calloc(max_threads, sizeof(document_generator_t));
+    bench->keys = (char(*)[SHARED_KEY_LENGTH])malloc(SHARED_MAP_KEYS * SHARED_KEY_LENGTH);
+    if (bench->tasks == NULL || bench->generators == NULL || bench->keys == NULL) {
+        return false;
+    }
+    document_config_t config = document_config_default();
+    for (size_t thread = 0; thread < max_threads; thread++) {
+        if (!document_generator_init(
+                &bench->generators[thread], &config, DOCUMENT_SEED_BASE + thread)) {
+            return false;
+        }
+    }
+
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    for (size_t index = 0; index < SHARED_MAP_KEYS && hmap != NULL; index++) {
+        snprintf(bench->keys[index], SHARED_KEY_LENGTH, "key_%05zu", index);
+        mvn_hmap_set_cstr(hmap, bench->keys[index], mvn_val_i64((int64_t)index));
+    }
+    bench->fmap = mvn_fmap_from_hmap(hmap);
+    if (bench->fmap == NULL) {
+        mvn_hmap_free(hmap);
+        return false;
+    }
+    return true;
+}
+
+static void scaling_bench_free(scaling_bench_t *bench, size_t max_threads)
+{
+    if (bench->generators != NULL) {
+        for (size_t thread = 0; thread < max_threads; thread++) {
+            document_generator_free(&bench->generators[thread]);
+        }
+    }
+    free(bench->generators);
+    free(bench->tasks);
+    free(bench->keys);
+    mvn_fmap_free(bench->fmap);
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_threads = 0;
+    benchmark_take_size_option(&argc, argv, "max-threads", &max_threads);
+
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        printf("Scaling options: --max-threads=N (default: hardware concurrency)\n");
+        return 1;
+    }
+    if (max_threads == 0) {
+        mvn_pool_t *probe = mvn_pool_new(0);
+        max_threads       = mvn_pool_thread_count(probe);
+        mvn_pool_free(probe);
+    }
+
+    scaling_bench_t bench;
+    memset(&bench, 0, sizeof(bench));
+    if (max_threads == 0 || !scaling_bench_init(&bench, max_threads)) {
+        fprintf(stderr, "Failed to set up scaling benchmark\n");
+        scaling_bench_free(&bench, max_threads);
+        return 1;
+    }
+    fprintf(suite.report, "Thread counts: 1, 2, 4, ... up to %zu\n", max_threads);
+
+    double single_thread_ns[WORKLOAD_COUNT] = {0};
+    for (size_t threads = 1;; threads *= 2) {
+        threads       = threads > max_threads ? max_threads : threads;
+        bench.threads = threads;
+        bench.pool    = mvn_pool_new(threads);
+        if (bench.pool == NULL) {
+            fprintf(stderr, "Failed to create a pool of %zu threads\n", threads);
+            break;
+        }
+        for (size_t workload = 0; workload < WORKLOAD_COUNT; workload++) {
+            char name[96];
+            snprintf(
+                name, sizeof(name), "scaling/%s/threads:%zu", workloads[workload].name, threads);
+            bench.workload                   = &workloads[workload];
+            const benchmark_result_t *result = benchmark_run(&suite, name, bench_scaling, &bench);
+            if (result == NULL || result->median <= 0.0) {
+                continue;
+            }
+            // Speedup and efficiency relative to the single-thread run of the same workload
+            if (threads == 1) {
+                single_thread_ns[workload] = result->median;
+            }
+            double speedup =
+                single_thread_ns[workload] > 0.0 ? single_thread_ns[workload] / result->median
+                                                 : 0.0;
+            fprintf(suite.report,
+                    "  -> %.0f ops/s, speedup %.2fx, efficiency %.0f%%\n",
+                    1e9 / result->median,
+                    speedup,
+                    speedup / (double)threads * 100.0);
+        }
+        mvn_pool_free(bench.pool);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    scaling_bench_free(&bench, max_threads);
+    return benchmark_suite_finish(&suite);
+}
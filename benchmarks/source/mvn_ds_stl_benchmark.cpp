@@ -0,0 +1,767 @@
+// Compares mvn_ds containers with their closest STL counterparts on identical workloads:
+//   mvn_arr_t  vs std::vector<std::variant<...>>
+//   mvn_hmap_t vs std::unordered_map<std::string, std::variant<...>>
+//   mvn_str_t  vs std::string
+// Every input (keys, values, strings, lookup sequences) is generated once up front from fixed
+// seeds and shared by both sides. Whole-container operations (insert, iterate, deep copy, free)
+// report time per container; lookups report time per lookup.
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds_benchmark_utils.h"
+#include "mvn_ds_benchmark_workload.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+// Elements per array and keys per map
+#define CONTAINER_SIZE 50000
+// Strings in the string pool
+#define STRING_POOL_SIZE 10000
+// Length of each pre-generated lookup sequence (a power of two)
+#define LOOKUP_SEQUENCE_LENGTH (1 << 16)
+// Elements in the array searched linearly by find benchmarks
+#define FIND_ARRAY_SIZE 1000
+
+typedef std::variant<std::monostate, bool, int64_t, double, std::string> std_value_t;
+typedef std::vector<std_value_t>                                          std_arr_t;
+typedef std::unordered_map<std::string, std_value_t>                      std_map_t;
+
+typedef struct workload_t {
+    // Shared inputs
+    std::vector<std::string> keys;      // Present keys, in insertion order
+    std::vector<std::string> miss_keys; // Keys that are never inserted
+    std::vector<std::string> strings;   // String pool with a spread of lengths
+    std::vector<std::string> probes;    // Equal to strings[i] (hits)
+    std::vector<std::string> near_miss; // strings[i] with the last character changed (misses)
+    std::vector<size_t>      sequences[2]; // Index sequences, by workload_distribution_t
+
+    // mvn_ds side
+    mvn_val_t               mvn_arr;  // Mixed-value array
+    mvn_val_t               mvn_find; // FIND_ARRAY_SIZE consecutive integers
+    mvn_val_t               mvn_map;
+    std::vector<mvn_str_t *> mvn_keys;
+    std::vector<mvn_str_t *> mvn_miss_keys;
+    std::vector<mvn_str_t *> mvn_strings;
+    std::vector<mvn_str_t *> mvn_probes;
+    std::vector<mvn_str_t *> mvn_near_miss;
+
+    // STL side
+    std_arr_t std_arr;
+    std_arr_t std_find;
+    std_map_t std_map;
+} workload_t;
+
+typedef struct lookup_context_t {
+    workload_t                *workload;
+    const std::vector<size_t> *sequence;
+} lookup_context_t;
+
+static volatile int64_t benchmark_sink; // Keeps results observable
+
+// --- Shared Value Generation ---
+
+// Value i of the mixed array: integers, doubles, booleans and strings in equal parts.
+static mvn_val_t make_mvn_value(const workload_t *workload, size_t index)
+{
+    switch (index % 4) {
+        case 0:
+            return mvn_val_i64((int64_t)index);
+        case 1:
+            return mvn_val_f64((double)index * 0.5);
+        case 2:
+            return mvn_val_bool((index & 8) != 0);
+        default:
+            return mvn_val_str(workload->strings[index % STRING_POOL_SIZE].c_str());
+    }
+}
+
+static std_value_t make_std_value(const workload_t *workload, size_t index)
+{
+    switch (index % 4) {
+        case 0:
+            return std_value_t((int64_t)index);
+        case 1:
+            return std_value_t((double)index * 0.5);
+        case 2:
+            return std_value_t((index & 8) != 0);
+        default:
+            return std_value_t(workload->strings[index % STRING_POOL_SIZE]);
+    }
+}
+
+static int64_t mvn_value_weight(const mvn_val_t *value)
+{
+    switch (value->type) {
+        case MVN_VAL_I64:
+            return value->i64;
+        case MVN_VAL_F64:
+            return (int64_t)value->f64;
+        case MVN_VAL_BOOL:
+            return value->b ? 1 : 0;
+        case MVN_VAL_STRING:
+            return (int64_t)value->str->length;
+        default:
+            return 0;
+    }
+}
+
+static int64_t std_value_weight(const std_value_t &value)
+{
+    if (const int64_t *integer = std::get_if<int64_t>(&value)) {
+        return *integer;
+    }
+    if (const double *number = std::get_if<double>(&value)) {
+        return (int64_t)*number;
+    }
+    if (const bool *flag = std::get_if<bool>(&value)) {
+        return *flag ? 1 : 0;
+    }
+    if (const std::string *text = std::get_if<std::string>(&value)) {
+        return (int64_t)text->size();
+    }
+    return 0;
+}
+
+// --- Array Benchmarks ---
+
+static void bench_arr_mvn_insert(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_arr_t *array = mvn_arr_new();
+        for (size_t index = 0; index < CONTAINER_SIZE; ++index) {
+            mvn_arr_push(array, make_mvn_value(workload, index));
+        }
+        benchmark_pause(state);
+        mvn_arr_free(array);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_arr_std_insert(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        std_arr_t *array = new std_arr_t();
+        for (size_t index = 0; index < CONTAINER_SIZE; ++index) {
+            array->push_back(make_std_value(workload, index));
+        }
+        benchmark_pause(state);
+        delete array;
+        benchmark_resume(state);
+    }
+}
+
+static void bench_arr_mvn_iterate(benchmark_state_t *state)
+{
+    const mvn_arr_t *array = ((const workload_t *)state->context)->mvn_arr.arr;
+    int64_t          total = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (size_t index = 0; index < array->count; ++index) {
+            total += mvn_value_weight(&array->data[index]);
+        }
+    }
+    benchmark_sink = total;
+}
+
+static void bench_arr_std_iterate(benchmark_state_t *state)
+{
+    const std_arr_t &array = ((const workload_t *)state->context)->std_arr;
+    int64_t          total = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (const std_value_t &value : array) {
+            total += std_value_weight(value);
+        }
+    }
+    benchmark_sink = total;
+}
+
+static void bench_arr_mvn_index(benchmark_state_t *state)
+{
+    const lookup_context_t *lookup = (const lookup_context_t *)state->context;
+    const mvn_arr_t        *array  = lookup->workload->mvn_arr.arr;
+    const size_t           *indices = lookup->sequence->data();
+    int64_t                 total   = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % CONTAINER_SIZE;
+        total += mvn_value_weight(mvn_arr_get(array, index));
+    }
+    benchmark_sink = total;
+}
+
+static void bench_arr_std_index(benchmark_state_t *state)
+{
+    const lookup_context_t *lookup  = (const lookup_context_t *)state->context;
+    const std_arr_t        &array   = lookup->workload->std_arr;
+    const size_t           *indices = lookup->sequence->data();
+    int64_t                 total   = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % CONTAINER_SIZE;
+        total += std_value_weight(array.at(index)); // Bounds-checked like mvn_arr_get
+    }
+    benchmark_sink = total;
+}
+
+// Linear search for a value that is present (offset 0) or absent (offset FIND_ARRAY_SIZE).
+static void bench_arr_mvn_find(benchmark_state_t *state, size_t offset)
+{
+    const lookup_context_t *lookup  = (const lookup_context_t *)state->context;
+    const mvn_arr_t        *array   = lookup->workload->mvn_find.arr;
+    const size_t           *indices = lookup->sequence->data();
+    int64_t                 found   = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t    target = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % FIND_ARRAY_SIZE + offset;
+        mvn_val_t needle = mvn_val_i64((int64_t)target);
+        found += mvn_arr_find(array, &needle, 0) != NULL;
+    }
+    benchmark_sink = found;
+}
+
+static void bench_arr_std_find(benchmark_state_t *state, size_t offset)
+{
+    const lookup_context_t *lookup  = (const lookup_context_t *)state->context;
+    const std_arr_t        &array   = lookup->workload->std_find;
+    const size_t           *indices = lookup->sequence->data();
+    int64_t                 found   = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t      target = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % FIND_ARRAY_SIZE + offset;
+        std_value_t needle((int64_t)target);
+        found += std::find(array.begin(), array.end(), needle) != array.end();
+    }
+    benchmark_sink = found;
+}
+
+static void bench_arr_mvn_find_hit(benchmark_state_t *state)
+{
+    bench_arr_mvn_find(state, 0);
+}
+
+static void bench_arr_mvn_find_miss(benchmark_state_t *state)
+{
+    bench_arr_mvn_find(state, FIND_ARRAY_SIZE);
+}
+
+static void bench_arr_std_find_hit(benchmark_state_t *state)
+{
+    bench_arr_std_find(state, 0);
+}
+
+static void bench_arr_std_find_miss(benchmark_state_t *state)
+{
+    bench_arr_std_find(state, FIND_ARRAY_SIZE);
+}
+
+static void bench_arr_mvn_deep_copy(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_val_t copy = mvn_val_deep_copy(&workload->mvn_arr);
+        benchmark_pause(state);
+        mvn_val_free(&copy);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_arr_std_deep_copy(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        std_arr_t *copy = new std_arr_t(workload->std_arr);
+        benchmark_pause(state);
+        delete copy;
+        benchmark_resume(state);
+    }
+}
+
+static void bench_arr_mvn_free(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        mvn_val_t copy = mvn_val_deep_copy(&workload->mvn_arr);
+        benchmark_resume(state);
+        mvn_val_free(&copy);
+    }
+}
+
+static void bench_arr_std_free(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        std_arr_t *copy = new std_arr_t(workload->std_arr);
+        benchmark_resume(state);
+        delete copy;
+    }
+}
+
+// --- Hash Map Benchmarks ---
+
+static void bench_map_mvn_insert(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_hmap_t *hmap = mvn_hmap_new();
+        for (size_t index = 0; index < CONTAINER_SIZE; ++index) {
+            mvn_hmap_set_cstr(hmap, workload->keys[index].c_str(), mvn_val_i64((int64_t)index));
+        }
+        benchmark_pause(state);
+        mvn_hmap_free(hmap);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_map_std_insert(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        std_map_t *map = new std_map_t();
+        for (size_t index = 0; index < CONTAINER_SIZE; ++index) {
+            map->emplace(workload->keys[index], std_value_t((int64_t)index));
+        }
+        benchmark_pause(state);
+        delete map;
+        benchmark_resume(state);
+    }
+}
+
+static void bench_map_mvn_lookup(benchmark_state_t *state, bool hit)
+{
+    const lookup_context_t   *lookup  = (const lookup_context_t *)state->context;
+    const mvn_hmap_t         *hmap    = lookup->workload->mvn_map.hmap;
+    mvn_str_t *const         *keys    = hit ? lookup->workload->mvn_keys.data()
+                                            : lookup->workload->mvn_miss_keys.data();
+    const size_t             *indices = lookup->sequence->data();
+    int64_t                   found   = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % CONTAINER_SIZE;
+        found += mvn_hmap_get(hmap, keys[index]) != NULL;
+    }
+    benchmark_sink = found;
+}
+
+static void bench_map_std_lookup(benchmark_state_t *state, bool hit)
+{
+    const lookup_context_t         *lookup  = (const lookup_context_t *)state->context;
+    const std_map_t                &map     = lookup->workload->std_map;
+    const std::vector<std::string> &keys    = hit ? lookup->workload->keys
+                                                  : lookup->workload->miss_keys;
+    const size_t                   *indices = lookup->sequence->data();
+    int64_t                         found   = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % CONTAINER_SIZE;
+        found += map.find(keys[index]) != map.end();
+    }
+    benchmark_sink = found;
+}
+
+static void bench_map_mvn_lookup_hit(benchmark_state_t *state)
+{
+    bench_map_mvn_lookup(state, true);
+}
+
+static void bench_map_mvn_lookup_miss(benchmark_state_t *state)
+{
+    bench_map_mvn_lookup(state, false);
+}
+
+static void bench_map_std_lookup_hit(benchmark_state_t *state)
+{
+    bench_map_std_lookup(state, true);
+}
+
+static void bench_map_std_lookup_miss(benchmark_state_t *state)
+{
+    bench_map_std_lookup(state, false);
+}
+
+static void bench_map_mvn_iterate(benchmark_state_t *state)
+{
+    const mvn_hmap_t *hmap  = ((const workload_t *)state->context)->mvn_map.hmap;
+    int64_t           total = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (size_t bucket = 0; bucket < hmap->capacity; ++bucket) {
+            for (const mvn_hmap_entry_t *entry = hmap->buckets[bucket]; entry != NULL;
+                 entry                         = entry->next) {
+                total += mvn_value_weight(&entry->value);
+            }
+        }
+    }
+    benchmark_sink = total;
+}
+
+static void bench_map_std_iterate(benchmark_state_t *state)
+{
+    const std_map_t &map   = ((const workload_t *)state->context)->std_map;
+    int64_t          total = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (const auto &entry : map) {
+            total += std_value_weight(entry.second);
+        }
+    }
+    benchmark_sink = total;
+}
+
+static void bench_map_mvn_deep_copy(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_val_t copy = mvn_val_deep_copy(&workload->mvn_map);
+        benchmark_pause(state);
+        mvn_val_free(&copy);
+        benchmark_resume(state);
+    }
+}
+
+static void bench_map_std_deep_copy(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        std_map_t *copy = new std_map_t(workload->std_map);
+        benchmark_pause(state);
+        delete copy;
+        benchmark_resume(state);
+    }
+}
+
+static void bench_map_mvn_free(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        mvn_val_t copy = mvn_val_deep_copy(&workload->mvn_map);
+        benchmark_resume(state);
+        mvn_val_free(&copy);
+    }
+}
+
+static void bench_map_std_free(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        std_map_t *copy = new std_map_t(workload->std_map);
+        benchmark_resume(state);
+        delete copy;
+    }
+}
+
+// --- String Benchmarks ---
+
+static void bench_str_mvn_append(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    benchmark_pause(state);
+    mvn_str_t *text = mvn_str_new("");
+    benchmark_resume(state);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        mvn_str_append_cstr(text, workload->strings[i % STRING_POOL_SIZE].c_str());
+    }
+    benchmark_pause(state);
+    mvn_str_free(text);
+    benchmark_resume(state);
+}
+
+static void bench_str_std_append(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    benchmark_pause(state);
+    std::string *text = new std::string();
+    benchmark_resume(state);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        text->append(workload->strings[i % STRING_POOL_SIZE]);
+    }
+    benchmark_pause(state);
+    delete text;
+    benchmark_resume(state);
+}
+
+static void bench_str_mvn_equal(benchmark_state_t *state, bool hit)
+{
+    const lookup_context_t *lookup  = (const lookup_context_t *)state->context;
+    const workload_t       *workload = lookup->workload;
+    mvn_str_t *const       *probes   = hit ? workload->mvn_probes.data()
+                                           : workload->mvn_near_miss.data();
+    const size_t           *indices  = lookup->sequence->data();
+    int64_t                 matches  = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % STRING_POOL_SIZE;
+        matches += mvn_str_equal(workload->mvn_strings[index], probes[index]);
+    }
+    benchmark_sink = matches;
+}
+
+static void bench_str_std_equal(benchmark_state_t *state, bool hit)
+{
+    const lookup_context_t         *lookup   = (const lookup_context_t *)state->context;
+    const workload_t               *workload = lookup->workload;
+    const std::vector<std::string> &probes   = hit ? workload->probes : workload->near_miss;
+    const size_t                   *indices  = lookup->sequence->data();
+    int64_t                         matches  = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        size_t index = indices[i & (LOOKUP_SEQUENCE_LENGTH - 1)] % STRING_POOL_SIZE;
+        matches += workload->strings[index] == probes[index];
+    }
+    benchmark_sink = matches;
+}
+
+static void bench_str_mvn_equal_hit(benchmark_state_t *state)
+{
+    bench_str_mvn_equal(state, true);
+}
+
+static void bench_str_mvn_equal_miss(benchmark_state_t *state)
+{
+    bench_str_mvn_equal(state, false);
+}
+
+static void bench_str_std_equal_hit(benchmark_state_t *state)
+{
+    bench_str_std_equal(state, true);
+}
+
+static void bench_str_std_equal_miss(benchmark_state_t *state)
+{
+    bench_str_std_equal(state, false);
+}
+
+static void bench_str_mvn_iterate(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    int64_t           total    = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (const mvn_str_t *text : workload->mvn_strings) {
+            for (size_t index = 0; index < text->length; ++index) {
+                total += (unsigned char)text->data[index];
+            }
+        }
+    }
+    benchmark_sink = total;
+}
+
+static void bench_str_std_iterate(benchmark_state_t *state)
+{
+    const workload_t *workload = (const workload_t *)state->context;
+    int64_t           total    = 0;
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (const std::string &text : workload->strings) {
+            for (char character : text) {
+                total += (unsigned char)character;
+            }
+        }
+    }
+    benchmark_sink = total;
+}
+
+static void bench_str_mvn_deep_copy(benchmark_state_t *state)
+{
+    const workload_t        *workload = (const workload_t *)state->context;
+    std::vector<mvn_str_t *> copies(STRING_POOL_SIZE);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (size_t index = 0; index < STRING_POOL_SIZE; ++index) {
+            copies[index] = mvn_str_new(workload->mvn_strings[index]->data);
+        }
+        benchmark_pause(state);
+        for (mvn_str_t *copy : copies) {
+            mvn_str_free(copy);
+        }
+        benchmark_resume(state);
+    }
+}
+
+static void bench_str_std_deep_copy(benchmark_state_t *state)
+{
+    const workload_t          *workload = (const workload_t *)state->context;
+    std::vector<std::string *> copies(STRING_POOL_SIZE);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        for (size_t index = 0; index < STRING_POOL_SIZE; ++index) {
+            copies[index] = new std::string(workload->strings[index]);
+        }
+        benchmark_pause(state);
+        for (std::string *copy : copies) {
+            delete copy;
+        }
+        benchmark_resume(state);
+    }
+}
+
+static void bench_str_mvn_free(benchmark_state_t *state)
+{
+    const workload_t        *workload = (const workload_t *)state->context;
+    std::vector<mvn_str_t *> copies(STRING_POOL_SIZE);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        for (size_t index = 0; index < STRING_POOL_SIZE; ++index) {
+            copies[index] = mvn_str_new(workload->mvn_strings[index]->data);
+        }
+        benchmark_resume(state);
+        for (mvn_str_t *copy : copies) {
+            mvn_str_free(copy);
+        }
+    }
+}
+
+static void bench_str_std_free(benchmark_state_t *state)
+{
+    const workload_t          *workload = (const workload_t *)state->context;
+    std::vector<std::string *> copies(STRING_POOL_SIZE);
+    for (size_t i = 0; i < state->iterations; ++i) {
+        benchmark_pause(state);
+        for (size_t index = 0; index < STRING_POOL_SIZE; ++index) {
+            copies[index] = new std::string(workload->strings[index]);
+        }
+        benchmark_resume(state);
+        for (std::string *copy : copies) {
+            delete copy;
+        }
+    }
+}
+
+// --- Setup ---
+
+static void workload_build(workload_t *workload)
+{
+    char key[32];
+    for (size_t index = 0; index < CONTAINER_SIZE; ++index) {
+        workload_format_key(key, sizeof(key), index, 1);
+        workload->keys.push_back(key);
+        workload->mvn_keys.push_back(mvn_str_new(key));
+        workload_format_key(key, sizeof(key), index, 0);
+        workload->miss_keys.push_back(key);
+        workload->mvn_miss_keys.push_back(mvn_str_new(key));
+    }
+
+    // Strings of 4..67 characters; short ones fit std::string's inline buffer, long ones do not
+    workload_rng_t rng;
+    workload_rng_seed(&rng, 42);
+    for (size_t index = 0; index < STRING_POOL_SIZE; ++index) {
+        size_t      length = 4 + workload_rng_below(&rng, 64);
+        std::string text;
+        for (size_t offset = 0; offset < length; ++offset) {
+            text.push_back((char)('a' + workload_rng_below(&rng, 26)));
+        }
+        std::string miss = text;
+        miss.back()      = miss.back() == 'z' ? 'a' : (char)(miss.back() + 1);
+        workload->strings.push_back(text);
+        workload->probes.push_back(text);
+        workload->near_miss.push_back(miss);
+        workload->mvn_strings.push_back(mvn_str_new(text.c_str()));
+        workload->mvn_probes.push_back(mvn_str_new(text.c_str()));
+        workload->mvn_near_miss.push_back(mvn_str_new(miss.c_str()));
+    }
+
+    for (int distribution = WORKLOAD_UNIFORM; distribution <= WORKLOAD_ZIPFIAN; ++distribution) {
+        workload->sequences[distribution].resize(LOOKUP_SEQUENCE_LENGTH);
+        workload_fill_indices(workload->sequences[distribution].data(),
+                              LOOKUP_SEQUENCE_LENGTH,
+                              CONTAINER_SIZE,
+                              (workload_distribution_t)distribution,
+                              1234);
+    }
+
+    workload->mvn_arr  = mvn_val_arr();
+    workload->mvn_find = mvn_val_arr();
+    workload->mvn_map  = mvn_val_hmap();
+    for (size_t index = 0; index < CONTAINER_SIZE; ++index) {
+        mvn_arr_push(workload->mvn_arr.arr, make_mvn_value(workload, index));
+        workload->std_arr.push_back(make_std_value(workload, index));
+        mvn_hmap_set_cstr(
+            workload->mvn_map.hmap, workload->keys[index].c_str(), mvn_val_i64((int64_t)index));
+        workload->std_map.emplace(workload->keys[index], std_value_t((int64_t)index));
+    }
+    for (size_t index = 0; index < FIND_ARRAY_SIZE; ++index) {
+        mvn_arr_push(workload->mvn_find.arr, mvn_val_i64((int64_t)index));
+        workload->std_find.push_back(std_value_t((int64_t)index));
+    }
+}
+
+static void workload_release(workload_t *workload)
+{
+    mvn_val_free(&workload->mvn_arr);
+    mvn_val_free(&workload->mvn_find);
+    mvn_val_free(&workload->mvn_map);
+    std::vector<mvn_str_t *> *lists[] = {&workload->mvn_keys,
+                                         &workload->mvn_miss_keys,
+                                         &workload->mvn_strings,
+                                         &workload->mvn_probes,
+                                         &workload->mvn_near_miss};
+    for (std::vector<mvn_str_t *> *list : lists) {
+        for (mvn_str_t *text : *list) {
+            mvn_str_free(text);
+        }
+    }
+}
+
+// Runs the same benchmark under both distributions, naming it "<group>/<impl>/<op>/<dist>".
+static void run_with_distributions(benchmark_suite_t *suite,
+                                   workload_t        *workload,
+                                   const char        *prefix,
+                                   benchmark_fn       body)
+{
+    for (int distribution = WORKLOAD_UNIFORM; distribution <= WORKLOAD_ZIPFIAN; ++distribution) {
+        lookup_context_t context = {workload, &workload->sequences[distribution]};
+        std::string      name    = std::string(prefix) + "/" +
+                           workload_distribution_name((workload_distribution_t)distribution);
+        benchmark_run(suite, name.c_str(), body, &context);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        return 1;
+    }
+
+    workload_t *workload = new workload_t();
+    workload_build(workload);
+
+    benchmark_run(&suite, "arr/mvn/insert (50K)", bench_arr_mvn_insert, workload);
+    benchmark_run(&suite, "arr/std/insert (50K)", bench_arr_std_insert, workload);
+    benchmark_run(&suite, "arr/mvn/iterate (50K)", bench_arr_mvn_iterate, workload);
+    benchmark_run(&suite, "arr/std/iterate (50K)", bench_arr_std_iterate, workload);
+    run_with_distributions(&suite, workload, "arr/mvn/index", bench_arr_mvn_index);
+    run_with_distributions(&suite, workload, "arr/std/index", bench_arr_std_index);
+    run_with_distributions(&suite, workload, "arr/mvn/find_hit (1K)", bench_arr_mvn_find_hit);
+    run_with_distributions(&suite, workload, "arr/std/find_hit (1K)", bench_arr_std_find_hit);
+    run_with_distributions(&suite, workload, "arr/mvn/find_miss (1K)", bench_arr_mvn_find_miss);
+    run_with_distributions(&suite, workload, "arr/std/find_miss (1K)", bench_arr_std_find_miss);
+    benchmark_run(&suite, "arr/mvn/deep_copy (50K)", bench_arr_mvn_deep_copy, workload);
+    benchmark_run(&suite, "arr/std/deep_copy (50K)", bench_arr_std_deep_copy, workload);
+    benchmark_run(&suite, "arr/mvn/free (50K)", bench_arr_mvn_free, workload);
+    benchmark_run(&suite, "arr/std/free (50K)", bench_arr_std_free, workload);
+
+    benchmark_run(&suite, "map/mvn/insert (50K)", bench_map_mvn_insert, workload);
+    benchmark_run(&suite, "map/std/insert (50K)", bench_map_std_insert, workload);
+    run_with_distributions(&suite, workload, "map/mvn/lookup_hit", bench_map_mvn_lookup_hit);
+    run_with_distributions(&suite, workload, "map/std/lookup_hit", bench_map_std_lookup_hit);
+    run_with_distributions(&suite, workload, "map/mvn/lookup_miss", bench_map_mvn_lookup_miss);
+    run_with_distributions(&suite, workload, "map/std/lookup_miss", bench_map_std_lookup_miss);
+    benchmark_run(&suite, "map/mvn/iterate (50K)", bench_map_mvn_iterate, workload);
+    benchmark_run(&suite, "map/std/iterate (50K)", bench_map_std_iterate, workload);
+    benchmark_run(&suite, "map/mvn/deep_copy (50K)", bench_map_mvn_deep_copy, workload);
+    benchmark_run(&suite, "map/std/deep_copy (50K)", bench_map_std_deep_copy, workload);
+    benchmark_run(&suite, "map/mvn/free (50K)", bench_map_mvn_free, workload);
+    benchmark_run(&suite, "map/std/free (50K)", bench_map_std_free, workload);
+
+    benchmark_run(&suite, "str/mvn/append", bench_str_mvn_append, workload);
+    benchmark_run(&suite, "str/std/append", bench_str_std_append, workload);
+    run_with_distributions(&suite, workload, "str/mvn/equal_hit", bench_str_mvn_equal_hit);
+    run_with_distributions(&suite, workload, "str/std/equal_hit", bench_str_std_equal_hit);
+    run_with_distributions(&suite, workload, "str/mvn/equal_miss", bench_str_mvn_equal_miss);
+    run_with_distributions(&suite, workload, "str/std/equal_miss", bench_str_std_equal_miss);
+    benchmark_run(&suite, "str/mvn/iterate (10K strings)", bench_str_mvn_iterate, workload);
+    benchmark_run(&suite, "str/std/iterate (10K strings)", bench_str_std_iterate, workload);
+    benchmark_run(&suite, "str/mvn/deep_copy (10K strings)", bench_str_mvn_deep_copy, workload);
+    benchmark_run(&suite, "str/std/deep_copy (10K strings)", bench_str_std_deep_copy, workload);
+    benchmark_run(&suite, "str/mvn/free (10K strings)", bench_str_mvn_free, workload);
+    benchmark_run(&suite, "str/std/free (10K strings)", bench_str_std_free, workload);
+
+    workload_release(workload);
+    delete workload;
+    return benchmark_suite_finish(&suite);
+}
@@ -3,32 +3,42 @@
 
 #include <stdio.h>
 
-int main()
+static void bench_str_creation(benchmark_state_t *state)
 {
-    const size_t num_iterations = 100000;
-
-    // Benchmark string creation
-    clock_t start = benchmark_start();
-    for (size_t i = 0; i < num_iterations; ++i) {
+    for (size_t i = 0; i < state->iterations; ++i) {
         mvn_str_t *str = mvn_str_new("benchmark");
         mvn_str_free(str);
     }
-    benchmark_end(start, "String Creation and Destruction (100K iterations)");
+}
 
-    // Benchmark string appending
+static void bench_str_append(benchmark_state_t *state)
+{
+    benchmark_pause(state);
     mvn_str_t *str = mvn_str_new("start");
+    benchmark_resume(state);
     if (!str) {
         fprintf(stderr, "Failed to create string for appending benchmark.\n");
-        return 1;
+        return;
     }
 
-    start = benchmark_start();
-    for (size_t i = 0; i < num_iterations; ++i) {
+    for (size_t i = 0; i < state->iterations; ++i) {
         mvn_str_append_cstr(str, "_append");
     }
-    benchmark_end(start, "String Appending (100K iterations)");
 
+    benchmark_pause(state);
     mvn_str_free(str);
+    benchmark_resume(state);
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_suite_t suite;
+    if (!benchmark_suite_init(&suite, argc, argv)) {
+        return 1;
+    }
+
+    benchmark_run(&suite, "String Creation and Destruction", bench_str_creation, NULL);
+    benchmark_run(&suite, "String Appending", bench_str_append, NULL);
 
-    return 0;
+    return benchmark_suite_finish(&suite);
 }
@@ -7,9 +7,23 @@
 #include "mvn_ds_types.h" // Include all structure definitions
 
 // Include component function declarations
+#include "mvn_ds_alloc.h"
 #include "mvn_ds_arr.h"
+#include "mvn_ds_art.h"
+#include "mvn_ds_bitset.h"
+#include "mvn_ds_bloom.h"
+#include "mvn_ds_btree.h"
+#include "mvn_ds_carr.h"
+#include "mvn_ds_fmap.h"
+#include "mvn_ds_group.h"
+#include "mvn_ds_heap.h"
 #include "mvn_ds_hmap.h"
+#include "mvn_ds_hset.h"
+#include "mvn_ds_join.h"
+#include "mvn_ds_lru.h"
+#include "mvn_ds_pool.h"
 #include "mvn_ds_str.h"
+#include "mvn_ds_table.h"
 
 // Include basic stdlib headers needed by users of mvn_val_t directly
 #include <stdbool.h>
@@ -36,12 +50,17 @@ mvn_val_t mvn_val_f32(float f32);
 mvn_val_t mvn_val_f64(double f64);
 mvn_val_t mvn_val_char(char c);
 mvn_val_t mvn_val_ptr(void *ptr_val);
-mvn_val_t mvn_val_str(const char *chars);      // Creates a new owned string
-mvn_val_t mvn_val_str_take(mvn_str_t *str);    // Takes ownership of an existing string
-mvn_val_t mvn_val_arr(void);                   // Creates a new empty owned array
-mvn_val_t mvn_val_arr_take(mvn_arr_t *arr);    // Takes ownership of an existing array
-mvn_val_t mvn_val_hmap(void);                  // Creates a new empty owned hash map
-mvn_val_t mvn_val_hmap_take(mvn_hmap_t *hmap); // Takes ownership of an existing map
+mvn_val_t mvn_val_str(const char *chars);          // Creates a new owned string
+mvn_val_t mvn_val_str_take(mvn_str_t *str);        // Takes ownership of an existing string
+mvn_val_t mvn_val_arr(void);                       // Creates a new empty owned array
+mvn_val_t mvn_val_arr_take(mvn_arr_t *arr);        // Takes ownership of an existing array
+mvn_val_t mvn_val_hmap(void);                      // Creates a new empty owned hash map
+mvn_val_t mvn_val_hmap_take(mvn_hmap_t *hmap);     // Takes ownership of an existing map
+mvn_val_t mvn_val_fmap_take(mvn_fmap_t *fmap);     // Takes ownership of an existing frozen map
+mvn_val_t mvn_val_hset(void);                      // Creates a new empty owned hash set
+mvn_val_t mvn_val_hset_take(mvn_hset_t *hset);     // Takes ownership of an existing hash set
+mvn_val_t mvn_val_bitset(size_t size);             // Creates a new owned bitset of size clear bits
+mvn_val_t mvn_val_bitset_take(mvn_bitset_t *bits); // Takes ownership of an existing bitset
 
 // --- Value Operations ---
 // Frees the resources owned by a mvn_val_t.
@@ -63,9 +82,23 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value);
 // Comparison order between different types is defined (e.g., NULL < BOOL < I32 < STRING ...).
 int mvn_val_compare(const mvn_val_t *val_one, const mvn_val_t *val_two);
 
+// Returns a structural 64-bit hash consistent with mvn_val_equal (floats are hashed by exact
+// value). Maps and sets hash the same regardless of insertion order.
+uint64_t mvn_val_hash(const mvn_val_t *value);
+
 // Converts a mvn_val_type_t enum to its string representation.
 const char *mvn_val_type_to_str(mvn_val_type_t type);
 
+// Recursively freezes a value in place: hash maps become immutable frozen maps (one probe per
+// lookup, safe to share between threads without locks) and array elements are frozen. Hash
+// set elements are left as they are, since freezing them would change their hashes.
+// Returns false on failure, in which case value is still valid but may be partially frozen.
+bool mvn_val_freeze(mvn_val_t *value);
+
+// Returns the heap bytes owned by a value and everything nested in it (requested sizes,
+// counting container capacity rather than element count). The mvn_val_t itself is not counted.
+size_t mvn_val_memory_usage(const mvn_val_t *value);
+
 // --- Component Operations ---
 // Declarations are now in their respective headers (mvn_ds_str.h, etc.)
 
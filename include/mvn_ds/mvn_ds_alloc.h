@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_ALLOC_H
+#define MVN_DS_ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Allocation statistics. When the library is built with MVN_DS_ALLOC_STATS (CMake option of the
+// same name), the MVN_DS_MALLOC family records every call per call site and per container type.
+// Otherwise the macros map straight to the C allocator and the functions below report nothing.
+
+// Maximum number of distinct call sites tracked; further sites only count towards the totals
+#define MVN_DS_ALLOC_MAX_SITES 256
+
+// Bytes reserved in front of each tracked block to remember its size and call site
+#define MVN_DS_ALLOC_HEADER_SIZE 16
+
+/**
+ * @brief Container type an allocation was made for, taken from the allocating source file.
+ */
+typedef enum {
+    MVN_DS_ALLOC_KIND_VAL,    /**< Generic value helpers (mvn_ds.c). */
+    MVN_DS_ALLOC_KIND_STR,    /**< Strings. */
+    MVN_DS_ALLOC_KIND_ARR,    /**< Dynamic arrays. */
+    MVN_DS_ALLOC_KIND_CARR,   /**< Concurrent arrays. */
+    MVN_DS_ALLOC_KIND_HMAP,   /**< Hash maps. */
+    MVN_DS_ALLOC_KIND_FMAP,   /**< Frozen maps. */
+    MVN_DS_ALLOC_KIND_HSET,   /**< Hash sets. */
+    MVN_DS_ALLOC_KIND_BTREE,  /**< B+trees. */
+    MVN_DS_ALLOC_KIND_HEAP,   /**< Heaps. */
+    MVN_DS_ALLOC_KIND_BITSET, /**< Bitsets. */
+    MVN_DS_ALLOC_KIND_LRU,    /**< LRU caches. */
+    MVN_DS_ALLOC_KIND_BLOOM,  /**< Bloom filters. */
+    MVN_DS_ALLOC_KIND_ART,    /**< Adaptive radix trees. */
+    MVN_DS_ALLOC_KIND_TABLE,  /**< Columnar tables. */
+    MVN_DS_ALLOC_KIND_GROUP,  /**< Group-by working state. */
+    MVN_DS_ALLOC_KIND_JOIN,   /**< Hash indexes and joins. */
+    MVN_DS_ALLOC_KIND_POOL,   /**< Thread pool. */
+    MVN_DS_ALLOC_KIND_OTHER,  /**< Any other user of the MVN_DS_MALLOC family. */
+    MVN_DS_ALLOC_KIND_COUNT   /**< Number of kinds (not a kind). */
+} mvn_ds_alloc_kind_t;
+
+/**
+ * @brief Counters for one call site, one kind, or all allocations.
+ */
+typedef struct mvn_ds_alloc_counters_t {
+    uint64_t allocs;          /**< MVN_DS_MALLOC and MVN_DS_CALLOC calls that succeeded. */
+    uint64_t reallocs;        /**< MVN_DS_REALLOC calls that succeeded. */
+    uint64_t frees;           /**< MVN_DS_FREE calls with a non-NULL pointer. */
+    uint64_t bytes_requested; /**< Bytes requested by successful allocs and reallocs. */
+    uint64_t live_bytes;      /**< Bytes currently allocated (kept across resets). */
+} mvn_ds_alloc_counters_t;
+
+/**
+ * @brief Counters for one allocation call site. Frees count against the site that made
+ * the block; a realloc moves the block's live bytes to the realloc site.
+ */
+typedef struct mvn_ds_alloc_site_t {
+    const char             *file; /**< __FILE__ of the call site. */
+    int                     line; /**< __LINE__ of the call site. */
+    mvn_ds_alloc_kind_t     kind; /**< Container type of the call site. */
+    mvn_ds_alloc_counters_t counters;
+} mvn_ds_alloc_site_t;
+
+/**
+ * @brief Snapshot of all allocation statistics.
+ */
+typedef struct mvn_ds_alloc_stats_t {
+    bool                    enabled;    /**< False if the library was built without stats. */
+    mvn_ds_alloc_counters_t total;      /**< All allocations. */
+    mvn_ds_alloc_counters_t kinds[MVN_DS_ALLOC_KIND_COUNT]; /**< Per container type. */
+    size_t                  site_count; /**< Number of valid entries in sites. */
+    mvn_ds_alloc_site_t     sites[MVN_DS_ALLOC_MAX_SITES];  /**< In first-use order. */
+} mvn_ds_alloc_stats_t;
+
+// --- Statistics ---
+
+// Copies the current statistics into stats. Returns false (and zeroes stats) when the library
+// was built without MVN_DS_ALLOC_STATS.
+bool mvn_ds_alloc_stats(mvn_ds_alloc_stats_t *stats);
+
+// Zeroes the alloc, realloc, free and byte counters. Live bytes are kept since the blocks
+// they describe are still allocated.
+void mvn_ds_alloc_stats_reset(void);
+
+// Returns allocs + reallocs so far without copying the full snapshot; 0 when compiled out.
+uint64_t mvn_ds_alloc_count(void);
+
+// --- Tracked Allocators ---
+// Used by the MVN_DS_MALLOC family when stats are enabled; not meant to be called directly.
+
+#ifdef MVN_DS_ALLOC_STATS
+void *mvn_ds_alloc_stats_malloc(size_t size, mvn_ds_alloc_kind_t kind, const char *file, int line);
+void *mvn_ds_alloc_stats_calloc(
+    size_t count, size_t size, mvn_ds_alloc_kind_t kind, const char *file, int line);
+void *mvn_ds_alloc_stats_realloc(
+    void *pointer, size_t size, mvn_ds_alloc_kind_t kind, const char *file, int line);
+void mvn_ds_alloc_stats_free(void *pointer);
+#endif /* MVN_DS_ALLOC_STATS */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_ALLOC_H */
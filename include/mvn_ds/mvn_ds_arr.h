@@ -106,6 +106,19 @@ mvn_arr_index_of(const mvn_arr_t *array, const mvn_val_t *value_to_find, size_t
 // Returns the index of the last occurrence, or -1 if not found or on invalid input.
 ptrdiff_t mvn_arr_last_index_of(const mvn_arr_t *array, const mvn_val_t *value_to_find);
 
+// Removes duplicate values in place, comparing with mvn_val_hash and mvn_val_equal through a
+// temporary hash table in O(n). Keeps each value's first occurrence (or its last, if keep_first
+// is false); survivors keep their relative order and are moved, not copied. Duplicates are freed.
+// F32 and F64 values are matched by exact value, as in mvn_hset_t: values that mvn_val_equal
+// accepts as equal within its epsilon may both be kept. mvn_arr_unique_sorted merges them.
+// Returns false if array is NULL or on allocation failure, leaving the array unchanged.
+bool mvn_arr_unique(mvn_arr_t *array, bool keep_first);
+
+// Removes adjacent duplicate values (by mvn_val_equal) in place in one linear pass, keeping the
+// first of each run. On an array sorted by mvn_arr_sort this removes every duplicate.
+// Returns false if array is NULL.
+bool mvn_arr_unique_sorted(mvn_arr_t *array);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
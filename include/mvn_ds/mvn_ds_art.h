@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_ART_H
+#define MVN_DS_ART_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// --- Adaptive Radix Tree Operations ---
+// Keys are byte strings, ordered bytewise with a prefix before its extensions ("ab" < "abc" <
+// "b"). Lookups, inserts and removals cost O(key length) whatever the number of keys. Chains of
+// single-child nodes are collapsed into one node, and each node is allocated as the smallest
+// of four layouts (4, 16, 48 or 256 children) that holds its children.
+
+// Creates a new, empty tree. No nodes are allocated until the first insert.
+mvn_art_t *mvn_art_new(void);
+
+// Frees the tree, including all of its keys and values.
+void mvn_art_free(mvn_art_t *art);
+
+// Sets the value for key, taking ownership of the value. The key's bytes are copied. If the key
+// exists, its old value is freed. Returns false on allocation failure or invalid input (the
+// value is freed in that case).
+bool mvn_art_put(mvn_art_t *art, const mvn_str_t *key, mvn_val_t value);
+
+// Same as mvn_art_put with a C string key.
+bool mvn_art_put_cstr(mvn_art_t *art, const char *key_cstr, mvn_val_t value);
+
+// Returns a pointer to the value for key, or NULL if it isn't present.
+mvn_val_t *mvn_art_get(const mvn_art_t *art, const mvn_str_t *key);
+
+// Same as mvn_art_get with a C string key.
+mvn_val_t *mvn_art_get_cstr(const mvn_art_t *art, const char *key_cstr);
+
+// Removes the entry for key, freeing its value. Returns false if there was none.
+bool mvn_art_remove(mvn_art_t *art, const mvn_str_t *key);
+
+// Same as mvn_art_remove with a C string key.
+bool mvn_art_remove_cstr(mvn_art_t *art, const char *key_cstr);
+
+// Returns the number of keys in the tree.
+size_t mvn_art_count(const mvn_art_t *art);
+
+// Returns the bytes held by the tree's nodes and leaves (including the key copies), not
+// counting memory owned by the values.
+size_t mvn_art_memory_usage(const mvn_art_t *art);
+
+// --- Iteration ---
+
+// Returns an iterator over every entry in ascending key order.
+mvn_art_iter_t mvn_art_iter(const mvn_art_t *art);
+
+// Returns an iterator over the entries whose key starts with prefix_cstr, in ascending key
+// order. Finding the first entry costs O(prefix length). prefix_cstr is not copied and must
+// outlive the iterator.
+mvn_art_iter_t mvn_art_prefix(const mvn_art_t *art, const char *prefix_cstr);
+
+// Advances the iterator. Stores the entry's null-terminated key and its value (either pointer
+// may be NULL) and returns true, or returns false when the entries are exhausted.
+bool mvn_art_iter_next(mvn_art_iter_t *iter, const char **key, mvn_val_t **value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_ART_H */
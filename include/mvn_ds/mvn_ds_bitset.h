@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_BITSET_H
+#define MVN_DS_BITSET_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Returned by the search functions when no bit matches
+#define MVN_DS_BITSET_NPOS ((size_t)-1)
+// Bits per rank index block; each block stores the number of set bits before it
+#define MVN_DS_BITSET_RANK_BLOCK_BITS 512
+
+// --- Bitset Operations ---
+// Indices past the size are rejected (setters return false, mvn_bitset_test returns false).
+
+// Creates a new bitset of size bits, all clear. Returns NULL on allocation failure.
+mvn_bitset_t *mvn_bitset_new(size_t size);
+
+// Frees the bitset.
+void mvn_bitset_free(mvn_bitset_t *bitset);
+
+// Creates a copy of the bitset (without its rank index). Returns NULL on allocation failure or
+// if bitset is NULL.
+mvn_bitset_t *mvn_bitset_copy(const mvn_bitset_t *bitset);
+
+// Changes the size to size bits. Added bits are clear. Returns false on allocation failure
+// (the bitset is unchanged).
+bool mvn_bitset_resize(mvn_bitset_t *bitset, size_t size);
+
+// Returns the number of bits.
+size_t mvn_bitset_size(const mvn_bitset_t *bitset);
+
+// Returns whether bit index is set.
+bool mvn_bitset_test(const mvn_bitset_t *bitset, size_t index);
+
+// Sets bit index to value.
+bool mvn_bitset_assign(mvn_bitset_t *bitset, size_t index, bool value);
+
+// Sets bit index to 1.
+bool mvn_bitset_set(mvn_bitset_t *bitset, size_t index);
+
+// Sets bit index to 0.
+bool mvn_bitset_reset(mvn_bitset_t *bitset, size_t index);
+
+// Inverts bit index.
+bool mvn_bitset_flip(mvn_bitset_t *bitset, size_t index);
+
+// Sets every bit to value.
+void mvn_bitset_fill(mvn_bitset_t *bitset, bool value);
+
+// Returns the number of set bits (population count).
+size_t mvn_bitset_count(const mvn_bitset_t *bitset);
+
+// Returns the index of the first set bit at or after from, or MVN_DS_BITSET_NPOS.
+size_t mvn_bitset_find_first_set(const mvn_bitset_t *bitset, size_t from);
+
+// Returns the index of the first clear bit at or after from, or MVN_DS_BITSET_NPOS.
+size_t mvn_bitset_find_first_unset(const mvn_bitset_t *bitset, size_t from);
+
+// Checks if two bitsets have the same size and bits. Two NULL bitsets are equal.
+bool mvn_bitset_equal(const mvn_bitset_t *bitset_one, const mvn_bitset_t *bitset_two);
+
+// --- Bulk Operations ---
+// Each combines other into target word by word (16 bytes at a time with SSE2). Both must have
+// the same size; returns false otherwise.
+
+bool mvn_bitset_and(mvn_bitset_t *target, const mvn_bitset_t *other);    // target &= other
+bool mvn_bitset_or(mvn_bitset_t *target, const mvn_bitset_t *other);     // target |= other
+bool mvn_bitset_xor(mvn_bitset_t *target, const mvn_bitset_t *other);    // target ^= other
+bool mvn_bitset_andnot(mvn_bitset_t *target, const mvn_bitset_t *other); // target &= ~other
+
+// --- Rank / Select ---
+// Both scan the words, or use the rank index when one is current, which makes rank O(1) and
+// select O(log n). Any change to the bits makes the index stale until it is rebuilt.
+
+// Builds (or rebuilds) the rank index: one count per MVN_DS_BITSET_RANK_BLOCK_BITS bits.
+// Returns false on allocation failure.
+bool mvn_bitset_build_rank_index(mvn_bitset_t *bitset);
+
+// Returns the number of set bits before index (index may equal the size).
+size_t mvn_bitset_rank(const mvn_bitset_t *bitset, size_t index);
+
+// Returns the index of the set bit with rank k (the (k+1)-th set bit), or MVN_DS_BITSET_NPOS
+// if fewer than k + 1 bits are set.
+size_t mvn_bitset_select(const mvn_bitset_t *bitset, size_t k);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BITSET_H */
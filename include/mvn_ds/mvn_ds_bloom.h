@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_BLOOM_H
+#define MVN_DS_BLOOM_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Bits per block; every key's bits fall in one block of one cache line
+#define MVN_DS_BLOOM_BLOCK_BITS 512
+// Alignment of the bit array, in bytes
+#define MVN_DS_BLOOM_ALIGNMENT 64
+// Upper bound on the bits set per key, reached for very low false-positive rates
+#define MVN_DS_BLOOM_MAX_HASHES 16
+// False-positive rate used when 0 is passed
+#define MVN_DS_BLOOM_DEFAULT_FALSE_POSITIVE_RATE 0.01
+
+// --- Bloom Filter Operations ---
+// A filter answers "definitely absent" or "maybe present". Keys cannot be removed. Up to the
+// capacity it was sized for, the false-positive rate stays within about 15% of the target.
+
+// Creates an empty filter sized for capacity keys at the given false-positive rate (0 for the
+// default, otherwise in (0, 1)). Returns NULL on allocation failure or an invalid rate.
+mvn_bloom_t *mvn_bloom_new(size_t capacity, double false_positive_rate);
+
+// Frees the filter.
+void mvn_bloom_free(mvn_bloom_t *bloom);
+
+// Adds a key given by a well-mixed 64-bit hash (e.g. from mvn_val_hash).
+void mvn_bloom_add_hash(mvn_bloom_t *bloom, uint64_t hash);
+
+// Returns false if the key with this hash was definitely never added.
+bool mvn_bloom_contains_hash(const mvn_bloom_t *bloom, uint64_t hash);
+
+// Adds a value, hashed with mvn_val_hash.
+void mvn_bloom_add(mvn_bloom_t *bloom, const mvn_val_t *value);
+
+// Returns false if the value (hashed with mvn_val_hash) was definitely never added.
+bool mvn_bloom_contains(const mvn_bloom_t *bloom, const mvn_val_t *value);
+
+// Removes every key, keeping the size.
+void mvn_bloom_clear(mvn_bloom_t *bloom);
+
+// Returns the number of keys added since creation or the last clear.
+size_t mvn_bloom_count(const mvn_bloom_t *bloom);
+
+// Returns the heap bytes owned by the filter, including its structure.
+size_t mvn_bloom_memory_usage(const mvn_bloom_t *bloom);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BLOOM_H */
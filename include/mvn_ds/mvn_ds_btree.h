@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_BTREE_H
+#define MVN_DS_BTREE_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Alignment of every B+tree node, in bytes
+#define MVN_DS_BTREE_NODE_ALIGNMENT 64
+// Minimum number of keys in a node other than the root
+#define MVN_DS_BTREE_MIN_KEYS (MVN_DS_BTREE_MAX_KEYS / 2 - 1)
+
+// --- B+Tree Operations ---
+// Keys are ordered by mvn_val_compare. Use primitives or strings as keys: arrays and maps are
+// ordered by count and address rather than by contents. Lookups and updates are O(log n).
+
+// Creates a new, empty B+tree. No nodes are allocated until the first insert.
+mvn_btree_t *mvn_btree_new(void);
+
+// Frees the B+tree, including all of its keys and values.
+void mvn_btree_free(mvn_btree_t *btree);
+
+// Builds a B+tree from keys sorted in strictly ascending order and their values, in O(n).
+// On success both arrays are consumed (their elements are moved into the tree and the arrays
+// freed). Returns NULL and leaves the arrays untouched if the keys are not strictly ascending,
+// the counts differ, or on allocation failure.
+mvn_btree_t *mvn_btree_bulk_load(mvn_arr_t *keys, mvn_arr_t *values);
+
+// Sets the value for key, taking ownership of both. If the key exists, its old value is freed
+// and the passed key is freed. Returns false on allocation failure or invalid input (key and
+// value are freed in that case too).
+bool mvn_btree_put(mvn_btree_t *btree, mvn_val_t key, mvn_val_t value);
+
+// Same as mvn_btree_put with a string key copied from key_cstr.
+bool mvn_btree_put_cstr(mvn_btree_t *btree, const char *key_cstr, mvn_val_t value);
+
+// Returns a pointer to the value for key, or NULL if it isn't present.
+mvn_val_t *mvn_btree_get(const mvn_btree_t *btree, const mvn_val_t *key);
+
+// Same as mvn_btree_get with a string key. Does not allocate.
+mvn_val_t *mvn_btree_get_cstr(const mvn_btree_t *btree, const char *key_cstr);
+
+// Removes the entry for key, freeing its key and value. Returns false if there was none.
+bool mvn_btree_remove(mvn_btree_t *btree, const mvn_val_t *key);
+
+// Same as mvn_btree_remove with a string key. Does not allocate.
+bool mvn_btree_remove_cstr(mvn_btree_t *btree, const char *key_cstr);
+
+// Returns the number of entries in the tree.
+size_t mvn_btree_count(const mvn_btree_t *btree);
+
+// --- Iteration ---
+
+// Returns an iterator over every entry in ascending key order.
+mvn_btree_iter_t mvn_btree_iter(const mvn_btree_t *btree);
+
+// Returns an iterator over the entries with low <= key < high, in ascending key order.
+// A NULL bound is unbounded. high is not copied and must outlive the iterator.
+mvn_btree_iter_t
+mvn_btree_range(const mvn_btree_t *btree, const mvn_val_t *low, const mvn_val_t *high);
+
+// Advances the iterator. Stores the entry's key and value (either pointer may be NULL) and
+// returns true, or returns false when the range is exhausted.
+bool mvn_btree_iter_next(mvn_btree_iter_t *iter, const mvn_val_t **key, mvn_val_t **value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BTREE_H */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_CARR_H
+#define MVN_DS_CARR_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// log2 of the number of slots in the first segment; segment k holds twice as many as segment k-1
+#define MVN_DS_CARR_FIRST_SEGMENT_SHIFT 6
+// Number of slots in the first segment
+#define MVN_DS_CARR_FIRST_SEGMENT_SIZE ((size_t)1 << MVN_DS_CARR_FIRST_SEGMENT_SHIFT)
+// Maximum number of segments (enough to address every size_t index)
+#define MVN_DS_CARR_MAX_SEGMENTS (sizeof(size_t) * 8 - MVN_DS_CARR_FIRST_SEGMENT_SHIFT)
+
+// Opaque concurrent append-only array of mvn_val_t.
+// Any number of threads may push at once; slots are reserved with a single fetch_add and
+// storage grows by adding segments, so existing elements never move.
+typedef struct mvn_carr_t mvn_carr_t;
+
+// --- Concurrent Array Operations ---
+
+// Creates a new, empty concurrent array. Segments are allocated on demand.
+mvn_carr_t *mvn_carr_new(void);
+
+// Creates a new concurrent array with segments preallocated for at least capacity elements,
+// so pushes below that count never allocate.
+mvn_carr_t *mvn_carr_new_capacity(size_t capacity);
+
+// Frees the array and every element written to it. No pushes may be in flight.
+void mvn_carr_free(mvn_carr_t *carr);
+
+// Appends a value, taking ownership. Safe to call from many threads concurrently.
+// Returns false (and frees value) if carr is NULL or a new segment could not be allocated.
+// The slot of a push that failed on allocation is still published and reads as null, so
+// pushes after it stay visible; mvn_carr_failed_count reports how many there were.
+bool mvn_carr_push(mvn_carr_t *carr, mvn_val_t value);
+
+// Returns the published count: every index below it is fully written and safe to read
+// concurrently with pushes. Failed pushes are included.
+size_t mvn_carr_count(const mvn_carr_t *carr);
+
+// Returns the number of pushes that failed to allocate storage (their slots read as null).
+size_t mvn_carr_failed_count(const mvn_carr_t *carr);
+
+// Returns a pointer to the element at index, or NULL if index is not yet published.
+// The pointer stays valid until the array is freed or converted.
+const mvn_val_t *mvn_carr_get(const mvn_carr_t *carr, size_t index);
+
+// Moves all published elements into a new contiguous mvn_arr_t and frees carr. Slots of
+// failed pushes become null values.
+// Call only after all writers have finished. Returns NULL if carr is NULL or on allocation
+// failure (carr is left intact in that case).
+mvn_arr_t *mvn_carr_to_arr(mvn_carr_t *carr);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_CARR_H */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_FMAP_H
+#define MVN_DS_FMAP_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Average number of keys per displacement bucket (higher is smaller but slower to build)
+#define MVN_DS_FMAP_KEYS_PER_BUCKET 4
+// Number of displacement seeds tried for one bucket before the build gives up
+#define MVN_DS_FMAP_MAX_SEED_ATTEMPTS (1 << 20)
+// Number of hash salts tried before a frozen map build gives up
+#define MVN_DS_FMAP_MAX_BUILD_ATTEMPTS 4
+
+// --- Frozen Map Operations ---
+
+// Builds a frozen map from a hash map. On success the hash map is consumed: its values are moved
+// into the frozen map and its memory is freed. On failure NULL is returned and hmap is untouched.
+// Values are moved as-is; use mvn_val_freeze to freeze nested maps as well.
+mvn_fmap_t *mvn_fmap_from_hmap(mvn_hmap_t *hmap);
+
+// Frees the frozen map, including all of its values.
+void mvn_fmap_free(mvn_fmap_t *fmap);
+
+// Creates a deep copy of the frozen map. Returns NULL on allocation failure or if fmap is NULL.
+mvn_fmap_t *mvn_fmap_copy(const mvn_fmap_t *fmap);
+
+// Returns the number of key-value pairs in the frozen map.
+size_t mvn_fmap_count(const mvn_fmap_t *fmap);
+
+// Retrieves a pointer to the value associated with a given mvn_str_t key, or NULL if absent.
+// Exactly one entry is probed. Safe to call from any number of threads without locking.
+const mvn_val_t *mvn_fmap_get(const mvn_fmap_t *fmap, const mvn_str_t *key);
+
+// Retrieves a pointer to the value associated with a given C string key, or NULL if absent.
+const mvn_val_t *mvn_fmap_get_cstr(const mvn_fmap_t *fmap, const char *key_cstr);
+
+// Returns the null-terminated key stored at slot index (0 <= index < count), or NULL.
+const char *mvn_fmap_key_at(const mvn_fmap_t *fmap, size_t index);
+
+// Returns the value stored at slot index (0 <= index < count), or NULL.
+const mvn_val_t *mvn_fmap_value_at(const mvn_fmap_t *fmap, size_t index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_FMAP_H */
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_GROUP_H
+#define MVN_DS_GROUP_H
+
+#include "mvn_ds_pool.h"  // For mvn_pool_t
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Minimum records per partition before mvn_group_by_parallel splits the work
+#define MVN_DS_GROUP_PARTITION_ROWS 4096
+
+// --- Group By Operations ---
+// Records are hash maps (or frozen maps). A key path such as "user.city" names a field of a
+// nested map; each path is parsed and its field names hashed once per call, not per record.
+// Records are grouped by the value at key_path, compared with mvn_val_equal; records where it
+// is missing form the group whose key is null.
+//
+// The result is a new array with one hash map per group, in order of each group's first
+// record. A group's record holds a copy of its key under key_path (the whole path as one field
+// name) and each aggregation's result under its output name.
+
+// Groups records by the value at key_path and computes aggregation_count aggregations for
+// each group in a single pass. Returns NULL on invalid input or allocation failure.
+mvn_arr_t *mvn_group_by(const mvn_arr_t *records,
+                        const char      *key_path,
+                        const mvn_agg_t *aggregations,
+                        size_t           aggregation_count);
+
+// Same as mvn_group_by, with the records split into contiguous partitions that are grouped on
+// the pool's threads and then merged in order, so the result is the same. Runs on the calling
+// thread if pool is NULL or there are fewer than two partitions' worth of records.
+mvn_arr_t *mvn_group_by_parallel(mvn_pool_t      *pool,
+                                 const mvn_arr_t *records,
+                                 const char      *key_path,
+                                 const mvn_agg_t *aggregations,
+                                 size_t           aggregation_count);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_GROUP_H */
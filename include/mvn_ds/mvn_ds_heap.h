@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_HEAP_H
+#define MVN_DS_HEAP_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Children per node when 0 is passed as the arity. Four children keep a node's children in one
+// cache line and halve the depth of a binary heap, at two more comparisons per level.
+#define MVN_DS_HEAP_DEFAULT_ARITY 4
+// Default initial capacity allocated by the first push into an empty heap
+#define MVN_DS_HEAP_INITIAL_CAPACITY 16
+
+// --- Heap Operations ---
+// The heap keeps the element that compares lowest on top; pass a comparator that inverts the
+// order for a max-heap. Each element gets a handle on insertion, which stays valid until the
+// element is popped or removed and may be reused by a later push.
+
+// Creates a new, empty heap. arity is the number of children per node (0 for the default,
+// otherwise at least 2). compare NULL orders by mvn_val_compare. Returns NULL on allocation
+// failure or invalid arity.
+mvn_heap_t *mvn_heap_new(size_t arity, mvn_heap_compare_fn compare, void *context);
+
+// Builds a heap from the elements of array in O(n). The element at index i gets handle i.
+// On success the array is consumed (its elements are moved into the heap and it is freed).
+// Returns NULL and leaves the array untouched on allocation failure or invalid input.
+mvn_heap_t *
+mvn_heap_from_arr(mvn_arr_t *array, size_t arity, mvn_heap_compare_fn compare, void *context);
+
+// Frees the heap, including all of its elements.
+void mvn_heap_free(mvn_heap_t *heap);
+
+// Adds value to the heap, taking ownership of it, and stores its handle in *handle (may be
+// NULL). Returns false on allocation failure or invalid input (value is freed in that case).
+bool mvn_heap_push(mvn_heap_t *heap, mvn_val_t value, size_t *handle);
+
+// Returns the top element without removing it, or NULL if the heap is empty.
+const mvn_val_t *mvn_heap_peek(const mvn_heap_t *heap);
+
+// Removes the top element and moves it into *out (ownership passes to the caller; it is freed
+// if out is NULL). Returns false if the heap is empty.
+bool mvn_heap_pop(mvn_heap_t *heap, mvn_val_t *out);
+
+// Returns the element with the given handle, or NULL if the handle is not in use.
+const mvn_val_t *mvn_heap_get(const mvn_heap_t *heap, size_t handle);
+
+// Replaces the element with the given handle, taking ownership of value and freeing the old
+// element, and moves it up or down to its new place (decrease-key or increase-key) in
+// O(log n). Returns false if the handle is not in use (value is freed in that case).
+bool mvn_heap_update(mvn_heap_t *heap, size_t handle, mvn_val_t value);
+
+// Removes the element with the given handle and moves it into *out (ownership passes to the
+// caller; it is freed if out is NULL). Returns false if the handle is not in use.
+bool mvn_heap_remove(mvn_heap_t *heap, size_t handle, mvn_val_t *out);
+
+// Returns the number of elements in the heap.
+size_t mvn_heap_count(const mvn_heap_t *heap);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_HEAP_H */
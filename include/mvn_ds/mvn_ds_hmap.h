@@ -29,6 +29,20 @@ mvn_hmap_t *mvn_hmap_new(void);
 // Creates a new, empty hash map with a specific initial capacity.
 mvn_hmap_t *mvn_hmap_new_capacity(size_t capacity);
 
+// Creates a new, empty hash map whose keys are hashed with SipHash-1-3 keyed by seed.
+// Use for keys from untrusted input: FNV-1a collisions are easy to precompute, and a flood of
+// colliding keys turns every operation into a scan of one long chain.
+mvn_hmap_t *mvn_hmap_new_seeded(size_t capacity, uint64_t seed);
+
+// Creates a new, empty seeded hash map with a random per-map seed.
+mvn_hmap_t *mvn_hmap_new_randomized(size_t capacity);
+
+// Returns the hash the map uses for key (FNV-1a, or SipHash-1-3 folded to 32 bits if seeded).
+uint32_t mvn_hmap_hash_key(const mvn_hmap_t *hmap, const mvn_str_t *key);
+
+// Checks if the hash map uses seeded (SipHash-1-3) key hashing.
+bool mvn_hmap_is_seeded(const mvn_hmap_t *hmap);
+
 // Frees the memory associated with a hash map, including all keys and values.
 void mvn_hmap_free(mvn_hmap_t *hmap);
 
@@ -44,6 +58,10 @@ mvn_val_t *mvn_hmap_get(const mvn_hmap_t *hmap, const mvn_str_t *key);
 // Retrieves a pointer to the value associated with a given C string key.
 mvn_val_t *mvn_hmap_cstr(const mvn_hmap_t *hmap, const char *key_cstr);
 
+// Same as mvn_hmap_get with the key's hash already computed; hash must equal
+// mvn_hmap_hash_key(hmap, key). Lets callers hash a key once and look it up in many maps.
+mvn_val_t *mvn_hmap_get_hashed(const mvn_hmap_t *hmap, const mvn_str_t *key, uint32_t hash);
+
 // Deletes a key-value pair from the hash map using an mvn_str_t key.
 bool mvn_hmap_delete(mvn_hmap_t *hmap, const mvn_str_t *key);
 
@@ -82,6 +100,18 @@ mvn_arr_t *mvn_hmap_values(const mvn_hmap_t *hmap);
 // Returns the number of key-value pairs in the hash map (alias for mvn_hmap_count).
 size_t mvn_hmap_size(const mvn_hmap_t *hmap);
 
+// Attaches a Bloom filter over the keys (rate 0 for the default) so that lookups and deletes
+// of absent keys usually return without touching the buckets. Worth it for miss-heavy
+// workloads; each new key costs one filter update. Replaces an attached filter.
+// Returns false on allocation failure or an invalid rate.
+bool mvn_hmap_attach_filter(mvn_hmap_t *hmap, double false_positive_rate);
+
+// Detaches and frees the Bloom filter, if any.
+void mvn_hmap_detach_filter(mvn_hmap_t *hmap);
+
+// Checks if the hash map has a Bloom filter attached.
+bool mvn_hmap_has_filter(const mvn_hmap_t *hmap);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
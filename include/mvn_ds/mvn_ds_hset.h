@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_HSET_H
+#define MVN_DS_HSET_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Default initial capacity (slots) allocated by the first insert into an empty set
+#define MVN_DS_HSET_INITIAL_CAPACITY 8
+// Maximum fraction of occupied slots; linear probing slows down quickly beyond it
+#define MVN_DS_HSET_LOAD_FACTOR 0.7
+
+// --- Hash Set Operations ---
+// Elements are hashed with mvn_val_hash and compared with mvn_val_equal, so a string, an array
+// or a map is found by its contents. F32 and F64 elements are matched by exact value: values
+// that mvn_val_equal accepts as equal within its epsilon may still be separate elements.
+
+// Creates a new, empty hash set. No slots are allocated until the first insert.
+mvn_hset_t *mvn_hset_new(void);
+
+// Creates a new, empty hash set with room for at least capacity elements without resizing.
+mvn_hset_t *mvn_hset_new_capacity(size_t capacity);
+
+// Frees the hash set, including all of its elements.
+void mvn_hset_free(mvn_hset_t *hset);
+
+// Creates a deep copy of the hash set. Returns NULL on allocation failure or if hset is NULL.
+mvn_hset_t *mvn_hset_copy(const mvn_hset_t *hset);
+
+// Adds value to the set, taking ownership of it. If an equal element is already present, the
+// set is unchanged and value is freed. Returns false on allocation failure or invalid input
+// (value is freed in that case too).
+bool mvn_hset_insert(mvn_hset_t *hset, mvn_val_t value);
+
+// Checks if the set contains an element equal to value.
+bool mvn_hset_contains(const mvn_hset_t *hset, const mvn_val_t *value);
+
+// Removes and frees the element equal to value. Returns false if there was none.
+bool mvn_hset_remove(mvn_hset_t *hset, const mvn_val_t *value);
+
+// Returns the number of elements in the set.
+size_t mvn_hset_count(const mvn_hset_t *hset);
+
+// Checks if two sets hold equal elements. Two NULL sets are equal.
+bool mvn_hset_equal(const mvn_hset_t *set_one, const mvn_hset_t *set_two);
+
+// Removes and frees all elements. The slot table is kept.
+void mvn_hset_clear(mvn_hset_t *hset);
+
+// Iterates the elements in slot order. Start with *cursor = 0; each call returns the next
+// element and advances the cursor, or returns NULL when done. The set must not be modified
+// during the iteration.
+const mvn_val_t *mvn_hset_next(const mvn_hset_t *hset, size_t *cursor);
+
+// Retrieves all elements as a new array of deep copies, in slot order.
+// Returns NULL on allocation failure or if hset is NULL.
+mvn_arr_t *mvn_hset_to_arr(const mvn_hset_t *hset);
+
+// --- Set Algebra ---
+// Each returns a new set holding deep copies of the resulting elements, or NULL on allocation
+// failure or if either set is NULL. The work is proportional to the size of the smaller set,
+// plus copying the result.
+
+// Elements in set_one, set_two or both.
+mvn_hset_t *mvn_hset_union(const mvn_hset_t *set_one, const mvn_hset_t *set_two);
+
+// Elements in both set_one and set_two.
+mvn_hset_t *mvn_hset_intersection(const mvn_hset_t *set_one, const mvn_hset_t *set_two);
+
+// Elements in set_one but not in set_two.
+mvn_hset_t *mvn_hset_difference(const mvn_hset_t *set_one, const mvn_hset_t *set_two);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_HSET_H */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_JOIN_H
+#define MVN_DS_JOIN_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Probe records whose keys are looked up together, so their table slots load in parallel
+#define MVN_DS_JOIN_BATCH_ROWS 64
+
+// --- Hash Index Operations ---
+// Records are hash maps (or frozen maps); key_path is dot-separated like in mvn_group_by.
+// Keys are compared with mvn_val_equal. Records whose key is missing or null are not indexed.
+// An index borrows its keys from the records, which must outlive it unchanged.
+
+// Builds an index from each distinct key value to the rows that hold it, in one hash pass.
+// Returns NULL on invalid input or allocation failure.
+mvn_index_t *mvn_index_build(const mvn_arr_t *records, const char *key_path);
+
+// Frees an index. Safe to call with NULL. The records are not touched.
+void mvn_index_free(mvn_index_t *index);
+
+// Returns the number of distinct keys in the index.
+size_t mvn_index_key_count(const mvn_index_t *index);
+
+// Returns the rows whose key equals key, in ascending order, and stores their number in
+// row_count. Returns NULL (and a count of 0) if no row has the key.
+const size_t *mvn_index_rows(const mvn_index_t *index, const mvn_val_t *key, size_t *row_count);
+
+// --- Hash Join Operations ---
+
+// Joins two arrays of records where the value at left_key equals the value at right_key. A
+// hash index is built on the smaller array and the other is probed in batches. Each match
+// becomes a new hash map with copies of the left record's fields, then of the right record's
+// fields whose names the left record does not have. Results follow left record order, then
+// right record order. Returns NULL on invalid input or allocation failure.
+mvn_arr_t *mvn_hash_join(const mvn_arr_t *left,
+                         const mvn_arr_t *right,
+                         const char      *left_key,
+                         const char      *right_key,
+                         mvn_join_mode_t  mode);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_JOIN_H */
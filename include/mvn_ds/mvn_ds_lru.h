@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_LRU_H
+#define MVN_DS_LRU_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Number of buckets allocated by the first put into a cache
+#define MVN_DS_LRU_INITIAL_BUCKETS 16
+// Load factor threshold (entries per bucket) that doubles the bucket array
+#define MVN_DS_LRU_LOAD_FACTOR 0.75
+
+// --- LRU Cache Operations ---
+// A put that takes the cache over its capacity evicts entries, least recently used first (or
+// in CLOCK order), until it fits again. The entry just put is never evicted by its own put.
+
+// Creates a new, empty cache. capacity is a number of entries or of bytes, depending on limit,
+// and must be greater than 0. Returns NULL on allocation failure or invalid input.
+mvn_lru_t *mvn_lru_new(size_t capacity, mvn_lru_limit_t limit, mvn_lru_policy_t policy);
+
+// Frees the cache, including all keys and values. The eviction callback is not called.
+void mvn_lru_free(mvn_lru_t *lru);
+
+// Sets the function called with each entry evicted to make room (not for removals, replaced
+// values or mvn_lru_free). NULL disables it.
+void mvn_lru_set_evict_callback(mvn_lru_t *lru, mvn_lru_evict_fn on_evict, void *context);
+
+// Stores value under key, taking ownership of both, and marks the entry as used. Replaces (and
+// frees) an existing value. With a byte capacity the entry is charged its size at this point;
+// later changes made through mvn_lru_get are not tracked until the next put.
+// Returns false on allocation failure, invalid input, or an entry larger than a byte capacity
+// (key and value are freed in that case).
+bool mvn_lru_put(mvn_lru_t *lru, mvn_str_t *key, mvn_val_t value);
+
+// Stores value under a C string key (copied).
+bool mvn_lru_put_cstr(mvn_lru_t *lru, const char *key_cstr, mvn_val_t value);
+
+// Returns the value stored under key and marks the entry as used, or NULL if it is absent.
+mvn_val_t *mvn_lru_get(mvn_lru_t *lru, const mvn_str_t *key);
+
+// Same as mvn_lru_get with a C string key; does not allocate.
+mvn_val_t *mvn_lru_get_cstr(mvn_lru_t *lru, const char *key_cstr);
+
+// Returns the value stored under key without marking the entry as used, or NULL.
+const mvn_val_t *mvn_lru_peek(const mvn_lru_t *lru, const mvn_str_t *key);
+
+// Same as mvn_lru_peek with a C string key; does not allocate.
+const mvn_val_t *mvn_lru_peek_cstr(const mvn_lru_t *lru, const char *key_cstr);
+
+// Removes and frees the entry stored under key. Returns false if it is absent.
+bool mvn_lru_remove(mvn_lru_t *lru, const mvn_str_t *key);
+
+// Same as mvn_lru_remove with a C string key; does not allocate.
+bool mvn_lru_remove_cstr(mvn_lru_t *lru, const char *key_cstr);
+
+// Returns the number of entries.
+size_t mvn_lru_count(const mvn_lru_t *lru);
+
+// Returns the bytes charged by the entries; always 0 with MVN_LRU_LIMIT_COUNT.
+size_t mvn_lru_bytes(const mvn_lru_t *lru);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_LRU_H */
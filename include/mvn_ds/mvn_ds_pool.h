@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_POOL_H
+#define MVN_DS_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// Number of grain-sized parallel_for chunks per worker when the grain is chosen automatically
+#define MVN_DS_POOL_CHUNKS_PER_WORKER 8
+// Initial number of task slots in each worker's deque (must be a power of two)
+#define MVN_DS_POOL_DEQUE_INITIAL_CAPACITY 64
+
+// Opaque work-stealing thread pool. Each worker owns a Chase-Lev deque; idle workers steal.
+typedef struct mvn_pool_t mvn_pool_t;
+
+// Opaque group of tasks that can be waited on together (fork-join).
+typedef struct mvn_pool_group_t mvn_pool_group_t;
+
+// Task body run on a pool thread.
+typedef void (*mvn_pool_task_fn)(void *context);
+
+// Range body for mvn_pool_parallel_for; processes indices in [begin, end).
+typedef void (*mvn_pool_range_fn)(size_t begin, size_t end, void *context);
+
+// --- Pool Operations ---
+
+// Creates a pool with thread_count workers. 0 selects the number of hardware threads.
+// Returns NULL on allocation or thread creation failure.
+mvn_pool_t *mvn_pool_new(size_t thread_count);
+
+// Waits for all queued tasks to finish, stops the workers and frees the pool.
+void mvn_pool_free(mvn_pool_t *pool);
+
+// Returns the number of worker threads in the pool, or 0 if pool is NULL.
+size_t mvn_pool_thread_count(const mvn_pool_t *pool);
+
+// Queues a detached task. Tasks submitted from a worker go to that worker's deque.
+// Returns false if pool or task_fn is NULL, or on allocation failure.
+bool mvn_pool_submit(mvn_pool_t *pool, mvn_pool_task_fn task_fn, void *context);
+
+// Blocks until every task submitted to the pool so far has finished.
+// The calling thread helps run tasks while it waits.
+void mvn_pool_wait_idle(mvn_pool_t *pool);
+
+// Runs body over [begin, end) split into chunks of at most grain indices, in parallel.
+// A grain of 0 picks ceil(count / (workers * MVN_DS_POOL_CHUNKS_PER_WORKER)) once per call.
+// Splitting is lazy: a half is handed off only when an idle worker could take it, so a busy
+// pool runs the range with few tasks and chunk counts adapt to the load.
+// Returns after every chunk has finished. Returns false on invalid input or allocation failure.
+bool mvn_pool_parallel_for(mvn_pool_t       *pool,
+                           size_t            begin,
+                           size_t            end,
+                           size_t            grain,
+                           mvn_pool_range_fn body,
+                           void             *context);
+
+// --- Task Group Operations ---
+
+// Creates a task group bound to pool. Returns NULL if pool is NULL or on allocation failure.
+mvn_pool_group_t *mvn_pool_group_new(mvn_pool_t *pool);
+
+// Waits for outstanding tasks in the group, then frees it.
+void mvn_pool_group_free(mvn_pool_group_t *group);
+
+// Queues a task that belongs to the group.
+// Returns false if group or task_fn is NULL, or on allocation failure.
+bool mvn_pool_group_submit(mvn_pool_group_t *group, mvn_pool_task_fn task_fn, void *context);
+
+// Blocks until every task in the group (including tasks they add to it) has finished.
+// The calling thread runs pending tasks while it waits, so nested waits do not deadlock.
+void mvn_pool_group_wait(mvn_pool_group_t *group);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_POOL_H */
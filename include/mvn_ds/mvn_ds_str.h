@@ -45,6 +45,9 @@ bool mvn_str_equal_cstr(const mvn_str_t *str1_ptr, const char *cstr2);
 // Calculates a hash value for the string (FNV-1a algorithm).
 uint32_t mvn_str_hash(const mvn_str_t *string_ptr);
 
+// Calculates a keyed hash of the string (SipHash-1-3). Resists precomputed collisions.
+uint64_t mvn_str_hash_seeded(const mvn_str_t *string_ptr, uint64_t key0, uint64_t key1);
+
 // Creates a new string by converting the given string to uppercase.
 // Returns NULL on allocation failure or if string_ptr is NULL.
 mvn_str_t *mvn_str_to_uppercase(const mvn_str_t *string_ptr);
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_TABLE_H
+#define MVN_DS_TABLE_H
+
+#include "mvn_ds_types.h" // Include the structure definitions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// --- Table Operations ---
+// A table is built once from an array of hash map records and is not modified afterwards. Each
+// field gets one column whose storage depends on the values found: booleans, integers and
+// floats are packed into arrays (integers widened to 64 bits, f32 to f64), strings are
+// dictionary-encoded as 32-bit codes, and fields with mixed or nested values keep copies of the
+// values. Scanning a column's array needs no hashing and reads only that field's bytes.
+
+// Builds a table from an array of MVN_VAL_HASHMAP records. The records are copied, not taken.
+// A field that is missing from a record, or null in it, is a null row of its column.
+// Returns NULL on allocation failure or if an element is not a hash map.
+mvn_table_t *mvn_table_from_rows(const mvn_arr_t *rows);
+
+// Frees the table and all of its columns.
+void mvn_table_free(mvn_table_t *table);
+
+// Converts the table back to an array of hash map records. Null rows of a column are left out
+// of the records, and values come back in their column's type (for example i32 as i64).
+// Returns NULL on allocation failure.
+mvn_arr_t *mvn_table_to_rows(const mvn_table_t *table);
+
+// Returns the number of rows in the table.
+size_t mvn_table_row_count(const mvn_table_t *table);
+
+// Returns the number of columns in the table.
+size_t mvn_table_column_count(const mvn_table_t *table);
+
+// Returns the column at index (columns are sorted by name), or NULL if out of bounds.
+const mvn_table_col_t *mvn_table_column(const mvn_table_t *table, size_t index);
+
+// Returns the column for a field name, or NULL if no record had that field.
+const mvn_table_col_t *mvn_table_column_cstr(const mvn_table_t *table, const char *name_cstr);
+
+// Returns a new value holding a column's row (MVN_VAL_NULL for a null row). The caller owns it.
+mvn_val_t mvn_table_cell(const mvn_table_col_t *column, size_t row);
+
+// Returns the bytes held by the table, its columns and their dictionaries and values.
+size_t mvn_table_memory_usage(const mvn_table_t *table);
+
+// --- Column Scans ---
+
+// Returns the sum of a numeric or boolean column's valid rows (counting true as 1). Integer
+// columns are summed in 64-bit integers, which wrap on overflow. Returns 0 for other columns.
+double mvn_table_sum(const mvn_table_col_t *column);
+
+// Returns the number of rows of a string column equal to value_cstr. The string is looked up
+// in the dictionary once; the rows are then compared as codes.
+size_t mvn_table_count_cstr(const mvn_table_col_t *column, const char *value_cstr);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_TABLE_H */
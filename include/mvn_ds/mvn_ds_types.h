@@ -14,6 +14,28 @@ typedef struct mvn_str_t        mvn_str_t;
 typedef struct mvn_arr_t        mvn_arr_t;
 typedef struct mvn_hmap_entry_t mvn_hmap_entry_t;
 typedef struct mvn_hmap_t       mvn_hmap_t;
+typedef struct mvn_fmap_entry_t mvn_fmap_entry_t;
+typedef struct mvn_fmap_t       mvn_fmap_t;
+typedef struct mvn_hset_slot_t  mvn_hset_slot_t;
+typedef struct mvn_hset_t       mvn_hset_t;
+typedef struct mvn_bitset_t     mvn_bitset_t;
+typedef struct mvn_bloom_t      mvn_bloom_t;
+typedef struct mvn_btree_node_t mvn_btree_node_t;
+typedef struct mvn_btree_t      mvn_btree_t;
+typedef struct mvn_btree_iter_t mvn_btree_iter_t;
+typedef struct mvn_heap_entry_t mvn_heap_entry_t;
+typedef struct mvn_heap_t       mvn_heap_t;
+typedef struct mvn_lru_entry_t  mvn_lru_entry_t;
+typedef struct mvn_lru_t        mvn_lru_t;
+typedef struct mvn_art_node_t   mvn_art_node_t;
+typedef struct mvn_art_leaf_t   mvn_art_leaf_t;
+typedef struct mvn_art_t        mvn_art_t;
+typedef struct mvn_art_iter_t   mvn_art_iter_t;
+typedef struct mvn_table_col_t  mvn_table_col_t;
+typedef struct mvn_table_t      mvn_table_t;
+typedef struct mvn_agg_t        mvn_agg_t;
+typedef struct mvn_index_slot_t mvn_index_slot_t;
+typedef struct mvn_index_t      mvn_index_t;
 typedef struct mvn_val_t        mvn_val_t;
 
 // --- Type Enum ---
@@ -21,23 +43,26 @@ typedef struct mvn_val_t        mvn_val_t;
  * @brief Enumeration of possible types stored in mvn_val_t.
  */
 typedef enum {
-    MVN_VAL_NULL,   /**< Represents a null value. */
-    MVN_VAL_BOOL,   /**< Represents a boolean value (true/false). */
-    MVN_VAL_I8,     /**< Represents an 8-bit signed integer. */
-    MVN_VAL_I16,    /**< Represents a 16-bit signed integer. */
-    MVN_VAL_I32,    /**< Represents a 32-bit signed integer. */
-    MVN_VAL_I64,    /**< Represents a 64-bit signed integer. */
-    MVN_VAL_U8,     /**< Represents an 8-bit unsigned integer. */
-    MVN_VAL_U16,    /**< Represents a 16-bit unsigned integer. */
-    MVN_VAL_U32,    /**< Represents a 32-bit unsigned integer. */
-    MVN_VAL_U64,    /**< Represents a 64-bit unsigned integer. */
-    MVN_VAL_F32,    /**< Represents a 32-bit floating-point number. */
-    MVN_VAL_F64,    /**< Represents a 64-bit floating-point number (double). */
-    MVN_VAL_CHAR,   /**< Represents a single character. */
-    MVN_VAL_PTR,    /**< Represents a generic void pointer. */
-    MVN_VAL_STRING, /**< Represents an owned dynamic string (mvn_str_t*). */
-    MVN_VAL_ARRAY,  /**< Represents an owned dynamic array (mvn_arr_t*). */
-    MVN_VAL_HASHMAP /**< Represents an owned dynamic hash map (mvn_hmap_t*). */
+    MVN_VAL_NULL,       /**< Represents a null value. */
+    MVN_VAL_BOOL,       /**< Represents a boolean value (true/false). */
+    MVN_VAL_I8,         /**< Represents an 8-bit signed integer. */
+    MVN_VAL_I16,        /**< Represents a 16-bit signed integer. */
+    MVN_VAL_I32,        /**< Represents a 32-bit signed integer. */
+    MVN_VAL_I64,        /**< Represents a 64-bit signed integer. */
+    MVN_VAL_U8,         /**< Represents an 8-bit unsigned integer. */
+    MVN_VAL_U16,        /**< Represents a 16-bit unsigned integer. */
+    MVN_VAL_U32,        /**< Represents a 32-bit unsigned integer. */
+    MVN_VAL_U64,        /**< Represents a 64-bit unsigned integer. */
+    MVN_VAL_F32,        /**< Represents a 32-bit floating-point number. */
+    MVN_VAL_F64,        /**< Represents a 64-bit floating-point number (double). */
+    MVN_VAL_CHAR,       /**< Represents a single character. */
+    MVN_VAL_PTR,        /**< Represents a generic void pointer. */
+    MVN_VAL_STRING,     /**< Represents an owned dynamic string (mvn_str_t*). */
+    MVN_VAL_ARRAY,      /**< Represents an owned dynamic array (mvn_arr_t*). */
+    MVN_VAL_HASHMAP,    /**< Represents an owned dynamic hash map (mvn_hmap_t*). */
+    MVN_VAL_FROZEN_MAP, /**< Represents an owned immutable, perfectly-hashed map (mvn_fmap_t*). */
+    MVN_VAL_HASHSET,    /**< Represents an owned hash set of values (mvn_hset_t*). */
+    MVN_VAL_BITSET      /**< Represents an owned packed array of bits (mvn_bitset_t*). */
 } mvn_val_type_t;
 
 // --- Dynamic String ---
@@ -55,27 +80,31 @@ struct mvn_str_t {
 // or use it in arrays (like mvn_arr_t).
 /**
  * @brief A tagged union structure capable of holding various data types.
- * Owns the memory for MVN_VAL_STRING, MVN_VAL_ARRAY, and MVN_VAL_HASHMAP types.
+ * Owns the memory for MVN_VAL_STRING, MVN_VAL_ARRAY, MVN_VAL_HASHMAP, MVN_VAL_FROZEN_MAP,
+ * MVN_VAL_HASHSET and MVN_VAL_BITSET types.
  */
 struct mvn_val_t {
-    mvn_val_type_t type;  /**< The type of data currently held by the union. */
-    union {               // Anonymous union
-        bool        b;    /**< Value if type is MVN_VAL_BOOL. */
-        int8_t      i8;   /**< Value if type is MVN_VAL_I8. */
-        int16_t     i16;  /**< Value if type is MVN_VAL_I16. */
-        int32_t     i32;  /**< Value if type is MVN_VAL_I32. */
-        int64_t     i64;  /**< Value if type is MVN_VAL_I64. */
-        uint8_t     u8;   /**< Value if type is MVN_VAL_U8. */
-        uint16_t    u16;  /**< Value if type is MVN_VAL_U16. */
-        uint32_t    u32;  /**< Value if type is MVN_VAL_U32. */
-        uint64_t    u64;  /**< Value if type is MVN_VAL_U64. */
-        float       f32;  /**< Value if type is MVN_VAL_F32. */
-        double      f64;  /**< Value if type is MVN_VAL_F64. */
-        char        c;    /**< Value if type is MVN_VAL_CHAR. */
-        void       *ptr;  /**< Value if type is MVN_VAL_PTR. */
-        mvn_str_t  *str;  /**< Pointer to owned string if type is MVN_VAL_STRING. */
-        mvn_arr_t  *arr;  /**< Pointer to owned array if type is MVN_VAL_ARRAY. */
-        mvn_hmap_t *hmap; /**< Pointer to owned hash map if type is MVN_VAL_HASHMAP. */
+    mvn_val_type_t type;    /**< The type of data currently held by the union. */
+    union {                 // Anonymous union
+        bool          b;    /**< Value if type is MVN_VAL_BOOL. */
+        int8_t        i8;   /**< Value if type is MVN_VAL_I8. */
+        int16_t       i16;  /**< Value if type is MVN_VAL_I16. */
+        int32_t       i32;  /**< Value if type is MVN_VAL_I32. */
+        int64_t       i64;  /**< Value if type is MVN_VAL_I64. */
+        uint8_t       u8;   /**< Value if type is MVN_VAL_U8. */
+        uint16_t      u16;  /**< Value if type is MVN_VAL_U16. */
+        uint32_t      u32;  /**< Value if type is MVN_VAL_U32. */
+        uint64_t      u64;  /**< Value if type is MVN_VAL_U64. */
+        float         f32;  /**< Value if type is MVN_VAL_F32. */
+        double        f64;  /**< Value if type is MVN_VAL_F64. */
+        char          c;    /**< Value if type is MVN_VAL_CHAR. */
+        void         *ptr;  /**< Value if type is MVN_VAL_PTR. */
+        mvn_str_t    *str;  /**< Pointer to owned string if type is MVN_VAL_STRING. */
+        mvn_arr_t    *arr;  /**< Pointer to owned array if type is MVN_VAL_ARRAY. */
+        mvn_hmap_t   *hmap; /**< Pointer to owned hash map if type is MVN_VAL_HASHMAP. */
+        mvn_fmap_t   *fmap; /**< Pointer to owned frozen map if type is MVN_VAL_FROZEN_MAP. */
+        mvn_hset_t   *hset; /**< Pointer to owned hash set if type is MVN_VAL_HASHSET. */
+        mvn_bitset_t *bits; /**< Pointer to owned bitset if type is MVN_VAL_BITSET. */
     };
 };
 
@@ -112,6 +141,393 @@ struct mvn_hmap_t {
     size_t             count;    /**< Number of key-value pairs currently in the map. */
     size_t             capacity; /**< Number of buckets allocated. */
     mvn_hmap_entry_t **buckets;  /**< Pointer to the array of bucket pointers. */
+    uint64_t           seed;     /**< SipHash key seed; only used if seeded is true. */
+    bool               seeded;   /**< Keys are hashed with SipHash-1-3 instead of FNV-1a. */
+    mvn_bloom_t       *filter;   /**< Optional filter over the key hashes; NULL if none. */
 };
 
+// --- Frozen Map Entry ---
+/**
+ * @brief A key-value entry stored contiguously in a frozen map.
+ */
+struct mvn_fmap_entry_t {
+    size_t    key_offset; /**< Offset of the key's first byte in mvn_fmap_t::key_data. */
+    size_t    key_length; /**< Length of the key (excluding null terminator). */
+    uint64_t  hash;       /**< 64-bit hash of the key, checked before the key bytes. */
+    mvn_val_t value;      /**< Owned value for the entry. */
+};
+
+// --- Frozen Map ---
+/**
+ * @brief Structure representing an immutable string-key map built from a mvn_hmap_t.
+ * A minimal perfect hash (hash-and-displace) maps every key to exactly one entry slot, so a
+ * lookup reads one displacement and one entry. Never modified after construction, so it can be
+ * read from many threads without locks.
+ */
+struct mvn_fmap_t {
+    size_t            count;         /**< Number of entries (and slots). */
+    size_t            bucket_count;  /**< Number of displacement buckets. */
+    uint64_t          salt;          /**< Mixed into key hashes; 0 unless a build was retried. */
+    int32_t          *displacements; /**< Per-bucket seed (>= 0) or direct slot (-(slot + 1)). */
+    mvn_fmap_entry_t *entries;       /**< Entries indexed by their perfect hash slot. */
+    char             *key_data;      /**< All keys, null-terminated, stored back to back. */
+};
+
+// --- Hash Set Slot ---
+/**
+ * @brief One slot of a hash set's open-addressing table.
+ */
+struct mvn_hset_slot_t {
+    uint64_t  hash;  /**< mvn_val_hash of the element, never 0; 0 marks an empty slot. */
+    mvn_val_t value; /**< Owned element; MVN_VAL_NULL while the slot is empty. */
+};
+
+// --- Hash Set ---
+/**
+ * @brief Structure representing a set of mvn_val_t elements, hashed structurally with
+ * mvn_val_hash and compared with mvn_val_equal. Uses open addressing with linear probing;
+ * removal shifts the following run back, so there are no tombstones.
+ */
+struct mvn_hset_t {
+    size_t           count;    /**< Number of elements in the set. */
+    size_t           capacity; /**< Number of slots, a power of two (0 before the first insert). */
+    mvn_hset_slot_t *slots;    /**< Slot table, NULL while capacity is 0. */
+};
+
+// --- Bitset ---
+/**
+ * @brief Structure representing a fixed-size array of bits packed into 64-bit words. Bit i is
+ * bit i % 64 of word i / 64. Bits past size in the last word are always zero.
+ */
+struct mvn_bitset_t {
+    size_t    size;        /**< Number of bits. */
+    uint64_t *words;       /**< (size + 63) / 64 words, NULL while size is 0. */
+    size_t   *rank_blocks; /**< Set bits before each 512-bit block, or NULL. */
+    bool      rank_valid;  /**< Whether rank_blocks matches words. */
+};
+
+// --- Bloom Filter ---
+/**
+ * @brief Structure representing a blocked Bloom filter. A key hashes to one 512-bit block (a
+ * cache line) and sets hash_count bits inside it, so a query reads a single cache line.
+ */
+struct mvn_bloom_t {
+    uint64_t *words;               /**< block_count * 8 words, aligned to 64 bytes. */
+    void     *allocation;          /**< Allocation holding words, before alignment. */
+    size_t    block_count;         /**< Number of 512-bit blocks, at least 1. */
+    size_t    count;               /**< Number of keys added. */
+    size_t    capacity;            /**< Number of keys the filter was sized for. */
+    double    false_positive_rate; /**< Target false-positive rate at capacity keys. */
+    uint32_t  hash_count;          /**< Bits set per key. */
+};
+
+// --- B+Tree Node ---
+// Maximum number of keys per B+tree node. 32 keys of 16 bytes fill eight 64-byte cache lines.
+#define MVN_DS_BTREE_MAX_KEYS 32
+
+/**
+ * @brief One node of a B+tree, allocated on a 64-byte boundary. The keys come first so a
+ * binary search starts on a cache line. Leaves own their keys and values and are linked in key
+ * order; inner nodes own copies of their separator keys.
+ */
+struct mvn_btree_node_t {
+    mvn_val_t keys[MVN_DS_BTREE_MAX_KEYS]; /**< Sorted keys; separators in inner nodes. */
+    union {
+        mvn_val_t         values[MVN_DS_BTREE_MAX_KEYS];       /**< Leaf values. */
+        mvn_btree_node_t *children[MVN_DS_BTREE_MAX_KEYS + 1]; /**< Inner node children. */
+    };
+    mvn_btree_node_t *next;       /**< Next leaf in key order, NULL for the last leaf. */
+    void             *allocation; /**< Unaligned block returned by MVN_DS_MALLOC. */
+    uint32_t          count;      /**< Number of keys in the node. */
+    bool              leaf;       /**< Whether the node is a leaf. */
+};
+
+// --- B+Tree ---
+/**
+ * @brief Structure representing an ordered map from mvn_val_t keys, ordered by
+ * mvn_val_compare, to mvn_val_t values. All entries live in the leaves.
+ */
+struct mvn_btree_t {
+    size_t            count;  /**< Number of entries in the tree. */
+    size_t            height; /**< Number of levels, 0 while the tree is empty. */
+    mvn_btree_node_t *root;   /**< Root node, NULL while the tree is empty. */
+    mvn_btree_node_t *first;  /**< Leftmost leaf, NULL while the tree is empty. */
+};
+
+// --- B+Tree Iterator ---
+/**
+ * @brief Forward cursor over a key range of a B+tree. The tree must not be modified while
+ * the iterator is in use.
+ */
+struct mvn_btree_iter_t {
+    const mvn_btree_node_t *leaf;  /**< Leaf holding the next entry, NULL when done. */
+    size_t                  index; /**< Index of the next entry within the leaf. */
+    const mvn_val_t        *high;  /**< Exclusive upper bound, NULL for none. Not owned. */
+};
+
+// --- Heap Entry ---
+/**
+ * @brief One element of a heap together with the handle it was given on insertion.
+ */
+struct mvn_heap_entry_t {
+    mvn_val_t value;  /**< Owned element; MVN_VAL_NULL in slots past the heap's count. */
+    size_t    handle; /**< Handle of the element, stable while it is in the heap. */
+};
+
+// Ordering of a heap: returns <0 if a must leave the heap before b, 0 if either may go first
+typedef int (*mvn_heap_compare_fn)(const mvn_val_t *a, const mvn_val_t *b, void *context);
+
+// --- Heap ---
+/**
+ * @brief Structure representing a d-ary heap (priority queue) of mvn_val_t elements.
+ * Slots [0, count) of entries are in heap order; the slots after them hold the handles not in
+ * use, so entries and positions are always inverse permutations of [0, capacity).
+ */
+struct mvn_heap_t {
+    size_t              count;     /**< Number of elements in the heap. */
+    size_t              capacity;  /**< Number of allocated slots (and handles). */
+    size_t              arity;     /**< Children per node, at least 2. */
+    mvn_heap_entry_t   *entries;   /**< Element slots, NULL while capacity is 0. */
+    size_t             *positions; /**< Slot index of every handle. */
+    mvn_heap_compare_fn compare;   /**< Element order; the first element is the minimum. */
+    void               *context;   /**< Passed to compare. Not owned. */
+};
+
+// --- LRU Cache Entry ---
+/**
+ * @brief One cached key-value pair. It is linked into a hash bucket chain and into the cache's
+ * circular recency list, so a lookup and the recency update need no extra allocation.
+ */
+struct mvn_lru_entry_t {
+    mvn_str_t       *key;        /**< Owned key. */
+    uint32_t         hash;       /**< Pre-calculated hash of the key. */
+    bool             referenced; /**< CLOCK reference bit, set on hits. */
+    mvn_val_t        value;      /**< Owned value. */
+    size_t           bytes;      /**< Size charged against a byte capacity when stored. */
+    mvn_lru_entry_t *chain;      /**< Next entry in the same bucket. */
+    mvn_lru_entry_t *prev;       /**< Previous entry in the recency list. */
+    mvn_lru_entry_t *next;       /**< Next entry in the recency list. */
+};
+
+// What the capacity of a cache limits
+typedef enum {
+    MVN_LRU_LIMIT_COUNT, /**< Number of entries. */
+    MVN_LRU_LIMIT_BYTES  /**< Bytes charged by the entries (mvn_val_memory_usage and key). */
+} mvn_lru_limit_t;
+
+// How a cache picks the entry to evict
+typedef enum {
+    MVN_LRU_POLICY_LRU,  /**< Least recently used; every hit moves the entry to the front. */
+    MVN_LRU_POLICY_CLOCK /**< CLOCK (second chance); a hit only sets the reference bit. */
+} mvn_lru_policy_t;
+
+// Called before an evicted entry is freed; may move the value out (leaving MVN_VAL_NULL)
+typedef void (*mvn_lru_evict_fn)(const mvn_str_t *key, mvn_val_t *value, void *context);
+
+// --- LRU Cache ---
+/**
+ * @brief Structure representing a bounded cache with string keys and mvn_val_t values.
+ * Entries sit in a circular doubly linked list. With MVN_LRU_POLICY_LRU, head is the most
+ * recently used entry and head->prev the next victim. With MVN_LRU_POLICY_CLOCK, head is the
+ * clock hand and new entries are inserted just behind it.
+ */
+struct mvn_lru_t {
+    size_t            count;        /**< Number of entries. */
+    size_t            bytes;        /**< Sum of the bytes charged by the entries. */
+    size_t            capacity;     /**< Maximum count or bytes, depending on limit. */
+    mvn_lru_limit_t   limit;        /**< What capacity limits. */
+    mvn_lru_policy_t  policy;       /**< Eviction policy. */
+    size_t            bucket_count; /**< Number of buckets, a power of two (0 until first put). */
+    mvn_lru_entry_t **buckets;      /**< Bucket chain heads. */
+    mvn_lru_entry_t  *head;         /**< Most recently used entry or clock hand; NULL if empty. */
+    mvn_lru_evict_fn  on_evict;     /**< Eviction callback, or NULL. */
+    void             *context;      /**< Passed to on_evict. Not owned. */
+};
+
+// --- Adaptive Radix Tree Node ---
+// Compressed path bytes stored in a node; longer paths are completed from a leaf's key
+#define MVN_DS_ART_MAX_PREFIX 9
+
+// Kind of an adaptive radix tree node, stored in its first byte
+typedef enum {
+    MVN_ART_LEAF,    /**< mvn_art_leaf_t: one key and its value. */
+    MVN_ART_NODE4,   /**< mvn_art_node4_t: up to 4 children, keys sorted. */
+    MVN_ART_NODE16,  /**< mvn_art_node16_t: up to 16 children, keys sorted. */
+    MVN_ART_NODE48,  /**< mvn_art_node48_t: up to 48 children behind a 256-byte index. */
+    MVN_ART_NODE256  /**< mvn_art_node256_t: one child slot per byte value. */
+} mvn_art_node_type_t;
+
+/**
+ * @brief Header shared by the inner nodes of an adaptive radix tree. Child pointers are typed
+ * mvn_art_node_t but may point to a leaf; the first byte tells them apart. A node consumes
+ * prefix_length bytes of compressed path and then one byte to pick a child. The key that ends
+ * exactly at the node, if any, is kept in leaf.
+ */
+struct mvn_art_node_t {
+    uint8_t         type;                          /**< An mvn_art_node_type_t. */
+    uint8_t         prefix[MVN_DS_ART_MAX_PREFIX]; /**< First bytes of the compressed path. */
+    uint16_t        count;                         /**< Number of children. */
+    uint32_t        prefix_length;                 /**< Full length of the compressed path. */
+    mvn_art_leaf_t *leaf;                          /**< Key ending at this node, or NULL. */
+};
+
+/**
+ * @brief Leaf of an adaptive radix tree. The key bytes follow the structure in the same
+ * allocation.
+ */
+struct mvn_art_leaf_t {
+    uint8_t   type;       /**< Always MVN_ART_LEAF. */
+    size_t    key_length; /**< Length of the key in bytes. */
+    char     *key;        /**< Null-terminated key, stored right after the leaf. */
+    mvn_val_t value;      /**< Owned value. */
+};
+
+// Node with up to 4 children; 64 bytes, one cache line
+typedef struct mvn_art_node4_t {
+    mvn_art_node_t  header;      /**< Common header. */
+    uint8_t         keys[4];     /**< Child key bytes, ascending. */
+    mvn_art_node_t *children[4]; /**< Children, in key order. */
+} mvn_art_node4_t;
+
+// Node with up to 16 children, searched with one SSE2 compare where available
+typedef struct mvn_art_node16_t {
+    mvn_art_node_t  header;       /**< Common header. */
+    uint8_t         keys[16];     /**< Child key bytes, ascending. */
+    mvn_art_node_t *children[16]; /**< Children, in key order. */
+} mvn_art_node16_t;
+
+// Node with up to 48 children
+typedef struct mvn_art_node48_t {
+    mvn_art_node_t  header;       /**< Common header. */
+    uint8_t         index[256];   /**< 1 + slot of the child for each byte, 0 if none. */
+    mvn_art_node_t *children[48]; /**< Children in any order; free slots are NULL. */
+} mvn_art_node48_t;
+
+// Node with a child slot for every byte value
+typedef struct mvn_art_node256_t {
+    mvn_art_node_t  header;        /**< Common header. */
+    mvn_art_node_t *children[256]; /**< Child for each byte, NULL if none. */
+} mvn_art_node256_t;
+
+// --- Adaptive Radix Tree ---
+/**
+ * @brief Structure representing a map from string keys to mvn_val_t values, ordered by the
+ * key bytes (shorter keys first on a tie). Lookups cost O(key length), independent of count.
+ */
+struct mvn_art_t {
+    size_t          count; /**< Number of keys. */
+    mvn_art_node_t *root;  /**< Root node or leaf, NULL while the tree is empty. */
+};
+
+// --- Adaptive Radix Tree Iterator ---
+/**
+ * @brief Forward cursor over the keys of an adaptive radix tree, optionally limited to the
+ * keys with a given prefix. The tree must not be modified while the iterator is in use.
+ */
+struct mvn_art_iter_t {
+    const mvn_art_t      *art;           /**< Tree being iterated. */
+    const mvn_art_leaf_t *next;          /**< Leaf to return next, NULL when done. */
+    const char           *prefix;        /**< Required key prefix, NULL for none. Not owned. */
+    size_t                prefix_length; /**< Length of prefix. */
+};
+
+// --- Table Column ---
+// Dictionary code stored for rows whose string is null or missing
+#define MVN_DS_TABLE_NULL_CODE UINT32_MAX
+
+// Storage of a table column, chosen from the values found in the rows
+typedef enum {
+    MVN_TABLE_NULL,   /**< Every row is null; no data is stored. */
+    MVN_TABLE_BOOL,   /**< bools: one byte per row, 0 or 1. */
+    MVN_TABLE_I64,    /**< i64: signed integers, and unsigned ones that fit. */
+    MVN_TABLE_U64,    /**< u64: unsigned integers, some above INT64_MAX. */
+    MVN_TABLE_F64,    /**< f64: f32 and f64 values. */
+    MVN_TABLE_STRING, /**< codes: index of the row's string in dictionary. */
+    MVN_TABLE_VALUE   /**< values: owned copies, for mixed or nested values. */
+} mvn_table_type_t;
+
+/**
+ * @brief One column of a table: a field's values for every row, stored contiguously. Rows
+ * whose value is null or missing have their valid bit clear and hold 0 (or
+ * MVN_DS_TABLE_NULL_CODE, or MVN_VAL_NULL), so sums can skip the validity bitmap.
+ */
+struct mvn_table_col_t {
+    mvn_str_t       *name;  /**< Owned field name. */
+    mvn_table_type_t type;  /**< Which member of the union below is used. */
+    mvn_bitset_t    *valid; /**< Bit per row, set where the row has a non-null value. */
+    union {
+        void      *data;   /**< Row storage, NULL for MVN_TABLE_NULL columns. */
+        uint8_t   *bools;  /**< MVN_TABLE_BOOL rows. */
+        int64_t   *i64;    /**< MVN_TABLE_I64 rows. */
+        uint64_t  *u64;    /**< MVN_TABLE_U64 rows. */
+        double    *f64;    /**< MVN_TABLE_F64 rows. */
+        uint32_t  *codes;  /**< MVN_TABLE_STRING rows. */
+        mvn_val_t *values; /**< MVN_TABLE_VALUE rows. */
+    };
+    mvn_arr_t       *dictionary; /**< Distinct strings, first seen first (MVN_TABLE_STRING). */
+};
+
+// --- Table ---
+/**
+ * @brief Structure representing an array of records stored column by column: every field
+ * found in the records becomes one typed column, so a scan of one field reads one array.
+ */
+struct mvn_table_t {
+    size_t           row_count;    /**< Number of rows. */
+    size_t           column_count; /**< Number of columns. */
+    mvn_table_col_t *columns;      /**< Columns sorted by name. */
+};
+
+// --- Group By Aggregation ---
+// Result computed for each group by mvn_group_by. Missing and null values are skipped.
+typedef enum {
+    MVN_AGG_COUNT,  /**< u64: records in the group, or values found if path is set. */
+    MVN_AGG_SUM,    /**< i64 sum of the numeric values, or f64 if any is a float. */
+    MVN_AGG_MIN,    /**< Copy of the smallest value by mvn_val_compare; null if none. */
+    MVN_AGG_MAX,    /**< Copy of the largest value by mvn_val_compare; null if none. */
+    MVN_AGG_AVG,    /**< f64 mean of the numeric values; null if there are none. */
+    MVN_AGG_COLLECT /**< Array of copies of the values, in record order. */
+} mvn_agg_kind_t;
+
+/**
+ * @brief One aggregation requested from mvn_group_by.
+ */
+struct mvn_agg_t {
+    mvn_agg_kind_t kind;   /**< What to compute. */
+    const char    *path;   /**< Dot-separated key path of the input field; NULL for COUNT. */
+    const char    *output; /**< Field name of the result in each group record. */
+};
+
+// --- Hash Index Slot ---
+/**
+ * @brief One slot of a hash index's open-addressing table.
+ */
+struct mvn_index_slot_t {
+    uint64_t hash; /**< mvn_val_hash of the slot's key. */
+    size_t   key;  /**< Index of the key in mvn_index_t::keys plus 1; 0 marks an empty slot. */
+};
+
+// --- Hash Index ---
+/**
+ * @brief Structure mapping each distinct key value of an array of records to the rows that
+ * hold it. Rows are stored grouped by key (compressed sparse rows), so the rows of one key are
+ * one contiguous run. Keys are borrowed from the indexed records.
+ */
+struct mvn_index_t {
+    size_t            key_count;  /**< Number of distinct keys. */
+    size_t            row_count;  /**< Number of rows indexed, i.e. that have a key. */
+    size_t            slot_count; /**< Number of slots, a power of two; keys fill at most half. */
+    mvn_index_slot_t *slots;      /**< Open-addressing table with linear probing. */
+    const mvn_val_t **keys;       /**< Keys in order of their first row. */
+    size_t           *offsets;    /**< key_count + 1 offsets into rows; the runs of the keys. */
+    size_t           *rows;       /**< Row numbers, ascending within each key's run. */
+};
+
+// --- Join Mode ---
+// Which left records mvn_hash_join keeps.
+typedef enum {
+    MVN_JOIN_INNER, /**< Only left records with at least one matching right record. */
+    MVN_JOIN_LEFT   /**< Every left record; those without a match appear once, alone. */
+} mvn_join_mode_t;
+
 #endif /* MVN_DS_TYPES_H */
@@ -5,6 +5,8 @@
 #ifndef MVN_DS_UTILS_H
 #define MVN_DS_UTILS_H
 
+#include "mvn_ds_alloc.h" // For the allocation statistics hooks
+
 #include <stdio.h>  // For fprintf, stderr
 #include <stdlib.h> // For malloc, calloc, realloc, free, size_t
 #include <string.h> // For memcpy, memmove
@@ -13,6 +15,22 @@
 extern "C" {
 #endif /* __cplusplus */
 
+// Container type charged by the allocation macros; library sources define it before any include
+#ifndef MVN_DS_ALLOC_KIND
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_OTHER
+#endif
+
+// Route allocations through the statistics layer unless a custom allocator was supplied
+#if defined(MVN_DS_ALLOC_STATS) && !defined(MVN_DS_MALLOC) && !defined(MVN_DS_CALLOC) && \
+    !defined(MVN_DS_REALLOC) && !defined(MVN_DS_FREE)
+#define MVN_DS_MALLOC(sz) mvn_ds_alloc_stats_malloc(sz, MVN_DS_ALLOC_KIND, __FILE__, __LINE__)
+#define MVN_DS_CALLOC(n, sz) \
+    mvn_ds_alloc_stats_calloc(n, sz, MVN_DS_ALLOC_KIND, __FILE__, __LINE__)
+#define MVN_DS_REALLOC(ptr, sz) \
+    mvn_ds_alloc_stats_realloc(ptr, sz, MVN_DS_ALLOC_KIND, __FILE__, __LINE__)
+#define MVN_DS_FREE(ptr) mvn_ds_alloc_stats_free(ptr)
+#endif
+
 // Allow custom memory allocators
 #ifndef MVN_DS_MALLOC
 #define MVN_DS_MALLOC(sz) malloc(sz)
@@ -1,12 +1,19 @@
 /*
  * Copyright (c) 2024 Jake Larson
  */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_VAL // Allocation statistics category
+
 #include "mvn_ds/mvn_ds.h"
 
 #include "mvn_ds/mvn_ds_arr.h"
+#include "mvn_ds/mvn_ds_bitset.h"
+#include "mvn_ds/mvn_ds_bloom.h"
+#include "mvn_ds/mvn_ds_fmap.h"
 #include "mvn_ds/mvn_ds_hmap.h"
+#include "mvn_ds/mvn_ds_hset.h"
 #include "mvn_ds/mvn_ds_str.h"
 #include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_FREE
+#include "mvn_ds_trace.h"        // For deep copy tracepoints
 
 #include <ctype.h>    // For isprint
 #include <inttypes.h> // For PRId64, PRIu32, PRIu64
@@ -22,6 +29,14 @@
 #define MVN_DS_FLOAT_EPSILON  1e-6f
 #define MVN_DS_DOUBLE_EPSILON 1e-14
 
+// FNV-1a 64-bit constants, used by mvn_val_hash for string bytes and to combine array elements
+#define MVN_DS_VAL_FNV_OFFSET_BASIS 14695981039346656037ULL
+#define MVN_DS_VAL_FNV_PRIME        1099511628211ULL
+// Odd constant that makes a map entry's hash depend on which side is the key (2^64 / phi)
+#define MVN_DS_VAL_HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+// Bitsets up to this size are printed bit by bit, larger ones as their size and count
+#define MVN_DS_VAL_PRINT_MAX_BITS 128
+
 // --- Value Implementation ---
 
 /**
@@ -283,10 +298,78 @@ mvn_val_t mvn_val_hmap_take(mvn_hmap_t *hmap)
     return (mvn_val_t){.type = MVN_VAL_HASHMAP, .hmap = hmap};
 }
 
+/**
+ * @brief Creates a frozen map value by taking ownership of an existing mvn_fmap_t.
+ * @param fmap The mvn_fmap_t to take ownership of. If NULL, creates a NULL value.
+ * @return A mvn_val_t representing the frozen map.
+ */
+mvn_val_t mvn_val_fmap_take(mvn_fmap_t *fmap)
+{
+    if (!fmap) {
+        return mvn_val_null();
+    }
+    return (mvn_val_t){.type = MVN_VAL_FROZEN_MAP, .fmap = fmap};
+}
+
+/**
+ * @brief Creates an empty hash set value.
+ * Allocates a new mvn_hset_t internally.
+ * @return A mvn_val_t representing the hash set, or MVN_VAL_NULL on allocation failure.
+ */
+mvn_val_t mvn_val_hset(void)
+{
+    mvn_hset_t *hset = mvn_hset_new();
+    if (!hset) {
+        return mvn_val_null();
+    }
+    return (mvn_val_t){.type = MVN_VAL_HASHSET, .hset = hset};
+}
+
+/**
+ * @brief Creates a hash set value by taking ownership of an existing mvn_hset_t.
+ * @param hset The mvn_hset_t to take ownership of. If NULL, creates a NULL value.
+ * @return A mvn_val_t representing the hash set.
+ */
+mvn_val_t mvn_val_hset_take(mvn_hset_t *hset)
+{
+    if (!hset) {
+        return mvn_val_null();
+    }
+    return (mvn_val_t){.type = MVN_VAL_HASHSET, .hset = hset};
+}
+
+/**
+ * @brief Creates a bitset value with every bit clear.
+ * Allocates a new mvn_bitset_t internally.
+ * @param size The number of bits.
+ * @return A mvn_val_t representing the bitset, or MVN_VAL_NULL on allocation failure.
+ */
+mvn_val_t mvn_val_bitset(size_t size)
+{
+    mvn_bitset_t *bits = mvn_bitset_new(size);
+    if (!bits) {
+        return mvn_val_null();
+    }
+    return (mvn_val_t){.type = MVN_VAL_BITSET, .bits = bits};
+}
+
+/**
+ * @brief Creates a bitset value by taking ownership of an existing mvn_bitset_t.
+ * @param bits The mvn_bitset_t to take ownership of. If NULL, creates a NULL value.
+ * @return A mvn_val_t representing the bitset.
+ */
+mvn_val_t mvn_val_bitset_take(mvn_bitset_t *bits)
+{
+    if (!bits) {
+        return mvn_val_null();
+    }
+    return (mvn_val_t){.type = MVN_VAL_BITSET, .bits = bits};
+}
+
 /**
  * @brief Frees the resources owned by a mvn_val_t.
- * If the value type is STRING, ARRAY, or HASHMAP, it frees the associated
- * dynamic structure recursively. For other types, it does nothing.
+ * If the value type is STRING, ARRAY, HASHMAP, FROZEN_MAP, HASHSET or BITSET, it frees the
+ * associated dynamic structure recursively. For other types, it does nothing.
  * Resets the value to MVN_VAL_NULL after freeing to prevent double frees.
  * @param value Pointer to the value to free. Does nothing if NULL.
  */
@@ -306,6 +389,15 @@ void mvn_val_free(mvn_val_t *value)
         case MVN_VAL_HASHMAP:
             mvn_hmap_free(value->hmap); // Calls function from mvn_ds_hmap.c
             break;
+        case MVN_VAL_FROZEN_MAP:
+            mvn_fmap_free(value->fmap); // Calls function from mvn_ds_fmap.c
+            break;
+        case MVN_VAL_HASHSET:
+            mvn_hset_free(value->hset); // Calls function from mvn_ds_hset.c
+            break;
+        case MVN_VAL_BITSET:
+            mvn_bitset_free(value->bits); // Calls function from mvn_ds_bitset.c
+            break;
             // Primitive types and NULL don't own heap resources:
         case MVN_VAL_NULL:
         case MVN_VAL_BOOL:
@@ -375,6 +467,12 @@ const char *mvn_val_type_to_str(mvn_val_type_t type)
             return "ARRAY";
         case MVN_VAL_HASHMAP:
             return "HASHMAP";
+        case MVN_VAL_FROZEN_MAP:
+            return "FROZEN_MAP";
+        case MVN_VAL_HASHSET:
+            return "HASHSET";
+        case MVN_VAL_BITSET:
+            return "BITSET";
         default:
             return "UNKNOWN";
     }
@@ -489,6 +587,57 @@ void mvn_val_print(const mvn_val_t *value)
             printf("}");
             break;
         } // Close brace for case
+        case MVN_VAL_FROZEN_MAP:
+            if (!value->fmap) {
+                printf("NULL_FMAP_PTR");
+                break;
+            }
+            printf("{");
+            for (size_t index = 0; index < value->fmap->count; index++) {
+                if (index > 0) {
+                    printf(", ");
+                }
+                printf("\"%s\": ", mvn_fmap_key_at(value->fmap, index));
+                mvn_val_print(mvn_fmap_value_at(value->fmap, index));
+            }
+            printf("}");
+            break;
+        case MVN_VAL_HASHSET: {
+            if (!value->hset) {
+                printf("NULL_HSET_PTR");
+                break;
+            }
+            printf("Set{");
+            size_t           cursor  = 0;
+            const mvn_val_t *element = NULL;
+            bool             first   = true;
+            while ((element = mvn_hset_next(value->hset, &cursor)) != NULL) {
+                if (!first) {
+                    printf(", ");
+                }
+                first = false;
+                mvn_val_print(element);
+            }
+            printf("}");
+            break;
+        }
+        case MVN_VAL_BITSET:
+            if (!value->bits) {
+                printf("NULL_BITSET_PTR");
+                break;
+            }
+            if (value->bits->size > MVN_DS_VAL_PRINT_MAX_BITS) {
+                printf("Bits(size=%zu, count=%zu)",
+                       value->bits->size,
+                       mvn_bitset_count(value->bits));
+                break;
+            }
+            printf("Bits(");
+            for (size_t index = 0; index < value->bits->size; index++) {
+                putchar(mvn_bitset_test(value->bits, index) ? '1' : '0');
+            }
+            printf(")");
+            break;
         default:
             printf("UNKNOWN_TYPE(%d)", value->type);
             break;
@@ -624,6 +773,35 @@ bool mvn_val_equal(const mvn_val_t *val_one, const mvn_val_t *val_two)
             }
             return true; // All keys and values matched
         }
+        case MVN_VAL_FROZEN_MAP: {
+            mvn_fmap_t *map_one = val_one->fmap;
+            mvn_fmap_t *map_two = val_two->fmap;
+
+            if (!map_one && !map_two) {
+                return true;
+            }
+            if (!map_one || !map_two) {
+                return false;
+            }
+            if (map_one->count != map_two->count) {
+                return false;
+            }
+            // Every key of the first map must be present in the second with an equal value
+            for (size_t index = 0; index < map_one->count; index++) {
+                const mvn_val_t *found_val_two =
+                    mvn_fmap_get_cstr(map_two, mvn_fmap_key_at(map_one, index));
+                if (!found_val_two ||
+                    !mvn_val_equal(mvn_fmap_value_at(map_one, index), found_val_two)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case MVN_VAL_HASHSET:
+            // Same count and every element found in the other set
+            return mvn_hset_equal(val_one->hset, val_two->hset);
+        case MVN_VAL_BITSET:
+            return mvn_bitset_equal(val_one->bits, val_two->bits);
         default:
             // Should not happen if all types are handled
             fprintf(stderr,
@@ -634,15 +812,10 @@ bool mvn_val_equal(const mvn_val_t *val_one, const mvn_val_t *val_two)
 }
 
 /**
- * @brief Creates a deep copy of a mvn_val_t.
- * For dynamic types (STRING, ARRAY, HASHMAP), this means new allocations and copying content.
- * For PTR type, the pointer value is copied, not the data it points to.
- * Primitive types are copied by value.
- * @param original_value Pointer to the value to copy.
- * @return A new mvn_val_t containing the deep-copied data.
- *         Returns MVN_VAL_NULL if original_value is NULL or on allocation failure.
+ * @internal
+ * @brief Recursive body of mvn_val_deep_copy, without the tracepoints.
  */
-mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
+static mvn_val_t mvn_val_deep_copy_value(const mvn_val_t *original_value)
 {
     if (!original_value) {
         return mvn_val_null();
@@ -717,7 +890,8 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
                     return mvn_val_null(); // Allocation failure
                 }
                 for (size_t i = 0; i < original_value->arr->count; ++i) {
-                    mvn_val_t element_copy = mvn_val_deep_copy(&original_value->arr->data[i]);
+                    mvn_val_t element_copy =
+                        mvn_val_deep_copy_value(&original_value->arr->data[i]);
                     if (!mvn_arr_push(new_arr_ptr, element_copy)) {
                         // Handle push failure: free already copied elements and the new array
                         mvn_val_free(&element_copy); // Free the last problematic copy
@@ -732,7 +906,12 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
             break;
         case MVN_VAL_HASHMAP:
             if (original_value->hmap) {
-                mvn_hmap_t *new_hmap_ptr = mvn_hmap_new_capacity(original_value->hmap->capacity);
+                // Copies of seeded maps keep the seed, so they stay flooding-resistant
+                mvn_hmap_t *new_hmap_ptr =
+                    original_value->hmap->seeded
+                        ? mvn_hmap_new_seeded(original_value->hmap->capacity,
+                                              original_value->hmap->seed)
+                        : mvn_hmap_new_capacity(original_value->hmap->capacity);
                 if (!new_hmap_ptr) {
                     return mvn_val_null(); // Allocation failure
                 }
@@ -747,7 +926,7 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
                                 mvn_hmap_free(new_hmap_ptr);
                                 return mvn_val_null();
                             }
-                            mvn_val_t value_copy = mvn_val_deep_copy(&current_entry->value);
+                            mvn_val_t value_copy = mvn_val_deep_copy_value(&current_entry->value);
 
                             if (!mvn_hmap_set(new_hmap_ptr, key_copy_ptr, value_copy)) {
                                 // Handle set failure
@@ -760,11 +939,49 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
                         current_entry = current_entry->next;
                     }
                 }
+                // A filtered map keeps its filter, rebuilt from the copied keys
+                const mvn_bloom_t *filter = original_value->hmap->filter;
+                if (filter && !mvn_hmap_attach_filter(new_hmap_ptr, filter->false_positive_rate)) {
+                    mvn_hmap_free(new_hmap_ptr);
+                    return mvn_val_null();
+                }
                 copy_val.hmap = new_hmap_ptr;
             } else {
                 copy_val.hmap = NULL; // Or mvn_hmap_new() for an empty map
             }
             break;
+        case MVN_VAL_FROZEN_MAP:
+            if (original_value->fmap) {
+                // The perfect hash is copied as-is; only the values need deep copies
+                copy_val.fmap = mvn_fmap_copy(original_value->fmap);
+                if (!copy_val.fmap) {
+                    return mvn_val_null();
+                }
+            } else {
+                copy_val.fmap = NULL;
+            }
+            break;
+        case MVN_VAL_HASHSET:
+            if (original_value->hset) {
+                // Stored hashes and the slot layout are reused; only elements need deep copies
+                copy_val.hset = mvn_hset_copy(original_value->hset);
+                if (!copy_val.hset) {
+                    return mvn_val_null();
+                }
+            } else {
+                copy_val.hset = NULL;
+            }
+            break;
+        case MVN_VAL_BITSET:
+            if (original_value->bits) {
+                copy_val.bits = mvn_bitset_copy(original_value->bits);
+                if (!copy_val.bits) {
+                    return mvn_val_null();
+                }
+            } else {
+                copy_val.bits = NULL;
+            }
+            break;
         default:
             // Should not happen if all types are handled
             fprintf(stderr,
@@ -775,6 +992,51 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
     return copy_val;
 }
 
+/**
+ * @brief Creates a deep copy of a mvn_val_t.
+ * For dynamic types (STRING, ARRAY, HASHMAP), this means new allocations and copying content.
+ * For PTR type, the pointer value is copied, not the data it points to.
+ * Primitive types are copied by value.
+ * @param original_value Pointer to the value to copy.
+ * @return A new mvn_val_t containing the deep-copied data.
+ *         Returns MVN_VAL_NULL if original_value is NULL or on allocation failure.
+ */
+mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
+{
+    if (!original_value) {
+        return mvn_val_null();
+    }
+    MVN_DS_TRACE2(deep_copy_start, original_value, (int)original_value->type);
+    mvn_val_t copy_val = mvn_val_deep_copy_value(original_value);
+    MVN_DS_TRACE3(deep_copy_done,
+                  original_value,
+                  (int)original_value->type,
+                  copy_val.type == original_value->type ? 1 : 0);
+    return copy_val;
+}
+
+/**
+ * @internal
+ * @brief Orders bitsets by size, then by the lowest differing bit: the bitset with that bit
+ * clear is less. Equal bitsets compare 0, consistent with mvn_bitset_equal.
+ */
+static int mvn_val_compare_bitsets(const mvn_bitset_t *bits_one, const mvn_bitset_t *bits_two)
+{
+    if (bits_one == bits_two) return 0;
+    if (!bits_one) return -1;
+    if (!bits_two) return 1;
+    if (bits_one->size != bits_two->size) return bits_one->size < bits_two->size ? -1 : 1;
+    size_t word_count = (bits_one->size + 63) / 64;
+    for (size_t index = 0; index < word_count; index++) {
+        uint64_t difference = bits_one->words[index] ^ bits_two->words[index];
+        if (difference != 0) {
+            uint64_t lowest = difference & (~difference + 1); // Lowest differing bit
+            return (bits_one->words[index] & lowest) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Compares two mvn_val_t values.
  *
@@ -782,6 +1044,7 @@ mvn_val_t mvn_val_deep_copy(const mvn_val_t *original_value)
  * - First compares by type (e.g., NULL < BOOL < I32 < STRING).
  * - If types are the same, performs type-specific comparison.
  * - For strings, uses lexicographical comparison.
+ * - For bitsets, compares by size, then by the lowest bit where they differ.
  * - For arrays and hashmaps, comparison is currently based on pointer address or count
  *   (could be extended to content comparison if needed, but that's complex).
  *   For simplicity in this example, we'll compare by count, then by pointer if counts are equal.
@@ -864,7 +1127,332 @@ int mvn_val_compare(const mvn_val_t *val_one, const mvn_val_t *val_two)
             if (val_one->hmap->count < val_two->hmap->count) return -1;
             if (val_one->hmap->count > val_two->hmap->count) return 1;
             return (val_one->hmap < val_two->hmap) ? -1 : (val_one->hmap > val_two->hmap ? 1 : 0);
+        case MVN_VAL_FROZEN_MAP:
+            // Simplified comparison: by count, then by address.
+            if (val_one->fmap == val_two->fmap) return 0;
+            if (!val_one->fmap) return -1;
+            if (!val_two->fmap) return 1;
+            if (val_one->fmap->count < val_two->fmap->count) return -1;
+            if (val_one->fmap->count > val_two->fmap->count) return 1;
+            return (val_one->fmap < val_two->fmap) ? -1 : (val_one->fmap > val_two->fmap ? 1 : 0);
+        case MVN_VAL_HASHSET:
+            // Simplified comparison: by count, then by address.
+            if (val_one->hset == val_two->hset) return 0;
+            if (!val_one->hset) return -1;
+            if (!val_two->hset) return 1;
+            if (val_one->hset->count < val_two->hset->count) return -1;
+            if (val_one->hset->count > val_two->hset->count) return 1;
+            return (val_one->hset < val_two->hset) ? -1 : (val_one->hset > val_two->hset ? 1 : 0);
+        case MVN_VAL_BITSET:
+            return mvn_val_compare_bitsets(val_one->bits, val_two->bits);
         default:
             return 0; // Should not happen
     }
 }
+
+/**
+ * @brief Recursively converts a value into its read-only form.
+ * Hash maps become frozen maps (a minimal perfect hash over contiguous entries), after their
+ * values have been frozen. Arrays keep their type but their elements are frozen in place.
+ * Hash sets are left unchanged, since freezing an element would change its hash; lookups do
+ * not modify them either. Bitsets get their rank index built. Every other type is already
+ * immutable and is left unchanged. A frozen value has no mutable metadata, so it can be read
+ * from many threads at once without locking.
+ * @param value Pointer to the value to freeze in place. Ownership stays with the caller.
+ * @return true on success. On failure (allocation, or no perfect hash found) false is returned
+ *         and value is still valid, but may be only partially frozen.
+ */
+bool mvn_val_freeze(mvn_val_t *value)
+{
+    if (!value) {
+        return false;
+    }
+    switch (value->type) {
+        case MVN_VAL_ARRAY:
+            if (value->arr) {
+                for (size_t index = 0; index < value->arr->count; index++) {
+                    if (!mvn_val_freeze(&value->arr->data[index])) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        case MVN_VAL_HASHMAP: {
+            if (!value->hmap) {
+                return true;
+            }
+            // Freeze nested values first; they are moved into the frozen map below
+            for (size_t index = 0; index < value->hmap->capacity; index++) {
+                mvn_hmap_entry_t *entry = value->hmap->buckets[index];
+                while (entry) {
+                    if (!mvn_val_freeze(&entry->value)) {
+                        return false;
+                    }
+                    entry = entry->next;
+                }
+            }
+            mvn_fmap_t *fmap = mvn_fmap_from_hmap(value->hmap); // Consumes hmap on success
+            if (!fmap) {
+                return false;
+            }
+            *value = mvn_val_fmap_take(fmap);
+            return true;
+        }
+        case MVN_VAL_BITSET:
+            // Readers never touch the bits, so only the rank index is added for rank/select
+            return !value->bits || mvn_bitset_build_rank_index(value->bits);
+        default:
+            return true; // Primitives, strings, frozen maps and hash sets
+    }
+}
+
+/**
+ * @brief Computes the heap memory owned by a value, recursively.
+ * Counts the requested size of every allocation the value owns: container structs, element,
+ * bucket and entry storage (by capacity, not count), string buffers and keys. The mvn_val_t
+ * itself is not counted (it lives in its parent or on the stack), nor is allocator overhead.
+ * @param value Pointer to the value to measure.
+ * @return The number of bytes, or 0 for NULL and for types that own no heap memory.
+ */
+size_t mvn_val_memory_usage(const mvn_val_t *value)
+{
+    if (!value) {
+        return 0;
+    }
+    size_t total = 0;
+    switch (value->type) {
+        case MVN_VAL_STRING:
+            if (value->str) {
+                total += sizeof(mvn_str_t);
+                if (value->str->data) {
+                    total += value->str->capacity + 1; // +1 for the null terminator
+                }
+            }
+            break;
+        case MVN_VAL_ARRAY:
+            if (value->arr) {
+                total += sizeof(mvn_arr_t) + value->arr->capacity * sizeof(mvn_val_t);
+                for (size_t index = 0; index < value->arr->count; index++) {
+                    total += mvn_val_memory_usage(&value->arr->data[index]);
+                }
+            }
+            break;
+        case MVN_VAL_HASHMAP:
+            if (value->hmap) {
+                total += sizeof(mvn_hmap_t) + mvn_bloom_memory_usage(value->hmap->filter);
+                if (value->hmap->buckets) {
+                    total += value->hmap->capacity * sizeof(mvn_hmap_entry_t *);
+                    for (size_t index = 0; index < value->hmap->capacity; index++) {
+                        mvn_hmap_entry_t *entry = value->hmap->buckets[index];
+                        while (entry) {
+                            mvn_val_t key = {.type = MVN_VAL_STRING, .str = entry->key};
+                            total += sizeof(mvn_hmap_entry_t) + mvn_val_memory_usage(&key) +
+                                     mvn_val_memory_usage(&entry->value);
+                            entry = entry->next;
+                        }
+                    }
+                }
+            }
+            break;
+        case MVN_VAL_FROZEN_MAP:
+            if (value->fmap) {
+                // One block holds the header, entries, displacements and key bytes
+                total += sizeof(mvn_fmap_t) + value->fmap->count * sizeof(mvn_fmap_entry_t) +
+                         value->fmap->bucket_count * sizeof(int32_t);
+                for (size_t index = 0; index < value->fmap->count; index++) {
+                    total += value->fmap->entries[index].key_length + 1;
+                    total += mvn_val_memory_usage(&value->fmap->entries[index].value);
+                }
+            }
+            break;
+        case MVN_VAL_HASHSET:
+            if (value->hset) {
+                total += sizeof(mvn_hset_t) + value->hset->capacity * sizeof(mvn_hset_slot_t);
+                size_t           cursor  = 0;
+                const mvn_val_t *element = NULL;
+                while ((element = mvn_hset_next(value->hset, &cursor)) != NULL) {
+                    total += mvn_val_memory_usage(element);
+                }
+            }
+            break;
+        case MVN_VAL_BITSET:
+            if (value->bits) {
+                size_t word_count = (value->bits->size + 63) / 64;
+                total += sizeof(mvn_bitset_t) + word_count * sizeof(uint64_t);
+                if (value->bits->rank_blocks) {
+                    size_t block_count = value->bits->size / MVN_DS_BITSET_RANK_BLOCK_BITS + 1;
+                    total += block_count * sizeof(size_t);
+                }
+            }
+            break;
+        default:
+            break; // Primitives own no heap memory
+    }
+    return total;
+}
+
+/**
+ * @internal
+ * @brief 64-bit finalizer (MurmurHash3 fmix64); every input bit affects every output bit.
+ */
+static uint64_t mvn_val_mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @internal
+ * @brief Hashes string bytes with FNV-1a 64 followed by a finalizer.
+ */
+static uint64_t mvn_val_hash_bytes(const char *data, size_t length)
+{
+    uint64_t hash_value = MVN_DS_VAL_FNV_OFFSET_BASIS;
+    for (size_t index = 0; index < length; index++) {
+        hash_value ^= (uint64_t)(unsigned char)data[index];
+        hash_value *= MVN_DS_VAL_FNV_PRIME;
+    }
+    return mvn_val_mix(hash_value);
+}
+
+/**
+ * @internal
+ * @brief Hashes one map entry so that swapping key and value changes the result.
+ */
+static uint64_t mvn_val_hash_entry(const char *key, size_t key_length, const mvn_val_t *value)
+{
+    return mvn_val_mix(mvn_val_hash_bytes(key, key_length) ^
+                       mvn_val_hash(value) * MVN_DS_VAL_HASH_MULTIPLIER);
+}
+
+/**
+ * @brief Computes a structural 64-bit hash of a value, consistent with mvn_val_equal: equal
+ * values of every type hash equally, except floats that are only equal within epsilon.
+ * Arrays hash their elements in order. Maps and sets combine their entries with a sum, so the
+ * result does not depend on insertion order or capacity. The type is part of the hash,
+ * matching mvn_val_equal, which never considers values of different types equal.
+ * Floats are hashed by their bits, with -0.0 folded into 0.0.
+ * @param value Pointer to the value to hash.
+ * @return The hash, or 0 if value is NULL.
+ */
+uint64_t mvn_val_hash(const mvn_val_t *value)
+{
+    if (!value) {
+        return 0;
+    }
+    uint64_t bits = 0;
+    switch (value->type) {
+        case MVN_VAL_NULL:
+            break;
+        case MVN_VAL_BOOL:
+            bits = value->b ? 1 : 0;
+            break;
+        case MVN_VAL_I8:
+            bits = (uint64_t)(int64_t)value->i8;
+            break;
+        case MVN_VAL_I16:
+            bits = (uint64_t)(int64_t)value->i16;
+            break;
+        case MVN_VAL_I32:
+            bits = (uint64_t)(int64_t)value->i32;
+            break;
+        case MVN_VAL_I64:
+            bits = (uint64_t)value->i64;
+            break;
+        case MVN_VAL_U8:
+            bits = value->u8;
+            break;
+        case MVN_VAL_U16:
+            bits = value->u16;
+            break;
+        case MVN_VAL_U32:
+            bits = value->u32;
+            break;
+        case MVN_VAL_U64:
+            bits = value->u64;
+            break;
+        case MVN_VAL_F32: {
+            float    number = value->f32 == 0.0f ? 0.0f : value->f32; // -0.0 == 0.0
+            uint32_t float_bits;
+            memcpy(&float_bits, &number, sizeof(float_bits));
+            bits = float_bits;
+            break;
+        }
+        case MVN_VAL_F64: {
+            double number = value->f64 == 0.0 ? 0.0 : value->f64; // -0.0 == 0.0
+            memcpy(&bits, &number, sizeof(bits));
+            break;
+        }
+        case MVN_VAL_CHAR:
+            bits = (unsigned char)value->c;
+            break;
+        case MVN_VAL_PTR:
+            bits = (uint64_t)(uintptr_t)value->ptr;
+            break;
+        case MVN_VAL_STRING:
+            if (value->str && value->str->data) {
+                bits = mvn_val_hash_bytes(value->str->data, value->str->length);
+            }
+            break;
+        case MVN_VAL_ARRAY:
+            if (value->arr) {
+                bits = MVN_DS_VAL_FNV_OFFSET_BASIS;
+                for (size_t index = 0; index < value->arr->count; index++) {
+                    bits = (bits ^ mvn_val_hash(&value->arr->data[index])) * MVN_DS_VAL_FNV_PRIME;
+                }
+                bits ^= value->arr->count;
+            }
+            break;
+        case MVN_VAL_HASHMAP:
+            if (value->hmap && value->hmap->buckets) {
+                for (size_t index = 0; index < value->hmap->capacity; index++) {
+                    for (mvn_hmap_entry_t *entry = value->hmap->buckets[index]; entry;
+                         entry                   = entry->next) {
+                        bits += mvn_val_hash_entry(
+                            entry->key->data, entry->key->length, &entry->value);
+                    }
+                }
+                bits ^= value->hmap->count;
+            }
+            break;
+        case MVN_VAL_FROZEN_MAP:
+            if (value->fmap) {
+                for (size_t index = 0; index < value->fmap->count; index++) {
+                    const mvn_fmap_entry_t *entry = &value->fmap->entries[index];
+                    bits += mvn_val_hash_entry(value->fmap->key_data + entry->key_offset,
+                                               entry->key_length,
+                                               &entry->value);
+                }
+                bits ^= value->fmap->count;
+            }
+            break;
+        case MVN_VAL_HASHSET:
+            if (value->hset) {
+                // Reuse the hashes stored in the slots
+                for (size_t index = 0; index < value->hset->capacity; index++) {
+                    if (value->hset->slots[index].hash != 0) {
+                        bits += mvn_val_mix(value->hset->slots[index].hash);
+                    }
+                }
+                bits ^= value->hset->count;
+            }
+            break;
+        case MVN_VAL_BITSET:
+            if (value->bits) {
+                // The bits past the size are always clear, so whole words can be hashed
+                size_t word_count = (value->bits->size + 63) / 64;
+                for (size_t index = 0; index < word_count; index++) {
+                    bits = mvn_val_mix(bits ^ value->bits->words[index]) * MVN_DS_VAL_FNV_PRIME;
+                }
+                bits ^= value->bits->size;
+            }
+            break;
+        default:
+            break;
+    }
+    return mvn_val_mix(bits ^ mvn_val_mix((uint64_t)value->type + 1));
+}
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds/mvn_ds_alloc.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h> // For memset, strcmp
+
+#ifdef MVN_DS_ALLOC_STATS
+
+#include "mvn_ds_thread.h" // For the atomics behind the stats lock
+
+#include <stdlib.h> // For malloc, calloc, realloc, free
+
+// Size of the open-addressing index over the site table (a power of two, at most half full)
+#define MVN_DS_ALLOC_SITE_SLOTS (MVN_DS_ALLOC_MAX_SITES * 2)
+// Site index stored in block headers when the site table is full
+#define MVN_DS_ALLOC_NO_SITE UINT32_MAX
+
+/**
+ * @internal
+ * @brief Bookkeeping stored in front of every tracked block. Padded to
+ * MVN_DS_ALLOC_HEADER_SIZE so the user pointer keeps malloc's alignment.
+ */
+typedef union mvn_ds_alloc_header_t {
+    struct {
+        size_t   size; /**< Bytes requested for the block. */
+        uint32_t site; /**< Index into the site table, or MVN_DS_ALLOC_NO_SITE. */
+        uint32_t kind; /**< Container type of the allocating site. */
+    } info;
+    unsigned char padding[MVN_DS_ALLOC_HEADER_SIZE];
+} mvn_ds_alloc_header_t;
+
+// All state below is guarded by g_stats_lock
+static volatile size_t      g_stats_lock = 0;
+static mvn_ds_alloc_stats_t g_stats;
+static uint16_t             g_site_slots[MVN_DS_ALLOC_SITE_SLOTS]; // Site index + 1, 0 if empty
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Acquires the stats lock. Critical sections are a few counter updates, so a
+ * yielding spin lock avoids needing a statically initialized mutex on every platform.
+ */
+static void mvn_ds_alloc_lock(void)
+{
+    while (!mvn_atomic_cas_size(&g_stats_lock, 0, 1)) {
+        mvn_thread_yield();
+    }
+}
+
+static void mvn_ds_alloc_unlock(void)
+{
+    mvn_atomic_store_release_size(&g_stats_lock, 0);
+}
+
+/**
+ * @internal
+ * @brief Finds or registers the site for file:line. Must be called with the lock held.
+ * @return The site index, or MVN_DS_ALLOC_NO_SITE if the table is full.
+ */
+static uint32_t mvn_ds_alloc_find_site(mvn_ds_alloc_kind_t kind, const char *file, int line)
+{
+    size_t slot = ((size_t)line * 2654435761U) & (MVN_DS_ALLOC_SITE_SLOTS - 1);
+    while (g_site_slots[slot] != 0) {
+        mvn_ds_alloc_site_t *site = &g_stats.sites[g_site_slots[slot] - 1];
+        // __FILE__ literals are not guaranteed to be shared between translation units
+        if (site->line == line && site->kind == kind &&
+            (site->file == file || strcmp(site->file, file) == 0)) {
+            return (uint32_t)(g_site_slots[slot] - 1);
+        }
+        slot = (slot + 1) & (MVN_DS_ALLOC_SITE_SLOTS - 1);
+    }
+    if (g_stats.site_count == MVN_DS_ALLOC_MAX_SITES) {
+        return MVN_DS_ALLOC_NO_SITE;
+    }
+    mvn_ds_alloc_site_t *site = &g_stats.sites[g_stats.site_count];
+    memset(site, 0, sizeof(*site));
+    site->file         = file;
+    site->line         = line;
+    site->kind         = kind;
+    g_site_slots[slot] = (uint16_t)(++g_stats.site_count);
+    return (uint32_t)(g_stats.site_count - 1);
+}
+
+/**
+ * @internal
+ * @brief Applies a change to the total, kind and (if tracked) site counters. Must be called
+ * with the lock held. live_delta is added to live bytes (negative values subtract).
+ */
+static void mvn_ds_alloc_record(uint32_t site,
+                                uint32_t kind,
+                                uint64_t allocs,
+                                uint64_t reallocs,
+                                uint64_t frees,
+                                uint64_t bytes_requested,
+                                int64_t  live_delta)
+{
+    mvn_ds_alloc_counters_t *targets[3] = {&g_stats.total, &g_stats.kinds[kind], NULL};
+    if (site != MVN_DS_ALLOC_NO_SITE) {
+        targets[2] = &g_stats.sites[site].counters;
+    }
+    for (size_t index = 0; index < 3 && targets[index] != NULL; index++) {
+        targets[index]->allocs += allocs;
+        targets[index]->reallocs += reallocs;
+        targets[index]->frees += frees;
+        targets[index]->bytes_requested += bytes_requested;
+        targets[index]->live_bytes += (uint64_t)live_delta; // Wraps back for negative deltas
+    }
+}
+
+/**
+ * @internal
+ * @brief Fills in a new block's header and records it. Returns the user pointer.
+ */
+static void *mvn_ds_alloc_track(mvn_ds_alloc_header_t *header,
+                                size_t                 size,
+                                bool                   is_realloc,
+                                mvn_ds_alloc_kind_t    kind,
+                                const char            *file,
+                                int                    line)
+{
+    mvn_ds_alloc_lock();
+    uint32_t site = mvn_ds_alloc_find_site(kind, file, line);
+    mvn_ds_alloc_record(
+        site, (uint32_t)kind, is_realloc ? 0 : 1, is_realloc ? 1 : 0, 0, size, (int64_t)size);
+    mvn_ds_alloc_unlock();
+
+    header->info.size = size;
+    header->info.site = site;
+    header->info.kind = (uint32_t)kind;
+    return header + 1;
+}
+
+// --- Tracked Allocators ---
+
+/**
+ * @brief malloc that records the call against kind and file:line.
+ * @return The block, or NULL on failure (nothing is recorded).
+ */
+void *mvn_ds_alloc_stats_malloc(size_t size, mvn_ds_alloc_kind_t kind, const char *file, int line)
+{
+    if (size > SIZE_MAX - sizeof(mvn_ds_alloc_header_t)) {
+        return NULL;
+    }
+    mvn_ds_alloc_header_t *header =
+        (mvn_ds_alloc_header_t *)malloc(sizeof(mvn_ds_alloc_header_t) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    return mvn_ds_alloc_track(header, size, false, kind, file, line);
+}
+
+/**
+ * @brief calloc that records the call against kind and file:line. Counts as one alloc.
+ * @return The zeroed block, or NULL on failure or overflow.
+ */
+void *mvn_ds_alloc_stats_calloc(
+    size_t count, size_t size, mvn_ds_alloc_kind_t kind, const char *file, int line)
+{
+    if (size != 0 && count > (SIZE_MAX - sizeof(mvn_ds_alloc_header_t)) / size) {
+        return NULL;
+    }
+    size_t                 total = count * size;
+    mvn_ds_alloc_header_t *header =
+        (mvn_ds_alloc_header_t *)calloc(1, sizeof(mvn_ds_alloc_header_t) + total);
+    if (header == NULL) {
+        return NULL;
+    }
+    return mvn_ds_alloc_track(header, total, false, kind, file, line);
+}
+
+/**
+ * @brief realloc that records the call against kind and file:line. A NULL pointer is still
+ * counted as a realloc, since that is the call the code made.
+ * @return The resized block, or NULL on failure (the original block is kept).
+ */
+void *mvn_ds_alloc_stats_realloc(
+    void *pointer, size_t size, mvn_ds_alloc_kind_t kind, const char *file, int line)
+{
+    if (size > SIZE_MAX - sizeof(mvn_ds_alloc_header_t)) {
+        return NULL;
+    }
+    mvn_ds_alloc_header_t *old_header = NULL;
+    mvn_ds_alloc_header_t  old_info;
+    memset(&old_info, 0, sizeof(old_info));
+    if (pointer != NULL) {
+        old_header = (mvn_ds_alloc_header_t *)pointer - 1;
+        old_info   = *old_header; // The block may move, so keep a copy
+    }
+    mvn_ds_alloc_header_t *header = (mvn_ds_alloc_header_t *)realloc(
+        old_header, sizeof(mvn_ds_alloc_header_t) + size);
+    if (header == NULL) {
+        return NULL; // The original block is untouched, as with realloc
+    }
+    if (old_header != NULL) {
+        // The old block's bytes leave its site; the new size is charged to this site
+        mvn_ds_alloc_lock();
+        mvn_ds_alloc_record(old_info.info.site,
+                            old_info.info.kind,
+                            0,
+                            0,
+                            0,
+                            0,
+                            -(int64_t)old_info.info.size);
+        mvn_ds_alloc_unlock();
+    }
+    return mvn_ds_alloc_track(header, size, true, kind, file, line);
+}
+
+/**
+ * @brief free for blocks from the tracked allocators. Charged to the allocating site.
+ */
+void mvn_ds_alloc_stats_free(void *pointer)
+{
+    if (pointer == NULL) {
+        return;
+    }
+    mvn_ds_alloc_header_t *header = (mvn_ds_alloc_header_t *)pointer - 1;
+    mvn_ds_alloc_lock();
+    mvn_ds_alloc_record(
+        header->info.site, header->info.kind, 0, 0, 1, 0, -(int64_t)header->info.size);
+    mvn_ds_alloc_unlock();
+    free(header);
+}
+
+#endif /* MVN_DS_ALLOC_STATS */
+
+// --- Statistics ---
+
+/**
+ * @brief Copies the current allocation statistics.
+ * @param stats Destination snapshot. Must not be NULL.
+ * @return true if statistics are compiled in, false otherwise (stats is then zeroed).
+ */
+bool mvn_ds_alloc_stats(mvn_ds_alloc_stats_t *stats)
+{
+    if (stats == NULL) {
+        return false;
+    }
+#ifdef MVN_DS_ALLOC_STATS
+    mvn_ds_alloc_lock();
+    // Copy only the used part of the site table
+    memcpy(stats, &g_stats, offsetof(mvn_ds_alloc_stats_t, sites));
+    memcpy(stats->sites, g_stats.sites, g_stats.site_count * sizeof(mvn_ds_alloc_site_t));
+    mvn_ds_alloc_unlock();
+    stats->enabled = true;
+    return true;
+#else
+    memset(stats, 0, offsetof(mvn_ds_alloc_stats_t, sites));
+    return false;
+#endif
+}
+
+/**
+ * @brief Zeroes the event and byte counters, keeping live bytes and registered sites.
+ */
+void mvn_ds_alloc_stats_reset(void)
+{
+#ifdef MVN_DS_ALLOC_STATS
+    mvn_ds_alloc_lock();
+    mvn_ds_alloc_counters_t *counters[MVN_DS_ALLOC_KIND_COUNT + 1 + MVN_DS_ALLOC_MAX_SITES];
+    size_t                   count = 0;
+    counters[count++]              = &g_stats.total;
+    for (size_t kind = 0; kind < MVN_DS_ALLOC_KIND_COUNT; kind++) {
+        counters[count++] = &g_stats.kinds[kind];
+    }
+    for (size_t site = 0; site < g_stats.site_count; site++) {
+        counters[count++] = &g_stats.sites[site].counters;
+    }
+    for (size_t index = 0; index < count; index++) {
+        uint64_t live = counters[index]->live_bytes;
+        memset(counters[index], 0, sizeof(mvn_ds_alloc_counters_t));
+        counters[index]->live_bytes = live;
+    }
+    mvn_ds_alloc_unlock();
+#endif
+}
+
+/**
+ * @brief Returns the number of successful allocs and reallocs since the last reset.
+ * @return The count, or 0 when statistics are compiled out.
+ */
+uint64_t mvn_ds_alloc_count(void)
+{
+#ifdef MVN_DS_ALLOC_STATS
+    mvn_ds_alloc_lock();
+    uint64_t count = g_stats.total.allocs + g_stats.total.reallocs;
+    mvn_ds_alloc_unlock();
+    return count;
+#else
+    return 0;
+#endif
+}
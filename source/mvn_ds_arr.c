@@ -1,10 +1,13 @@
 /*
  * Copyright (c) 2024 Jake Larson
  */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_ARR // Allocation statistics category
+
 #include "mvn_ds/mvn_ds_arr.h"
 
-#include "mvn_ds/mvn_ds.h"       // Provides mvn_val_null, mvn_val_free
+#include "mvn_ds/mvn_ds.h"       // Provides mvn_val_null, mvn_val_free, mvn_val_hash
 #include "mvn_ds/mvn_ds_utils.h" // Provides memory macros (MVN_DS_*)
+#include "mvn_ds_trace.h"        // For resize and large allocation tracepoints
 
 #include <assert.h>
 #include <stdbool.h>
@@ -12,6 +15,18 @@
 #include <stdlib.h> // For SIZE_MAX, qsort
 #include <string.h> // For memmove
 
+// Smallest table allocated by mvn_arr_unique; a power of two
+#define MVN_DS_ARR_UNIQUE_MIN_SLOTS 8
+
+/**
+ * @internal
+ * @brief One slot of the temporary open-addressing table used by mvn_arr_unique.
+ */
+typedef struct mvn_arr_unique_slot_t {
+    uint64_t hash;     /**< mvn_val_hash of the kept value. */
+    size_t   position; /**< Position of the kept value plus 1; 0 marks an empty slot. */
+} mvn_arr_unique_slot_t;
+
 // --- Internal Helper Functions ---
 
 /**
@@ -73,8 +88,11 @@ static bool mvn_arr_ensure_capacity(mvn_arr_t *array)
     }
     size_t allocation_size = new_capacity * sizeof(mvn_val_t);
 
+    MVN_DS_TRACE3(arr_resize_start, array, old_capacity, new_capacity);
+    MVN_DS_TRACE_ALLOCATION(allocation_size, MVN_DS_ALLOC_KIND);
     mvn_val_t *new_data = (mvn_val_t *)mvn_arr_reallocate(array->data, allocation_size);
     if (!new_data) {
+        MVN_DS_TRACE3(arr_resize_done, array, new_capacity, 0);
         return false;
     }
 
@@ -85,6 +103,33 @@ static bool mvn_arr_ensure_capacity(mvn_arr_t *array)
     for (size_t index = old_capacity; index < new_capacity; ++index) {
         array->data[index] = mvn_val_null();
     }
+    MVN_DS_TRACE3(arr_resize_done, array, new_capacity, 1);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Looks value up among the values kept so far by mvn_arr_unique and, if it is new,
+ * records that it will be kept at position. Linear probing; the table is at most half full.
+ * @param data The array's elements; kept values are looked up at their recorded positions.
+ * @return true if no equal value was kept before, false if value is a duplicate.
+ */
+static bool mvn_arr_unique_keep(mvn_arr_unique_slot_t *slots,
+                                size_t                 mask,
+                                const mvn_val_t       *data,
+                                const mvn_val_t       *value,
+                                size_t                 position)
+{
+    uint64_t hash = mvn_val_hash(value);
+    size_t   slot = (size_t)hash & mask;
+    while (slots[slot].position != 0) {
+        if (slots[slot].hash == hash && mvn_val_equal(&data[slots[slot].position - 1], value)) {
+            return false;
+        }
+        slot = (slot + 1) & mask;
+    }
+    slots[slot].hash     = hash;
+    slots[slot].position = position + 1;
     return true;
 }
 
@@ -110,6 +155,7 @@ mvn_arr_t *mvn_arr_new_capacity(size_t capacity)
             fprintf(stderr, "[MVN_DS_ARR] Initial capacity overflow.\n");
             return NULL;
         }
+        MVN_DS_TRACE_ALLOCATION(capacity * sizeof(mvn_val_t), MVN_DS_ALLOC_KIND);
         array->data = (mvn_val_t *)MVN_DS_CALLOC(capacity, sizeof(mvn_val_t));
         if (!array->data) {
             MVN_DS_FREE(array);
@@ -615,3 +661,102 @@ mvn_val_t *mvn_arr_find_last(const mvn_arr_t *array, const mvn_val_t *value_to_f
     }
     return NULL;
 }
+
+/**
+ * @brief Removes duplicate values from the array in place, in O(n) expected time instead of
+ * the O(n^2) of checking each value with mvn_arr_contains. Each value is hashed once with
+ * mvn_val_hash and looked up in a temporary open-addressing table of the values kept so far,
+ * which is compared with mvn_val_equal. Kept values are moved down over the removed ones
+ * without deep copies; removed values are freed. Floats only meet when their hashes do, i.e.
+ * when they are exactly equal, so epsilon-equal floats can both survive.
+ * @param array The array to modify.
+ * @param keep_first true to keep the first occurrence of each value, false to keep the last.
+ *                   Either way the kept values stay in their original relative order.
+ * @return true on success, false if array is NULL or the table cannot be allocated (the array
+ *         is then unchanged).
+ */
+bool mvn_arr_unique(mvn_arr_t *array, bool keep_first)
+{
+    if (!array) {
+        return false;
+    }
+    size_t count = array->count;
+    if (count < 2) {
+        return true; // Nothing to compare
+    }
+    size_t slot_count = MVN_DS_ARR_UNIQUE_MIN_SLOTS;
+    // count * 2 cannot overflow, since count values of sizeof(mvn_val_t) bytes are allocated
+    while (slot_count < count * 2) {
+        slot_count *= 2;
+    }
+    mvn_arr_unique_slot_t *slots =
+        (mvn_arr_unique_slot_t *)MVN_DS_CALLOC(slot_count, sizeof(mvn_arr_unique_slot_t));
+    if (!slots) {
+        return false;
+    }
+
+    mvn_val_t *data = array->data;
+    size_t     mask = slot_count - 1;
+    size_t     kept = 0;
+    if (keep_first) {
+        for (size_t index = 0; index < count; ++index) {
+            if (mvn_arr_unique_keep(slots, mask, data, &data[index], kept)) {
+                data[kept++] = data[index];
+            } else {
+                mvn_val_free(&data[index]);
+            }
+        }
+    } else {
+        // Walk backwards so that each value's last occurrence is met first, packing the kept
+        // values against the end, then move them down to the front in one block
+        size_t start = count;
+        for (size_t index = count; index-- > 0;) {
+            if (mvn_arr_unique_keep(slots, mask, data, &data[index], start - 1)) {
+                data[--start] = data[index];
+            } else {
+                mvn_val_free(&data[index]);
+            }
+        }
+        kept = count - start;
+        memmove(data, data + start, kept * sizeof(mvn_val_t));
+    }
+    MVN_DS_FREE(slots);
+
+    // The slots past the kept values hold stale copies of moved values; clear them
+    for (size_t index = kept; index < count; ++index) {
+        data[index] = mvn_val_null();
+    }
+    array->count = kept;
+    return true;
+}
+
+/**
+ * @brief Removes adjacent duplicate values from the array in place, in one linear pass that
+ * compares each value with the last one kept using mvn_val_equal. Kept values are moved down
+ * without deep copies; removed values are freed. Sort the array first (e.g. with
+ * mvn_arr_sort and a mvn_val_compare-based comparator) to remove every duplicate.
+ * @param array The array to modify.
+ * @return true on success, false if array is NULL.
+ */
+bool mvn_arr_unique_sorted(mvn_arr_t *array)
+{
+    if (!array) {
+        return false;
+    }
+    if (array->count < 2) {
+        return true;
+    }
+    size_t kept = 1;
+    for (size_t index = 1; index < array->count; ++index) {
+        if (mvn_val_equal(&array->data[kept - 1], &array->data[index])) {
+            mvn_val_free(&array->data[index]);
+        } else {
+            array->data[kept++] = array->data[index];
+        }
+    }
+    for (size_t index = kept; index < array->count; ++index) {
+        array->data[index] = mvn_val_null();
+    }
+    array->count = kept;
+    return true;
+}
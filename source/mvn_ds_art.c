@@ -0,0 +1,1091 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_ART // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_art.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_free
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memcmp, memcpy, memmove, strlen
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // For _BitScanForward
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MVN_DS_ART_SSE2 1
+#endif
+
+// Child counts at which a node moves down to the next smaller layout. They sit below the
+// capacities of those layouts, so a key added and removed at a boundary does not reallocate.
+#define MVN_DS_ART_SHRINK_NODE16  3
+#define MVN_DS_ART_SHRINK_NODE48  12
+#define MVN_DS_ART_SHRINK_NODE256 37
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Returns the mvn_art_node_type_t of a node or leaf. Read as a byte, since the pointer
+ * may refer to either structure.
+ */
+static uint8_t mvn_art_type(const mvn_art_node_t *node)
+{
+    return *(const uint8_t *)node;
+}
+
+/**
+ * @internal
+ * @brief Checks whether a child pointer refers to a leaf.
+ */
+static bool mvn_art_is_leaf(const mvn_art_node_t *node)
+{
+    return mvn_art_type(node) == MVN_ART_LEAF;
+}
+
+#ifdef MVN_DS_ART_SSE2
+/**
+ * @internal
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ */
+static unsigned mvn_art_lowest_bit(unsigned mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit_index;
+    _BitScanForward(&bit_index, (unsigned long)mask);
+    return (unsigned)bit_index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+/**
+ * @internal
+ * @brief Returns the allocation size of a node layout.
+ */
+static size_t mvn_art_node_size(uint8_t type)
+{
+    switch (type) {
+        case MVN_ART_NODE4:
+            return sizeof(mvn_art_node4_t);
+        case MVN_ART_NODE16:
+            return sizeof(mvn_art_node16_t);
+        case MVN_ART_NODE48:
+            return sizeof(mvn_art_node48_t);
+        default:
+            return sizeof(mvn_art_node256_t);
+    }
+}
+
+/**
+ * @internal
+ * @brief Allocates an empty inner node of the given layout.
+ * @return The node, or NULL on allocation failure.
+ */
+static mvn_art_node_t *mvn_art_node_new(uint8_t type)
+{
+    mvn_art_node_t *node = (mvn_art_node_t *)MVN_DS_CALLOC(1, mvn_art_node_size(type));
+    if (node == NULL) {
+        fprintf(stderr, "[MVN_DS_ART] Failed to allocate node.\n");
+        return NULL;
+    }
+    node->type = type;
+    return node;
+}
+
+/**
+ * @internal
+ * @brief Allocates a leaf holding a copy of the key and the value.
+ * @return The leaf, or NULL on allocation failure (the value is not freed).
+ */
+static mvn_art_leaf_t *mvn_art_leaf_new(const uint8_t *key, size_t length, mvn_val_t value)
+{
+    mvn_art_leaf_t *leaf = (mvn_art_leaf_t *)MVN_DS_MALLOC(sizeof(mvn_art_leaf_t) + length + 1);
+    if (leaf == NULL) {
+        fprintf(stderr, "[MVN_DS_ART] Failed to allocate leaf.\n");
+        return NULL;
+    }
+    leaf->type       = MVN_ART_LEAF;
+    leaf->key_length = length;
+    leaf->key        = (char *)(leaf + 1);
+    memcpy(leaf->key, key, length);
+    leaf->key[length] = '\0';
+    leaf->value       = value;
+    return leaf;
+}
+
+/**
+ * @internal
+ * @brief Checks whether a leaf holds exactly the given key.
+ */
+static bool mvn_art_leaf_matches(const mvn_art_leaf_t *leaf, const uint8_t *key, size_t length)
+{
+    return leaf->key_length == length && memcmp(leaf->key, key, length) == 0;
+}
+
+/**
+ * @internal
+ * @brief Returns the slot holding the child for byte, or NULL if there is none.
+ */
+static mvn_art_node_t **mvn_art_find_child(const mvn_art_node_t *node, uint8_t byte)
+{
+    switch (node->type) {
+        case MVN_ART_NODE4: {
+            mvn_art_node4_t *node4 = (mvn_art_node4_t *)node;
+            for (uint16_t index = 0; index < node->count; index++) {
+                if (node4->keys[index] == byte) {
+                    return &node4->children[index];
+                }
+            }
+            return NULL;
+        }
+        case MVN_ART_NODE16: {
+            mvn_art_node16_t *node16 = (mvn_art_node16_t *)node;
+#ifdef MVN_DS_ART_SSE2
+            // Compare all 16 key bytes at once; bits past count are masked off
+            __m128i  keys    = _mm_loadu_si128((const __m128i *)node16->keys);
+            __m128i  matches = _mm_cmpeq_epi8(keys, _mm_set1_epi8((char)byte));
+            unsigned mask    = (unsigned)_mm_movemask_epi8(matches) & ((1U << node->count) - 1);
+            return mask != 0 ? &node16->children[mvn_art_lowest_bit(mask)] : NULL;
+#else
+            for (uint16_t index = 0; index < node->count; index++) {
+                if (node16->keys[index] == byte) {
+                    return &node16->children[index];
+                }
+            }
+            return NULL;
+#endif
+        }
+        case MVN_ART_NODE48: {
+            mvn_art_node48_t *node48 = (mvn_art_node48_t *)node;
+            uint8_t           slot   = node48->index[byte];
+            return slot != 0 ? &node48->children[slot - 1] : NULL;
+        }
+        default: {
+            mvn_art_node256_t *node256 = (mvn_art_node256_t *)node;
+            return node256->children[byte] != NULL ? &node256->children[byte] : NULL;
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Returns the child with the smallest key byte greater than after (-1 for the first
+ * child), storing its key byte in *byte, or NULL if there is none.
+ */
+static mvn_art_node_t *mvn_art_child_after(const mvn_art_node_t *node, int after, int *byte)
+{
+    switch (node->type) {
+        case MVN_ART_NODE4:
+        case MVN_ART_NODE16: {
+            // Both keep their keys sorted and share the layout up to the array lengths
+            const uint8_t        *keys     = node->type == MVN_ART_NODE4
+                                                 ? ((const mvn_art_node4_t *)node)->keys
+                                                 : ((const mvn_art_node16_t *)node)->keys;
+            mvn_art_node_t *const *children = node->type == MVN_ART_NODE4
+                                                  ? ((const mvn_art_node4_t *)node)->children
+                                                  : ((const mvn_art_node16_t *)node)->children;
+            for (uint16_t index = 0; index < node->count; index++) {
+                if ((int)keys[index] > after) {
+                    *byte = keys[index];
+                    return children[index];
+                }
+            }
+            return NULL;
+        }
+        case MVN_ART_NODE48: {
+            const mvn_art_node48_t *node48 = (const mvn_art_node48_t *)node;
+            for (int candidate = after + 1; candidate < 256; candidate++) {
+                if (node48->index[candidate] != 0) {
+                    *byte = candidate;
+                    return node48->children[node48->index[candidate] - 1];
+                }
+            }
+            return NULL;
+        }
+        default: {
+            const mvn_art_node256_t *node256 = (const mvn_art_node256_t *)node;
+            for (int candidate = after + 1; candidate < 256; candidate++) {
+                if (node256->children[candidate] != NULL) {
+                    *byte = candidate;
+                    return node256->children[candidate];
+                }
+            }
+            return NULL;
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Returns the leaf with the smallest key in a subtree.
+ */
+static const mvn_art_leaf_t *mvn_art_minimum(const mvn_art_node_t *node)
+{
+    int byte;
+    while (node != NULL && !mvn_art_is_leaf(node)) {
+        if (node->leaf != NULL) {
+            return node->leaf; // A key ending here precedes everything below
+        }
+        node = mvn_art_child_after(node, -1, &byte);
+    }
+    return (const mvn_art_leaf_t *)node;
+}
+
+/**
+ * @internal
+ * @brief Checks the bytes of a node's compressed path that are stored in the node against key.
+ * Longer paths are only checked in part; the leaf comparison at the end catches the rest.
+ * @return false if key is too short for the path or differs from the stored bytes.
+ */
+static bool
+mvn_art_prefix_matches(const mvn_art_node_t *node, const uint8_t *key, size_t length, size_t depth)
+{
+    if (length - depth < node->prefix_length) {
+        return false;
+    }
+    size_t stored =
+        node->prefix_length < MVN_DS_ART_MAX_PREFIX ? node->prefix_length : MVN_DS_ART_MAX_PREFIX;
+    return memcmp(node->prefix, key + depth, stored) == 0;
+}
+
+/**
+ * @internal
+ * @brief Returns how many bytes of a node's compressed path match key from depth on. Bytes
+ * past those stored in the node are read from the subtree's smallest key, which shares them.
+ * @return The number of matching bytes; equal to prefix_length if the whole path matches.
+ */
+static size_t
+mvn_art_prefix_mismatch(const mvn_art_node_t *node, const uint8_t *key, size_t length, size_t depth)
+{
+    size_t limit  = length - depth < node->prefix_length ? length - depth : node->prefix_length;
+    size_t stored = limit < MVN_DS_ART_MAX_PREFIX ? limit : MVN_DS_ART_MAX_PREFIX;
+    size_t index  = 0;
+    for (; index < stored; index++) {
+        if (node->prefix[index] != key[depth + index]) {
+            return index;
+        }
+    }
+    if (index < limit) {
+        const uint8_t *full = (const uint8_t *)mvn_art_minimum(node)->key + depth;
+        for (; index < limit; index++) {
+            if (full[index] != key[depth + index]) {
+                return index;
+            }
+        }
+    }
+    return index;
+}
+
+/**
+ * @internal
+ * @brief Inserts a child into a node that has room for it, keeping the keys of the sorted
+ * layouts in order.
+ */
+static void mvn_art_insert_child(mvn_art_node_t *node, uint8_t byte, mvn_art_node_t *child)
+{
+    switch (node->type) {
+        case MVN_ART_NODE4:
+        case MVN_ART_NODE16: {
+            uint8_t         *keys     = node->type == MVN_ART_NODE4
+                                            ? ((mvn_art_node4_t *)node)->keys
+                                            : ((mvn_art_node16_t *)node)->keys;
+            mvn_art_node_t **children = node->type == MVN_ART_NODE4
+                                            ? ((mvn_art_node4_t *)node)->children
+                                            : ((mvn_art_node16_t *)node)->children;
+            uint16_t         position = 0;
+            while (position < node->count && keys[position] < byte) {
+                position++;
+            }
+            size_t moved = node->count - position;
+            memmove(keys + position + 1, keys + position, moved);
+            memmove(children + position + 1, children + position, moved * sizeof(*children));
+            keys[position]     = byte;
+            children[position] = child;
+            break;
+        }
+        case MVN_ART_NODE48: {
+            mvn_art_node48_t *node48 = (mvn_art_node48_t *)node;
+            uint8_t           slot   = 0;
+            while (node48->children[slot] != NULL) {
+                slot++;
+            }
+            node48->children[slot] = child;
+            node48->index[byte]    = (uint8_t)(slot + 1);
+            break;
+        }
+        default:
+            ((mvn_art_node256_t *)node)->children[byte] = child;
+            break;
+    }
+    node->count++;
+}
+
+/**
+ * @internal
+ * @brief Removes the child for byte from a node. The child itself is not freed.
+ */
+static void mvn_art_delete_child(mvn_art_node_t *node, uint8_t byte)
+{
+    switch (node->type) {
+        case MVN_ART_NODE4:
+        case MVN_ART_NODE16: {
+            uint8_t         *keys     = node->type == MVN_ART_NODE4
+                                            ? ((mvn_art_node4_t *)node)->keys
+                                            : ((mvn_art_node16_t *)node)->keys;
+            mvn_art_node_t **children = node->type == MVN_ART_NODE4
+                                            ? ((mvn_art_node4_t *)node)->children
+                                            : ((mvn_art_node16_t *)node)->children;
+            uint16_t         position = 0;
+            while (keys[position] != byte) {
+                position++;
+            }
+            size_t moved = node->count - position - 1;
+            memmove(keys + position, keys + position + 1, moved);
+            memmove(children + position, children + position + 1, moved * sizeof(*children));
+            break;
+        }
+        case MVN_ART_NODE48: {
+            mvn_art_node48_t *node48                 = (mvn_art_node48_t *)node;
+            node48->children[node48->index[byte] - 1] = NULL;
+            node48->index[byte]                       = 0;
+            break;
+        }
+        default:
+            ((mvn_art_node256_t *)node)->children[byte] = NULL;
+            break;
+    }
+    node->count--;
+}
+
+/**
+ * @internal
+ * @brief Moves a node's path, leaf and children into a new node of another layout, which must
+ * be able to hold the children, and frees the old node.
+ * @return The new node, or NULL on allocation failure (the old node is left untouched).
+ */
+static mvn_art_node_t *mvn_art_resize(mvn_art_node_t *node, uint8_t type)
+{
+    mvn_art_node_t *resized = mvn_art_node_new(type);
+    if (resized == NULL) {
+        return NULL;
+    }
+    resized->prefix_length = node->prefix_length;
+    resized->leaf          = node->leaf;
+    memcpy(resized->prefix, node->prefix, MVN_DS_ART_MAX_PREFIX);
+
+    int             byte  = -1;
+    mvn_art_node_t *child = mvn_art_child_after(node, byte, &byte);
+    while (child != NULL) {
+        mvn_art_insert_child(resized, (uint8_t)byte, child);
+        child = mvn_art_child_after(node, byte, &byte);
+    }
+    MVN_DS_FREE(node);
+    return resized;
+}
+
+/**
+ * @internal
+ * @brief Adds a child to the node in *ref, moving the node to the next larger layout first if
+ * it is full.
+ * @return false on allocation failure (the tree is unchanged).
+ */
+static bool mvn_art_add_child(mvn_art_node_t **ref, uint8_t byte, mvn_art_node_t *child)
+{
+    mvn_art_node_t *node = *ref;
+    bool            full = (node->type == MVN_ART_NODE4 && node->count == 4) ||
+                (node->type == MVN_ART_NODE16 && node->count == 16) ||
+                (node->type == MVN_ART_NODE48 && node->count == 48);
+    if (full) {
+        node = mvn_art_resize(node, (uint8_t)(node->type + 1));
+        if (node == NULL) {
+            return false;
+        }
+        *ref = node;
+    }
+    mvn_art_insert_child(node, byte, child);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Replaces a node left with a single entry by that entry. A remaining child node
+ * absorbs the node's path and key byte into its own path; a remaining leaf takes the node's
+ * place as is, since leaves always compare the whole key.
+ */
+static void mvn_art_collapse(mvn_art_node_t **ref)
+{
+    mvn_art_node_t *node = *ref;
+    if (node->count == 0) {
+        *ref = (mvn_art_node_t *)node->leaf;
+        MVN_DS_FREE(node);
+        return;
+    }
+    int             byte  = -1;
+    mvn_art_node_t *child = mvn_art_child_after(node, byte, &byte);
+    if (!mvn_art_is_leaf(child)) {
+        if (child->prefix_length > UINT32_MAX - 1 - node->prefix_length) {
+            return; // Path too long to merge; keep the chain
+        }
+        uint8_t prefix[MVN_DS_ART_MAX_PREFIX];
+        size_t  stored = node->prefix_length < MVN_DS_ART_MAX_PREFIX ? node->prefix_length
+                                                                     : MVN_DS_ART_MAX_PREFIX;
+        memcpy(prefix, node->prefix, stored);
+        if (stored < MVN_DS_ART_MAX_PREFIX) {
+            prefix[stored++] = (uint8_t)byte;
+        }
+        for (size_t index = 0; stored < MVN_DS_ART_MAX_PREFIX && index < child->prefix_length;
+             index++) {
+            prefix[stored++] = child->prefix[index];
+        }
+        memcpy(child->prefix, prefix, stored);
+        child->prefix_length += node->prefix_length + 1;
+    }
+    *ref = child;
+    MVN_DS_FREE(node);
+}
+
+/**
+ * @internal
+ * @brief Collapses the node in *ref if a single entry is left, or moves it to a smaller
+ * layout once it has few enough children. Allocation failure just keeps the larger layout.
+ */
+static void mvn_art_shrink(mvn_art_node_t **ref)
+{
+    mvn_art_node_t *node = *ref;
+    if (node->count + (node->leaf != NULL ? 1 : 0) <= 1) {
+        mvn_art_collapse(ref);
+        return;
+    }
+    mvn_art_node_t *resized = NULL;
+    switch (node->type) {
+        case MVN_ART_NODE4:
+            break;
+        case MVN_ART_NODE16:
+            if (node->count <= MVN_DS_ART_SHRINK_NODE16) {
+                resized = mvn_art_resize(node, MVN_ART_NODE4);
+            }
+            break;
+        case MVN_ART_NODE48:
+            if (node->count <= MVN_DS_ART_SHRINK_NODE48) {
+                resized = mvn_art_resize(node, MVN_ART_NODE16);
+            }
+            break;
+        default:
+            if (node->count <= MVN_DS_ART_SHRINK_NODE256) {
+                resized = mvn_art_resize(node, MVN_ART_NODE48);
+            }
+            break;
+    }
+    if (resized != NULL) {
+        *ref = resized;
+    }
+}
+
+/**
+ * @internal
+ * @brief Puts a leaf in a new node at depth: as the node's own leaf if the key ends there,
+ * otherwise as the child for its next byte.
+ */
+static void mvn_art_place_leaf(mvn_art_node_t *node, mvn_art_leaf_t *leaf, size_t depth)
+{
+    if (leaf->key_length == depth) {
+        node->leaf = leaf;
+    } else {
+        mvn_art_insert_child(node, (uint8_t)leaf->key[depth], (mvn_art_node_t *)leaf);
+    }
+}
+
+/**
+ * @internal
+ * @brief Replaces the leaf in *ref, whose key differs from key, by a node holding both.
+ * The node's path is the part both keys share after depth.
+ * @return false on allocation failure (the tree is unchanged, the value is not freed).
+ */
+static bool mvn_art_split_leaf(mvn_art_node_t **ref,
+                               const uint8_t   *key,
+                               size_t           length,
+                               size_t           depth,
+                               mvn_val_t        value)
+{
+    mvn_art_leaf_t *existing = (mvn_art_leaf_t *)*ref;
+    const uint8_t  *other    = (const uint8_t *)existing->key;
+    size_t          limit    = existing->key_length < length ? existing->key_length : length;
+    size_t          common   = depth;
+    while (common < limit && other[common] == key[common]) {
+        common++;
+    }
+
+    mvn_art_node_t *node = mvn_art_node_new(MVN_ART_NODE4);
+    mvn_art_leaf_t *leaf = node != NULL ? mvn_art_leaf_new(key, length, value) : NULL;
+    if (leaf == NULL) {
+        MVN_DS_FREE(node);
+        return false;
+    }
+    node->prefix_length = (uint32_t)(common - depth);
+    memcpy(node->prefix,
+           key + depth,
+           node->prefix_length < MVN_DS_ART_MAX_PREFIX ? node->prefix_length
+                                                       : MVN_DS_ART_MAX_PREFIX);
+    mvn_art_place_leaf(node, existing, common);
+    mvn_art_place_leaf(node, leaf, common);
+    *ref = node;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Splits the path of the node in *ref where key leaves it, after mismatch bytes: a new
+ * node takes the shared part and gets the old node (with the rest of its path) and the new
+ * key as entries.
+ * @return false on allocation failure (the tree is unchanged, the value is not freed).
+ */
+static bool mvn_art_split_prefix(mvn_art_node_t **ref,
+                                 size_t           mismatch,
+                                 const uint8_t   *key,
+                                 size_t           length,
+                                 size_t           depth,
+                                 mvn_val_t        value)
+{
+    mvn_art_node_t *node   = *ref;
+    mvn_art_node_t *parent = mvn_art_node_new(MVN_ART_NODE4);
+    mvn_art_leaf_t *leaf   = parent != NULL ? mvn_art_leaf_new(key, length, value) : NULL;
+    if (leaf == NULL) {
+        MVN_DS_FREE(parent);
+        return false;
+    }
+    parent->prefix_length = (uint32_t)mismatch;
+    memcpy(parent->prefix,
+           node->prefix,
+           mismatch < MVN_DS_ART_MAX_PREFIX ? mismatch : MVN_DS_ART_MAX_PREFIX);
+
+    // The old node keeps the path after the byte that now leads to it
+    size_t  remaining = node->prefix_length - mismatch - 1;
+    size_t  stored    = remaining < MVN_DS_ART_MAX_PREFIX ? remaining : MVN_DS_ART_MAX_PREFIX;
+    uint8_t byte;
+    if (node->prefix_length <= MVN_DS_ART_MAX_PREFIX) {
+        byte = node->prefix[mismatch];
+        memmove(node->prefix, node->prefix + mismatch + 1, stored);
+    } else {
+        const uint8_t *full = (const uint8_t *)mvn_art_minimum(node)->key + depth;
+        byte                = full[mismatch];
+        memcpy(node->prefix, full + mismatch + 1, stored);
+    }
+    node->prefix_length = (uint32_t)remaining;
+
+    mvn_art_insert_child(parent, byte, node);
+    mvn_art_place_leaf(parent, leaf, depth + mismatch);
+    *ref = parent;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Inserts or replaces the value for key below *ref.
+ * @param[out] added Set to true if a new key was inserted.
+ * @return false on allocation failure (the tree is unchanged, the value is not freed).
+ */
+static bool mvn_art_insert(mvn_art_node_t **ref,
+                           const uint8_t   *key,
+                           size_t           length,
+                           mvn_val_t        value,
+                           bool            *added)
+{
+    size_t depth = 0;
+    while (true) {
+        mvn_art_node_t *node = *ref;
+        if (node == NULL) {
+            // Only an empty tree has a NULL slot
+            mvn_art_leaf_t *leaf = mvn_art_leaf_new(key, length, value);
+            *ref                 = (mvn_art_node_t *)leaf;
+            *added               = leaf != NULL;
+            return leaf != NULL;
+        }
+        if (mvn_art_is_leaf(node)) {
+            mvn_art_leaf_t *existing = (mvn_art_leaf_t *)node;
+            if (mvn_art_leaf_matches(existing, key, length)) {
+                mvn_val_free(&existing->value);
+                existing->value = value;
+                return true;
+            }
+            *added = mvn_art_split_leaf(ref, key, length, depth, value);
+            return *added;
+        }
+
+        size_t mismatch = mvn_art_prefix_mismatch(node, key, length, depth);
+        if (mismatch < node->prefix_length) {
+            *added = mvn_art_split_prefix(ref, mismatch, key, length, depth, value);
+            return *added;
+        }
+        depth += node->prefix_length;
+
+        if (depth == length) {
+            // The key ends at this node
+            if (node->leaf != NULL) {
+                mvn_val_free(&node->leaf->value);
+                node->leaf->value = value;
+                return true;
+            }
+            node->leaf = mvn_art_leaf_new(key, length, value);
+            *added     = node->leaf != NULL;
+            return node->leaf != NULL;
+        }
+
+        mvn_art_node_t **child = mvn_art_find_child(node, key[depth]);
+        if (child == NULL) {
+            mvn_art_leaf_t *leaf = mvn_art_leaf_new(key, length, value);
+            if (leaf == NULL || !mvn_art_add_child(ref, key[depth], (mvn_art_node_t *)leaf)) {
+                MVN_DS_FREE(leaf); // The value stays with the caller
+                return false;
+            }
+            *added = true;
+            return true;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+/**
+ * @internal
+ * @brief Unlinks the leaf for key from the subtree in *ref, then shrinks or collapses the
+ * nodes on the way back up.
+ * @return The unlinked leaf, or NULL if key is absent.
+ */
+static mvn_art_leaf_t *
+mvn_art_remove_from(mvn_art_node_t **ref, const uint8_t *key, size_t length, size_t depth)
+{
+    mvn_art_node_t *node = *ref;
+    if (mvn_art_is_leaf(node)) {
+        if (!mvn_art_leaf_matches((const mvn_art_leaf_t *)node, key, length)) {
+            return NULL;
+        }
+        *ref = NULL;
+        return (mvn_art_leaf_t *)node;
+    }
+    if (!mvn_art_prefix_matches(node, key, length, depth)) {
+        return NULL;
+    }
+    depth += node->prefix_length;
+
+    mvn_art_leaf_t *removed = NULL;
+    if (depth == length) {
+        if (node->leaf == NULL || !mvn_art_leaf_matches(node->leaf, key, length)) {
+            return NULL;
+        }
+        removed    = node->leaf;
+        node->leaf = NULL;
+    } else {
+        mvn_art_node_t **child = mvn_art_find_child(node, key[depth]);
+        if (child == NULL) {
+            return NULL;
+        }
+        removed = mvn_art_remove_from(child, key, length, depth + 1);
+        if (removed == NULL) {
+            return NULL;
+        }
+        if (*child == NULL) {
+            mvn_art_delete_child(node, key[depth]);
+        }
+    }
+    mvn_art_shrink(ref);
+    return removed;
+}
+
+/**
+ * @internal
+ * @brief Returns the leaf for key, or NULL.
+ */
+static mvn_art_leaf_t *mvn_art_search(const mvn_art_t *art, const uint8_t *key, size_t length)
+{
+    const mvn_art_node_t *node  = art->root;
+    size_t                depth = 0;
+    while (node != NULL) {
+        if (mvn_art_is_leaf(node)) {
+            mvn_art_leaf_t *leaf = (mvn_art_leaf_t *)node;
+            return mvn_art_leaf_matches(leaf, key, length) ? leaf : NULL;
+        }
+        if (!mvn_art_prefix_matches(node, key, length, depth)) {
+            return NULL;
+        }
+        depth += node->prefix_length;
+        if (depth == length) {
+            return node->leaf != NULL && mvn_art_leaf_matches(node->leaf, key, length) ? node->leaf
+                                                                                        : NULL;
+        }
+        mvn_art_node_t **child = mvn_art_find_child(node, key[depth]);
+        if (child == NULL) {
+            return NULL;
+        }
+        node = *child;
+        depth++;
+    }
+    return NULL;
+}
+
+/**
+ * @internal
+ * @brief Returns the leaf that follows last in key order, or NULL. One descent along last's
+ * key remembers the deepest subtree to the right of the path; its smallest key is the answer.
+ */
+static const mvn_art_leaf_t *mvn_art_successor(const mvn_art_t *art, const mvn_art_leaf_t *last)
+{
+    const uint8_t        *key   = (const uint8_t *)last->key;
+    const mvn_art_node_t *node  = art->root;
+    const mvn_art_node_t *right = NULL;
+    size_t                depth = 0;
+    int                   byte;
+    while (node != NULL && !mvn_art_is_leaf(node)) {
+        depth += node->prefix_length;
+        if (depth == last->key_length) {
+            // last is this node's own leaf; the node's children all follow it
+            const mvn_art_node_t *first = mvn_art_child_after(node, -1, &byte);
+            right                       = first != NULL ? first : right;
+            break;
+        }
+        const mvn_art_node_t *next = mvn_art_child_after(node, key[depth], &byte);
+        right                      = next != NULL ? next : right;
+        node                       = *mvn_art_find_child(node, key[depth]);
+        depth++;
+    }
+    return right != NULL ? mvn_art_minimum(right) : NULL;
+}
+
+/**
+ * @internal
+ * @brief Returns the subtree holding exactly the keys that start with prefix, or NULL.
+ */
+static const mvn_art_node_t *
+mvn_art_prefix_root(const mvn_art_t *art, const uint8_t *prefix, size_t length)
+{
+    const mvn_art_node_t *node  = art->root;
+    size_t                depth = 0;
+    while (node != NULL && depth < length) {
+        if (mvn_art_is_leaf(node)) {
+            const mvn_art_leaf_t *leaf = (const mvn_art_leaf_t *)node;
+            return leaf->key_length >= length && memcmp(leaf->key, prefix, length) == 0 ? node
+                                                                                         : NULL;
+        }
+        size_t mismatch = mvn_art_prefix_mismatch(node, prefix, length, depth);
+        if (mismatch < node->prefix_length) {
+            // Either the prefix ends inside the path, so the whole subtree matches, or it differs
+            return depth + mismatch == length ? node : NULL;
+        }
+        depth += node->prefix_length;
+        if (depth == length) {
+            return node;
+        }
+        mvn_art_node_t **child = mvn_art_find_child(node, prefix[depth]);
+        node                   = child != NULL ? *child : NULL;
+        depth++;
+    }
+    return node;
+}
+
+/**
+ * @internal
+ * @brief Frees a subtree, including its keys and values.
+ */
+static void mvn_art_free_node(mvn_art_node_t *node)
+{
+    if (node == NULL) {
+        return;
+    }
+    if (mvn_art_is_leaf(node)) {
+        mvn_art_leaf_t *leaf = (mvn_art_leaf_t *)node;
+        mvn_val_free(&leaf->value);
+        MVN_DS_FREE(leaf);
+        return;
+    }
+    mvn_art_free_node((mvn_art_node_t *)node->leaf);
+    int             byte  = -1;
+    mvn_art_node_t *child = mvn_art_child_after(node, byte, &byte);
+    while (child != NULL) {
+        mvn_art_free_node(child);
+        child = mvn_art_child_after(node, byte, &byte);
+    }
+    MVN_DS_FREE(node);
+}
+
+/**
+ * @internal
+ * @brief Returns the bytes held by a subtree's nodes and leaves.
+ */
+static size_t mvn_art_node_memory(const mvn_art_node_t *node)
+{
+    if (node == NULL) {
+        return 0;
+    }
+    if (mvn_art_is_leaf(node)) {
+        return sizeof(mvn_art_leaf_t) + ((const mvn_art_leaf_t *)node)->key_length + 1;
+    }
+    size_t total = mvn_art_node_size(node->type) +
+                   mvn_art_node_memory((const mvn_art_node_t *)node->leaf);
+    int                   byte  = -1;
+    const mvn_art_node_t *child = mvn_art_child_after(node, byte, &byte);
+    while (child != NULL) {
+        total += mvn_art_node_memory(child);
+        child = mvn_art_child_after(node, byte, &byte);
+    }
+    return total;
+}
+
+/**
+ * @internal
+ * @brief Checks key and key length before an insert.
+ */
+static bool mvn_art_key_valid(const char *key, size_t length)
+{
+    if (key == NULL) {
+        return false;
+    }
+    if (length > UINT32_MAX) {
+        fprintf(stderr, "[MVN_DS_ART] Key longer than 4 GiB.\n");
+        return false;
+    }
+    return true;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Creates a new, empty adaptive radix tree.
+ * @return A pointer to the new tree, or NULL on allocation failure.
+ */
+mvn_art_t *mvn_art_new(void)
+{
+    mvn_art_t *art = (mvn_art_t *)MVN_DS_MALLOC(sizeof(mvn_art_t));
+    if (art == NULL) {
+        fprintf(stderr, "[MVN_DS_ART] Failed to allocate tree structure.\n");
+        return NULL;
+    }
+    art->count = 0;
+    art->root  = NULL;
+    return art;
+}
+
+/**
+ * @brief Frees the tree, including all of its keys and values.
+ * @param art The tree to free. If NULL, the function does nothing.
+ */
+void mvn_art_free(mvn_art_t *art)
+{
+    if (art == NULL) {
+        return;
+    }
+    mvn_art_free_node(art->root);
+    MVN_DS_FREE(art);
+}
+
+/**
+ * @brief Sets the value for key. Walks one path from the root: splits a leaf or a compressed
+ * path where the new key leaves it, and grows a full node to the next layout.
+ * @param art The tree.
+ * @param key The key. Its bytes are copied; the string stays with the caller.
+ * @param value The value. Ownership is taken, even on failure.
+ * @return true on success, false on allocation failure or invalid input.
+ */
+bool mvn_art_put(mvn_art_t *art, const mvn_str_t *key, mvn_val_t value)
+{
+    bool added = false;
+    if (art == NULL || key == NULL || !mvn_art_key_valid(key->data, key->length) ||
+        !mvn_art_insert(&art->root, (const uint8_t *)key->data, key->length, value, &added)) {
+        mvn_val_free(&value);
+        return false;
+    }
+    art->count += added ? 1 : 0;
+    return true;
+}
+
+/**
+ * @brief Sets the value for a C string key.
+ * @param art The tree.
+ * @param key_cstr The key. Copied.
+ * @param value The value. Ownership is taken, even on failure.
+ * @return true on success, false on allocation failure or invalid input.
+ */
+bool mvn_art_put_cstr(mvn_art_t *art, const char *key_cstr, mvn_val_t value)
+{
+    bool   added  = false;
+    size_t length = key_cstr != NULL ? strlen(key_cstr) : 0;
+    if (art == NULL || !mvn_art_key_valid(key_cstr, length) ||
+        !mvn_art_insert(&art->root, (const uint8_t *)key_cstr, length, value, &added)) {
+        mvn_val_free(&value);
+        return false;
+    }
+    art->count += added ? 1 : 0;
+    return true;
+}
+
+/**
+ * @brief Looks up the value for key, comparing at most one byte per level plus the stored
+ * path bytes, and the whole key once at the leaf.
+ * @param art The tree.
+ * @param key The key.
+ * @return A pointer to the value, or NULL if the key is absent or an argument is NULL.
+ */
+mvn_val_t *mvn_art_get(const mvn_art_t *art, const mvn_str_t *key)
+{
+    if (art == NULL || key == NULL || key->data == NULL) {
+        return NULL;
+    }
+    mvn_art_leaf_t *leaf = mvn_art_search(art, (const uint8_t *)key->data, key->length);
+    return leaf != NULL ? &leaf->value : NULL;
+}
+
+/**
+ * @brief Looks up the value for a C string key.
+ * @param art The tree.
+ * @param key_cstr The key.
+ * @return A pointer to the value, or NULL if the key is absent or an argument is NULL.
+ */
+mvn_val_t *mvn_art_get_cstr(const mvn_art_t *art, const char *key_cstr)
+{
+    if (art == NULL || key_cstr == NULL) {
+        return NULL;
+    }
+    mvn_art_leaf_t *leaf = mvn_art_search(art, (const uint8_t *)key_cstr, strlen(key_cstr));
+    return leaf != NULL ? &leaf->value : NULL;
+}
+
+/**
+ * @brief Removes the entry for key. Nodes left with few children move to a smaller layout, and
+ * a node left with a single entry is merged into it.
+ * @param art The tree.
+ * @param key The key.
+ * @return true if the key was found and removed, false otherwise.
+ */
+bool mvn_art_remove(mvn_art_t *art, const mvn_str_t *key)
+{
+    if (art == NULL || key == NULL || key->data == NULL || art->root == NULL) {
+        return false;
+    }
+    mvn_art_leaf_t *leaf =
+        mvn_art_remove_from(&art->root, (const uint8_t *)key->data, key->length, 0);
+    if (leaf == NULL) {
+        return false;
+    }
+    mvn_val_free(&leaf->value);
+    MVN_DS_FREE(leaf);
+    art->count--;
+    return true;
+}
+
+/**
+ * @brief Removes the entry for a C string key.
+ * @param art The tree.
+ * @param key_cstr The key.
+ * @return true if the key was found and removed, false otherwise.
+ */
+bool mvn_art_remove_cstr(mvn_art_t *art, const char *key_cstr)
+{
+    if (key_cstr == NULL) {
+        return false;
+    }
+    size_t    length = strlen(key_cstr);
+    mvn_str_t key    = {.length = length, .capacity = length, .data = (char *)key_cstr};
+    return mvn_art_remove(art, &key);
+}
+
+/**
+ * @brief Returns the number of keys in the tree.
+ * @param art The tree.
+ * @return The number of keys, or 0 if art is NULL.
+ */
+size_t mvn_art_count(const mvn_art_t *art)
+{
+    return art != NULL ? art->count : 0;
+}
+
+/**
+ * @brief Returns the bytes held by the tree structure, its nodes and its leaves (which
+ * include the key copies). Memory owned by the values is not counted.
+ * @param art The tree.
+ * @return The byte count, or 0 if art is NULL.
+ */
+size_t mvn_art_memory_usage(const mvn_art_t *art)
+{
+    if (art == NULL) {
+        return 0;
+    }
+    return sizeof(mvn_art_t) + mvn_art_node_memory(art->root);
+}
+
+/**
+ * @brief Returns an iterator over every entry in ascending key order.
+ * @param art The tree. A NULL tree yields an exhausted iterator.
+ * @return The iterator.
+ */
+mvn_art_iter_t mvn_art_iter(const mvn_art_t *art)
+{
+    mvn_art_iter_t iter = {art, NULL, NULL, 0};
+    if (art != NULL) {
+        iter.next = mvn_art_minimum(art->root);
+    }
+    return iter;
+}
+
+/**
+ * @brief Returns an iterator over the entries whose key starts with prefix_cstr.
+ *
+ * One descent along the prefix finds the subtree holding exactly those keys; iteration starts
+ * at its smallest key and stops at the first key without the prefix.
+ *
+ * @param art The tree. A NULL tree yields an exhausted iterator.
+ * @param prefix_cstr The prefix. NULL or "" iterates over every entry. Not copied; must
+ * outlive the iterator.
+ * @return The iterator.
+ */
+mvn_art_iter_t mvn_art_prefix(const mvn_art_t *art, const char *prefix_cstr)
+{
+    mvn_art_iter_t iter = {art, NULL, NULL, 0};
+    if (art == NULL) {
+        return iter;
+    }
+    if (prefix_cstr == NULL || prefix_cstr[0] == '\0') {
+        return mvn_art_iter(art);
+    }
+    iter.prefix        = prefix_cstr;
+    iter.prefix_length = strlen(prefix_cstr);
+    iter.next          = mvn_art_minimum(
+        mvn_art_prefix_root(art, (const uint8_t *)prefix_cstr, iter.prefix_length));
+    return iter;
+}
+
+/**
+ * @brief Advances the iterator. Each step walks one path from the root to find the next key,
+ * so the iterator needs no stack of its own.
+ * @param iter The iterator.
+ * @param[out] key Receives the entry's null-terminated key. May be NULL.
+ * @param[out] value Receives a pointer to the entry's value. May be NULL.
+ * @return true if an entry was produced, false when the iterator is exhausted.
+ */
+bool mvn_art_iter_next(mvn_art_iter_t *iter, const char **key, mvn_val_t **value)
+{
+    if (iter == NULL || iter->next == NULL) {
+        return false;
+    }
+    mvn_art_leaf_t *current = (mvn_art_leaf_t *)iter->next;
+    if (key != NULL) {
+        *key = current->key;
+    }
+    if (value != NULL) {
+        *value = &current->value;
+    }
+
+    iter->next = mvn_art_successor(iter->art, current);
+    if (iter->next != NULL && iter->prefix != NULL &&
+        (iter->next->key_length < iter->prefix_length ||
+         memcmp(iter->next->key, iter->prefix, iter->prefix_length) != 0)) {
+        iter->next = NULL; // Keys with the prefix are contiguous, so none follow
+    }
+    return true;
+}
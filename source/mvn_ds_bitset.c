@@ -0,0 +1,646 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_BITSET // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_bitset.h"
+
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_REALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memcpy, memcmp, memset
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // For _BitScanForward64
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MVN_DS_BITSET_SSE2 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(__POPCNT__)
+// Built without -mpopcnt, the popcount builtin becomes a bit-twiddling sequence. Long runs of
+// words get a copy compiled for the POPCNT instruction, used when the CPU reports it.
+#define MVN_DS_BITSET_POPCNT_DISPATCH 1
+#endif
+
+#define MVN_DS_BITSET_WORD_BITS    64
+#define MVN_DS_BITSET_BLOCK_WORDS  (MVN_DS_BITSET_RANK_BLOCK_BITS / MVN_DS_BITSET_WORD_BITS)
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Returns the number of words holding size bits.
+ */
+static size_t mvn_bitset_word_count(size_t size)
+{
+    return size / MVN_DS_BITSET_WORD_BITS + (size % MVN_DS_BITSET_WORD_BITS != 0 ? 1 : 0);
+}
+
+/**
+ * @internal
+ * @brief Returns the number of set bits in a word.
+ */
+static size_t mvn_bitset_popcount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcountll(word);
+#else
+    // SWAR count; MSVC's __popcnt64 would fault on CPUs without POPCNT
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @internal
+ * @brief Returns the index of the lowest set bit of a non-zero word.
+ */
+static size_t mvn_bitset_lowest_bit(uint64_t word)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64)
+    unsigned long bit_index;
+    _BitScanForward64(&bit_index, (unsigned __int64)word);
+    return (size_t)bit_index;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit_index;
+    if ((uint32_t)word != 0) {
+        _BitScanForward(&bit_index, (unsigned long)word);
+        return (size_t)bit_index;
+    }
+    _BitScanForward(&bit_index, (unsigned long)(word >> 32));
+    return (size_t)bit_index + 32;
+#else
+    return (size_t)__builtin_ctzll((unsigned long long)word);
+#endif
+}
+
+/**
+ * @internal
+ * @brief Returns the number of set bits in count words.
+ */
+static size_t mvn_bitset_popcount_words_generic(const uint64_t *words, size_t count)
+{
+    size_t total = 0;
+    for (size_t index = 0; index < count; index++) {
+        total += mvn_bitset_popcount(words[index]);
+    }
+    return total;
+}
+
+#ifdef MVN_DS_BITSET_POPCNT_DISPATCH
+/**
+ * @internal
+ * @brief mvn_bitset_popcount_words_generic compiled for the POPCNT instruction.
+ */
+__attribute__((target("popcnt"))) static size_t
+mvn_bitset_popcount_words_popcnt(const uint64_t *words, size_t count)
+{
+    size_t total = 0;
+    for (size_t index = 0; index < count; index++) {
+        total += (size_t)__builtin_popcountll(words[index]);
+    }
+    return total;
+}
+#endif
+
+/**
+ * @internal
+ * @brief Returns the number of set bits in count words, using POPCNT when available.
+ */
+static size_t mvn_bitset_popcount_words(const uint64_t *words, size_t count)
+{
+#ifdef MVN_DS_BITSET_POPCNT_DISPATCH
+    if (count >= MVN_DS_BITSET_BLOCK_WORDS && __builtin_cpu_supports("popcnt")) {
+        return mvn_bitset_popcount_words_popcnt(words, count);
+    }
+#endif
+    return mvn_bitset_popcount_words_generic(words, count);
+}
+
+/**
+ * @internal
+ * @brief Returns the index of the set bit with rank k within a word with more than k bits set.
+ */
+static size_t mvn_bitset_select_in_word(uint64_t word, size_t k)
+{
+    for (; k > 0; k--) {
+        word &= word - 1; // Clear the lowest set bit
+    }
+    return mvn_bitset_lowest_bit(word);
+}
+
+/**
+ * @internal
+ * @brief Clears the bits past the size in the last word, restoring the invariant.
+ */
+static void mvn_bitset_clear_tail(mvn_bitset_t *bitset)
+{
+    size_t tail_bits = bitset->size % MVN_DS_BITSET_WORD_BITS;
+    if (tail_bits != 0) {
+        bitset->words[bitset->size / MVN_DS_BITSET_WORD_BITS] &= (UINT64_C(1) << tail_bits) - 1;
+    }
+}
+
+/**
+ * @internal
+ * @brief Bulk operations of mvn_bitset_combine.
+ */
+typedef enum {
+    MVN_BITSET_OP_AND,
+    MVN_BITSET_OP_OR,
+    MVN_BITSET_OP_XOR,
+    MVN_BITSET_OP_ANDNOT
+} mvn_bitset_op_t;
+
+// Applies one operation to every word; SSE2 handles two words per step
+#ifdef MVN_DS_BITSET_SSE2
+#define MVN_BITSET_COMBINE_LOOP(vector_op, scalar_expr)                                      \
+    for (; index + 2 <= word_count; index += 2) {                                            \
+        __m128i target_vector = _mm_loadu_si128((const __m128i *)(target_words + index));    \
+        __m128i other_vector  = _mm_loadu_si128((const __m128i *)(other_words + index));     \
+        _mm_storeu_si128((__m128i *)(target_words + index), vector_op);                      \
+    }                                                                                        \
+    for (; index < word_count; index++) {                                                    \
+        target_words[index] = scalar_expr;                                                   \
+    }
+#else
+#define MVN_BITSET_COMBINE_LOOP(vector_op, scalar_expr) \
+    for (; index < word_count; index++) {                \
+        target_words[index] = scalar_expr;               \
+    }
+#endif
+
+/**
+ * @internal
+ * @brief Combines other into target word by word. Both must have the same size. Zero tails
+ * stay zero under every operation, so the invariant holds without masking.
+ * @return true on success, false on invalid input or a size mismatch.
+ */
+static bool mvn_bitset_combine(mvn_bitset_t *target, const mvn_bitset_t *other, mvn_bitset_op_t op)
+{
+    if (target == NULL || other == NULL || target->size != other->size) {
+        return false;
+    }
+    uint64_t       *target_words = target->words;
+    const uint64_t *other_words  = other->words;
+    size_t          word_count   = mvn_bitset_word_count(target->size);
+    size_t          index        = 0;
+    switch (op) {
+        case MVN_BITSET_OP_AND:
+            MVN_BITSET_COMBINE_LOOP(_mm_and_si128(target_vector, other_vector),
+                                    target_words[index] & other_words[index])
+            break;
+        case MVN_BITSET_OP_OR:
+            MVN_BITSET_COMBINE_LOOP(_mm_or_si128(target_vector, other_vector),
+                                    target_words[index] | other_words[index])
+            break;
+        case MVN_BITSET_OP_XOR:
+            MVN_BITSET_COMBINE_LOOP(_mm_xor_si128(target_vector, other_vector),
+                                    target_words[index] ^ other_words[index])
+            break;
+        case MVN_BITSET_OP_ANDNOT:
+            // _mm_andnot_si128(a, b) computes ~a & b
+            MVN_BITSET_COMBINE_LOOP(_mm_andnot_si128(other_vector, target_vector),
+                                    target_words[index] & ~other_words[index])
+            break;
+    }
+    target->rank_valid = false;
+    return true;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Creates a new bitset with every bit clear.
+ * @param size The number of bits.
+ * @return A pointer to the new bitset, or NULL on allocation failure.
+ */
+mvn_bitset_t *mvn_bitset_new(size_t size)
+{
+    mvn_bitset_t *bitset = (mvn_bitset_t *)MVN_DS_MALLOC(sizeof(mvn_bitset_t));
+    if (bitset == NULL) {
+        fprintf(stderr, "[MVN_DS_BITSET] Failed to allocate bitset structure.\n");
+        return NULL;
+    }
+    bitset->size        = size;
+    bitset->words       = NULL;
+    bitset->rank_blocks = NULL;
+    bitset->rank_valid  = false;
+
+    size_t word_count = mvn_bitset_word_count(size);
+    if (word_count > 0) {
+        bitset->words = (uint64_t *)MVN_DS_CALLOC(word_count, sizeof(uint64_t));
+        if (bitset->words == NULL) {
+            fprintf(stderr, "[MVN_DS_BITSET] Failed to allocate bitset words.\n");
+            MVN_DS_FREE(bitset);
+            return NULL;
+        }
+    }
+    return bitset;
+}
+
+/**
+ * @brief Frees the bitset and its rank index.
+ * @param bitset The bitset to free. If NULL, the function does nothing.
+ */
+void mvn_bitset_free(mvn_bitset_t *bitset)
+{
+    if (bitset == NULL) {
+        return;
+    }
+    MVN_DS_FREE(bitset->words);
+    MVN_DS_FREE(bitset->rank_blocks);
+    MVN_DS_FREE(bitset);
+}
+
+/**
+ * @brief Creates a copy of the bitset. The rank index is not copied.
+ * @param bitset The bitset to copy.
+ * @return The copy, or NULL on allocation failure or if bitset is NULL.
+ */
+mvn_bitset_t *mvn_bitset_copy(const mvn_bitset_t *bitset)
+{
+    if (bitset == NULL) {
+        return NULL;
+    }
+    mvn_bitset_t *copy = mvn_bitset_new(bitset->size);
+    if (copy == NULL) {
+        return NULL;
+    }
+    if (copy->words != NULL) {
+        memcpy(copy->words, bitset->words, mvn_bitset_word_count(bitset->size) * sizeof(uint64_t));
+    }
+    return copy;
+}
+
+/**
+ * @brief Changes the number of bits. Added bits are clear; removed bits are discarded.
+ * @param bitset The bitset. Must not be NULL.
+ * @param size The new number of bits.
+ * @return true on success, false on allocation failure or invalid input (unchanged).
+ */
+bool mvn_bitset_resize(mvn_bitset_t *bitset, size_t size)
+{
+    if (bitset == NULL) {
+        return false;
+    }
+    size_t old_word_count = mvn_bitset_word_count(bitset->size);
+    size_t new_word_count = mvn_bitset_word_count(size);
+    if (new_word_count == 0) {
+        MVN_DS_FREE(bitset->words);
+        bitset->words = NULL;
+    } else if (new_word_count != old_word_count) {
+        if (new_word_count > SIZE_MAX / sizeof(uint64_t)) {
+            return false;
+        }
+        uint64_t *new_words =
+            (uint64_t *)MVN_DS_REALLOC(bitset->words, new_word_count * sizeof(uint64_t));
+        if (new_words == NULL) {
+            fprintf(stderr, "[MVN_DS_BITSET] Bitset resize failed - out of memory.\n");
+            return false;
+        }
+        if (new_word_count > old_word_count) {
+            memset(new_words + old_word_count,
+                   0,
+                   (new_word_count - old_word_count) * sizeof(uint64_t));
+        }
+        bitset->words = new_words;
+    }
+    bitset->size = size;
+    if (bitset->words != NULL) {
+        mvn_bitset_clear_tail(bitset); // Drops bits removed from the last word
+    }
+    bitset->rank_valid = false;
+    return true;
+}
+
+/**
+ * @brief Returns the number of bits.
+ * @param bitset The bitset.
+ * @return The number of bits, or 0 if bitset is NULL.
+ */
+size_t mvn_bitset_size(const mvn_bitset_t *bitset)
+{
+    return bitset != NULL ? bitset->size : 0;
+}
+
+/**
+ * @brief Returns whether a bit is set.
+ * @param bitset The bitset.
+ * @param index The bit index.
+ * @return true if the bit is set, false if it is clear, out of range or bitset is NULL.
+ */
+bool mvn_bitset_test(const mvn_bitset_t *bitset, size_t index)
+{
+    if (bitset == NULL || index >= bitset->size) {
+        return false;
+    }
+    return (bitset->words[index / MVN_DS_BITSET_WORD_BITS] >> (index % MVN_DS_BITSET_WORD_BITS)) &
+           1U;
+}
+
+/**
+ * @brief Sets a bit to the given value.
+ * @param bitset The bitset.
+ * @param index The bit index.
+ * @param value The new value of the bit.
+ * @return true on success, false if index is out of range or bitset is NULL.
+ */
+bool mvn_bitset_assign(mvn_bitset_t *bitset, size_t index, bool value)
+{
+    return value ? mvn_bitset_set(bitset, index) : mvn_bitset_reset(bitset, index);
+}
+
+/**
+ * @brief Sets a bit to 1.
+ * @param bitset The bitset.
+ * @param index The bit index.
+ * @return true on success, false if index is out of range or bitset is NULL.
+ */
+bool mvn_bitset_set(mvn_bitset_t *bitset, size_t index)
+{
+    if (bitset == NULL || index >= bitset->size) {
+        return false;
+    }
+    bitset->words[index / MVN_DS_BITSET_WORD_BITS] |= UINT64_C(1)
+                                                      << (index % MVN_DS_BITSET_WORD_BITS);
+    bitset->rank_valid = false;
+    return true;
+}
+
+/**
+ * @brief Sets a bit to 0.
+ * @param bitset The bitset.
+ * @param index The bit index.
+ * @return true on success, false if index is out of range or bitset is NULL.
+ */
+bool mvn_bitset_reset(mvn_bitset_t *bitset, size_t index)
+{
+    if (bitset == NULL || index >= bitset->size) {
+        return false;
+    }
+    bitset->words[index / MVN_DS_BITSET_WORD_BITS] &= ~(UINT64_C(1)
+                                                        << (index % MVN_DS_BITSET_WORD_BITS));
+    bitset->rank_valid = false;
+    return true;
+}
+
+/**
+ * @brief Inverts a bit.
+ * @param bitset The bitset.
+ * @param index The bit index.
+ * @return true on success, false if index is out of range or bitset is NULL.
+ */
+bool mvn_bitset_flip(mvn_bitset_t *bitset, size_t index)
+{
+    if (bitset == NULL || index >= bitset->size) {
+        return false;
+    }
+    bitset->words[index / MVN_DS_BITSET_WORD_BITS] ^= UINT64_C(1)
+                                                      << (index % MVN_DS_BITSET_WORD_BITS);
+    bitset->rank_valid = false;
+    return true;
+}
+
+/**
+ * @brief Sets every bit to the given value.
+ * @param bitset The bitset. If NULL, the function does nothing.
+ * @param value The new value of every bit.
+ */
+void mvn_bitset_fill(mvn_bitset_t *bitset, bool value)
+{
+    if (bitset == NULL || bitset->words == NULL) {
+        return;
+    }
+    memset(bitset->words, value ? 0xFF : 0, mvn_bitset_word_count(bitset->size) * sizeof(uint64_t));
+    mvn_bitset_clear_tail(bitset);
+    bitset->rank_valid = false;
+}
+
+/**
+ * @brief Counts the set bits.
+ * @param bitset The bitset.
+ * @return The number of set bits, or 0 if bitset is NULL.
+ */
+size_t mvn_bitset_count(const mvn_bitset_t *bitset)
+{
+    if (bitset == NULL) {
+        return 0;
+    }
+    return mvn_bitset_popcount_words(bitset->words, mvn_bitset_word_count(bitset->size));
+}
+
+/**
+ * @brief Finds the first set bit at or after a position, a word at a time.
+ * @param bitset The bitset.
+ * @param from The first index to consider.
+ * @return The index of the bit, or MVN_DS_BITSET_NPOS if there is none.
+ */
+size_t mvn_bitset_find_first_set(const mvn_bitset_t *bitset, size_t from)
+{
+    if (bitset == NULL || from >= bitset->size) {
+        return MVN_DS_BITSET_NPOS;
+    }
+    size_t   word_count = mvn_bitset_word_count(bitset->size);
+    size_t   word_index = from / MVN_DS_BITSET_WORD_BITS;
+    uint64_t word = bitset->words[word_index] & (~UINT64_C(0) << (from % MVN_DS_BITSET_WORD_BITS));
+    while (word == 0) {
+        if (++word_index == word_count) {
+            return MVN_DS_BITSET_NPOS;
+        }
+        word = bitset->words[word_index];
+    }
+    return word_index * MVN_DS_BITSET_WORD_BITS + mvn_bitset_lowest_bit(word);
+}
+
+/**
+ * @brief Finds the first clear bit at or after a position, a word at a time.
+ * @param bitset The bitset.
+ * @param from The first index to consider.
+ * @return The index of the bit, or MVN_DS_BITSET_NPOS if there is none.
+ */
+size_t mvn_bitset_find_first_unset(const mvn_bitset_t *bitset, size_t from)
+{
+    if (bitset == NULL || from >= bitset->size) {
+        return MVN_DS_BITSET_NPOS;
+    }
+    size_t   word_count = mvn_bitset_word_count(bitset->size);
+    size_t   word_index = from / MVN_DS_BITSET_WORD_BITS;
+    uint64_t word = ~bitset->words[word_index] & (~UINT64_C(0) << (from % MVN_DS_BITSET_WORD_BITS));
+    while (word == 0) {
+        if (++word_index == word_count) {
+            return MVN_DS_BITSET_NPOS;
+        }
+        word = ~bitset->words[word_index];
+    }
+    // The zero tail of the last word reads as clear bits past the size
+    size_t index = word_index * MVN_DS_BITSET_WORD_BITS + mvn_bitset_lowest_bit(word);
+    return index < bitset->size ? index : MVN_DS_BITSET_NPOS;
+}
+
+/**
+ * @brief Checks if two bitsets have the same size and bits.
+ * @param bitset_one The first bitset.
+ * @param bitset_two The second bitset.
+ * @return true if both are equal or both are NULL, false otherwise.
+ */
+bool mvn_bitset_equal(const mvn_bitset_t *bitset_one, const mvn_bitset_t *bitset_two)
+{
+    if (bitset_one == bitset_two) {
+        return true;
+    }
+    if (bitset_one == NULL || bitset_two == NULL || bitset_one->size != bitset_two->size) {
+        return false;
+    }
+    size_t word_count = mvn_bitset_word_count(bitset_one->size);
+    return word_count == 0 ||
+           memcmp(bitset_one->words, bitset_two->words, word_count * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief target &= other.
+ * @return true on success, false if either is NULL or the sizes differ.
+ */
+bool mvn_bitset_and(mvn_bitset_t *target, const mvn_bitset_t *other)
+{
+    return mvn_bitset_combine(target, other, MVN_BITSET_OP_AND);
+}
+
+/**
+ * @brief target |= other.
+ * @return true on success, false if either is NULL or the sizes differ.
+ */
+bool mvn_bitset_or(mvn_bitset_t *target, const mvn_bitset_t *other)
+{
+    return mvn_bitset_combine(target, other, MVN_BITSET_OP_OR);
+}
+
+/**
+ * @brief target ^= other.
+ * @return true on success, false if either is NULL or the sizes differ.
+ */
+bool mvn_bitset_xor(mvn_bitset_t *target, const mvn_bitset_t *other)
+{
+    return mvn_bitset_combine(target, other, MVN_BITSET_OP_XOR);
+}
+
+/**
+ * @brief target &= ~other: clears in target every bit set in other.
+ * @return true on success, false if either is NULL or the sizes differ.
+ */
+bool mvn_bitset_andnot(mvn_bitset_t *target, const mvn_bitset_t *other)
+{
+    return mvn_bitset_combine(target, other, MVN_BITSET_OP_ANDNOT);
+}
+
+/**
+ * @brief Builds the rank index: the number of set bits before every 512-bit block, plus one
+ * entry for the end. Costs one pass over the words and 1/64 of their memory.
+ * @param bitset The bitset.
+ * @return true on success, false on allocation failure or if bitset is NULL.
+ */
+bool mvn_bitset_build_rank_index(mvn_bitset_t *bitset)
+{
+    if (bitset == NULL) {
+        return false;
+    }
+    size_t word_count  = mvn_bitset_word_count(bitset->size);
+    size_t block_count = word_count / MVN_DS_BITSET_BLOCK_WORDS + 1;
+    size_t *blocks =
+        (size_t *)MVN_DS_REALLOC(bitset->rank_blocks, block_count * sizeof(size_t));
+    if (blocks == NULL) {
+        fprintf(stderr, "[MVN_DS_BITSET] Rank index allocation failed - out of memory.\n");
+        return false;
+    }
+    bitset->rank_blocks = blocks;
+
+    size_t total = 0;
+    for (size_t block = 0; block < block_count; block++) {
+        blocks[block]   = total;
+        size_t first    = block * MVN_DS_BITSET_BLOCK_WORDS;
+        size_t in_block = word_count - first < MVN_DS_BITSET_BLOCK_WORDS
+                              ? word_count - first
+                              : MVN_DS_BITSET_BLOCK_WORDS;
+        total += mvn_bitset_popcount_words(bitset->words + first, in_block);
+    }
+    bitset->rank_valid = true;
+    return true;
+}
+
+/**
+ * @brief Counts the set bits before a position.
+ * @param bitset The bitset.
+ * @param index The position; values past the size count the whole bitset.
+ * @return The number of set bits in [0, index), or 0 if bitset is NULL.
+ */
+size_t mvn_bitset_rank(const mvn_bitset_t *bitset, size_t index)
+{
+    if (bitset == NULL || bitset->words == NULL) {
+        return 0;
+    }
+    if (index > bitset->size) {
+        index = bitset->size;
+    }
+    size_t word_index = index / MVN_DS_BITSET_WORD_BITS;
+    size_t first_word = 0;
+    size_t total      = 0;
+    if (bitset->rank_valid) {
+        size_t block = word_index / MVN_DS_BITSET_BLOCK_WORDS;
+        first_word   = block * MVN_DS_BITSET_BLOCK_WORDS;
+        total        = bitset->rank_blocks[block];
+    }
+    total += mvn_bitset_popcount_words(bitset->words + first_word, word_index - first_word);
+    size_t bit = index % MVN_DS_BITSET_WORD_BITS;
+    if (bit != 0) {
+        total += mvn_bitset_popcount(bitset->words[word_index] & ((UINT64_C(1) << bit) - 1));
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the set bit with a given rank.
+ * @param bitset The bitset.
+ * @param k The rank: 0 for the first set bit, 1 for the second, and so on.
+ * @return The index of the bit, or MVN_DS_BITSET_NPOS if fewer than k + 1 bits are set.
+ */
+size_t mvn_bitset_select(const mvn_bitset_t *bitset, size_t k)
+{
+    if (bitset == NULL) {
+        return MVN_DS_BITSET_NPOS;
+    }
+    size_t word_count = mvn_bitset_word_count(bitset->size);
+    size_t word_index = 0;
+    if (bitset->rank_valid) {
+        // Last block with at most k set bits before it; the bit is in that block or later
+        size_t low  = 0;
+        size_t high = word_count / MVN_DS_BITSET_BLOCK_WORDS + 1;
+        while (high - low > 1) {
+            size_t mid = low + (high - low) / 2;
+            if (bitset->rank_blocks[mid] <= k) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        word_index = low * MVN_DS_BITSET_BLOCK_WORDS;
+        k -= bitset->rank_blocks[low];
+    }
+    for (; word_index < word_count; word_index++) {
+        size_t count = mvn_bitset_popcount(bitset->words[word_index]);
+        if (k < count) {
+            return word_index * MVN_DS_BITSET_WORD_BITS +
+                   mvn_bitset_select_in_word(bitset->words[word_index], k);
+        }
+        k -= count;
+    }
+    return MVN_DS_BITSET_NPOS;
+}
@@ -0,0 +1,848 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_BTREE // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_btree.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_compare, mvn_val_deep_copy, mvn_val_free
+#include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_free
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memmove, strlen
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Allocates an empty node aligned to MVN_DS_BTREE_NODE_ALIGNMENT.
+ * @param leaf Whether the node is a leaf.
+ * @return The node, or NULL on allocation failure.
+ */
+static mvn_btree_node_t *mvn_btree_node_new(bool leaf)
+{
+    void *allocation = MVN_DS_MALLOC(sizeof(mvn_btree_node_t) + MVN_DS_BTREE_NODE_ALIGNMENT - 1);
+    if (allocation == NULL) {
+        fprintf(stderr, "[MVN_DS_BTREE] Node allocation failed - out of memory.\n");
+        return NULL;
+    }
+    uintptr_t address = ((uintptr_t)allocation + MVN_DS_BTREE_NODE_ALIGNMENT - 1) &
+                        ~(uintptr_t)(MVN_DS_BTREE_NODE_ALIGNMENT - 1);
+    mvn_btree_node_t *node = (mvn_btree_node_t *)address;
+    node->next             = NULL;
+    node->allocation       = allocation;
+    node->count            = 0;
+    node->leaf             = leaf;
+    return node;
+}
+
+/**
+ * @internal
+ * @brief Frees a node's memory only. Keys, values and children are not touched.
+ */
+static void mvn_btree_node_free(mvn_btree_node_t *node)
+{
+    if (node != NULL) {
+        MVN_DS_FREE(node->allocation);
+    }
+}
+
+/**
+ * @internal
+ * @brief Frees a subtree. Separator keys are always freed.
+ * @param node The subtree root, may be NULL.
+ * @param free_entries Whether to free the leaf keys and values too. Bulk loading passes false
+ * on failure, since the entries still belong to the caller's arrays.
+ */
+static void mvn_btree_free_subtree(mvn_btree_node_t *node, bool free_entries)
+{
+    if (node == NULL) {
+        return;
+    }
+    if (node->leaf) {
+        for (size_t index = 0; free_entries && index < node->count; index++) {
+            mvn_val_free(&node->keys[index]);
+            mvn_val_free(&node->values[index]);
+        }
+    } else {
+        for (size_t index = 0; index < node->count; index++) {
+            mvn_val_free(&node->keys[index]);
+        }
+        for (size_t index = 0; index <= node->count; index++) {
+            mvn_btree_free_subtree(node->children[index], free_entries);
+        }
+    }
+    mvn_btree_node_free(node);
+}
+
+/**
+ * @internal
+ * @brief Wraps a C string in a borrowed string value without allocating.
+ * @param key_cstr The characters. Must outlive the returned value.
+ * @param storage Caller-provided string header the value points to.
+ */
+static mvn_val_t mvn_btree_cstr_key(const char *key_cstr, mvn_str_t *storage)
+{
+    storage->length   = strlen(key_cstr);
+    storage->capacity = storage->length;
+    storage->data     = (char *)key_cstr; // Only read through the returned value
+    return (mvn_val_t){.type = MVN_VAL_STRING, .str = storage};
+}
+
+/**
+ * @internal
+ * @brief Returns the index of the first key in node that is not less than key.
+ */
+static size_t mvn_btree_lower_bound(const mvn_btree_node_t *node, const mvn_val_t *key)
+{
+    size_t low  = 0;
+    size_t high = node->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (mvn_val_compare(&node->keys[mid], key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @internal
+ * @brief Returns the index of the child of an inner node whose range holds key. A separator
+ * is the smallest key of the subtree to its right, so keys equal to it go right.
+ */
+static size_t mvn_btree_child_index(const mvn_btree_node_t *node, const mvn_val_t *key)
+{
+    size_t low  = 0;
+    size_t high = node->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (mvn_val_compare(&node->keys[mid], key) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @internal
+ * @brief Descends from the root to the leaf whose range holds key.
+ * @return The leaf, or NULL for an empty tree.
+ */
+static mvn_btree_node_t *mvn_btree_find_leaf(const mvn_btree_t *btree, const mvn_val_t *key)
+{
+    mvn_btree_node_t *node = btree->root;
+    while (node != NULL && !node->leaf) {
+        node = node->children[mvn_btree_child_index(node, key)];
+    }
+    return node;
+}
+
+/**
+ * @internal
+ * @brief Returns the smallest key of a subtree.
+ */
+static const mvn_val_t *mvn_btree_min_key(const mvn_btree_node_t *node)
+{
+    while (!node->leaf) {
+        node = node->children[0];
+    }
+    return &node->keys[0];
+}
+
+/**
+ * @internal
+ * @brief Makes an owned copy of a key for use as a separator.
+ * @return true on success, false on allocation failure.
+ */
+static bool mvn_btree_copy_key(const mvn_val_t *key, mvn_val_t *copy)
+{
+    *copy = mvn_val_deep_copy(key);
+    if (copy->type != key->type) {
+        fprintf(stderr, "[MVN_DS_BTREE] Separator key copy failed - out of memory.\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Splits the full child at index of a non-full inner node in two, and inserts the
+ * separator of the halves into the parent.
+ * @return true on success, false on allocation failure (the tree is unchanged).
+ */
+static bool mvn_btree_split_child(mvn_btree_node_t *parent, size_t index)
+{
+    mvn_btree_node_t *child = parent->children[index];
+    mvn_btree_node_t *right = mvn_btree_node_new(child->leaf);
+    if (right == NULL) {
+        return false;
+    }
+
+    size_t    mid = MVN_DS_BTREE_MAX_KEYS / 2;
+    mvn_val_t separator;
+    if (child->leaf) {
+        // Leaves keep every key, so the separator is a copy of the right half's first key
+        if (!mvn_btree_copy_key(&child->keys[mid], &separator)) {
+            mvn_btree_node_free(right);
+            return false;
+        }
+        right->count = (uint32_t)(child->count - mid);
+        memcpy(right->keys, &child->keys[mid], right->count * sizeof(mvn_val_t));
+        memcpy(right->values, &child->values[mid], right->count * sizeof(mvn_val_t));
+        right->next = child->next;
+        child->next = right;
+    } else {
+        // The middle key moves up; the right half takes the keys and children after it
+        separator    = child->keys[mid];
+        right->count = (uint32_t)(child->count - mid - 1);
+        memcpy(right->keys, &child->keys[mid + 1], right->count * sizeof(mvn_val_t));
+        memcpy(right->children,
+               &child->children[mid + 1],
+               (right->count + 1) * sizeof(mvn_btree_node_t *));
+    }
+    child->count = (uint32_t)mid;
+
+    memmove(&parent->keys[index + 1],
+            &parent->keys[index],
+            (parent->count - index) * sizeof(mvn_val_t));
+    memmove(&parent->children[index + 2],
+            &parent->children[index + 1],
+            (parent->count - index) * sizeof(mvn_btree_node_t *));
+    parent->keys[index]         = separator;
+    parent->children[index + 1] = right;
+    parent->count++;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Moves the last entry of the left sibling into the underfull child at index.
+ * @return true on success, false if a leaf separator could not be copied (nothing moved).
+ */
+static bool mvn_btree_borrow_left(mvn_btree_node_t *parent, size_t index)
+{
+    mvn_btree_node_t *child = parent->children[index];
+    mvn_btree_node_t *left  = parent->children[index - 1];
+    size_t            last  = left->count - 1;
+
+    mvn_val_t separator;
+    if (child->leaf && !mvn_btree_copy_key(&left->keys[last], &separator)) {
+        return false;
+    }
+    memmove(&child->keys[1], &child->keys[0], child->count * sizeof(mvn_val_t));
+    if (child->leaf) {
+        memmove(&child->values[1], &child->values[0], child->count * sizeof(mvn_val_t));
+        child->keys[0]   = left->keys[last];
+        child->values[0] = left->values[last];
+        mvn_val_free(&parent->keys[index - 1]);
+        parent->keys[index - 1] = separator;
+    } else {
+        // Rotate through the parent: its separator comes down, the left's last key goes up
+        memmove(&child->children[1],
+                &child->children[0],
+                (child->count + 1) * sizeof(mvn_btree_node_t *));
+        child->keys[0]          = parent->keys[index - 1];
+        child->children[0]      = left->children[last + 1];
+        parent->keys[index - 1] = left->keys[last];
+    }
+    child->count++;
+    left->count--;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Moves the first entry of the right sibling into the underfull child at index.
+ * @return true on success, false if a leaf separator could not be copied (nothing moved).
+ */
+static bool mvn_btree_borrow_right(mvn_btree_node_t *parent, size_t index)
+{
+    mvn_btree_node_t *child = parent->children[index];
+    mvn_btree_node_t *right = parent->children[index + 1];
+
+    if (child->leaf) {
+        // The right sibling's second key becomes its first, and so the new separator
+        mvn_val_t separator;
+        if (!mvn_btree_copy_key(&right->keys[1], &separator)) {
+            return false;
+        }
+        child->keys[child->count]   = right->keys[0];
+        child->values[child->count] = right->values[0];
+        memmove(&right->keys[0], &right->keys[1], (right->count - 1) * sizeof(mvn_val_t));
+        memmove(&right->values[0], &right->values[1], (right->count - 1) * sizeof(mvn_val_t));
+        mvn_val_free(&parent->keys[index]);
+        parent->keys[index] = separator;
+    } else {
+        child->keys[child->count]         = parent->keys[index];
+        child->children[child->count + 1] = right->children[0];
+        parent->keys[index]               = right->keys[0];
+        memmove(&right->keys[0], &right->keys[1], (right->count - 1) * sizeof(mvn_val_t));
+        memmove(&right->children[0],
+                &right->children[1],
+                right->count * sizeof(mvn_btree_node_t *));
+    }
+    child->count++;
+    right->count--;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Merges the child at index + 1 into the child at index and drops their separator
+ * from the parent. The two children must fit in one node.
+ */
+static void mvn_btree_merge(mvn_btree_node_t *parent, size_t index)
+{
+    mvn_btree_node_t *left  = parent->children[index];
+    mvn_btree_node_t *right = parent->children[index + 1];
+
+    if (left->leaf) {
+        memcpy(&left->keys[left->count], right->keys, right->count * sizeof(mvn_val_t));
+        memcpy(&left->values[left->count], right->values, right->count * sizeof(mvn_val_t));
+        left->count += right->count;
+        left->next = right->next;
+        mvn_val_free(&parent->keys[index]);
+    } else {
+        // The separator comes down between the two halves
+        left->keys[left->count] = parent->keys[index];
+        memcpy(&left->keys[left->count + 1], right->keys, right->count * sizeof(mvn_val_t));
+        memcpy(&left->children[left->count + 1],
+               right->children,
+               (right->count + 1) * sizeof(mvn_btree_node_t *));
+        left->count += right->count + 1;
+    }
+    mvn_btree_node_free(right);
+
+    memmove(&parent->keys[index],
+            &parent->keys[index + 1],
+            (parent->count - index - 1) * sizeof(mvn_val_t));
+    memmove(&parent->children[index + 1],
+            &parent->children[index + 2],
+            (parent->count - index - 1) * sizeof(mvn_btree_node_t *));
+    parent->count--;
+}
+
+/**
+ * @internal
+ * @brief Restores the minimum fill of the underfull child at index by borrowing from a
+ * sibling, or merging with one if neither can spare an entry.
+ *
+ * If a leaf separator cannot be copied the child is left underfull. Lookups and iteration do
+ * not depend on the minimum fill, so the tree stays correct, only less dense.
+ */
+static void mvn_btree_rebalance(mvn_btree_node_t *parent, size_t index)
+{
+    mvn_btree_node_t *left  = index > 0 ? parent->children[index - 1] : NULL;
+    mvn_btree_node_t *right = index < parent->count ? parent->children[index + 1] : NULL;
+
+    if (left != NULL && left->count > MVN_DS_BTREE_MIN_KEYS) {
+        mvn_btree_borrow_left(parent, index);
+    } else if (right != NULL && right->count > MVN_DS_BTREE_MIN_KEYS) {
+        mvn_btree_borrow_right(parent, index);
+    } else if (left != NULL) {
+        mvn_btree_merge(parent, index - 1);
+    } else if (right != NULL) {
+        mvn_btree_merge(parent, index);
+    }
+}
+
+/**
+ * @internal
+ * @brief Removes key from a subtree, rebalancing underfull children on the way back up.
+ * @return true if the key was found and removed.
+ */
+static bool mvn_btree_remove_from(mvn_btree_node_t *node, const mvn_val_t *key)
+{
+    if (node->leaf) {
+        size_t index = mvn_btree_lower_bound(node, key);
+        if (index >= node->count || mvn_val_compare(&node->keys[index], key) != 0) {
+            return false;
+        }
+        mvn_val_free(&node->keys[index]);
+        mvn_val_free(&node->values[index]);
+        memmove(&node->keys[index],
+                &node->keys[index + 1],
+                (node->count - index - 1) * sizeof(mvn_val_t));
+        memmove(&node->values[index],
+                &node->values[index + 1],
+                (node->count - index - 1) * sizeof(mvn_val_t));
+        node->count--;
+        return true;
+    }
+
+    size_t index = mvn_btree_child_index(node, key);
+    if (!mvn_btree_remove_from(node->children[index], key)) {
+        return false;
+    }
+    if (node->children[index]->count < MVN_DS_BTREE_MIN_KEYS) {
+        mvn_btree_rebalance(node, index);
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Builds one level of inner nodes over the given nodes, spreading them evenly.
+ * @param nodes The level's nodes in key order; replaced by the new level on success.
+ * @param[in,out] count The number of nodes; set to the new level's count.
+ * @return true on success. On allocation failure every node is freed with its separators, but
+ * leaf entries are not.
+ */
+static bool mvn_btree_build_level(mvn_btree_node_t **nodes, size_t *count)
+{
+    size_t level_count  = *count;
+    size_t parent_count = (level_count + MVN_DS_BTREE_MAX_KEYS) / (MVN_DS_BTREE_MAX_KEYS + 1);
+    size_t consumed     = 0;
+
+    for (size_t parent_index = 0; parent_index < parent_count; parent_index++) {
+        size_t children = level_count / parent_count +
+                          (parent_index < level_count % parent_count ? 1 : 0);
+        mvn_btree_node_t *parent = mvn_btree_node_new(false);
+        if (parent == NULL) {
+            for (size_t index = 0; index < parent_index; index++) {
+                mvn_btree_free_subtree(nodes[index], false);
+            }
+            for (size_t index = consumed; index < level_count; index++) {
+                mvn_btree_free_subtree(nodes[index], false);
+            }
+            return false;
+        }
+
+        parent->children[0] = nodes[consumed++];
+        for (size_t child = 1; child < children; child++) {
+            mvn_btree_node_t *node = nodes[consumed];
+            if (!mvn_btree_copy_key(mvn_btree_min_key(node), &parent->keys[child - 1])) {
+                // Free the built parents, this partial one and the nodes not yet attached
+                for (size_t index = 0; index < parent_index; index++) {
+                    mvn_btree_free_subtree(nodes[index], false);
+                }
+                mvn_btree_free_subtree(parent, false);
+                for (size_t index = consumed; index < level_count; index++) {
+                    mvn_btree_free_subtree(nodes[index], false);
+                }
+                return false;
+            }
+            parent->children[child] = node;
+            parent->count++;
+            consumed++;
+        }
+        nodes[parent_index] = parent; // Never overwrites a node not yet consumed
+    }
+
+    *count = parent_count;
+    return true;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Creates a new, empty B+tree.
+ * @return A pointer to the new tree, or NULL on allocation failure.
+ */
+mvn_btree_t *mvn_btree_new(void)
+{
+    mvn_btree_t *btree = (mvn_btree_t *)MVN_DS_MALLOC(sizeof(mvn_btree_t));
+    if (btree == NULL) {
+        fprintf(stderr, "[MVN_DS_BTREE] Failed to allocate B+tree structure.\n");
+        return NULL;
+    }
+    btree->count  = 0;
+    btree->height = 0;
+    btree->root   = NULL;
+    btree->first  = NULL;
+    return btree;
+}
+
+/**
+ * @brief Frees the B+tree, including all of its keys and values.
+ * @param btree The tree to free. If NULL, the function does nothing.
+ */
+void mvn_btree_free(mvn_btree_t *btree)
+{
+    if (btree == NULL) {
+        return;
+    }
+    mvn_btree_free_subtree(btree->root, true);
+    MVN_DS_FREE(btree);
+}
+
+/**
+ * @brief Builds a B+tree bottom-up from sorted keys and their values.
+ *
+ * Entries are spread evenly over the fewest leaves that hold them, and each inner level over
+ * the fewest nodes that hold the level below, so every node but the root is at least half
+ * full and no key is compared more than once.
+ *
+ * @param keys Keys in strictly ascending order (mvn_val_compare). Consumed on success.
+ * @param values The value for each key. Consumed on success.
+ * @return The new tree, or NULL if the input is invalid or on allocation failure (the arrays
+ *         are untouched in that case).
+ */
+mvn_btree_t *mvn_btree_bulk_load(mvn_arr_t *keys, mvn_arr_t *values)
+{
+    if (keys == NULL || values == NULL || keys == values || keys->count != values->count) {
+        return NULL;
+    }
+    for (size_t index = 1; index < keys->count; index++) {
+        if (mvn_val_compare(&keys->data[index - 1], &keys->data[index]) >= 0) {
+            return NULL; // Not strictly ascending
+        }
+    }
+
+    mvn_btree_t *btree = mvn_btree_new();
+    if (btree == NULL) {
+        return NULL;
+    }
+
+    size_t entry_count = keys->count;
+    if (entry_count > 0) {
+        size_t leaf_count = (entry_count + MVN_DS_BTREE_MAX_KEYS - 1) / MVN_DS_BTREE_MAX_KEYS;
+        mvn_btree_node_t **nodes =
+            (mvn_btree_node_t **)MVN_DS_MALLOC(leaf_count * sizeof(mvn_btree_node_t *));
+        if (nodes == NULL) {
+            fprintf(stderr, "[MVN_DS_BTREE] Bulk load failed - out of memory.\n");
+            MVN_DS_FREE(btree);
+            return NULL;
+        }
+
+        size_t            position = 0;
+        mvn_btree_node_t *previous = NULL;
+        for (size_t leaf_index = 0; leaf_index < leaf_count; leaf_index++) {
+            mvn_btree_node_t *leaf = mvn_btree_node_new(true);
+            if (leaf == NULL) {
+                for (size_t index = 0; index < leaf_index; index++) {
+                    mvn_btree_node_free(nodes[index]);
+                }
+                MVN_DS_FREE(nodes);
+                MVN_DS_FREE(btree);
+                return NULL;
+            }
+            size_t entries = entry_count / leaf_count +
+                             (leaf_index < entry_count % leaf_count ? 1 : 0);
+            memcpy(leaf->keys, &keys->data[position], entries * sizeof(mvn_val_t));
+            memcpy(leaf->values, &values->data[position], entries * sizeof(mvn_val_t));
+            leaf->count = (uint32_t)entries;
+            position += entries;
+            if (previous != NULL) {
+                previous->next = leaf;
+            } else {
+                btree->first = leaf;
+            }
+            previous          = leaf;
+            nodes[leaf_index] = leaf;
+        }
+
+        size_t level_count = leaf_count;
+        btree->height      = 1;
+        while (level_count > 1) {
+            if (!mvn_btree_build_level(nodes, &level_count)) {
+                MVN_DS_FREE(nodes);
+                MVN_DS_FREE(btree);
+                return NULL;
+            }
+            btree->height++;
+        }
+        btree->root  = nodes[0];
+        btree->count = entry_count;
+        MVN_DS_FREE(nodes);
+    }
+
+    // The entries now belong to the tree; free the arrays without them
+    keys->count   = 0;
+    values->count = 0;
+    mvn_arr_free(keys);
+    mvn_arr_free(values);
+    return btree;
+}
+
+/**
+ * @internal
+ * @brief Descends to the leaf for key, splitting full nodes on the way down so the leaf
+ * always has room, and stores the entry there.
+ * @return true on success, false on allocation failure. The tree is valid either way, and
+ * key and value are still owned by the caller on failure.
+ */
+static bool mvn_btree_insert(mvn_btree_t *btree, mvn_val_t *key, mvn_val_t *value)
+{
+    if (btree->root == NULL) {
+        mvn_btree_node_t *leaf = mvn_btree_node_new(true);
+        if (leaf == NULL) {
+            return false;
+        }
+        btree->root   = leaf;
+        btree->first  = leaf;
+        btree->height = 1;
+    }
+
+    if (btree->root->count == MVN_DS_BTREE_MAX_KEYS) {
+        mvn_btree_node_t *root = mvn_btree_node_new(false);
+        if (root == NULL) {
+            return false;
+        }
+        root->children[0] = btree->root;
+        if (!mvn_btree_split_child(root, 0)) {
+            mvn_btree_node_free(root);
+            return false;
+        }
+        btree->root = root;
+        btree->height++;
+    }
+
+    mvn_btree_node_t *node = btree->root;
+    while (!node->leaf) {
+        size_t index = mvn_btree_child_index(node, key);
+        if (node->children[index]->count == MVN_DS_BTREE_MAX_KEYS) {
+            if (!mvn_btree_split_child(node, index)) {
+                return false;
+            }
+            if (mvn_val_compare(key, &node->keys[index]) >= 0) {
+                index++;
+            }
+        }
+        node = node->children[index];
+    }
+
+    size_t index = mvn_btree_lower_bound(node, key);
+    if (index < node->count && mvn_val_compare(&node->keys[index], key) == 0) {
+        mvn_val_free(&node->values[index]);
+        node->values[index] = *value;
+        mvn_val_free(key);
+        return true;
+    }
+    memmove(&node->keys[index + 1], &node->keys[index], (node->count - index) * sizeof(mvn_val_t));
+    memmove(&node->values[index + 1],
+            &node->values[index],
+            (node->count - index) * sizeof(mvn_val_t));
+    node->keys[index]   = *key;
+    node->values[index] = *value;
+    node->count++;
+    btree->count++;
+    return true;
+}
+
+/**
+ * @brief Sets the value for a key. Full nodes are split on the way down, so an allocation
+ * failure part way leaves a valid tree behind.
+ * @param btree The tree. Must not be NULL.
+ * @param key The key. Ownership is transferred; freed if the key was already present.
+ * @param value The value. Ownership is transferred; replaces (and frees) any previous value.
+ * @return true on success, false on allocation failure or invalid input (key and value are
+ *         freed in that case).
+ */
+bool mvn_btree_put(mvn_btree_t *btree, mvn_val_t key, mvn_val_t value)
+{
+    if (btree == NULL || !mvn_btree_insert(btree, &key, &value)) {
+        mvn_val_free(&key);
+        mvn_val_free(&value);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Sets the value for a string key copied from a C string.
+ * @param btree The tree. Must not be NULL.
+ * @param key_cstr The key. Must not be NULL.
+ * @param value The value. Ownership is transferred.
+ * @return true on success, false on allocation failure or invalid input (value is freed).
+ */
+bool mvn_btree_put_cstr(mvn_btree_t *btree, const char *key_cstr, mvn_val_t value)
+{
+    if (btree == NULL || key_cstr == NULL) {
+        mvn_val_free(&value);
+        return false;
+    }
+    mvn_val_t key = mvn_val_str(key_cstr);
+    if (key.type != MVN_VAL_STRING) {
+        mvn_val_free(&value);
+        return false;
+    }
+    return mvn_btree_put(btree, key, value);
+}
+
+/**
+ * @brief Looks up the value for a key.
+ * @param btree The tree.
+ * @param key The key to look for.
+ * @return A pointer to the value (owned by the tree), or NULL if not found or on invalid input.
+ */
+mvn_val_t *mvn_btree_get(const mvn_btree_t *btree, const mvn_val_t *key)
+{
+    if (btree == NULL || key == NULL) {
+        return NULL;
+    }
+    mvn_btree_node_t *leaf = mvn_btree_find_leaf(btree, key);
+    if (leaf == NULL) {
+        return NULL;
+    }
+    size_t index = mvn_btree_lower_bound(leaf, key);
+    if (index < leaf->count && mvn_val_compare(&leaf->keys[index], key) == 0) {
+        return &leaf->values[index];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Looks up the value for a string key given as a C string, without allocating.
+ * @param btree The tree.
+ * @param key_cstr The key to look for.
+ * @return A pointer to the value (owned by the tree), or NULL if not found or on invalid input.
+ */
+mvn_val_t *mvn_btree_get_cstr(const mvn_btree_t *btree, const char *key_cstr)
+{
+    if (btree == NULL || key_cstr == NULL) {
+        return NULL;
+    }
+    mvn_str_t storage;
+    mvn_val_t key = mvn_btree_cstr_key(key_cstr, &storage);
+    return mvn_btree_get(btree, &key);
+}
+
+/**
+ * @brief Removes the entry for a key, freeing its key and value.
+ *
+ * Underfull nodes borrow an entry from a sibling or merge with it on the way back up; the
+ * root is dropped when it is left with a single child.
+ *
+ * @param btree The tree.
+ * @param key The key to remove.
+ * @return true if the entry was found and removed, false otherwise.
+ */
+bool mvn_btree_remove(mvn_btree_t *btree, const mvn_val_t *key)
+{
+    if (btree == NULL || key == NULL || btree->root == NULL) {
+        return false;
+    }
+    if (!mvn_btree_remove_from(btree->root, key)) {
+        return false;
+    }
+    btree->count--;
+
+    mvn_btree_node_t *root = btree->root;
+    if (root->count == 0) {
+        if (root->leaf) {
+            btree->root   = NULL;
+            btree->first  = NULL;
+            btree->height = 0;
+        } else {
+            btree->root = root->children[0];
+            btree->height--;
+        }
+        mvn_btree_node_free(root);
+    }
+    return true;
+}
+
+/**
+ * @brief Removes the entry for a string key given as a C string, without allocating.
+ * @param btree The tree.
+ * @param key_cstr The key to remove.
+ * @return true if the entry was found and removed, false otherwise.
+ */
+bool mvn_btree_remove_cstr(mvn_btree_t *btree, const char *key_cstr)
+{
+    if (btree == NULL || key_cstr == NULL) {
+        return false;
+    }
+    mvn_str_t storage;
+    mvn_val_t key = mvn_btree_cstr_key(key_cstr, &storage);
+    return mvn_btree_remove(btree, &key);
+}
+
+/**
+ * @brief Returns the number of entries in the tree.
+ * @param btree The tree.
+ * @return The number of entries, or 0 if btree is NULL.
+ */
+size_t mvn_btree_count(const mvn_btree_t *btree)
+{
+    return btree != NULL ? btree->count : 0;
+}
+
+/**
+ * @brief Returns an iterator over every entry in ascending key order.
+ * @param btree The tree. A NULL tree yields an exhausted iterator.
+ * @return The iterator.
+ */
+mvn_btree_iter_t mvn_btree_iter(const mvn_btree_t *btree)
+{
+    mvn_btree_iter_t iter = {NULL, 0, NULL};
+    if (btree != NULL) {
+        iter.leaf = btree->first;
+    }
+    return iter;
+}
+
+/**
+ * @brief Returns an iterator over the entries with low <= key < high.
+ *
+ * The start is found with one descent from the root; the scan then follows the leaf links,
+ * so each further entry costs a single comparison against high.
+ *
+ * @param btree The tree. A NULL tree yields an exhausted iterator.
+ * @param low Inclusive lower bound, or NULL for none.
+ * @param high Exclusive upper bound, or NULL for none. Not copied; must outlive the iterator.
+ * @return The iterator.
+ */
+mvn_btree_iter_t
+mvn_btree_range(const mvn_btree_t *btree, const mvn_val_t *low, const mvn_val_t *high)
+{
+    mvn_btree_iter_t iter = {NULL, 0, high};
+    if (btree == NULL || btree->root == NULL) {
+        return iter;
+    }
+    if (low == NULL) {
+        iter.leaf = btree->first;
+        return iter;
+    }
+    mvn_btree_node_t *leaf = mvn_btree_find_leaf(btree, low);
+    iter.leaf              = leaf;
+    iter.index             = mvn_btree_lower_bound(leaf, low);
+    return iter;
+}
+
+/**
+ * @brief Advances an iterator to the next entry in its range.
+ * @param iter The iterator. Must not be NULL.
+ * @param[out] key Set to the entry's key (owned by the tree). May be NULL.
+ * @param[out] value Set to the entry's value (owned by the tree). May be NULL.
+ * @return true if an entry was produced, false when the range is exhausted.
+ */
+bool mvn_btree_iter_next(mvn_btree_iter_t *iter, const mvn_val_t **key, mvn_val_t **value)
+{
+    if (iter == NULL) {
+        return false;
+    }
+    // Leaves can be empty after a failed rebalance, so skip until one has an entry left
+    while (iter->leaf != NULL && iter->index >= iter->leaf->count) {
+        iter->leaf  = iter->leaf->next;
+        iter->index = 0;
+    }
+    if (iter->leaf == NULL) {
+        return false;
+    }
+    if (iter->high != NULL && mvn_val_compare(&iter->leaf->keys[iter->index], iter->high) >= 0) {
+        iter->leaf = NULL;
+        return false;
+    }
+
+    // The iterator only reads, but hands out the tree's values like mvn_btree_get does
+    mvn_btree_node_t *leaf = (mvn_btree_node_t *)iter->leaf;
+    if (key != NULL) {
+        *key = &leaf->keys[iter->index];
+    }
+    if (value != NULL) {
+        *value = &leaf->values[iter->index];
+    }
+    iter->index++;
+    return true;
+}
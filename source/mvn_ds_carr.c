@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_CARR // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_carr.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_free
+#include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_new_capacity
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_FREE
+#include "mvn_ds_thread.h"       // For atomics
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memcpy
+
+// Padding used to keep the hot counters on separate cache lines
+#define MVN_DS_CARR_CACHE_LINE 64
+// Number of times a segment allocation is tried before the segment is marked as failed
+#define MVN_DS_CARR_ALLOC_ATTEMPTS 3
+
+struct mvn_carr_t {
+    volatile size_t reserved; /**< Next index handed out by push (fetch_add). */
+    char            reserved_pad[MVN_DS_CARR_CACHE_LINE - sizeof(size_t)];
+    volatile size_t published; /**< Every index below this is written and readable. */
+    char            published_pad[MVN_DS_CARR_CACHE_LINE - sizeof(size_t)];
+    volatile size_t failed; /**< Pushes that could not store their value. */
+    /** Segment k holds MVN_DS_CARR_FIRST_SEGMENT_SIZE << k values followed by as many
+     * ready flags. Segments are installed once with a CAS and never move; a segment that
+     * could not be allocated is set to MVN_DS_CARR_FAILED_SEGMENT instead. */
+    void *volatile segments[MVN_DS_CARR_MAX_SEGMENTS];
+};
+
+// Read in place of every slot of a failed segment. Its address also marks failed segments.
+static const mvn_val_t mvn_carr_null_slot = {.type = MVN_VAL_NULL};
+#define MVN_DS_CARR_FAILED_SEGMENT ((mvn_val_t *)&mvn_carr_null_slot)
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Returns the index of the most significant set bit of a non-zero value.
+ */
+static size_t mvn_carr_highest_bit(size_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64)
+    unsigned long bit_index;
+    _BitScanReverse64(&bit_index, (unsigned __int64)value);
+    return (size_t)bit_index;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit_index;
+    _BitScanReverse(&bit_index, (unsigned long)value);
+    return (size_t)bit_index;
+#else
+    return (size_t)(sizeof(unsigned long long) * 8 - 1) -
+           (size_t)__builtin_clzll((unsigned long long)value);
+#endif
+}
+
+/**
+ * @internal
+ * @brief Maps a global index to its segment number and offset within that segment.
+ */
+static void mvn_carr_locate(size_t index, size_t *segment_index, size_t *offset)
+{
+    size_t biased  = index + MVN_DS_CARR_FIRST_SEGMENT_SIZE;
+    size_t top_bit = mvn_carr_highest_bit(biased);
+    *segment_index = top_bit - MVN_DS_CARR_FIRST_SEGMENT_SHIFT;
+    *offset        = biased - ((size_t)1 << top_bit);
+}
+
+/**
+ * @internal
+ * @brief Number of slots in a segment.
+ */
+static size_t mvn_carr_segment_size(size_t segment_index)
+{
+    return MVN_DS_CARR_FIRST_SEGMENT_SIZE << segment_index;
+}
+
+/**
+ * @internal
+ * @brief Returns the ready flag array stored after a segment's values.
+ */
+static volatile uint8_t *mvn_carr_ready_flags(mvn_val_t *segment, size_t segment_index)
+{
+    return (volatile uint8_t *)(segment + mvn_carr_segment_size(segment_index));
+}
+
+/**
+ * @internal
+ * @brief Returns the segment, allocating and installing it if no thread has yet.
+ * Racing allocators CAS the segment pointer; losers free their copy. If every allocation
+ * attempt fails, MVN_DS_CARR_FAILED_SEGMENT is installed so the slots already reserved in the
+ * segment still resolve and the published count can move past them.
+ * @return The segment, or MVN_DS_CARR_FAILED_SEGMENT if it could not be allocated.
+ */
+static mvn_val_t *mvn_carr_ensure_segment(mvn_carr_t *carr, size_t segment_index)
+{
+    mvn_val_t *segment = (mvn_val_t *)mvn_atomic_load_acquire_ptr(&carr->segments[segment_index]);
+    if (segment != NULL) {
+        return segment;
+    }
+
+    size_t     slot_count = mvn_carr_segment_size(segment_index);
+    mvn_val_t *fresh      = NULL;
+    if (slot_count > SIZE_MAX / (sizeof(mvn_val_t) + 1)) {
+        fprintf(stderr, "[MVN_DS_CARR] Segment size overflow.\n");
+    } else {
+        // Zeroed memory clears every ready flag
+        for (int attempt = 0; attempt < MVN_DS_CARR_ALLOC_ATTEMPTS && fresh == NULL; attempt++) {
+            fresh = (mvn_val_t *)MVN_DS_CALLOC(1, slot_count * (sizeof(mvn_val_t) + 1));
+        }
+        if (fresh == NULL) {
+            fprintf(stderr, "[MVN_DS_CARR] Failed to allocate segment %zu.\n", segment_index);
+        }
+    }
+    if (!mvn_atomic_cas_ptr(&carr->segments[segment_index],
+                            NULL,
+                            fresh != NULL ? fresh : MVN_DS_CARR_FAILED_SEGMENT)) {
+        MVN_DS_FREE(fresh); // Another writer installed it first
+    }
+    return (mvn_val_t *)mvn_atomic_load_acquire_ptr(&carr->segments[segment_index]);
+}
+
+/**
+ * @internal
+ * @brief Returns true if the slot at index has been written or belongs to a failed segment.
+ */
+static bool mvn_carr_slot_ready(const mvn_carr_t *carr, size_t index)
+{
+    size_t segment_index;
+    size_t offset;
+    mvn_carr_locate(index, &segment_index, &offset);
+    mvn_val_t *segment = (mvn_val_t *)mvn_atomic_load_acquire_ptr(
+        (void *volatile *)&carr->segments[segment_index]);
+    if (segment == NULL) {
+        return false;
+    }
+    if (segment == MVN_DS_CARR_FAILED_SEGMENT) {
+        return true;
+    }
+    return mvn_atomic_load_acquire_u8(&mvn_carr_ready_flags(segment, segment_index)[offset]) != 0;
+}
+
+/**
+ * @internal
+ * @brief Moves the published count forward over every contiguous ready slot.
+ * Any writer may advance past slots written by others, so the count never waits on a
+ * specific thread once the slots below it are ready.
+ */
+static void mvn_carr_advance_published(mvn_carr_t *carr)
+{
+    for (;;) {
+        mvn_atomic_fence_seq_cst(); // Pairs with the fence after a ready flag is set
+        size_t published = mvn_atomic_load_acquire_size(&carr->published);
+        if (published >= mvn_atomic_load_acquire_size(&carr->reserved) ||
+            !mvn_carr_slot_ready(carr, published)) {
+            return;
+        }
+        mvn_atomic_cas_size(&carr->published, published, published + 1);
+    }
+}
+
+/**
+ * @internal
+ * @brief Frees every written element and every segment. Does not free carr itself.
+ * @param first_index Elements below this index are skipped (already moved out).
+ */
+static void mvn_carr_release_segments(mvn_carr_t *carr, size_t first_index)
+{
+    size_t reserved = mvn_atomic_load_acquire_size(&carr->reserved);
+    for (size_t index = first_index; index < reserved; index++) {
+        size_t segment_index;
+        size_t offset;
+        mvn_carr_locate(index, &segment_index, &offset);
+        mvn_val_t *segment = (mvn_val_t *)carr->segments[segment_index];
+        if (segment != NULL && segment != MVN_DS_CARR_FAILED_SEGMENT &&
+            mvn_carr_ready_flags(segment, segment_index)[offset] != 0) {
+            mvn_val_free(&segment[offset]);
+        }
+    }
+    for (size_t segment_index = 0; segment_index < MVN_DS_CARR_MAX_SEGMENTS; segment_index++) {
+        if (carr->segments[segment_index] != MVN_DS_CARR_FAILED_SEGMENT) {
+            MVN_DS_FREE((mvn_val_t *)carr->segments[segment_index]);
+        }
+        carr->segments[segment_index] = NULL;
+    }
+}
+
+// --- Concurrent Array Implementation ---
+
+/**
+ * @brief Creates a new concurrent array with segments preallocated for at least capacity
+ * elements.
+ * @param capacity Number of elements to preallocate for. 0 defers all allocation to push.
+ * @return A pointer to the new mvn_carr_t, or NULL on allocation failure.
+ */
+mvn_carr_t *mvn_carr_new_capacity(size_t capacity)
+{
+    mvn_carr_t *carr = (mvn_carr_t *)MVN_DS_CALLOC(1, sizeof(mvn_carr_t));
+    if (carr == NULL) {
+        return NULL;
+    }
+    if (capacity > 0) {
+        size_t last_segment;
+        size_t offset;
+        mvn_carr_locate(capacity - 1, &last_segment, &offset);
+        for (size_t segment_index = 0; segment_index <= last_segment; segment_index++) {
+            if (mvn_carr_ensure_segment(carr, segment_index) == MVN_DS_CARR_FAILED_SEGMENT) {
+                mvn_carr_free(carr);
+                return NULL;
+            }
+        }
+    }
+    return carr;
+}
+
+/**
+ * @brief Creates a new, empty concurrent array.
+ * @return A pointer to the new mvn_carr_t, or NULL on allocation failure.
+ */
+mvn_carr_t *mvn_carr_new(void)
+{
+    return mvn_carr_new_capacity(0);
+}
+
+/**
+ * @brief Frees the array, every element written to it and its segments.
+ * @param carr The array to free. Does nothing if NULL. No pushes may be in flight.
+ */
+void mvn_carr_free(mvn_carr_t *carr)
+{
+    if (carr == NULL) {
+        return;
+    }
+    mvn_carr_release_segments(carr, 0);
+    MVN_DS_FREE(carr);
+}
+
+/**
+ * @brief Appends a value. Safe to call from many threads at once.
+ * A slot is reserved with one fetch_add, the value is written in place, the slot's ready flag is
+ * set with release semantics, and the published count is advanced over any ready prefix.
+ * @param carr The array. Must not be NULL.
+ * @param value The value to append. Ownership is transferred to the array.
+ * @return true on success, false on invalid input or if the slot's segment could not be
+ *         allocated. A failed slot is still published, reads as null and is counted by
+ *         mvn_carr_failed_count, so later pushes stay visible.
+ */
+bool mvn_carr_push(mvn_carr_t *carr, mvn_val_t value)
+{
+    if (carr == NULL) {
+        mvn_val_free(&value);
+        return false;
+    }
+
+    size_t index = mvn_atomic_fetch_add_size(&carr->reserved, 1);
+    size_t segment_index;
+    size_t offset;
+    mvn_carr_locate(index, &segment_index, &offset);
+
+    mvn_val_t *segment = mvn_carr_ensure_segment(carr, segment_index);
+    if (segment == MVN_DS_CARR_FAILED_SEGMENT) {
+        mvn_val_free(&value);
+        mvn_atomic_fetch_add_size(&carr->failed, 1);
+        mvn_carr_advance_published(carr); // The slot resolves as null
+        return false;
+    }
+    segment[offset] = value;
+    mvn_atomic_store_release_u8(&mvn_carr_ready_flags(segment, segment_index)[offset], 1);
+    mvn_atomic_fence_seq_cst(); // Pairs with the fence in mvn_carr_advance_published
+    mvn_carr_advance_published(carr);
+    return true;
+}
+
+/**
+ * @brief Returns the number of published elements.
+ * @param carr The array. Can be NULL.
+ * @return The published count, or 0 if carr is NULL.
+ */
+size_t mvn_carr_count(const mvn_carr_t *carr)
+{
+    if (carr == NULL) {
+        return 0;
+    }
+    return mvn_atomic_load_acquire_size((volatile size_t *)&carr->published);
+}
+
+/**
+ * @brief Returns the number of pushes that failed to allocate their segment.
+ * Their slots are published as null values.
+ * @param carr The array. Can be NULL.
+ * @return The failed push count, or 0 if carr is NULL.
+ */
+size_t mvn_carr_failed_count(const mvn_carr_t *carr)
+{
+    if (carr == NULL) {
+        return 0;
+    }
+    return mvn_atomic_load_acquire_size((volatile size_t *)&carr->failed);
+}
+
+/**
+ * @brief Retrieves a pointer to a published element.
+ * Safe to call while other threads push.
+ * @param carr The array. Can be NULL.
+ * @param index The index to read.
+ * @return A pointer to the element (a null value for a failed push), or NULL if carr is NULL
+ *         or index is not published yet.
+ */
+const mvn_val_t *mvn_carr_get(const mvn_carr_t *carr, size_t index)
+{
+    if (carr == NULL || index >= mvn_carr_count(carr)) {
+        return NULL;
+    }
+    size_t segment_index;
+    size_t offset;
+    mvn_carr_locate(index, &segment_index, &offset);
+    mvn_val_t *segment = (mvn_val_t *)mvn_atomic_load_acquire_ptr(
+        (void *volatile *)&carr->segments[segment_index]);
+    return segment == MVN_DS_CARR_FAILED_SEGMENT ? &mvn_carr_null_slot : &segment[offset];
+}
+
+/**
+ * @brief Moves all published elements into a new contiguous array and frees carr.
+ * Elements are moved, not copied: the segment contents are memcpy'd segment by segment.
+ * Slots of failed pushes become null values.
+ * @param carr The array to convert. All writers must have finished.
+ * @return A new mvn_arr_t owning the elements, or NULL if carr is NULL or on allocation failure
+ *         (carr is left intact on failure).
+ */
+mvn_arr_t *mvn_carr_to_arr(mvn_carr_t *carr)
+{
+    if (carr == NULL) {
+        return NULL;
+    }
+    size_t     count = mvn_carr_count(carr);
+    mvn_arr_t *array = mvn_arr_new_capacity(count);
+    if (array == NULL) {
+        return NULL;
+    }
+
+    size_t copied = 0;
+    for (size_t segment_index = 0; copied < count; segment_index++) {
+        size_t chunk = mvn_carr_segment_size(segment_index);
+        if (chunk > count - copied) {
+            chunk = count - copied;
+        }
+        mvn_val_t *segment = (mvn_val_t *)carr->segments[segment_index];
+        if (segment == MVN_DS_CARR_FAILED_SEGMENT) {
+            for (size_t offset = 0; offset < chunk; offset++) {
+                array->data[copied + offset] = mvn_val_null();
+            }
+        } else {
+            memcpy(&array->data[copied], segment, chunk * sizeof(mvn_val_t));
+        }
+        copied += chunk;
+    }
+    array->count = count;
+
+    mvn_carr_release_segments(carr, count); // Frees the segments
+    MVN_DS_FREE(carr);
+    return array;
+}
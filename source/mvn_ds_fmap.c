@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_FMAP // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_fmap.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_free, mvn_val_deep_copy
+#include "mvn_ds/mvn_ds_bloom.h" // For mvn_bloom_free
+#include "mvn_ds/mvn_ds_str.h"   // For mvn_str_free
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memcpy, memcmp, strlen
+
+// FNV-1a 64-bit constants
+#define MVN_DS_FMAP_FNV_OFFSET_BASIS 14695981039346656037ULL
+#define MVN_DS_FMAP_FNV_PRIME        1099511628211ULL
+// Odd constant used to spread displacement seeds across the hash (2^64 / golden ratio)
+#define MVN_DS_FMAP_SEED_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief 64-bit finalizer (MurmurHash3 fmix64); every input bit affects every output bit.
+ */
+static uint64_t mvn_fmap_mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @internal
+ * @brief Hashes key bytes with FNV-1a 64 followed by a finalizer.
+ * The upper half selects the bucket and the whole value is reseeded to select the slot.
+ * @param salt Changes the starting state; 0 gives plain FNV-1a.
+ */
+static uint64_t mvn_fmap_hash_bytes(const char *data, size_t length, uint64_t salt)
+{
+    uint64_t hash_value = MVN_DS_FMAP_FNV_OFFSET_BASIS ^ (salt * MVN_DS_FMAP_SEED_MULTIPLIER);
+    for (size_t index = 0; index < length; index++) {
+        hash_value ^= (uint64_t)(unsigned char)data[index];
+        hash_value *= MVN_DS_FMAP_FNV_PRIME;
+    }
+    return mvn_fmap_mix(hash_value);
+}
+
+/**
+ * @internal
+ * @brief Maps the low 32 bits of a hash onto [0, range) with a multiply instead of a modulo.
+ * @param range Must not exceed UINT32_MAX.
+ */
+static size_t mvn_fmap_reduce(uint64_t hash, size_t range)
+{
+    return (size_t)(((hash & 0xFFFFFFFFULL) * (uint64_t)range) >> 32);
+}
+
+/**
+ * @internal
+ * @brief Returns the displacement bucket of a key hash.
+ */
+static size_t mvn_fmap_bucket(uint64_t hash, size_t bucket_count)
+{
+    return mvn_fmap_reduce(hash >> 32, bucket_count);
+}
+
+/**
+ * @internal
+ * @brief Returns the slot a key hash lands in when its bucket uses the given seed.
+ */
+static size_t mvn_fmap_seeded_slot(uint64_t hash, uint32_t seed, size_t count)
+{
+    return mvn_fmap_reduce(mvn_fmap_mix(hash ^ ((uint64_t)seed * MVN_DS_FMAP_SEED_MULTIPLIER)),
+                           count);
+}
+
+/**
+ * @internal
+ * @brief Allocates a frozen map and its entries, displacements and key bytes as one block.
+ * Entries come first after the header so mvn_val_t keeps its natural alignment.
+ * @return The map with count, bucket_count and the array pointers set, or NULL on failure.
+ */
+static mvn_fmap_t *mvn_fmap_allocate(size_t count, size_t bucket_count, size_t key_bytes)
+{
+    if (count > (SIZE_MAX - sizeof(mvn_fmap_t)) / sizeof(mvn_fmap_entry_t)) {
+        fprintf(stderr, "[MVN_DS_FMAP] Frozen map entry count overflow.\n");
+        return NULL;
+    }
+    size_t entries_size = count * sizeof(mvn_fmap_entry_t);
+    size_t header_size  = sizeof(mvn_fmap_t) + entries_size;
+    if (bucket_count > (SIZE_MAX - header_size) / sizeof(int32_t) ||
+        key_bytes > SIZE_MAX - header_size - bucket_count * sizeof(int32_t)) {
+        fprintf(stderr, "[MVN_DS_FMAP] Frozen map size overflow.\n");
+        return NULL;
+    }
+    size_t displacements_size = bucket_count * sizeof(int32_t);
+
+    char *block = (char *)MVN_DS_MALLOC(header_size + displacements_size + key_bytes);
+    if (block == NULL) {
+        fprintf(stderr, "[MVN_DS_FMAP] Failed to allocate frozen map.\n");
+        return NULL;
+    }
+    mvn_fmap_t *fmap    = (mvn_fmap_t *)block;
+    fmap->count         = count;
+    fmap->bucket_count  = bucket_count;
+    fmap->salt          = 0;
+    fmap->entries       = (mvn_fmap_entry_t *)(block + sizeof(mvn_fmap_t));
+    fmap->displacements = (int32_t *)(block + header_size);
+    fmap->key_data      = block + header_size + displacements_size;
+    return fmap;
+}
+
+/**
+ * @internal
+ * @brief Finds a seed that sends every key of a bucket to a distinct free slot.
+ * @param members Indices (into hashes) of the keys in the bucket.
+ * @param[out] slot_for_key Receives the chosen slot of each member on success.
+ * @return The seed, or -1 if two members share a hash (no seed can separate them) or none was
+ *         found within MVN_DS_FMAP_MAX_SEED_ATTEMPTS.
+ */
+static int32_t mvn_fmap_place_bucket(const uint64_t *hashes,
+                                     const size_t   *members,
+                                     size_t          member_count,
+                                     const uint8_t  *taken,
+                                     size_t          count,
+                                     size_t         *slot_for_key)
+{
+    for (size_t member = 1; member < member_count; member++) {
+        for (size_t earlier = 0; earlier < member; earlier++) {
+            if (hashes[members[member]] == hashes[members[earlier]]) {
+                return -1;
+            }
+        }
+    }
+    for (uint32_t seed = 0; seed < MVN_DS_FMAP_MAX_SEED_ATTEMPTS; seed++) {
+        bool fits = true;
+        for (size_t member = 0; member < member_count && fits; member++) {
+            size_t slot = mvn_fmap_seeded_slot(hashes[members[member]], seed, count);
+            if (taken[slot]) {
+                fits = false;
+                break;
+            }
+            for (size_t earlier = 0; earlier < member; earlier++) {
+                if (slot_for_key[members[earlier]] == slot) {
+                    fits = false;
+                    break;
+                }
+            }
+            slot_for_key[members[member]] = slot;
+        }
+        if (fits) {
+            return (int32_t)seed;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @internal
+ * @brief Runs the hash-and-displace construction: buckets are placed largest first, trying
+ * seeds until all of a bucket's keys land in free slots; single-key buckets then take the
+ * remaining slots directly.
+ * @param[out] slot_for_key Receives the final slot of every key.
+ * @return true on success, false if some bucket could not be placed.
+ */
+static bool mvn_fmap_build_slots(mvn_fmap_t *fmap, const uint64_t *hashes, size_t *slot_for_key)
+{
+    size_t count        = fmap->count;
+    size_t bucket_count = fmap->bucket_count;
+
+    // Workspace: bucket offsets (bucket_count + 1), fill cursors, member list and slot flags
+    size_t size_t_count = (bucket_count + 1) + bucket_count + count;
+    if (size_t_count > (SIZE_MAX - count) / sizeof(size_t)) {
+        fprintf(stderr, "[MVN_DS_FMAP] Frozen map build size overflow.\n");
+        return false;
+    }
+    size_t *workspace = (size_t *)MVN_DS_MALLOC(size_t_count * sizeof(size_t) + count);
+    if (workspace == NULL) {
+        fprintf(stderr, "[MVN_DS_FMAP] Failed to allocate build workspace.\n");
+        return false;
+    }
+    size_t  *bucket_start = workspace;
+    size_t  *cursor       = bucket_start + bucket_count + 1;
+    size_t  *members      = cursor + bucket_count;
+    uint8_t *taken        = (uint8_t *)(members + count);
+    memset(bucket_start, 0, (bucket_count + 1) * sizeof(size_t));
+    memset(taken, 0, count);
+
+    // Group keys by bucket (counting sort)
+    for (size_t key = 0; key < count; key++) {
+        bucket_start[mvn_fmap_bucket(hashes[key], bucket_count) + 1]++;
+    }
+    size_t largest_bucket = 0;
+    for (size_t bucket = 0; bucket < bucket_count; bucket++) {
+        if (bucket_start[bucket + 1] > largest_bucket) {
+            largest_bucket = bucket_start[bucket + 1];
+        }
+        bucket_start[bucket + 1] += bucket_start[bucket];
+        cursor[bucket] = bucket_start[bucket];
+    }
+    for (size_t key = 0; key < count; key++) {
+        members[cursor[mvn_fmap_bucket(hashes[key], bucket_count)]++] = key;
+    }
+
+    // Multi-key buckets, largest first, while the table is still mostly empty
+    bool success = true;
+    for (size_t size = largest_bucket; size >= 2 && success; size--) {
+        for (size_t bucket = 0; bucket < bucket_count; bucket++) {
+            if (bucket_start[bucket + 1] - bucket_start[bucket] != size) {
+                continue;
+            }
+            const size_t *bucket_members = &members[bucket_start[bucket]];
+            int32_t       seed =
+                mvn_fmap_place_bucket(hashes, bucket_members, size, taken, count, slot_for_key);
+            if (seed < 0) {
+                success = false;
+                break;
+            }
+            fmap->displacements[bucket] = seed;
+            for (size_t member = 0; member < size; member++) {
+                taken[slot_for_key[bucket_members[member]]] = 1;
+            }
+        }
+    }
+
+    // Single-key and empty buckets: store the free slot directly as -(slot + 1)
+    size_t free_slot = 0;
+    for (size_t bucket = 0; bucket < bucket_count && success; bucket++) {
+        size_t size = bucket_start[bucket + 1] - bucket_start[bucket];
+        if (size == 0) {
+            fmap->displacements[bucket] = 0;
+        } else if (size == 1) {
+            while (taken[free_slot]) {
+                free_slot++;
+            }
+            taken[free_slot]                            = 1;
+            slot_for_key[members[bucket_start[bucket]]] = free_slot;
+            fmap->displacements[bucket]                 = -(int32_t)free_slot - 1;
+        }
+    }
+
+    MVN_DS_FREE(workspace);
+    return success;
+}
+
+/**
+ * @internal
+ * @brief Returns the only entry a key could occupy.
+ */
+static const mvn_fmap_entry_t *mvn_fmap_probe(const mvn_fmap_t *fmap, uint64_t hash)
+{
+    int32_t displacement = fmap->displacements[mvn_fmap_bucket(hash, fmap->bucket_count)];
+    size_t  slot         = displacement < 0
+                               ? (size_t)(-(int64_t)displacement - 1)
+                               : mvn_fmap_seeded_slot(hash, (uint32_t)displacement, fmap->count);
+    return &fmap->entries[slot];
+}
+
+/**
+ * @internal
+ * @brief Looks up key bytes, checking the stored hash before the key itself.
+ */
+static const mvn_val_t *mvn_fmap_find(const mvn_fmap_t *fmap, const char *data, size_t length)
+{
+    if (fmap->count == 0) {
+        return NULL;
+    }
+    uint64_t                hash  = mvn_fmap_hash_bytes(data, length, fmap->salt);
+    const mvn_fmap_entry_t *entry = mvn_fmap_probe(fmap, hash);
+    if (entry->hash != hash || entry->key_length != length ||
+        memcmp(fmap->key_data + entry->key_offset, data, length) != 0) {
+        return NULL;
+    }
+    return &entry->value;
+}
+
+// --- Frozen Map Implementation ---
+
+/**
+ * @brief Builds an immutable frozen map from a hash map.
+ * Keys are copied into one contiguous buffer and values are moved (not copied) into an entry
+ * array ordered by a minimal perfect hash, so every lookup reads one displacement and one entry.
+ * @param hmap The hash map to consume. On success it is freed and must not be used again.
+ * If some bucket cannot be placed (for example two keys share a 64-bit hash), the keys are
+ * rehashed with a new salt and the build starts over, up to MVN_DS_FMAP_MAX_BUILD_ATTEMPTS times.
+ * @return A new mvn_fmap_t, or NULL if hmap is NULL, on allocation failure or if no perfect hash
+ *         was found (hmap is left intact in every failure case).
+ */
+mvn_fmap_t *mvn_fmap_from_hmap(mvn_hmap_t *hmap)
+{
+    if (hmap == NULL) {
+        return NULL;
+    }
+    size_t count = hmap->count;
+    if (count > (size_t)INT32_MAX) {
+        fprintf(stderr, "[MVN_DS_FMAP] Too many keys to freeze (%zu).\n", count);
+        return NULL;
+    }
+    size_t bucket_count = (count + MVN_DS_FMAP_KEYS_PER_BUCKET - 1) / MVN_DS_FMAP_KEYS_PER_BUCKET;
+
+    // Collect the source entries and the total key size
+    size_t per_key = sizeof(mvn_hmap_entry_t *) + sizeof(uint64_t) + sizeof(size_t);
+    if (count > SIZE_MAX / per_key) {
+        fprintf(stderr, "[MVN_DS_FMAP] Frozen map build size overflow.\n");
+        return NULL;
+    }
+    uint64_t *hashes = (uint64_t *)MVN_DS_MALLOC(count * per_key + 1);
+    if (hashes == NULL) {
+        fprintf(stderr, "[MVN_DS_FMAP] Failed to allocate build workspace.\n");
+        return NULL;
+    }
+    size_t            *slot_for_key = (size_t *)(hashes + count);
+    mvn_hmap_entry_t **sources      = (mvn_hmap_entry_t **)(slot_for_key + count);
+
+    size_t key_bytes = 0;
+    size_t collected = 0;
+    for (size_t index = 0; index < hmap->capacity && hmap->buckets != NULL; index++) {
+        for (mvn_hmap_entry_t *entry = hmap->buckets[index]; entry != NULL;
+             entry                   = entry->next) {
+            if (collected == count || entry->key == NULL || entry->key->data == NULL) {
+                fprintf(stderr, "[MVN_DS_FMAP] Hash map is inconsistent; cannot freeze.\n");
+                MVN_DS_FREE(hashes);
+                return NULL;
+            }
+            sources[collected] = entry;
+            key_bytes += entry->key->length + 1;
+            collected++;
+        }
+    }
+    if (collected != count) {
+        fprintf(stderr, "[MVN_DS_FMAP] Hash map is inconsistent; cannot freeze.\n");
+        MVN_DS_FREE(hashes);
+        return NULL;
+    }
+
+    mvn_fmap_t *fmap = mvn_fmap_allocate(count, bucket_count, key_bytes);
+    if (fmap == NULL) {
+        MVN_DS_FREE(hashes);
+        return NULL;
+    }
+    bool built = false;
+    for (uint64_t salt = 0; salt < MVN_DS_FMAP_MAX_BUILD_ATTEMPTS && !built; salt++) {
+        for (size_t key = 0; key < count; key++) {
+            hashes[key] =
+                mvn_fmap_hash_bytes(sources[key]->key->data, sources[key]->key->length, salt);
+        }
+        fmap->salt = salt;
+        built      = mvn_fmap_build_slots(fmap, hashes, slot_for_key);
+    }
+    if (!built) {
+        fprintf(stderr,
+                "[MVN_DS_FMAP] No perfect hash found after %d attempts.\n",
+                MVN_DS_FMAP_MAX_BUILD_ATTEMPTS);
+        MVN_DS_FREE(fmap);
+        MVN_DS_FREE(hashes);
+        return NULL;
+    }
+
+    // Nothing can fail from here on: move keys and values into place
+    size_t key_offset = 0;
+    for (size_t key = 0; key < count; key++) {
+        mvn_fmap_entry_t *target = &fmap->entries[slot_for_key[key]];
+        const mvn_str_t  *source = sources[key]->key;
+        memcpy(fmap->key_data + key_offset, source->data, source->length + 1);
+        target->key_offset = key_offset;
+        target->key_length = source->length;
+        target->hash       = hashes[key];
+        target->value      = sources[key]->value;
+        key_offset += source->length + 1;
+    }
+    MVN_DS_FREE(hashes);
+
+    // Free the hash map shell; its values now belong to the frozen map
+    for (size_t index = 0; index < hmap->capacity && hmap->buckets != NULL; index++) {
+        mvn_hmap_entry_t *entry = hmap->buckets[index];
+        while (entry != NULL) {
+            mvn_hmap_entry_t *next_entry = entry->next;
+            mvn_str_free(entry->key);
+            MVN_DS_FREE(entry);
+            entry = next_entry;
+        }
+    }
+    MVN_DS_FREE(hmap->buckets);
+    mvn_bloom_free(hmap->filter);
+    MVN_DS_FREE(hmap);
+    return fmap;
+}
+
+/**
+ * @brief Frees the frozen map, including all of its values.
+ * @param fmap The frozen map to free. Does nothing if NULL.
+ */
+void mvn_fmap_free(mvn_fmap_t *fmap)
+{
+    if (fmap == NULL) {
+        return;
+    }
+    for (size_t index = 0; index < fmap->count; index++) {
+        mvn_val_free(&fmap->entries[index].value);
+    }
+    MVN_DS_FREE(fmap); // Entries, displacements and keys share the allocation
+}
+
+/**
+ * @brief Creates a deep copy of a frozen map.
+ * The displacement table and keys are copied verbatim, so the copy needs no rebuild.
+ * @param fmap The frozen map to copy.
+ * @return A new mvn_fmap_t, or NULL if fmap is NULL or on allocation failure.
+ */
+mvn_fmap_t *mvn_fmap_copy(const mvn_fmap_t *fmap)
+{
+    if (fmap == NULL) {
+        return NULL;
+    }
+    size_t key_bytes = 0;
+    for (size_t index = 0; index < fmap->count; index++) {
+        key_bytes += fmap->entries[index].key_length + 1;
+    }
+    mvn_fmap_t *copy = mvn_fmap_allocate(fmap->count, fmap->bucket_count, key_bytes);
+    if (copy == NULL) {
+        return NULL;
+    }
+    copy->salt = fmap->salt;
+    memcpy(copy->displacements, fmap->displacements, fmap->bucket_count * sizeof(int32_t));
+    memcpy(copy->key_data, fmap->key_data, key_bytes);
+
+    for (size_t index = 0; index < fmap->count; index++) {
+        const mvn_fmap_entry_t *source = &fmap->entries[index];
+        mvn_fmap_entry_t       *target = &copy->entries[index];
+        target->key_offset             = source->key_offset;
+        target->key_length             = source->key_length;
+        target->hash                   = source->hash;
+        target->value                  = mvn_val_deep_copy(&source->value);
+        if (target->value.type == MVN_VAL_NULL && source->value.type != MVN_VAL_NULL) {
+            // Deep copy failed: release what was copied so far
+            for (size_t copied = 0; copied < index; copied++) {
+                mvn_val_free(&copy->entries[copied].value);
+            }
+            MVN_DS_FREE(copy);
+            return NULL;
+        }
+    }
+    return copy;
+}
+
+/**
+ * @brief Returns the number of key-value pairs in the frozen map.
+ * @param fmap The frozen map. Can be NULL.
+ * @return The count, or 0 if fmap is NULL.
+ */
+size_t mvn_fmap_count(const mvn_fmap_t *fmap)
+{
+    return fmap != NULL ? fmap->count : 0;
+}
+
+/**
+ * @brief Retrieves the value associated with an mvn_str_t key.
+ * The map is never modified after construction, so concurrent lookups need no locking.
+ * @param fmap The frozen map.
+ * @param key The key to look up.
+ * @return A pointer to the value, or NULL if not found or on invalid input.
+ */
+const mvn_val_t *mvn_fmap_get(const mvn_fmap_t *fmap, const mvn_str_t *key)
+{
+    if (fmap == NULL || key == NULL || key->data == NULL) {
+        return NULL;
+    }
+    return mvn_fmap_find(fmap, key->data, key->length);
+}
+
+/**
+ * @brief Retrieves the value associated with a C string key without allocating.
+ * @param fmap The frozen map.
+ * @param key_cstr The null-terminated key to look up.
+ * @return A pointer to the value, or NULL if not found or on invalid input.
+ */
+const mvn_val_t *mvn_fmap_get_cstr(const mvn_fmap_t *fmap, const char *key_cstr)
+{
+    if (fmap == NULL || key_cstr == NULL) {
+        return NULL;
+    }
+    return mvn_fmap_find(fmap, key_cstr, strlen(key_cstr));
+}
+
+/**
+ * @brief Returns the key stored in a slot, for iteration.
+ * @param fmap The frozen map.
+ * @param index The slot index (0 <= index < count).
+ * @return The null-terminated key, or NULL if fmap is NULL or index is out of bounds.
+ */
+const char *mvn_fmap_key_at(const mvn_fmap_t *fmap, size_t index)
+{
+    if (fmap == NULL || index >= fmap->count) {
+        return NULL;
+    }
+    return fmap->key_data + fmap->entries[index].key_offset;
+}
+
+/**
+ * @brief Returns the value stored in a slot, for iteration.
+ * @param fmap The frozen map.
+ * @param index The slot index (0 <= index < count).
+ * @return A pointer to the value, or NULL if fmap is NULL or index is out of bounds.
+ */
+const mvn_val_t *mvn_fmap_value_at(const mvn_fmap_t *fmap, size_t index)
+{
+    if (fmap == NULL || index >= fmap->count) {
+        return NULL;
+    }
+    return &fmap->entries[index].value;
+}
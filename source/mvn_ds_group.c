@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_GROUP // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_group.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_hash, mvn_val_equal, mvn_val_compare
+#include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_new, mvn_arr_push, mvn_arr_free
+#include "mvn_ds/mvn_ds_hmap.h"  // For mvn_hmap_new, mvn_hmap_set_cstr
+#include "mvn_ds/mvn_ds_pool.h"  // For mvn_pool_parallel_for, mvn_pool_thread_count
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_REALLOC, MVN_DS_FREE
+
+#include "mvn_ds_path.h" // For mvn_path_t, mvn_path_parse, mvn_path_resolve
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memmove, memset
+
+// Hash table slots allocated for a partition's first groups; a power of two
+#define MVN_DS_GROUP_INITIAL_SLOTS 64
+
+/**
+ * @internal
+ * @brief Running state of one aggregation for one group.
+ */
+typedef struct mvn_group_acc_t {
+    uint64_t         count;     /**< Records (COUNT without path) or values counted. */
+    uint64_t         int_sum;   /**< Sum of the integer values, wrapping like int64_t. */
+    double           float_sum; /**< Sum of the float values. */
+    bool             has_float; /**< Whether any value summed was a float. */
+    const mvn_val_t *best;      /**< MIN/MAX so far, borrowed from a record; NULL if none. */
+    mvn_arr_t       *items;     /**< COLLECT copies, NULL until the first value. */
+} mvn_group_acc_t;
+
+/**
+ * @internal
+ * @brief Key of one group, borrowed from the group's first record.
+ */
+typedef struct mvn_group_key_t {
+    const mvn_val_t *value; /**< The key. */
+    uint64_t         hash;  /**< mvn_val_hash of the key. */
+} mvn_group_key_t;
+
+/**
+ * @internal
+ * @brief Groups of one partition in first-seen order, found through an open-addressing table
+ * with linear probing that stays at most half full.
+ */
+typedef struct mvn_group_table_t {
+    size_t           count;      /**< Number of groups. */
+    size_t           slot_count; /**< Number of slots, a power of two; groups fit in half. */
+    size_t          *slots;      /**< Group index + 1 per slot, 0 for an empty slot. */
+    mvn_group_key_t *keys;       /**< Key of each group. */
+    mvn_group_acc_t *accs;       /**< aggregation_count accumulators per group, group-major. */
+} mvn_group_table_t;
+
+/**
+ * @internal
+ * @brief A group-by call with its paths parsed once.
+ */
+typedef struct mvn_group_query_t {
+    const mvn_arr_t *records;           /**< Records being grouped. */
+    const char      *key_path_cstr;     /**< Key path as given; names the key field in results. */
+    mvn_path_t       key_path;          /**< Parsed key path. */
+    const mvn_agg_t *aggregations;      /**< Requested aggregations. */
+    size_t           aggregation_count; /**< Number of aggregations. */
+    mvn_path_t      *paths;             /**< Parsed path per aggregation; empty if it has none. */
+} mvn_group_query_t;
+
+/**
+ * @internal
+ * @brief One contiguous range of records grouped by one task.
+ */
+typedef struct mvn_group_part_t {
+    const mvn_group_query_t *query; /**< Shared, read-only query. */
+    size_t                   begin; /**< First record of the range. */
+    size_t                   end;   /**< One past the last record. */
+    mvn_group_table_t        table; /**< Groups found in the range. */
+    bool                     ok;    /**< False after an allocation failure. */
+} mvn_group_part_t;
+
+// Key of the group of records that have no value at the key path
+static const mvn_val_t mvn_group_null_key = {.type = MVN_VAL_NULL};
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Allocates an empty table with room for MVN_DS_GROUP_INITIAL_SLOTS / 2 groups.
+ */
+static bool mvn_group_table_init(mvn_group_table_t *table, size_t aggregation_count)
+{
+    size_t capacity   = MVN_DS_GROUP_INITIAL_SLOTS / 2;
+    table->count      = 0;
+    table->slot_count = MVN_DS_GROUP_INITIAL_SLOTS;
+    table->slots      = (size_t *)MVN_DS_CALLOC(table->slot_count, sizeof(size_t));
+    table->keys       = (mvn_group_key_t *)MVN_DS_MALLOC(capacity * sizeof(mvn_group_key_t));
+    table->accs       = NULL;
+    if (aggregation_count > 0) {
+        table->accs = (mvn_group_acc_t *)MVN_DS_CALLOC(capacity * aggregation_count,
+                                                       sizeof(mvn_group_acc_t));
+    }
+    return table->slots != NULL && table->keys != NULL &&
+           (aggregation_count == 0 || table->accs != NULL);
+}
+
+/**
+ * @internal
+ * @brief Frees a table and the values its COLLECT accumulators still own.
+ */
+static void mvn_group_table_free(mvn_group_table_t *table, size_t aggregation_count)
+{
+    if (table->accs != NULL) {
+        for (size_t index = 0; index < table->count * aggregation_count; index++) {
+            mvn_arr_free(table->accs[index].items);
+        }
+    }
+    MVN_DS_FREE(table->slots);
+    MVN_DS_FREE(table->keys);
+    MVN_DS_FREE(table->accs);
+}
+
+/**
+ * @internal
+ * @brief Doubles the slots and the room for groups, and re-inserts every group by its hash.
+ */
+static bool mvn_group_table_grow(mvn_group_table_t *table, size_t aggregation_count)
+{
+    size_t slot_count = table->slot_count * 2;
+    size_t capacity   = slot_count / 2;
+    if (capacity > SIZE_MAX / ((aggregation_count + 1) * sizeof(mvn_group_acc_t))) {
+        fprintf(stderr, "[MVN_DS_GROUP] Group table size overflow.\n");
+        return false;
+    }
+    size_t *slots = (size_t *)MVN_DS_CALLOC(slot_count, sizeof(size_t));
+    if (slots == NULL) {
+        return false;
+    }
+    mvn_group_key_t *keys =
+        (mvn_group_key_t *)MVN_DS_REALLOC(table->keys, capacity * sizeof(mvn_group_key_t));
+    if (keys == NULL) {
+        MVN_DS_FREE(slots);
+        return false;
+    }
+    table->keys = keys;
+    if (aggregation_count > 0) {
+        size_t           old_size = table->count * aggregation_count;
+        mvn_group_acc_t *accs     = (mvn_group_acc_t *)MVN_DS_REALLOC(
+            table->accs, capacity * aggregation_count * sizeof(mvn_group_acc_t));
+        if (accs == NULL) {
+            MVN_DS_FREE(slots);
+            return false;
+        }
+        memset(accs + old_size, 0, (capacity * aggregation_count - old_size) * sizeof(*accs));
+        table->accs = accs;
+    }
+
+    size_t mask = slot_count - 1;
+    for (size_t group = 0; group < table->count; group++) {
+        size_t slot = (size_t)table->keys[group].hash & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = group + 1;
+    }
+    MVN_DS_FREE(table->slots);
+    table->slots      = slots;
+    table->slot_count = slot_count;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Returns the index of the group for key, adding an empty group if there is none.
+ * @return The group index, or SIZE_MAX on allocation failure.
+ */
+static size_t mvn_group_table_find(mvn_group_table_t *table,
+                                   size_t             aggregation_count,
+                                   const mvn_val_t   *key,
+                                   uint64_t           hash)
+{
+    if (table->count == table->slot_count / 2 &&
+        !mvn_group_table_grow(table, aggregation_count)) {
+        return SIZE_MAX;
+    }
+    size_t mask = table->slot_count - 1;
+    size_t slot = (size_t)hash & mask;
+    while (table->slots[slot] != 0) {
+        size_t group = table->slots[slot] - 1;
+        if (table->keys[group].hash == hash && mvn_val_equal(table->keys[group].value, key)) {
+            return group;
+        }
+        slot = (slot + 1) & mask;
+    }
+    size_t group       = table->count++;
+    table->slots[slot] = group + 1;
+    table->keys[group] = (mvn_group_key_t){.value = key, .hash = hash};
+    return group;
+}
+
+/**
+ * @internal
+ * @brief Adds a value to a sum, if it is a number. Integers are summed separately from
+ * floats so that all-integer sums stay exact.
+ */
+static void mvn_group_add_number(mvn_group_acc_t *acc, const mvn_val_t *value)
+{
+    switch (value->type) {
+        case MVN_VAL_I8:
+            acc->int_sum += (uint64_t)(int64_t)value->i8;
+            break;
+        case MVN_VAL_I16:
+            acc->int_sum += (uint64_t)(int64_t)value->i16;
+            break;
+        case MVN_VAL_I32:
+            acc->int_sum += (uint64_t)(int64_t)value->i32;
+            break;
+        case MVN_VAL_I64:
+            acc->int_sum += (uint64_t)value->i64;
+            break;
+        case MVN_VAL_U8:
+            acc->int_sum += value->u8;
+            break;
+        case MVN_VAL_U16:
+            acc->int_sum += value->u16;
+            break;
+        case MVN_VAL_U32:
+            acc->int_sum += value->u32;
+            break;
+        case MVN_VAL_U64:
+            acc->int_sum += value->u64;
+            break;
+        case MVN_VAL_F32:
+            acc->float_sum += value->f32;
+            acc->has_float = true;
+            break;
+        case MVN_VAL_F64:
+            acc->float_sum += value->f64;
+            acc->has_float = true;
+            break;
+        default:
+            return; // Not a number; not counted towards the average
+    }
+    acc->count++;
+}
+
+/**
+ * @internal
+ * @brief Feeds one record's value (NULL if missing) to an accumulator.
+ */
+static bool
+mvn_group_accumulate(mvn_group_acc_t *acc, const mvn_agg_t *aggregation, const mvn_val_t *value)
+{
+    if (aggregation->kind == MVN_AGG_COUNT && aggregation->path == NULL) {
+        acc->count++;
+        return true;
+    }
+    if (value == NULL || value->type == MVN_VAL_NULL) {
+        return true;
+    }
+    switch (aggregation->kind) {
+        case MVN_AGG_COUNT:
+            acc->count++;
+            break;
+        case MVN_AGG_SUM:
+        case MVN_AGG_AVG:
+            mvn_group_add_number(acc, value);
+            break;
+        case MVN_AGG_MIN:
+            if (acc->best == NULL || mvn_val_compare(value, acc->best) < 0) {
+                acc->best = value;
+            }
+            break;
+        case MVN_AGG_MAX:
+            if (acc->best == NULL || mvn_val_compare(value, acc->best) > 0) {
+                acc->best = value;
+            }
+            break;
+        case MVN_AGG_COLLECT:
+            if (acc->items == NULL && (acc->items = mvn_arr_new()) == NULL) {
+                return false;
+            }
+            return mvn_arr_push(acc->items, mvn_val_deep_copy(value));
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Folds the accumulator of a later partition into the same group's accumulator of an
+ * earlier one. Collected values are moved, keeping record order.
+ */
+static bool
+mvn_group_merge_acc(mvn_group_acc_t *into, mvn_group_acc_t *from, const mvn_agg_t *aggregation)
+{
+    into->count += from->count;
+    into->int_sum += from->int_sum;
+    into->float_sum += from->float_sum;
+    into->has_float = into->has_float || from->has_float;
+    if (from->best != NULL) {
+        int order = into->best == NULL ? 0 : mvn_val_compare(from->best, into->best);
+        if (into->best == NULL || (aggregation->kind == MVN_AGG_MIN ? order < 0 : order > 0)) {
+            into->best = from->best;
+        }
+    }
+    if (from->items != NULL) {
+        if (into->items == NULL) {
+            into->items = from->items;
+            from->items = NULL;
+            return true;
+        }
+        for (size_t index = 0; index < from->items->count; index++) {
+            if (!mvn_arr_push(into->items, from->items->data[index])) {
+                // The push freed the value at index; keep only the values not yet moved
+                size_t rest = from->items->count - index - 1;
+                memmove(from->items->data, from->items->data + index + 1, rest * sizeof(mvn_val_t));
+                from->items->count = rest;
+                return false;
+            }
+        }
+        from->items->count = 0; // Every value now belongs to into
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Produces the result value of an accumulator. COLLECT arrays are moved out.
+ */
+static mvn_val_t mvn_group_result(mvn_group_acc_t *acc, const mvn_agg_t *aggregation)
+{
+    double total = acc->float_sum + (double)(int64_t)acc->int_sum;
+    switch (aggregation->kind) {
+        case MVN_AGG_COUNT:
+            return mvn_val_u64(acc->count);
+        case MVN_AGG_SUM:
+            return acc->has_float ? mvn_val_f64(total) : mvn_val_i64((int64_t)acc->int_sum);
+        case MVN_AGG_AVG:
+            return acc->count > 0 ? mvn_val_f64(total / (double)acc->count) : mvn_val_null();
+        case MVN_AGG_MIN:
+        case MVN_AGG_MAX:
+            return acc->best != NULL ? mvn_val_deep_copy(acc->best) : mvn_val_null();
+        case MVN_AGG_COLLECT: {
+            mvn_arr_t *items = acc->items;
+            acc->items       = NULL;
+            return items != NULL ? mvn_val_arr_take(items) : mvn_val_arr();
+        }
+    }
+    return mvn_val_null();
+}
+
+/**
+ * @internal
+ * @brief Groups the records of one partition: one key lookup and one table probe per record.
+ */
+static void mvn_group_part_run(mvn_group_part_t *part)
+{
+    const mvn_group_query_t *query = part->query;
+    size_t                   count = query->aggregation_count;
+    for (size_t row = part->begin; part->ok && row < part->end; row++) {
+        const mvn_val_t *record = &query->records->data[row];
+        const mvn_val_t *key    = mvn_path_resolve(&query->key_path, record);
+        if (key == NULL) {
+            key = &mvn_group_null_key;
+        }
+        size_t group = mvn_group_table_find(&part->table, count, key, mvn_val_hash(key));
+        if (group == SIZE_MAX) {
+            part->ok = false;
+            break;
+        }
+        for (size_t index = 0; index < count; index++) {
+            const mvn_path_t *path  = &query->paths[index];
+            const mvn_val_t  *value = path->count > 0 ? mvn_path_resolve(path, record) : NULL;
+            if (!mvn_group_accumulate(&part->table.accs[group * count + index],
+                                      &query->aggregations[index],
+                                      value)) {
+                part->ok = false;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief mvn_pool_parallel_for body: groups partitions [begin, end).
+ */
+static void mvn_group_part_range(size_t begin, size_t end, void *context)
+{
+    mvn_group_part_t *parts = (mvn_group_part_t *)context;
+    for (size_t index = begin; index < end; index++) {
+        mvn_group_part_run(&parts[index]);
+    }
+}
+
+/**
+ * @internal
+ * @brief Merges the groups of a later partition into an earlier partition's table. Groups new
+ * to into are appended in from's order, which keeps first-seen order overall.
+ */
+static bool mvn_group_merge(mvn_group_table_t *into,
+                            mvn_group_table_t *from,
+                            const mvn_group_query_t *query)
+{
+    size_t count = query->aggregation_count;
+    for (size_t group = 0; group < from->count; group++) {
+        const mvn_group_key_t *key = &from->keys[group];
+        size_t target = mvn_group_table_find(into, count, key->value, key->hash);
+        if (target == SIZE_MAX) {
+            return false;
+        }
+        for (size_t index = 0; index < count; index++) {
+            if (!mvn_group_merge_acc(&into->accs[target * count + index],
+                                     &from->accs[group * count + index],
+                                     &query->aggregations[index])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Builds the result records from a table: the key under the key path, then each
+ * aggregation's result under its output name.
+ */
+static mvn_arr_t *mvn_group_results(mvn_group_table_t *table, const mvn_group_query_t *query)
+{
+    size_t     count   = query->aggregation_count;
+    mvn_arr_t *results = mvn_arr_new_capacity(table->count);
+    if (results == NULL) {
+        return NULL;
+    }
+    for (size_t group = 0; group < table->count; group++) {
+        mvn_hmap_t *record = mvn_hmap_new();
+        bool        ok     = record != NULL &&
+                  mvn_hmap_set_cstr(record,
+                                    query->key_path_cstr,
+                                    mvn_val_deep_copy(table->keys[group].value));
+        for (size_t index = 0; ok && index < count; index++) {
+            const mvn_agg_t *aggregation = &query->aggregations[index];
+            ok = mvn_hmap_set_cstr(record,
+                                   aggregation->output,
+                                   mvn_group_result(&table->accs[group * count + index],
+                                                    aggregation));
+        }
+        if (!ok) {
+            mvn_hmap_free(record);
+            mvn_arr_free(results);
+            return NULL;
+        }
+        if (!mvn_arr_push(results, mvn_val_hmap_take(record))) {
+            mvn_arr_free(results);
+            return NULL;
+        }
+    }
+    return results;
+}
+
+/**
+ * @internal
+ * @brief Checks the arguments and parses the key path and aggregation paths.
+ * @return false on invalid input or allocation failure; the query is then freed.
+ */
+static bool mvn_group_query_init(mvn_group_query_t *query,
+                                 const mvn_arr_t   *records,
+                                 const char        *key_path,
+                                 const mvn_agg_t   *aggregations,
+                                 size_t             aggregation_count)
+{
+    memset(query, 0, sizeof(*query));
+    if (records == NULL || key_path == NULL || (aggregations == NULL && aggregation_count > 0)) {
+        return false;
+    }
+    for (size_t index = 0; index < aggregation_count; index++) {
+        const mvn_agg_t *aggregation = &aggregations[index];
+        if (aggregation->output == NULL || aggregation->kind > MVN_AGG_COLLECT ||
+            (aggregation->path == NULL && aggregation->kind != MVN_AGG_COUNT)) {
+            fprintf(stderr, "[MVN_DS_GROUP] Invalid aggregation %zu.\n", index);
+            return false;
+        }
+    }
+    query->records           = records;
+    query->key_path_cstr     = key_path;
+    query->aggregations      = aggregations;
+    query->aggregation_count = aggregation_count;
+    if (aggregation_count > 0) {
+        query->paths = (mvn_path_t *)MVN_DS_CALLOC(aggregation_count, sizeof(mvn_path_t));
+        if (query->paths == NULL) {
+            return false;
+        }
+    }
+    bool ok = mvn_path_parse(&query->key_path, key_path);
+    for (size_t index = 0; ok && index < aggregation_count; index++) {
+        ok = aggregations[index].path == NULL ||
+             mvn_path_parse(&query->paths[index], aggregations[index].path);
+    }
+    return ok;
+}
+
+/**
+ * @internal
+ * @brief Frees the parsed paths of a query.
+ */
+static void mvn_group_query_free(mvn_group_query_t *query)
+{
+    mvn_path_free(&query->key_path);
+    for (size_t index = 0; query->paths != NULL && index < query->aggregation_count; index++) {
+        mvn_path_free(&query->paths[index]);
+    }
+    MVN_DS_FREE(query->paths);
+}
+
+/**
+ * @internal
+ * @brief Shared body of mvn_group_by and mvn_group_by_parallel.
+ */
+static mvn_arr_t *mvn_group_run(mvn_pool_t      *pool,
+                                const mvn_arr_t *records,
+                                const char      *key_path,
+                                const mvn_agg_t *aggregations,
+                                size_t           aggregation_count)
+{
+    mvn_group_query_t query;
+    if (!mvn_group_query_init(&query, records, key_path, aggregations, aggregation_count)) {
+        mvn_group_query_free(&query);
+        return NULL;
+    }
+
+    size_t part_count = 1;
+    if (pool != NULL) {
+        size_t most    = records->count / MVN_DS_GROUP_PARTITION_ROWS;
+        size_t threads = mvn_pool_thread_count(pool);
+        part_count     = most < threads ? most : threads;
+        part_count     = part_count > 0 ? part_count : 1;
+    }
+    mvn_group_part_t *parts = (mvn_group_part_t *)MVN_DS_CALLOC(part_count, sizeof(*parts));
+    bool              ok    = parts != NULL;
+    for (size_t index = 0; ok && index < part_count; index++) {
+        parts[index].query = &query;
+        parts[index].begin = records->count * index / part_count;
+        parts[index].end   = records->count * (index + 1) / part_count;
+        parts[index].ok    = mvn_group_table_init(&parts[index].table, aggregation_count);
+        ok                 = parts[index].ok;
+    }
+
+    if (ok && part_count == 1) {
+        mvn_group_part_run(&parts[0]);
+    } else if (ok) {
+        ok = mvn_pool_parallel_for(pool, 0, part_count, 1, mvn_group_part_range, parts);
+    }
+    for (size_t index = 0; ok && index < part_count; index++) {
+        ok = parts[index].ok;
+    }
+    for (size_t index = 1; ok && index < part_count; index++) {
+        ok = mvn_group_merge(&parts[0].table, &parts[index].table, &query);
+    }
+    mvn_arr_t *results = ok ? mvn_group_results(&parts[0].table, &query) : NULL;
+
+    for (size_t index = 0; parts != NULL && index < part_count; index++) {
+        mvn_group_table_free(&parts[index].table, aggregation_count);
+    }
+    MVN_DS_FREE(parts);
+    mvn_group_query_free(&query);
+    if (results == NULL) {
+        fprintf(stderr, "[MVN_DS_GROUP] Failed to group records.\n");
+    }
+    return results;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Groups records by the value at key_path in one pass. Each record costs one key path
+ * lookup (with pre-hashed field names), one mvn_val_hash and one probe of an open-addressing
+ * table, plus one path lookup per aggregation.
+ * @param records Array of records (hash maps or frozen maps). Not modified.
+ * @param key_path Dot-separated path of the grouping field.
+ * @param aggregations Aggregations to compute. Can be NULL if aggregation_count is 0.
+ * @param aggregation_count Number of aggregations.
+ * @return A new array of group records owned by the caller, or NULL on failure.
+ */
+mvn_arr_t *mvn_group_by(const mvn_arr_t *records,
+                        const char      *key_path,
+                        const mvn_agg_t *aggregations,
+                        size_t           aggregation_count)
+{
+    return mvn_group_run(NULL, records, key_path, aggregations, aggregation_count);
+}
+
+/**
+ * @brief Groups records like mvn_group_by, with one partition of contiguous records per pool
+ * thread (each at least MVN_DS_GROUP_PARTITION_ROWS records). Partitions are grouped into
+ * private tables in parallel, so the threads share nothing but the read-only records, and the
+ * tables are then merged in partition order on the calling thread.
+ * @param pool Pool to run the partitions on. NULL groups on the calling thread.
+ * @param records Array of records (hash maps or frozen maps). Not modified.
+ * @param key_path Dot-separated path of the grouping field.
+ * @param aggregations Aggregations to compute. Can be NULL if aggregation_count is 0.
+ * @param aggregation_count Number of aggregations.
+ * @return A new array of group records owned by the caller, or NULL on failure.
+ */
+mvn_arr_t *mvn_group_by_parallel(mvn_pool_t      *pool,
+                                 const mvn_arr_t *records,
+                                 const char      *key_path,
+                                 const mvn_agg_t *aggregations,
+                                 size_t           aggregation_count)
+{
+    return mvn_group_run(pool, records, key_path, aggregations, aggregation_count);
+}
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_HEAP // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_heap.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_compare, mvn_val_free, mvn_val_null
+#include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_free
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_REALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h> // For SIZE_MAX
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Default ordering: mvn_val_compare, which makes the heap a min-heap.
+ */
+static int mvn_heap_default_compare(const mvn_val_t *a, const mvn_val_t *b, void *context)
+{
+    (void)context;
+    return mvn_val_compare(a, b);
+}
+
+/**
+ * @internal
+ * @brief Grows the slot and position tables. The new slots are empty and receive the new
+ * handles [capacity, new_capacity), which are free.
+ * @return true on success, false on allocation failure (the heap is unchanged).
+ */
+static bool mvn_heap_adjust_capacity(mvn_heap_t *heap, size_t new_capacity)
+{
+    if (new_capacity > SIZE_MAX / sizeof(mvn_heap_entry_t)) {
+        fprintf(stderr, "[MVN_DS_HEAP] Heap capacity overflow during resize.\n");
+        return false;
+    }
+    mvn_heap_entry_t *new_entries = (mvn_heap_entry_t *)MVN_DS_REALLOC(
+        heap->entries, new_capacity * sizeof(mvn_heap_entry_t));
+    if (new_entries == NULL) {
+        fprintf(stderr, "[MVN_DS_HEAP] Heap resize failed - out of memory.\n");
+        return false;
+    }
+    heap->entries = new_entries;
+
+    size_t *new_positions =
+        (size_t *)MVN_DS_REALLOC(heap->positions, new_capacity * sizeof(size_t));
+    if (new_positions == NULL) {
+        // The larger slot table is kept; capacity still describes both tables correctly
+        fprintf(stderr, "[MVN_DS_HEAP] Heap resize failed - out of memory.\n");
+        return false;
+    }
+    heap->positions = new_positions;
+
+    for (size_t index = heap->capacity; index < new_capacity; index++) {
+        heap->entries[index].value  = mvn_val_null();
+        heap->entries[index].handle = index;
+        heap->positions[index]      = index;
+    }
+    heap->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Moves the entry at index towards the root until its parent does not compare higher.
+ * The entry is held aside and parents are shifted down into the hole, so each level costs one
+ * copy instead of a swap.
+ * @return The entry's final index.
+ */
+static size_t mvn_heap_sift_up(mvn_heap_t *heap, size_t index)
+{
+    mvn_heap_entry_t entry = heap->entries[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / heap->arity;
+        if (heap->compare(&entry.value, &heap->entries[parent].value, heap->context) >= 0) {
+            break;
+        }
+        heap->entries[index]                         = heap->entries[parent];
+        heap->positions[heap->entries[index].handle] = index;
+        index                                        = parent;
+    }
+    heap->entries[index]          = entry;
+    heap->positions[entry.handle] = index;
+    return index;
+}
+
+/**
+ * @internal
+ * @brief Moves the entry at index towards the leaves until no child compares lower than it.
+ */
+static void mvn_heap_sift_down(mvn_heap_t *heap, size_t index)
+{
+    mvn_heap_entry_t entry = heap->entries[index];
+    // A node has children while arity * index + 1 < count; written to avoid overflow
+    while (heap->count >= 2 && index <= (heap->count - 2) / heap->arity) {
+        size_t first = heap->arity * index + 1;
+        size_t last  = heap->count - first > heap->arity ? first + heap->arity : heap->count;
+        size_t best  = first;
+        for (size_t child = first + 1; child < last; child++) {
+            if (heap->compare(&heap->entries[child].value,
+                              &heap->entries[best].value,
+                              heap->context) < 0) {
+                best = child;
+            }
+        }
+        if (heap->compare(&heap->entries[best].value, &entry.value, heap->context) >= 0) {
+            break;
+        }
+        heap->entries[index]                         = heap->entries[best];
+        heap->positions[heap->entries[index].handle] = index;
+        index                                        = best;
+    }
+    heap->entries[index]          = entry;
+    heap->positions[entry.handle] = index;
+}
+
+/**
+ * @internal
+ * @brief Swaps two slots, keeping the position table in sync.
+ */
+static void mvn_heap_swap(mvn_heap_t *heap, size_t first, size_t second)
+{
+    mvn_heap_entry_t entry                        = heap->entries[first];
+    heap->entries[first]                          = heap->entries[second];
+    heap->entries[second]                         = entry;
+    heap->positions[heap->entries[first].handle]  = first;
+    heap->positions[heap->entries[second].handle] = second;
+}
+
+/**
+ * @internal
+ * @brief Takes the element at index out of the heap. It is swapped with the last element,
+ * which then moves up or down to its place; the freed slot (and handle) ends up at count.
+ * @param heap The heap.
+ * @param index The slot to remove, below count.
+ * @param out Receives the element, or NULL to free it.
+ */
+static void mvn_heap_take(mvn_heap_t *heap, size_t index, mvn_val_t *out)
+{
+    size_t last = heap->count - 1;
+    mvn_heap_swap(heap, index, last);
+    heap->count--;
+
+    mvn_val_t value           = heap->entries[last].value;
+    heap->entries[last].value = mvn_val_null();
+    if (out != NULL) {
+        *out = value;
+    } else {
+        mvn_val_free(&value);
+    }
+
+    if (index < heap->count) {
+        mvn_heap_sift_down(heap, mvn_heap_sift_up(heap, index));
+    }
+}
+
+/**
+ * @internal
+ * @brief Returns the slot of a handle in use, or SIZE_MAX if it is not in use.
+ */
+static size_t mvn_heap_slot(const mvn_heap_t *heap, size_t handle)
+{
+    if (heap == NULL || handle >= heap->capacity || heap->positions[handle] >= heap->count) {
+        return SIZE_MAX;
+    }
+    return heap->positions[handle];
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Creates a new, empty heap.
+ * @param arity Children per node; 0 selects MVN_DS_HEAP_DEFAULT_ARITY, otherwise at least 2.
+ * @param compare Element order, or NULL for mvn_val_compare. The lowest element is on top.
+ * @param context Passed to compare. Not owned.
+ * @return A pointer to the new heap, or NULL on allocation failure or invalid arity.
+ */
+mvn_heap_t *mvn_heap_new(size_t arity, mvn_heap_compare_fn compare, void *context)
+{
+    if (arity == 1) {
+        return NULL;
+    }
+    mvn_heap_t *heap = (mvn_heap_t *)MVN_DS_MALLOC(sizeof(mvn_heap_t));
+    if (heap == NULL) {
+        fprintf(stderr, "[MVN_DS_HEAP] Failed to allocate heap structure.\n");
+        return NULL;
+    }
+    heap->count     = 0;
+    heap->capacity  = 0;
+    heap->arity     = arity != 0 ? arity : MVN_DS_HEAP_DEFAULT_ARITY;
+    heap->entries   = NULL;
+    heap->positions = NULL;
+    heap->compare   = compare != NULL ? compare : mvn_heap_default_compare;
+    heap->context   = context;
+    return heap;
+}
+
+/**
+ * @brief Builds a heap from an array in O(n) (Floyd's method): every node with children is
+ * sifted down, from the last one back to the root.
+ * @param array The elements. Consumed on success; element i gets handle i.
+ * @param arity Children per node; 0 selects MVN_DS_HEAP_DEFAULT_ARITY, otherwise at least 2.
+ * @param compare Element order, or NULL for mvn_val_compare.
+ * @param context Passed to compare. Not owned.
+ * @return The new heap, or NULL on allocation failure or invalid input (the array is
+ *         untouched in that case).
+ */
+mvn_heap_t *
+mvn_heap_from_arr(mvn_arr_t *array, size_t arity, mvn_heap_compare_fn compare, void *context)
+{
+    if (array == NULL) {
+        return NULL;
+    }
+    mvn_heap_t *heap = mvn_heap_new(arity, compare, context);
+    if (heap == NULL) {
+        return NULL;
+    }
+    size_t capacity =
+        array->count > MVN_DS_HEAP_INITIAL_CAPACITY ? array->count : MVN_DS_HEAP_INITIAL_CAPACITY;
+    if (!mvn_heap_adjust_capacity(heap, capacity)) {
+        mvn_heap_free(heap);
+        return NULL;
+    }
+
+    for (size_t index = 0; index < array->count; index++) {
+        heap->entries[index].value = array->data[index];
+    }
+    heap->count = array->count;
+    if (heap->count >= 2) {
+        for (size_t index = (heap->count - 2) / heap->arity + 1; index-- > 0;) {
+            mvn_heap_sift_down(heap, index);
+        }
+    }
+
+    // The elements now belong to the heap; free the array without them
+    array->count = 0;
+    mvn_arr_free(array);
+    return heap;
+}
+
+/**
+ * @brief Frees the heap, including all of its elements.
+ * @param heap The heap to free. If NULL, the function does nothing.
+ */
+void mvn_heap_free(mvn_heap_t *heap)
+{
+    if (heap == NULL) {
+        return;
+    }
+    for (size_t index = 0; index < heap->count; index++) {
+        mvn_val_free(&heap->entries[index].value);
+    }
+    MVN_DS_FREE(heap->entries);
+    MVN_DS_FREE(heap->positions);
+    MVN_DS_FREE(heap);
+}
+
+/**
+ * @brief Adds an element to the heap in O(log n).
+ * @param heap The heap. Must not be NULL.
+ * @param value The element. Ownership is transferred to the heap.
+ * @param[out] handle Receives the element's handle. May be NULL.
+ * @return true on success, false on allocation failure or invalid input (value is freed).
+ */
+bool mvn_heap_push(mvn_heap_t *heap, mvn_val_t value, size_t *handle)
+{
+    if (heap == NULL) {
+        mvn_val_free(&value);
+        return false;
+    }
+    if (heap->count == heap->capacity) {
+        size_t new_capacity =
+            heap->capacity == 0 ? MVN_DS_HEAP_INITIAL_CAPACITY : heap->capacity * 2;
+        if (new_capacity < heap->capacity || !mvn_heap_adjust_capacity(heap, new_capacity)) {
+            mvn_val_free(&value);
+            return false;
+        }
+    }
+
+    // The slot past the last element holds a free handle
+    size_t index               = heap->count++;
+    heap->entries[index].value = value;
+    if (handle != NULL) {
+        *handle = heap->entries[index].handle;
+    }
+    mvn_heap_sift_up(heap, index);
+    return true;
+}
+
+/**
+ * @brief Returns the top element without removing it.
+ * @param heap The heap.
+ * @return A pointer to the element (owned by the heap), or NULL if the heap is empty or NULL.
+ */
+const mvn_val_t *mvn_heap_peek(const mvn_heap_t *heap)
+{
+    if (heap == NULL || heap->count == 0) {
+        return NULL;
+    }
+    return &heap->entries[0].value;
+}
+
+/**
+ * @brief Removes the top element in O(log n).
+ * @param heap The heap.
+ * @param[out] out Receives the element; ownership passes to the caller. If NULL, the element
+ *             is freed.
+ * @return true if an element was removed, false if the heap is empty or NULL.
+ */
+bool mvn_heap_pop(mvn_heap_t *heap, mvn_val_t *out)
+{
+    if (heap == NULL || heap->count == 0) {
+        return false;
+    }
+    mvn_heap_take(heap, 0, out);
+    return true;
+}
+
+/**
+ * @brief Returns the element with the given handle.
+ * @param heap The heap.
+ * @param handle A handle returned by mvn_heap_push, or an index given to mvn_heap_from_arr.
+ * @return A pointer to the element (owned by the heap), or NULL if the handle is not in use.
+ */
+const mvn_val_t *mvn_heap_get(const mvn_heap_t *heap, size_t handle)
+{
+    size_t index = mvn_heap_slot(heap, handle);
+    return index != SIZE_MAX ? &heap->entries[index].value : NULL;
+}
+
+/**
+ * @brief Replaces the element with the given handle and restores the heap order in O(log n).
+ * Works for both a decrease-key and an increase-key; the handle stays the same.
+ * @param heap The heap.
+ * @param handle The element's handle.
+ * @param value The new element. Ownership is transferred; the old element is freed.
+ * @return true on success, false if the handle is not in use (value is freed).
+ */
+bool mvn_heap_update(mvn_heap_t *heap, size_t handle, mvn_val_t value)
+{
+    size_t index = mvn_heap_slot(heap, handle);
+    if (index == SIZE_MAX) {
+        mvn_val_free(&value);
+        return false;
+    }
+    mvn_val_free(&heap->entries[index].value);
+    heap->entries[index].value = value;
+    mvn_heap_sift_down(heap, mvn_heap_sift_up(heap, index));
+    return true;
+}
+
+/**
+ * @brief Removes the element with the given handle in O(log n).
+ * @param heap The heap.
+ * @param handle The element's handle.
+ * @param[out] out Receives the element; ownership passes to the caller. If NULL, the element
+ *             is freed.
+ * @return true if the element was removed, false if the handle is not in use.
+ */
+bool mvn_heap_remove(mvn_heap_t *heap, size_t handle, mvn_val_t *out)
+{
+    size_t index = mvn_heap_slot(heap, handle);
+    if (index == SIZE_MAX) {
+        return false;
+    }
+    mvn_heap_take(heap, index, out);
+    return true;
+}
+
+/**
+ * @brief Returns the number of elements in the heap.
+ * @param heap The heap.
+ * @return The number of elements, or 0 if heap is NULL.
+ */
+size_t mvn_heap_count(const mvn_heap_t *heap)
+{
+    return heap != NULL ? heap->count : 0;
+}
@@ -1,18 +1,24 @@
 /*
  * Copyright (c) 2024 Jake Larson
  */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_HMAP // Allocation statistics category
+
 #include "mvn_ds/mvn_ds_hmap.h"
 
 #include "mvn_ds/mvn_ds.h"       // For mvn_val_free, mvn_val_deep_copy, mvn_val_str_take
 #include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_new_capacity, mvn_arr_push
-#include "mvn_ds/mvn_ds_str.h"   // For mvn_str_free, mvn_str_new, mvn_str_hash
+#include "mvn_ds/mvn_ds_bloom.h" // For the optional key filter
+#include "mvn_ds/mvn_ds_str.h"   // For mvn_str_free, mvn_str_new, mvn_str_hash*
 #include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_FREE, MVN_DS_CALLOC
+#include "mvn_ds_thread.h"       // For the atomics guarding the random seed secret
+#include "mvn_ds_trace.h"        // For resize and large allocation tracepoints
 
 #include <assert.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h> // For SIZE_MAX
 #include <string.h> // For strcmp, strlen
+#include <time.h>   // For time, clock (random seed entropy)
 
 // --- Static Helper Functions ---
 
@@ -68,11 +74,14 @@ static bool mvn_hmap_adjust_capacity(mvn_hmap_t *hmap, size_t new_capacity)
     }
     size_t allocation_size = new_capacity * sizeof(mvn_hmap_entry_t *);
 
+    MVN_DS_TRACE4(hmap_resize_start, hmap, hmap->capacity, new_capacity, hmap->count);
+    MVN_DS_TRACE_ALLOCATION(allocation_size, MVN_DS_ALLOC_KIND);
     // Allocate new bucket array, initialized to NULL
     mvn_hmap_entry_t **new_buckets = (mvn_hmap_entry_t **)MVN_DS_CALLOC(1, allocation_size);
     if (new_buckets == NULL) {
         // Allocation failed, keep the old table. This is problematic.
         fprintf(stderr, "[MVN_DS_HMAP] Hash map resize failed - out of memory.\n");
+        MVN_DS_TRACE3(hmap_resize_done, hmap, new_capacity, 0);
         return false; // Indicate failure
     }
 
@@ -112,9 +121,132 @@ static bool mvn_hmap_adjust_capacity(mvn_hmap_t *hmap, size_t new_capacity)
     hmap->buckets  = new_buckets;
     hmap->capacity = new_capacity;
 
+    MVN_DS_TRACE3(hmap_resize_done, hmap, new_capacity, 1);
     return true;
 }
 
+/**
+ * @internal
+ * @brief splitmix64 finalizer; spreads every input bit over the whole output.
+ */
+static uint64_t mvn_hmap_mix(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+/**
+ * @internal
+ * @brief Returns a fresh seed for mvn_hmap_new_randomized.
+ * A process-wide secret is read once from /dev/urandom where available (otherwise derived from
+ * the clock and addresses, which ASLR randomizes) and mixed with a per-call counter, so every
+ * map gets a different, unpredictable seed.
+ */
+static uint64_t mvn_hmap_random_seed(const void *salt)
+{
+    static volatile size_t secret  = 0;
+    static volatile size_t counter = 0;
+
+    size_t current = mvn_atomic_load_acquire_size(&secret);
+    if (current == 0) {
+        uint64_t entropy = 0;
+        FILE    *source  = fopen("/dev/urandom", "rb");
+        if (source != NULL) {
+            if (fread(&entropy, sizeof(entropy), 1, source) != 1) {
+                entropy = 0;
+            }
+            fclose(source);
+        }
+        entropy ^= mvn_hmap_mix((uint64_t)time(NULL) ^ ((uint64_t)clock() << 32) ^
+                                (uint64_t)(uintptr_t)&secret);
+        size_t candidate = (size_t)mvn_hmap_mix(entropy) | 1U; // Never 0 (uninitialized)
+        // If another thread won the race, use its secret
+        if (mvn_atomic_cas_size(&secret, 0, candidate)) {
+            current = candidate;
+        } else {
+            current = mvn_atomic_load_acquire_size(&secret);
+        }
+    }
+    size_t sequence = mvn_atomic_fetch_add_size(&counter, 1);
+    return mvn_hmap_mix((uint64_t)current ^ mvn_hmap_mix((uint64_t)sequence) ^
+                        (uint64_t)(uintptr_t)salt);
+}
+
+/**
+ * @internal
+ * @brief Wraps a C string in a borrowed string header without allocating.
+ * @param key_cstr The characters. Must outlive the returned header, which is only read.
+ */
+static mvn_str_t mvn_hmap_cstr_key(const char *key_cstr)
+{
+    size_t length = strlen(key_cstr);
+    return (mvn_str_t){.length = length, .capacity = length, .data = (char *)key_cstr};
+}
+
+/**
+ * @internal
+ * @brief Widens a 32-bit key hash to the 64 well-mixed bits the filter expects.
+ */
+static uint64_t mvn_hmap_filter_hash(uint32_t hash)
+{
+    return mvn_hmap_mix((uint64_t)hash);
+}
+
+/**
+ * @internal
+ * @brief Builds a filter holding the hash of every key in the map.
+ * @param hmap The hash map.
+ * @param capacity Number of keys the filter is sized for.
+ * @param false_positive_rate Target rate, as for mvn_bloom_new.
+ * @return The new filter, or NULL on failure.
+ */
+static mvn_bloom_t *
+mvn_hmap_build_filter(const mvn_hmap_t *hmap, size_t capacity, double false_positive_rate)
+{
+    mvn_bloom_t *filter = mvn_bloom_new(capacity, false_positive_rate);
+    if (filter == NULL) {
+        return NULL;
+    }
+    for (size_t index = 0; index < hmap->capacity; index++) {
+        for (const mvn_hmap_entry_t *entry = hmap->buckets[index]; entry != NULL;
+             entry                         = entry->next) {
+            mvn_bloom_add_hash(filter, mvn_hmap_filter_hash(entry->hash));
+        }
+    }
+    return filter;
+}
+
+/**
+ * @internal
+ * @brief Records a newly inserted key in the filter. A full filter is rebuilt from the live
+ * keys, sized for twice as many, which also drops the bits of deleted keys; so insert/delete
+ * churn does not grow it. If the rebuild fails the key goes into the old filter: lookups get
+ * less selective but never miss a present key.
+ * @param hmap The hash map, with the new entry already linked in.
+ * @param hash The hash of the new key.
+ */
+static void mvn_hmap_filter_insert(mvn_hmap_t *hmap, uint32_t hash)
+{
+    mvn_bloom_t *filter = hmap->filter;
+    if (filter->count >= filter->capacity && hmap->count <= SIZE_MAX / 2) {
+        size_t capacity = hmap->count * 2 > MVN_DS_HMAP_INITIAL_CAPACITY
+                              ? hmap->count * 2
+                              : MVN_DS_HMAP_INITIAL_CAPACITY;
+        mvn_bloom_t *rebuilt =
+            mvn_hmap_build_filter(hmap, capacity, filter->false_positive_rate);
+        if (rebuilt != NULL) {
+            mvn_bloom_free(filter);
+            hmap->filter = rebuilt;
+            return;
+        }
+    }
+    mvn_bloom_add_hash(filter, mvn_hmap_filter_hash(hash));
+}
+
 // --- Hash Map Implementation ---
 
 /**
@@ -129,7 +261,10 @@ mvn_hmap_t *mvn_hmap_new_capacity(size_t capacity)
         return NULL;
     }
 
-    hmap_ptr->count = 0;
+    hmap_ptr->count  = 0;
+    hmap_ptr->seed   = 0;
+    hmap_ptr->seeded = false;
+    hmap_ptr->filter = NULL;
     // Use provided capacity directly. If 0, buckets will be NULL.
     hmap_ptr->capacity = capacity;
 
@@ -142,7 +277,8 @@ mvn_hmap_t *mvn_hmap_new_capacity(size_t capacity)
             return NULL;
         }
         size_t allocation_size = hmap_ptr->capacity * sizeof(mvn_hmap_entry_t *);
-        hmap_ptr->buckets      = (mvn_hmap_entry_t **)MVN_DS_CALLOC(1, allocation_size);
+        MVN_DS_TRACE_ALLOCATION(allocation_size, MVN_DS_ALLOC_KIND);
+        hmap_ptr->buckets = (mvn_hmap_entry_t **)MVN_DS_CALLOC(1, allocation_size);
         if (hmap_ptr->buckets == NULL) {
             MVN_DS_FREE(hmap_ptr);
             return NULL;
@@ -153,6 +289,39 @@ mvn_hmap_t *mvn_hmap_new_capacity(size_t capacity)
     return hmap_ptr;
 }
 
+/**
+ * @brief Creates a new, empty hash map whose keys are hashed with SipHash-1-3.
+ * The seed is expanded into the 128-bit SipHash key. Without the seed, an attacker cannot
+ * precompute keys that share a bucket, so chains stay short even for hostile input. Seeded
+ * hashing costs more per key than FNV-1a; prefer mvn_hmap_new for trusted keys.
+ * @param capacity The initial number of buckets. If 0, allocation happens on first insert.
+ * @param seed The hash seed. Keep it secret if keys are untrusted.
+ * @return A pointer to the new mvn_hmap_t, or NULL on allocation failure.
+ */
+mvn_hmap_t *mvn_hmap_new_seeded(size_t capacity, uint64_t seed)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new_capacity(capacity);
+    if (hmap != NULL) {
+        hmap->seed   = seed;
+        hmap->seeded = true;
+    }
+    return hmap;
+}
+
+/**
+ * @brief Creates a new, empty seeded hash map with a random per-map seed.
+ * @param capacity The initial number of buckets. If 0, allocation happens on first insert.
+ * @return A pointer to the new mvn_hmap_t, or NULL on allocation failure.
+ */
+mvn_hmap_t *mvn_hmap_new_randomized(size_t capacity)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new_seeded(capacity, 0);
+    if (hmap != NULL) {
+        hmap->seed = mvn_hmap_random_seed(hmap);
+    }
+    return hmap;
+}
+
 /**
  * @brief Creates a new, empty hash map with a default initial capacity.
  * Uses MVN_DS_HMAP_INITIAL_CAPACITY defined in the header.
@@ -189,9 +358,27 @@ void mvn_hmap_free(mvn_hmap_t *hmap)
         }
         MVN_DS_FREE(hmap->buckets); // Free the bucket array
     }
+    mvn_bloom_free(hmap->filter);
     MVN_DS_FREE(hmap); // Free the map struct
 }
 
+/**
+ * @brief Returns the hash the map uses to place key.
+ * FNV-1a for ordinary maps; for seeded maps, SipHash-1-3 folded to 32 bits.
+ * @param hmap The hash map. Must not be NULL.
+ * @param key The key. Can be NULL (hashes to 0).
+ * @return The 32-bit bucket hash.
+ */
+uint32_t mvn_hmap_hash_key(const mvn_hmap_t *hmap, const mvn_str_t *key)
+{
+    if (!hmap->seeded) {
+        return mvn_str_hash(key);
+    }
+    // The second key word is derived from the seed so one 64-bit value configures the map
+    uint64_t hash_value = mvn_str_hash_seeded(key, hmap->seed, mvn_hmap_mix(hmap->seed));
+    return (uint32_t)(hash_value ^ (hash_value >> 32));
+}
+
 /**
  * @brief Sets a key-value pair in the hash map using an owned mvn_str_t key.
  * Takes ownership of the key string and the value's dynamic data.
@@ -247,7 +434,7 @@ bool mvn_hmap_set(mvn_hmap_t *hmap, mvn_str_t *key, mvn_val_t value)
     }
 
     // Calculate hash and index
-    uint32_t hash_value = mvn_str_hash(key);
+    uint32_t hash_value = mvn_hmap_hash_key(hmap, key);
     size_t   index      = hash_value % hmap->capacity;
 
     // Check if key already exists in the bucket chain
@@ -276,6 +463,9 @@ bool mvn_hmap_set(mvn_hmap_t *hmap, mvn_str_t *key, mvn_val_t value)
         new_entry->next      = hmap->buckets[index];
         hmap->buckets[index] = new_entry;
         hmap->count++;
+        if (hmap->filter != NULL) {
+            mvn_hmap_filter_insert(hmap, hash_value);
+        }
         return true;
     }
 }
@@ -339,10 +529,30 @@ mvn_val_t *mvn_hmap_get(const mvn_hmap_t *hmap, const mvn_str_t *key)
         return NULL;
     }
 
-    uint32_t hash_value = mvn_str_hash(key);
-    size_t   index      = hash_value % hmap->capacity;
+    return mvn_hmap_get_hashed(hmap, key, mvn_hmap_hash_key(hmap, key));
+}
 
-    mvn_hmap_entry_t *entry = mvn_hmap_find_entry(hmap->buckets[index], key, hash_value, NULL);
+/**
+ * @brief Retrieves a pointer to the value for a key whose hash the caller already computed.
+ * Unseeded maps all hash a key the same way (FNV-1a), so one hash serves every such map.
+ * Does not transfer ownership. Returns NULL if the key is not found or map/key is NULL.
+ * @param hmap The hash map to search.
+ * @param key The key to look up.
+ * @param hash The key's hash for this map, as returned by mvn_hmap_hash_key.
+ * @return A pointer to the mvn_val_t associated with the key, or NULL if not found.
+ */
+mvn_val_t *mvn_hmap_get_hashed(const mvn_hmap_t *hmap, const mvn_str_t *key, uint32_t hash)
+{
+    if (hmap == NULL || key == NULL || hmap->capacity == 0 || hmap->buckets == NULL) {
+        return NULL;
+    }
+    if (hmap->filter != NULL &&
+        !mvn_bloom_contains_hash(hmap->filter, mvn_hmap_filter_hash(hash))) {
+        return NULL; // Definite miss; the buckets are never touched
+    }
+    size_t index = hash % hmap->capacity;
+
+    mvn_hmap_entry_t *entry = mvn_hmap_find_entry(hmap->buckets[index], key, hash, NULL);
 
     return (entry != NULL) ? &entry->value : NULL;
 }
@@ -360,22 +570,9 @@ mvn_val_t *mvn_hmap_cstr(const mvn_hmap_t *hmap, const char *key_cstr)
         return NULL;
     }
 
-    // Create a temporary heap-allocated key for lookup
-    mvn_str_t *temp_key_ptr = mvn_str_new(key_cstr);
-    if (temp_key_ptr == NULL) {
-        fprintf(stderr, "[MVN_DS_HMAP] Failed to allocate temporary key for get_cstr.\n");
-        return NULL; // Allocation failure
-    }
-
-    uint32_t hash_value = mvn_str_hash(temp_key_ptr);
-    size_t   index      = hash_value % hmap->capacity;
-
-    mvn_hmap_entry_t *entry =
-        mvn_hmap_find_entry(hmap->buckets[index], temp_key_ptr, hash_value, NULL);
-
-    mvn_str_free(temp_key_ptr); // Free the temporary key
-
-    return (entry != NULL) ? &entry->value : NULL;
+    // Borrow the characters for the lookup instead of copying them
+    mvn_str_t temp_key = mvn_hmap_cstr_key(key_cstr);
+    return mvn_hmap_get(hmap, &temp_key);
 }
 
 /**
@@ -391,8 +588,12 @@ bool mvn_hmap_delete(mvn_hmap_t *hmap, const mvn_str_t *key)
         return false;
     }
 
-    uint32_t hash_value = mvn_str_hash(key);
-    size_t   index      = hash_value % hmap->capacity;
+    uint32_t hash_value = mvn_hmap_hash_key(hmap, key);
+    if (hmap->filter != NULL &&
+        !mvn_bloom_contains_hash(hmap->filter, mvn_hmap_filter_hash(hash_value))) {
+        return false; // Definite miss
+    }
+    size_t index = hash_value % hmap->capacity;
 
     mvn_hmap_entry_t *prev_entry = NULL;
     mvn_hmap_entry_t *entry =
@@ -433,19 +634,9 @@ bool mvn_hmap_delete_cstr(mvn_hmap_t *hmap, const char *key_cstr)
         return false;
     }
 
-    // Create a temporary heap-allocated key for lookup
-    mvn_str_t *temp_key_ptr = mvn_str_new(key_cstr);
-    if (temp_key_ptr == NULL) {
-        fprintf(stderr, "[MVN_DS_HMAP] Failed to allocate temporary key for delete_cstr.\n");
-        return false; // Allocation failure
-    }
-
-    // Call the primary delete function using the temporary key
-    bool deleted = mvn_hmap_delete(hmap, temp_key_ptr);
-
-    mvn_str_free(temp_key_ptr); // Free the temporary key
-
-    return deleted;
+    // Borrow the characters for the lookup instead of copying them
+    mvn_str_t temp_key = mvn_hmap_cstr_key(key_cstr);
+    return mvn_hmap_delete(hmap, &temp_key);
 }
 
 /**
@@ -490,6 +681,16 @@ bool mvn_hmap_is_empty(const mvn_hmap_t *hmap)
     return hmap->count == 0;
 }
 
+/**
+ * @brief Checks if the hash map uses seeded (SipHash-1-3) key hashing.
+ * @param hmap The hash map. Can be NULL.
+ * @return true if the map is seeded, false otherwise or if the map is NULL.
+ */
+bool mvn_hmap_is_seeded(const mvn_hmap_t *hmap)
+{
+    return hmap != NULL && hmap->seeded;
+}
+
 /**
  * @brief Checks if the hash map contains the given mvn_str_t key.
  * @param hmap The hash map. Can be NULL.
@@ -543,6 +744,7 @@ void mvn_hmap_clear(mvn_hmap_t *hmap)
         hmap->buckets[i] = NULL; // Clear the bucket pointer
     }
     hmap->count = 0;
+    mvn_bloom_clear(hmap->filter);
 }
 
 /**
@@ -631,3 +833,56 @@ size_t mvn_hmap_size(const mvn_hmap_t *hmap)
 {
     return mvn_hmap_count(hmap);
 }
+
+/**
+ * @brief Attaches a Bloom filter over the map's keys. Lookups and deletes of keys the filter
+ * rules out return at once without touching the bucket array, which pays off when most
+ * lookups miss. Each insert of a new key costs one more filter update. Deleted keys stay in
+ * the filter until it is next rebuilt, which happens whenever it fills up.
+ * Replaces a filter that is already attached.
+ * @param hmap The hash map.
+ * @param false_positive_rate Target false-positive rate in (0, 1), or 0 for
+ * MVN_DS_BLOOM_DEFAULT_FALSE_POSITIVE_RATE.
+ * @return true on success, false on allocation failure or invalid input (the map keeps its
+ * previous filter, if any).
+ */
+bool mvn_hmap_attach_filter(mvn_hmap_t *hmap, double false_positive_rate)
+{
+    if (hmap == NULL) {
+        return false;
+    }
+    size_t capacity = hmap->count > hmap->capacity ? hmap->count : hmap->capacity;
+    if (capacity < MVN_DS_HMAP_INITIAL_CAPACITY) {
+        capacity = MVN_DS_HMAP_INITIAL_CAPACITY;
+    }
+    mvn_bloom_t *filter = mvn_hmap_build_filter(hmap, capacity, false_positive_rate);
+    if (filter == NULL) {
+        return false;
+    }
+    mvn_bloom_free(hmap->filter);
+    hmap->filter = filter;
+    return true;
+}
+
+/**
+ * @brief Detaches and frees the map's Bloom filter, if any.
+ * @param hmap The hash map. Can be NULL.
+ */
+void mvn_hmap_detach_filter(mvn_hmap_t *hmap)
+{
+    if (hmap == NULL) {
+        return;
+    }
+    mvn_bloom_free(hmap->filter);
+    hmap->filter = NULL;
+}
+
+/**
+ * @brief Checks if the hash map has a Bloom filter attached.
+ * @param hmap The hash map. Can be NULL.
+ * @return true if a filter is attached, false otherwise or if the map is NULL.
+ */
+bool mvn_hmap_has_filter(const mvn_hmap_t *hmap)
+{
+    return hmap != NULL && hmap->filter != NULL;
+}
@@ -0,0 +1,560 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_HSET // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_hset.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_hash, mvn_val_equal, mvn_val_deep_copy
+#include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_new_capacity, mvn_arr_push
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h> // For SIZE_MAX
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Hashes an element for the slot table. 0 marks empty slots, so it is remapped to 1.
+ */
+static uint64_t mvn_hset_hash(const mvn_val_t *value)
+{
+    uint64_t hash = mvn_val_hash(value);
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * @internal
+ * @brief Returns the smallest power-of-two slot count that holds count elements within the
+ * load factor, or 0 on overflow.
+ */
+static size_t mvn_hset_capacity_for(size_t count)
+{
+    size_t capacity = MVN_DS_HSET_INITIAL_CAPACITY;
+    while ((double)count > (double)capacity * MVN_DS_HSET_LOAD_FACTOR) {
+        if (capacity > SIZE_MAX / 2 / sizeof(mvn_hset_slot_t)) {
+            return 0;
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * @internal
+ * @brief Linear probe for value starting at its home slot.
+ * @param hset The set. Its capacity must be non-zero.
+ * @param value The element to look for.
+ * @param hash The element's slot hash (mvn_hset_hash).
+ * @param[out] found Set to whether the returned slot holds an equal element.
+ * @return The slot holding the element, or the empty slot where it would be inserted.
+ */
+static size_t
+mvn_hset_probe(const mvn_hset_t *hset, const mvn_val_t *value, uint64_t hash, bool *found)
+{
+    size_t mask = hset->capacity - 1;
+    size_t slot = (size_t)hash & mask;
+    while (hset->slots[slot].hash != 0) {
+        // Check the stored hash first; full comparison may walk nested containers
+        if (hset->slots[slot].hash == hash && mvn_val_equal(&hset->slots[slot].value, value)) {
+            *found = true;
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    *found = false;
+    return slot;
+}
+
+/**
+ * @internal
+ * @brief Looks up value with a precomputed hash.
+ * @return Whether an equal element is present. False for a set without slots.
+ */
+static bool mvn_hset_contains_hashed(const mvn_hset_t *hset, const mvn_val_t *value, uint64_t hash)
+{
+    bool found = false;
+    if (hset->capacity > 0) {
+        mvn_hset_probe(hset, value, hash, &found);
+    }
+    return found;
+}
+
+/**
+ * @internal
+ * @brief Moves all elements into a new slot table. Stored hashes are reused, so no element is
+ * hashed again.
+ * @param hset The set to resize.
+ * @param new_capacity The new slot count, a power of two that holds every element.
+ * @return true on success, false on allocation failure (the set is unchanged).
+ */
+static bool mvn_hset_adjust_capacity(mvn_hset_t *hset, size_t new_capacity)
+{
+    // Zeroed slots are empty: hash 0 and type MVN_VAL_NULL
+    mvn_hset_slot_t *new_slots =
+        (mvn_hset_slot_t *)MVN_DS_CALLOC(new_capacity, sizeof(mvn_hset_slot_t));
+    if (new_slots == NULL) {
+        fprintf(stderr, "[MVN_DS_HSET] Hash set resize failed - out of memory.\n");
+        return false;
+    }
+
+    size_t mask = new_capacity - 1;
+    for (size_t index = 0; index < hset->capacity; index++) {
+        if (hset->slots[index].hash == 0) {
+            continue;
+        }
+        size_t slot = (size_t)hset->slots[index].hash & mask;
+        while (new_slots[slot].hash != 0) {
+            slot = (slot + 1) & mask;
+        }
+        new_slots[slot] = hset->slots[index]; // Move the element
+    }
+
+    MVN_DS_FREE(hset->slots);
+    hset->slots    = new_slots;
+    hset->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Inserts an owned element with a precomputed hash, growing the table as needed.
+ * @param hset The set.
+ * @param value The element (ownership is taken; freed if already present or on failure).
+ * @param hash The element's slot hash (mvn_hset_hash).
+ * @return true if the element is in the set afterwards, false on allocation failure.
+ */
+static bool mvn_hset_insert_hashed(mvn_hset_t *hset, mvn_val_t value, uint64_t hash)
+{
+    if ((double)(hset->count + 1) > (double)hset->capacity * MVN_DS_HSET_LOAD_FACTOR) {
+        size_t new_capacity = mvn_hset_capacity_for(hset->count + 1);
+        if (new_capacity == 0) {
+            fprintf(stderr, "[MVN_DS_HSET] Hash set capacity overflow during resize.\n");
+            mvn_val_free(&value);
+            return false;
+        }
+        if (!mvn_hset_adjust_capacity(hset, new_capacity)) {
+            mvn_val_free(&value);
+            return false;
+        }
+    }
+
+    bool   found = false;
+    size_t slot  = mvn_hset_probe(hset, &value, hash, &found);
+    if (found) {
+        mvn_val_free(&value); // Keep the existing, equal element
+        return true;
+    }
+    hset->slots[slot].hash  = hash;
+    hset->slots[slot].value = value; // Transfer ownership
+    hset->count++;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Inserts a deep copy of an element of another set, reusing its stored hash.
+ * @return true if successful (or already present), false on allocation failure.
+ */
+static bool mvn_hset_insert_copy(mvn_hset_t *hset, const mvn_hset_slot_t *source)
+{
+    if (mvn_hset_contains_hashed(hset, &source->value, source->hash)) {
+        return true; // Skip the copy
+    }
+    mvn_val_t copy = mvn_val_deep_copy(&source->value);
+    if (copy.type == MVN_VAL_NULL && source->value.type != MVN_VAL_NULL) {
+        return false; // Deep copy failed
+    }
+    return mvn_hset_insert_hashed(hset, copy, source->hash);
+}
+
+/**
+ * @internal
+ * @brief Removes the element in slot and closes the gap by shifting later elements of the
+ * probe run back (backward-shift deletion), so lookups never need tombstones.
+ */
+static void mvn_hset_remove_slot(mvn_hset_t *hset, size_t slot)
+{
+    size_t mask = hset->capacity - 1;
+    mvn_val_free(&hset->slots[slot].value);
+
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; hset->slots[next].hash != 0; next = (next + 1) & mask) {
+        size_t home = (size_t)hset->slots[next].hash & mask;
+        // Move the element back unless its home lies between the hole and its position
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            hset->slots[hole] = hset->slots[next];
+            hole              = next;
+        }
+    }
+    hset->slots[hole].hash  = 0;
+    hset->slots[hole].value = mvn_val_null();
+    hset->count--;
+}
+
+// --- Public Hash Set Functions ---
+
+/**
+ * @brief Creates a new, empty hash set. Slots are allocated by the first insert.
+ * @return A pointer to the new mvn_hset_t, or NULL on allocation failure.
+ */
+mvn_hset_t *mvn_hset_new(void)
+{
+    mvn_hset_t *hset = (mvn_hset_t *)MVN_DS_MALLOC(sizeof(mvn_hset_t));
+    if (hset == NULL) {
+        return NULL;
+    }
+    hset->count    = 0;
+    hset->capacity = 0;
+    hset->slots    = NULL;
+    return hset;
+}
+
+/**
+ * @brief Creates a new, empty hash set sized for a number of elements.
+ * @param capacity Number of elements the set holds before its first resize. 0 allocates
+ * nothing, like mvn_hset_new.
+ * @return A pointer to the new mvn_hset_t, or NULL on allocation failure or overflow.
+ */
+mvn_hset_t *mvn_hset_new_capacity(size_t capacity)
+{
+    mvn_hset_t *hset = mvn_hset_new();
+    if (hset == NULL || capacity == 0) {
+        return hset;
+    }
+    size_t slot_count = mvn_hset_capacity_for(capacity);
+    if (slot_count == 0) {
+        fprintf(stderr, "[MVN_DS_HSET] Hash set initial capacity overflow.\n");
+        MVN_DS_FREE(hset);
+        return NULL;
+    }
+    if (!mvn_hset_adjust_capacity(hset, slot_count)) {
+        MVN_DS_FREE(hset);
+        return NULL;
+    }
+    return hset;
+}
+
+/**
+ * @brief Frees the hash set and all of its elements.
+ * @param hset The set to free. If NULL, no action is taken.
+ */
+void mvn_hset_free(mvn_hset_t *hset)
+{
+    if (hset == NULL) {
+        return;
+    }
+    for (size_t index = 0; index < hset->capacity; index++) {
+        if (hset->slots[index].hash != 0) {
+            mvn_val_free(&hset->slots[index].value);
+        }
+    }
+    MVN_DS_FREE(hset->slots);
+    MVN_DS_FREE(hset);
+}
+
+/**
+ * @brief Creates a deep copy of a hash set. The copy has the same slot layout, so no element
+ * is hashed or probed again.
+ * @param hset The set to copy.
+ * @return A new set, or NULL on allocation failure or if hset is NULL.
+ */
+mvn_hset_t *mvn_hset_copy(const mvn_hset_t *hset)
+{
+    if (hset == NULL) {
+        return NULL;
+    }
+    mvn_hset_t *copy = mvn_hset_new();
+    if (copy == NULL) {
+        return NULL;
+    }
+    if (hset->capacity == 0) {
+        return copy;
+    }
+    copy->slots = (mvn_hset_slot_t *)MVN_DS_CALLOC(hset->capacity, sizeof(mvn_hset_slot_t));
+    if (copy->slots == NULL) {
+        MVN_DS_FREE(copy);
+        return NULL;
+    }
+    copy->capacity = hset->capacity;
+
+    for (size_t index = 0; index < hset->capacity; index++) {
+        const mvn_hset_slot_t *source = &hset->slots[index];
+        if (source->hash == 0) {
+            continue;
+        }
+        mvn_val_t value = mvn_val_deep_copy(&source->value);
+        if (value.type == MVN_VAL_NULL && source->value.type != MVN_VAL_NULL) {
+            mvn_hset_free(copy); // Deep copy failed: release what was copied so far
+            return NULL;
+        }
+        copy->slots[index].hash  = source->hash;
+        copy->slots[index].value = value;
+        copy->count++;
+    }
+    return copy;
+}
+
+/**
+ * @brief Adds an element to the set. Takes ownership of the value's dynamic data.
+ * If an equal element is already present, the set keeps it and the provided value is freed.
+ * @param hset The set. Must not be NULL.
+ * @param value The element (ownership is taken).
+ * @return true if the element is in the set afterwards, false on allocation failure or if
+ *         hset is NULL (value is freed in both cases).
+ */
+bool mvn_hset_insert(mvn_hset_t *hset, mvn_val_t value)
+{
+    if (hset == NULL) {
+        mvn_val_free(&value); // Free the value as it won't be stored
+        return false;
+    }
+    return mvn_hset_insert_hashed(hset, value, mvn_hset_hash(&value));
+}
+
+/**
+ * @brief Checks if the set contains an element equal to value (mvn_val_equal).
+ * @param hset The set.
+ * @param value The element to look for.
+ * @return true if found, false otherwise or on invalid input.
+ */
+bool mvn_hset_contains(const mvn_hset_t *hset, const mvn_val_t *value)
+{
+    if (hset == NULL || value == NULL) {
+        return false;
+    }
+    return mvn_hset_contains_hashed(hset, value, mvn_hset_hash(value));
+}
+
+/**
+ * @brief Removes and frees the element equal to value.
+ * @param hset The set.
+ * @param value The element to remove (not freed; only compared).
+ * @return true if an element was removed, false if none was found or on invalid input.
+ */
+bool mvn_hset_remove(mvn_hset_t *hset, const mvn_val_t *value)
+{
+    if (hset == NULL || value == NULL || hset->capacity == 0) {
+        return false;
+    }
+    bool   found = false;
+    size_t slot  = mvn_hset_probe(hset, value, mvn_hset_hash(value), &found);
+    if (!found) {
+        return false;
+    }
+    mvn_hset_remove_slot(hset, slot);
+    return true;
+}
+
+/**
+ * @brief Returns the number of elements in the set.
+ * @param hset The set. Can be NULL.
+ * @return The count, or 0 if hset is NULL.
+ */
+size_t mvn_hset_count(const mvn_hset_t *hset)
+{
+    return hset != NULL ? hset->count : 0;
+}
+
+/**
+ * @brief Removes and frees all elements. The slot table keeps its capacity.
+ * @param hset The set. If NULL, no action is taken.
+ */
+void mvn_hset_clear(mvn_hset_t *hset)
+{
+    if (hset == NULL) {
+        return;
+    }
+    for (size_t index = 0; index < hset->capacity; index++) {
+        if (hset->slots[index].hash != 0) {
+            mvn_val_free(&hset->slots[index].value);
+            hset->slots[index].hash = 0;
+        }
+    }
+    hset->count = 0;
+}
+
+/**
+ * @brief Returns the next element in slot order.
+ * @param hset The set. Must not be modified while iterating.
+ * @param[in,out] cursor Iteration state; 0 starts a new iteration.
+ * @return The next element, or NULL when all elements were returned or on invalid input.
+ */
+const mvn_val_t *mvn_hset_next(const mvn_hset_t *hset, size_t *cursor)
+{
+    if (hset == NULL || cursor == NULL) {
+        return NULL;
+    }
+    while (*cursor < hset->capacity) {
+        const mvn_hset_slot_t *slot = &hset->slots[(*cursor)++];
+        if (slot->hash != 0) {
+            return &slot->value;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Retrieves all elements of the set as a new array.
+ * The caller owns the returned mvn_arr_t and its contents (deep copies of the elements).
+ * @param hset The set.
+ * @return A new array, or NULL on allocation failure or if hset is NULL.
+ */
+mvn_arr_t *mvn_hset_to_arr(const mvn_hset_t *hset)
+{
+    if (hset == NULL) {
+        return NULL;
+    }
+    mvn_arr_t *array = mvn_arr_new_capacity(hset->count);
+    if (array == NULL) {
+        return NULL;
+    }
+    size_t           cursor = 0;
+    const mvn_val_t *value  = NULL;
+    while ((value = mvn_hset_next(hset, &cursor)) != NULL) {
+        mvn_val_t copy = mvn_val_deep_copy(value);
+        if (copy.type == MVN_VAL_NULL && value->type != MVN_VAL_NULL) {
+            mvn_arr_free(array); // Deep copy failed
+            return NULL;
+        }
+        if (!mvn_arr_push(array, copy)) {
+            mvn_val_free(&copy);
+            mvn_arr_free(array);
+            return NULL;
+        }
+    }
+    return array;
+}
+
+/**
+ * @brief Checks if two sets contain equal elements. Each element of one set is looked up in the
+ * other with its stored hash, so no element is hashed again.
+ * @param set_one The first set.
+ * @param set_two The second set.
+ * @return true if both are NULL or hold the same elements, false otherwise.
+ */
+bool mvn_hset_equal(const mvn_hset_t *set_one, const mvn_hset_t *set_two)
+{
+    if (set_one == NULL || set_two == NULL) {
+        return set_one == set_two;
+    }
+    if (set_one->count != set_two->count) {
+        return false;
+    }
+    for (size_t index = 0; index < set_one->capacity; index++) {
+        const mvn_hset_slot_t *slot = &set_one->slots[index];
+        if (slot->hash != 0 && !mvn_hset_contains_hashed(set_two, &slot->value, slot->hash)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Set Algebra ---
+
+/**
+ * @brief Creates the union of two sets: a copy of the larger set, plus copies of the elements
+ * of the smaller set that it lacks.
+ * @param set_one The first set.
+ * @param set_two The second set.
+ * @return A new set, or NULL on allocation failure or if either set is NULL.
+ */
+mvn_hset_t *mvn_hset_union(const mvn_hset_t *set_one, const mvn_hset_t *set_two)
+{
+    if (set_one == NULL || set_two == NULL) {
+        return NULL;
+    }
+    const mvn_hset_t *larger  = set_one->count >= set_two->count ? set_one : set_two;
+    const mvn_hset_t *smaller = larger == set_one ? set_two : set_one;
+
+    mvn_hset_t *result = mvn_hset_copy(larger);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (size_t index = 0; index < smaller->capacity; index++) {
+        if (smaller->slots[index].hash != 0 &&
+            !mvn_hset_insert_copy(result, &smaller->slots[index])) {
+            mvn_hset_free(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Creates the intersection of two sets by looking up each element of the smaller set in
+ * the larger one.
+ * @param set_one The first set.
+ * @param set_two The second set.
+ * @return A new set, or NULL on allocation failure or if either set is NULL.
+ */
+mvn_hset_t *mvn_hset_intersection(const mvn_hset_t *set_one, const mvn_hset_t *set_two)
+{
+    if (set_one == NULL || set_two == NULL) {
+        return NULL;
+    }
+    const mvn_hset_t *larger  = set_one->count >= set_two->count ? set_one : set_two;
+    const mvn_hset_t *smaller = larger == set_one ? set_two : set_one;
+
+    mvn_hset_t *result = mvn_hset_new_capacity(smaller->count);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (size_t index = 0; index < smaller->capacity; index++) {
+        const mvn_hset_slot_t *slot = &smaller->slots[index];
+        if (slot->hash != 0 && mvn_hset_contains_hashed(larger, &slot->value, slot->hash) &&
+            !mvn_hset_insert_copy(result, slot)) {
+            mvn_hset_free(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Creates the difference set_one - set_two. If set_one is the smaller set, its elements
+ * are looked up in set_two; otherwise set_one is copied and the elements of set_two removed.
+ * @param set_one The set to take elements from.
+ * @param set_two The set of elements to leave out.
+ * @return A new set, or NULL on allocation failure or if either set is NULL.
+ */
+mvn_hset_t *mvn_hset_difference(const mvn_hset_t *set_one, const mvn_hset_t *set_two)
+{
+    if (set_one == NULL || set_two == NULL) {
+        return NULL;
+    }
+
+    if (set_one->count > set_two->count) {
+        mvn_hset_t *result = mvn_hset_copy(set_one);
+        for (size_t index = 0; result != NULL && index < set_two->capacity; index++) {
+            const mvn_hset_slot_t *slot = &set_two->slots[index];
+            bool                   found = false;
+            if (slot->hash == 0 || result->count == 0) {
+                continue;
+            }
+            size_t position = mvn_hset_probe(result, &slot->value, slot->hash, &found);
+            if (found) {
+                mvn_hset_remove_slot(result, position);
+            }
+        }
+        return result;
+    }
+
+    mvn_hset_t *result = mvn_hset_new_capacity(set_one->count);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (size_t index = 0; index < set_one->capacity; index++) {
+        const mvn_hset_slot_t *slot = &set_one->slots[index];
+        if (slot->hash != 0 && !mvn_hset_contains_hashed(set_two, &slot->value, slot->hash) &&
+            !mvn_hset_insert_copy(result, slot)) {
+            mvn_hset_free(result);
+            return NULL;
+        }
+    }
+    return result;
+}
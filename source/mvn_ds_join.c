@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_JOIN // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_join.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_hash, mvn_val_equal, mvn_val_deep_copy
+#include "mvn_ds/mvn_ds_arr.h"   // For mvn_arr_new_capacity, mvn_arr_push, mvn_arr_free
+#include "mvn_ds/mvn_ds_fmap.h"  // For mvn_fmap_count, mvn_fmap_key_at, mvn_fmap_value_at
+#include "mvn_ds/mvn_ds_hmap.h"  // For mvn_hmap_new_capacity, mvn_hmap_set_cstr
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_REALLOC, MVN_DS_FREE
+
+#include "mvn_ds_path.h" // For mvn_path_t, mvn_path_parse, mvn_path_resolve
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For memmove
+
+// Hash table slots allocated for an index's first keys; a power of two
+#define MVN_DS_INDEX_INITIAL_SLOTS 64
+
+// Key number of a record that has no key
+#define MVN_DS_JOIN_NO_KEY SIZE_MAX
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MVN_DS_JOIN_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define MVN_DS_JOIN_PREFETCH(address) ((void)(address))
+#endif
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Returns the key at the end of path in record, or NULL if it is missing or null.
+ */
+static const mvn_val_t *mvn_join_key(const mvn_path_t *path, const mvn_val_t *record)
+{
+    const mvn_val_t *key = mvn_path_resolve(path, record);
+    return key != NULL && key->type != MVN_VAL_NULL ? key : NULL;
+}
+
+/**
+ * @internal
+ * @brief Returns the number of the key equal to key, or MVN_DS_JOIN_NO_KEY if there is none.
+ */
+static size_t mvn_index_find(const mvn_index_t *index, const mvn_val_t *key, uint64_t hash)
+{
+    size_t mask = index->slot_count - 1;
+    for (size_t slot = (size_t)hash & mask; index->slots[slot].key != 0; slot = (slot + 1) & mask) {
+        const mvn_index_slot_t *entry = &index->slots[slot];
+        if (entry->hash == hash && mvn_val_equal(index->keys[entry->key - 1], key)) {
+            return entry->key - 1;
+        }
+    }
+    return MVN_DS_JOIN_NO_KEY;
+}
+
+/**
+ * @internal
+ * @brief Doubles the slots and the room for keys, and re-inserts every key by its hash.
+ */
+static bool mvn_index_grow(mvn_index_t *index)
+{
+    size_t slot_count = index->slot_count * 2;
+    if (slot_count > SIZE_MAX / sizeof(mvn_index_slot_t)) {
+        fprintf(stderr, "[MVN_DS_JOIN] Index size overflow.\n");
+        return false;
+    }
+    mvn_index_slot_t *slots =
+        (mvn_index_slot_t *)MVN_DS_CALLOC(slot_count, sizeof(mvn_index_slot_t));
+    if (slots == NULL) {
+        return false;
+    }
+    const mvn_val_t **keys = (const mvn_val_t **)MVN_DS_REALLOC(
+        (void *)index->keys, (slot_count / 2) * sizeof(const mvn_val_t *));
+    if (keys == NULL) {
+        MVN_DS_FREE(slots);
+        return false;
+    }
+    index->keys = keys;
+
+    size_t mask = slot_count - 1;
+    for (size_t old = 0; old < index->slot_count; old++) {
+        if (index->slots[old].key == 0) {
+            continue;
+        }
+        size_t slot = (size_t)index->slots[old].hash & mask;
+        while (slots[slot].key != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = index->slots[old];
+    }
+    MVN_DS_FREE(index->slots);
+    index->slots      = slots;
+    index->slot_count = slot_count;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Stores the number of the key equal to key in number, adding the key if it is new.
+ * @return false on allocation failure.
+ */
+static bool mvn_index_add(mvn_index_t *index, const mvn_val_t *key, uint64_t hash, size_t *number)
+{
+    if (index->key_count == index->slot_count / 2 && !mvn_index_grow(index)) {
+        return false;
+    }
+    size_t mask = index->slot_count - 1;
+    size_t slot = (size_t)hash & mask;
+    while (index->slots[slot].key != 0) {
+        const mvn_index_slot_t *entry = &index->slots[slot];
+        if (entry->hash == hash && mvn_val_equal(index->keys[entry->key - 1], key)) {
+            *number = entry->key - 1;
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+    *number                 = index->key_count++;
+    index->keys[*number]    = key;
+    index->slots[slot].hash = hash;
+    index->slots[slot].key  = *number + 1;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Groups row numbers by key number with a counting sort that keeps row order. offsets
+ * must hold key_count + 1 zeros; it receives the start of each key's run in rows.
+ */
+static void mvn_join_group_rows(size_t       *offsets,
+                                size_t       *rows,
+                                const size_t *row_keys,
+                                size_t        row_count,
+                                size_t        key_count)
+{
+    for (size_t row = 0; row < row_count; row++) {
+        if (row_keys[row] != MVN_DS_JOIN_NO_KEY) {
+            offsets[row_keys[row] + 1]++;
+        }
+    }
+    for (size_t key = 0; key < key_count; key++) {
+        offsets[key + 1] += offsets[key];
+    }
+    for (size_t row = 0; row < row_count; row++) {
+        if (row_keys[row] != MVN_DS_JOIN_NO_KEY) {
+            rows[offsets[row_keys[row]]++] = row;
+        }
+    }
+    // Each offset moved to the end of its run, which is the start of the next one
+    memmove(offsets + 1, offsets, key_count * sizeof(size_t));
+    offsets[0] = 0;
+}
+
+/**
+ * @internal
+ * @brief Builds an index of records by the key at path. If row_keys is not NULL, it receives
+ * a new array with the key number of every record (MVN_DS_JOIN_NO_KEY if it has no key).
+ */
+static mvn_index_t *
+mvn_index_build_path(const mvn_arr_t *records, const mvn_path_t *path, size_t **row_keys)
+{
+    mvn_index_t *index   = (mvn_index_t *)MVN_DS_CALLOC(1, sizeof(mvn_index_t));
+    size_t      *numbers = (size_t *)MVN_DS_MALLOC(
+        (records->count > 0 ? records->count : 1) * sizeof(size_t));
+    if (index == NULL || numbers == NULL) {
+        MVN_DS_FREE(index);
+        MVN_DS_FREE(numbers);
+        return NULL;
+    }
+    index->slot_count = MVN_DS_INDEX_INITIAL_SLOTS;
+    index->slots =
+        (mvn_index_slot_t *)MVN_DS_CALLOC(index->slot_count, sizeof(mvn_index_slot_t));
+    index->keys = (const mvn_val_t **)MVN_DS_MALLOC((index->slot_count / 2) *
+                                                    sizeof(const mvn_val_t *));
+    bool ok = index->slots != NULL && index->keys != NULL;
+
+    for (size_t row = 0; ok && row < records->count; row++) {
+        const mvn_val_t *key = mvn_join_key(path, &records->data[row]);
+        numbers[row]         = MVN_DS_JOIN_NO_KEY;
+        if (key != NULL) {
+            ok = mvn_index_add(index, key, mvn_val_hash(key), &numbers[row]);
+            index->row_count++;
+        }
+    }
+    if (ok) {
+        index->offsets = (size_t *)MVN_DS_CALLOC(index->key_count + 1, sizeof(size_t));
+        index->rows    = (size_t *)MVN_DS_MALLOC(
+            (index->row_count > 0 ? index->row_count : 1) * sizeof(size_t));
+        ok = index->offsets != NULL && index->rows != NULL;
+    }
+    if (!ok) {
+        mvn_index_free(index);
+        MVN_DS_FREE(numbers);
+        return NULL;
+    }
+    mvn_join_group_rows(index->offsets, index->rows, numbers, records->count, index->key_count);
+
+    if (row_keys != NULL) {
+        *row_keys = numbers;
+    } else {
+        MVN_DS_FREE(numbers);
+    }
+    return index;
+}
+
+/**
+ * @internal
+ * @brief Stores in row_keys the index key number of every probe record's key at path. Records
+ * are handled MVN_DS_JOIN_BATCH_ROWS at a time: a batch's keys are all resolved and hashed,
+ * and their first slots prefetched, before any is compared, so the cache misses of a batch
+ * overlap instead of following one another.
+ */
+static void mvn_join_probe(const mvn_index_t *index,
+                           const mvn_arr_t   *records,
+                           const mvn_path_t  *path,
+                           size_t            *row_keys)
+{
+    const mvn_val_t *keys[MVN_DS_JOIN_BATCH_ROWS];
+    uint64_t         hashes[MVN_DS_JOIN_BATCH_ROWS];
+    size_t           mask = index->slot_count - 1;
+    for (size_t begin = 0; begin < records->count; begin += MVN_DS_JOIN_BATCH_ROWS) {
+        size_t count = records->count - begin;
+        count        = count < MVN_DS_JOIN_BATCH_ROWS ? count : MVN_DS_JOIN_BATCH_ROWS;
+        for (size_t item = 0; item < count; item++) {
+            keys[item]   = mvn_join_key(path, &records->data[begin + item]);
+            hashes[item] = keys[item] != NULL ? mvn_val_hash(keys[item]) : 0;
+            MVN_DS_JOIN_PREFETCH(&index->slots[(size_t)hashes[item] & mask]);
+        }
+        for (size_t item = 0; item < count; item++) {
+            row_keys[begin + item] = keys[item] != NULL
+                                         ? mvn_index_find(index, keys[item], hashes[item])
+                                         : MVN_DS_JOIN_NO_KEY;
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Copies the fields of a hash map or frozen map record into into. With skip_present,
+ * fields whose names into already has are left out. Other records have no fields.
+ */
+static bool mvn_join_copy_fields(mvn_hmap_t *into, const mvn_val_t *record, bool skip_present)
+{
+    if (record->type == MVN_VAL_HASHMAP && record->hmap != NULL) {
+        const mvn_hmap_t *hmap = record->hmap;
+        for (size_t bucket = 0; bucket < hmap->capacity; bucket++) {
+            for (mvn_hmap_entry_t *entry = hmap->buckets[bucket]; entry != NULL;
+                 entry                   = entry->next) {
+                if (skip_present && mvn_hmap_contains_key(into, entry->key)) {
+                    continue;
+                }
+                if (!mvn_hmap_set_cstr(into, entry->key->data, mvn_val_deep_copy(&entry->value))) {
+                    return false;
+                }
+            }
+        }
+    } else if (record->type == MVN_VAL_FROZEN_MAP) {
+        for (size_t index = 0; index < mvn_fmap_count(record->fmap); index++) {
+            const char *key = mvn_fmap_key_at(record->fmap, index);
+            if (skip_present && mvn_hmap_contains_key_cstr(into, key)) {
+                continue;
+            }
+            if (!mvn_hmap_set_cstr(
+                    into, key, mvn_val_deep_copy(mvn_fmap_value_at(record->fmap, index)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Returns the number of fields of a hash map or frozen map record, 0 for others.
+ */
+static size_t mvn_join_field_count(const mvn_val_t *record)
+{
+    if (record->type == MVN_VAL_HASHMAP) {
+        return mvn_hmap_count(record->hmap);
+    }
+    return record->type == MVN_VAL_FROZEN_MAP ? mvn_fmap_count(record->fmap) : 0;
+}
+
+/**
+ * @internal
+ * @brief Appends the joined record of a left record and its matching right record (NULL for
+ * an unmatched left record) to results.
+ */
+static bool mvn_join_emit(mvn_arr_t *results, const mvn_val_t *left, const mvn_val_t *right)
+{
+    size_t fields = mvn_join_field_count(left) + (right != NULL ? mvn_join_field_count(right) : 0);
+    mvn_hmap_t *record = mvn_hmap_new_capacity(fields * 2);
+    if (record == NULL || !mvn_join_copy_fields(record, left, false) ||
+        (right != NULL && !mvn_join_copy_fields(record, right, true))) {
+        mvn_hmap_free(record);
+        return false;
+    }
+    return mvn_arr_push(results, mvn_val_hmap_take(record));
+}
+
+/**
+ * @internal
+ * @brief Builds the joined records in left record order. The right records matching left
+ * record row are rows[offsets[key]] to rows[offsets[key + 1] - 1], where key is left_keys[row].
+ */
+static mvn_arr_t *mvn_join_emit_all(const mvn_arr_t *left,
+                                    const mvn_arr_t *right,
+                                    const size_t    *left_keys,
+                                    const size_t    *offsets,
+                                    const size_t    *rows,
+                                    mvn_join_mode_t  mode)
+{
+    size_t total = 0;
+    for (size_t row = 0; row < left->count; row++) {
+        size_t key     = left_keys[row];
+        size_t matches = key != MVN_DS_JOIN_NO_KEY ? offsets[key + 1] - offsets[key] : 0;
+        total += matches > 0 ? matches : (mode == MVN_JOIN_LEFT ? 1 : 0);
+    }
+    mvn_arr_t *results = mvn_arr_new_capacity(total);
+    bool       ok      = results != NULL;
+    for (size_t row = 0; ok && row < left->count; row++) {
+        size_t key   = left_keys[row];
+        size_t begin = key != MVN_DS_JOIN_NO_KEY ? offsets[key] : 0;
+        size_t end   = key != MVN_DS_JOIN_NO_KEY ? offsets[key + 1] : 0;
+        if (begin == end && mode == MVN_JOIN_LEFT) {
+            ok = mvn_join_emit(results, &left->data[row], NULL);
+        }
+        for (size_t match = begin; ok && match < end; match++) {
+            ok = mvn_join_emit(results, &left->data[row], &right->data[rows[match]]);
+        }
+    }
+    if (!ok) {
+        mvn_arr_free(results);
+        return NULL;
+    }
+    return results;
+}
+
+/**
+ * @internal
+ * @brief Joins with the index built on the right records and the left records probing it.
+ */
+static mvn_arr_t *mvn_join_build_right(const mvn_arr_t  *left,
+                                       const mvn_arr_t  *right,
+                                       const mvn_path_t *left_path,
+                                       const mvn_path_t *right_path,
+                                       mvn_join_mode_t   mode)
+{
+    mvn_index_t *index = mvn_index_build_path(right, right_path, NULL);
+    size_t      *left_keys =
+        (size_t *)MVN_DS_MALLOC((left->count > 0 ? left->count : 1) * sizeof(size_t));
+    mvn_arr_t *results = NULL;
+    if (index != NULL && left_keys != NULL) {
+        mvn_join_probe(index, left, left_path, left_keys);
+        results = mvn_join_emit_all(left, right, left_keys, index->offsets, index->rows, mode);
+    }
+    mvn_index_free(index);
+    MVN_DS_FREE(left_keys);
+    return results;
+}
+
+/**
+ * @internal
+ * @brief Joins with the index built on the left records and the right records probing it.
+ * The right records are then grouped by the left key they matched, so that results still
+ * come out in left record order.
+ */
+static mvn_arr_t *mvn_join_build_left(const mvn_arr_t  *left,
+                                      const mvn_arr_t  *right,
+                                      const mvn_path_t *left_path,
+                                      const mvn_path_t *right_path,
+                                      mvn_join_mode_t   mode)
+{
+    size_t      *left_keys = NULL;
+    mvn_index_t *index     = mvn_index_build_path(left, left_path, &left_keys);
+    if (index == NULL) {
+        return NULL;
+    }
+    size_t  row_count  = right->count > 0 ? right->count : 1;
+    size_t *right_keys = (size_t *)MVN_DS_MALLOC(row_count * sizeof(size_t));
+    size_t *rows       = (size_t *)MVN_DS_MALLOC(row_count * sizeof(size_t));
+    size_t *offsets    = (size_t *)MVN_DS_CALLOC(index->key_count + 1, sizeof(size_t));
+    mvn_arr_t *results = NULL;
+    if (right_keys != NULL && rows != NULL && offsets != NULL) {
+        mvn_join_probe(index, right, right_path, right_keys);
+        mvn_join_group_rows(offsets, rows, right_keys, right->count, index->key_count);
+        results = mvn_join_emit_all(left, right, left_keys, offsets, rows, mode);
+    }
+    MVN_DS_FREE(right_keys);
+    MVN_DS_FREE(rows);
+    MVN_DS_FREE(offsets);
+    MVN_DS_FREE(left_keys);
+    mvn_index_free(index);
+    return results;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Builds a hash index of records by the value at key_path. One pass resolves each
+ * record's key (with pre-hashed field names), hashes it with mvn_val_hash and finds or adds it
+ * in an open-addressing table; a counting sort then lays the rows out grouped by key.
+ * @param records Array of records (hash maps or frozen maps). Must outlive the index unchanged.
+ * @param key_path Dot-separated path of the key field.
+ * @return A new index owned by the caller, or NULL on invalid input or allocation failure.
+ */
+mvn_index_t *mvn_index_build(const mvn_arr_t *records, const char *key_path)
+{
+    if (records == NULL || key_path == NULL) {
+        return NULL;
+    }
+    mvn_path_t path;
+    if (!mvn_path_parse(&path, key_path)) {
+        return NULL;
+    }
+    mvn_index_t *index = mvn_index_build_path(records, &path, NULL);
+    mvn_path_free(&path);
+    if (index == NULL) {
+        fprintf(stderr, "[MVN_DS_JOIN] Failed to build index.\n");
+    }
+    return index;
+}
+
+/**
+ * @brief Frees an index. The indexed records are not touched.
+ * @param index The index to free. Can be NULL.
+ */
+void mvn_index_free(mvn_index_t *index)
+{
+    if (index == NULL) {
+        return;
+    }
+    MVN_DS_FREE(index->slots);
+    MVN_DS_FREE((void *)index->keys);
+    MVN_DS_FREE(index->offsets);
+    MVN_DS_FREE(index->rows);
+    MVN_DS_FREE(index);
+}
+
+/**
+ * @brief Gets the number of distinct keys in an index.
+ * @param index The index.
+ * @return The number of keys, or 0 if index is NULL.
+ */
+size_t mvn_index_key_count(const mvn_index_t *index)
+{
+    return index != NULL ? index->key_count : 0;
+}
+
+/**
+ * @brief Looks up the rows whose key equals key.
+ * @param index The index.
+ * @param key The key to look up, compared with mvn_val_equal.
+ * @param row_count Receives the number of rows. Must not be NULL.
+ * @return Pointer to the ascending row numbers (owned by the index), or NULL if none match.
+ */
+const size_t *mvn_index_rows(const mvn_index_t *index, const mvn_val_t *key, size_t *row_count)
+{
+    if (row_count == NULL) {
+        return NULL;
+    }
+    *row_count = 0;
+    if (index == NULL || key == NULL || key->type == MVN_VAL_NULL) {
+        return NULL;
+    }
+    size_t number = mvn_index_find(index, key, mvn_val_hash(key));
+    if (number == MVN_DS_JOIN_NO_KEY) {
+        return NULL;
+    }
+    *row_count = index->offsets[number + 1] - index->offsets[number];
+    return &index->rows[index->offsets[number]];
+}
+
+/**
+ * @brief Joins two arrays of records on equal key values in time linear in their sizes plus
+ * the number of results. The index is built on the smaller array, so the table that every
+ * probe visits is the one most likely to stay in cache, and the larger array is probed
+ * MVN_DS_JOIN_BATCH_ROWS records at a time. Records whose key is missing or null match
+ * nothing.
+ * @param left Left records (hash maps or frozen maps). Not modified.
+ * @param right Right records (hash maps or frozen maps). Not modified.
+ * @param left_key Dot-separated path of the key in the left records.
+ * @param right_key Dot-separated path of the key in the right records.
+ * @param mode MVN_JOIN_INNER or MVN_JOIN_LEFT.
+ * @return A new array of joined records owned by the caller, or NULL on failure.
+ */
+mvn_arr_t *mvn_hash_join(const mvn_arr_t *left,
+                         const mvn_arr_t *right,
+                         const char      *left_key,
+                         const char      *right_key,
+                         mvn_join_mode_t  mode)
+{
+    if (left == NULL || right == NULL || left_key == NULL || right_key == NULL ||
+        (mode != MVN_JOIN_INNER && mode != MVN_JOIN_LEFT)) {
+        return NULL;
+    }
+    mvn_path_t left_path;
+    mvn_path_t right_path;
+    bool       left_ok  = mvn_path_parse(&left_path, left_key);
+    bool       right_ok = mvn_path_parse(&right_path, right_key);
+    mvn_arr_t *results  = NULL;
+    if (left_ok && right_ok) {
+        results = left->count < right->count
+                      ? mvn_join_build_left(left, right, &left_path, &right_path, mode)
+                      : mvn_join_build_right(left, right, &left_path, &right_path, mode);
+    }
+    mvn_path_free(&left_path);
+    mvn_path_free(&right_path);
+    if (results == NULL) {
+        fprintf(stderr, "[MVN_DS_JOIN] Failed to join records.\n");
+    }
+    return results;
+}
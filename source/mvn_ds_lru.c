@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_LRU // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_lru.h"
+
+#include "mvn_ds/mvn_ds.h"       // For mvn_val_free, mvn_val_memory_usage
+#include "mvn_ds/mvn_ds_str.h"   // For mvn_str_new, mvn_str_free, mvn_str_equal, mvn_str_hash
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h> // For strlen
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Wraps a C string in a borrowed string header without allocating.
+ * @param key_cstr The characters. Must outlive the returned header, which is only read.
+ */
+static mvn_str_t mvn_lru_cstr_key(const char *key_cstr)
+{
+    size_t length = strlen(key_cstr);
+    return (mvn_str_t){.length = length, .capacity = length, .data = (char *)key_cstr};
+}
+
+/**
+ * @internal
+ * @brief Returns the slot holding the entry for key in its bucket chain: a pointer to the
+ * bucket head or to the chain field of the previous entry. *slot is NULL if key is absent.
+ */
+static mvn_lru_entry_t **
+mvn_lru_find_slot(const mvn_lru_t *lru, const mvn_str_t *key, uint32_t hash)
+{
+    mvn_lru_entry_t **slot = &lru->buckets[hash & (lru->bucket_count - 1)];
+    while (*slot != NULL && ((*slot)->hash != hash || !mvn_str_equal((*slot)->key, key))) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+/**
+ * @internal
+ * @brief Finds the entry for key, or returns NULL.
+ */
+static mvn_lru_entry_t *mvn_lru_find(const mvn_lru_t *lru, const mvn_str_t *key)
+{
+    if (lru == NULL || key == NULL || lru->bucket_count == 0) {
+        return NULL;
+    }
+    return *mvn_lru_find_slot(lru, key, mvn_str_hash(key));
+}
+
+/**
+ * @internal
+ * @brief Doubles the bucket array (or allocates the first one) and relinks every entry.
+ * @return true on success, false on allocation failure (the cache is unchanged).
+ */
+static bool mvn_lru_grow_buckets(mvn_lru_t *lru)
+{
+    size_t new_count =
+        lru->bucket_count == 0 ? MVN_DS_LRU_INITIAL_BUCKETS : lru->bucket_count * 2;
+    if (new_count < lru->bucket_count || new_count > SIZE_MAX / sizeof(mvn_lru_entry_t *)) {
+        fprintf(stderr, "[MVN_DS_LRU] Bucket count overflow.\n");
+        return false;
+    }
+    mvn_lru_entry_t **new_buckets =
+        (mvn_lru_entry_t **)MVN_DS_CALLOC(new_count, sizeof(mvn_lru_entry_t *));
+    if (new_buckets == NULL) {
+        fprintf(stderr, "[MVN_DS_LRU] Bucket resize failed - out of memory.\n");
+        return false;
+    }
+    for (size_t index = 0; index < lru->bucket_count; index++) {
+        mvn_lru_entry_t *entry = lru->buckets[index];
+        while (entry != NULL) {
+            mvn_lru_entry_t *next   = entry->chain;
+            size_t           bucket = entry->hash & (new_count - 1);
+            entry->chain            = new_buckets[bucket];
+            new_buckets[bucket]     = entry;
+            entry                   = next;
+        }
+    }
+    MVN_DS_FREE(lru->buckets);
+    lru->buckets      = new_buckets;
+    lru->bucket_count = new_count;
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Links entry into the recency list just before head (the back of the list for LRU,
+ * just behind the hand for CLOCK).
+ */
+static void mvn_lru_list_insert(mvn_lru_t *lru, mvn_lru_entry_t *entry)
+{
+    if (lru->head == NULL) {
+        entry->prev = entry;
+        entry->next = entry;
+        lru->head   = entry;
+        return;
+    }
+    entry->next       = lru->head;
+    entry->prev       = lru->head->prev;
+    entry->prev->next = entry;
+    lru->head->prev   = entry;
+}
+
+/**
+ * @internal
+ * @brief Unlinks entry from the recency list. If it was the head, the next entry becomes the
+ * head (the next most recent entry for LRU, the next entry under the hand for CLOCK).
+ */
+static void mvn_lru_list_remove(mvn_lru_t *lru, mvn_lru_entry_t *entry)
+{
+    if (entry->next == entry) {
+        lru->head = NULL;
+        return;
+    }
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    if (lru->head == entry) {
+        lru->head = entry->next;
+    }
+}
+
+/**
+ * @internal
+ * @brief Marks entry as used. LRU moves it to the front of the list; CLOCK only sets its
+ * reference bit, and skips even that store when the bit is already set.
+ */
+static void mvn_lru_touch(mvn_lru_t *lru, mvn_lru_entry_t *entry)
+{
+    if (lru->policy == MVN_LRU_POLICY_CLOCK) {
+        if (!entry->referenced) {
+            entry->referenced = true;
+        }
+        return;
+    }
+    if (lru->head != entry) {
+        mvn_lru_list_remove(lru, entry);
+        mvn_lru_list_insert(lru, entry);
+        lru->head = entry;
+    }
+}
+
+/**
+ * @internal
+ * @brief Returns the bytes an entry is charged: the entry, its key and everything the value
+ * owns. 0 when the capacity counts entries, so count-limited caches never walk their values.
+ */
+static size_t
+mvn_lru_entry_bytes(const mvn_lru_t *lru, const mvn_str_t *key, const mvn_val_t *value)
+{
+    if (lru->limit != MVN_LRU_LIMIT_BYTES) {
+        return 0;
+    }
+    return sizeof(mvn_lru_entry_t) + sizeof(mvn_str_t) + key->capacity + 1 +
+           mvn_val_memory_usage(value);
+}
+
+/**
+ * @internal
+ * @brief Unlinks entry from its bucket and the recency list, then frees it with its key and
+ * value.
+ */
+static void mvn_lru_unlink_and_free(mvn_lru_t *lru, mvn_lru_entry_t **slot)
+{
+    mvn_lru_entry_t *entry = *slot;
+    *slot                  = entry->chain;
+    mvn_lru_list_remove(lru, entry);
+    lru->count--;
+    lru->bytes -= entry->bytes;
+    mvn_str_free(entry->key);
+    mvn_val_free(&entry->value);
+    MVN_DS_FREE(entry);
+}
+
+/**
+ * @internal
+ * @brief Returns whether the cache holds more than its capacity.
+ */
+static bool mvn_lru_over_capacity(const mvn_lru_t *lru)
+{
+    return (lru->limit == MVN_LRU_LIMIT_BYTES ? lru->bytes : lru->count) > lru->capacity;
+}
+
+/**
+ * @internal
+ * @brief Evicts entries other than keep until the cache fits its capacity.
+ */
+static void mvn_lru_evict_to_fit(mvn_lru_t *lru, mvn_lru_entry_t *keep)
+{
+    while (lru->count > 1 && mvn_lru_over_capacity(lru)) {
+        mvn_lru_entry_t *victim;
+        if (lru->policy == MVN_LRU_POLICY_CLOCK) {
+            // Sweep the hand, giving each referenced entry a second chance
+            while (lru->head->referenced || lru->head == keep) {
+                lru->head->referenced = false;
+                lru->head             = lru->head->next;
+            }
+            victim = lru->head;
+        } else {
+            victim = lru->head->prev != keep ? lru->head->prev : keep->prev;
+        }
+        if (lru->on_evict != NULL) {
+            lru->on_evict(victim->key, &victim->value, lru->context);
+        }
+        mvn_lru_unlink_and_free(lru, mvn_lru_find_slot(lru, victim->key, victim->hash));
+    }
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Creates a new, empty cache. Buckets are allocated by the first put.
+ * @param capacity Maximum number of entries or bytes, depending on limit. Must be > 0.
+ * @param limit Whether capacity counts entries or bytes.
+ * @param policy LRU or CLOCK eviction.
+ * @return A pointer to the new cache, or NULL on allocation failure or invalid input.
+ */
+mvn_lru_t *mvn_lru_new(size_t capacity, mvn_lru_limit_t limit, mvn_lru_policy_t policy)
+{
+    if (capacity == 0) {
+        return NULL;
+    }
+    mvn_lru_t *lru = (mvn_lru_t *)MVN_DS_MALLOC(sizeof(mvn_lru_t));
+    if (lru == NULL) {
+        fprintf(stderr, "[MVN_DS_LRU] Failed to allocate cache structure.\n");
+        return NULL;
+    }
+    lru->count        = 0;
+    lru->bytes        = 0;
+    lru->capacity     = capacity;
+    lru->limit        = limit;
+    lru->policy       = policy;
+    lru->bucket_count = 0;
+    lru->buckets      = NULL;
+    lru->head         = NULL;
+    lru->on_evict     = NULL;
+    lru->context      = NULL;
+    return lru;
+}
+
+/**
+ * @brief Frees the cache and every key and value in it, without calling the eviction callback.
+ * @param lru The cache to free. If NULL, the function does nothing.
+ */
+void mvn_lru_free(mvn_lru_t *lru)
+{
+    if (lru == NULL) {
+        return;
+    }
+    mvn_lru_entry_t *entry = lru->head;
+    for (size_t index = 0; index < lru->count; index++) {
+        mvn_lru_entry_t *next = entry->next;
+        mvn_str_free(entry->key);
+        mvn_val_free(&entry->value);
+        MVN_DS_FREE(entry);
+        entry = next;
+    }
+    MVN_DS_FREE(lru->buckets);
+    MVN_DS_FREE(lru);
+}
+
+/**
+ * @brief Sets the function called with every entry evicted to make room.
+ * The callback runs before the entry is freed. It must not modify the cache, but may move the
+ * value out by copying it and setting *value to MVN_VAL_NULL.
+ * @param lru The cache. If NULL, the function does nothing.
+ * @param on_evict The callback, or NULL to disable it.
+ * @param context Passed to every call. Not owned.
+ */
+void mvn_lru_set_evict_callback(mvn_lru_t *lru, mvn_lru_evict_fn on_evict, void *context)
+{
+    if (lru == NULL) {
+        return;
+    }
+    lru->on_evict = on_evict;
+    lru->context  = context;
+}
+
+/**
+ * @brief Stores a value under a key, then evicts entries until the cache fits its capacity.
+ * A new entry goes to the front (LRU) or just behind the clock hand (CLOCK); a replaced one
+ * is marked as used. Either way it is not evicted by this call.
+ * @param lru The cache.
+ * @param key The key (ownership is taken). Must not be NULL.
+ * @param value The value (ownership is taken).
+ * @return true on success. false on allocation failure, invalid input, or an entry larger than
+ *         a byte capacity; key and value are freed in that case.
+ */
+bool mvn_lru_put(mvn_lru_t *lru, mvn_str_t *key, mvn_val_t value)
+{
+    if (lru == NULL || key == NULL) {
+        mvn_str_free(key);
+        mvn_val_free(&value);
+        return false;
+    }
+    size_t bytes = mvn_lru_entry_bytes(lru, key, &value);
+    if (lru->limit == MVN_LRU_LIMIT_BYTES && bytes > lru->capacity) {
+        mvn_str_free(key);
+        mvn_val_free(&value);
+        return false;
+    }
+
+    uint32_t         hash  = mvn_str_hash(key);
+    mvn_lru_entry_t *entry = lru->bucket_count > 0 ? *mvn_lru_find_slot(lru, key, hash) : NULL;
+    if (entry != NULL) {
+        // Replace the value and keep the existing key
+        mvn_val_free(&entry->value);
+        mvn_str_free(key);
+        entry->value = value;
+        lru->bytes   = lru->bytes - entry->bytes + bytes;
+        entry->bytes = bytes;
+        mvn_lru_touch(lru, entry);
+        mvn_lru_evict_to_fit(lru, entry);
+        return true;
+    }
+
+    if ((double)(lru->count + 1) > (double)lru->bucket_count * MVN_DS_LRU_LOAD_FACTOR &&
+        !mvn_lru_grow_buckets(lru)) {
+        mvn_str_free(key);
+        mvn_val_free(&value);
+        return false;
+    }
+    entry = (mvn_lru_entry_t *)MVN_DS_MALLOC(sizeof(mvn_lru_entry_t));
+    if (entry == NULL) {
+        fprintf(stderr, "[MVN_DS_LRU] Failed to allocate cache entry.\n");
+        mvn_str_free(key);
+        mvn_val_free(&value);
+        return false;
+    }
+    entry->key        = key;
+    entry->hash       = hash;
+    entry->referenced = false;
+    entry->value      = value;
+    entry->bytes      = bytes;
+
+    size_t bucket        = hash & (lru->bucket_count - 1);
+    entry->chain         = lru->buckets[bucket];
+    lru->buckets[bucket] = entry;
+    mvn_lru_list_insert(lru, entry);
+    if (lru->policy == MVN_LRU_POLICY_LRU) {
+        lru->head = entry;
+    }
+    lru->count++;
+    lru->bytes += bytes;
+    mvn_lru_evict_to_fit(lru, entry);
+    return true;
+}
+
+/**
+ * @brief Stores a value under a copy of a C string key.
+ * @param lru The cache.
+ * @param key_cstr The key. Must not be NULL.
+ * @param value The value (ownership is taken; freed on failure).
+ * @return true on success, false on failure (see mvn_lru_put).
+ */
+bool mvn_lru_put_cstr(mvn_lru_t *lru, const char *key_cstr, mvn_val_t value)
+{
+    if (key_cstr == NULL) {
+        mvn_val_free(&value);
+        return false;
+    }
+    mvn_str_t *key = mvn_str_new(key_cstr);
+    if (key == NULL) {
+        mvn_val_free(&value);
+        return false;
+    }
+    return mvn_lru_put(lru, key, value);
+}
+
+/**
+ * @brief Looks up a key and marks its entry as used.
+ * @param lru The cache.
+ * @param key The key to look up.
+ * @return A pointer to the stored value (owned by the cache), or NULL if the key is absent.
+ */
+mvn_val_t *mvn_lru_get(mvn_lru_t *lru, const mvn_str_t *key)
+{
+    mvn_lru_entry_t *entry = mvn_lru_find(lru, key);
+    if (entry == NULL) {
+        return NULL;
+    }
+    mvn_lru_touch(lru, entry);
+    return &entry->value;
+}
+
+/**
+ * @brief Looks up a C string key and marks its entry as used.
+ * @param lru The cache.
+ * @param key_cstr The key to look up.
+ * @return A pointer to the stored value, or NULL if the key is absent.
+ */
+mvn_val_t *mvn_lru_get_cstr(mvn_lru_t *lru, const char *key_cstr)
+{
+    if (key_cstr == NULL) {
+        return NULL;
+    }
+    mvn_str_t key = mvn_lru_cstr_key(key_cstr);
+    return mvn_lru_get(lru, &key);
+}
+
+/**
+ * @brief Looks up a key without changing the eviction order.
+ * @param lru The cache.
+ * @param key The key to look up.
+ * @return A pointer to the stored value, or NULL if the key is absent.
+ */
+const mvn_val_t *mvn_lru_peek(const mvn_lru_t *lru, const mvn_str_t *key)
+{
+    mvn_lru_entry_t *entry = mvn_lru_find(lru, key);
+    return entry != NULL ? &entry->value : NULL;
+}
+
+/**
+ * @brief Looks up a C string key without changing the eviction order.
+ * @param lru The cache.
+ * @param key_cstr The key to look up.
+ * @return A pointer to the stored value, or NULL if the key is absent.
+ */
+const mvn_val_t *mvn_lru_peek_cstr(const mvn_lru_t *lru, const char *key_cstr)
+{
+    if (key_cstr == NULL) {
+        return NULL;
+    }
+    mvn_str_t key = mvn_lru_cstr_key(key_cstr);
+    return mvn_lru_peek(lru, &key);
+}
+
+/**
+ * @brief Removes the entry for a key and frees its key and value. The eviction callback is
+ * not called.
+ * @param lru The cache.
+ * @param key The key to remove.
+ * @return true if the key was found and removed, false otherwise.
+ */
+bool mvn_lru_remove(mvn_lru_t *lru, const mvn_str_t *key)
+{
+    if (lru == NULL || key == NULL || lru->bucket_count == 0) {
+        return false;
+    }
+    mvn_lru_entry_t **slot = mvn_lru_find_slot(lru, key, mvn_str_hash(key));
+    if (*slot == NULL) {
+        return false;
+    }
+    mvn_lru_unlink_and_free(lru, slot);
+    return true;
+}
+
+/**
+ * @brief Removes the entry for a C string key.
+ * @param lru The cache.
+ * @param key_cstr The key to remove.
+ * @return true if the key was found and removed, false otherwise.
+ */
+bool mvn_lru_remove_cstr(mvn_lru_t *lru, const char *key_cstr)
+{
+    if (key_cstr == NULL) {
+        return false;
+    }
+    mvn_str_t key = mvn_lru_cstr_key(key_cstr);
+    return mvn_lru_remove(lru, &key);
+}
+
+/**
+ * @brief Returns the number of entries in the cache.
+ * @param lru The cache.
+ * @return The number of entries, or 0 if lru is NULL.
+ */
+size_t mvn_lru_count(const mvn_lru_t *lru)
+{
+    return lru != NULL ? lru->count : 0;
+}
+
+/**
+ * @brief Returns the bytes charged by the entries of a byte-limited cache.
+ * @param lru The cache.
+ * @return The charged bytes, or 0 if lru is NULL or its capacity counts entries.
+ */
+size_t mvn_lru_bytes(const mvn_lru_t *lru)
+{
+    return lru != NULL ? lru->bytes : 0;
+}
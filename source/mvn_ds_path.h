@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_PATH_H
+#define MVN_DS_PATH_H
+
+// Private key paths shared by the modules that query arrays of records.
+// Not installed; only included from files in source/.
+
+#include "mvn_ds/mvn_ds_fmap.h"  // For mvn_fmap_get
+#include "mvn_ds/mvn_ds_hmap.h"  // For mvn_hmap_get_hashed, mvn_hmap_hash_key
+#include "mvn_ds/mvn_ds_str.h"   // For mvn_str_hash
+#include "mvn_ds/mvn_ds_types.h" // For mvn_str_t, mvn_val_t
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h> // For memcpy, strlen
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @internal
+ * @brief One field name of a key path, hashed once when the path is parsed.
+ */
+typedef struct mvn_path_segment_t {
+    mvn_str_t key;  /**< Borrowed view of the name inside mvn_path_t::text. */
+    uint32_t  hash; /**< mvn_str_hash of key; the hash every unseeded hash map uses. */
+} mvn_path_segment_t;
+
+/**
+ * @internal
+ * @brief A parsed dot-separated key path such as "user.address.city". Each segment selects a
+ * field of a hash map or frozen map; the first applies to the record itself.
+ */
+typedef struct mvn_path_t {
+    char               *text;     /**< Copy of the path with each '.' replaced by '\0'. */
+    size_t              count;    /**< Number of segments, at least 1. */
+    mvn_path_segment_t *segments; /**< Segments, outermost first. */
+} mvn_path_t;
+
+/**
+ * @internal
+ * @brief Splits path_cstr at its dots and hashes each segment.
+ * @return false if path_cstr is NULL or on allocation failure; path is then empty.
+ */
+static inline bool mvn_path_parse(mvn_path_t *path, const char *path_cstr)
+{
+    path->text     = NULL;
+    path->count    = 0;
+    path->segments = NULL;
+    if (path_cstr == NULL) {
+        return false;
+    }
+    size_t length = strlen(path_cstr);
+    size_t count  = 1;
+    for (size_t index = 0; index < length; index++) {
+        count += path_cstr[index] == '.' ? 1 : 0;
+    }
+    path->text     = (char *)MVN_DS_MALLOC(length + 1);
+    path->segments = (mvn_path_segment_t *)MVN_DS_MALLOC(count * sizeof(mvn_path_segment_t));
+    if (path->text == NULL || path->segments == NULL) {
+        MVN_DS_FREE(path->text);
+        MVN_DS_FREE(path->segments);
+        path->text     = NULL;
+        path->segments = NULL;
+        return false;
+    }
+    memcpy(path->text, path_cstr, length + 1);
+
+    size_t start = 0;
+    for (size_t index = 0; index <= length; index++) {
+        if (path->text[index] == '.' || path->text[index] == '\0') {
+            path->text[index]         = '\0';
+            mvn_path_segment_t *piece = &path->segments[path->count++];
+            piece->key = (mvn_str_t){.length = index - start,
+                                     .capacity = index - start,
+                                     .data     = path->text + start};
+            piece->hash = mvn_str_hash(&piece->key);
+            start       = index + 1;
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Frees a parsed path. Safe to call on a path whose parse failed.
+ */
+static inline void mvn_path_free(mvn_path_t *path)
+{
+    MVN_DS_FREE(path->text);
+    MVN_DS_FREE(path->segments);
+    path->text     = NULL;
+    path->count    = 0;
+    path->segments = NULL;
+}
+
+/**
+ * @internal
+ * @brief Follows a path from a record. Unseeded hash maps are probed with the stored segment
+ * hashes, so no key is hashed per record; seeded maps hash the segment with their own seed.
+ * @return The value at the end of the path (owned by the record), or NULL if a segment is
+ *         missing or a value along the way is not a map.
+ */
+static inline const mvn_val_t *mvn_path_resolve(const mvn_path_t *path, const mvn_val_t *record)
+{
+    const mvn_val_t *value = record;
+    for (size_t index = 0; value != NULL && index < path->count; index++) {
+        const mvn_path_segment_t *piece = &path->segments[index];
+        if (value->type == MVN_VAL_HASHMAP && value->hmap != NULL) {
+            const mvn_hmap_t *hmap = value->hmap;
+            uint32_t hash = hmap->seeded ? mvn_hmap_hash_key(hmap, &piece->key) : piece->hash;
+            value         = mvn_hmap_get_hashed(hmap, &piece->key, hash);
+        } else if (value->type == MVN_VAL_FROZEN_MAP) {
+            value = mvn_fmap_get(value->fmap, &piece->key);
+        } else {
+            value = NULL;
+        }
+    }
+    return value;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_PATH_H */
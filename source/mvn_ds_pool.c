@@ -0,0 +1,854 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_POOL // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_pool.h"
+
+#include "mvn_ds/mvn_ds_utils.h" // For MVN_DS_MALLOC, MVN_DS_FREE
+#include "mvn_ds_thread.h"       // For threads, mutexes and atomics
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Number of empty polls a worker makes before going to sleep
+#define MVN_DS_POOL_SPIN_COUNT 64
+// Number of failed task searches (each followed by a yield) before a waiting thread sleeps
+#define MVN_DS_POOL_HELP_ATTEMPTS 16
+// Padding used to keep the deque indices on separate cache lines
+#define MVN_DS_POOL_CACHE_LINE 64
+
+// --- Internal Types ---
+
+/**
+ * @internal
+ * @brief A queued unit of work.
+ */
+typedef struct mvn_pool_task_t {
+    mvn_pool_task_fn        task_fn; /**< Function to run. */
+    void                   *context; /**< Argument passed to task_fn. */
+    mvn_pool_group_t       *group;   /**< Owning group, or NULL for detached tasks. */
+    struct mvn_pool_task_t *next;    /**< Link used by the shared injection queue. */
+} mvn_pool_task_t;
+
+/**
+ * @internal
+ * @brief Circular slot buffer backing a Chase-Lev deque. Capacity is a power of two.
+ */
+typedef struct mvn_pool_buffer_t {
+    int64_t                   capacity; /**< Number of slots. */
+    struct mvn_pool_buffer_t *retired;  /**< Next buffer in the owner's retired list. */
+    void *volatile            slots[];  /**< Task pointers indexed by position & (capacity - 1). */
+} mvn_pool_buffer_t;
+
+/**
+ * @internal
+ * @brief Chase-Lev work-stealing deque. The owner pushes and takes at the bottom,
+ * thieves steal from the top.
+ */
+typedef struct mvn_pool_deque_t {
+    volatile int64_t   top;                                            /**< Steal end. */
+    char               top_pad[MVN_DS_POOL_CACHE_LINE - sizeof(int64_t)];
+    volatile int64_t   bottom;                                         /**< Owner end. */
+    char               bottom_pad[MVN_DS_POOL_CACHE_LINE - sizeof(int64_t)];
+    void *volatile     buffer;  /**< Current mvn_pool_buffer_t. */
+    mvn_pool_buffer_t *retired; /**< Buffers replaced by growth; freed with the pool. */
+} mvn_pool_deque_t;
+
+/**
+ * @internal
+ * @brief Per-thread worker state.
+ */
+typedef struct mvn_pool_worker_t {
+    mvn_pool_deque_t deque;     /**< This worker's task deque. */
+    mvn_pool_t      *pool;      /**< Owning pool. */
+    mvn_thread_t     thread;    /**< Platform thread handle. */
+    uint64_t         rng_state; /**< xorshift state used to pick steal victims. */
+} mvn_pool_worker_t;
+
+struct mvn_pool_t {
+    size_t             worker_count; /**< Number of worker threads. */
+    mvn_pool_worker_t *workers;      /**< Worker array. */
+    mvn_mutex_t        lock;         /**< Guards the injection queue and sleeping workers. */
+    mvn_cond_t         wake;         /**< Signalled when work arrives or the pool stops. */
+    mvn_pool_task_t   *inject_head;  /**< Tasks submitted from outside the pool (FIFO). */
+    mvn_pool_task_t   *inject_tail;  /**< Tail of the injection queue. */
+    volatile size_t    injected;     /**< Number of tasks in the injection queue. */
+    volatile size_t    queued;       /**< Tasks submitted but not yet picked up. */
+    volatile size_t    pending;      /**< Tasks submitted but not yet finished. */
+    volatile size_t    sleeping;     /**< Threads blocked on the wake condition. */
+    volatile size_t    waiting;      /**< Of those, threads waiting for a counter to drain. */
+    volatile size_t    stopping;     /**< Non-zero once the pool is shutting down. */
+};
+
+struct mvn_pool_group_t {
+    mvn_pool_t     *pool;    /**< Pool the group's tasks run on. */
+    volatile size_t pending; /**< Tasks in the group not yet finished. */
+};
+
+/**
+ * @internal
+ * @brief Shared state for one mvn_pool_parallel_for call.
+ */
+typedef struct mvn_pool_range_shared_t {
+    mvn_pool_range_fn body;    /**< User range body. */
+    void             *context; /**< User context. */
+    size_t            grain;   /**< Largest chunk passed to body; smaller ranges never split. */
+    mvn_pool_group_t *group;   /**< Group tracking every spawned range task. */
+} mvn_pool_range_shared_t;
+
+/**
+ * @internal
+ * @brief A range [begin, end) waiting to be split or executed.
+ */
+typedef struct mvn_pool_range_task_t {
+    mvn_pool_range_shared_t *shared; /**< Shared call state. */
+    size_t                   begin;  /**< First index. */
+    size_t                   end;    /**< One past the last index. */
+} mvn_pool_range_task_t;
+
+// Worker running on the current thread, or NULL for threads outside any pool.
+static MVN_DS_THREAD_LOCAL mvn_pool_worker_t *mvn_pool_current_worker = NULL;
+
+// --- Deque Helpers ---
+
+/**
+ * @internal
+ * @brief Allocates a deque buffer with the given power-of-two capacity.
+ * @return The new buffer, or NULL on allocation failure.
+ */
+static mvn_pool_buffer_t *mvn_pool_buffer_new(int64_t capacity)
+{
+    size_t allocation_size = sizeof(mvn_pool_buffer_t) + (size_t)capacity * sizeof(void *);
+    mvn_pool_buffer_t *buffer = (mvn_pool_buffer_t *)MVN_DS_MALLOC(allocation_size);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->capacity = capacity;
+    buffer->retired  = NULL;
+    return buffer;
+}
+
+/**
+ * @internal
+ * @brief Initializes an empty deque.
+ * @return true on success, false on allocation failure.
+ */
+static bool mvn_pool_deque_init(mvn_pool_deque_t *deque)
+{
+    deque->top     = 0;
+    deque->bottom  = 0;
+    deque->retired = NULL;
+    deque->buffer  = mvn_pool_buffer_new(MVN_DS_POOL_DEQUE_INITIAL_CAPACITY);
+    return deque->buffer != NULL;
+}
+
+/**
+ * @internal
+ * @brief Frees a deque's current buffer and every retired buffer.
+ */
+static void mvn_pool_deque_destroy(mvn_pool_deque_t *deque)
+{
+    mvn_pool_buffer_t *retired = deque->retired;
+    while (retired != NULL) {
+        mvn_pool_buffer_t *next = retired->retired;
+        MVN_DS_FREE(retired);
+        retired = next;
+    }
+    MVN_DS_FREE((mvn_pool_buffer_t *)deque->buffer);
+    deque->buffer  = NULL;
+    deque->retired = NULL;
+}
+
+/**
+ * @internal
+ * @brief Doubles a full deque buffer. Owner only.
+ * The old buffer is retired rather than freed because thieves may still be reading it.
+ * @return The new buffer, or NULL on allocation failure.
+ */
+static mvn_pool_buffer_t *
+mvn_pool_deque_grow(mvn_pool_deque_t *deque, mvn_pool_buffer_t *old_buffer, int64_t top, int64_t bottom)
+{
+    mvn_pool_buffer_t *new_buffer = mvn_pool_buffer_new(old_buffer->capacity * 2);
+    if (new_buffer == NULL) {
+        return NULL;
+    }
+    for (int64_t position = top; position < bottom; position++) {
+        new_buffer->slots[position & (new_buffer->capacity - 1)] =
+            old_buffer->slots[position & (old_buffer->capacity - 1)];
+    }
+    old_buffer->retired = deque->retired;
+    deque->retired      = old_buffer;
+    mvn_atomic_store_release_ptr(&deque->buffer, new_buffer);
+    return new_buffer;
+}
+
+/**
+ * @internal
+ * @brief Pushes a task at the bottom of the deque. Owner only.
+ * @return true on success, false if the buffer needed to grow and allocation failed.
+ */
+static bool mvn_pool_deque_push(mvn_pool_deque_t *deque, mvn_pool_task_t *task)
+{
+    int64_t            bottom = mvn_atomic_load_relaxed_i64(&deque->bottom);
+    int64_t            top    = mvn_atomic_load_acquire_i64(&deque->top);
+    mvn_pool_buffer_t *buffer = (mvn_pool_buffer_t *)mvn_atomic_load_relaxed_ptr(&deque->buffer);
+
+    if (bottom - top > buffer->capacity - 1) {
+        buffer = mvn_pool_deque_grow(deque, buffer, top, bottom);
+        if (buffer == NULL) {
+            return false;
+        }
+    }
+    mvn_atomic_store_relaxed_ptr(&buffer->slots[bottom & (buffer->capacity - 1)], task);
+    mvn_atomic_fence_release();
+    mvn_atomic_store_relaxed_i64(&deque->bottom, bottom + 1);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Takes the most recently pushed task from the bottom of the deque. Owner only.
+ * @return The task, or NULL if the deque is empty or a thief won the last element.
+ */
+static mvn_pool_task_t *mvn_pool_deque_take(mvn_pool_deque_t *deque)
+{
+    int64_t            bottom = mvn_atomic_load_relaxed_i64(&deque->bottom) - 1;
+    mvn_pool_buffer_t *buffer = (mvn_pool_buffer_t *)mvn_atomic_load_relaxed_ptr(&deque->buffer);
+    mvn_atomic_store_relaxed_i64(&deque->bottom, bottom);
+    mvn_atomic_fence_seq_cst();
+    int64_t top = mvn_atomic_load_relaxed_i64(&deque->top);
+
+    if (top > bottom) {
+        // Deque was empty; restore bottom
+        mvn_atomic_store_relaxed_i64(&deque->bottom, bottom + 1);
+        return NULL;
+    }
+
+    mvn_pool_task_t *task = (mvn_pool_task_t *)mvn_atomic_load_relaxed_ptr(
+        &buffer->slots[bottom & (buffer->capacity - 1)]);
+    if (top == bottom) {
+        // Last element: race against thieves for it
+        if (!mvn_atomic_cas_i64(&deque->top, top, top + 1)) {
+            task = NULL;
+        }
+        mvn_atomic_store_relaxed_i64(&deque->bottom, bottom + 1);
+    }
+    return task;
+}
+
+/**
+ * @internal
+ * @brief Steals the oldest task from the top of the deque. Safe from any thread.
+ * @return The task, or NULL if the deque is empty or the steal lost a race.
+ */
+static mvn_pool_task_t *mvn_pool_deque_steal(mvn_pool_deque_t *deque)
+{
+    int64_t top = mvn_atomic_load_acquire_i64(&deque->top);
+    mvn_atomic_fence_seq_cst();
+    int64_t bottom = mvn_atomic_load_acquire_i64(&deque->bottom);
+
+    if (top >= bottom) {
+        return NULL;
+    }
+    mvn_pool_buffer_t *buffer = (mvn_pool_buffer_t *)mvn_atomic_load_acquire_ptr(&deque->buffer);
+    mvn_pool_task_t   *task   = (mvn_pool_task_t *)mvn_atomic_load_relaxed_ptr(
+        &buffer->slots[top & (buffer->capacity - 1)]);
+    if (!mvn_atomic_cas_i64(&deque->top, top, top + 1)) {
+        return NULL; // Another thief or the owner took it
+    }
+    return task;
+}
+
+// --- Scheduling Helpers ---
+
+/**
+ * @internal
+ * @brief Appends a task to the shared injection queue.
+ */
+static void mvn_pool_inject(mvn_pool_t *pool, mvn_pool_task_t *task)
+{
+    task->next = NULL;
+    mvn_mutex_lock(&pool->lock);
+    if (pool->inject_tail != NULL) {
+        pool->inject_tail->next = task;
+    } else {
+        pool->inject_head = task;
+    }
+    pool->inject_tail = task;
+    mvn_atomic_fetch_add_size(&pool->injected, 1);
+    mvn_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @internal
+ * @brief Removes the oldest task from the injection queue.
+ * @return The task, or NULL if the queue is empty.
+ */
+static mvn_pool_task_t *mvn_pool_inject_pop(mvn_pool_t *pool)
+{
+    if (mvn_atomic_load_acquire_size(&pool->injected) == 0) {
+        return NULL; // Skip the lock on the common empty path
+    }
+    mvn_mutex_lock(&pool->lock);
+    mvn_pool_task_t *task = pool->inject_head;
+    if (task != NULL) {
+        pool->inject_head = task->next;
+        if (pool->inject_head == NULL) {
+            pool->inject_tail = NULL;
+        }
+        mvn_atomic_fetch_sub_size(&pool->injected, 1);
+    }
+    mvn_mutex_unlock(&pool->lock);
+    return task;
+}
+
+/**
+ * @internal
+ * @brief Advances an xorshift64 generator.
+ */
+static uint64_t mvn_pool_next_random(uint64_t *state)
+{
+    uint64_t value = *state;
+    value ^= value << 13;
+    value ^= value >> 7;
+    value ^= value << 17;
+    *state = value;
+    return value;
+}
+
+/**
+ * @internal
+ * @brief Finds a runnable task: own deque first, then the injection queue, then stealing.
+ * @param pool The pool to search.
+ * @param self The calling worker, or NULL when called from a thread outside the pool.
+ * @return A task now owned by the caller, or NULL if none was found.
+ */
+static mvn_pool_task_t *mvn_pool_find_task(mvn_pool_t *pool, mvn_pool_worker_t *self)
+{
+    mvn_pool_task_t *task = NULL;
+    if (self != NULL) {
+        task = mvn_pool_deque_take(&self->deque);
+    }
+    if (task == NULL) {
+        task = mvn_pool_inject_pop(pool);
+    }
+    if (task == NULL && pool->worker_count > 0) {
+        static MVN_DS_THREAD_LOCAL uint64_t helper_rng_state = 0x9E3779B97F4A7C15ULL;
+        uint64_t *rng_state = self != NULL ? &self->rng_state : &helper_rng_state;
+        size_t    start     = (size_t)(mvn_pool_next_random(rng_state) % pool->worker_count);
+        for (size_t offset = 0; offset < pool->worker_count && task == NULL; offset++) {
+            mvn_pool_worker_t *victim = &pool->workers[(start + offset) % pool->worker_count];
+            if (victim != self) {
+                task = mvn_pool_deque_steal(&victim->deque);
+            }
+        }
+    }
+    if (task != NULL) {
+        mvn_atomic_fetch_sub_size(&pool->queued, 1);
+    }
+    return task;
+}
+
+/**
+ * @internal
+ * @brief Runs a task, frees it and updates group and pool completion counters.
+ * Wakes sleeping waiters when a counter drains to zero.
+ */
+static void mvn_pool_run_task(mvn_pool_t *pool, mvn_pool_task_t *task)
+{
+    mvn_pool_group_t *group = task->group;
+    task->task_fn(task->context);
+    MVN_DS_FREE(task);
+    bool drained = false;
+    if (group != NULL) {
+        // Group may be freed after this
+        drained = mvn_atomic_fetch_sub_size(&group->pending, 1) == 1;
+    }
+    if (mvn_atomic_fetch_sub_size(&pool->pending, 1) == 1) {
+        drained = true;
+    }
+    if (drained) {
+        mvn_atomic_fence_seq_cst();
+        if (mvn_atomic_load_acquire_size(&pool->waiting) > 0) {
+            mvn_mutex_lock(&pool->lock);
+            mvn_cond_broadcast(&pool->wake);
+            mvn_mutex_unlock(&pool->lock);
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Returns the calling thread's worker if it belongs to pool, otherwise NULL.
+ */
+static mvn_pool_worker_t *mvn_pool_self(const mvn_pool_t *pool)
+{
+    mvn_pool_worker_t *worker = mvn_pool_current_worker;
+    return (worker != NULL && worker->pool == pool) ? worker : NULL;
+}
+
+/**
+ * @internal
+ * @brief Runs tasks on the calling thread until *counter drops to zero.
+ * After MVN_DS_POOL_HELP_ATTEMPTS searches find nothing, the remaining tasks are running on
+ * other threads, so the caller sleeps on the wake condition until new work is queued or a
+ * counter drains.
+ */
+static void mvn_pool_help_until_zero(mvn_pool_t *pool, volatile size_t *counter)
+{
+    mvn_pool_worker_t *self   = mvn_pool_self(pool);
+    int                misses = 0;
+    while (mvn_atomic_load_acquire_size(counter) > 0) {
+        mvn_pool_task_t *task = mvn_pool_find_task(pool, self);
+        if (task != NULL) {
+            mvn_pool_run_task(pool, task);
+            misses = 0;
+            continue;
+        }
+        if (++misses < MVN_DS_POOL_HELP_ATTEMPTS) {
+            mvn_thread_yield();
+            continue;
+        }
+        misses = 0;
+
+        mvn_mutex_lock(&pool->lock);
+        mvn_atomic_fetch_add_size(&pool->sleeping, 1);
+        mvn_atomic_fetch_add_size(&pool->waiting, 1);
+        mvn_atomic_fence_seq_cst();
+        while (mvn_atomic_load_acquire_size(counter) > 0 &&
+               mvn_atomic_load_acquire_size(&pool->queued) == 0) {
+            mvn_cond_wait(&pool->wake, &pool->lock);
+        }
+        mvn_atomic_fetch_sub_size(&pool->waiting, 1);
+        mvn_atomic_fetch_sub_size(&pool->sleeping, 1);
+        if (mvn_atomic_load_acquire_size(&pool->queued) > 0) {
+            // The signal for that work may have woken this thread; pass it on in case we return
+            mvn_cond_signal(&pool->wake);
+        }
+        mvn_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * @internal
+ * @brief Queues a task, optionally as part of a group, and wakes a sleeping worker.
+ * @return true on success, false on allocation failure.
+ */
+static bool mvn_pool_submit_task(mvn_pool_t       *pool,
+                                 mvn_pool_task_fn  task_fn,
+                                 void             *context,
+                                 mvn_pool_group_t *group)
+{
+    mvn_pool_task_t *task = (mvn_pool_task_t *)MVN_DS_MALLOC(sizeof(mvn_pool_task_t));
+    if (task == NULL) {
+        fprintf(stderr, "[MVN_DS_POOL] Failed to allocate task.\n");
+        return false;
+    }
+    task->task_fn = task_fn;
+    task->context = context;
+    task->group   = group;
+    task->next    = NULL;
+
+    mvn_atomic_fetch_add_size(&pool->pending, 1);
+    if (group != NULL) {
+        mvn_atomic_fetch_add_size(&group->pending, 1);
+    }
+    // Count the task as queued before publishing it so a worker about to sleep sees it
+    mvn_atomic_fetch_add_size(&pool->queued, 1);
+
+    mvn_pool_worker_t *self = mvn_pool_self(pool);
+    if (self == NULL || !mvn_pool_deque_push(&self->deque, task)) {
+        mvn_pool_inject(pool, task);
+    }
+
+    mvn_atomic_fence_seq_cst();
+    if (mvn_atomic_load_acquire_size(&pool->sleeping) > 0) {
+        mvn_mutex_lock(&pool->lock);
+        mvn_cond_signal(&pool->wake);
+        mvn_mutex_unlock(&pool->lock);
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Worker thread main loop: run tasks, spin briefly when idle, then sleep.
+ */
+static void mvn_pool_worker_main(void *argument)
+{
+    mvn_pool_worker_t *self = (mvn_pool_worker_t *)argument;
+    mvn_pool_t        *pool = self->pool;
+    mvn_pool_current_worker = self;
+
+    for (;;) {
+        mvn_pool_task_t *task = mvn_pool_find_task(pool, self);
+        if (task != NULL) {
+            mvn_pool_run_task(pool, task);
+            continue;
+        }
+
+        bool work_seen = false;
+        for (int spin = 0; spin < MVN_DS_POOL_SPIN_COUNT; spin++) {
+            if (mvn_atomic_load_acquire_size(&pool->queued) > 0) {
+                work_seen = true;
+                break;
+            }
+            mvn_cpu_relax();
+        }
+        if (work_seen) {
+            continue;
+        }
+
+        mvn_mutex_lock(&pool->lock);
+        mvn_atomic_fetch_add_size(&pool->sleeping, 1);
+        mvn_atomic_fence_seq_cst();
+        while (mvn_atomic_load_acquire_size(&pool->queued) == 0 &&
+               mvn_atomic_load_acquire_size(&pool->stopping) == 0) {
+            mvn_cond_wait(&pool->wake, &pool->lock);
+        }
+        mvn_atomic_fetch_sub_size(&pool->sleeping, 1);
+        bool stop = mvn_atomic_load_acquire_size(&pool->stopping) != 0 &&
+                    mvn_atomic_load_acquire_size(&pool->queued) == 0;
+        mvn_mutex_unlock(&pool->lock);
+        if (stop) {
+            break;
+        }
+    }
+    mvn_pool_current_worker = NULL;
+}
+
+/**
+ * @internal
+ * @brief Stops and joins the first started_count workers and releases pool resources.
+ */
+static void mvn_pool_shutdown(mvn_pool_t *pool, size_t started_count)
+{
+    mvn_mutex_lock(&pool->lock);
+    mvn_atomic_store_release_size(&pool->stopping, 1);
+    mvn_cond_broadcast(&pool->wake);
+    mvn_mutex_unlock(&pool->lock);
+
+    for (size_t index = 0; index < started_count; index++) {
+        mvn_thread_join(pool->workers[index].thread);
+    }
+    for (size_t index = 0; index < pool->worker_count; index++) {
+        mvn_pool_deque_destroy(&pool->workers[index].deque);
+    }
+    mvn_cond_destroy(&pool->wake);
+    mvn_mutex_destroy(&pool->lock);
+    MVN_DS_FREE(pool->workers);
+    MVN_DS_FREE(pool);
+}
+
+// --- Pool Implementation ---
+
+/**
+ * @brief Creates a work-stealing thread pool.
+ * Every worker owns a Chase-Lev deque. Tasks submitted from a worker are pushed to its own deque
+ * (LIFO for locality); tasks from other threads go through a shared FIFO injection queue. Idle
+ * workers steal from random victims before sleeping.
+ * @param thread_count Number of worker threads. 0 selects the number of hardware threads.
+ * @return A pointer to the new mvn_pool_t, or NULL on allocation or thread creation failure.
+ */
+mvn_pool_t *mvn_pool_new(size_t thread_count)
+{
+    if (thread_count == 0) {
+        thread_count = mvn_thread_hardware_concurrency();
+    }
+    if (thread_count > SIZE_MAX / sizeof(mvn_pool_worker_t)) {
+        fprintf(stderr, "[MVN_DS_POOL] Thread count overflow.\n");
+        return NULL;
+    }
+
+    mvn_pool_t *pool = (mvn_pool_t *)MVN_DS_MALLOC(sizeof(mvn_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->workers =
+        (mvn_pool_worker_t *)MVN_DS_CALLOC(thread_count, sizeof(mvn_pool_worker_t));
+    if (pool->workers == NULL) {
+        MVN_DS_FREE(pool);
+        return NULL;
+    }
+    pool->worker_count = thread_count;
+    pool->inject_head  = NULL;
+    pool->inject_tail  = NULL;
+    pool->injected     = 0;
+    pool->queued       = 0;
+    pool->pending      = 0;
+    pool->sleeping     = 0;
+    pool->waiting      = 0;
+    pool->stopping     = 0;
+    mvn_mutex_init(&pool->lock);
+    mvn_cond_init(&pool->wake);
+
+    // All deques must exist before any worker starts stealing
+    for (size_t index = 0; index < thread_count; index++) {
+        mvn_pool_worker_t *worker = &pool->workers[index];
+        worker->pool              = pool;
+        worker->rng_state         = 0x9E3779B97F4A7C15ULL * (uint64_t)(index + 1);
+        if (!mvn_pool_deque_init(&worker->deque)) {
+            mvn_pool_shutdown(pool, 0);
+            return NULL;
+        }
+    }
+    for (size_t index = 0; index < thread_count; index++) {
+        mvn_pool_worker_t *worker = &pool->workers[index];
+        if (!mvn_thread_create(&worker->thread, mvn_pool_worker_main, worker)) {
+            fprintf(stderr, "[MVN_DS_POOL] Failed to start worker thread %zu.\n", index);
+            mvn_pool_shutdown(pool, index);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+/**
+ * @brief Waits for all queued tasks to finish, stops the workers and frees the pool.
+ * @param pool The pool to free. Does nothing if NULL.
+ */
+void mvn_pool_free(mvn_pool_t *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    mvn_pool_wait_idle(pool);
+    mvn_pool_shutdown(pool, pool->worker_count);
+}
+
+/**
+ * @brief Returns the number of worker threads in the pool.
+ * @param pool The pool. Can be NULL.
+ * @return The worker count, or 0 if pool is NULL.
+ */
+size_t mvn_pool_thread_count(const mvn_pool_t *pool)
+{
+    return pool ? pool->worker_count : 0;
+}
+
+/**
+ * @brief Queues a detached task on the pool.
+ * @param pool The pool. Must not be NULL.
+ * @param task_fn The function to run. Must not be NULL.
+ * @param context Argument passed to task_fn. Ownership stays with the caller.
+ * @return true if the task was queued, false on invalid input or allocation failure.
+ */
+bool mvn_pool_submit(mvn_pool_t *pool, mvn_pool_task_fn task_fn, void *context)
+{
+    if (pool == NULL || task_fn == NULL) {
+        return false;
+    }
+    return mvn_pool_submit_task(pool, task_fn, context, NULL);
+}
+
+/**
+ * @brief Blocks until every task submitted to the pool so far has finished.
+ * The calling thread runs queued tasks while it waits.
+ * @param pool The pool. Does nothing if NULL.
+ */
+void mvn_pool_wait_idle(mvn_pool_t *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    mvn_pool_help_until_zero(pool, &pool->pending);
+}
+
+// --- Task Group Implementation ---
+
+/**
+ * @brief Creates a task group bound to a pool.
+ * @param pool The pool the group's tasks run on. Must not be NULL.
+ * @return A pointer to the new group, or NULL on invalid input or allocation failure.
+ */
+mvn_pool_group_t *mvn_pool_group_new(mvn_pool_t *pool)
+{
+    if (pool == NULL) {
+        return NULL;
+    }
+    mvn_pool_group_t *group = (mvn_pool_group_t *)MVN_DS_MALLOC(sizeof(mvn_pool_group_t));
+    if (group == NULL) {
+        return NULL;
+    }
+    group->pool    = pool;
+    group->pending = 0;
+    return group;
+}
+
+/**
+ * @brief Waits for any outstanding tasks in the group, then frees it.
+ * @param group The group to free. Does nothing if NULL.
+ */
+void mvn_pool_group_free(mvn_pool_group_t *group)
+{
+    if (group == NULL) {
+        return;
+    }
+    mvn_pool_group_wait(group);
+    MVN_DS_FREE(group);
+}
+
+/**
+ * @brief Queues a task that belongs to the group.
+ * @param group The group. Must not be NULL.
+ * @param task_fn The function to run. Must not be NULL.
+ * @param context Argument passed to task_fn. Ownership stays with the caller.
+ * @return true if the task was queued, false on invalid input or allocation failure.
+ */
+bool mvn_pool_group_submit(mvn_pool_group_t *group, mvn_pool_task_fn task_fn, void *context)
+{
+    if (group == NULL || task_fn == NULL) {
+        return false;
+    }
+    return mvn_pool_submit_task(group->pool, task_fn, context, group);
+}
+
+/**
+ * @brief Blocks until every task in the group has finished.
+ * Instead of sleeping, the calling thread executes pending tasks (its own first, then stolen
+ * ones), which keeps nested fork-join waits from deadlocking the pool.
+ * @param group The group. Does nothing if NULL.
+ */
+void mvn_pool_group_wait(mvn_pool_group_t *group)
+{
+    if (group == NULL) {
+        return;
+    }
+    mvn_pool_help_until_zero(group->pool, &group->pending);
+}
+
+// --- Parallel For Implementation ---
+
+static void mvn_pool_range_task_entry(void *context);
+
+/**
+ * @internal
+ * @brief Reports whether another thread could pick up a split right now: some thread is asleep,
+ * or the work this thread already queued has been taken (its own deque, or the injection queue
+ * for threads outside the pool, is empty).
+ */
+static bool mvn_pool_wants_split(mvn_pool_t *pool)
+{
+    if (mvn_atomic_load_acquire_size(&pool->sleeping) > 0) {
+        return true;
+    }
+    mvn_pool_worker_t *self = mvn_pool_self(pool);
+    if (self == NULL) {
+        return mvn_atomic_load_acquire_size(&pool->injected) == 0;
+    }
+    int64_t bottom = mvn_atomic_load_relaxed_i64(&self->deque.bottom);
+    int64_t top    = mvn_atomic_load_acquire_i64(&self->deque.top);
+    return bottom - top <= 0;
+}
+
+/**
+ * @internal
+ * @brief Runs [begin, end) with lazy binary splitting. While the range is larger than the grain,
+ * the right half is handed to the pool only if another thread could take it; otherwise the
+ * current thread runs one grain-sized chunk and checks again. Busy pools therefore run large
+ * ranges with few tasks, and idle workers get work as soon as they ask for it.
+ * If a split cannot be spawned the remaining range simply runs on the current thread.
+ */
+static void mvn_pool_range_run(mvn_pool_range_shared_t *shared, size_t begin, size_t end)
+{
+    while (end - begin > shared->grain) {
+        if (!mvn_pool_wants_split(shared->group->pool)) {
+            shared->body(begin, begin + shared->grain, shared->context);
+            begin += shared->grain;
+            continue;
+        }
+        size_t                 middle = begin + (end - begin) / 2;
+        mvn_pool_range_task_t *right =
+            (mvn_pool_range_task_t *)MVN_DS_MALLOC(sizeof(mvn_pool_range_task_t));
+        if (right == NULL) {
+            break;
+        }
+        right->shared = shared;
+        right->begin  = middle;
+        right->end    = end;
+        if (!mvn_pool_group_submit(shared->group, mvn_pool_range_task_entry, right)) {
+            MVN_DS_FREE(right);
+            break;
+        }
+        end = middle;
+    }
+    while (end - begin > shared->grain) {
+        shared->body(begin, begin + shared->grain, shared->context); // Split failed
+        begin += shared->grain;
+    }
+    shared->body(begin, end, shared->context);
+}
+
+/**
+ * @internal
+ * @brief Task entry point for a spawned range.
+ */
+static void mvn_pool_range_task_entry(void *context)
+{
+    mvn_pool_range_task_t   *range  = (mvn_pool_range_task_t *)context;
+    mvn_pool_range_shared_t *shared = range->shared;
+    size_t                   begin  = range->begin;
+    size_t                   end    = range->end;
+    MVN_DS_FREE(range);
+    mvn_pool_range_run(shared, begin, end);
+}
+
+/**
+ * @brief Runs body over [begin, end) in parallel and waits for completion.
+ * The range is split lazily in halves: the right half is handed to the pool only while a worker
+ * is asleep or this thread's queued work has been stolen, so chunk sizes adapt to the load.
+ * Otherwise the current thread runs grain-sized chunks itself. The grain bounds every chunk
+ * passed to body and is also the smallest range that is ever split.
+ * @param pool The pool to run on. Must not be NULL.
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param grain Maximum chunk size. 0 picks ceil(count / (workers * MVN_DS_POOL_CHUNKS_PER_WORKER)).
+ * @param body Range body. Must not be NULL.
+ * @param context Argument passed to body.
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool mvn_pool_parallel_for(mvn_pool_t       *pool,
+                           size_t            begin,
+                           size_t            end,
+                           size_t            grain,
+                           mvn_pool_range_fn body,
+                           void             *context)
+{
+    if (pool == NULL || body == NULL || end < begin) {
+        return false;
+    }
+    if (begin == end) {
+        return true;
+    }
+
+    size_t count = end - begin;
+    if (grain == 0) {
+        size_t chunk_count = pool->worker_count * MVN_DS_POOL_CHUNKS_PER_WORKER;
+        grain              = (count + chunk_count - 1) / chunk_count;
+        if (grain == 0) {
+            grain = 1;
+        }
+    }
+    if (count <= grain) {
+        body(begin, end, context); // Not worth a task
+        return true;
+    }
+
+    mvn_pool_group_t *group = mvn_pool_group_new(pool);
+    if (group == NULL) {
+        return false;
+    }
+    mvn_pool_range_shared_t shared;
+    shared.body    = body;
+    shared.context = context;
+    shared.grain   = grain;
+    shared.group   = group;
+
+    mvn_pool_range_run(&shared, begin, end);
+    mvn_pool_group_free(group); // Waits for every spawned range
+    return true;
+}
@@ -1,9 +1,12 @@
 /*
  * Copyright (c) 2024 Jake Larson
  */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_STR // Allocation statistics category
+
 #include "mvn_ds/mvn_ds_str.h"
 
 #include "mvn_ds/mvn_ds_utils.h" // Provides mvn_reallocate, memory macros
+#include "mvn_ds_trace.h"        // For resize and large allocation tracepoints
 
 #include <assert.h>
 #include <stdbool.h>
@@ -16,6 +19,12 @@
 #define FNV_OFFSET_BASIS 2166136261U
 #define FNV_PRIME        16777619U
 
+// SipHash initialization constants ("somepseudorandomlygeneratedbytes")
+#define SIPHASH_V0 0x736f6d6570736575ULL
+#define SIPHASH_V1 0x646f72616e646f6dULL
+#define SIPHASH_V2 0x6c7967656e657261ULL
+#define SIPHASH_V3 0x7465646279746573ULL
+
 // --- Static Helper Functions ---
 
 /**
@@ -63,14 +72,18 @@ static bool mvn_str_ensure_capacity(mvn_str_t *string_ptr, size_t additional_len
     }
     size_t allocation_size = new_capacity + 1; // +1 for null terminator
 
+    MVN_DS_TRACE3(str_resize_start, string_ptr, string_ptr->capacity, new_capacity);
+    MVN_DS_TRACE_ALLOCATION(allocation_size, MVN_DS_ALLOC_KIND);
     char *new_data = (char *)MVN_DS_REALLOC(string_ptr->data, allocation_size);
     if (!new_data) {
         fprintf(stderr, "[MVN_DS_STR] Failed to reallocate string data.\n");
+        MVN_DS_TRACE3(str_resize_done, string_ptr, new_capacity, 0);
         return false; // Allocation failure
     }
 
     string_ptr->data     = new_data;
     string_ptr->capacity = new_capacity;
+    MVN_DS_TRACE3(str_resize_done, string_ptr, new_capacity, 1);
     return true;
 }
 
@@ -104,8 +117,9 @@ mvn_str_t *mvn_str_new_capacity(size_t capacity)
         return NULL; // Malloc failure for the struct itself
     }
 
-    size_t allocation_size = capacity + 1;                           // For null terminator
-    string_ptr->data       = (char *)MVN_DS_MALLOC(allocation_size); // This is line 103 from error
+    size_t allocation_size = capacity + 1; // For null terminator
+    MVN_DS_TRACE_ALLOCATION(allocation_size, MVN_DS_ALLOC_KIND);
+    string_ptr->data = (char *)MVN_DS_MALLOC(allocation_size);
     if (!string_ptr->data) {
         MVN_DS_FREE(string_ptr);
         return NULL; // Malloc failure for the data buffer
@@ -299,6 +313,81 @@ uint32_t mvn_str_hash(const mvn_str_t *string_ptr)
     return hash_value;
 }
 
+/**
+ * @internal
+ * @brief Rotates a 64-bit value left by bits (0 < bits < 64).
+ */
+static uint64_t mvn_str_rotl64(uint64_t value, unsigned bits)
+{
+    return (value << bits) | (value >> (64U - bits));
+}
+
+/**
+ * @internal
+ * @brief One SipRound over the four state words.
+ */
+static void mvn_str_sipround(uint64_t state[4])
+{
+    state[0] += state[1];
+    state[1] = mvn_str_rotl64(state[1], 13) ^ state[0];
+    state[0] = mvn_str_rotl64(state[0], 32);
+    state[2] += state[3];
+    state[3] = mvn_str_rotl64(state[3], 16) ^ state[2];
+    state[0] += state[3];
+    state[3] = mvn_str_rotl64(state[3], 21) ^ state[0];
+    state[2] += state[1];
+    state[1] = mvn_str_rotl64(state[1], 17) ^ state[2];
+    state[2] = mvn_str_rotl64(state[2], 32);
+}
+
+/**
+ * @brief Calculates a keyed hash of the string (SipHash-1-3 with a 128-bit key).
+ * Unlike mvn_str_hash, colliding inputs cannot be precomputed without knowing the key, which
+ * makes it suitable for maps whose keys come from untrusted input. Input words are read in
+ * little-endian order, so results are the same on every platform.
+ * @param string_ptr The string to hash. Can be NULL.
+ * @param key0 First half of the key.
+ * @param key1 Second half of the key.
+ * @return The 64-bit hash value, or 0 if string_ptr or string_ptr->data is NULL.
+ */
+uint64_t mvn_str_hash_seeded(const mvn_str_t *string_ptr, uint64_t key0, uint64_t key1)
+{
+    if (string_ptr == NULL || string_ptr->data == NULL) {
+        return 0;
+    }
+
+    uint64_t state[4] = {
+        SIPHASH_V0 ^ key0, SIPHASH_V1 ^ key1, SIPHASH_V2 ^ key0, SIPHASH_V3 ^ key1};
+    const unsigned char *bytes  = (const unsigned char *)string_ptr->data;
+    size_t               length = string_ptr->length;
+    size_t               tail   = length & 7U;
+
+    for (size_t offset = 0; offset < length - tail; offset += 8) {
+        uint64_t word = 0;
+        for (unsigned byte = 0; byte < 8; byte++) {
+            word |= (uint64_t)bytes[offset + byte] << (8U * byte);
+        }
+        state[3] ^= word;
+        mvn_str_sipround(state); // c = 1 compression round
+        state[0] ^= word;
+    }
+
+    // Last word: remaining bytes plus the length in the top byte
+    uint64_t last = (uint64_t)length << 56;
+    for (size_t byte = 0; byte < tail; byte++) {
+        last |= (uint64_t)bytes[length - tail + byte] << (8U * byte);
+    }
+    state[3] ^= last;
+    mvn_str_sipround(state);
+    state[0] ^= last;
+
+    state[2] ^= 0xFF;
+    for (int round = 0; round < 3; round++) { // d = 3 finalization rounds
+        mvn_str_sipround(state);
+    }
+    return state[0] ^ state[1] ^ state[2] ^ state[3];
+}
+
 /**
  * @brief Creates a new string by converting the given string to uppercase.
  * The caller owns the returned string and must free it using mvn_str_free.
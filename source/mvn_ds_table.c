@@ -0,0 +1,657 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#define MVN_DS_ALLOC_KIND MVN_DS_ALLOC_KIND_TABLE // Allocation statistics category
+
+#include "mvn_ds/mvn_ds_table.h"
+
+#include "mvn_ds/mvn_ds.h"        // For mvn_val_deep_copy, mvn_val_free, mvn_val_memory_usage
+#include "mvn_ds/mvn_ds_arr.h"    // For mvn_arr_new_capacity, mvn_arr_push, mvn_arr_free
+#include "mvn_ds/mvn_ds_bitset.h" // For mvn_bitset_new, mvn_bitset_set, mvn_bitset_test
+#include "mvn_ds/mvn_ds_hmap.h"   // For mvn_hmap_new, mvn_hmap_get, mvn_hmap_set_cstr
+#include "mvn_ds/mvn_ds_str.h"    // For mvn_str_new, mvn_str_free, mvn_str_equal_cstr
+#include "mvn_ds/mvn_ds_utils.h"  // For MVN_DS_MALLOC, MVN_DS_CALLOC, MVN_DS_REALLOC, MVN_DS_FREE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h> // For qsort
+#include <string.h> // For memset, strcmp
+
+// Kinds of values found in a field, combined to pick the field's column type
+#define MVN_TABLE_SEEN_BOOL     0x01U
+#define MVN_TABLE_SEEN_INT      0x02U // Any integer that fits in int64_t
+#define MVN_TABLE_SEEN_NEGATIVE 0x04U // A negative integer
+#define MVN_TABLE_SEEN_BIG      0x08U // An unsigned integer above INT64_MAX
+#define MVN_TABLE_SEEN_FLOAT    0x10U
+#define MVN_TABLE_SEEN_STRING   0x20U
+#define MVN_TABLE_SEEN_OTHER    0x40U
+
+/**
+ * @internal
+ * @brief A field found while scanning the records, before its column is allocated.
+ */
+typedef struct mvn_table_field_t {
+    mvn_str_t *name; /**< Owned field name. */
+    unsigned   seen; /**< MVN_TABLE_SEEN_* flags of the field's non-null values. */
+} mvn_table_field_t;
+
+// --- Static Helper Functions ---
+
+/**
+ * @internal
+ * @brief Returns an integer value as int64_t (u64 values above INT64_MAX wrap).
+ */
+static int64_t mvn_table_as_i64(const mvn_val_t *value)
+{
+    switch (value->type) {
+        case MVN_VAL_I8:
+            return value->i8;
+        case MVN_VAL_I16:
+            return value->i16;
+        case MVN_VAL_I32:
+            return value->i32;
+        case MVN_VAL_I64:
+            return value->i64;
+        case MVN_VAL_U8:
+            return value->u8;
+        case MVN_VAL_U16:
+            return value->u16;
+        case MVN_VAL_U32:
+            return value->u32;
+        case MVN_VAL_U64:
+            return (int64_t)value->u64;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @internal
+ * @brief Returns the MVN_TABLE_SEEN_* flags describing one value (0 for null).
+ */
+static unsigned mvn_table_classify(const mvn_val_t *value)
+{
+    switch (value->type) {
+        case MVN_VAL_NULL:
+            return 0;
+        case MVN_VAL_BOOL:
+            return MVN_TABLE_SEEN_BOOL;
+        case MVN_VAL_I8:
+        case MVN_VAL_I16:
+        case MVN_VAL_I32:
+        case MVN_VAL_I64:
+            return mvn_table_as_i64(value) < 0 ? MVN_TABLE_SEEN_INT | MVN_TABLE_SEEN_NEGATIVE
+                                               : MVN_TABLE_SEEN_INT;
+        case MVN_VAL_U8:
+        case MVN_VAL_U16:
+        case MVN_VAL_U32:
+            return MVN_TABLE_SEEN_INT;
+        case MVN_VAL_U64:
+            return value->u64 > INT64_MAX ? MVN_TABLE_SEEN_BIG : MVN_TABLE_SEEN_INT;
+        case MVN_VAL_F32:
+        case MVN_VAL_F64:
+            return MVN_TABLE_SEEN_FLOAT;
+        case MVN_VAL_STRING:
+            return value->str != NULL ? MVN_TABLE_SEEN_STRING : MVN_TABLE_SEEN_OTHER;
+        default:
+            return MVN_TABLE_SEEN_OTHER;
+    }
+}
+
+/**
+ * @internal
+ * @brief Picks the narrowest column type that holds every value of a field exactly.
+ */
+static mvn_table_type_t mvn_table_pick_type(unsigned seen)
+{
+    switch (seen) {
+        case 0:
+            return MVN_TABLE_NULL;
+        case MVN_TABLE_SEEN_BOOL:
+            return MVN_TABLE_BOOL;
+        case MVN_TABLE_SEEN_INT:
+        case MVN_TABLE_SEEN_INT | MVN_TABLE_SEEN_NEGATIVE:
+            return MVN_TABLE_I64;
+        case MVN_TABLE_SEEN_BIG:
+        case MVN_TABLE_SEEN_INT | MVN_TABLE_SEEN_BIG:
+            return MVN_TABLE_U64;
+        case MVN_TABLE_SEEN_FLOAT:
+            return MVN_TABLE_F64;
+        case MVN_TABLE_SEEN_STRING:
+            return MVN_TABLE_STRING;
+        default:
+            return MVN_TABLE_VALUE; // Mixed kinds, or negative and big integers together
+    }
+}
+
+/**
+ * @internal
+ * @brief Bytes of row storage per row for a column type.
+ */
+static size_t mvn_table_row_size(mvn_table_type_t type)
+{
+    switch (type) {
+        case MVN_TABLE_BOOL:
+            return sizeof(uint8_t);
+        case MVN_TABLE_I64:
+            return sizeof(int64_t);
+        case MVN_TABLE_U64:
+            return sizeof(uint64_t);
+        case MVN_TABLE_F64:
+            return sizeof(double);
+        case MVN_TABLE_STRING:
+            return sizeof(uint32_t);
+        case MVN_TABLE_VALUE:
+            return sizeof(mvn_val_t);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @internal
+ * @brief Orders fields by name.
+ */
+static int mvn_table_compare_fields(const void *a, const void *b)
+{
+    return strcmp(((const mvn_table_field_t *)a)->name->data,
+                  ((const mvn_table_field_t *)b)->name->data);
+}
+
+/**
+ * @internal
+ * @brief First pass over the records: finds every field and the kinds of its values. names
+ * maps each field name to its index in *fields.
+ * @return false if a record is not a hash map or on allocation failure. The names already
+ *         stored in *fields are owned by the caller either way.
+ */
+static bool mvn_table_collect_fields(const mvn_arr_t *rows,
+                                     mvn_hmap_t *names,
+                                     mvn_table_field_t **fields,
+                                     size_t *field_count)
+{
+    size_t capacity = 0;
+    for (size_t row = 0; row < rows->count; row++) {
+        const mvn_val_t *record = &rows->data[row];
+        if (record->type != MVN_VAL_HASHMAP || record->hmap == NULL) {
+            fprintf(stderr, "[MVN_DS_TABLE] Row %zu is not a hash map.\n", row);
+            return false;
+        }
+        const mvn_hmap_t *hmap = record->hmap;
+        for (size_t bucket = 0; bucket < hmap->capacity; bucket++) {
+            for (const mvn_hmap_entry_t *entry = hmap->buckets[bucket]; entry != NULL;
+                 entry = entry->next) {
+                const mvn_val_t *known = mvn_hmap_get(names, entry->key);
+                size_t           index = known != NULL ? (size_t)known->u64 : *field_count;
+                if (known == NULL) {
+                    if (*field_count == capacity) {
+                        size_t             new_capacity = capacity == 0 ? 8 : capacity * 2;
+                        mvn_table_field_t *grown        = (mvn_table_field_t *)MVN_DS_REALLOC(
+                            *fields, new_capacity * sizeof(mvn_table_field_t));
+                        if (grown == NULL) {
+                            return false;
+                        }
+                        *fields  = grown;
+                        capacity = new_capacity;
+                    }
+                    mvn_str_t *name = mvn_str_new(entry->key->data);
+                    if (name == NULL) {
+                        return false;
+                    }
+                    (*fields)[index] = (mvn_table_field_t){.name = name, .seen = 0};
+                    (*field_count)++;
+                    if (!mvn_hmap_set_cstr(names, name->data, mvn_val_u64(index))) {
+                        return false;
+                    }
+                }
+                (*fields)[index].seen |= mvn_table_classify(&entry->value);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Allocates a column's validity bitmap, row storage and dictionary. Null rows are
+ * pre-filled: 0 for packed types, MVN_DS_TABLE_NULL_CODE for codes, MVN_VAL_NULL for values.
+ */
+static bool mvn_table_init_column(mvn_table_col_t *column, size_t row_count)
+{
+    column->valid = mvn_bitset_new(row_count);
+    if (column->valid == NULL) {
+        return false;
+    }
+    size_t row_size = mvn_table_row_size(column->type);
+    if (row_size > 0 && row_count > 0) {
+        if (row_count > SIZE_MAX / row_size) {
+            fprintf(stderr, "[MVN_DS_TABLE] Column size overflow.\n");
+            return false;
+        }
+        column->data = MVN_DS_CALLOC(row_count, row_size);
+        if (column->data == NULL) {
+            fprintf(stderr, "[MVN_DS_TABLE] Failed to allocate column storage.\n");
+            return false;
+        }
+    }
+    if (column->type == MVN_TABLE_STRING) {
+        if (column->codes != NULL) {
+            memset(column->codes, 0xFF, row_count * sizeof(uint32_t)); // MVN_DS_TABLE_NULL_CODE
+        }
+        column->dictionary = mvn_arr_new();
+        if (column->dictionary == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Stores a record's value in a column row and marks the row valid. Strings are looked
+ * up in codes (string to dictionary index) and added to the dictionary on first sight.
+ */
+static bool
+mvn_table_store(mvn_table_col_t *column, mvn_hmap_t *codes, size_t row, const mvn_val_t *value)
+{
+    if (value->type == MVN_VAL_NULL) {
+        return true;
+    }
+    switch (column->type) {
+        case MVN_TABLE_BOOL:
+            column->bools[row] = value->b ? 1 : 0;
+            break;
+        case MVN_TABLE_I64:
+            column->i64[row] = mvn_table_as_i64(value);
+            break;
+        case MVN_TABLE_U64:
+            column->u64[row] = (uint64_t)mvn_table_as_i64(value); // Every value is >= 0
+            break;
+        case MVN_TABLE_F64:
+            column->f64[row] = value->type == MVN_VAL_F32 ? (double)value->f32 : value->f64;
+            break;
+        case MVN_TABLE_STRING: {
+            const mvn_val_t *code = mvn_hmap_get(codes, value->str);
+            if (code != NULL) {
+                column->codes[row] = (uint32_t)code->u64;
+                break;
+            }
+            size_t next = column->dictionary->count;
+            if (next >= MVN_DS_TABLE_NULL_CODE) {
+                fprintf(stderr, "[MVN_DS_TABLE] Too many distinct strings in a column.\n");
+                return false;
+            }
+            mvn_val_t copy = mvn_val_deep_copy(value);
+            if (copy.type != MVN_VAL_STRING || !mvn_arr_push(column->dictionary, copy) ||
+                !mvn_hmap_set_cstr(codes, value->str->data, mvn_val_u64(next))) {
+                return false;
+            }
+            column->codes[row] = (uint32_t)next;
+            break;
+        }
+        case MVN_TABLE_VALUE:
+            column->values[row] = mvn_val_deep_copy(value);
+            if (column->values[row].type != value->type) {
+                return false; // The copy failed
+            }
+            break;
+        default:
+            break;
+    }
+    return mvn_bitset_set(column->valid, row);
+}
+
+/**
+ * @internal
+ * @brief Second pass over the records: fills the allocated columns. names maps each field
+ * name to its column index.
+ */
+static bool mvn_table_fill(mvn_table_t *table, const mvn_arr_t *rows, const mvn_hmap_t *names)
+{
+    // String to code maps for the string columns, only needed while building
+    mvn_hmap_t **codes = (mvn_hmap_t **)MVN_DS_CALLOC(table->column_count, sizeof(mvn_hmap_t *));
+    bool         ok    = codes != NULL || table->column_count == 0;
+    for (size_t index = 0; ok && index < table->column_count; index++) {
+        if (table->columns[index].type == MVN_TABLE_STRING) {
+            codes[index] = mvn_hmap_new();
+            ok           = codes[index] != NULL;
+        }
+    }
+
+    for (size_t row = 0; ok && row < rows->count; row++) {
+        const mvn_hmap_t *hmap = rows->data[row].hmap;
+        for (size_t bucket = 0; ok && bucket < hmap->capacity; bucket++) {
+            for (const mvn_hmap_entry_t *entry = hmap->buckets[bucket]; ok && entry != NULL;
+                 entry = entry->next) {
+                size_t index = (size_t)mvn_hmap_get(names, entry->key)->u64;
+                ok = mvn_table_store(&table->columns[index], codes[index], row, &entry->value);
+            }
+        }
+    }
+
+    for (size_t index = 0; codes != NULL && index < table->column_count; index++) {
+        mvn_hmap_free(codes[index]);
+    }
+    MVN_DS_FREE(codes);
+    return ok;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Builds a table from an array of hash map records in two passes: the first finds the
+ * fields and the kinds of their values, the second copies each value into its column.
+ * @param rows The records. Not modified; every element must be an MVN_VAL_HASHMAP.
+ * @return A new table, or NULL on allocation failure or invalid input.
+ */
+mvn_table_t *mvn_table_from_rows(const mvn_arr_t *rows)
+{
+    if (rows == NULL) {
+        return NULL;
+    }
+    mvn_hmap_t        *names       = mvn_hmap_new();
+    mvn_table_field_t *fields      = NULL;
+    size_t             field_count = 0;
+    mvn_table_t       *table       = NULL;
+    bool ok = names != NULL && mvn_table_collect_fields(rows, names, &fields, &field_count);
+
+    if (ok) {
+        table = (mvn_table_t *)MVN_DS_CALLOC(1, sizeof(mvn_table_t));
+        ok    = table != NULL;
+    }
+    if (ok && field_count > 0) {
+        table->columns = (mvn_table_col_t *)MVN_DS_CALLOC(field_count, sizeof(mvn_table_col_t));
+        ok             = table->columns != NULL;
+    }
+    if (ok) {
+        table->row_count    = rows->count;
+        table->column_count = field_count;
+    }
+    if (ok && field_count > 0) {
+        // Sorted columns; the names map is repointed at the sorted indexes
+        qsort(fields, field_count, sizeof(mvn_table_field_t), mvn_table_compare_fields);
+        for (size_t index = 0; index < field_count; index++) {
+            mvn_table_col_t *column = &table->columns[index];
+            column->name            = fields[index].name;
+            column->type            = mvn_table_pick_type(fields[index].seen);
+            fields[index].name      = NULL; // Now owned by the column
+            mvn_hmap_cstr(names, column->name->data)->u64 = index;
+            ok = ok && mvn_table_init_column(column, rows->count);
+        }
+    }
+    ok = ok && mvn_table_fill(table, rows, names);
+
+    for (size_t index = 0; index < field_count; index++) {
+        mvn_str_free(fields[index].name);
+    }
+    MVN_DS_FREE(fields);
+    mvn_hmap_free(names);
+    if (!ok) {
+        fprintf(stderr, "[MVN_DS_TABLE] Failed to build table.\n");
+        mvn_table_free(table);
+        return NULL;
+    }
+    return table;
+}
+
+/**
+ * @brief Frees the table, its columns, their dictionaries and the values they hold.
+ * @param table The table to free. If NULL, the function does nothing.
+ */
+void mvn_table_free(mvn_table_t *table)
+{
+    if (table == NULL) {
+        return;
+    }
+    for (size_t index = 0; index < table->column_count; index++) {
+        mvn_table_col_t *column = &table->columns[index];
+        if (column->type == MVN_TABLE_VALUE && column->values != NULL) {
+            for (size_t row = 0; row < table->row_count; row++) {
+                mvn_val_free(&column->values[row]);
+            }
+        }
+        mvn_str_free(column->name);
+        mvn_bitset_free(column->valid);
+        mvn_arr_free(column->dictionary);
+        MVN_DS_FREE(column->data);
+    }
+    MVN_DS_FREE(table->columns);
+    MVN_DS_FREE(table);
+}
+
+/**
+ * @brief Converts the table back to records. Each record holds the valid rows of the columns,
+ * so fields that were null or missing are left out.
+ * @param table The table. Can be NULL.
+ * @return A new array of MVN_VAL_HASHMAP values owned by the caller, or NULL on failure.
+ */
+mvn_arr_t *mvn_table_to_rows(const mvn_table_t *table)
+{
+    if (table == NULL) {
+        return NULL;
+    }
+    mvn_arr_t *rows = mvn_arr_new_capacity(table->row_count);
+    if (rows == NULL) {
+        return NULL;
+    }
+    for (size_t row = 0; row < table->row_count; row++) {
+        mvn_hmap_t *record = mvn_hmap_new();
+        bool        ok     = record != NULL;
+        for (size_t index = 0; ok && index < table->column_count; index++) {
+            const mvn_table_col_t *column = &table->columns[index];
+            if (mvn_bitset_test(column->valid, row)) {
+                ok = mvn_hmap_set_cstr(record, column->name->data, mvn_table_cell(column, row));
+            }
+        }
+        if (!ok || !mvn_arr_push(rows, mvn_val_hmap_take(record))) {
+            if (!ok) {
+                mvn_hmap_free(record);
+            }
+            fprintf(stderr, "[MVN_DS_TABLE] Failed to convert row %zu.\n", row);
+            mvn_arr_free(rows);
+            return NULL;
+        }
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns the number of rows.
+ * @param table The table. Can be NULL.
+ * @return The row count, or 0 if table is NULL.
+ */
+size_t mvn_table_row_count(const mvn_table_t *table)
+{
+    return table != NULL ? table->row_count : 0;
+}
+
+/**
+ * @brief Returns the number of columns.
+ * @param table The table. Can be NULL.
+ * @return The column count, or 0 if table is NULL.
+ */
+size_t mvn_table_column_count(const mvn_table_t *table)
+{
+    return table != NULL ? table->column_count : 0;
+}
+
+/**
+ * @brief Returns a column by position.
+ * @param table The table. Can be NULL.
+ * @param index Index of the column in name order.
+ * @return The column, or NULL if table is NULL or index is out of bounds.
+ */
+const mvn_table_col_t *mvn_table_column(const mvn_table_t *table, size_t index)
+{
+    if (table == NULL || index >= table->column_count) {
+        return NULL;
+    }
+    return &table->columns[index];
+}
+
+/**
+ * @brief Returns a column by field name, found by binary search over the sorted columns.
+ * @param table The table. Can be NULL.
+ * @param name_cstr The field name. Can be NULL.
+ * @return The column, or NULL if there is none.
+ */
+const mvn_table_col_t *mvn_table_column_cstr(const mvn_table_t *table, const char *name_cstr)
+{
+    if (table == NULL || name_cstr == NULL) {
+        return NULL;
+    }
+    size_t low  = 0;
+    size_t high = table->column_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int    order  = strcmp(table->columns[middle].name->data, name_cstr);
+        if (order == 0) {
+            return &table->columns[middle];
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns a copy of one row of a column.
+ * @param column The column. Can be NULL.
+ * @param row The row index.
+ * @return A new value owned by the caller; MVN_VAL_NULL for a null row, an out-of-bounds row
+ *         or a NULL column.
+ */
+mvn_val_t mvn_table_cell(const mvn_table_col_t *column, size_t row)
+{
+    if (column == NULL || !mvn_bitset_test(column->valid, row)) {
+        return mvn_val_null();
+    }
+    switch (column->type) {
+        case MVN_TABLE_BOOL:
+            return mvn_val_bool(column->bools[row] != 0);
+        case MVN_TABLE_I64:
+            return mvn_val_i64(column->i64[row]);
+        case MVN_TABLE_U64:
+            return mvn_val_u64(column->u64[row]);
+        case MVN_TABLE_F64:
+            return mvn_val_f64(column->f64[row]);
+        case MVN_TABLE_STRING:
+            return mvn_val_deep_copy(&column->dictionary->data[column->codes[row]]);
+        case MVN_TABLE_VALUE:
+            return mvn_val_deep_copy(&column->values[row]);
+        default:
+            return mvn_val_null();
+    }
+}
+
+/**
+ * @brief Calculates the memory held by the table: its columns' names, bitmaps, row storage,
+ * dictionaries and the heap memory of MVN_TABLE_VALUE values.
+ * @param table The table. Can be NULL.
+ * @return The size in bytes, or 0 if table is NULL.
+ */
+size_t mvn_table_memory_usage(const mvn_table_t *table)
+{
+    if (table == NULL) {
+        return 0;
+    }
+    size_t total = sizeof(mvn_table_t) + table->column_count * sizeof(mvn_table_col_t);
+    for (size_t index = 0; index < table->column_count; index++) {
+        const mvn_table_col_t *column = &table->columns[index];
+        mvn_val_t              name   = {.type = MVN_VAL_STRING, .str = column->name};
+        mvn_val_t              valid  = {.type = MVN_VAL_BITSET, .bits = column->valid};
+        total += mvn_val_memory_usage(&name) + mvn_val_memory_usage(&valid);
+        total += table->row_count * mvn_table_row_size(column->type);
+        if (column->dictionary != NULL) {
+            mvn_val_t dictionary = {.type = MVN_VAL_ARRAY, .arr = column->dictionary};
+            total += mvn_val_memory_usage(&dictionary);
+        }
+        if (column->type == MVN_TABLE_VALUE) {
+            for (size_t row = 0; row < table->row_count; row++) {
+                total += mvn_val_memory_usage(&column->values[row]);
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Sums a column. Null rows hold 0, so the loops read only the row storage, never the
+ * validity bitmap; the float sum keeps four partial sums to overlap the additions.
+ * @param column The column. Can be NULL.
+ * @return The sum, or 0 for a NULL or non-numeric column.
+ */
+double mvn_table_sum(const mvn_table_col_t *column)
+{
+    if (column == NULL || column->data == NULL) {
+        return 0.0;
+    }
+    size_t row_count = mvn_bitset_size(column->valid);
+    switch (column->type) {
+        case MVN_TABLE_BOOL: {
+            size_t total = 0;
+            for (size_t row = 0; row < row_count; row++) {
+                total += column->bools[row];
+            }
+            return (double)total;
+        }
+        case MVN_TABLE_I64:
+        case MVN_TABLE_U64: {
+            uint64_t total = 0; // Unsigned, so overflow wraps instead of being undefined
+            for (size_t row = 0; row < row_count; row++) {
+                total += column->u64[row];
+            }
+            return column->type == MVN_TABLE_I64 ? (double)(int64_t)total : (double)total;
+        }
+        case MVN_TABLE_F64: {
+            double partial[4] = {0.0, 0.0, 0.0, 0.0};
+            size_t row        = 0;
+            for (; row + 4 <= row_count; row += 4) {
+                partial[0] += column->f64[row];
+                partial[1] += column->f64[row + 1];
+                partial[2] += column->f64[row + 2];
+                partial[3] += column->f64[row + 3];
+            }
+            for (; row < row_count; row++) {
+                partial[0] += column->f64[row];
+            }
+            return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+        }
+        default:
+            return 0.0;
+    }
+}
+
+/**
+ * @brief Counts the rows of a string column equal to a string. Null rows hold
+ * MVN_DS_TABLE_NULL_CODE, which never matches, so the loop compares codes only.
+ * @param column The column. Can be NULL.
+ * @param value_cstr The string to count. Can be NULL.
+ * @return The number of matching rows; 0 if the column is not a string column.
+ */
+size_t mvn_table_count_cstr(const mvn_table_col_t *column, const char *value_cstr)
+{
+    if (column == NULL || value_cstr == NULL || column->type != MVN_TABLE_STRING) {
+        return 0;
+    }
+    size_t code = 0;
+    while (code < column->dictionary->count &&
+           !mvn_str_equal_cstr(column->dictionary->data[code].str, value_cstr)) {
+        code++;
+    }
+    if (code == column->dictionary->count) {
+        return 0;
+    }
+    size_t   row_count = mvn_bitset_size(column->valid);
+    uint32_t wanted    = (uint32_t)code;
+    size_t   matches   = 0;
+    for (size_t row = 0; row < row_count; row++) {
+        matches += column->codes[row] == wanted;
+    }
+    return matches;
+}
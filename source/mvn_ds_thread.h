@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_THREAD_H
+#define MVN_DS_THREAD_H
+
+// Private threading and atomics layer shared by the concurrent modules.
+// Not installed; only included from files in source/.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h> // For malloc, free (thread start blocks)
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MVN_DS_THREAD_LOCAL __declspec(thread)
+#else
+#define MVN_DS_THREAD_LOCAL __thread
+#endif
+
+// MSVC targeting ARM64, where plain loads and stores are not ordered by the hardware
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_ARM64) || defined(_M_ARM64EC))
+#define MVN_DS_MSVC_ARM64 1
+#else
+#define MVN_DS_MSVC_ARM64 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+// --- Threads ---
+
+#if defined(_WIN32)
+typedef HANDLE             mvn_thread_t;
+typedef SRWLOCK            mvn_mutex_t;
+typedef CONDITION_VARIABLE mvn_cond_t;
+#else
+typedef pthread_t       mvn_thread_t;
+typedef pthread_mutex_t mvn_mutex_t;
+typedef pthread_cond_t  mvn_cond_t;
+#endif
+
+typedef void (*mvn_thread_fn_t)(void *argument);
+
+/**
+ * @internal
+ * @brief Start parameters handed to the platform thread entry point.
+ */
+typedef struct mvn_thread_start_t {
+    mvn_thread_fn_t function; /**< Function to run on the new thread. */
+    void           *argument; /**< Argument passed to function. */
+} mvn_thread_start_t;
+
+#if defined(_WIN32)
+static inline DWORD WINAPI mvn_thread_entry(LPVOID param)
+{
+    mvn_thread_start_t start = *(mvn_thread_start_t *)param;
+    HeapFree(GetProcessHeap(), 0, param);
+    start.function(start.argument);
+    return 0;
+}
+#else
+static inline void *mvn_thread_entry(void *param)
+{
+    mvn_thread_start_t start = *(mvn_thread_start_t *)param;
+    free(param);
+    start.function(start.argument);
+    return NULL;
+}
+#endif
+
+/**
+ * @internal
+ * @brief Starts a new thread running function(argument).
+ * @return true on success, false if the thread could not be created.
+ */
+static inline bool mvn_thread_create(mvn_thread_t *thread, mvn_thread_fn_t function, void *argument)
+{
+#if defined(_WIN32)
+    mvn_thread_start_t *start =
+        (mvn_thread_start_t *)HeapAlloc(GetProcessHeap(), 0, sizeof(mvn_thread_start_t));
+    if (start == NULL) {
+        return false;
+    }
+    start->function = function;
+    start->argument = argument;
+    *thread         = CreateThread(NULL, 0, mvn_thread_entry, start, 0, NULL);
+    if (*thread == NULL) {
+        HeapFree(GetProcessHeap(), 0, start);
+        return false;
+    }
+    return true;
+#else
+    mvn_thread_start_t *start = (mvn_thread_start_t *)malloc(sizeof(mvn_thread_start_t));
+    if (start == NULL) {
+        return false;
+    }
+    start->function = function;
+    start->argument = argument;
+    if (pthread_create(thread, NULL, mvn_thread_entry, start) != 0) {
+        free(start);
+        return false;
+    }
+    return true;
+#endif
+}
+
+static inline void mvn_thread_join(mvn_thread_t thread)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+static inline void mvn_thread_yield(void)
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/**
+ * @internal
+ * @brief Returns the number of online hardware threads (at least 1).
+ */
+static inline size_t mvn_thread_hardware_concurrency(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (size_t)online : 1;
+#endif
+}
+
+static inline void mvn_mutex_init(mvn_mutex_t *mutex)
+{
+#if defined(_WIN32)
+    InitializeSRWLock(mutex);
+#else
+    pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+static inline void mvn_mutex_destroy(mvn_mutex_t *mutex)
+{
+#if defined(_WIN32)
+    (void)mutex; // SRW locks need no cleanup
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+static inline void mvn_mutex_lock(mvn_mutex_t *mutex)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+static inline void mvn_mutex_unlock(mvn_mutex_t *mutex)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+static inline void mvn_cond_init(mvn_cond_t *cond)
+{
+#if defined(_WIN32)
+    InitializeConditionVariable(cond);
+#else
+    pthread_cond_init(cond, NULL);
+#endif
+}
+
+static inline void mvn_cond_destroy(mvn_cond_t *cond)
+{
+#if defined(_WIN32)
+    (void)cond; // Condition variables need no cleanup
+#else
+    pthread_cond_destroy(cond);
+#endif
+}
+
+static inline void mvn_cond_wait(mvn_cond_t *cond, mvn_mutex_t *mutex)
+{
+#if defined(_WIN32)
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+#else
+    pthread_cond_wait(cond, mutex);
+#endif
+}
+
+static inline void mvn_cond_signal(mvn_cond_t *cond)
+{
+#if defined(_WIN32)
+    WakeConditionVariable(cond);
+#else
+    pthread_cond_signal(cond);
+#endif
+}
+
+static inline void mvn_cond_broadcast(mvn_cond_t *cond)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(cond);
+#else
+    pthread_cond_broadcast(cond);
+#endif
+}
+
+// --- Atomics ---
+// GCC/Clang use the __atomic builtins. MSVC uses Interlocked* for read-modify-write operations
+// and aligned volatile accesses for loads and stores: on x86/x64 the hardware already orders
+// those, so a compiler barrier gives acquire/release; on ARM64 they go through LDAR/STLR.
+
+static inline void mvn_cpu_relax(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static inline void mvn_atomic_fence_seq_cst(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    MemoryBarrier();
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline void mvn_atomic_fence_release(void)
+{
+#if MVN_DS_MSVC_ARM64
+    __dmb(_ARM64_BARRIER_ISH);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#endif
+}
+
+static inline int64_t mvn_atomic_load_relaxed_i64(volatile int64_t *target)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return *target;
+#else
+    return __atomic_load_n(target, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline int64_t mvn_atomic_load_acquire_i64(volatile int64_t *target)
+{
+#if MVN_DS_MSVC_ARM64
+    return (int64_t)__ldar64((volatile unsigned __int64 *)target);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int64_t value = *target;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void mvn_atomic_store_relaxed_i64(volatile int64_t *target, int64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline bool mvn_atomic_cas_i64(volatile int64_t *target, int64_t expected, int64_t desired)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _InterlockedCompareExchange64((volatile long long *)target, desired, expected) ==
+           expected;
+#else
+    return __atomic_compare_exchange_n(
+        target, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline size_t mvn_atomic_load_acquire_size(volatile size_t *target)
+{
+#if MVN_DS_MSVC_ARM64
+    return (size_t)__ldar64((volatile unsigned __int64 *)target);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    size_t value = *target;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void mvn_atomic_store_release_size(volatile size_t *target, size_t value)
+{
+#if MVN_DS_MSVC_ARM64
+    __stlr64((volatile unsigned __int64 *)target, (unsigned __int64)value);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static inline size_t mvn_atomic_fetch_add_size(volatile size_t *target, size_t delta)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64)
+    return (size_t)_InterlockedExchangeAdd64((volatile long long *)target, (long long)delta);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    return (size_t)_InterlockedExchangeAdd((volatile long *)target, (long)delta);
+#else
+    return __atomic_fetch_add(target, delta, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline size_t mvn_atomic_fetch_sub_size(volatile size_t *target, size_t delta)
+{
+    return mvn_atomic_fetch_add_size(target, (size_t)0 - delta);
+}
+
+static inline bool mvn_atomic_cas_size(volatile size_t *target, size_t expected, size_t desired)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64)
+    return (size_t)_InterlockedCompareExchange64(
+               (volatile long long *)target, (long long)desired, (long long)expected) == expected;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    return (size_t)_InterlockedCompareExchange(
+               (volatile long *)target, (long)desired, (long)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(
+        target, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline uint8_t mvn_atomic_load_acquire_u8(volatile uint8_t *target)
+{
+#if MVN_DS_MSVC_ARM64
+    return (uint8_t)__ldar8((volatile unsigned __int8 *)target);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    uint8_t value = *target;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void mvn_atomic_store_release_u8(volatile uint8_t *target, uint8_t value)
+{
+#if MVN_DS_MSVC_ARM64
+    __stlr8((volatile unsigned __int8 *)target, (unsigned __int8)value);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static inline void *mvn_atomic_load_acquire_ptr(void *volatile *target)
+{
+#if MVN_DS_MSVC_ARM64
+    return (void *)__ldar64((volatile unsigned __int64 *)target);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    void *value = *target;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void *mvn_atomic_load_relaxed_ptr(void *volatile *target)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return *target;
+#else
+    return __atomic_load_n(target, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline void mvn_atomic_store_release_ptr(void *volatile *target, void *value)
+{
+#if MVN_DS_MSVC_ARM64
+    __stlr64((volatile unsigned __int64 *)target, (unsigned __int64)(uintptr_t)value);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static inline void mvn_atomic_store_relaxed_ptr(void *volatile *target, void *value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline bool mvn_atomic_cas_ptr(void *volatile *target, void *expected, void *desired)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _InterlockedCompareExchangePointer(target, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(
+        target, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_THREAD_H */
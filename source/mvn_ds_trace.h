@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#ifndef MVN_DS_TRACE_H
+#define MVN_DS_TRACE_H
+
+// Private static tracepoints (USDT, provider "mvn_ds") for resizes, large allocations and
+// deep copies. Built only with MVN_DS_ENABLE_USDT; otherwise every macro compiles to nothing.
+// An enabled probe is a single nop until a tracer attaches, so release builds can keep them.
+// Not installed; only included from files in source/. See tools/bpftrace for consumers.
+//
+// Probes (arguments in order):
+//   hmap_resize_start(hmap, old_capacity, new_capacity, count)  Rehash of every entry
+//   hmap_resize_done(hmap, new_capacity, ok)
+//   arr_resize_start(array, old_capacity, new_capacity)
+//   arr_resize_done(array, new_capacity, ok)
+//   str_resize_start(string, old_capacity, new_capacity)
+//   str_resize_done(string, new_capacity, ok)
+//   large_alloc(bytes, kind)  Allocation of at least MVN_DS_TRACE_LARGE_ALLOCATION bytes
+//   deep_copy_start(value, type)  Once per mvn_val_deep_copy call, not per nested value
+//   deep_copy_done(value, type, ok)
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocations of at least this many bytes fire the large_alloc probe
+#ifndef MVN_DS_TRACE_LARGE_ALLOCATION
+#define MVN_DS_TRACE_LARGE_ALLOCATION ((size_t)1 << 20)
+#endif
+
+#ifdef MVN_DS_ENABLE_USDT
+
+#include <sys/sdt.h>
+
+#define MVN_DS_TRACE1(name, a)          DTRACE_PROBE1(mvn_ds, name, a)
+#define MVN_DS_TRACE2(name, a, b)       DTRACE_PROBE2(mvn_ds, name, a, b)
+#define MVN_DS_TRACE3(name, a, b, c)    DTRACE_PROBE3(mvn_ds, name, a, b, c)
+#define MVN_DS_TRACE4(name, a, b, c, d) DTRACE_PROBE4(mvn_ds, name, a, b, c, d)
+
+// Fires large_alloc for allocations of at least MVN_DS_TRACE_LARGE_ALLOCATION bytes
+#define MVN_DS_TRACE_ALLOCATION(bytes, kind)                                  \
+    do {                                                                      \
+        if ((size_t)(bytes) >= MVN_DS_TRACE_LARGE_ALLOCATION) {               \
+            DTRACE_PROBE2(mvn_ds, large_alloc, (size_t)(bytes), (int)(kind)); \
+        }                                                                     \
+    } while (0)
+
+#else
+
+#define MVN_DS_TRACE1(name, a)               ((void)0)
+#define MVN_DS_TRACE2(name, a, b)            ((void)0)
+#define MVN_DS_TRACE3(name, a, b, c)         ((void)0)
+#define MVN_DS_TRACE4(name, a, b, c, d)      ((void)0)
+#define MVN_DS_TRACE_ALLOCATION(bytes, kind) ((void)0)
+
+#endif /* MVN_DS_ENABLE_USDT */
+
+#endif /* MVN_DS_TRACE_H */
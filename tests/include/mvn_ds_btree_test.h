@@ -0,0 +1,20 @@
+#ifndef MVN_DS_BTREE_TEST_H
+#define MVN_DS_BTREE_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Run all B+tree tests
+ * \param[out]      passed: Pointer to integer to increment for passed tests
+ * \param[out]      failed: Pointer to integer to increment for failed tests
+ * \param[out]      total: Pointer to integer to increment for total tests run
+ */
+int run_btree_tests(int *passed, int *failed, int *total);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_DS_BTREE_TEST_H */
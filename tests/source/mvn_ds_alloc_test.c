@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_alloc_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_alloc.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef MVN_DS_ALLOC_STATS
+
+// --- Helpers ---
+
+static void push_range(size_t begin, size_t end, void *context)
+{
+    (void)context;
+    for (size_t index = begin; index < end; index++) {
+        mvn_arr_t *array = mvn_arr_new();
+        mvn_arr_push(array, mvn_val_str("worker"));
+        mvn_arr_free(array);
+    }
+}
+
+// --- Test Functions ---
+
+static bool test_alloc_stats_counts_by_kind(void)
+{
+    mvn_ds_alloc_stats_t *before = (mvn_ds_alloc_stats_t *)malloc(sizeof(mvn_ds_alloc_stats_t));
+    mvn_ds_alloc_stats_t *after  = (mvn_ds_alloc_stats_t *)malloc(sizeof(mvn_ds_alloc_stats_t));
+    TEST_ASSERT(before != NULL && after != NULL, "Failed to allocate snapshots");
+
+    mvn_ds_alloc_stats_reset();
+    TEST_ASSERT(mvn_ds_alloc_stats(before), "Stats should be enabled");
+    TEST_ASSERT(before->enabled && before->total.allocs == 0 && before->total.frees == 0,
+                "Reset should zero the counters");
+
+    mvn_str_t *str = mvn_str_new("allocation statistics");
+    mvn_arr_t *arr = mvn_arr_new();
+    TEST_ASSERT(str != NULL && arr != NULL, "Failed to create containers");
+    for (int index = 0; index < 100; index++) {
+        mvn_arr_push(arr, mvn_val_i32(index)); // Forces reallocs
+    }
+
+    TEST_ASSERT(mvn_ds_alloc_stats(after), "Stats should be enabled");
+    TEST_ASSERT(after->kinds[MVN_DS_ALLOC_KIND_STR].allocs >= 2, "String struct and buffer");
+    TEST_ASSERT(after->kinds[MVN_DS_ALLOC_KIND_ARR].allocs >= 2, "Array struct and buffer");
+    TEST_ASSERT(after->kinds[MVN_DS_ALLOC_KIND_ARR].reallocs >= 1, "Array growth reallocs");
+    TEST_ASSERT(after->total.live_bytes >
+                    before->total.live_bytes + 100 * sizeof(mvn_val_t) - sizeof(mvn_val_t),
+                "Live bytes should cover the array buffer");
+    TEST_ASSERT(after->total.bytes_requested >= after->total.live_bytes - before->total.live_bytes,
+                "Requested bytes should cover live growth");
+    TEST_ASSERT(mvn_ds_alloc_count() == after->total.allocs + after->total.reallocs,
+                "mvn_ds_alloc_count should match the snapshot");
+
+    // Every tracked site is attributed to the file that allocated it
+    bool found_str_site = false;
+    for (size_t index = 0; index < after->site_count; index++) {
+        const mvn_ds_alloc_site_t *site = &after->sites[index];
+        TEST_ASSERT(site->file != NULL && site->line > 0, "Sites should have a location");
+        if (site->kind == MVN_DS_ALLOC_KIND_STR && site->counters.allocs > 0) {
+            found_str_site = strstr(site->file, "mvn_ds_str.c") != NULL;
+        }
+    }
+    TEST_ASSERT(found_str_site, "A string allocation site should point at mvn_ds_str.c");
+
+    mvn_str_free(str);
+    mvn_arr_free(arr);
+    TEST_ASSERT(mvn_ds_alloc_stats(after), "Stats should be enabled");
+    TEST_ASSERT(after->total.live_bytes == before->total.live_bytes,
+                "Freeing everything should restore live bytes");
+    TEST_ASSERT(after->total.frees == after->total.allocs,
+                "Every allocation should have been freed");
+
+    free(before);
+    free(after);
+    return true;
+}
+
+static bool test_alloc_stats_concurrent(void)
+{
+    mvn_ds_alloc_stats_t *stats = (mvn_ds_alloc_stats_t *)malloc(sizeof(mvn_ds_alloc_stats_t));
+    TEST_ASSERT(stats != NULL, "Failed to allocate snapshot");
+    mvn_ds_alloc_stats(stats);
+    uint64_t live_before = stats->total.live_bytes;
+
+    mvn_pool_t *pool = mvn_pool_new(4);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+    uint64_t allocs_before = mvn_ds_alloc_count();
+
+    // Each iteration allocates at least an array, its buffer, a string and its buffer
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 0, 2000, 50, push_range, NULL),
+                "parallel_for failed");
+    TEST_ASSERT(mvn_ds_alloc_count() - allocs_before >= 2000 * 4,
+                "Allocations from all workers should be counted");
+    mvn_pool_free(pool);
+
+    mvn_ds_alloc_stats(stats);
+    TEST_ASSERT(stats->total.live_bytes == live_before, "Everything allocated should be freed");
+    TEST_ASSERT(stats->kinds[MVN_DS_ALLOC_KIND_POOL].allocs > 0, "Pool allocations are counted");
+
+    free(stats);
+    return true;
+}
+
+#else /* !MVN_DS_ALLOC_STATS */
+
+static bool test_alloc_stats_disabled(void)
+{
+    mvn_ds_alloc_stats_t *stats = (mvn_ds_alloc_stats_t *)malloc(sizeof(mvn_ds_alloc_stats_t));
+    TEST_ASSERT(stats != NULL, "Failed to allocate snapshot");
+    memset(stats, 0xFF, sizeof(*stats));
+
+    mvn_str_t *str = mvn_str_new("untracked");
+    TEST_ASSERT(!mvn_ds_alloc_stats(stats), "Stats should report being compiled out");
+    TEST_ASSERT(!stats->enabled && stats->total.allocs == 0 && stats->site_count == 0,
+                "Disabled stats should be zeroed");
+    TEST_ASSERT(mvn_ds_alloc_count() == 0, "Disabled count should be 0");
+    mvn_ds_alloc_stats_reset(); // Should be a no-op
+    mvn_str_free(str);
+
+    free(stats);
+    return true;
+}
+
+#endif /* MVN_DS_ALLOC_STATS */
+
+static bool test_alloc_stats_null_param_safety(void)
+{
+    TEST_ASSERT(!mvn_ds_alloc_stats(NULL), "Stats into NULL should fail");
+    return true;
+}
+
+// --- Test Runner ---
+
+/**
+ * \brief           Run all allocation statistics tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_alloc_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING ALLOCATION STATISTICS TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+#ifdef MVN_DS_ALLOC_STATS
+    RUN_TEST(test_alloc_stats_counts_by_kind);
+    RUN_TEST(test_alloc_stats_concurrent);
+#else
+    RUN_TEST(test_alloc_stats_disabled);
+#endif
+    RUN_TEST(test_alloc_stats_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_alloc_tests(&passed, &failed, &total);
+
+    printf("\n===== ALLOCATION STATISTICS TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -505,6 +505,127 @@ static bool test_array_getters(void)
     return true;
 }
 
+/**
+ * @brief Tests mvn_arr_unique keeping first and last occurrences of mixed and nested values.
+ */
+static bool test_array_unique(void)
+{
+    // 3, "a", 1, 3, [1, 2], "a", 2, [1, 2], 1, null, null
+    mvn_arr_t *array_ptr = mvn_arr_new();
+    TEST_ASSERT(array_ptr != NULL, "Failed to create array for unique test");
+    for (size_t pass = 0; pass < 2; ++pass) {
+        mvn_arr_clear(array_ptr);
+        mvn_arr_push(array_ptr, mvn_val_i32(3));
+        mvn_arr_push(array_ptr, mvn_val_str("a"));
+        mvn_arr_push(array_ptr, mvn_val_i32(1));
+        mvn_arr_push(array_ptr, mvn_val_i32(3));
+        for (size_t copy = 0; copy < 2; ++copy) {
+            mvn_val_t nested = mvn_val_arr();
+            mvn_arr_push(nested.arr, mvn_val_i32(1));
+            mvn_arr_push(nested.arr, mvn_val_i32(2));
+            mvn_arr_push(array_ptr, nested);
+            mvn_arr_push(array_ptr, copy == 0 ? mvn_val_str("a") : mvn_val_i32(1));
+            if (copy == 0) {
+                mvn_arr_push(array_ptr, mvn_val_i32(2));
+            }
+        }
+        mvn_arr_push(array_ptr, mvn_val_null());
+        mvn_arr_push(array_ptr, mvn_val_null());
+        TEST_ASSERT(array_ptr->count == 11, "Input has 11 values");
+
+        bool keep_first = pass == 0;
+        TEST_ASSERT(mvn_arr_unique(array_ptr, keep_first), "mvn_arr_unique failed");
+        TEST_ASSERT_FMT(array_ptr->count == 6, "6 distinct values, got %zu", array_ptr->count);
+        // First occurrences: 3, "a", 1, [1, 2], 2, null
+        // Last occurrences: 3, "a", 2, [1, 2], 1, null
+        const mvn_val_t *data = array_ptr->data;
+        TEST_ASSERT(data[0].type == MVN_VAL_I32 && data[0].i32 == 3, "3 kept in place");
+        TEST_ASSERT(data[1].type == MVN_VAL_STRING && strcmp(data[1].str->data, "a") == 0,
+                    "String compared by content");
+        TEST_ASSERT(data[2].i32 == (keep_first ? 1 : 2), "Third survivor");
+        TEST_ASSERT(data[3].type == MVN_VAL_ARRAY && data[3].arr->count == 2,
+                    "Nested arrays compared structurally");
+        TEST_ASSERT(data[4].i32 == (keep_first ? 2 : 1), "Fifth survivor");
+        TEST_ASSERT(data[5].type == MVN_VAL_NULL, "Nulls deduplicated");
+        for (size_t index = array_ptr->count; index < array_ptr->capacity; ++index) {
+            TEST_ASSERT(array_ptr->data[index].type == MVN_VAL_NULL, "Freed slots cleared");
+        }
+    }
+
+    // Many values, enough to need a large table: i % 100 for i < 10000
+    mvn_arr_clear(array_ptr);
+    for (int32_t index = 0; index < 10000; ++index) {
+        mvn_arr_push(array_ptr, mvn_val_i32(index % 100));
+    }
+    TEST_ASSERT(mvn_arr_unique(array_ptr, false), "mvn_arr_unique on large array failed");
+    TEST_ASSERT(array_ptr->count == 100, "100 distinct values");
+    for (int32_t index = 0; index < 100; ++index) {
+        TEST_ASSERT(array_ptr->data[index].i32 == index, "Last occurrences in order");
+    }
+
+    TEST_ASSERT(!mvn_arr_unique(NULL, true), "mvn_arr_unique(NULL) should fail");
+    mvn_arr_clear(array_ptr);
+    TEST_ASSERT(mvn_arr_unique(array_ptr, true) && array_ptr->count == 0, "Empty array");
+    mvn_arr_free(array_ptr);
+    return true;
+}
+
+/**
+ * @brief Compares two values with mvn_val_compare, for mvn_arr_sort.
+ */
+static int compare_values(const mvn_val_t *a, const mvn_val_t *b)
+{
+    return mvn_val_compare(a, b);
+}
+
+/**
+ * @brief Tests mvn_arr_unique_sorted on sorted and unsorted input.
+ */
+static bool test_array_unique_sorted(void)
+{
+    mvn_arr_t *array_ptr = mvn_arr_new();
+    mvn_arr_t *unsorted  = mvn_arr_new();
+    TEST_ASSERT(array_ptr != NULL && unsorted != NULL, "Failed to create arrays");
+    const char *words[] = {"pear", "apple", "fig", "apple", "pear", "pear", "kiwi"};
+    for (size_t index = 0; index < 7; ++index) {
+        mvn_arr_push(array_ptr, mvn_val_str(words[index]));
+        mvn_arr_push(unsorted, mvn_val_str(words[index]));
+    }
+
+    // Unsorted: only adjacent duplicates go
+    TEST_ASSERT(mvn_arr_unique_sorted(unsorted), "mvn_arr_unique_sorted failed");
+    TEST_ASSERT(unsorted->count == 6, "Only the adjacent pears merge");
+    mvn_arr_free(unsorted);
+
+    TEST_ASSERT(mvn_arr_sort(array_ptr, compare_values), "Sort failed");
+    TEST_ASSERT(mvn_arr_unique_sorted(array_ptr), "mvn_arr_unique_sorted failed");
+    const char *expected[] = {"apple", "fig", "kiwi", "pear"};
+    TEST_ASSERT(array_ptr->count == 4, "4 distinct words");
+    for (size_t index = 0; index < 4; ++index) {
+        TEST_ASSERT_FMT(strcmp(array_ptr->data[index].str->data, expected[index]) == 0,
+                        "Word %zu",
+                        index);
+    }
+    for (size_t index = array_ptr->count; index < array_ptr->capacity; ++index) {
+        TEST_ASSERT(array_ptr->data[index].type == MVN_VAL_NULL, "Freed slots cleared");
+    }
+
+    TEST_ASSERT(!mvn_arr_unique_sorted(NULL), "mvn_arr_unique_sorted(NULL) should fail");
+    mvn_arr_clear(array_ptr);
+    TEST_ASSERT(mvn_arr_unique_sorted(array_ptr), "Empty array");
+
+    // Epsilon-equal floats hash apart, so only the adjacent pass merges them
+    mvn_arr_push(array_ptr, mvn_val_f64(0.1 + 0.2));
+    mvn_arr_push(array_ptr, mvn_val_f64(0.3));
+    TEST_ASSERT(mvn_val_equal(&array_ptr->data[0], &array_ptr->data[1]), "Epsilon-equal floats");
+    TEST_ASSERT(mvn_arr_unique(array_ptr, true) && array_ptr->count == 2,
+                "mvn_arr_unique keeps floats that differ in any bit");
+    TEST_ASSERT(mvn_arr_unique_sorted(array_ptr) && array_ptr->count == 1,
+                "mvn_arr_unique_sorted merges epsilon-equal floats");
+    mvn_arr_free(array_ptr);
+    return true;
+}
+
 // --- Test Runner ---
 
 /**
@@ -534,6 +655,8 @@ int run_array_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_array_new_capacity_overflow);
     RUN_TEST(test_array_new_slots_initialized_null);
     RUN_TEST(test_array_getters); // Added
+    RUN_TEST(test_array_unique);
+    RUN_TEST(test_array_unique_sorted);
 
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
     (*total_tests) += tests_run;
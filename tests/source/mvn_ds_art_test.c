@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_art_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_art.h"
+#include "mvn_ds/mvn_ds_str.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+#define REFERENCE_KEYS 600
+
+// Builds the key for a key number. Keys share short and long (over 9-byte) prefixes, and some
+// keys are prefixes of others.
+static void reference_key(size_t number, char *key, size_t size)
+{
+    static const char *const prefixes[] = {"", "a", "alpha/beta/gamma/", "alpha/beta/delta/"};
+    snprintf(key, size, "%s%zu", prefixes[number % 4], number / 4 * 37 % 1000);
+}
+
+static int compare_cstr(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+// Checks that iterating with the given prefix yields exactly the expected keys, in order.
+static bool
+iterates_as(const mvn_art_t *art, const char *prefix, const char *const *expected, size_t count)
+{
+    mvn_art_iter_t iter  = mvn_art_prefix(art, prefix);
+    const char    *key   = NULL;
+    size_t         index = 0;
+    while (mvn_art_iter_next(&iter, &key, NULL)) {
+        if (index >= count || strcmp(key, expected[index]) != 0) {
+            printf("  prefix \"%s\": unexpected key \"%s\" at %zu\n", prefix, key, index);
+            return false;
+        }
+        index++;
+    }
+    if (index != count) {
+        printf("  prefix \"%s\": %zu keys, expected %zu\n", prefix, index, count);
+    }
+    return index == count;
+}
+
+// --- Test Functions ---
+
+static bool test_art_put_get_remove(void)
+{
+    mvn_art_t *art = mvn_art_new();
+    TEST_ASSERT(art != NULL, "Failed to create tree");
+    TEST_ASSERT(mvn_art_get_cstr(art, "a") == NULL, "Empty tree misses");
+
+    // Keys that are prefixes of each other end at inner nodes
+    const char *keys[] = {"abc", "a", "ab", "b", "abd", ""};
+    for (int index = 0; index < 6; index++) {
+        TEST_ASSERT(mvn_art_put_cstr(art, keys[index], mvn_val_i32(index)), "Put");
+    }
+    TEST_ASSERT(mvn_art_count(art) == 6, "Six keys");
+    for (int index = 0; index < 6; index++) {
+        mvn_val_t *value = mvn_art_get_cstr(art, keys[index]);
+        TEST_ASSERT_FMT(value != NULL && value->i32 == index, "Get \"%s\"", keys[index]);
+    }
+    TEST_ASSERT(mvn_art_get_cstr(art, "abcd") == NULL, "Extension misses");
+    TEST_ASSERT(mvn_art_get_cstr(art, "ac") == NULL, "Sibling misses");
+
+    // Replacing frees the old value and keeps the count
+    TEST_ASSERT(mvn_art_put_cstr(art, "ab", mvn_val_str("replaced")), "Replace");
+    TEST_ASSERT(mvn_art_count(art) == 6, "Replacement keeps the count");
+    TEST_ASSERT(strcmp(mvn_art_get_cstr(art, "ab")->str->data, "replaced") == 0, "Replaced");
+
+    mvn_str_t *key = mvn_str_new("abd");
+    TEST_ASSERT(key != NULL && mvn_art_get(art, key)->i32 == 4, "Get with mvn_str_t key");
+    TEST_ASSERT(mvn_art_remove(art, key), "Remove abd");
+    TEST_ASSERT(!mvn_art_remove(art, key), "Second remove fails");
+    TEST_ASSERT(mvn_art_put(art, key, mvn_val_i32(40)), "Put with mvn_str_t key");
+    TEST_ASSERT(mvn_art_get_cstr(art, "abd")->i32 == 40, "Key was copied");
+    mvn_str_free(key);
+
+    // Removing inner keys keeps their extensions
+    TEST_ASSERT(mvn_art_remove_cstr(art, "a"), "Remove a");
+    TEST_ASSERT(mvn_art_remove_cstr(art, ""), "Remove empty key");
+    TEST_ASSERT(mvn_art_get_cstr(art, "abc")->i32 == 0, "abc survives");
+    TEST_ASSERT(mvn_art_get_cstr(art, "a") == NULL, "a is gone");
+    TEST_ASSERT(!mvn_art_remove_cstr(art, "zzz"), "Absent key");
+
+    const char *all[] = {"abc", "ab", "b", "abd"};
+    for (int index = 0; index < 4; index++) {
+        TEST_ASSERT(mvn_art_remove_cstr(art, all[index]), "Remove remaining");
+    }
+    TEST_ASSERT(mvn_art_count(art) == 0 && art->root == NULL, "Tree is empty");
+    TEST_ASSERT(mvn_art_put_cstr(art, "again", mvn_val_i32(1)), "Reuse emptied tree");
+    mvn_art_free(art);
+    return true;
+}
+
+static bool test_art_node_layouts(void)
+{
+    TEST_ASSERT(sizeof(void *) != 8 || sizeof(mvn_art_node4_t) == 64, "Node4 is one cache line");
+
+    // "x" followed by every byte: the root grows through each layout, then shrinks back
+    mvn_art_t *art = mvn_art_new();
+    TEST_ASSERT(art != NULL, "Failed to create tree");
+    char text[3] = {'x', 0, 0};
+    for (int byte = 255; byte >= 0; byte--) {
+        text[1]       = (char)byte;
+        mvn_str_t key = {.length = 2, .capacity = 2, .data = text};
+        TEST_ASSERT(mvn_art_put(art, &key, mvn_val_i32(byte)), "Put");
+        uint8_t type     = art->root->type;
+        size_t  children = 256 - (size_t)byte;
+        uint8_t expected = children == 1    ? MVN_ART_LEAF
+                           : children <= 4  ? MVN_ART_NODE4
+                           : children <= 16 ? MVN_ART_NODE16
+                           : children <= 48 ? MVN_ART_NODE48
+                                            : MVN_ART_NODE256;
+        TEST_ASSERT_FMT(type == expected, "Layout %d with %zu children", type, children);
+    }
+    TEST_ASSERT(art->root->prefix_length == 1 && art->root->prefix[0] == 'x', "Shared path");
+    TEST_ASSERT(mvn_art_count(art) == 256, "Every byte, including 0, is a key");
+
+    mvn_art_iter_t iter     = mvn_art_iter(art);
+    const char    *key      = NULL;
+    mvn_val_t     *value    = NULL;
+    int            expected = 0;
+    while (mvn_art_iter_next(&iter, &key, &value)) {
+        TEST_ASSERT_FMT(value->i32 == expected, "Bytes in unsigned order at %d", expected);
+        expected++;
+    }
+    TEST_ASSERT(expected == 256, "Iterated every key");
+
+    for (int byte = 0; byte < 254; byte++) {
+        text[1]       = (char)byte;
+        mvn_str_t key = {.length = 2, .capacity = 2, .data = text};
+        TEST_ASSERT(mvn_art_remove(art, &key), "Remove");
+    }
+    TEST_ASSERT(art->root->type == MVN_ART_NODE4 && art->root->count == 2, "Shrunk to node4");
+    TEST_ASSERT(mvn_art_remove_cstr(art, "x\xfe"), "Remove second to last");
+    TEST_ASSERT(art->root->type == MVN_ART_LEAF, "Single key collapses to a leaf");
+    TEST_ASSERT(mvn_art_get_cstr(art, "x\xff")->i32 == 255, "Last key found");
+    mvn_art_free(art);
+    return true;
+}
+
+static bool test_art_prefix_iteration(void)
+{
+    mvn_art_t *art = mvn_art_new();
+    TEST_ASSERT(art != NULL, "Failed to create tree");
+    const char *keys[] = {"user:10",
+                          "user:2",
+                          "usage",
+                          "user:1",
+                          "admin",
+                          "user:",
+                          "a-long-shared-path/one",
+                          "a-long-shared-path/two",
+                          "a-long-shared-path/two/three"};
+    for (int index = 0; index < 9; index++) {
+        TEST_ASSERT(mvn_art_put_cstr(art, keys[index], mvn_val_i32(index)), "Put");
+    }
+
+    const char *users[] = {"user:", "user:1", "user:10", "user:2"};
+    TEST_ASSERT(iterates_as(art, "user:", users, 4), "Prefix user:");
+    TEST_ASSERT(iterates_as(art, "user:1", users + 1, 2), "Prefix equal to a key");
+    const char *us[] = {"usage", "user:", "user:1", "user:10", "user:2"};
+    TEST_ASSERT(iterates_as(art, "us", us, 5), "Prefix us");
+    TEST_ASSERT(iterates_as(art, "user:3", NULL, 0), "No match");
+    TEST_ASSERT(iterates_as(art, "user:100", NULL, 0), "Prefix longer than every key");
+    TEST_ASSERT(iterates_as(art, "b", NULL, 0), "Prefix past every key");
+
+    // Prefixes ending inside, at the end of, and diverging from a long compressed path
+    const char *paths[] = {"a-long-shared-path/one",
+                           "a-long-shared-path/two",
+                           "a-long-shared-path/two/three"};
+    TEST_ASSERT(iterates_as(art, "a-long-sh", paths, 3), "Prefix inside the path");
+    TEST_ASSERT(iterates_as(art, "a-long-shared-path/", paths, 3), "Prefix at the path end");
+    TEST_ASSERT(iterates_as(art, "a-long-shared-path/t", paths + 1, 2), "Prefix past the path");
+    TEST_ASSERT(iterates_as(art, "a-long-shared-PATH/", NULL, 0), "Differs past stored bytes");
+    TEST_ASSERT(mvn_art_get_cstr(art, "a-long-shared-PATH/one") == NULL, "Lookup checks leaf");
+
+    const char *all[] = {"a-long-shared-path/one",
+                         "a-long-shared-path/two",
+                         "a-long-shared-path/two/three",
+                         "admin",
+                         "usage",
+                         "user:",
+                         "user:1",
+                         "user:10",
+                         "user:2"};
+    TEST_ASSERT(iterates_as(art, "", all, 9), "Empty prefix iterates everything");
+    TEST_ASSERT(iterates_as(art, NULL, all, 9), "NULL prefix iterates everything");
+    mvn_art_free(art);
+    return true;
+}
+
+static bool test_art_matches_reference(void)
+{
+    mvn_art_t *art = mvn_art_new();
+    TEST_ASSERT(art != NULL, "Failed to create tree");
+    static char keys[REFERENCE_KEYS][32];
+    bool        present[REFERENCE_KEYS] = {false};
+    size_t      present_count           = 0;
+    for (size_t number = 0; number < REFERENCE_KEYS; number++) {
+        reference_key(number, keys[number], sizeof(keys[number]));
+    }
+    // Distinct numbers can build the same key; use the first number for each key
+    size_t owner[REFERENCE_KEYS];
+    for (size_t number = 0; number < REFERENCE_KEYS; number++) {
+        owner[number] = number;
+        for (size_t other = 0; other < number; other++) {
+            if (strcmp(keys[other], keys[number]) == 0) {
+                owner[number] = owner[other];
+                break;
+            }
+        }
+    }
+
+    for (size_t step = 0; step < 30000; step++) {
+        size_t      number = owner[(step * 2654435761U >> 7) % REFERENCE_KEYS];
+        const char *key    = keys[number];
+        switch (step % 5) {
+            case 0:
+            case 1: {
+                TEST_ASSERT(mvn_art_put_cstr(art, key, mvn_val_u64(number)), "Put");
+                present_count += present[number] ? 0 : 1;
+                present[number] = true;
+                break;
+            }
+            case 2: {
+                bool removed = mvn_art_remove_cstr(art, key);
+                TEST_ASSERT_FMT(removed == present[number], "Remove \"%s\" at %zu", key, step);
+                present_count -= present[number] ? 1 : 0;
+                present[number] = false;
+                break;
+            }
+            default: {
+                mvn_val_t *value = mvn_art_get_cstr(art, key);
+                TEST_ASSERT_FMT((value != NULL) == present[number], "Get \"%s\"", key);
+                TEST_ASSERT(value == NULL || value->u64 == number, "Value");
+                break;
+            }
+        }
+        TEST_ASSERT(mvn_art_count(art) == present_count, "Count matches the reference");
+
+        if (step % 2500 == 0 || step == 29999) {
+            const char *sorted[REFERENCE_KEYS];
+            size_t      sorted_count = 0;
+            for (size_t index = 0; index < REFERENCE_KEYS; index++) {
+                if (present[index]) {
+                    sorted[sorted_count++] = keys[index];
+                }
+            }
+            qsort(sorted, sorted_count, sizeof(sorted[0]), compare_cstr);
+            TEST_ASSERT_FMT(iterates_as(art, NULL, sorted, sorted_count), "Order at %zu", step);
+
+            // Every key starting with "alpha/beta/d", in order
+            size_t first = 0;
+            while (first < sorted_count && strncmp(sorted[first], "alpha/beta/d", 12) < 0) {
+                first++;
+            }
+            size_t last = first;
+            while (last < sorted_count && strncmp(sorted[last], "alpha/beta/d", 12) == 0) {
+                last++;
+            }
+            TEST_ASSERT(iterates_as(art, "alpha/beta/d", sorted + first, last - first),
+                        "Prefix matches the reference");
+        }
+    }
+    TEST_ASSERT(mvn_art_memory_usage(art) > present_count * sizeof(mvn_art_leaf_t),
+                "Memory usage counts the leaves");
+
+    for (size_t number = 0; number < REFERENCE_KEYS; number++) {
+        if (present[number]) {
+            TEST_ASSERT(mvn_art_remove_cstr(art, keys[number]), "Remove remaining key");
+            present[number] = false;
+        }
+    }
+    TEST_ASSERT(mvn_art_count(art) == 0 && art->root == NULL, "Tree is empty");
+    mvn_art_free(art);
+    return true;
+}
+
+static bool test_art_null_param_safety(void)
+{
+    mvn_art_free(NULL);
+    TEST_ASSERT(!mvn_art_put_cstr(NULL, "a", mvn_val_str("freed")), "Put into NULL tree");
+    TEST_ASSERT(mvn_art_get_cstr(NULL, "a") == NULL, "Get from NULL tree");
+    TEST_ASSERT(!mvn_art_remove_cstr(NULL, "a"), "Remove from NULL tree");
+    TEST_ASSERT(mvn_art_count(NULL) == 0, "NULL tree count");
+    TEST_ASSERT(mvn_art_memory_usage(NULL) == 0, "NULL tree memory usage");
+
+    mvn_art_iter_t iter = mvn_art_iter(NULL);
+    TEST_ASSERT(!mvn_art_iter_next(&iter, NULL, NULL), "NULL tree iterator is exhausted");
+    iter = mvn_art_prefix(NULL, "a");
+    TEST_ASSERT(!mvn_art_iter_next(&iter, NULL, NULL), "NULL tree prefix iterator");
+    TEST_ASSERT(!mvn_art_iter_next(NULL, NULL, NULL), "NULL iterator");
+
+    mvn_art_t *art = mvn_art_new();
+    TEST_ASSERT(art != NULL, "Failed to create tree");
+    TEST_ASSERT(!mvn_art_put_cstr(art, NULL, mvn_val_str("freed")), "NULL key rejected");
+    TEST_ASSERT(!mvn_art_put(art, NULL, mvn_val_i32(1)), "NULL string key rejected");
+    TEST_ASSERT(mvn_art_get(art, NULL) == NULL, "Get NULL key");
+    TEST_ASSERT(!mvn_art_remove(art, NULL), "Remove NULL key");
+    iter = mvn_art_iter(art);
+    TEST_ASSERT(!mvn_art_iter_next(&iter, NULL, NULL), "Empty tree iterator is exhausted");
+    mvn_art_free(art);
+    return true;
+}
+
+// --- Test Runner ---
+
+int run_art_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING ADAPTIVE RADIX TREE TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_art_put_get_remove);
+    RUN_TEST(test_art_node_layouts);
+    RUN_TEST(test_art_prefix_iteration);
+    RUN_TEST(test_art_matches_reference);
+    RUN_TEST(test_art_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_art_tests(&passed, &failed, &total);
+
+    printf("\n===== ADAPTIVE RADIX TREE TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_bitset_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_bitset.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Deterministic pseudo-random bit pattern with runs of set and clear bits
+static bool test_bit(size_t index, size_t seed)
+{
+    return ((index * 2654435761U + seed * 40503U) >> 7) % 3 == 0;
+}
+
+// Builds a bitset of size bits and a bool array holding the same pattern.
+static mvn_bitset_t *make_pattern(size_t size, size_t seed, bool **reference)
+{
+    mvn_bitset_t *bitset = mvn_bitset_new(size);
+    *reference           = (bool *)calloc(size + 1, sizeof(bool));
+    if (bitset == NULL || *reference == NULL) {
+        return bitset;
+    }
+    for (size_t index = 0; index < size; index++) {
+        (*reference)[index] = test_bit(index, seed);
+        mvn_bitset_assign(bitset, index, (*reference)[index]);
+    }
+    return bitset;
+}
+
+// Checks every bit of the bitset against a bool array.
+static bool matches_reference(const mvn_bitset_t *bitset, const bool *reference)
+{
+    for (size_t index = 0; index < bitset->size; index++) {
+        if (mvn_bitset_test(bitset, index) != reference[index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Test Functions ---
+
+static bool test_bitset_single_bits(void)
+{
+    mvn_bitset_t *bitset = mvn_bitset_new(130);
+    TEST_ASSERT(bitset != NULL, "Failed to create bitset");
+    TEST_ASSERT(mvn_bitset_size(bitset) == 130, "Size should be 130");
+    TEST_ASSERT(mvn_bitset_count(bitset) == 0, "New bitset should be clear");
+
+    TEST_ASSERT(mvn_bitset_set(bitset, 0), "Set bit 0");
+    TEST_ASSERT(mvn_bitset_set(bitset, 63), "Set bit 63");
+    TEST_ASSERT(mvn_bitset_set(bitset, 64), "Set bit 64");
+    TEST_ASSERT(mvn_bitset_set(bitset, 129), "Set last bit");
+    TEST_ASSERT(!mvn_bitset_set(bitset, 130), "Set past the size should fail");
+    TEST_ASSERT(!mvn_bitset_test(bitset, 130), "Test past the size is false");
+    TEST_ASSERT(mvn_bitset_count(bitset) == 4, "Four bits set");
+
+    TEST_ASSERT(mvn_bitset_reset(bitset, 63), "Reset bit 63");
+    TEST_ASSERT(mvn_bitset_flip(bitset, 1), "Flip bit 1");
+    TEST_ASSERT(mvn_bitset_flip(bitset, 0), "Flip bit 0");
+    TEST_ASSERT(mvn_bitset_assign(bitset, 100, true), "Assign bit 100");
+    TEST_ASSERT(!mvn_bitset_test(bitset, 0) && mvn_bitset_test(bitset, 1), "Flips applied");
+    TEST_ASSERT(!mvn_bitset_test(bitset, 63) && mvn_bitset_test(bitset, 100), "Updates applied");
+    TEST_ASSERT(mvn_bitset_count(bitset) == 4, "Four bits set after updates");
+
+    // Fill keeps the bits past the size clear
+    mvn_bitset_fill(bitset, true);
+    TEST_ASSERT(mvn_bitset_count(bitset) == 130, "Fill sets every bit");
+    TEST_ASSERT(bitset->words[2] == 3, "Bits past the size stay clear");
+    mvn_bitset_fill(bitset, false);
+    TEST_ASSERT(mvn_bitset_count(bitset) == 0, "Fill clears every bit");
+
+    // Shrinking drops bits, growing adds clear bits
+    mvn_bitset_fill(bitset, true);
+    TEST_ASSERT(mvn_bitset_resize(bitset, 70), "Shrink should succeed");
+    TEST_ASSERT(mvn_bitset_count(bitset) == 70, "Shrunk bitset keeps its first 70 bits");
+    TEST_ASSERT(mvn_bitset_resize(bitset, 300), "Grow should succeed");
+    TEST_ASSERT(mvn_bitset_count(bitset) == 70, "Grown bits should be clear");
+    TEST_ASSERT(!mvn_bitset_test(bitset, 70) && !mvn_bitset_test(bitset, 127), "Tail is clear");
+    TEST_ASSERT(mvn_bitset_resize(bitset, 0), "Resize to zero should succeed");
+    TEST_ASSERT(mvn_bitset_count(bitset) == 0 && bitset->words == NULL, "Empty bitset");
+    TEST_ASSERT(mvn_bitset_resize(bitset, 5) && mvn_bitset_set(bitset, 4), "Regrow from zero");
+    mvn_bitset_free(bitset);
+    return true;
+}
+
+static bool test_bitset_find(void)
+{
+    mvn_bitset_t *bitset = mvn_bitset_new(1000);
+    TEST_ASSERT(bitset != NULL, "Failed to create bitset");
+    TEST_ASSERT(mvn_bitset_find_first_set(bitset, 0) == MVN_DS_BITSET_NPOS, "No set bit");
+    TEST_ASSERT(mvn_bitset_find_first_unset(bitset, 0) == 0, "First clear bit is 0");
+
+    mvn_bitset_set(bitset, 5);
+    mvn_bitset_set(bitset, 64);
+    mvn_bitset_set(bitset, 999);
+    TEST_ASSERT(mvn_bitset_find_first_set(bitset, 0) == 5, "First set bit is 5");
+    TEST_ASSERT(mvn_bitset_find_first_set(bitset, 5) == 5, "Search includes from");
+    TEST_ASSERT(mvn_bitset_find_first_set(bitset, 6) == 64, "Next set bit is 64");
+    TEST_ASSERT(mvn_bitset_find_first_set(bitset, 65) == 999, "Search crosses words");
+    TEST_ASSERT(mvn_bitset_find_first_set(bitset, 1000) == MVN_DS_BITSET_NPOS, "Past the end");
+
+    // The clear tail of the last word must not be reported
+    mvn_bitset_fill(bitset, true);
+    mvn_bitset_reset(bitset, 300);
+    TEST_ASSERT(mvn_bitset_find_first_unset(bitset, 0) == 300, "First clear bit is 300");
+    TEST_ASSERT(mvn_bitset_find_first_unset(bitset, 301) == MVN_DS_BITSET_NPOS,
+                "Bits past the size are not clear bits");
+
+    // Iterating set bits visits them all in order
+    bool         *reference = NULL;
+    mvn_bitset_t *pattern   = make_pattern(777, 3, &reference);
+    TEST_ASSERT(pattern != NULL && reference != NULL, "Failed to build pattern");
+    size_t visited = 0;
+    for (size_t index = mvn_bitset_find_first_set(pattern, 0); index != MVN_DS_BITSET_NPOS;
+         index     = mvn_bitset_find_first_set(pattern, index + 1)) {
+        TEST_ASSERT_FMT(reference[index], "Bit %zu is not set", index);
+        visited++;
+    }
+    TEST_ASSERT(visited == mvn_bitset_count(pattern), "Every set bit should be visited");
+    free(reference);
+    mvn_bitset_free(pattern);
+    mvn_bitset_free(bitset);
+    return true;
+}
+
+static bool test_bitset_bulk_operations(void)
+{
+    // Odd word counts exercise the scalar tail after the two-word steps
+    const size_t sizes[] = {1, 64, 100, 128, 191, 1000, 4097};
+    for (size_t size_index = 0; size_index < sizeof(sizes) / sizeof(sizes[0]); size_index++) {
+        size_t        size       = sizes[size_index];
+        bool         *left_bits  = NULL;
+        bool         *right_bits = NULL;
+        mvn_bitset_t *left       = make_pattern(size, 1, &left_bits);
+        mvn_bitset_t *right      = make_pattern(size, 2, &right_bits);
+        TEST_ASSERT(left != NULL && right != NULL && left_bits != NULL && right_bits != NULL,
+                    "Failed to build patterns");
+
+        mvn_bitset_t *result   = mvn_bitset_copy(left);
+        bool         *expected = (bool *)calloc(size, sizeof(bool));
+        TEST_ASSERT(result != NULL && expected != NULL, "Failed to copy bitset");
+        TEST_ASSERT(mvn_bitset_equal(result, left), "Copy should equal the original");
+
+        TEST_ASSERT(mvn_bitset_and(result, right), "And should succeed");
+        for (size_t index = 0; index < size; index++) {
+            expected[index] = left_bits[index] && right_bits[index];
+        }
+        TEST_ASSERT_FMT(matches_reference(result, expected), "And of %zu bits", size);
+
+        TEST_ASSERT(mvn_bitset_or(result, left), "Or should succeed");
+        TEST_ASSERT_FMT(mvn_bitset_equal(result, left), "(a & b) | a == a for %zu bits", size);
+
+        TEST_ASSERT(mvn_bitset_xor(result, right), "Xor should succeed");
+        for (size_t index = 0; index < size; index++) {
+            expected[index] = left_bits[index] != right_bits[index];
+        }
+        TEST_ASSERT_FMT(matches_reference(result, expected), "Xor of %zu bits", size);
+
+        TEST_ASSERT(mvn_bitset_andnot(result, left), "Andnot should succeed");
+        for (size_t index = 0; index < size; index++) {
+            expected[index] = !left_bits[index] && right_bits[index];
+        }
+        TEST_ASSERT_FMT(matches_reference(result, expected), "Andnot of %zu bits", size);
+
+        free(expected);
+        free(left_bits);
+        free(right_bits);
+        mvn_bitset_free(result);
+        mvn_bitset_free(left);
+        mvn_bitset_free(right);
+    }
+
+    mvn_bitset_t *small = mvn_bitset_new(10);
+    mvn_bitset_t *large = mvn_bitset_new(11);
+    TEST_ASSERT(!mvn_bitset_or(small, large), "Size mismatch should fail");
+    TEST_ASSERT(!mvn_bitset_equal(small, large), "Different sizes are not equal");
+    mvn_bitset_free(small);
+    mvn_bitset_free(large);
+    return true;
+}
+
+static bool test_bitset_rank_select(void)
+{
+    const size_t  size      = 5000;
+    bool         *reference = NULL;
+    mvn_bitset_t *bitset    = make_pattern(size, 7, &reference);
+    TEST_ASSERT(bitset != NULL && reference != NULL, "Failed to build pattern");
+
+    // Scanning and indexed answers must agree with the reference
+    for (int pass = 0; pass < 2; pass++) {
+        size_t rank = 0;
+        for (size_t index = 0; index <= size; index++) {
+            TEST_ASSERT_FMT(mvn_bitset_rank(bitset, index) == rank, "Rank of %zu", index);
+            if (index < size && reference[index]) {
+                TEST_ASSERT_FMT(mvn_bitset_select(bitset, rank) == index, "Select %zu", rank);
+                rank++;
+            }
+        }
+        TEST_ASSERT(mvn_bitset_select(bitset, rank) == MVN_DS_BITSET_NPOS, "Select past count");
+        TEST_ASSERT(mvn_bitset_rank(bitset, size + 10) == rank, "Rank past the size");
+        TEST_ASSERT(mvn_bitset_build_rank_index(bitset) && bitset->rank_valid, "Build index");
+    }
+
+    // A change makes the index stale; answers stay correct
+    size_t before = mvn_bitset_rank(bitset, size);
+    mvn_bitset_flip(bitset, 10);
+    TEST_ASSERT(!bitset->rank_valid, "Mutation invalidates the index");
+    TEST_ASSERT(mvn_bitset_rank(bitset, size) == (reference[10] ? before - 1 : before + 1),
+                "Rank after mutation");
+
+    // Every bit set: rank and select are the identity
+    mvn_bitset_fill(bitset, true);
+    TEST_ASSERT(mvn_bitset_build_rank_index(bitset), "Build index");
+    for (size_t index = 0; index < size; index += 37) {
+        TEST_ASSERT_FMT(mvn_bitset_rank(bitset, index) == index, "Full rank of %zu", index);
+        TEST_ASSERT_FMT(mvn_bitset_select(bitset, index) == index, "Full select %zu", index);
+    }
+
+    mvn_bitset_t *empty = mvn_bitset_new(0);
+    TEST_ASSERT(mvn_bitset_build_rank_index(empty), "Index of an empty bitset");
+    TEST_ASSERT(mvn_bitset_rank(empty, 0) == 0, "Empty rank");
+    TEST_ASSERT(mvn_bitset_select(empty, 0) == MVN_DS_BITSET_NPOS, "Empty select");
+    mvn_bitset_free(empty);
+    free(reference);
+    mvn_bitset_free(bitset);
+    return true;
+}
+
+static bool test_bitset_value(void)
+{
+    mvn_val_t value = mvn_val_bitset(200);
+    TEST_ASSERT(value.type == MVN_VAL_BITSET && value.bits != NULL, "Failed to create value");
+    mvn_bitset_set(value.bits, 3);
+    mvn_bitset_set(value.bits, 150);
+
+    mvn_val_t copy = mvn_val_deep_copy(&value);
+    TEST_ASSERT(copy.type == MVN_VAL_BITSET && copy.bits != value.bits, "Deep copy");
+    TEST_ASSERT(mvn_val_equal(&value, &copy), "Copy should be equal");
+    TEST_ASSERT(mvn_val_compare(&value, &copy) == 0, "Copy should compare equal");
+    TEST_ASSERT(mvn_val_hash(&value) == mvn_val_hash(&copy), "Equal bitsets hash equally");
+
+    // The lower differing bit decides the order
+    mvn_bitset_set(copy.bits, 100);
+    TEST_ASSERT(!mvn_val_equal(&value, &copy), "Changed copy should differ");
+    TEST_ASSERT(mvn_val_compare(&value, &copy) < 0, "Bit 100 clear sorts first");
+    TEST_ASSERT(mvn_val_compare(&copy, &value) > 0, "Bit 100 set sorts last");
+    TEST_ASSERT(mvn_val_hash(&value) != mvn_val_hash(&copy), "Different bits hash differently");
+
+    size_t usage = mvn_val_memory_usage(&value);
+    TEST_ASSERT(usage >= sizeof(mvn_bitset_t) + 4 * sizeof(uint64_t), "Memory usage");
+    TEST_ASSERT(mvn_val_freeze(&value) && value.bits->rank_valid, "Freeze builds the index");
+    TEST_ASSERT(mvn_val_memory_usage(&value) > usage, "Memory usage includes the index");
+    TEST_ASSERT(strcmp(mvn_val_type_to_str(value.type), "BITSET") == 0, "Type name");
+
+    // Values hold bitsets in containers
+    mvn_hset_t *set = mvn_hset_new();
+    TEST_ASSERT(set != NULL, "Failed to create set");
+    TEST_ASSERT(mvn_hset_insert(set, mvn_val_deep_copy(&value)), "Add bitset to set");
+    TEST_ASSERT(mvn_hset_contains(set, &value), "Set should find an equal bitset");
+    TEST_ASSERT(!mvn_hset_contains(set, &copy), "Set should not find a different bitset");
+    mvn_hset_free(set);
+
+    TEST_ASSERT(mvn_val_bitset_take(NULL).type == MVN_VAL_NULL, "Taking NULL gives NULL");
+    mvn_val_free(&value);
+    mvn_val_free(&copy);
+    TEST_ASSERT(value.type == MVN_VAL_NULL, "Freed value is NULL");
+    return true;
+}
+
+static bool test_bitset_null_param_safety(void)
+{
+    mvn_bitset_free(NULL);
+    mvn_bitset_fill(NULL, true);
+    TEST_ASSERT(mvn_bitset_copy(NULL) == NULL, "Copy of NULL");
+    TEST_ASSERT(!mvn_bitset_resize(NULL, 10), "Resize NULL");
+    TEST_ASSERT(mvn_bitset_size(NULL) == 0, "Size of NULL");
+    TEST_ASSERT(!mvn_bitset_test(NULL, 0), "Test NULL");
+    TEST_ASSERT(!mvn_bitset_set(NULL, 0), "Set NULL");
+    TEST_ASSERT(mvn_bitset_count(NULL) == 0, "Count NULL");
+    TEST_ASSERT(mvn_bitset_find_first_set(NULL, 0) == MVN_DS_BITSET_NPOS, "Find in NULL");
+    TEST_ASSERT(mvn_bitset_equal(NULL, NULL), "NULL equals NULL");
+    TEST_ASSERT(!mvn_bitset_and(NULL, NULL), "And NULL");
+    TEST_ASSERT(!mvn_bitset_build_rank_index(NULL), "Index NULL");
+    TEST_ASSERT(mvn_bitset_rank(NULL, 5) == 0, "Rank NULL");
+    TEST_ASSERT(mvn_bitset_select(NULL, 0) == MVN_DS_BITSET_NPOS, "Select NULL");
+    return true;
+}
+
+/**
+ * \brief           Run all bitset tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_bitset_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING BITSET TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_bitset_single_bits);
+    RUN_TEST(test_bitset_find);
+    RUN_TEST(test_bitset_bulk_operations);
+    RUN_TEST(test_bitset_rank_select);
+    RUN_TEST(test_bitset_value);
+    RUN_TEST(test_bitset_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_bitset_tests(&passed, &failed, &total);
+
+    printf("\n===== BITSET TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_bloom_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_bloom.h"
+#include "mvn_ds/mvn_ds_hmap.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// splitmix64; stands in for well-mixed key hashes
+static uint64_t test_hash(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// Measures the false-positive rate of a filter holding keys 0..capacity-1 on other keys.
+static double measure_false_positive_rate(size_t capacity, double target)
+{
+    mvn_bloom_t *bloom = mvn_bloom_new(capacity, target);
+    if (bloom == NULL) {
+        return 1.0;
+    }
+    for (uint64_t key = 0; key < capacity; key++) {
+        mvn_bloom_add_hash(bloom, test_hash(key));
+    }
+    size_t probes = 200000;
+    size_t hits   = 0;
+    for (uint64_t key = capacity; key < capacity + probes; key++) {
+        hits += mvn_bloom_contains_hash(bloom, test_hash(key)) ? 1 : 0;
+    }
+    mvn_bloom_free(bloom);
+    return (double)hits / (double)probes;
+}
+
+// --- Test Functions ---
+
+static bool test_bloom_no_false_negatives(void)
+{
+    mvn_bloom_t *bloom = mvn_bloom_new(1000, 0.01);
+    TEST_ASSERT(bloom != NULL, "Failed to create filter");
+    TEST_ASSERT(mvn_bloom_count(bloom) == 0, "New filter is empty");
+    TEST_ASSERT(!mvn_bloom_contains_hash(bloom, test_hash(1)), "Empty filter holds nothing");
+
+    // Past capacity the rate degrades, but added keys are always found
+    for (uint64_t key = 0; key < 5000; key++) {
+        mvn_bloom_add_hash(bloom, test_hash(key));
+    }
+    for (uint64_t key = 0; key < 5000; key++) {
+        TEST_ASSERT_FMT(mvn_bloom_contains_hash(bloom, test_hash(key)), "Key %llu missing",
+                        (unsigned long long)key);
+    }
+    TEST_ASSERT(mvn_bloom_count(bloom) == 5000, "Count tracks adds");
+
+    mvn_bloom_clear(bloom);
+    TEST_ASSERT(mvn_bloom_count(bloom) == 0, "Clear resets the count");
+    TEST_ASSERT(!mvn_bloom_contains_hash(bloom, test_hash(1)), "Clear removes keys");
+    mvn_bloom_free(bloom);
+    return true;
+}
+
+static bool test_bloom_false_positive_rate(void)
+{
+    // Close to the target at capacity, with slack for sampling noise
+    double targets[] = {0.1, 0.01, 0.001, 0.0001};
+    for (size_t index = 0; index < sizeof(targets) / sizeof(targets[0]); index++) {
+        double measured = measure_false_positive_rate(20000, targets[index]);
+        printf("  target %.4f: measured %.5f\n", targets[index], measured);
+        TEST_ASSERT_FMT(measured <= targets[index] * 1.5, "Rate %.5f too high for target %.4f",
+                        measured, targets[index]);
+    }
+
+    // A lower target costs more memory
+    mvn_bloom_t *loose = mvn_bloom_new(10000, 0.1);
+    mvn_bloom_t *tight = mvn_bloom_new(10000, 0.001);
+    TEST_ASSERT(loose != NULL && tight != NULL, "Failed to create filters");
+    TEST_ASSERT(mvn_bloom_memory_usage(tight) > 2 * mvn_bloom_memory_usage(loose),
+                "Tighter filter is larger");
+    mvn_bloom_free(loose);
+    mvn_bloom_free(tight);
+    return true;
+}
+
+static bool test_bloom_values(void)
+{
+    mvn_bloom_t *bloom = mvn_bloom_new(0, 0.0); // Defaults
+    TEST_ASSERT(bloom != NULL, "Failed to create filter with defaults");
+
+    mvn_val_t text   = mvn_val_str("apple");
+    mvn_val_t number = mvn_val_i64(42);
+    mvn_bloom_add(bloom, &text);
+    mvn_bloom_add(bloom, &number);
+    TEST_ASSERT(mvn_bloom_contains(bloom, &text), "String value found");
+    TEST_ASSERT(mvn_bloom_contains(bloom, &number), "Integer value found");
+
+    // Equal values hash equally, so a separate copy is found too
+    mvn_val_t same = mvn_val_str("apple");
+    TEST_ASSERT(mvn_bloom_contains(bloom, &same), "Equal value found");
+
+    mvn_val_free(&text);
+    mvn_val_free(&same);
+    mvn_bloom_free(bloom);
+    return true;
+}
+
+static bool test_bloom_hmap_filter(void)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    TEST_ASSERT(hmap != NULL, "Failed to create map");
+    TEST_ASSERT(mvn_hmap_set_cstr(hmap, "before", mvn_val_i32(-1)), "Set before attach");
+    TEST_ASSERT(mvn_hmap_attach_filter(hmap, 0.01), "Attach filter");
+    TEST_ASSERT(mvn_hmap_has_filter(hmap), "Filter attached");
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "before")->i32 == -1, "Key set before attach is found");
+
+    // Far more keys than the filter was sized for, so it is rebuilt several times
+    char key[32];
+    for (int index = 0; index < 2000; index++) {
+        snprintf(key, sizeof(key), "key%d", index);
+        TEST_ASSERT(mvn_hmap_set_cstr(hmap, key, mvn_val_i32(index)), "Set key");
+    }
+    for (int index = 0; index < 2000; index++) {
+        snprintf(key, sizeof(key), "key%d", index);
+        mvn_val_t *value = mvn_hmap_cstr(hmap, key);
+        TEST_ASSERT_FMT(value != NULL && value->i32 == index, "Key %s missing after growth", key);
+    }
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "absent") == NULL, "Absent key misses");
+    TEST_ASSERT(!mvn_hmap_delete_cstr(hmap, "absent"), "Absent key is not deleted");
+
+    // Deleted keys miss even though their bits stay set
+    TEST_ASSERT(mvn_hmap_delete_cstr(hmap, "key7"), "Delete key7");
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "key7") == NULL, "Deleted key misses");
+    TEST_ASSERT(mvn_hmap_set_cstr(hmap, "key7", mvn_val_i32(70)), "Reinsert key7");
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "key7")->i32 == 70, "Reinserted key found");
+
+    // Copies keep the filter
+    mvn_val_t original = mvn_val_hmap_take(hmap);
+    mvn_val_t copy     = mvn_val_deep_copy(&original);
+    TEST_ASSERT(copy.type == MVN_VAL_HASHMAP && mvn_hmap_has_filter(copy.hmap), "Copy filtered");
+    TEST_ASSERT(mvn_val_equal(&original, &copy), "Copy equals original");
+    TEST_ASSERT(mvn_val_memory_usage(&copy) > mvn_bloom_memory_usage(copy.hmap->filter),
+                "Memory usage includes the filter");
+    mvn_val_free(&copy);
+
+    mvn_hmap_clear(hmap);
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "key1") == NULL, "Cleared map misses");
+    TEST_ASSERT(mvn_hmap_set_cstr(hmap, "key1", mvn_val_i32(1)), "Set after clear");
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "key1")->i32 == 1, "Key found after clear");
+
+    mvn_hmap_detach_filter(hmap);
+    TEST_ASSERT(!mvn_hmap_has_filter(hmap), "Filter detached");
+    TEST_ASSERT(mvn_hmap_cstr(hmap, "key1")->i32 == 1, "Key found without filter");
+    mvn_val_free(&original);
+    return true;
+}
+
+static bool test_bloom_null_param_safety(void)
+{
+    TEST_ASSERT(mvn_bloom_new(10, -0.5) == NULL, "Negative rate rejected");
+    TEST_ASSERT(mvn_bloom_new(10, 1.0) == NULL, "Rate of 1 rejected");
+    mvn_bloom_free(NULL);
+    mvn_bloom_add_hash(NULL, 1);
+    mvn_bloom_add(NULL, NULL);
+    mvn_bloom_clear(NULL);
+    TEST_ASSERT(!mvn_bloom_contains_hash(NULL, 1), "NULL filter holds nothing");
+    TEST_ASSERT(!mvn_bloom_contains(NULL, NULL), "NULL value is absent");
+    TEST_ASSERT(mvn_bloom_count(NULL) == 0, "NULL filter count");
+    TEST_ASSERT(mvn_bloom_memory_usage(NULL) == 0, "NULL filter memory usage");
+    TEST_ASSERT(!mvn_hmap_attach_filter(NULL, 0.01), "Attach to NULL map fails");
+    TEST_ASSERT(!mvn_hmap_has_filter(NULL), "NULL map has no filter");
+    mvn_hmap_detach_filter(NULL);
+
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    TEST_ASSERT(hmap != NULL, "Failed to create map");
+    TEST_ASSERT(!mvn_hmap_attach_filter(hmap, 2.0), "Invalid rate rejected");
+    TEST_ASSERT(!mvn_hmap_has_filter(hmap), "Failed attach leaves no filter");
+    mvn_hmap_free(hmap);
+    return true;
+}
+
+// --- Test Runner ---
+
+int run_bloom_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING BLOOM FILTER TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_bloom_no_false_negatives);
+    RUN_TEST(test_bloom_false_positive_rate);
+    RUN_TEST(test_bloom_values);
+    RUN_TEST(test_bloom_hmap_filter);
+    RUN_TEST(test_bloom_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_bloom_tests(&passed, &failed, &total);
+
+    printf("\n===== BLOOM FILTER TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
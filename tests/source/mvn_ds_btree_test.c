@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_btree_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_arr.h"
+#include "mvn_ds/mvn_ds_btree.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Keys below count in a scrambled order (7919 is prime, so this is a permutation)
+static int64_t scrambled_key(size_t index, size_t count)
+{
+    return (int64_t)((index * 7919) % count);
+}
+
+static mvn_btree_t *build_scrambled_tree(size_t count)
+{
+    mvn_btree_t *btree = mvn_btree_new();
+    for (size_t index = 0; btree != NULL && index < count; index++) {
+        int64_t key = scrambled_key(index, count);
+        if (!mvn_btree_put(btree, mvn_val_i64(key), mvn_val_i64(key * 10))) {
+            mvn_btree_free(btree);
+            return NULL;
+        }
+    }
+    return btree;
+}
+
+static mvn_val_t *get_i64(const mvn_btree_t *btree, int64_t number)
+{
+    mvn_val_t key = mvn_val_i64(number);
+    return mvn_btree_get(btree, &key);
+}
+
+// Checks node alignment, fill, key order within [low, high), and that every leaf is at
+// depth levels_left == 1. Returns the number of entries below node, or SIZE_MAX on error.
+static size_t check_node(const mvn_btree_node_t *node,
+                         bool                    is_root,
+                         const mvn_val_t        *low,
+                         const mvn_val_t        *high,
+                         size_t                  levels_left)
+{
+    if ((uintptr_t)node % MVN_DS_BTREE_NODE_ALIGNMENT != 0 ||
+        node->count > MVN_DS_BTREE_MAX_KEYS || (!is_root && node->count < MVN_DS_BTREE_MIN_KEYS) ||
+        node->leaf != (levels_left == 1)) {
+        return SIZE_MAX;
+    }
+    for (size_t index = 0; index < node->count; index++) {
+        const mvn_val_t *key = &node->keys[index];
+        if ((low != NULL && mvn_val_compare(key, low) < 0) ||
+            (high != NULL && mvn_val_compare(key, high) >= 0) ||
+            (index > 0 && mvn_val_compare(&node->keys[index - 1], key) >= 0)) {
+            return SIZE_MAX;
+        }
+    }
+    if (node->leaf) {
+        return node->count;
+    }
+    size_t total = 0;
+    for (size_t index = 0; index <= node->count; index++) {
+        const mvn_val_t *child_low  = index > 0 ? &node->keys[index - 1] : low;
+        const mvn_val_t *child_high = index < node->count ? &node->keys[index] : high;
+        size_t           below =
+            check_node(node->children[index], false, child_low, child_high, levels_left - 1);
+        if (below == SIZE_MAX) {
+            return SIZE_MAX;
+        }
+        total += below;
+    }
+    return total;
+}
+
+static bool tree_is_valid(const mvn_btree_t *btree)
+{
+    if (btree->root == NULL) {
+        return btree->count == 0 && btree->height == 0 && btree->first == NULL;
+    }
+    return check_node(btree->root, true, NULL, NULL, btree->height) == btree->count;
+}
+
+// --- Test Functions ---
+
+static bool test_btree_put_get_remove(void)
+{
+    const size_t count = 20000;
+    mvn_btree_t *btree = build_scrambled_tree(count);
+    TEST_ASSERT(btree != NULL, "Failed to build tree");
+    TEST_ASSERT(mvn_btree_count(btree) == count, "Count should match inserted entries");
+    TEST_ASSERT(btree->height >= 3, "20000 entries should need at least three levels");
+    TEST_ASSERT(tree_is_valid(btree), "Tree invariants should hold after inserts");
+
+    for (size_t number = 0; number < count; number++) {
+        mvn_val_t *value = get_i64(btree, (int64_t)number);
+        TEST_ASSERT_FMT(
+            value != NULL && value->i64 == (int64_t)number * 10, "Missing %zu", number);
+    }
+    TEST_ASSERT(get_i64(btree, -1) == NULL && get_i64(btree, (int64_t)count) == NULL,
+                "Absent keys should not be found");
+
+    // Replacing keeps the count
+    TEST_ASSERT(mvn_btree_put(btree, mvn_val_i64(7), mvn_val_i64(-7)), "Replace should succeed");
+    TEST_ASSERT(mvn_btree_count(btree) == count, "Replace should not add an entry");
+    TEST_ASSERT(get_i64(btree, 7)->i64 == -7, "Replace should update the value");
+
+    // Iteration visits keys in ascending order
+    mvn_btree_iter_t iter     = mvn_btree_iter(btree);
+    const mvn_val_t *key      = NULL;
+    int64_t          expected = 0;
+    while (mvn_btree_iter_next(&iter, &key, NULL)) {
+        TEST_ASSERT_FMT(key->i64 == expected, "Expected key %lld", (long long)expected);
+        expected++;
+    }
+    TEST_ASSERT(expected == (int64_t)count, "Iteration should visit every entry");
+
+    // Remove in scrambled order; borrowing and merging must keep the invariants
+    for (size_t index = 0; index < count; index += 2) {
+        mvn_val_t remove_key = mvn_val_i64(scrambled_key(index, count));
+        TEST_ASSERT(mvn_btree_remove(btree, &remove_key), "Remove of present key should succeed");
+    }
+    TEST_ASSERT(mvn_btree_count(btree) == count / 2, "Half the entries should remain");
+    TEST_ASSERT(tree_is_valid(btree), "Tree invariants should hold after removals");
+    mvn_val_t gone = mvn_val_i64(scrambled_key(0, count));
+    TEST_ASSERT(!mvn_btree_remove(btree, &gone), "Removing a missing key should fail");
+    for (size_t index = 1; index < count; index += 2) {
+        int64_t number = scrambled_key(index, count);
+        TEST_ASSERT_FMT(get_i64(btree, number) != NULL, "Lost %lld", (long long)number);
+    }
+
+    for (size_t index = 1; index < count; index += 2) {
+        mvn_val_t remove_key = mvn_val_i64(scrambled_key(index, count));
+        TEST_ASSERT(mvn_btree_remove(btree, &remove_key), "Remove of present key should succeed");
+    }
+    TEST_ASSERT(mvn_btree_count(btree) == 0 && tree_is_valid(btree), "Tree should be empty");
+    iter = mvn_btree_iter(btree);
+    TEST_ASSERT(!mvn_btree_iter_next(&iter, NULL, NULL), "Empty tree should not iterate");
+
+    // An emptied tree is reusable
+    TEST_ASSERT(mvn_btree_put(btree, mvn_val_i64(1), mvn_val_bool(true)), "Put should succeed");
+    TEST_ASSERT(mvn_btree_count(btree) == 1, "Tree should hold one entry");
+
+    mvn_btree_free(btree);
+    return true;
+}
+
+static bool test_btree_string_keys(void)
+{
+    mvn_btree_t *btree = mvn_btree_new();
+    TEST_ASSERT(btree != NULL, "Failed to create tree");
+
+    const char *words[]    = {"pear", "apple", "fig", "banana", "cherry", "date", "grape"};
+    const char *sorted[]   = {"apple", "banana", "cherry", "date", "fig", "grape", "pear"};
+    size_t      word_count = sizeof(words) / sizeof(words[0]);
+    for (size_t index = 0; index < word_count; index++) {
+        TEST_ASSERT(mvn_btree_put_cstr(btree, words[index], mvn_val_i32((int32_t)index)),
+                    "Put with string key should succeed");
+    }
+
+    mvn_val_t *value = mvn_btree_get_cstr(btree, "fig");
+    TEST_ASSERT(value != NULL && value->i32 == 2, "Should find fig");
+    TEST_ASSERT(mvn_btree_get_cstr(btree, "kiwi") == NULL, "Should not find kiwi");
+
+    // Keys owned by mvn_str_t values find the same entries
+    mvn_val_t key = mvn_val_str("cherry");
+    TEST_ASSERT(mvn_btree_get(btree, &key) != NULL, "Should find cherry via mvn_val_t key");
+    mvn_val_free(&key);
+
+    mvn_btree_iter_t iter  = mvn_btree_iter(btree);
+    const mvn_val_t *found = NULL;
+    size_t           seen  = 0;
+    while (mvn_btree_iter_next(&iter, &found, NULL)) {
+        TEST_ASSERT_FMT(seen < word_count && strcmp(found->str->data, sorted[seen]) == 0,
+                        "Expected %s at position %zu",
+                        seen < word_count ? sorted[seen] : "(end)",
+                        seen);
+        seen++;
+    }
+    TEST_ASSERT(seen == word_count, "Iteration should visit every word");
+
+    TEST_ASSERT(mvn_btree_remove_cstr(btree, "apple"), "Remove apple should succeed");
+    TEST_ASSERT(!mvn_btree_remove_cstr(btree, "apple"), "Second remove should fail");
+    TEST_ASSERT(mvn_btree_count(btree) == word_count - 1, "Count should drop by one");
+
+    mvn_btree_free(btree);
+    return true;
+}
+
+static bool test_btree_range(void)
+{
+    // Even keys only, so bounds can fall between keys
+    const size_t count = 1000;
+    mvn_btree_t *btree = mvn_btree_new();
+    TEST_ASSERT(btree != NULL, "Failed to create tree");
+    for (size_t index = 0; index < count; index++) {
+        TEST_ASSERT(mvn_btree_put(btree, mvn_val_i64((int64_t)index * 2), mvn_val_null()),
+                    "Put should succeed");
+    }
+
+    // [100, 200) holds 100, 102, ..., 198
+    mvn_val_t        low  = mvn_val_i64(100);
+    mvn_val_t        high = mvn_val_i64(200);
+    mvn_btree_iter_t iter = mvn_btree_range(btree, &low, &high);
+    const mvn_val_t *key  = NULL;
+    int64_t          next = 100;
+    while (mvn_btree_iter_next(&iter, &key, NULL)) {
+        TEST_ASSERT_FMT(key->i64 == next, "Expected %lld", (long long)next);
+        next += 2;
+    }
+    TEST_ASSERT(next == 200, "Range should stop before the upper bound");
+
+    // Bounds between keys: [101, 106) holds 102 and 104
+    low          = mvn_val_i64(101);
+    high         = mvn_val_i64(106);
+    iter         = mvn_btree_range(btree, &low, &high);
+    size_t found = 0;
+    while (mvn_btree_iter_next(&iter, NULL, NULL)) {
+        found++;
+    }
+    TEST_ASSERT(found == 2, "Range between keys should hold two entries");
+
+    // Open bounds
+    low   = mvn_val_i64(1990);
+    iter  = mvn_btree_range(btree, &low, NULL);
+    found = 0;
+    while (mvn_btree_iter_next(&iter, NULL, NULL)) {
+        found++;
+    }
+    TEST_ASSERT(found == 5, "Open upper bound should run to the last key");
+    high  = mvn_val_i64(10);
+    iter  = mvn_btree_range(btree, NULL, &high);
+    found = 0;
+    while (mvn_btree_iter_next(&iter, NULL, NULL)) {
+        found++;
+    }
+    TEST_ASSERT(found == 5, "Open lower bound should start at the first key");
+
+    // Empty ranges
+    low  = mvn_val_i64(5000);
+    iter = mvn_btree_range(btree, &low, NULL);
+    TEST_ASSERT(!mvn_btree_iter_next(&iter, NULL, NULL), "Range past the end should be empty");
+    low  = mvn_val_i64(50);
+    high = mvn_val_i64(50);
+    iter = mvn_btree_range(btree, &low, &high);
+    TEST_ASSERT(!mvn_btree_iter_next(&iter, NULL, NULL), "Range [x, x) should be empty");
+
+    mvn_btree_free(btree);
+    return true;
+}
+
+static bool test_btree_bulk_load(void)
+{
+    const size_t count  = 5000;
+    mvn_arr_t   *keys   = mvn_arr_new_capacity(count);
+    mvn_arr_t   *values = mvn_arr_new_capacity(count);
+    TEST_ASSERT(keys != NULL && values != NULL, "Failed to create arrays");
+    for (size_t index = 0; index < count; index++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%06zu", index);
+        TEST_ASSERT(mvn_arr_push(keys, mvn_val_str(key)), "Push key should succeed");
+        TEST_ASSERT(mvn_arr_push(values, mvn_val_u64(index)), "Push value should succeed");
+    }
+
+    // Out of order input is rejected and the arrays stay with the caller
+    mvn_val_t swap = keys->data[10];
+    keys->data[10] = keys->data[11];
+    keys->data[11] = swap;
+    TEST_ASSERT(mvn_btree_bulk_load(keys, values) == NULL, "Unsorted keys should be rejected");
+    TEST_ASSERT(keys->count == count && values->count == count, "Arrays should be untouched");
+    swap           = keys->data[10];
+    keys->data[10] = keys->data[11];
+    keys->data[11] = swap;
+
+    mvn_btree_t *btree = mvn_btree_bulk_load(keys, values);
+    TEST_ASSERT(btree != NULL, "Bulk load of sorted keys should succeed");
+    TEST_ASSERT(mvn_btree_count(btree) == count, "Count should match the input");
+    TEST_ASSERT(tree_is_valid(btree), "Bulk loaded tree invariants should hold");
+
+    mvn_val_t *value = mvn_btree_get_cstr(btree, "key004321");
+    TEST_ASSERT(value != NULL && value->u64 == 4321, "Should find a bulk loaded key");
+
+    // The loaded tree accepts further updates
+    for (size_t index = 0; index < count; index += 3) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%06zu", index);
+        TEST_ASSERT(mvn_btree_remove_cstr(btree, key), "Remove should succeed");
+    }
+    TEST_ASSERT(mvn_btree_put_cstr(btree, "zzz", mvn_val_null()), "Put should succeed");
+    TEST_ASSERT(tree_is_valid(btree), "Invariants should hold after updates");
+
+    mvn_btree_free(btree);
+
+    // Empty input gives an empty tree
+    keys   = mvn_arr_new();
+    values = mvn_arr_new();
+    btree  = mvn_btree_bulk_load(keys, values);
+    TEST_ASSERT(btree != NULL && mvn_btree_count(btree) == 0, "Empty bulk load should succeed");
+    mvn_btree_free(btree);
+
+    return true;
+}
+
+static bool test_btree_null_param_safety(void)
+{
+    mvn_val_t key = mvn_val_i32(1);
+    TEST_ASSERT(!mvn_btree_put(NULL, mvn_val_i32(1), mvn_val_str("x")), "Put to NULL fails");
+    TEST_ASSERT(!mvn_btree_put_cstr(NULL, "a", mvn_val_null()), "Put cstr to NULL fails");
+    TEST_ASSERT(mvn_btree_get(NULL, &key) == NULL, "Get from NULL returns NULL");
+    TEST_ASSERT(mvn_btree_get_cstr(NULL, "a") == NULL, "Get cstr from NULL returns NULL");
+    TEST_ASSERT(!mvn_btree_remove(NULL, &key), "Remove from NULL fails");
+    TEST_ASSERT(mvn_btree_count(NULL) == 0, "Count of NULL is 0");
+    TEST_ASSERT(mvn_btree_bulk_load(NULL, NULL) == NULL, "Bulk load of NULL fails");
+
+    mvn_btree_iter_t iter = mvn_btree_range(NULL, &key, NULL);
+    TEST_ASSERT(!mvn_btree_iter_next(&iter, NULL, NULL), "NULL tree should not iterate");
+    TEST_ASSERT(!mvn_btree_iter_next(NULL, NULL, NULL), "NULL iterator should not iterate");
+
+    mvn_btree_t *btree = mvn_btree_new();
+    TEST_ASSERT(btree != NULL, "Failed to create tree");
+    TEST_ASSERT(mvn_btree_get(btree, NULL) == NULL, "Get with NULL key returns NULL");
+    TEST_ASSERT(!mvn_btree_remove(btree, &key), "Remove from empty tree fails");
+    mvn_btree_free(btree);
+    mvn_btree_free(NULL);
+    return true;
+}
+
+/**
+ * \brief           Run all B+tree tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_btree_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING B+TREE TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_btree_put_get_remove);
+    RUN_TEST(test_btree_string_keys);
+    RUN_TEST(test_btree_range);
+    RUN_TEST(test_btree_bulk_load);
+    RUN_TEST(test_btree_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_btree_tests(&passed, &failed, &total);
+
+    printf("\n===== B+TREE TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
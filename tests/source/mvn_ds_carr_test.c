@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_carr_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_carr.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// The allocation failure test caps the address space, which sanitizer runtimes do not survive
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define CARR_TEST_LIMIT_MEMORY 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) ||                         \
+    __has_feature(memory_sanitizer)
+#define CARR_TEST_LIMIT_MEMORY 0
+#endif
+#endif
+#if !defined(CARR_TEST_LIMIT_MEMORY) && defined(__linux__)
+#define CARR_TEST_LIMIT_MEMORY 1
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// --- Helpers ---
+
+static void push_range(size_t begin, size_t end, void *context)
+{
+    mvn_carr_t *carr = (mvn_carr_t *)context;
+    for (size_t index = begin; index < end; index++) {
+        mvn_carr_push(carr, mvn_val_i64((int64_t)index));
+    }
+}
+
+static int compare_i64(const mvn_val_t *val_one, const mvn_val_t *val_two)
+{
+    return mvn_val_compare(val_one, val_two);
+}
+
+// --- Test Functions ---
+
+static bool test_carr_creation_and_destruction(void)
+{
+    mvn_carr_t *carr = mvn_carr_new();
+    TEST_ASSERT(carr != NULL, "Failed to create concurrent array");
+    TEST_ASSERT(mvn_carr_count(carr) == 0, "New concurrent array count should be 0");
+    TEST_ASSERT(mvn_carr_get(carr, 0) == NULL, "Get on empty array should return NULL");
+    mvn_carr_free(carr);
+
+    carr = mvn_carr_new_capacity(1000);
+    TEST_ASSERT(carr != NULL, "Failed to create concurrent array with capacity");
+    TEST_ASSERT(mvn_carr_count(carr) == 0, "Preallocated array count should be 0");
+    mvn_carr_free(carr);
+
+    mvn_carr_free(NULL); // Should not crash
+    return true;
+}
+
+static bool test_carr_push_and_get(void)
+{
+    mvn_carr_t *carr = mvn_carr_new();
+    TEST_ASSERT(carr != NULL, "Failed to create concurrent array");
+
+    // Cross several segment boundaries
+    const size_t element_count = MVN_DS_CARR_FIRST_SEGMENT_SIZE * 10;
+    for (size_t index = 0; index < element_count; index++) {
+        TEST_ASSERT(mvn_carr_push(carr, mvn_val_i64((int64_t)index)), "Push failed");
+    }
+    TEST_ASSERT(mvn_carr_push(carr, mvn_val_str("owned")), "Push of string failed");
+    TEST_ASSERT(mvn_carr_count(carr) == element_count + 1, "Count should include every push");
+
+    for (size_t index = 0; index < element_count; index++) {
+        const mvn_val_t *value = mvn_carr_get(carr, index);
+        TEST_ASSERT_FMT(value != NULL && value->type == MVN_VAL_I64 &&
+                            value->i64 == (int64_t)index,
+                        "Wrong value at index %zu",
+                        index);
+    }
+    const mvn_val_t *last = mvn_carr_get(carr, element_count);
+    TEST_ASSERT(last != NULL && last->type == MVN_VAL_STRING &&
+                    mvn_str_equal_cstr(last->str, "owned"),
+                "Last value should be the owned string");
+    TEST_ASSERT(mvn_carr_get(carr, element_count + 1) == NULL,
+                "Get past the published count should return NULL");
+
+    mvn_carr_free(carr); // Frees the owned string
+    return true;
+}
+
+static bool test_carr_concurrent_push(void)
+{
+    const size_t element_count = 200000;
+    mvn_pool_t  *pool          = mvn_pool_new(4);
+    mvn_carr_t  *carr          = mvn_carr_new();
+    TEST_ASSERT(pool != NULL && carr != NULL, "Failed to create pool or concurrent array");
+
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 0, element_count, 1000, push_range, carr),
+                "parallel_for failed");
+    TEST_ASSERT(mvn_carr_count(carr) == element_count, "Every push should be published");
+
+    mvn_arr_t *array = mvn_carr_to_arr(carr); // carr is consumed
+    TEST_ASSERT(array != NULL, "Conversion to mvn_arr_t failed");
+    TEST_ASSERT(array->count == element_count, "Converted array should keep every element");
+
+    // Each value must appear exactly once
+    mvn_arr_sort(array, compare_i64);
+    for (size_t index = 0; index < element_count; index++) {
+        TEST_ASSERT_FMT(array->data[index].i64 == (int64_t)index, "Missing value %zu", index);
+    }
+
+    mvn_arr_free(array);
+    mvn_pool_free(pool);
+    return true;
+}
+
+static bool test_carr_to_arr_ownership(void)
+{
+    mvn_carr_t *carr = mvn_carr_new_capacity(4);
+    TEST_ASSERT(carr != NULL, "Failed to create concurrent array");
+    mvn_carr_push(carr, mvn_val_str("alpha"));
+    mvn_carr_push(carr, mvn_val_arr());
+    mvn_carr_push(carr, mvn_val_hmap());
+
+    mvn_arr_t *array = mvn_carr_to_arr(carr);
+    TEST_ASSERT(array != NULL && array->count == 3, "Converted array should have 3 elements");
+    TEST_ASSERT(array->data[0].type == MVN_VAL_STRING &&
+                    mvn_str_equal_cstr(array->data[0].str, "alpha"),
+                "String should be moved intact");
+    TEST_ASSERT(array->data[1].type == MVN_VAL_ARRAY, "Array should be moved intact");
+    TEST_ASSERT(array->data[2].type == MVN_VAL_HASHMAP, "Map should be moved intact");
+    TEST_ASSERT(mvn_arr_push(array, mvn_val_i32(4)), "Converted array should accept pushes");
+    mvn_arr_free(array);
+
+    carr = mvn_carr_new();
+    array = mvn_carr_to_arr(carr);
+    TEST_ASSERT(array != NULL && array->count == 0, "Empty conversion should give empty array");
+    mvn_arr_free(array);
+    return true;
+}
+
+#if CARR_TEST_LIMIT_MEMORY
+
+// Pushes value index, recording what each slot should hold afterwards.
+static bool push_tracked(mvn_carr_t *carr, size_t index, size_t *failed, bool *pushed_ok)
+{
+    pushed_ok[index] = mvn_carr_push(carr, mvn_val_i64((int64_t)index));
+    *failed += pushed_ok[index] ? 0 : 1;
+    return pushed_ok[index];
+}
+
+static bool test_carr_segment_allocation_failure(void)
+{
+    // Push past 1M values, into segment 14, then cap the address space so the next segment
+    // (2M values, about 36 MB) cannot be allocated
+    const size_t before_limit = (size_t)1 << 20;
+    const size_t max_pushes   = (size_t)1 << 23;
+    bool        *pushed_ok    = (bool *)calloc(max_pushes, sizeof(bool));
+    mvn_carr_t  *carr         = mvn_carr_new();
+    TEST_ASSERT(pushed_ok != NULL && carr != NULL, "Failed to create concurrent array");
+    size_t failed = 0;
+    size_t pushes = 0;
+    while (pushes < before_limit) {
+        TEST_ASSERT(push_tracked(carr, pushes++, &failed, pushed_ok), "Push failed");
+    }
+
+    struct rlimit original;
+    long          vm_pages = 0;
+    FILE         *statm    = fopen("/proc/self/statm", "r");
+    TEST_ASSERT(statm != NULL && fscanf(statm, "%ld", &vm_pages) == 1, "Cannot read statm");
+    fclose(statm);
+    TEST_ASSERT(getrlimit(RLIMIT_AS, &original) == 0, "getrlimit failed");
+    struct rlimit limited = original;
+    limited.rlim_cur      = (rlim_t)vm_pages * (rlim_t)sysconf(_SC_PAGESIZE);
+    TEST_ASSERT(setrlimit(RLIMIT_AS, &limited) == 0, "setrlimit failed");
+    while (failed == 0 && pushes < max_pushes) {
+        push_tracked(carr, pushes++, &failed, pushed_ok);
+    }
+    setrlimit(RLIMIT_AS, &original);
+    TEST_ASSERT(failed > 0, "A segment allocation should have failed under the limit");
+
+    // Memory is back: the rest of the failed segment still fails, later segments work
+    size_t successes_after = 0;
+    while (successes_after < 1000 && pushes < max_pushes) {
+        successes_after += push_tracked(carr, pushes++, &failed, pushed_ok) ? 1 : 0;
+    }
+    TEST_ASSERT(successes_after == 1000, "Pushes after the failed segment should succeed");
+    TEST_ASSERT(mvn_carr_count(carr) == pushes, "Failed slots must not block publication");
+    TEST_ASSERT(mvn_carr_failed_count(carr) == failed, "Failed pushes should be counted");
+    for (size_t index = 0; index < pushes; index++) {
+        const mvn_val_t *value = mvn_carr_get(carr, index);
+        TEST_ASSERT_FMT(value != NULL && (pushed_ok[index] ? value->type == MVN_VAL_I64 &&
+                                                                 value->i64 == (int64_t)index
+                                                           : value->type == MVN_VAL_NULL),
+                        "Wrong value at index %zu",
+                        index);
+    }
+
+    mvn_arr_t *array = mvn_carr_to_arr(carr);
+    TEST_ASSERT(array != NULL && array->count == pushes, "Conversion should keep every slot");
+    for (size_t index = 0; index < pushes; index++) {
+        TEST_ASSERT_FMT(pushed_ok[index] ? array->data[index].i64 == (int64_t)index
+                                         : array->data[index].type == MVN_VAL_NULL,
+                        "Converted value at index %zu",
+                        index);
+    }
+    mvn_arr_free(array);
+    free(pushed_ok);
+    return true;
+}
+
+#endif /* CARR_TEST_LIMIT_MEMORY */
+
+static bool test_carr_null_param_safety(void)
+{
+    TEST_ASSERT(!mvn_carr_push(NULL, mvn_val_str("leak check")), "Push to NULL should fail");
+    TEST_ASSERT(mvn_carr_count(NULL) == 0, "Count of NULL should be 0");
+    TEST_ASSERT(mvn_carr_get(NULL, 0) == NULL, "Get on NULL should return NULL");
+    TEST_ASSERT(mvn_carr_to_arr(NULL) == NULL, "Convert NULL should return NULL");
+    return true;
+}
+
+// --- Test Runner ---
+
+/**
+ * \brief           Run all concurrent array tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_carr_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING CONCURRENT ARRAY TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_carr_creation_and_destruction);
+    RUN_TEST(test_carr_push_and_get);
+#if CARR_TEST_LIMIT_MEMORY
+    // Before any worker threads exist, so no spare malloc arena can absorb the failed segment
+    RUN_TEST(test_carr_segment_allocation_failure);
+#endif
+    RUN_TEST(test_carr_concurrent_push);
+    RUN_TEST(test_carr_to_arr_ownership);
+    RUN_TEST(test_carr_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_carr_tests(&passed, &failed, &total);
+
+    printf("\n===== CONCURRENT ARRAY TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_fmap_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_fmap.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+static mvn_hmap_t *build_numbered_map(size_t count)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    if (hmap == NULL) {
+        return NULL;
+    }
+    char key_buffer[32];
+    for (size_t index = 0; index < count; index++) {
+        snprintf(key_buffer, sizeof(key_buffer), "key_%zu", index);
+        if (!mvn_hmap_set_cstr(hmap, key_buffer, mvn_val_i64((int64_t)index))) {
+            mvn_hmap_free(hmap);
+            return NULL;
+        }
+    }
+    return hmap;
+}
+
+static void lookup_range(size_t begin, size_t end, void *context)
+{
+    const mvn_fmap_t *fmap = (const mvn_fmap_t *)context;
+    char              key_buffer[32];
+    for (size_t index = begin; index < end; index++) {
+        snprintf(key_buffer, sizeof(key_buffer), "key_%zu", index);
+        const mvn_val_t *value = mvn_fmap_get_cstr(fmap, key_buffer);
+        if (value == NULL || value->i64 != (int64_t)index) {
+            abort(); // Surfaces as a test crash
+        }
+    }
+}
+
+// --- Test Functions ---
+
+static bool test_fmap_from_hmap(void)
+{
+    // Sizes around the bucket and reduction boundaries
+    const size_t sizes[] = {0, 1, 2, 3, 5, 17, 100, 1000, 25000};
+    for (size_t size_index = 0; size_index < sizeof(sizes) / sizeof(sizes[0]); size_index++) {
+        size_t      count = sizes[size_index];
+        mvn_hmap_t *hmap  = build_numbered_map(count);
+        TEST_ASSERT(hmap != NULL, "Failed to build source map");
+
+        mvn_fmap_t *fmap = mvn_fmap_from_hmap(hmap); // hmap is consumed
+        TEST_ASSERT_FMT(fmap != NULL, "Freezing %zu keys failed", count);
+        TEST_ASSERT_FMT(mvn_fmap_count(fmap) == count, "Frozen count should be %zu", count);
+
+        char key_buffer[32];
+        for (size_t index = 0; index < count; index++) {
+            snprintf(key_buffer, sizeof(key_buffer), "key_%zu", index);
+            const mvn_val_t *value = mvn_fmap_get_cstr(fmap, key_buffer);
+            TEST_ASSERT_FMT(value != NULL && value->type == MVN_VAL_I64 &&
+                                value->i64 == (int64_t)index,
+                            "Wrong value for %s",
+                            key_buffer);
+        }
+        for (size_t index = count; index < count + 100; index++) {
+            snprintf(key_buffer, sizeof(key_buffer), "key_%zu", index);
+            TEST_ASSERT_FMT(mvn_fmap_get_cstr(fmap, key_buffer) == NULL,
+                            "Absent key %s should not be found",
+                            key_buffer);
+        }
+        TEST_ASSERT(mvn_fmap_get_cstr(fmap, "") == NULL, "Empty key should not be found");
+        mvn_fmap_free(fmap);
+    }
+    return true;
+}
+
+static bool test_fmap_iteration_and_str_keys(void)
+{
+    mvn_hmap_t *hmap = mvn_hmap_new();
+    TEST_ASSERT(hmap != NULL, "Failed to create map");
+    mvn_hmap_set_cstr(hmap, "alpha", mvn_val_str("first"));
+    mvn_hmap_set_cstr(hmap, "beta", mvn_val_i32(2));
+    mvn_hmap_set_cstr(hmap, "", mvn_val_bool(true));
+
+    mvn_fmap_t *fmap = mvn_fmap_from_hmap(hmap);
+    TEST_ASSERT(fmap != NULL && mvn_fmap_count(fmap) == 3, "Frozen map should hold 3 keys");
+
+    // Every slot is occupied and every key resolves back to its own slot
+    for (size_t index = 0; index < mvn_fmap_count(fmap); index++) {
+        const char *key = mvn_fmap_key_at(fmap, index);
+        TEST_ASSERT(key != NULL, "Key at slot should not be NULL");
+        TEST_ASSERT(mvn_fmap_get_cstr(fmap, key) == mvn_fmap_value_at(fmap, index),
+                    "Lookup should return the slot's value");
+    }
+    TEST_ASSERT(mvn_fmap_key_at(fmap, 3) == NULL, "Key past the end should be NULL");
+    TEST_ASSERT(mvn_fmap_value_at(fmap, 3) == NULL, "Value past the end should be NULL");
+
+    mvn_str_t       *key   = mvn_str_new("alpha");
+    const mvn_val_t *value = mvn_fmap_get(fmap, key);
+    TEST_ASSERT(value != NULL && value->type == MVN_VAL_STRING &&
+                    mvn_str_equal_cstr(value->str, "first"),
+                "mvn_str_t lookup should find 'alpha'");
+    mvn_str_free(key);
+
+    value = mvn_fmap_get_cstr(fmap, "");
+    TEST_ASSERT(value != NULL && value->b, "Empty key should be found");
+
+    mvn_fmap_free(fmap);
+    return true;
+}
+
+static bool test_val_freeze_nested(void)
+{
+    mvn_val_t root  = mvn_val_hmap();
+    mvn_val_t inner = mvn_val_hmap();
+    mvn_val_t list  = mvn_val_arr();
+    TEST_ASSERT(root.type == MVN_VAL_HASHMAP && inner.type == MVN_VAL_HASHMAP,
+                "Failed to create maps");
+    mvn_hmap_set_cstr(inner.hmap, "depth", mvn_val_i32(2));
+    mvn_arr_push(list.arr, mvn_val_hmap());
+    mvn_arr_push(list.arr, mvn_val_i32(7));
+    mvn_hmap_set_cstr(root.hmap, "inner", inner);
+    mvn_hmap_set_cstr(root.hmap, "list", list);
+    mvn_hmap_set_cstr(root.hmap, "name", mvn_val_str("root"));
+
+    mvn_val_t original = mvn_val_deep_copy(&root);
+    TEST_ASSERT(mvn_val_freeze(&root), "Freeze failed");
+    TEST_ASSERT(root.type == MVN_VAL_FROZEN_MAP, "Root should become a frozen map");
+    TEST_ASSERT(strcmp(mvn_val_type_to_str(root.type), "FROZEN_MAP") == 0,
+                "Type string should be FROZEN_MAP");
+
+    const mvn_val_t *frozen_inner = mvn_fmap_get_cstr(root.fmap, "inner");
+    TEST_ASSERT(frozen_inner != NULL && frozen_inner->type == MVN_VAL_FROZEN_MAP,
+                "Nested map should be frozen");
+    const mvn_val_t *depth = mvn_fmap_get_cstr(frozen_inner->fmap, "depth");
+    TEST_ASSERT(depth != NULL && depth->i32 == 2, "Nested value should survive freezing");
+
+    const mvn_val_t *frozen_list = mvn_fmap_get_cstr(root.fmap, "list");
+    TEST_ASSERT(frozen_list != NULL && frozen_list->type == MVN_VAL_ARRAY,
+                "Arrays should stay arrays");
+    TEST_ASSERT(frozen_list->arr->data[0].type == MVN_VAL_FROZEN_MAP,
+                "Maps inside arrays should be frozen");
+
+    // Frozen maps compare type-strictly against unfrozen ones
+    TEST_ASSERT(!mvn_val_equal(&root, &original), "Frozen and unfrozen maps differ in type");
+    TEST_ASSERT(mvn_val_freeze(&original), "Freezing the copy failed");
+    TEST_ASSERT(mvn_val_equal(&root, &original), "Frozen copies should be equal");
+
+    mvn_val_t copy = mvn_val_deep_copy(&root);
+    TEST_ASSERT(copy.type == MVN_VAL_FROZEN_MAP && copy.fmap != root.fmap,
+                "Deep copy should allocate a new frozen map");
+    TEST_ASSERT(mvn_val_equal(&root, &copy), "Deep copy should be equal");
+    TEST_ASSERT(mvn_val_compare(&root, &root) == 0, "Compare with itself should be 0");
+    TEST_ASSERT(mvn_val_freeze(&copy), "Freezing a frozen map should succeed");
+
+    mvn_val_t primitive = mvn_val_i32(5);
+    TEST_ASSERT(mvn_val_freeze(&primitive) && primitive.i32 == 5,
+                "Primitives should be unchanged");
+
+    mvn_val_free(&copy);
+    mvn_val_free(&original);
+    mvn_val_free(&root);
+    TEST_ASSERT(root.type == MVN_VAL_NULL, "Freed value should be NULL");
+    return true;
+}
+
+static bool test_fmap_hash_collision(void)
+{
+    // Two keys with the same FNV-1a 64 hash always share a bucket and a slot, so the first
+    // build must fail and the map is rebuilt with a salted hash
+    const char *first  = "623ZEs4R\xbb" "3lO03PA";
+    const char *second = "9T0Rz5S0P8800TLA";
+    mvn_val_t   root   = mvn_val_hmap();
+    TEST_ASSERT(root.type == MVN_VAL_HASHMAP, "Failed to create map");
+    mvn_hmap_set_cstr(root.hmap, first, mvn_val_i32(1));
+    mvn_hmap_set_cstr(root.hmap, second, mvn_val_i32(2));
+    mvn_hmap_set_cstr(root.hmap, "other", mvn_val_i32(3));
+
+    TEST_ASSERT(mvn_val_freeze(&root), "Freezing colliding keys should succeed");
+    TEST_ASSERT(root.type == MVN_VAL_FROZEN_MAP && root.fmap->salt != 0,
+                "Build should have been retried with a salt");
+    const mvn_val_t *value = mvn_fmap_get_cstr(root.fmap, first);
+    TEST_ASSERT(value != NULL && value->i32 == 1, "First colliding key should be found");
+    value = mvn_fmap_get_cstr(root.fmap, second);
+    TEST_ASSERT(value != NULL && value->i32 == 2, "Second colliding key should be found");
+    value = mvn_fmap_get_cstr(root.fmap, "other");
+    TEST_ASSERT(value != NULL && value->i32 == 3, "Other key should be found");
+    TEST_ASSERT(mvn_fmap_get_cstr(root.fmap, "missing") == NULL, "Missing key should not match");
+
+    // Copies keep the salt, so their lookups still agree
+    mvn_val_t copy = mvn_val_deep_copy(&root);
+    TEST_ASSERT(copy.type == MVN_VAL_FROZEN_MAP && mvn_val_equal(&root, &copy),
+                "Deep copy should be equal");
+    value = mvn_fmap_get_cstr(copy.fmap, second);
+    TEST_ASSERT(value != NULL && value->i32 == 2, "Copy should find the colliding key");
+
+    mvn_val_free(&copy);
+    mvn_val_free(&root);
+    return true;
+}
+
+static bool test_fmap_concurrent_lookup(void)
+{
+    const size_t count = 20000;
+    mvn_fmap_t  *fmap  = mvn_fmap_from_hmap(build_numbered_map(count));
+    mvn_pool_t  *pool  = mvn_pool_new(4);
+    TEST_ASSERT(fmap != NULL && pool != NULL, "Failed to create frozen map or pool");
+
+    // Readers share the map with no locking
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 0, count, 500, lookup_range, fmap),
+                "parallel_for failed");
+
+    mvn_pool_free(pool);
+    mvn_fmap_free(fmap);
+    return true;
+}
+
+static bool test_fmap_null_param_safety(void)
+{
+    TEST_ASSERT(mvn_fmap_from_hmap(NULL) == NULL, "Freeze of NULL should return NULL");
+    TEST_ASSERT(mvn_fmap_copy(NULL) == NULL, "Copy of NULL should return NULL");
+    TEST_ASSERT(mvn_fmap_count(NULL) == 0, "Count of NULL should be 0");
+    TEST_ASSERT(mvn_fmap_get(NULL, NULL) == NULL, "Get on NULL should return NULL");
+    TEST_ASSERT(mvn_fmap_get_cstr(NULL, "key") == NULL, "Get on NULL should return NULL");
+    TEST_ASSERT(mvn_fmap_key_at(NULL, 0) == NULL, "Key of NULL should be NULL");
+    TEST_ASSERT(mvn_fmap_value_at(NULL, 0) == NULL, "Value of NULL should be NULL");
+    TEST_ASSERT(!mvn_val_freeze(NULL), "Freeze of NULL pointer should fail");
+    mvn_fmap_free(NULL); // Should not crash
+    return true;
+}
+
+// --- Test Runner ---
+
+/**
+ * \brief           Run all frozen map tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_fmap_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING FROZEN MAP TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_fmap_from_hmap);
+    RUN_TEST(test_fmap_iteration_and_str_keys);
+    RUN_TEST(test_val_freeze_nested);
+    RUN_TEST(test_fmap_hash_collision);
+    RUN_TEST(test_fmap_concurrent_lookup);
+    RUN_TEST(test_fmap_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_fmap_tests(&passed, &failed, &total);
+
+    printf("\n===== FROZEN MAP TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
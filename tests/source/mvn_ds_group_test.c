@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_group_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_arr.h"
+#include "mvn_ds/mvn_ds_group.h"
+#include "mvn_ds/mvn_ds_hmap.h"
+#include "mvn_ds/mvn_ds_pool.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Builds sale records {region, amount: i32, price: f64, customer: {tier}}. Every fourth record
+// has no customer and every seventh has a null price.
+static mvn_arr_t *make_sales(size_t count, bool seeded)
+{
+    static const char *const regions[] = {"north", "south", "east"};
+    static const char *const tiers[]   = {"gold", "silver"};
+    mvn_arr_t               *rows      = mvn_arr_new();
+    for (size_t index = 0; rows != NULL && index < count; index++) {
+        mvn_hmap_t *record = seeded ? mvn_hmap_new_seeded(8, 0x5EED + index) : mvn_hmap_new();
+        if (record == NULL) {
+            mvn_arr_free(rows);
+            return NULL;
+        }
+        mvn_hmap_set_cstr(record, "region", mvn_val_str(regions[index % 3]));
+        mvn_hmap_set_cstr(record, "amount", mvn_val_i32((int32_t)(index % 11)));
+        mvn_hmap_set_cstr(record,
+                          "price",
+                          index % 7 == 0 ? mvn_val_null() : mvn_val_f64((double)index * 0.25));
+        if (index % 4 != 0) {
+            mvn_val_t customer = mvn_val_hmap();
+            mvn_hmap_set_cstr(customer.hmap, "tier", mvn_val_str(tiers[index % 2]));
+            mvn_hmap_set_cstr(record, "customer", customer);
+        }
+        mvn_arr_push(rows, mvn_val_hmap_take(record));
+    }
+    return rows;
+}
+
+// Finds the result record whose key field equals key_cstr (or the null group if NULL).
+static const mvn_hmap_t *
+find_group(const mvn_arr_t *groups, const char *key_path, const char *key_cstr)
+{
+    for (size_t index = 0; index < groups->count; index++) {
+        const mvn_val_t *key    = mvn_hmap_cstr(groups->data[index].hmap, key_path);
+        bool             is_str = key->type == MVN_VAL_STRING;
+        if (key_cstr == NULL ? key->type == MVN_VAL_NULL
+                             : is_str && strcmp(key->str->data, key_cstr) == 0) {
+            return groups->data[index].hmap;
+        }
+    }
+    return NULL;
+}
+
+// --- Test Functions ---
+
+static bool test_group_aggregations(void)
+{
+    mvn_arr_t *rows = make_sales(100, false);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    const mvn_agg_t aggregations[] = {
+        {MVN_AGG_COUNT, NULL, "records"},
+        {MVN_AGG_COUNT, "price", "priced"},
+        {MVN_AGG_SUM, "amount", "amount_sum"},
+        {MVN_AGG_SUM, "price", "price_sum"},
+        {MVN_AGG_MIN, "price", "cheapest"},
+        {MVN_AGG_MAX, "amount", "largest"},
+        {MVN_AGG_AVG, "amount", "amount_avg"},
+        {MVN_AGG_COLLECT, "amount", "amounts"},
+    };
+    mvn_arr_t *groups = mvn_group_by(rows, "region", aggregations, 8);
+    TEST_ASSERT(groups != NULL && groups->count == 3, "One record per region");
+
+    // Groups come in order of their first record
+    const char *order[] = {"north", "south", "east"};
+    for (size_t index = 0; index < 3; index++) {
+        const mvn_val_t *key = mvn_hmap_cstr(groups->data[index].hmap, "region");
+        TEST_ASSERT_FMT(strcmp(key->str->data, order[index]) == 0, "Group %zu", index);
+    }
+
+    for (size_t group = 0; group < 3; group++) {
+        uint64_t records   = 0;
+        uint64_t priced    = 0;
+        int64_t  amounts   = 0;
+        double   prices    = 0.0;
+        double   cheapest  = 1e300;
+        int32_t  largest   = -1;
+        size_t   collected = 0;
+        for (size_t index = group; index < 100; index += 3) {
+            int32_t amount = (int32_t)(index % 11);
+            records++;
+            amounts += amount;
+            largest = amount > largest ? amount : largest;
+            if (index % 7 != 0) {
+                priced++;
+                prices += (double)index * 0.25;
+                cheapest = (double)index * 0.25 < cheapest ? (double)index * 0.25 : cheapest;
+            }
+        }
+        const mvn_hmap_t *result = groups->data[group].hmap;
+        TEST_ASSERT(mvn_hmap_cstr(result, "records")->u64 == records, "Count of records");
+        TEST_ASSERT(mvn_hmap_cstr(result, "priced")->u64 == priced, "Count skips nulls");
+        TEST_ASSERT(mvn_hmap_cstr(result, "amount_sum")->type == MVN_VAL_I64 &&
+                        mvn_hmap_cstr(result, "amount_sum")->i64 == amounts,
+                    "Integer sum stays an integer");
+        TEST_ASSERT(mvn_hmap_cstr(result, "price_sum")->type == MVN_VAL_F64 &&
+                        mvn_hmap_cstr(result, "price_sum")->f64 == prices,
+                    "Float sum");
+        TEST_ASSERT(mvn_hmap_cstr(result, "cheapest")->f64 == cheapest, "Min");
+        TEST_ASSERT(mvn_hmap_cstr(result, "largest")->i32 == largest, "Max keeps the type");
+        TEST_ASSERT(mvn_hmap_cstr(result, "amount_avg")->f64 == (double)amounts / (double)records,
+                    "Average");
+        const mvn_arr_t *items = mvn_hmap_cstr(result, "amounts")->arr;
+        for (size_t index = group; index < 100; index += 3) {
+            TEST_ASSERT(items->data[collected++].i32 == (int32_t)(index % 11), "Collect order");
+        }
+        TEST_ASSERT(items->count == collected, "Collect holds every value");
+    }
+    mvn_arr_free(groups);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_group_nested_and_missing(void)
+{
+    mvn_arr_t *rows = make_sales(40, false);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    const mvn_agg_t aggregations[] = {
+        {MVN_AGG_COUNT, NULL, "records"},
+        {MVN_AGG_MIN, "customer.missing", "nothing"},
+        {MVN_AGG_AVG, "region", "not_numbers"},
+        {MVN_AGG_COLLECT, "customer.tier", "tiers"},
+    };
+    mvn_arr_t *groups = mvn_group_by(rows, "customer.tier", aggregations, 4);
+    TEST_ASSERT(groups != NULL && groups->count == 3, "Gold, silver and no customer");
+
+    const mvn_hmap_t *none = find_group(groups, "customer.tier", NULL);
+    TEST_ASSERT(none != NULL && mvn_hmap_cstr(none, "records")->u64 == 10,
+                "Records without the key form the null group");
+    TEST_ASSERT(mvn_hmap_cstr(none, "tiers")->arr->count == 0, "Missing values are not collected");
+    const mvn_hmap_t *silver = find_group(groups, "customer.tier", "silver");
+    TEST_ASSERT(silver != NULL && mvn_hmap_cstr(silver, "records")->u64 == 20, "Silver customers");
+    TEST_ASSERT(mvn_hmap_cstr(silver, "nothing")->type == MVN_VAL_NULL, "Min of nothing is null");
+    TEST_ASSERT(mvn_hmap_cstr(silver, "not_numbers")->type == MVN_VAL_NULL, "Average of strings");
+    TEST_ASSERT(mvn_hmap_cstr(silver, "tiers")->arr->count == 20, "Nested values collected");
+    mvn_arr_free(groups);
+
+    // Group by a path that no record has: one null group
+    groups = mvn_group_by(rows, "absent.field", aggregations, 1);
+    TEST_ASSERT(groups != NULL && groups->count == 1, "Single null group");
+    TEST_ASSERT(mvn_hmap_cstr(groups->data[0].hmap, "records")->u64 == 40, "All records");
+    mvn_arr_free(groups);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_group_seeded_and_frozen(void)
+{
+    // Seeded maps hash field names with their own seed instead of the pre-computed hash
+    mvn_arr_t *rows = make_sales(60, true);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    const mvn_agg_t aggregations[] = {{MVN_AGG_SUM, "amount", "total"}};
+    mvn_arr_t      *plain          = make_sales(60, false);
+    mvn_arr_t      *expected       = mvn_group_by(plain, "customer.tier", aggregations, 1);
+    mvn_arr_t      *seeded         = mvn_group_by(rows, "customer.tier", aggregations, 1);
+    TEST_ASSERT(expected != NULL && seeded != NULL, "Group plain and seeded records");
+    mvn_val_t expected_val = {.type = MVN_VAL_ARRAY, .arr = expected};
+    mvn_val_t seeded_val   = {.type = MVN_VAL_ARRAY, .arr = seeded};
+    TEST_ASSERT(mvn_val_equal(&expected_val, &seeded_val), "Seeded records group the same");
+
+    // Frozen records are looked up through their perfect hash
+    mvn_val_t frozen = mvn_val_arr_take(rows);
+    TEST_ASSERT(mvn_val_freeze(&frozen), "Freeze records");
+    TEST_ASSERT(frozen.arr->data[1].type == MVN_VAL_FROZEN_MAP, "Records are frozen");
+    mvn_arr_t *from_frozen = mvn_group_by(frozen.arr, "customer.tier", aggregations, 1);
+    mvn_val_t  frozen_val  = {.type = MVN_VAL_ARRAY, .arr = from_frozen};
+    TEST_ASSERT(mvn_val_equal(&expected_val, &frozen_val), "Frozen records group the same");
+
+    mvn_arr_free(from_frozen);
+    mvn_val_free(&frozen);
+    mvn_arr_free(seeded);
+    mvn_arr_free(expected);
+    mvn_arr_free(plain);
+    return true;
+}
+
+static bool test_group_parallel_matches(void)
+{
+    size_t     count = MVN_DS_GROUP_PARTITION_ROWS * 6 + 17;
+    mvn_arr_t *rows  = make_sales(count, false);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    // Spread the keys so that every partition sees most groups
+    for (size_t index = 0; index < count; index++) {
+        mvn_hmap_set_cstr(rows->data[index].hmap, "bucket", mvn_val_u32((uint32_t)(index % 997)));
+    }
+    const mvn_agg_t aggregations[] = {
+        {MVN_AGG_COUNT, NULL, "records"},
+        {MVN_AGG_SUM, "price", "price_sum"},
+        {MVN_AGG_MIN, "amount", "smallest"},
+        {MVN_AGG_MAX, "price", "dearest"},
+        {MVN_AGG_AVG, "amount", "amount_avg"},
+        {MVN_AGG_COLLECT, "region", "regions"},
+    };
+    mvn_pool_t *pool = mvn_pool_new(4);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+    mvn_arr_t *serial   = mvn_group_by(rows, "bucket", aggregations, 6);
+    mvn_arr_t *parallel = mvn_group_by_parallel(pool, rows, "bucket", aggregations, 6);
+    TEST_ASSERT(serial != NULL && parallel != NULL, "Group serially and in parallel");
+    TEST_ASSERT(serial->count == 997, "One group per bucket");
+
+    // Prices are multiples of 0.25, so float sums are exact in any order
+    mvn_val_t serial_val   = {.type = MVN_VAL_ARRAY, .arr = serial};
+    mvn_val_t parallel_val = {.type = MVN_VAL_ARRAY, .arr = parallel};
+    TEST_ASSERT(mvn_val_equal(&serial_val, &parallel_val), "Parallel result matches");
+
+    mvn_arr_t *no_pool = mvn_group_by_parallel(NULL, rows, "bucket", aggregations, 6);
+    mvn_val_t  no_pool_val = {.type = MVN_VAL_ARRAY, .arr = no_pool};
+    TEST_ASSERT(mvn_val_equal(&serial_val, &no_pool_val), "NULL pool runs serially");
+
+    mvn_arr_free(no_pool);
+    mvn_arr_free(parallel);
+    mvn_arr_free(serial);
+    mvn_pool_free(pool);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_group_null_param_safety(void)
+{
+    mvn_arr_t *rows = make_sales(5, false);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    const mvn_agg_t valid[] = {{MVN_AGG_COUNT, NULL, "records"}};
+    TEST_ASSERT(mvn_group_by(NULL, "region", valid, 1) == NULL, "NULL records");
+    TEST_ASSERT(mvn_group_by(rows, NULL, valid, 1) == NULL, "NULL key path");
+    TEST_ASSERT(mvn_group_by(rows, "region", NULL, 1) == NULL, "NULL aggregations");
+    const mvn_agg_t no_path[] = {{MVN_AGG_SUM, NULL, "total"}};
+    TEST_ASSERT(mvn_group_by(rows, "region", no_path, 1) == NULL, "Sum needs a path");
+    const mvn_agg_t no_output[] = {{MVN_AGG_COUNT, NULL, NULL}};
+    TEST_ASSERT(mvn_group_by(rows, "region", no_output, 1) == NULL, "Output name required");
+
+    // No aggregations: just the distinct keys
+    mvn_arr_t *keys = mvn_group_by(rows, "region", NULL, 0);
+    TEST_ASSERT(keys != NULL && keys->count == 3, "Distinct keys");
+    TEST_ASSERT(mvn_hmap_count(keys->data[0].hmap) == 1, "Only the key field");
+    mvn_arr_free(keys);
+
+    mvn_arr_t *empty  = mvn_arr_new();
+    mvn_arr_t *groups = mvn_group_by(empty, "region", valid, 1);
+    TEST_ASSERT(groups != NULL && groups->count == 0, "No records, no groups");
+    mvn_arr_free(groups);
+    mvn_arr_free(empty);
+    mvn_arr_free(rows);
+    return true;
+}
+
+// --- Test Runner ---
+
+int run_group_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING GROUP-BY TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_group_aggregations);
+    RUN_TEST(test_group_nested_and_missing);
+    RUN_TEST(test_group_seeded_and_frozen);
+    RUN_TEST(test_group_parallel_matches);
+    RUN_TEST(test_group_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_group_tests(&passed, &failed, &total);
+
+    printf("\n===== GROUP-BY TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_heap_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_arr.h"
+#include "mvn_ds/mvn_ds_heap.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Deterministic pseudo-random numbers with many duplicates
+static int64_t test_number(size_t index)
+{
+    return (int64_t)((index * 2654435761U) % 1000);
+}
+
+// Pops every element and checks they come out in non-decreasing order.
+static bool drains_in_order(mvn_heap_t *heap, size_t expected_count)
+{
+    size_t  popped   = 0;
+    int64_t previous = INT64_MIN;
+    while (mvn_heap_count(heap) > 0) {
+        mvn_val_t value;
+        if (!mvn_heap_pop(heap, &value) || value.i64 < previous) {
+            return false;
+        }
+        previous = value.i64;
+        popped++;
+    }
+    return popped == expected_count;
+}
+
+// Max-heap on I64 that counts its comparisons in the context
+static int compare_descending(const mvn_val_t *a, const mvn_val_t *b, void *context)
+{
+    (*(size_t *)context)++;
+    return (a->i64 < b->i64) - (a->i64 > b->i64);
+}
+
+// --- Test Functions ---
+
+static bool test_heap_push_pop_order(void)
+{
+    const size_t count     = 5000;
+    const size_t arities[] = {2, 3, 4, 8};
+    for (size_t arity = 0; arity < sizeof(arities) / sizeof(arities[0]); arity++) {
+        mvn_heap_t *heap = mvn_heap_new(arities[arity], NULL, NULL);
+        TEST_ASSERT(heap != NULL, "Failed to create heap");
+        for (size_t index = 0; index < count; index++) {
+            TEST_ASSERT(mvn_heap_push(heap, mvn_val_i64(test_number(index)), NULL),
+                        "Push should succeed");
+        }
+        TEST_ASSERT(mvn_heap_count(heap) == count, "Count should match pushes");
+        TEST_ASSERT(mvn_heap_peek(heap)->i64 == 0, "Minimum should be on top");
+        TEST_ASSERT_FMT(
+            drains_in_order(heap, count), "Arity %zu pops out of order", arities[arity]);
+        TEST_ASSERT(mvn_heap_peek(heap) == NULL, "Empty heap has no top");
+        TEST_ASSERT(!mvn_heap_pop(heap, NULL), "Pop from empty heap should fail");
+        mvn_heap_free(heap);
+    }
+
+    // Owned elements are handed to the caller or freed
+    mvn_heap_t *heap = mvn_heap_new(0, NULL, NULL);
+    TEST_ASSERT(heap != NULL && heap->arity == MVN_DS_HEAP_DEFAULT_ARITY, "Default arity");
+    TEST_ASSERT(mvn_heap_push(heap, mvn_val_str("pear"), NULL), "Push should succeed");
+    TEST_ASSERT(mvn_heap_push(heap, mvn_val_str("apple"), NULL), "Push should succeed");
+    TEST_ASSERT(mvn_heap_push(heap, mvn_val_str("fig"), NULL), "Push should succeed");
+    mvn_val_t top;
+    TEST_ASSERT(mvn_heap_pop(heap, &top), "Pop should succeed");
+    TEST_ASSERT(strcmp(top.str->data, "apple") == 0, "Strings pop in order");
+    mvn_val_free(&top);
+    TEST_ASSERT(mvn_heap_pop(heap, NULL), "Pop without out should free the element");
+    mvn_heap_free(heap); // Frees the remaining "pear"
+
+    TEST_ASSERT(mvn_heap_new(1, NULL, NULL) == NULL, "Arity 1 is invalid");
+    return true;
+}
+
+static bool test_heap_from_arr(void)
+{
+    const size_t count = 3000;
+    mvn_arr_t   *array = mvn_arr_new_capacity(count);
+    TEST_ASSERT(array != NULL, "Failed to create array");
+    for (size_t index = 0; index < count; index++) {
+        TEST_ASSERT(mvn_arr_push(array, mvn_val_i64(test_number(index))), "Push should succeed");
+    }
+
+    mvn_heap_t *heap = mvn_heap_from_arr(array, 4, NULL, NULL);
+    TEST_ASSERT(heap != NULL, "Heapify should succeed");
+    TEST_ASSERT(mvn_heap_count(heap) == count, "Heap should hold every element");
+
+    // Element i has handle i
+    for (size_t index = 0; index < count; index += 97) {
+        const mvn_val_t *value = mvn_heap_get(heap, index);
+        TEST_ASSERT_FMT(value != NULL && value->i64 == test_number(index), "Handle %zu", index);
+    }
+    TEST_ASSERT(drains_in_order(heap, count), "Heapified elements should pop in order");
+    mvn_heap_free(heap);
+
+    // Small and empty arrays
+    array = mvn_arr_new();
+    TEST_ASSERT(array != NULL && mvn_arr_push(array, mvn_val_i64(9)), "Failed to build array");
+    heap = mvn_heap_from_arr(array, 2, NULL, NULL);
+    TEST_ASSERT(heap != NULL && mvn_heap_peek(heap)->i64 == 9, "Single element heap");
+    mvn_heap_free(heap);
+    heap = mvn_heap_from_arr(mvn_arr_new(), 0, NULL, NULL);
+    TEST_ASSERT(heap != NULL && mvn_heap_count(heap) == 0, "Empty array gives empty heap");
+    TEST_ASSERT(mvn_heap_push(heap, mvn_val_i64(1), NULL), "Push after heapify should work");
+    mvn_heap_free(heap);
+
+    array = mvn_arr_new();
+    TEST_ASSERT(mvn_heap_from_arr(array, 1, NULL, NULL) == NULL, "Invalid arity should fail");
+    mvn_arr_free(array); // Still owned by the caller
+    return true;
+}
+
+static bool test_heap_handles(void)
+{
+    const size_t count   = 1000;
+    size_t      *handles = (size_t *)malloc(count * sizeof(size_t));
+    mvn_heap_t  *heap    = mvn_heap_new(2, NULL, NULL);
+    TEST_ASSERT(handles != NULL && heap != NULL, "Failed to create heap");
+    for (size_t index = 0; index < count; index++) {
+        TEST_ASSERT(mvn_heap_push(heap, mvn_val_i64((int64_t)index + 1000), &handles[index]),
+                    "Push should succeed");
+    }
+
+    // Decrease-key moves an element to the top, increase-key moves it down
+    TEST_ASSERT(mvn_heap_update(heap, handles[700], mvn_val_i64(-5)), "Update should succeed");
+    TEST_ASSERT(mvn_heap_peek(heap)->i64 == -5, "Decreased key should be on top");
+    TEST_ASSERT(mvn_heap_update(heap, handles[700], mvn_val_i64(5000)), "Update should succeed");
+    TEST_ASSERT(mvn_heap_peek(heap)->i64 == 1000, "Increased key should leave the top");
+    TEST_ASSERT(mvn_heap_get(heap, handles[700])->i64 == 5000, "Handle follows the element");
+
+    // Remove from the middle
+    mvn_val_t removed;
+    TEST_ASSERT(mvn_heap_remove(heap, handles[300], &removed), "Remove should succeed");
+    TEST_ASSERT(removed.i64 == 1300, "Removed element is returned");
+    TEST_ASSERT(mvn_heap_get(heap, handles[300]) == NULL, "Removed handle is not in use");
+    TEST_ASSERT(!mvn_heap_remove(heap, handles[300], NULL), "Second remove should fail");
+    TEST_ASSERT(!mvn_heap_update(heap, handles[300], mvn_val_str("x")), "Update should fail");
+
+    // Popped handles are released; the others still find their elements
+    TEST_ASSERT(mvn_heap_pop(heap, NULL), "Pop should succeed");
+    TEST_ASSERT(mvn_heap_get(heap, handles[0]) == NULL, "Popped handle is not in use");
+    for (size_t index = 1; index < count; index++) {
+        if (index == 300) {
+            continue;
+        }
+        const mvn_val_t *value    = mvn_heap_get(heap, handles[index]);
+        int64_t          expected = index == 700 ? 5000 : (int64_t)index + 1000;
+        TEST_ASSERT_FMT(value != NULL && value->i64 == expected, "Handle of %zu", index);
+    }
+    TEST_ASSERT(mvn_heap_get(heap, (size_t)-1) == NULL, "Unknown handle is not in use");
+    TEST_ASSERT(drains_in_order(heap, count - 2), "Heap order should survive the updates");
+
+    mvn_heap_free(heap);
+    free(handles);
+    return true;
+}
+
+static bool test_heap_comparator_context(void)
+{
+    size_t      comparisons = 0;
+    mvn_heap_t *heap        = mvn_heap_new(3, compare_descending, &comparisons);
+    TEST_ASSERT(heap != NULL, "Failed to create heap");
+    for (int64_t number = 0; number < 100; number++) {
+        TEST_ASSERT(mvn_heap_push(heap, mvn_val_i64(number), NULL), "Push should succeed");
+    }
+    TEST_ASSERT(comparisons > 0, "Comparator should receive the context");
+    int64_t expected = 99;
+    while (mvn_heap_count(heap) > 0) {
+        mvn_val_t value;
+        TEST_ASSERT(mvn_heap_pop(heap, &value), "Pop should succeed");
+        TEST_ASSERT_FMT(value.i64 == expected, "Expected %lld", (long long)expected);
+        expected--;
+    }
+    mvn_heap_free(heap);
+    return true;
+}
+
+static bool test_heap_null_param_safety(void)
+{
+    TEST_ASSERT(!mvn_heap_push(NULL, mvn_val_str("x"), NULL), "Push to NULL fails");
+    TEST_ASSERT(mvn_heap_peek(NULL) == NULL, "Peek NULL returns NULL");
+    TEST_ASSERT(!mvn_heap_pop(NULL, NULL), "Pop NULL fails");
+    TEST_ASSERT(mvn_heap_get(NULL, 0) == NULL, "Get from NULL returns NULL");
+    TEST_ASSERT(!mvn_heap_update(NULL, 0, mvn_val_i32(1)), "Update NULL fails");
+    TEST_ASSERT(!mvn_heap_remove(NULL, 0, NULL), "Remove from NULL fails");
+    TEST_ASSERT(mvn_heap_count(NULL) == 0, "Count of NULL is 0");
+    TEST_ASSERT(mvn_heap_from_arr(NULL, 0, NULL, NULL) == NULL, "Heapify NULL fails");
+
+    mvn_heap_t *heap = mvn_heap_new(0, NULL, NULL);
+    TEST_ASSERT(heap != NULL, "Failed to create heap");
+    TEST_ASSERT(mvn_heap_get(heap, 0) == NULL, "Empty heap has no handles in use");
+    mvn_heap_free(heap);
+    mvn_heap_free(NULL);
+    return true;
+}
+
+/**
+ * \brief           Run all heap tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_heap_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING HEAP TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_heap_push_pop_order);
+    RUN_TEST(test_heap_from_arr);
+    RUN_TEST(test_heap_handles);
+    RUN_TEST(test_heap_comparator_context);
+    RUN_TEST(test_heap_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_heap_tests(&passed, &failed, &total);
+
+    printf("\n===== HEAP TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
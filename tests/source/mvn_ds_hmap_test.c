@@ -880,6 +880,85 @@ static bool test_hmap_keys(void)
     return true;
 }
 
+static bool test_hmap_seeded(void)
+{
+    // "bgpvu" and "b13ea" share the FNV-1a hash 0x8cd9a0ab
+    mvn_str_t *first  = mvn_str_new("bgpvu");
+    mvn_str_t *second = mvn_str_new("b13ea");
+    TEST_ASSERT(first != NULL && second != NULL, "Failed to create colliding keys");
+    TEST_ASSERT(mvn_str_hash(first) == mvn_str_hash(second), "Keys should collide under FNV-1a");
+
+    mvn_hmap_t *plain  = mvn_hmap_new();
+    mvn_hmap_t *seeded = mvn_hmap_new_seeded(0, 42);
+    TEST_ASSERT(plain != NULL && seeded != NULL, "Failed to create maps");
+    TEST_ASSERT(!mvn_hmap_is_seeded(plain), "mvn_hmap_new should not be seeded");
+    TEST_ASSERT(mvn_hmap_is_seeded(seeded), "mvn_hmap_new_seeded should be seeded");
+    TEST_ASSERT(!mvn_hmap_is_seeded(NULL), "NULL map should not be seeded");
+    TEST_ASSERT(mvn_hmap_hash_key(plain, first) == mvn_str_hash(first),
+                "Unseeded maps should hash with FNV-1a");
+    TEST_ASSERT(mvn_hmap_hash_key(seeded, first) != mvn_hmap_hash_key(seeded, second),
+                "Seeded map should separate the FNV-1a collision");
+
+    // Same operations as an unseeded map, starting from zero capacity
+    char key[32];
+    for (int index = 0; index < 200; index++) {
+        snprintf(key, sizeof(key), "key_%d", index);
+        TEST_ASSERT(mvn_hmap_set_cstr(seeded, key, mvn_val_i32(index)), "Seeded set failed");
+    }
+    TEST_ASSERT(mvn_hmap_set(seeded, first, mvn_val_i32(-1)), "Seeded set (mvn_str_t) failed");
+    TEST_ASSERT(mvn_hmap_count(seeded) == 201, "Seeded map count mismatch");
+    for (int index = 0; index < 200; index++) {
+        snprintf(key, sizeof(key), "key_%d", index);
+        mvn_val_t *value = mvn_hmap_cstr(seeded, key);
+        TEST_ASSERT_FMT(value != NULL && value->i32 == index, "Seeded lookup of %s failed", key);
+    }
+    TEST_ASSERT(mvn_hmap_contains_key_cstr(seeded, "bgpvu"), "Seeded map lost mvn_str_t key");
+    TEST_ASSERT(!mvn_hmap_contains_key(seeded, second), "Colliding key should be absent");
+    TEST_ASSERT(mvn_hmap_delete_cstr(seeded, "key_7"), "Seeded delete failed");
+    TEST_ASSERT(mvn_hmap_cstr(seeded, "key_7") == NULL, "Deleted key still present");
+
+    // Lookups with a pre-computed hash
+    TEST_ASSERT(mvn_hmap_set_cstr(plain, "bgpvu", mvn_val_i32(5)), "Plain set failed");
+    TEST_ASSERT(mvn_hmap_get_hashed(plain, first, mvn_str_hash(first))->i32 == 5,
+                "FNV-1a hash should find the key in an unseeded map");
+    TEST_ASSERT(mvn_hmap_get_hashed(seeded, first, mvn_hmap_hash_key(seeded, first))->i32 == -1,
+                "Seeded hash should find the key in a seeded map");
+    TEST_ASSERT(mvn_hmap_get_hashed(plain, second, mvn_str_hash(second)) == NULL,
+                "Colliding hash should not match a different key");
+    TEST_ASSERT(mvn_hmap_get_hashed(NULL, first, 0) == NULL, "NULL map get_hashed");
+
+    // Deep copies keep the seed and therefore the bucket layout
+    mvn_val_t original = {.type = MVN_VAL_HASHMAP, .hmap = seeded};
+    mvn_val_t copy     = mvn_val_deep_copy(&original);
+    TEST_ASSERT(copy.type == MVN_VAL_HASHMAP && mvn_hmap_is_seeded(copy.hmap),
+                "Deep copy of a seeded map should be seeded");
+    TEST_ASSERT(mvn_hmap_hash_key(copy.hmap, second) == mvn_hmap_hash_key(seeded, second),
+                "Deep copy should use the same seed");
+    TEST_ASSERT(mvn_val_equal(&original, &copy), "Deep copy of a seeded map differs");
+    mvn_val_free(&copy);
+
+    mvn_str_free(second);
+    mvn_hmap_free(plain);
+    mvn_hmap_free(seeded);
+    return true;
+}
+
+static bool test_hmap_randomized(void)
+{
+    mvn_hmap_t *first  = mvn_hmap_new_randomized(16);
+    mvn_hmap_t *second = mvn_hmap_new_randomized(16);
+    TEST_ASSERT(first != NULL && second != NULL, "Failed to create randomized maps");
+    TEST_ASSERT(mvn_hmap_is_seeded(first) && mvn_hmap_is_seeded(second),
+                "Randomized maps should be seeded");
+    TEST_ASSERT(mvn_hmap_capacity(first) == 16, "Randomized map ignored capacity");
+    TEST_ASSERT(first->seed != second->seed, "Each randomized map should get its own seed");
+    TEST_ASSERT(mvn_hmap_set_cstr(first, "alpha", mvn_val_i32(1)), "Randomized set failed");
+    TEST_ASSERT(mvn_hmap_cstr(first, "alpha") != NULL, "Randomized lookup failed");
+    mvn_hmap_free(first);
+    mvn_hmap_free(second);
+    return true;
+}
+
 /**
  * \brief           Run all hmap tests
  * \param[out]      passed_tests: Pointer to passed tests counter
@@ -914,6 +993,8 @@ int run_hmap_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_hmap_keys);   // New test
     RUN_TEST(test_hmap_values); // New test
     RUN_TEST(test_hmap_size);   // New test
+    RUN_TEST(test_hmap_seeded);
+    RUN_TEST(test_hmap_randomized);
 
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
     (*total_tests) += tests_run;
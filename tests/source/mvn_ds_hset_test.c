@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_hset_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_hset.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+static mvn_hset_t *build_range_set(int64_t begin, int64_t end)
+{
+    mvn_hset_t *hset = mvn_hset_new();
+    for (int64_t number = begin; hset != NULL && number < end; number++) {
+        if (!mvn_hset_insert(hset, mvn_val_i64(number))) {
+            mvn_hset_free(hset);
+            return NULL;
+        }
+    }
+    return hset;
+}
+
+static bool set_has_i64(const mvn_hset_t *hset, int64_t number)
+{
+    mvn_val_t value = mvn_val_i64(number);
+    return mvn_hset_contains(hset, &value);
+}
+
+// --- Test Functions ---
+
+static bool test_hset_insert_contains_remove(void)
+{
+    const size_t count = 10000;
+    mvn_hset_t  *hset  = build_range_set(0, (int64_t)count);
+    TEST_ASSERT(hset != NULL, "Failed to build set");
+    TEST_ASSERT(mvn_hset_count(hset) == count, "Count should match inserted elements");
+
+    // Duplicates leave the set unchanged
+    TEST_ASSERT(mvn_hset_insert(hset, mvn_val_i64(5)), "Duplicate insert should succeed");
+    TEST_ASSERT(mvn_hset_count(hset) == count, "Duplicate should not be added");
+
+    for (size_t number = 0; number < count; number++) {
+        TEST_ASSERT_FMT(set_has_i64(hset, (int64_t)number), "Missing %zu", number);
+    }
+    TEST_ASSERT(!set_has_i64(hset, -1) && !set_has_i64(hset, (int64_t)count),
+                "Absent elements should not be found");
+
+    // Type is part of the identity, as in mvn_val_equal
+    mvn_val_t as_i32 = mvn_val_i32(5);
+    TEST_ASSERT(!mvn_hset_contains(hset, &as_i32), "I32 5 is not I64 5");
+
+    // Remove every other element; backward shifting must keep the rest reachable
+    for (size_t number = 0; number < count; number += 2) {
+        mvn_val_t value = mvn_val_i64((int64_t)number);
+        TEST_ASSERT_FMT(mvn_hset_remove(hset, &value), "Failed to remove %zu", number);
+    }
+    TEST_ASSERT(mvn_hset_count(hset) == count / 2, "Half should remain");
+    for (size_t number = 0; number < count; number++) {
+        TEST_ASSERT_FMT(set_has_i64(hset, (int64_t)number) == (number % 2 == 1),
+                        "Wrong membership for %zu after removal",
+                        number);
+    }
+    mvn_val_t absent = mvn_val_i64(0);
+    TEST_ASSERT(!mvn_hset_remove(hset, &absent), "Removing an absent element should fail");
+
+    mvn_hset_clear(hset);
+    TEST_ASSERT(mvn_hset_count(hset) == 0 && !set_has_i64(hset, 1), "Clear should empty");
+    TEST_ASSERT(mvn_hset_insert(hset, mvn_val_i64(1)) && set_has_i64(hset, 1),
+                "Set should be usable after clear");
+    mvn_hset_free(hset);
+    return true;
+}
+
+static bool test_hset_structural_elements(void)
+{
+    mvn_hset_t *hset = mvn_hset_new_capacity(4);
+    TEST_ASSERT(hset != NULL, "Failed to create set");
+
+    // Strings, arrays and maps are found by content, not by address
+    mvn_hset_insert(hset, mvn_val_str("alpha"));
+    mvn_val_t array = mvn_val_arr();
+    mvn_arr_push(array.arr, mvn_val_i32(1));
+    mvn_arr_push(array.arr, mvn_val_str("two"));
+    mvn_hset_insert(hset, array);
+
+    mvn_hmap_t *map_one = mvn_hmap_new();
+    mvn_hmap_set_cstr(map_one, "x", mvn_val_i32(1));
+    mvn_hmap_set_cstr(map_one, "y", mvn_val_i32(2));
+    mvn_hset_insert(hset, mvn_val_hmap_take(map_one));
+
+    // Same content, different insertion order and capacity
+    mvn_hmap_t *map_two = mvn_hmap_new_capacity(64);
+    mvn_hmap_set_cstr(map_two, "y", mvn_val_i32(2));
+    mvn_hmap_set_cstr(map_two, "x", mvn_val_i32(1));
+    mvn_val_t map_probe = mvn_val_hmap_take(map_two);
+    TEST_ASSERT(mvn_hset_contains(hset, &map_probe), "Equal map should be found");
+    mvn_hmap_set_cstr(map_probe.hmap, "x", mvn_val_i32(3));
+    TEST_ASSERT(!mvn_hset_contains(hset, &map_probe), "Changed map should not be found");
+    mvn_val_free(&map_probe);
+
+    mvn_val_t string_probe = mvn_val_str("alpha");
+    mvn_val_t array_probe  = mvn_val_arr();
+    mvn_arr_push(array_probe.arr, mvn_val_i32(1));
+    mvn_arr_push(array_probe.arr, mvn_val_str("two"));
+    TEST_ASSERT(mvn_hset_contains(hset, &string_probe), "Equal string should be found");
+    TEST_ASSERT(mvn_hset_contains(hset, &array_probe), "Equal array should be found");
+
+    // Element order matters for arrays
+    mvn_val_t reversed = mvn_val_arr();
+    mvn_arr_push(reversed.arr, mvn_val_str("two"));
+    mvn_arr_push(reversed.arr, mvn_val_i32(1));
+    TEST_ASSERT(!mvn_hset_contains(hset, &reversed), "Reversed array is a different element");
+
+    TEST_ASSERT(mvn_hset_insert(hset, mvn_val_deep_copy(&array_probe)) &&
+                    mvn_hset_count(hset) == 3,
+                "Equal array should not be added twice");
+    TEST_ASSERT(mvn_hset_remove(hset, &string_probe) && mvn_hset_count(hset) == 2,
+                "String should be removed by content");
+
+    // Nested sets hash independently of their insertion order
+    mvn_hset_t *inner_one = build_range_set(0, 100);
+    mvn_hset_t *inner_two = mvn_hset_new();
+    for (int64_t number = 99; number >= 0; number--) {
+        mvn_hset_insert(inner_two, mvn_val_i64(number));
+    }
+    mvn_val_t set_one = mvn_val_hset_take(inner_one);
+    mvn_val_t set_two = mvn_val_hset_take(inner_two);
+    TEST_ASSERT(mvn_val_hash(&set_one) == mvn_val_hash(&set_two), "Equal sets hash equally");
+    mvn_hset_insert(hset, set_one);
+    TEST_ASSERT(mvn_hset_contains(hset, &set_two), "Equal nested set should be found");
+
+    mvn_val_t zero          = mvn_val_f64(0.0);
+    mvn_val_t negative_zero = mvn_val_f64(-0.0);
+    TEST_ASSERT(mvn_val_hash(&zero) == mvn_val_hash(&negative_zero), "-0.0 hashes like 0.0");
+
+    mvn_val_free(&set_two);
+    mvn_val_free(&reversed);
+    mvn_val_free(&array_probe);
+    mvn_val_free(&string_probe);
+    mvn_hset_free(hset);
+    return true;
+}
+
+static bool test_hset_algebra(void)
+{
+    mvn_hset_t *small = build_range_set(0, 10);   // 0..9
+    mvn_hset_t *large = build_range_set(5, 1005); // 5..1004
+    mvn_hset_t *empty = mvn_hset_new();
+    TEST_ASSERT(small != NULL && large != NULL && empty != NULL, "Failed to build sets");
+
+    mvn_hset_t *both = mvn_hset_union(small, large);
+    TEST_ASSERT(both != NULL && mvn_hset_count(both) == 1005, "Union should hold 0..1004");
+    TEST_ASSERT(set_has_i64(both, 0) && set_has_i64(both, 1004), "Union bounds");
+
+    mvn_hset_t *common = mvn_hset_intersection(large, small);
+    TEST_ASSERT(common != NULL && mvn_hset_count(common) == 5, "Intersection should be 5..9");
+    for (int64_t number = 5; number < 10; number++) {
+        TEST_ASSERT(set_has_i64(common, number), "Intersection element missing");
+    }
+
+    mvn_hset_t *small_only = mvn_hset_difference(small, large); // Iterates small
+    TEST_ASSERT(small_only != NULL && mvn_hset_count(small_only) == 5, "small - large = 0..4");
+    TEST_ASSERT(set_has_i64(small_only, 0) && !set_has_i64(small_only, 5), "Difference bounds");
+
+    mvn_hset_t *large_only = mvn_hset_difference(large, small); // Copies large, removes small
+    TEST_ASSERT(large_only != NULL && mvn_hset_count(large_only) == 995,
+                "large - small = 10..1004");
+    for (int64_t number = 0; number < 1010; number++) {
+        TEST_ASSERT_FMT(set_has_i64(large_only, number) == (number >= 10 && number < 1005),
+                        "Wrong membership for %lld in large - small",
+                        (long long)number);
+    }
+
+    mvn_hset_t *with_empty = mvn_hset_intersection(small, empty);
+    TEST_ASSERT(with_empty != NULL && mvn_hset_count(with_empty) == 0, "Intersection with {}");
+    mvn_hset_t *union_empty = mvn_hset_union(empty, small);
+    TEST_ASSERT(union_empty != NULL && mvn_hset_equal(union_empty, small), "Union with {}");
+
+    // Results are independent deep copies
+    mvn_val_t owner = mvn_val_hset_take(build_range_set(0, 0));
+    mvn_hset_insert(owner.hset, mvn_val_str("shared"));
+    mvn_hset_t *copy = mvn_hset_union(owner.hset, empty);
+    mvn_val_free(&owner);
+    mvn_val_t shared = mvn_val_str("shared");
+    TEST_ASSERT(copy != NULL && mvn_hset_contains(copy, &shared), "Union should copy elements");
+    mvn_val_free(&shared);
+
+    mvn_hset_free(copy);
+    mvn_hset_free(union_empty);
+    mvn_hset_free(with_empty);
+    mvn_hset_free(large_only);
+    mvn_hset_free(small_only);
+    mvn_hset_free(common);
+    mvn_hset_free(both);
+    mvn_hset_free(empty);
+    mvn_hset_free(large);
+    mvn_hset_free(small);
+    return true;
+}
+
+static bool test_hset_as_value(void)
+{
+    mvn_val_t set = mvn_val_hset();
+    TEST_ASSERT(set.type == MVN_VAL_HASHSET, "Value should be a hash set");
+    TEST_ASSERT(strcmp(mvn_val_type_to_str(set.type), "HASHSET") == 0, "Type string");
+    for (int32_t number = 0; number < 50; number++) {
+        mvn_hset_insert(set.hset, mvn_val_i32(number));
+    }
+    mvn_hset_insert(set.hset, mvn_val_str("text"));
+
+    mvn_val_t copy = mvn_val_deep_copy(&set);
+    TEST_ASSERT(copy.type == MVN_VAL_HASHSET && copy.hset != set.hset, "Deep copy allocates");
+    TEST_ASSERT(mvn_val_equal(&set, &copy), "Deep copy should be equal");
+    TEST_ASSERT(mvn_val_hash(&set) == mvn_val_hash(&copy), "Deep copy should hash equally");
+    TEST_ASSERT(mvn_val_compare(&set, &set) == 0, "Compare with itself should be 0");
+
+    mvn_val_t element = mvn_val_i32(7);
+    mvn_hset_remove(copy.hset, &element);
+    TEST_ASSERT(!mvn_val_equal(&set, &copy), "Sets differ after removal");
+    mvn_hset_insert(copy.hset, mvn_val_i32(100));
+    TEST_ASSERT(!mvn_val_equal(&set, &copy), "Same count but different elements");
+
+    // Iteration visits every element once
+    size_t           cursor = 0;
+    size_t           seen   = 0;
+    const mvn_val_t *value  = NULL;
+    while ((value = mvn_hset_next(set.hset, &cursor)) != NULL) {
+        TEST_ASSERT(mvn_hset_contains(set.hset, value), "Iterated element should be present");
+        seen++;
+    }
+    TEST_ASSERT(seen == 51, "Iteration should visit all 51 elements");
+
+    mvn_arr_t *array = mvn_hset_to_arr(set.hset);
+    TEST_ASSERT(array != NULL && array->count == 51, "to_arr should copy all elements");
+    mvn_arr_free(array);
+
+    // Sets nest inside maps and keep working after freeze
+    mvn_val_t root = mvn_val_hmap();
+    mvn_hmap_set_cstr(root.hmap, "tags", copy);
+    TEST_ASSERT(mvn_val_freeze(&root) && root.type == MVN_VAL_FROZEN_MAP, "Freeze failed");
+    const mvn_val_t *tags = mvn_fmap_get_cstr(root.fmap, "tags");
+    TEST_ASSERT(tags != NULL && tags->type == MVN_VAL_HASHSET, "Sets are not converted");
+    TEST_ASSERT(mvn_hset_contains(tags->hset, &(mvn_val_t){.type = MVN_VAL_I32, .i32 = 100}),
+                "Set lookups work after freeze");
+    TEST_ASSERT(mvn_val_memory_usage(&set) >
+                    sizeof(mvn_hset_t) + set.hset->capacity * sizeof(mvn_hset_slot_t),
+                "Memory usage should include the string element");
+
+    mvn_val_free(&root);
+    mvn_val_free(&set);
+    TEST_ASSERT(set.type == MVN_VAL_NULL, "Freed value should be NULL");
+    return true;
+}
+
+static bool test_hset_null_param_safety(void)
+{
+    mvn_hset_t *hset  = mvn_hset_new();
+    mvn_val_t   value = mvn_val_i32(1);
+    TEST_ASSERT(!mvn_hset_insert(NULL, mvn_val_str("freed")), "Insert into NULL should fail");
+    TEST_ASSERT(!mvn_hset_contains(NULL, &value), "Contains on NULL should be false");
+    TEST_ASSERT(!mvn_hset_contains(hset, NULL), "Contains of NULL should be false");
+    TEST_ASSERT(!mvn_hset_contains(hset, &value), "Empty set contains nothing");
+    TEST_ASSERT(!mvn_hset_remove(hset, &value), "Remove from empty set should fail");
+    TEST_ASSERT(!mvn_hset_remove(NULL, &value), "Remove from NULL should fail");
+    TEST_ASSERT(mvn_hset_count(NULL) == 0, "Count of NULL should be 0");
+    TEST_ASSERT(mvn_hset_copy(NULL) == NULL, "Copy of NULL should be NULL");
+    TEST_ASSERT(mvn_hset_union(hset, NULL) == NULL, "Union with NULL should be NULL");
+    TEST_ASSERT(mvn_hset_intersection(NULL, hset) == NULL, "Intersection with NULL");
+    TEST_ASSERT(mvn_hset_difference(NULL, NULL) == NULL, "Difference of NULL");
+    TEST_ASSERT(mvn_hset_to_arr(NULL) == NULL, "to_arr of NULL should be NULL");
+    TEST_ASSERT(mvn_hset_equal(NULL, NULL) && !mvn_hset_equal(hset, NULL), "Equal with NULL");
+    size_t cursor = 0;
+    TEST_ASSERT(mvn_hset_next(hset, &cursor) == NULL, "Empty set iterates nothing");
+    TEST_ASSERT(mvn_val_hash(NULL) == 0, "Hash of NULL should be 0");
+    mvn_hset_clear(NULL);
+    mvn_hset_free(NULL); // Should not crash
+    mvn_hset_free(hset);
+    return true;
+}
+
+// --- Test Runner ---
+
+/**
+ * \brief           Run all hash set tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_hset_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING HASH SET TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_hset_insert_contains_remove);
+    RUN_TEST(test_hset_structural_elements);
+    RUN_TEST(test_hset_algebra);
+    RUN_TEST(test_hset_as_value);
+    RUN_TEST(test_hset_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_hset_tests(&passed, &failed, &total);
+
+    printf("\n===== HASH SET TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
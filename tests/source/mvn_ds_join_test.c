@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_join_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_arr.h"
+#include "mvn_ds/mvn_ds_hmap.h"
+#include "mvn_ds/mvn_ds_join.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Builds records {id: u64 (row), name: string, key_field: i64 (row % modulo)}. Every fifth
+// record has no key and every seventh a null key, so neither of those can match.
+static mvn_arr_t *make_records(size_t count, const char *key_field, size_t modulo)
+{
+    mvn_arr_t *rows = mvn_arr_new();
+    for (size_t index = 0; rows != NULL && index < count; index++) {
+        mvn_hmap_t *record = mvn_hmap_new();
+        if (record == NULL) {
+            mvn_arr_free(rows);
+            return NULL;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%s%zu", key_field, index);
+        mvn_hmap_set_cstr(record, "id", mvn_val_u64(index));
+        mvn_hmap_set_cstr(record, "name", mvn_val_str(name));
+        if (index % 5 != 0) {
+            mvn_hmap_set_cstr(record,
+                              key_field,
+                              index % 7 == 0 ? mvn_val_null()
+                                             : mvn_val_i64((int64_t)(index % modulo)));
+        }
+        mvn_arr_push(rows, mvn_val_hmap_take(record));
+    }
+    return rows;
+}
+
+// Returns the key of a record made by make_records, or -1 if it has none.
+static int64_t record_key(size_t index, size_t modulo)
+{
+    return index % 5 != 0 && index % 7 != 0 ? (int64_t)(index % modulo) : -1;
+}
+
+// Checks a join of make_records arrays against a nested-loop join of the same records.
+static bool check_join(size_t left_count, size_t right_count, mvn_join_mode_t mode)
+{
+    mvn_arr_t *left   = make_records(left_count, "lk", 13);
+    mvn_arr_t *right  = make_records(right_count, "rk", 17);
+    mvn_arr_t *joined = mvn_hash_join(left, right, "lk", "rk", mode);
+    TEST_ASSERT(left != NULL && right != NULL && joined != NULL, "Join records");
+
+    size_t next = 0;
+    for (size_t row = 0; row < left_count; row++) {
+        int64_t key     = record_key(row, 13);
+        size_t  matches = 0;
+        for (size_t other = 0; other < right_count; other++) {
+            if (key < 0 || record_key(other, 17) != key) {
+                continue;
+            }
+            TEST_ASSERT_FMT(next < joined->count, "Result for left %zu", row);
+            const mvn_hmap_t *result = joined->data[next++].hmap;
+            TEST_ASSERT_FMT(mvn_hmap_cstr(result, "id")->u64 == row, "Left id of %zu", row);
+            TEST_ASSERT_FMT(mvn_hmap_cstr(result, "rk")->i64 == key, "Right key of %zu", row);
+            char name[32];
+            snprintf(name, sizeof(name), "lk%zu", row);
+            TEST_ASSERT_FMT(strcmp(mvn_hmap_cstr(result, "name")->str->data, name) == 0,
+                            "Left fields win over right fields of the same name (%zu)",
+                            row);
+            TEST_ASSERT(mvn_hmap_count(result) == 4, "Fields of both records");
+            matches++;
+        }
+        if (matches == 0 && mode == MVN_JOIN_LEFT) {
+            TEST_ASSERT_FMT(next < joined->count, "Unmatched left %zu", row);
+            const mvn_hmap_t *result = joined->data[next++].hmap;
+            TEST_ASSERT_FMT(mvn_hmap_cstr(result, "id")->u64 == row, "Left id of %zu", row);
+            TEST_ASSERT(!mvn_hmap_contains_key_cstr(result, "rk"), "No right fields");
+        }
+    }
+    TEST_ASSERT_FMT(next == joined->count, "%zu results, expected %zu", joined->count, next);
+    mvn_arr_free(joined);
+    mvn_arr_free(right);
+    mvn_arr_free(left);
+    return true;
+}
+
+// --- Test Functions ---
+
+static bool test_index_build(void)
+{
+    mvn_arr_t *rows = make_records(100, "key", 6);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    mvn_index_t *index = mvn_index_build(rows, "key");
+    TEST_ASSERT(index != NULL, "Build index");
+    TEST_ASSERT(mvn_index_key_count(index) == 6, "One entry per distinct key");
+
+    size_t indexed = 0;
+    for (int64_t key = 0; key < 6; key++) {
+        mvn_val_t     probe       = mvn_val_i64(key);
+        size_t        count       = 0;
+        const size_t *rows_of_key = mvn_index_rows(index, &probe, &count);
+        TEST_ASSERT_FMT(rows_of_key != NULL && count > 0, "Rows of key %lld", (long long)key);
+        for (size_t item = 0; item < count; item++) {
+            TEST_ASSERT(record_key(rows_of_key[item], 6) == key, "Row holds the key");
+            TEST_ASSERT(item == 0 || rows_of_key[item - 1] < rows_of_key[item], "Ascending rows");
+        }
+        indexed += count;
+    }
+    size_t expected = 0;
+    for (size_t row = 0; row < 100; row++) {
+        expected += record_key(row, 6) >= 0 ? 1 : 0;
+    }
+    TEST_ASSERT(indexed == expected && index->row_count == expected, "Keyless rows skipped");
+
+    size_t    count  = 1;
+    mvn_val_t absent = mvn_val_i64(6);
+    mvn_val_t null   = mvn_val_null();
+    mvn_val_t other  = mvn_val_str("0");
+    TEST_ASSERT(mvn_index_rows(index, &absent, &count) == NULL && count == 0, "Absent key");
+    TEST_ASSERT(mvn_index_rows(index, &null, &count) == NULL, "Null is never indexed");
+    TEST_ASSERT(mvn_index_rows(index, &other, &count) == NULL, "Keys compare by type too");
+    mvn_val_free(&other);
+    mvn_index_free(index);
+
+    // Enough distinct keys to grow the table several times
+    index = mvn_index_build(rows, "id");
+    TEST_ASSERT(index != NULL && mvn_index_key_count(index) == 100, "Unique ids");
+    mvn_val_t id = mvn_val_u64(73);
+    TEST_ASSERT(mvn_index_rows(index, &id, &count)[0] == 73 && count == 1, "Row of id");
+    mvn_index_free(index);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_join_inner(void)
+{
+    // Left smaller, right smaller, and equal sizes take different build sides
+    TEST_ASSERT(check_join(60, 250, MVN_JOIN_INNER), "Index built on the left records");
+    TEST_ASSERT(check_join(250, 60, MVN_JOIN_INNER), "Index built on the right records");
+    TEST_ASSERT(check_join(150, 150, MVN_JOIN_INNER), "Same sizes");
+    TEST_ASSERT(check_join(0, 40, MVN_JOIN_INNER), "No left records");
+    TEST_ASSERT(check_join(40, 0, MVN_JOIN_INNER), "No right records");
+    return true;
+}
+
+static bool test_join_left(void)
+{
+    TEST_ASSERT(check_join(60, 250, MVN_JOIN_LEFT), "Index built on the left records");
+    TEST_ASSERT(check_join(250, 60, MVN_JOIN_LEFT), "Index built on the right records");
+    TEST_ASSERT(check_join(40, 0, MVN_JOIN_LEFT), "Every left record kept alone");
+    return true;
+}
+
+static bool test_join_nested_and_frozen(void)
+{
+    // Users keyed by a nested account id, orders keyed by a top-level user id
+    mvn_arr_t *users  = mvn_arr_new();
+    mvn_arr_t *orders = mvn_arr_new();
+    TEST_ASSERT(users != NULL && orders != NULL, "Failed to create arrays");
+    for (size_t index = 0; index < 4; index++) {
+        mvn_val_t user    = mvn_val_hmap();
+        mvn_val_t account = mvn_val_hmap();
+        mvn_hmap_set_cstr(account.hmap, "id", mvn_val_u32((uint32_t)index));
+        mvn_hmap_set_cstr(user.hmap, "account", account);
+        mvn_hmap_set_cstr(user.hmap, "user", mvn_val_u32((uint32_t)(index * 10)));
+        mvn_arr_push(users, user);
+    }
+    for (size_t index = 0; index < 9; index++) {
+        mvn_val_t order = mvn_val_hmap();
+        mvn_hmap_set_cstr(order.hmap, "user", mvn_val_u32((uint32_t)(index % 3)));
+        mvn_hmap_set_cstr(order.hmap, "total", mvn_val_f64((double)index));
+        mvn_arr_push(orders, order);
+    }
+
+    mvn_val_t frozen = mvn_val_arr_take(orders);
+    TEST_ASSERT(mvn_val_freeze(&frozen), "Freeze orders");
+    mvn_arr_t *joined = mvn_hash_join(users, frozen.arr, "account.id", "user", MVN_JOIN_LEFT);
+    TEST_ASSERT(joined != NULL && joined->count == 10, "Three orders for three users, one alone");
+    for (size_t index = 0; index < 9; index++) {
+        const mvn_hmap_t *result = joined->data[index].hmap;
+        TEST_ASSERT(mvn_hmap_cstr(result, "account")->type == MVN_VAL_HASHMAP, "Nested copy");
+        TEST_ASSERT(mvn_hmap_cstr(result, "user")->u32 == (uint32_t)(index / 3) * 10,
+                    "The left record's field of a shared name is kept");
+        TEST_ASSERT(mvn_hmap_cstr(result, "total")->f64 == (double)(index / 3 + (index % 3) * 3),
+                    "Orders of one user in order");
+    }
+    TEST_ASSERT(!mvn_hmap_contains_key_cstr(joined->data[9].hmap, "total"), "User without orders");
+    mvn_arr_free(joined);
+
+    joined = mvn_hash_join(frozen.arr, users, "user", "account.id", MVN_JOIN_INNER);
+    TEST_ASSERT(joined != NULL && joined->count == 9, "Frozen records on the left");
+    TEST_ASSERT(mvn_hmap_cstr(joined->data[4].hmap, "user")->u32 == 1, "Left wins again");
+    mvn_arr_free(joined);
+
+    mvn_val_free(&frozen);
+    mvn_arr_free(users);
+    return true;
+}
+
+static bool test_join_null_param_safety(void)
+{
+    mvn_arr_t *rows = make_records(5, "key", 2);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    TEST_ASSERT(mvn_index_build(NULL, "key") == NULL, "NULL records");
+    TEST_ASSERT(mvn_index_build(rows, NULL) == NULL, "NULL key path");
+    mvn_index_free(NULL);
+    TEST_ASSERT(mvn_index_key_count(NULL) == 0, "NULL index has no keys");
+    size_t    count = 1;
+    mvn_val_t key   = mvn_val_i64(1);
+    TEST_ASSERT(mvn_index_rows(NULL, &key, &count) == NULL && count == 0, "NULL index");
+    TEST_ASSERT(mvn_index_rows(NULL, &key, NULL) == NULL, "NULL row count");
+
+    TEST_ASSERT(mvn_hash_join(NULL, rows, "key", "key", MVN_JOIN_INNER) == NULL, "NULL left");
+    TEST_ASSERT(mvn_hash_join(rows, NULL, "key", "key", MVN_JOIN_INNER) == NULL, "NULL right");
+    TEST_ASSERT(mvn_hash_join(rows, rows, NULL, "key", MVN_JOIN_INNER) == NULL, "NULL left key");
+    TEST_ASSERT(mvn_hash_join(rows, rows, "key", NULL, MVN_JOIN_LEFT) == NULL, "NULL right key");
+    TEST_ASSERT(mvn_hash_join(rows, rows, "key", "key", (mvn_join_mode_t)7) == NULL, "Bad mode");
+
+    // A missing path matches nothing
+    mvn_arr_t *joined = mvn_hash_join(rows, rows, "key", "absent", MVN_JOIN_INNER);
+    TEST_ASSERT(joined != NULL && joined->count == 0, "No matches");
+    mvn_arr_free(joined);
+    mvn_arr_free(rows);
+    return true;
+}
+
+// --- Test Runner ---
+
+int run_join_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING HASH JOIN TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_index_build);
+    RUN_TEST(test_join_inner);
+    RUN_TEST(test_join_left);
+    RUN_TEST(test_join_nested_and_frozen);
+    RUN_TEST(test_join_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_join_tests(&passed, &failed, &total);
+
+    printf("\n===== HASH JOIN TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_lru_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_lru.h"
+#include "mvn_ds/mvn_ds_str.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Records evicted keys and takes ownership of evicted values
+typedef struct {
+    char      keys[16][16];
+    mvn_val_t values[16];
+    size_t    count;
+} evictions_t;
+
+static void record_eviction(const mvn_str_t *key, mvn_val_t *value, void *context)
+{
+    evictions_t *evictions = (evictions_t *)context;
+    if (evictions->count < 16) {
+        snprintf(evictions->keys[evictions->count], 16, "%s", key->data);
+        evictions->values[evictions->count] = *value;
+        *value                              = mvn_val_null(); // Moved out of the cache
+        evictions->count++;
+    }
+}
+
+// Returns the number of keys among the given ones that are in the cache.
+static size_t count_present(const mvn_lru_t *lru, const char *const *keys, size_t key_count)
+{
+    size_t present = 0;
+    for (size_t index = 0; index < key_count; index++) {
+        present += mvn_lru_peek_cstr(lru, keys[index]) != NULL ? 1 : 0;
+    }
+    return present;
+}
+
+// --- Test Functions ---
+
+static bool test_lru_count_capacity(void)
+{
+    mvn_lru_t *lru = mvn_lru_new(3, MVN_LRU_LIMIT_COUNT, MVN_LRU_POLICY_LRU);
+    TEST_ASSERT(lru != NULL, "Failed to create cache");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "a", mvn_val_i32(1)), "Put a");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "b", mvn_val_i32(2)), "Put b");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "c", mvn_val_i32(3)), "Put c");
+    TEST_ASSERT(mvn_lru_count(lru) == 3, "Three entries");
+
+    // A hit protects a; peek does not protect b
+    TEST_ASSERT(mvn_lru_get_cstr(lru, "a")->i32 == 1, "Get a");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "b")->i32 == 2, "Peek b");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "d", mvn_val_i32(4)), "Put d");
+    TEST_ASSERT(mvn_lru_count(lru) == 3, "Count stays at capacity");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "b") == NULL, "Least recently used b is evicted");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "a") != NULL, "Recently used a stays");
+
+    // Replacing a value marks the entry as used without changing the count
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "c", mvn_val_str("three")), "Replace c");
+    TEST_ASSERT(mvn_lru_count(lru) == 3, "Replacement keeps the count");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "e", mvn_val_i32(5)), "Put e");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "a") == NULL, "a is now the oldest and evicted");
+    TEST_ASSERT(strcmp(mvn_lru_get_cstr(lru, "c")->str->data, "three") == 0, "c replaced");
+
+    mvn_str_t *key = mvn_str_new("d");
+    TEST_ASSERT(key != NULL && mvn_lru_get(lru, key)->i32 == 4, "Get with mvn_str_t key");
+    TEST_ASSERT(mvn_lru_remove(lru, key), "Remove d");
+    TEST_ASSERT(!mvn_lru_remove(lru, key), "Second remove fails");
+    TEST_ASSERT(mvn_lru_count(lru) == 2, "Two entries left");
+    mvn_str_free(key);
+    TEST_ASSERT(mvn_lru_bytes(lru) == 0, "Count-limited caches charge no bytes");
+
+    // Remove every entry, then reuse the empty cache
+    TEST_ASSERT(mvn_lru_remove_cstr(lru, "c") && mvn_lru_remove_cstr(lru, "e"), "Remove all");
+    TEST_ASSERT(mvn_lru_count(lru) == 0 && lru->head == NULL, "Cache is empty");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "f", mvn_val_i32(6)), "Put into emptied cache");
+    mvn_lru_free(lru);
+    return true;
+}
+
+static bool test_lru_matches_reference(void)
+{
+    // Compare against a recency-ordered array: index 0 is the least recently used key
+    const size_t capacity  = 50;
+    const size_t key_space = 120;
+    size_t       order[50];
+    size_t       order_count = 0;
+    mvn_lru_t   *lru         = mvn_lru_new(capacity, MVN_LRU_LIMIT_COUNT, MVN_LRU_POLICY_LRU);
+    TEST_ASSERT(lru != NULL, "Failed to create cache");
+
+    for (size_t step = 0; step < 20000; step++) {
+        size_t key_number = (step * 2654435761U >> 5) % key_space;
+        char   key[16];
+        snprintf(key, sizeof(key), "k%zu", key_number);
+
+        size_t position = 0;
+        while (position < order_count && order[position] != key_number) {
+            position++;
+        }
+        bool present = position < order_count;
+        if (step % 3 == 0) {
+            mvn_val_t *value = mvn_lru_get_cstr(lru, key);
+            TEST_ASSERT_FMT((value != NULL) == present, "Presence of %s at step %zu", key, step);
+            if (!present) {
+                continue;
+            }
+            TEST_ASSERT_FMT(value->u64 == key_number, "Value of %s", key);
+        } else {
+            TEST_ASSERT(mvn_lru_put_cstr(lru, key, mvn_val_u64(key_number)), "Put");
+            if (!present && order_count == capacity) {
+                memmove(order, order + 1, (capacity - 1) * sizeof(size_t)); // Evict index 0
+                order_count--;
+            }
+            if (!present) {
+                order[order_count++] = key_number;
+                continue;
+            }
+        }
+        // Move the used key to the most recent end
+        memmove(order + position,
+                order + position + 1,
+                (order_count - position - 1) * sizeof(size_t));
+        order[order_count - 1] = key_number;
+    }
+    TEST_ASSERT(mvn_lru_count(lru) == order_count, "Count matches the reference");
+    mvn_lru_free(lru);
+    return true;
+}
+
+static bool test_lru_clock_policy(void)
+{
+    mvn_lru_t *lru = mvn_lru_new(3, MVN_LRU_LIMIT_COUNT, MVN_LRU_POLICY_CLOCK);
+    TEST_ASSERT(lru != NULL, "Failed to create cache");
+    mvn_lru_put_cstr(lru, "a", mvn_val_i32(1));
+    mvn_lru_put_cstr(lru, "b", mvn_val_i32(2));
+    mvn_lru_put_cstr(lru, "c", mvn_val_i32(3));
+
+    // A hit only sets the reference bit; the list is not reordered
+    mvn_lru_entry_t *head = lru->head;
+    TEST_ASSERT(mvn_lru_get_cstr(lru, "a") != NULL, "Get a");
+    TEST_ASSERT(lru->head == head && head->referenced, "Hit sets the bit in place");
+
+    // The hand passes over referenced a and evicts b
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "d", mvn_val_i32(4)), "Put d");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "b") == NULL, "Unreferenced b is evicted");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "a") != NULL, "Referenced a gets a second chance");
+
+    // a lost its bit on that sweep; c is referenced now, so d goes next
+    TEST_ASSERT(mvn_lru_get_cstr(lru, "c") != NULL, "Get c");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "e", mvn_val_i32(5)), "Put e");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "d") == NULL, "d is evicted");
+    const char *const keys[] = {"a", "c", "e"};
+    TEST_ASSERT(count_present(lru, keys, 3) == 3, "a, c and e remain");
+
+    // Every entry referenced: the hand clears all bits and evicts where it started
+    mvn_lru_get_cstr(lru, "a");
+    mvn_lru_get_cstr(lru, "c");
+    mvn_lru_get_cstr(lru, "e");
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "f", mvn_val_i32(6)), "Put f");
+    TEST_ASSERT(mvn_lru_count(lru) == 3 && mvn_lru_peek_cstr(lru, "f") != NULL, "f is kept");
+    mvn_lru_free(lru);
+    return true;
+}
+
+static bool test_lru_byte_capacity(void)
+{
+    const size_t capacity = 2000;
+    mvn_lru_t   *lru      = mvn_lru_new(capacity, MVN_LRU_LIMIT_BYTES, MVN_LRU_POLICY_LRU);
+    TEST_ASSERT(lru != NULL, "Failed to create cache");
+
+    char text[301];
+    memset(text, 'x', 300);
+    text[300] = '\0';
+    mvn_val_t sample = mvn_val_str(text);
+    size_t    charge = mvn_val_memory_usage(&sample);
+    mvn_val_free(&sample);
+
+    // Each 300-character string costs more than 300 bytes, so fewer than seven fit
+    for (size_t index = 0; index < 20; index++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%zu", index);
+        TEST_ASSERT(mvn_lru_put_cstr(lru, key, mvn_val_str(text)), "Put string");
+        TEST_ASSERT_FMT(mvn_lru_bytes(lru) <= capacity, "Over capacity after put %zu", index);
+    }
+    size_t count = mvn_lru_count(lru);
+    TEST_ASSERT(count > 0 && count < 2000 / 300, "Byte capacity bounds the count");
+    TEST_ASSERT(mvn_lru_bytes(lru) >= count * charge, "Bytes include the values");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "key19") != NULL, "Newest entry is present");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "key0") == NULL, "Oldest entry is evicted");
+
+    // Growing one value evicts others; an entry larger than the capacity is rejected
+    char big[1501];
+    memset(big, 'y', 1500);
+    big[1500] = '\0';
+    TEST_ASSERT(mvn_lru_put_cstr(lru, "key19", mvn_val_str(big)), "Grow key19");
+    TEST_ASSERT(mvn_lru_bytes(lru) <= capacity, "Growth evicts to fit");
+    TEST_ASSERT(mvn_lru_count(lru) < count, "Other entries were evicted");
+    char huge[2001];
+    memset(huge, 'z', 2000);
+    huge[2000] = '\0';
+    TEST_ASSERT(!mvn_lru_put_cstr(lru, "huge", mvn_val_str(huge)), "Oversized entry rejected");
+    TEST_ASSERT(mvn_lru_peek_cstr(lru, "key19") != NULL, "Rejection evicts nothing");
+
+    size_t bytes_before = mvn_lru_bytes(lru);
+    TEST_ASSERT(mvn_lru_remove_cstr(lru, "key19"), "Remove key19");
+    TEST_ASSERT(mvn_lru_bytes(lru) < bytes_before, "Removal releases its bytes");
+    mvn_lru_free(lru);
+    return true;
+}
+
+static bool test_lru_evict_callback(void)
+{
+    evictions_t evictions = {0};
+    mvn_lru_t  *lru       = mvn_lru_new(2, MVN_LRU_LIMIT_COUNT, MVN_LRU_POLICY_LRU);
+    TEST_ASSERT(lru != NULL, "Failed to create cache");
+    mvn_lru_set_evict_callback(lru, record_eviction, &evictions);
+
+    mvn_lru_put_cstr(lru, "one", mvn_val_str("first"));
+    mvn_lru_put_cstr(lru, "two", mvn_val_str("second"));
+    mvn_lru_put_cstr(lru, "three", mvn_val_str("third"));
+    TEST_ASSERT(evictions.count == 1, "One eviction");
+    TEST_ASSERT(strcmp(evictions.keys[0], "one") == 0, "Evicted key is passed");
+    TEST_ASSERT(strcmp(evictions.values[0].str->data, "first") == 0, "Value moved out");
+
+    // Replacements, removals and freeing the cache are not evictions
+    mvn_lru_put_cstr(lru, "two", mvn_val_str("again"));
+    mvn_lru_remove_cstr(lru, "three");
+    mvn_lru_free(lru);
+    TEST_ASSERT(evictions.count == 1, "No further evictions");
+    mvn_val_free(&evictions.values[0]);
+    return true;
+}
+
+static bool test_lru_null_param_safety(void)
+{
+    TEST_ASSERT(mvn_lru_new(0, MVN_LRU_LIMIT_COUNT, MVN_LRU_POLICY_LRU) == NULL, "Capacity 0");
+    mvn_lru_free(NULL);
+    mvn_lru_set_evict_callback(NULL, record_eviction, NULL);
+    TEST_ASSERT(!mvn_lru_put_cstr(NULL, "a", mvn_val_str("freed")), "Put into NULL");
+    TEST_ASSERT(!mvn_lru_put(NULL, mvn_str_new("a"), mvn_val_null()), "Put into NULL");
+    TEST_ASSERT(mvn_lru_get_cstr(NULL, "a") == NULL, "Get from NULL");
+    TEST_ASSERT(mvn_lru_peek(NULL, NULL) == NULL, "Peek NULL");
+    TEST_ASSERT(!mvn_lru_remove_cstr(NULL, "a"), "Remove from NULL");
+    TEST_ASSERT(mvn_lru_count(NULL) == 0 && mvn_lru_bytes(NULL) == 0, "Count of NULL");
+
+    mvn_lru_t *lru = mvn_lru_new(4, MVN_LRU_LIMIT_COUNT, MVN_LRU_POLICY_CLOCK);
+    TEST_ASSERT(lru != NULL, "Failed to create cache");
+    TEST_ASSERT(mvn_lru_get_cstr(lru, "a") == NULL, "Get from empty cache");
+    TEST_ASSERT(!mvn_lru_remove_cstr(lru, "a"), "Remove from empty cache");
+    TEST_ASSERT(!mvn_lru_put(lru, NULL, mvn_val_str("freed")), "NULL key");
+    TEST_ASSERT(mvn_lru_get_cstr(lru, NULL) == NULL, "NULL C string key");
+    mvn_lru_free(lru);
+    return true;
+}
+
+/**
+ * \brief           Run all LRU cache tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_lru_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING LRU TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_lru_count_capacity);
+    RUN_TEST(test_lru_matches_reference);
+    RUN_TEST(test_lru_clock_policy);
+    RUN_TEST(test_lru_byte_capacity);
+    RUN_TEST(test_lru_evict_callback);
+    RUN_TEST(test_lru_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_lru_tests(&passed, &failed, &total);
+
+    printf("\n===== LRU TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
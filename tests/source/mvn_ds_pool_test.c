@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_pool_test.h"
+
+#include "mvn_ds/mvn_ds_pool.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// --- Helpers ---
+
+typedef struct slot_task_t {
+    int *slots;
+    int  index;
+} slot_task_t;
+
+static void mark_slot_task(void *context)
+{
+    slot_task_t *task = (slot_task_t *)context;
+    task->slots[task->index] += task->index + 1;
+}
+
+static void square_range(size_t begin, size_t end, void *context)
+{
+    size_t *values = (size_t *)context;
+    for (size_t index = begin; index < end; index++) {
+        values[index] = index * index;
+    }
+}
+
+// Records at every index the size of the chunk that covered it.
+static void chunk_size_range(size_t begin, size_t end, void *context)
+{
+    size_t *sizes = (size_t *)context;
+    for (size_t index = begin; index < end; index++) {
+        sizes[index] += end - begin;
+    }
+}
+
+typedef struct fib_task_t {
+    mvn_pool_t *pool;
+    int         input;
+    long        result;
+} fib_task_t;
+
+static void fib_task(void *context)
+{
+    fib_task_t *task = (fib_task_t *)context;
+    if (task->input < 2) {
+        task->result = task->input;
+        return;
+    }
+    fib_task_t        left  = {task->pool, task->input - 1, 0};
+    fib_task_t        right = {task->pool, task->input - 2, 0};
+    mvn_pool_group_t *group = mvn_pool_group_new(task->pool);
+    if (group == NULL || !mvn_pool_group_submit(group, fib_task, &left)) {
+        fib_task(&left); // Fall back to running inline
+    }
+    fib_task(&right);
+    mvn_pool_group_free(group); // Waits for left
+    task->result = left.result + right.result;
+}
+
+typedef struct slow_task_t {
+    mvn_pool_t *pool;
+    int         depth; // Levels of nested slow tasks still to spawn
+    int         done;
+} slow_task_t;
+
+// Keeps a worker busy long enough that waiting threads stop polling and sleep.
+static void slow_task(void *context)
+{
+    slow_task_t      *task = (slow_task_t *)context;
+    volatile unsigned work = 0;
+    for (unsigned step = 0; step < 20000000u; step++) {
+        work += step;
+    }
+    if (task->depth > 0) {
+        slow_task_t       child = {task->pool, task->depth - 1, 0};
+        mvn_pool_group_t *group = mvn_pool_group_new(task->pool);
+        if (group == NULL || !mvn_pool_group_submit(group, slow_task, &child)) {
+            slow_task(&child);
+        }
+        mvn_pool_group_free(group); // A worker waiting on a slow task
+        task->done = child.done;
+    }
+    task->done += 1;
+}
+
+// --- Test Functions ---
+
+static bool test_pool_creation_and_destruction(void)
+{
+    mvn_pool_t *pool = mvn_pool_new(2);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+    TEST_ASSERT(mvn_pool_thread_count(pool) == 2, "Pool should have 2 workers");
+    mvn_pool_free(pool);
+
+    pool = mvn_pool_new(0);
+    TEST_ASSERT(pool != NULL, "Failed to create pool with default thread count");
+    TEST_ASSERT(mvn_pool_thread_count(pool) >= 1, "Default pool should have at least 1 worker");
+    mvn_pool_free(pool);
+
+    mvn_pool_free(NULL); // Should not crash
+    return true;
+}
+
+static bool test_pool_submit_and_wait_idle(void)
+{
+    enum { TASK_COUNT = 1000 };
+    mvn_pool_t *pool = mvn_pool_new(4);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+
+    int         slots[TASK_COUNT] = {0};
+    slot_task_t tasks[TASK_COUNT];
+    for (int index = 0; index < TASK_COUNT; index++) {
+        tasks[index].slots = slots;
+        tasks[index].index = index;
+        TEST_ASSERT(mvn_pool_submit(pool, mark_slot_task, &tasks[index]), "Submit failed");
+    }
+    mvn_pool_wait_idle(pool);
+
+    for (int index = 0; index < TASK_COUNT; index++) {
+        TEST_ASSERT_FMT(slots[index] == index + 1, "Slot %d ran %d times", index, slots[index]);
+    }
+    mvn_pool_free(pool);
+    return true;
+}
+
+static bool test_pool_parallel_for(void)
+{
+    enum { ELEMENT_COUNT = 100000 };
+    mvn_pool_t *pool = mvn_pool_new(4);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+
+    size_t *values = (size_t *)calloc(ELEMENT_COUNT, sizeof(size_t));
+    TEST_ASSERT(values != NULL, "Failed to allocate values");
+
+    // Adaptive grain
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 0, ELEMENT_COUNT, 0, square_range, values),
+                "parallel_for with adaptive grain failed");
+    for (size_t index = 0; index < ELEMENT_COUNT; index++) {
+        TEST_ASSERT_FMT(values[index] == index * index, "Wrong value at %zu", index);
+    }
+
+    // Explicit grain and a non-zero start index
+    for (size_t index = 0; index < ELEMENT_COUNT; index++) {
+        values[index] = 0;
+    }
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 10, ELEMENT_COUNT, 7, square_range, values),
+                "parallel_for with explicit grain failed");
+    TEST_ASSERT(values[9] == 0, "Index below begin should not be touched");
+    TEST_ASSERT(values[10] == 100, "First index should be processed");
+    TEST_ASSERT(values[ELEMENT_COUNT - 1] == (size_t)(ELEMENT_COUNT - 1) * (ELEMENT_COUNT - 1),
+                "Last index should be processed");
+
+    // Lazy splitting never passes body a chunk larger than the grain, nor covers an index twice
+    for (size_t index = 0; index < ELEMENT_COUNT; index++) {
+        values[index] = 0;
+    }
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 0, ELEMENT_COUNT, 64, chunk_size_range, values),
+                "parallel_for with chunk size check failed");
+    for (size_t index = 0; index < ELEMENT_COUNT; index++) {
+        TEST_ASSERT_FMT(values[index] >= 1 && values[index] <= 64,
+                        "Index %zu covered by chunks totalling %zu",
+                        index,
+                        values[index]);
+    }
+
+    // Empty range and invalid input
+    TEST_ASSERT(mvn_pool_parallel_for(pool, 5, 5, 0, square_range, values), "Empty range is ok");
+    TEST_ASSERT(!mvn_pool_parallel_for(pool, 6, 5, 0, square_range, values),
+                "Reversed range should fail");
+    TEST_ASSERT(!mvn_pool_parallel_for(NULL, 0, 5, 0, square_range, values),
+                "NULL pool should fail");
+    TEST_ASSERT(!mvn_pool_parallel_for(pool, 0, 5, 0, NULL, values), "NULL body should fail");
+
+    free(values);
+    mvn_pool_free(pool);
+    return true;
+}
+
+static bool test_pool_group_fork_join(void)
+{
+    mvn_pool_t *pool = mvn_pool_new(4);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+
+    fib_task_t root = {pool, 20, 0};
+    fib_task(&root);
+    TEST_ASSERT_FMT(root.result == 6765, "fib(20) should be 6765, got %ld", root.result);
+
+    // Same computation driven from a task running on a worker
+    fib_task_t        nested = {pool, 18, 0};
+    mvn_pool_group_t *group  = mvn_pool_group_new(pool);
+    TEST_ASSERT(group != NULL, "Failed to create group");
+    TEST_ASSERT(mvn_pool_group_submit(group, fib_task, &nested), "Group submit failed");
+    mvn_pool_group_wait(group);
+    TEST_ASSERT_FMT(nested.result == 2584, "fib(18) should be 2584, got %ld", nested.result);
+    mvn_pool_group_free(group);
+
+    mvn_pool_free(pool);
+    return true;
+}
+
+static bool test_pool_wait_on_slow_tasks(void)
+{
+    mvn_pool_t *pool = mvn_pool_new(2);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+
+    // The waiting threads run out of tasks to help with and must be woken when the counters drain
+    slow_task_t       tasks[3] = {{pool, 1, 0}, {pool, 0, 0}, {pool, 2, 0}};
+    mvn_pool_group_t *group    = mvn_pool_group_new(pool);
+    TEST_ASSERT(group != NULL, "Failed to create group");
+    for (size_t index = 0; index < 3; index++) {
+        TEST_ASSERT(mvn_pool_group_submit(group, slow_task, &tasks[index]), "Group submit failed");
+    }
+    mvn_pool_group_wait(group);
+    for (size_t index = 0; index < 3; index++) {
+        TEST_ASSERT_FMT(tasks[index].done == tasks[index].depth + 1,
+                        "Slow task %zu finished %d of %d levels",
+                        index,
+                        tasks[index].done,
+                        tasks[index].depth + 1);
+    }
+    mvn_pool_group_free(group);
+
+    slow_task_t detached = {pool, 0, 0};
+    TEST_ASSERT(mvn_pool_submit(pool, slow_task, &detached), "Submit failed");
+    mvn_pool_wait_idle(pool);
+    TEST_ASSERT(detached.done == 1, "wait_idle returned before the slow task finished");
+
+    mvn_pool_free(pool);
+    return true;
+}
+
+static bool test_pool_null_param_safety(void)
+{
+    TEST_ASSERT(mvn_pool_thread_count(NULL) == 0, "Thread count of NULL pool should be 0");
+    TEST_ASSERT(!mvn_pool_submit(NULL, mark_slot_task, NULL), "Submit to NULL pool should fail");
+    TEST_ASSERT(mvn_pool_group_new(NULL) == NULL, "Group on NULL pool should be NULL");
+    TEST_ASSERT(!mvn_pool_group_submit(NULL, mark_slot_task, NULL),
+                "Submit to NULL group should fail");
+    mvn_pool_wait_idle(NULL);  // Should not crash
+    mvn_pool_group_wait(NULL); // Should not crash
+    mvn_pool_group_free(NULL); // Should not crash
+
+    mvn_pool_t *pool = mvn_pool_new(1);
+    TEST_ASSERT(pool != NULL, "Failed to create pool");
+    TEST_ASSERT(!mvn_pool_submit(pool, NULL, NULL), "Submit with NULL function should fail");
+    mvn_pool_free(pool);
+    return true;
+}
+
+// --- Test Runner ---
+
+/**
+ * \brief           Run all thread pool tests
+ * \param[out]      passed_tests: Pointer to passed tests counter
+ * \param[out]      failed_tests: Pointer to failed tests counter
+ * \param[out]      total_tests: Pointer to total tests counter
+ */
+int run_pool_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING POOL TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_pool_creation_and_destruction);
+    RUN_TEST(test_pool_submit_and_wait_idle);
+    RUN_TEST(test_pool_parallel_for);
+    RUN_TEST(test_pool_group_fork_join);
+    RUN_TEST(test_pool_wait_on_slow_tasks);
+    RUN_TEST(test_pool_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_pool_tests(&passed, &failed, &total);
+
+    printf("\n===== POOL TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
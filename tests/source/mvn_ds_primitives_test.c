@@ -566,6 +566,41 @@ static bool test_additional_primitive_operations(void)
     return true; // Test passed
 }
 
+static bool test_val_memory_usage(void)
+{
+    mvn_val_t val_i32 = mvn_val_i32(7);
+    TEST_ASSERT(mvn_val_memory_usage(&val_i32) == 0, "Primitives should own no heap memory");
+    TEST_ASSERT(mvn_val_memory_usage(NULL) == 0, "NULL should report 0 bytes");
+
+    mvn_val_t val_str   = mvn_val_str("hello");
+    size_t    str_bytes = mvn_val_memory_usage(&val_str);
+    TEST_ASSERT(str_bytes == sizeof(mvn_str_t) + val_str.str->capacity + 1,
+                "String usage should be struct plus buffer");
+
+    mvn_val_t val_arr   = mvn_val_arr();
+    size_t    arr_empty = mvn_val_memory_usage(&val_arr);
+    TEST_ASSERT(arr_empty >= sizeof(mvn_arr_t), "Array usage should include the struct");
+    mvn_arr_push(val_arr.arr, val_str); // Ownership moves to the array
+    TEST_ASSERT(mvn_val_memory_usage(&val_arr) ==
+                    sizeof(mvn_arr_t) + val_arr.arr->capacity * sizeof(mvn_val_t) + str_bytes,
+                "Array usage should include its elements");
+
+    mvn_val_t val_hmap = mvn_val_hmap();
+    mvn_hmap_set_cstr(val_hmap.hmap, "list", val_arr);
+    size_t hmap_bytes = mvn_val_memory_usage(&val_hmap);
+    TEST_ASSERT(hmap_bytes > sizeof(mvn_hmap_t) + sizeof(mvn_hmap_entry_t) + str_bytes,
+                "Map usage should include entries, keys and nested values");
+
+    // Freezing compacts the map into one block
+    TEST_ASSERT(mvn_val_freeze(&val_hmap), "Freeze failed");
+    size_t frozen_bytes = mvn_val_memory_usage(&val_hmap);
+    TEST_ASSERT(frozen_bytes > 0 && frozen_bytes < hmap_bytes,
+                "Frozen map should use less memory than the hash map");
+
+    mvn_val_free(&val_hmap);
+    return true;
+}
+
 /**
  * \brief           Run all primitives tests
  * \param[out]      passed_tests: Pointer to passed tests counter
@@ -584,6 +619,7 @@ int run_primitives_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_primitive_equality_detailed);   // Added
     RUN_TEST(test_primitive_print);               // Added
     RUN_TEST(test_val_type_to_string_conversion); // Added
+    RUN_TEST(test_val_memory_usage);
 
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
     (*total_tests) += tests_run;
@@ -323,6 +323,33 @@ static bool test_string_hash(void)
     return true; // Test passed
 }
 
+static bool test_string_hash_seeded(void)
+{
+    // SipHash-1-3 reference values for key bytes 00..0f
+    const uint64_t key0  = 0x0706050403020100ULL;
+    const uint64_t key1  = 0x0F0E0D0C0B0A0908ULL;
+    mvn_str_t     *empty = mvn_str_new("");
+    mvn_str_t     *hello = mvn_str_new("hello world");
+    mvn_str_t     *block = mvn_str_new("abcdefgh");
+    TEST_ASSERT(empty != NULL && hello != NULL && block != NULL,
+                "Failed to create strings for seeded hash test");
+
+    TEST_ASSERT(mvn_str_hash_seeded(empty, key0, key1) == 0xABAC0158050FC4DCULL,
+                "Seeded hash of empty string does not match SipHash-1-3");
+    TEST_ASSERT(mvn_str_hash_seeded(hello, key0, key1) == 0xAB492B52FFA74D7BULL,
+                "Seeded hash with a partial block does not match SipHash-1-3");
+    TEST_ASSERT(mvn_str_hash_seeded(block, key0, key1) == 0x12D8C08C2EE9E620ULL,
+                "Seeded hash of one full block does not match SipHash-1-3");
+    TEST_ASSERT(mvn_str_hash_seeded(hello, key0, key1) != mvn_str_hash_seeded(hello, key0, 0),
+                "Different keys should give different seeded hashes");
+    TEST_ASSERT(mvn_str_hash_seeded(NULL, key0, key1) == 0, "Seeded hash of NULL should be 0");
+
+    mvn_str_free(empty);
+    mvn_str_free(hello);
+    mvn_str_free(block);
+    return true;
+}
+
 static bool test_string_val_integration(void)
 {
     // Test mvn_val_str (creates and owns)
@@ -402,6 +429,7 @@ int run_string_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_string_equal_cstr);
     RUN_TEST(test_string_resize);
     RUN_TEST(test_string_hash);
+    RUN_TEST(test_string_hash_seeded);
     RUN_TEST(test_string_val_integration);
     RUN_TEST(test_string_val_take_null);         // Added
     RUN_TEST(test_string_new_capacity_overflow); // Added
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 Jake Larson
+ */
+#include "mvn_ds_table_test.h"
+
+#include "mvn_ds/mvn_ds.h"
+#include "mvn_ds/mvn_ds_arr.h"
+#include "mvn_ds/mvn_ds_bitset.h"
+#include "mvn_ds/mvn_ds_hmap.h"
+#include "mvn_ds/mvn_ds_table.h"
+#include "mvn_ds_test_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+// Builds order records {id: i32, price: f64, city: string, paid: bool}; every third record
+// has no price and every fifth has a null city.
+static mvn_arr_t *make_orders(size_t count)
+{
+    static const char *const cities[] = {"Oslo", "Lima", "Pune"};
+    mvn_arr_t               *rows     = mvn_arr_new();
+    for (size_t index = 0; rows != NULL && index < count; index++) {
+        mvn_hmap_t *record = mvn_hmap_new();
+        if (record == NULL) {
+            mvn_arr_free(rows);
+            return NULL;
+        }
+        mvn_hmap_set_cstr(record, "id", mvn_val_i32((int32_t)index));
+        if (index % 3 != 0) {
+            mvn_hmap_set_cstr(record, "price", mvn_val_f64((double)index * 0.5));
+        }
+        mvn_hmap_set_cstr(record,
+                          "city",
+                          index % 5 == 0 ? mvn_val_null() : mvn_val_str(cities[index % 3]));
+        mvn_hmap_set_cstr(record, "paid", mvn_val_bool(index % 2 == 0));
+        mvn_arr_push(rows, mvn_val_hmap_take(record));
+    }
+    return rows;
+}
+
+// --- Test Functions ---
+
+static bool test_table_column_types(void)
+{
+    mvn_arr_t *rows = make_orders(30);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    mvn_table_t *table = mvn_table_from_rows(rows);
+    TEST_ASSERT(table != NULL, "Failed to build table");
+    TEST_ASSERT(mvn_table_row_count(table) == 30, "One row per record");
+    TEST_ASSERT(mvn_table_column_count(table) == 4, "One column per field");
+
+    // Columns are sorted by name
+    const char *names[] = {"city", "id", "paid", "price"};
+    for (size_t index = 0; index < 4; index++) {
+        TEST_ASSERT_FMT(strcmp(mvn_table_column(table, index)->name->data, names[index]) == 0,
+                        "Column %zu is %s",
+                        index,
+                        names[index]);
+    }
+    TEST_ASSERT(mvn_table_column(table, 4) == NULL, "Column index out of bounds");
+
+    const mvn_table_col_t *id = mvn_table_column_cstr(table, "id");
+    TEST_ASSERT(id != NULL && id->type == MVN_TABLE_I64, "Integers are packed as i64");
+    TEST_ASSERT(mvn_bitset_count(id->valid) == 30, "Every id is valid");
+    for (size_t row = 0; row < 30; row++) {
+        TEST_ASSERT(id->i64[row] == (int64_t)row, "Rows keep record order");
+    }
+
+    const mvn_table_col_t *price = mvn_table_column_cstr(table, "price");
+    TEST_ASSERT(price != NULL && price->type == MVN_TABLE_F64, "Floats are packed as f64");
+    TEST_ASSERT(mvn_bitset_count(price->valid) == 20, "Missing fields are null rows");
+    TEST_ASSERT(!mvn_bitset_test(price->valid, 3) && price->f64[3] == 0.0, "Null row holds 0");
+    TEST_ASSERT(price->f64[4] == 2.0, "Price of record 4");
+
+    const mvn_table_col_t *paid = mvn_table_column_cstr(table, "paid");
+    TEST_ASSERT(paid != NULL && paid->type == MVN_TABLE_BOOL, "Booleans are packed as bytes");
+    TEST_ASSERT(paid->bools[0] == 1 && paid->bools[1] == 0, "Boolean rows");
+
+    // Strings are dictionary-encoded in first-seen order
+    const mvn_table_col_t *city = mvn_table_column_cstr(table, "city");
+    TEST_ASSERT(city != NULL && city->type == MVN_TABLE_STRING, "Strings are codes");
+    TEST_ASSERT(city->dictionary->count == 3, "Three distinct cities");
+    TEST_ASSERT(mvn_bitset_count(city->valid) == 24, "Null strings are null rows");
+    TEST_ASSERT(city->codes[0] == MVN_DS_TABLE_NULL_CODE, "Null row holds the null code");
+    TEST_ASSERT(strcmp(city->dictionary->data[city->codes[1]].str->data, "Lima") == 0,
+                "Code of record 1");
+    TEST_ASSERT(city->codes[4] == city->codes[1], "Equal strings share a code");
+
+    TEST_ASSERT(mvn_table_column_cstr(table, "absent") == NULL, "Unknown field");
+    TEST_ASSERT(mvn_table_memory_usage(table) > 30 * (8 + 8 + 4 + 1), "Memory usage");
+    mvn_table_free(table);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_table_mixed_values(void)
+{
+    mvn_arr_t *rows = mvn_arr_new();
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    for (int index = 0; index < 4; index++) {
+        mvn_hmap_t *record = mvn_hmap_new();
+        TEST_ASSERT(record != NULL, "Failed to create record");
+        // Mixed signed and unsigned integers that fit in i64
+        mvn_hmap_set_cstr(record, "small", index % 2 ? mvn_val_u8(200) : mvn_val_i16(-5));
+        // Unsigned above INT64_MAX
+        mvn_hmap_set_cstr(record, "big", mvn_val_u64(UINT64_MAX - (uint64_t)index));
+        // Strings and integers together
+        mvn_hmap_set_cstr(record, "mixed", index % 2 ? mvn_val_str("x") : mvn_val_i32(index));
+        // Nested values
+        mvn_val_t tags = mvn_val_arr();
+        mvn_arr_push(tags.arr, mvn_val_i32(index));
+        mvn_hmap_set_cstr(record, "tags", tags);
+        mvn_hmap_set_cstr(record, "nothing", mvn_val_null());
+        TEST_ASSERT(mvn_arr_push(rows, mvn_val_hmap_take(record)), "Push record");
+    }
+
+    mvn_table_t *table = mvn_table_from_rows(rows);
+    TEST_ASSERT(table != NULL, "Failed to build table");
+    const mvn_table_col_t *small = mvn_table_column_cstr(table, "small");
+    TEST_ASSERT(small->type == MVN_TABLE_I64 && small->i64[0] == -5 && small->i64[1] == 200,
+                "Signed and unsigned widen to i64");
+    const mvn_table_col_t *big = mvn_table_column_cstr(table, "big");
+    TEST_ASSERT(big->type == MVN_TABLE_U64 && big->u64[0] == UINT64_MAX, "Big values are u64");
+    const mvn_table_col_t *mixed = mvn_table_column_cstr(table, "mixed");
+    TEST_ASSERT(mixed->type == MVN_TABLE_VALUE, "Mixed kinds keep values");
+    TEST_ASSERT(mixed->values[1].type == MVN_VAL_STRING, "Mixed string value");
+    const mvn_table_col_t *tags = mvn_table_column_cstr(table, "tags");
+    TEST_ASSERT(tags->type == MVN_TABLE_VALUE && tags->values[2].arr->data[0].i32 == 2,
+                "Nested values are copied");
+    const mvn_table_col_t *nothing = mvn_table_column_cstr(table, "nothing");
+    TEST_ASSERT(nothing->type == MVN_TABLE_NULL && nothing->data == NULL, "All-null column");
+    mvn_val_t cell = mvn_table_cell(nothing, 0);
+    TEST_ASSERT(cell.type == MVN_VAL_NULL, "All-null cell");
+
+    // The records are copied, so the table outlives them
+    mvn_arr_free(rows);
+    cell = mvn_table_cell(tags, 3);
+    TEST_ASSERT(cell.type == MVN_VAL_ARRAY && cell.arr->data[0].i32 == 3, "Cell copy");
+    mvn_val_free(&cell);
+    cell = mvn_table_cell(small, 99);
+    TEST_ASSERT(cell.type == MVN_VAL_NULL, "Out-of-bounds cell is null");
+    mvn_table_free(table);
+    return true;
+}
+
+static bool test_table_to_rows(void)
+{
+    mvn_arr_t *rows = make_orders(12);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    mvn_table_t *table = mvn_table_from_rows(rows);
+    TEST_ASSERT(table != NULL, "Failed to build table");
+    mvn_arr_t *back = mvn_table_to_rows(table);
+    TEST_ASSERT(back != NULL && back->count == 12, "One record per row");
+
+    for (size_t index = 0; index < 12; index++) {
+        const mvn_hmap_t *record = back->data[index].hmap;
+        TEST_ASSERT(mvn_hmap_cstr(record, "id")->type == MVN_VAL_I64, "Integers come back as i64");
+        TEST_ASSERT(mvn_hmap_cstr(record, "id")->i64 == (int64_t)index, "Id");
+        TEST_ASSERT((mvn_hmap_cstr(record, "price") != NULL) == (index % 3 != 0),
+                    "Missing fields stay missing");
+        TEST_ASSERT((mvn_hmap_cstr(record, "city") != NULL) == (index % 5 != 0),
+                    "Null fields are left out");
+        // Apart from the widened id, each record equals its original
+        mvn_val_t original_id = mvn_val_i64((int64_t)index);
+        mvn_hmap_set_cstr(rows->data[index].hmap, "id", original_id);
+        mvn_hmap_delete_cstr(rows->data[index].hmap, index % 5 == 0 ? "city" : "none");
+        TEST_ASSERT_FMT(mvn_val_equal(&rows->data[index], &back->data[index]),
+                        "Record %zu round-trips",
+                        index);
+    }
+    mvn_arr_free(back);
+    mvn_table_free(table);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_table_scans(void)
+{
+    mvn_arr_t *rows = make_orders(1001);
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    mvn_table_t *table = mvn_table_from_rows(rows);
+    TEST_ASSERT(table != NULL, "Failed to build table");
+
+    // Reference results computed from the records
+    double expected_price = 0.0;
+    size_t expected_paid  = 0;
+    size_t expected_lima  = 0;
+    for (size_t index = 0; index < rows->count; index++) {
+        const mvn_hmap_t *record = rows->data[index].hmap;
+        mvn_val_t        *price  = mvn_hmap_cstr(record, "price");
+        mvn_val_t        *city   = mvn_hmap_cstr(record, "city");
+        expected_price += price != NULL ? price->f64 : 0.0;
+        expected_paid += mvn_hmap_cstr(record, "paid")->b ? 1 : 0;
+        expected_lima += city->type == MVN_VAL_STRING && strcmp(city->str->data, "Lima") == 0;
+    }
+
+    TEST_ASSERT(mvn_table_sum(mvn_table_column_cstr(table, "price")) == expected_price,
+                "Float sum");
+    TEST_ASSERT(mvn_table_sum(mvn_table_column_cstr(table, "id")) == 1000.0 * 1001.0 / 2.0,
+                "Integer sum");
+    TEST_ASSERT(mvn_table_sum(mvn_table_column_cstr(table, "paid")) == (double)expected_paid,
+                "Boolean sum counts true rows");
+    TEST_ASSERT(mvn_table_sum(mvn_table_column_cstr(table, "city")) == 0.0, "String sum is 0");
+
+    const mvn_table_col_t *city = mvn_table_column_cstr(table, "city");
+    TEST_ASSERT(mvn_table_count_cstr(city, "Lima") == expected_lima, "Count by code");
+    TEST_ASSERT(mvn_table_count_cstr(city, "Rome") == 0, "Absent string");
+    TEST_ASSERT(mvn_table_count_cstr(mvn_table_column_cstr(table, "id"), "1") == 0,
+                "Count on a non-string column");
+    mvn_table_free(table);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_table_empty_input(void)
+{
+    // No records, hence no fields
+    mvn_arr_t *rows = mvn_arr_new();
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    mvn_table_t *empty = mvn_table_from_rows(rows);
+    TEST_ASSERT(empty != NULL && mvn_table_row_count(empty) == 0 &&
+                    mvn_table_column_count(empty) == 0,
+                "Empty table");
+    mvn_arr_t *no_rows = mvn_table_to_rows(empty);
+    TEST_ASSERT(no_rows != NULL && no_rows->count == 0, "Empty table to rows");
+    mvn_arr_free(no_rows);
+    mvn_table_free(empty);
+
+    // Records without fields give rows but no columns
+    mvn_arr_push(rows, mvn_val_hmap());
+    mvn_arr_push(rows, mvn_val_hmap());
+    mvn_table_t *fieldless = mvn_table_from_rows(rows);
+    TEST_ASSERT(fieldless != NULL && mvn_table_row_count(fieldless) == 2 &&
+                    mvn_table_column_count(fieldless) == 0,
+                "Fieldless records give two rows and no columns");
+    TEST_ASSERT(mvn_table_column_cstr(fieldless, "a") == NULL, "No column to find");
+    mvn_arr_t *back = mvn_table_to_rows(fieldless);
+    TEST_ASSERT(back != NULL && back->count == 2 && mvn_val_equal(&back->data[0], &rows->data[0]),
+                "Fieldless rows round-trip as empty maps");
+    mvn_arr_free(back);
+    mvn_table_free(fieldless);
+    mvn_arr_free(rows);
+    return true;
+}
+
+static bool test_table_null_param_safety(void)
+{
+    TEST_ASSERT(mvn_table_from_rows(NULL) == NULL, "NULL records");
+    mvn_table_free(NULL);
+    TEST_ASSERT(mvn_table_to_rows(NULL) == NULL, "NULL table to rows");
+    TEST_ASSERT(mvn_table_row_count(NULL) == 0, "NULL table row count");
+    TEST_ASSERT(mvn_table_column_count(NULL) == 0, "NULL table column count");
+    TEST_ASSERT(mvn_table_column(NULL, 0) == NULL, "NULL table column");
+    TEST_ASSERT(mvn_table_column_cstr(NULL, "a") == NULL, "NULL table column by name");
+    TEST_ASSERT(mvn_table_memory_usage(NULL) == 0, "NULL table memory usage");
+    TEST_ASSERT(mvn_table_sum(NULL) == 0.0, "NULL column sum");
+    TEST_ASSERT(mvn_table_count_cstr(NULL, "a") == 0, "NULL column count");
+    TEST_ASSERT(mvn_table_cell(NULL, 0).type == MVN_VAL_NULL, "NULL column cell");
+
+    // Records that are not maps are rejected
+    mvn_arr_t *rows = mvn_arr_new();
+    TEST_ASSERT(rows != NULL, "Failed to create records");
+    mvn_arr_push(rows, mvn_val_hmap());
+    mvn_arr_push(rows, mvn_val_i32(7));
+    TEST_ASSERT(mvn_table_from_rows(rows) == NULL, "Non-map record rejected");
+    mvn_arr_free(rows);
+    return true;
+}
+
+// --- Test Runner ---
+
+int run_table_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== RUNNING COLUMNAR TABLE TESTS =====\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_table_column_types);
+    RUN_TEST(test_table_mixed_values);
+    RUN_TEST(test_table_to_rows);
+    RUN_TEST(test_table_scans);
+    RUN_TEST(test_table_empty_input);
+    RUN_TEST(test_table_null_param_safety);
+
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    printf("\n");
+    return (*failed_tests == failed_before);
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_table_tests(&passed, &failed, &total);
+
+    printf("\n===== COLUMNAR TABLE TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}